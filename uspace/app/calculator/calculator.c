@@ -830,6 +830,8 @@ int main(int argc, char *argv[])
 
 	ui_wnd_params_init(&params);
 	params.caption = "Calculator";
+	/* UI controls update the display after painting */
+	params.flags |= ui_wndf_batch;
 	params.rect.p0.x = 0;
 	params.rect.p0.y = 0;
 
@@ -47,6 +47,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
@@ -68,6 +69,7 @@
 #include <numeric>
 #include <ostream>
 #include <ratio>
+#include <regex>
 #include <sstream>
 #include <stack>
 #include <streambuf>
@@ -112,15 +114,20 @@ int main()
     ts.add<std::test::map_test>();
     ts.add<std::test::set_test>();
     ts.add<std::test::unordered_map_test>();
+    ts.add<std::test::flat_hash_map_test>();
     ts.add<std::test::unordered_set_test>();
     ts.add<std::test::numeric_test>();
     ts.add<std::test::adaptors_test>();
     ts.add<std::test::memory_test>();
+    ts.add<std::test::memory_resource_test>();
+    ts.add<std::test::atomic_test>();
     ts.add<std::test::list_test>();
     ts.add<std::test::ratio_test>();
     ts.add<std::test::functional_test>();
     ts.add<std::test::algorithm_test>();
     ts.add<std::test::future_test>();
+    ts.add<std::test::mpsc_channel_test>();
+    ts.add<std::test::regex_test>();
 
     return ts.run(true) ? 0 : 1;
 }
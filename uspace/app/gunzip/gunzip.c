@@ -34,91 +34,114 @@
 
 #include <errno.h>
 #include <gzip.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+/** Size of input and output buffers */
+#define BUF_SIZE 65536
+
 int main(int argc, char *argv[])
 {
 	errno_t rc;
-	void *data, *ddata;
-	size_t size, dsize;
-	size_t nread, nwr;
-	long len;
-	FILE *f, *wf;
+	gzip_stream_t *gs = NULL;
+	uint8_t *ibuf = NULL, *obuf = NULL;
+	size_t ipos, ilen;
+	size_t used, produced;
+	size_t nwr;
+	FILE *f = NULL, *wf = NULL;
 
 	if (argc != 3) {
 		printf("syntax: gunzip <src.gz> <dest>\n");
 		return 1;
 	}
 
-	f = fopen(argv[1], "rb");
-	if (f == NULL) {
-		printf("Error opening '%s'\n", argv[1]);
-		return 1;
-	}
-
-	if (fseek(f, 0, SEEK_END) < 0) {
-		printf("Error determining size of '%s'\n", argv[1]);
-		fclose(f);
-		return 1;
-	}
-
-	len = ftell(f);
-	if (len < 0) {
-		printf("Error determining size of '%s'\n", argv[1]);
-		fclose(f);
-		return 1;
-	}
-
-	if (fseek(f, 0, SEEK_SET) < 0) {
-		printf ("Error rewinding '%s'\n", argv[1]);
-		fclose(f);
-		return 1;
-	}
-
-	data = malloc(len);
-	if (data == NULL) {
-		printf("Error allocating %ld bytes.\n", len);
-		fclose(f);
-		return 1;
+	ibuf = malloc(BUF_SIZE);
+	obuf = malloc(BUF_SIZE);
+	if (ibuf == NULL || obuf == NULL) {
+		printf("Out of memory.\n");
+		goto error;
 	}
 
-	nread = fread(data, 1, len, f);
-	if (nread != (size_t)len) {
-		printf("Error reading '%s'\n", argv[1]);
-		fclose(f);
-		return 1;
+	rc = gzip_stream_create(&gs);
+	if (rc != EOK) {
+		printf("Out of memory.\n");
+		goto error;
 	}
 
-	fclose(f);
-
-	size = (size_t) len;
-
-	rc = gzip_expand(data, size, &ddata, &dsize);
-	if (rc != EOK) {
-		printf("Error decompressing data.\n");
-		return 1;
+	f = fopen(argv[1], "rb");
+	if (f == NULL) {
+		printf("Error opening '%s'\n", argv[1]);
+		goto error;
 	}
 
 	wf = fopen(argv[2], "wb");
 	if (wf == NULL) {
 		printf("Error creating file '%s'\n", argv[2]);
-		return 1;
+		goto error;
 	}
 
-	nwr = fwrite(ddata, 1, dsize, wf);
-	if (nwr != dsize) {
-		printf("Error writing '%s'\n", argv[2]);
-		fclose(wf);
-		return 1;
+	ipos = 0;
+	ilen = 0;
+
+	while (!gzip_stream_done(gs)) {
+		rc = gzip_stream(gs, ibuf + ipos, ilen - ipos, &used, obuf,
+		    BUF_SIZE, &produced);
+		if (rc != EOK) {
+			printf("Error decompressing data.\n");
+			goto error;
+		}
+
+		ipos += used;
+
+		nwr = fwrite(obuf, 1, produced, wf);
+		if (nwr != produced) {
+			printf("Error writing '%s'\n", argv[2]);
+			goto error;
+		}
+
+		/*
+		 * If the output buffer was filled, there may be more
+		 * output pending without any more input.
+		 */
+		if (produced < BUF_SIZE && ipos == ilen &&
+		    !gzip_stream_done(gs)) {
+			ipos = 0;
+			ilen = fread(ibuf, 1, BUF_SIZE, f);
+			if (ilen == 0) {
+				if (ferror(f))
+					printf("Error reading '%s'\n", argv[1]);
+				else
+					printf("Unexpected end of '%s'\n",
+					    argv[1]);
+				goto error;
+			}
+		}
 	}
 
+	fclose(f);
+	f = NULL;
+
 	if (fclose(wf) != 0) {
+		wf = NULL;
 		printf("Error writing '%s'\n", argv[2]);
-		return 1;
+		goto error;
 	}
 
+	gzip_stream_destroy(gs);
+	free(ibuf);
+	free(obuf);
 	return 0;
+error:
+	if (wf != NULL)
+		fclose(wf);
+	if (f != NULL)
+		fclose(f);
+	if (gs != NULL)
+		gzip_stream_destroy(gs);
+	free(ibuf);
+	free(obuf);
+	return 1;
 }
 
 /** @}
@@ -41,8 +41,14 @@ benchmark_t *benchmarks[] = {
 	&benchmark_dir_read,
 	&benchmark_fibril_mutex,
 	&benchmark_file_read,
+	&benchmark_inflate_expand,
+	&benchmark_inflate_stream,
 	&benchmark_malloc1,
 	&benchmark_malloc2,
+	&benchmark_memgfx_colorize,
+	&benchmark_memgfx_copy,
+	&benchmark_memgfx_fill,
+	&benchmark_memgfx_key,
 	&benchmark_ns_ping,
 	&benchmark_ping_pong
 };
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+/**
+ * @file
+ *
+ * Decompression benchmarks. One operation decompresses the whole GZIP
+ * file given by the @c filename parameter (e.g. a file from a reference
+ * corpus compressed with gzip), which is read into memory beforehand.
+ */
+
+#include <errno.h>
+#include <gzip.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/** Size of the output buffer for streaming decompression */
+#define INFLATE_BUF_SIZE 65536
+
+/** Read the whole file into memory.
+ *
+ * @param run Benchmark run
+ * @param path File name
+ * @param rdata Place to store pointer to the data
+ * @param rsize Place to store the size of the data
+ * @return @c true on success
+ */
+static bool inflate_read_file(bench_run_t *run, const char *path,
+    void **rdata, size_t *rsize)
+{
+	FILE *f;
+	void *data;
+	long len;
+	size_t nread;
+
+	f = fopen(path, "rb");
+	if (f == NULL) {
+		return bench_run_fail(run, "failed to open %s for reading: %s",
+		    path, str_error(errno));
+	}
+
+	if (fseek(f, 0, SEEK_END) < 0 || (len = ftell(f)) < 0 ||
+	    fseek(f, 0, SEEK_SET) < 0) {
+		fclose(f);
+		return bench_run_fail(run, "failed to determine size of %s",
+		    path);
+	}
+
+	data = malloc(len);
+	if (data == NULL) {
+		fclose(f);
+		return bench_run_fail(run, "failed to allocate %ld bytes",
+		    len);
+	}
+
+	nread = fread(data, 1, len, f);
+	fclose(f);
+
+	if (nread != (size_t) len) {
+		free(data);
+		return bench_run_fail(run, "failed to read %s", path);
+	}
+
+	*rdata = data;
+	*rsize = (size_t) len;
+	return true;
+}
+
+/** Decompress the data at once using gzip_expand().
+ *
+ * @param run Benchmark run
+ * @param data Compressed data
+ * @param size Size of compressed data
+ * @return @c true on success
+ */
+static bool inflate_expand(bench_run_t *run, void *data, size_t size)
+{
+	void *ddata;
+	size_t dsize;
+	errno_t rc;
+
+	rc = gzip_expand(data, size, &ddata, &dsize);
+	if (rc != EOK)
+		return bench_run_fail(run, "decompression failed: %s",
+		    str_error(rc));
+
+	free(ddata);
+	return true;
+}
+
+/** Decompress the data through a fixed-size buffer using gzip_stream().
+ *
+ * @param run Benchmark run
+ * @param data Compressed data
+ * @param size Size of compressed data
+ * @param buf Output buffer of INFLATE_BUF_SIZE bytes
+ * @return @c true on success
+ */
+static bool inflate_stream(bench_run_t *run, void *data, size_t size,
+    uint8_t *buf)
+{
+	gzip_stream_t *gs;
+	size_t pos = 0;
+	size_t used, produced;
+	errno_t rc;
+
+	rc = gzip_stream_create(&gs);
+	if (rc != EOK)
+		return bench_run_fail(run, "out of memory");
+
+	while (!gzip_stream_done(gs)) {
+		rc = gzip_stream(gs, (uint8_t *) data + pos, size - pos, &used,
+		    buf, INFLATE_BUF_SIZE, &produced);
+		if (rc == EOK && used == 0 && produced == 0)
+			rc = EINVAL;
+		if (rc != EOK) {
+			gzip_stream_destroy(gs);
+			return bench_run_fail(run, "decompression failed: %s",
+			    str_error(rc));
+		}
+
+		pos += used;
+	}
+
+	gzip_stream_destroy(gs);
+	return true;
+}
+
+/** Run decompression benchmark.
+ *
+ * @param env Benchmark environment
+ * @param run Benchmark run
+ * @param size Number of times to decompress the file
+ * @param stream @c true to use streaming decompression
+ * @return @c true on success
+ */
+static bool inflate_runner(bench_env_t *env, bench_run_t *run, uint64_t size,
+    bool stream)
+{
+	const char *path = bench_env_param_get(env, "filename", NULL);
+	uint8_t *buf = NULL;
+	void *data = NULL;
+	size_t dsize;
+	bool ret = false;
+
+	if (path == NULL) {
+		return bench_run_fail(run, "set parameter filename to "
+		    "a GZIP compressed file");
+	}
+
+	if (!inflate_read_file(run, path, &data, &dsize))
+		return false;
+
+	buf = malloc(INFLATE_BUF_SIZE);
+	if (buf == NULL) {
+		bench_run_fail(run, "failed to allocate %d bytes",
+		    INFLATE_BUF_SIZE);
+		goto error;
+	}
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		if (stream) {
+			if (!inflate_stream(run, data, dsize, buf))
+				goto error;
+		} else {
+			if (!inflate_expand(run, data, dsize))
+				goto error;
+		}
+	}
+	bench_run_stop(run);
+
+	ret = true;
+error:
+	free(buf);
+	free(data);
+	return ret;
+}
+
+static bool runner_expand(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	return inflate_runner(env, run, size, false);
+}
+
+static bool runner_stream(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	return inflate_runner(env, run, size, true);
+}
+
+benchmark_t benchmark_inflate_expand = {
+	.name = "inflate_expand",
+	.desc = "Decompress GZIP file in memory at once (-p filename=...)",
+	.entry = &runner_expand,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_inflate_stream = {
+	.name = "inflate_stream",
+	.desc = "Decompress GZIP file through a 64 KiB buffer (-p filename=...)",
+	.entry = &runner_stream,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
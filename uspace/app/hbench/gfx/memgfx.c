@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+/**
+ * @file
+ *
+ * Memory GC rendering benchmarks. One operation processes one megapixel,
+ * so the reported number of operations per second is the throughput in
+ * megapixels per second.
+ */
+
+#include <gfx/bitmap.h>
+#include <gfx/color.h>
+#include <gfx/context.h>
+#include <gfx/render.h>
+#include <io/pixel.h>
+#include <memgfx/memgc.h>
+#include <stdlib.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/** Width and height of the rendered area (one megapixel) */
+#define MEMGFX_DIM 1000
+
+static void memgfx_invalidate(void *, gfx_rect_t *);
+static void memgfx_update(void *);
+
+static mem_gc_cb_t memgfx_cb = {
+	.invalidate = memgfx_invalidate,
+	.update = memgfx_update
+};
+
+static void memgfx_invalidate(void *arg, gfx_rect_t *rect)
+{
+}
+
+static void memgfx_update(void *arg)
+{
+}
+
+/** Run memory GC rendering benchmark.
+ *
+ * @param run Benchmark run
+ * @param size Number of megapixels to render
+ * @param fill @c true to fill rectangle, @c false to render bitmap
+ * @param flags Bitmap flags
+ * @return @c true on success
+ */
+static bool memgfx_runner(bench_run_t *run, uint64_t size, bool fill,
+    gfx_bitmap_flags_t flags)
+{
+	mem_gc_t *mgc = NULL;
+	gfx_context_t *gc;
+	gfx_rect_t rect;
+	gfx_bitmap_alloc_t alloc;
+	gfx_bitmap_params_t params;
+	gfx_bitmap_alloc_t balloc;
+	gfx_bitmap_t *bitmap = NULL;
+	gfx_color_t *color = NULL;
+	pixel_t *pixels;
+	bool ret = false;
+	errno_t rc;
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = MEMGFX_DIM;
+	rect.p1.y = MEMGFX_DIM;
+
+	alloc.pitch = MEMGFX_DIM * sizeof(uint32_t);
+	alloc.off0 = 0;
+	alloc.pixels = calloc(MEMGFX_DIM * MEMGFX_DIM, sizeof(uint32_t));
+	if (alloc.pixels == NULL)
+		return bench_run_fail(run, "failed to allocate frame buffer");
+
+	rc = mem_gc_create(&rect, &alloc, &memgfx_cb, NULL, &mgc);
+	if (rc != EOK) {
+		bench_run_fail(run, "failed to create memory GC: %s",
+		    str_error(rc));
+		goto error;
+	}
+
+	gc = mem_gc_get_ctx(mgc);
+
+	rc = gfx_color_new_rgb_i16(0xffff, 0x8000, 0, &color);
+	if (rc != EOK) {
+		bench_run_fail(run, "failed to create color: %s",
+		    str_error(rc));
+		goto error;
+	}
+
+	rc = gfx_set_color(gc, color);
+	if (rc != EOK) {
+		bench_run_fail(run, "failed to set color: %s", str_error(rc));
+		goto error;
+	}
+
+	if (!fill) {
+		gfx_bitmap_params_init(&params);
+		params.rect = rect;
+		params.flags = flags;
+		params.key_color = PIXEL(0, 255, 0, 255);
+
+		rc = gfx_bitmap_create(gc, &params, NULL, &bitmap);
+		if (rc != EOK) {
+			bench_run_fail(run, "failed to create bitmap: %s",
+			    str_error(rc));
+			goto error;
+		}
+
+		rc = gfx_bitmap_get_alloc(bitmap, &balloc);
+		if (rc != EOK) {
+			bench_run_fail(run, "failed to get bitmap allocation: %s",
+			    str_error(rc));
+			goto error;
+		}
+
+		/* Make roughly every fourth pixel transparent */
+		pixels = balloc.pixels;
+		for (size_t i = 0; i < MEMGFX_DIM * MEMGFX_DIM; i++) {
+			pixels[i] = (i * 7 % 4) == 0 ? params.key_color :
+			    PIXEL(0, i & 0xff, (i >> 8) & 0xff, 0x80);
+		}
+	}
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		if (fill)
+			rc = gfx_fill_rect(gc, &rect);
+		else
+			rc = gfx_bitmap_render(bitmap, NULL, NULL);
+		if (rc != EOK) {
+			bench_run_fail(run, "rendering failed: %s",
+			    str_error(rc));
+			goto error;
+		}
+	}
+	bench_run_stop(run);
+
+	ret = true;
+error:
+	if (bitmap != NULL)
+		gfx_bitmap_destroy(bitmap);
+	if (color != NULL)
+		gfx_color_delete(color);
+	if (mgc != NULL)
+		mem_gc_delete(mgc);
+	free(alloc.pixels);
+	return ret;
+}
+
+static bool runner_fill(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	return memgfx_runner(run, size, true, 0);
+}
+
+static bool runner_copy(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	return memgfx_runner(run, size, false, 0);
+}
+
+static bool runner_key(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	return memgfx_runner(run, size, false, bmpf_color_key);
+}
+
+static bool runner_colorize(bench_env_t *env, bench_run_t *run,
+    uint64_t size)
+{
+	return memgfx_runner(run, size, false, bmpf_color_key | bmpf_colorize);
+}
+
+benchmark_t benchmark_memgfx_fill = {
+	.name = "memgfx_fill",
+	.desc = "Fill rectangle in memory GC (one operation is one megapixel)",
+	.entry = &runner_fill,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_memgfx_copy = {
+	.name = "memgfx_copy",
+	.desc = "Render opaque bitmap in memory GC (one operation is one megapixel)",
+	.entry = &runner_copy,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_memgfx_key = {
+	.name = "memgfx_key",
+	.desc = "Render color-keyed bitmap in memory GC (one operation is one megapixel)",
+	.entry = &runner_key,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_memgfx_colorize = {
+	.name = "memgfx_colorize",
+	.desc = "Render colorized bitmap in memory GC (one operation is one megapixel)",
+	.entry = &runner_colorize,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -134,8 +134,14 @@ extern size_t benchmark_count;
 extern benchmark_t benchmark_dir_read;
 extern benchmark_t benchmark_fibril_mutex;
 extern benchmark_t benchmark_file_read;
+extern benchmark_t benchmark_inflate_expand;
+extern benchmark_t benchmark_inflate_stream;
 extern benchmark_t benchmark_malloc1;
 extern benchmark_t benchmark_malloc2;
+extern benchmark_t benchmark_memgfx_colorize;
+extern benchmark_t benchmark_memgfx_copy;
+extern benchmark_t benchmark_memgfx_fill;
+extern benchmark_t benchmark_memgfx_key;
 extern benchmark_t benchmark_ns_ping;
 extern benchmark_t benchmark_ping_pong;
 
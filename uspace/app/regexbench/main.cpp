@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Matches typical log filter patterns against every line of a log
+ * file and reports the throughput. Without a file a synthetic log
+ * is generated. The pathological patterns take exponential time
+ * with a backtracking matcher, here they run as fast as the rest.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct pattern
+    {
+        const char* name;
+        const char* expr;
+        std::regex::flag_type flags;
+        bool captures;
+    };
+
+    const pattern patterns[] = {
+        { "literal", "ERROR", std::regex::ECMAScript, false },
+        { "alternation", "\\[(ERROR|WARN)\\]", std::regex::ECMAScript, false },
+        { "icase", "timed out|refused", std::regex::icase, false },
+        { "repeat", "took [0-9]{4,} ms", std::regex::ECMAScript, false },
+        { "posix", "srv[[:digit:]]+: (GET|POST) /api", std::regex::extended, false },
+        { "captures", "\\[(\\w+)\\] (srv\\d+): .* from ([0-9.]+)$", std::regex::ECMAScript, true },
+        { "nested", "(a+a+)+b", std::regex::ECMAScript, false },
+        { "ambiguous", "(a|aa)*c", std::regex::ECMAScript, false }
+    };
+
+    const char* levels[] = { "INFO", "DEBUG", "WARN", "ERROR" };
+    const char* messages[] = {
+        "GET /api/items", "POST /api/login", "connection refused",
+        "request timed out", "cache miss", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+    };
+
+    void usage()
+    {
+        std::printf("Usage: regexbench [-n <lines>] [-r <rounds>] [<log file>]\n");
+    }
+
+    bool parse_number(const char* str, size_t& res)
+    {
+        res = 0;
+        if (!*str)
+            return false;
+
+        for (; *str; ++str)
+        {
+            if (*str < '0' || *str > '9')
+                return false;
+            res = res * 10 + static_cast<size_t>(*str - '0');
+        }
+
+        return true;
+    }
+
+    bool read_file(const char* path, std::string& data)
+    {
+        auto file = std::fopen(path, "rb");
+        if (!file)
+        {
+            std::printf("regexbench: cannot open %s\n", path);
+            return false;
+        }
+
+        char buf[4096];
+        size_t nread{};
+        while ((nread = std::fread(buf, 1, sizeof(buf), file)) > 0)
+            data.append(buf, nread);
+        std::fclose(file);
+
+        return true;
+    }
+
+    void generate(size_t lines, std::string& data)
+    {
+        unsigned int seed{1};
+        auto next = [&seed]{
+            seed = seed * 1103515245U + 12345U;
+            return seed >> 8;
+        };
+
+        char buf[256];
+        for (size_t i = 0; i < lines; ++i)
+        {
+            std::snprintf(
+                buf, sizeof(buf),
+                "2026-10-%02u 12:%02u:%02u.%03u [%s] srv%u: %s took %u ms from 10.0.%u.%u\n",
+                next() % 28 + 1, next() % 60, next() % 60, next() % 1000,
+                levels[next() % 4], next() % 16, messages[next() % 6],
+                next() % 5000, next() % 256, next() % 256
+            );
+            data.append(buf);
+        }
+    }
+
+    /**
+     * Splits the log into lines once, so that only the
+     * matching is measured. The data has to end with
+     * a newline, line i ends before the start of line i + 1.
+     */
+    void split_lines(const std::string& data, std::vector<const char*>& lines)
+    {
+        const char* first = data.data();
+        const char* last = first + data.size();
+
+        lines.push_back(first);
+        for (auto it = first; it != last; ++it)
+        {
+            if (*it == '\n')
+                lines.push_back(it + 1);
+        }
+    }
+
+    void run(const pattern& pat, const std::vector<const char*>& lines,
+             size_t bytes, size_t rounds)
+    {
+        std::regex re{pat.expr, pat.flags};
+        std::cmatch m{};
+        size_t hits{};
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r)
+        {
+            hits = 0;
+            for (size_t i = 0; i + 1 < lines.size(); ++i)
+            {
+                auto first = lines[i];
+                auto last = lines[i + 1] - 1;
+
+                if (pat.captures ? std::regex_search(first, last, m, re)
+                                 : std::regex_search(first, last, re))
+                    ++hits;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        if (usecs <= 0)
+            usecs = 1;
+
+        auto total = static_cast<unsigned long long>(bytes) * rounds;
+        std::printf("%-12s %8zu lines matched %8lld ms %6llu MB/s\n", pat.name, hits,
+                    static_cast<long long>(usecs / 1000), total / static_cast<unsigned long long>(usecs));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t gen_lines{100000};
+    size_t rounds{1};
+    const char* path{nullptr};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg{argv[i]};
+        if ((arg == "-n" || arg == "-r") && i + 1 < argc)
+        {
+            if (!parse_number(argv[++i], arg == "-n" ? gen_lines : rounds))
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (arg[0] != '-' && !path)
+            path = argv[i];
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    std::string data{};
+    if (path)
+    {
+        if (!read_file(path, data))
+            return 1;
+    }
+    else
+        generate(gen_lines, data);
+
+    if (!data.empty() && data.back() != '\n')
+        data.push_back('\n');
+
+    std::vector<const char*> lines{};
+    split_lines(data, lines);
+
+    std::printf("%zu lines, %zu bytes, %zu rounds\n", lines.size() - 1, data.size(), rounds);
+    for (const auto& pat: patterns)
+        run(pat, lines, data.size(), rounds);
+
+    return 0;
+}
@@ -48,6 +48,7 @@
 #include <io/concaps.h>
 #include <io/console.h>
 #include <io/pixelmap.h>
+#include <mem.h>
 #include <task.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -250,17 +251,96 @@ static void term_update_char(terminal_t *term, pixelmap_t *pixelmap,
 	term_update_region(term, bx, by, FONT_WIDTH, FONT_SCANLINES);
 }
 
+/** Scroll rows of the back buffer up.
+ *
+ * The characters and their pixels are moved up by @a delta rows. If
+ * @a gpos is not @c NULL, the pixels are also moved on the window GC,
+ * where the bitmap is displayed at @a gpos, so that they need not be
+ * rendered again. The rows at the bottom are left as they were.
+ *
+ * @param term Terminal
+ * @param pixelmap Pixel map of the terminal bitmap
+ * @param sx X coordinate of the character grid in the bitmap
+ * @param sy Y coordinate of the character grid in the bitmap
+ * @param delta Number of rows to scroll by
+ * @param gpos Position of the bitmap on the window GC or @c NULL
+ */
+static void term_scroll_rows(terminal_t *term, pixelmap_t *pixelmap,
+    sysarg_t sx, sysarg_t sy, sysarg_t delta, gfx_coord2_t *gpos)
+{
+	sysarg_t width = term->cols * FONT_WIDTH;
+	sysarg_t height = (term->rows - delta) * FONT_SCANLINES;
+	sysarg_t dy = delta * FONT_SCANLINES;
+	sysarg_t back_col;
+	sysarg_t back_row;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	errno_t rc;
+
+	for (sysarg_t row = 0; row < term->rows - delta; row++) {
+		for (sysarg_t col = 0; col < term->cols; col++) {
+			*chargrid_charfield_at(term->backbuf, col, row) =
+			    *chargrid_charfield_at(term->backbuf, col,
+			    row + delta);
+		}
+	}
+
+	for (sysarg_t y = 0; y < height; y++) {
+		memmove(pixelmap_pixel_at(pixelmap, sx, sy + y),
+		    pixelmap_pixel_at(pixelmap, sx, sy + y + dy),
+		    width * sizeof(pixel_t));
+	}
+
+	/*
+	 * Pixels pending in the update rectangle have not been rendered
+	 * yet, so the window only holds valid pixels if it is empty.
+	 */
+	rc = ENOTSUP;
+	if (gpos != NULL && gfx_rect_is_empty(&term->update)) {
+		rect.p0.x = gpos->x + sx;
+		rect.p0.y = gpos->y + sy + dy;
+		rect.p1.x = rect.p0.x + width;
+		rect.p1.y = rect.p0.y + height;
+		offs.x = 0;
+		offs.y = -dy;
+
+		rc = gfx_copy_area(term->gc, &rect, &offs);
+	}
+
+	if (rc != EOK)
+		term_update_region(term, sx, sy, width, height);
+
+	/* Cursor image moved with the pixels, redraw both affected cells */
+	if (chargrid_get_cursor_visibility(term->backbuf)) {
+		chargrid_get_cursor(term->backbuf, &back_col, &back_row);
+		if (back_row >= delta) {
+			term_update_char(term, pixelmap, sx, sy, back_col,
+			    back_row - delta);
+		}
+
+		term_update_char(term, pixelmap, sx, sy, back_col, back_row);
+	}
+}
+
 static bool term_update_scroll(terminal_t *term, pixelmap_t *pixelmap,
-    sysarg_t sx, sysarg_t sy)
+    sysarg_t sx, sysarg_t sy, gfx_coord2_t *gpos)
 {
 	sysarg_t top_row = chargrid_get_top_row(term->frontbuf);
+	sysarg_t delta;
 
 	if (term->top_row == top_row) {
 		return false;
 	}
 
+	delta = (top_row + term->rows - term->top_row) % term->rows;
 	term->top_row = top_row;
 
+	/*
+	 * Move the rows that are still visible, then only the newly
+	 * exposed rows will differ from the front buffer.
+	 */
+	term_scroll_rows(term, pixelmap, sx, sy, delta, gpos);
+
 	for (sysarg_t row = 0; row < term->rows; row++) {
 		for (sysarg_t col = 0; col < term->cols; col++) {
 			charfield_t *front_field =
@@ -347,7 +427,10 @@ static void term_update(terminal_t *term)
 	sysarg_t sx = 0;
 	sysarg_t sy = 0;
 
-	if (term_update_scroll(term, &pixelmap, sx, sy)) {
+	pos.x = 4;
+	pos.y = 26;
+
+	if (term_update_scroll(term, &pixelmap, sx, sy, &pos)) {
 		update = true;
 	} else {
 		for (sysarg_t y = 0; y < term->rows; y++) {
@@ -386,8 +469,6 @@ static void term_update(terminal_t *term)
 		update = true;
 
 	if (update) {
-		pos.x = 4;
-		pos.y = 26;
 		(void) gfx_bitmap_render(term->bmp, &term->update, &pos);
 
 		term->update.p0.x = 0;
@@ -420,7 +501,7 @@ static void term_repaint(terminal_t *term)
 	sysarg_t sx = 0;
 	sysarg_t sy = 0;
 
-	if (!term_update_scroll(term, &pixelmap, sx, sy)) {
+	if (!term_update_scroll(term, &pixelmap, sx, sy, NULL)) {
 		for (sysarg_t y = 0; y < term->rows; y++) {
 			for (sysarg_t x = 0; x < term->cols; x++) {
 				charfield_t *front_field =
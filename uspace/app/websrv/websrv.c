@@ -35,6 +35,7 @@
 
 #include <errno.h>
 #include <assert.h>
+#include <ctype.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -49,6 +50,8 @@
 #include <inet/tcp.h>
 
 #include <arg_parse.h>
+#include <deflate.h>
+#include <gzip.h>
 #include <macros.h>
 #include <str.h>
 #include <str_error.h>
@@ -93,6 +96,16 @@ static const char *msg_ok =
     "HTTP/1.0 200 OK\r\n"
     "\r\n";
 
+static const char *msg_ok_gzip =
+    "HTTP/1.0 200 OK\r\n"
+    "Content-Encoding: gzip\r\n"
+    "\r\n";
+
+/** Extensions of files which are not worth compressing */
+static const char *ext_compressed[] = {
+	".gif", ".gz", ".jpeg", ".jpg", ".png", ".zip"
+};
+
 static const char *msg_bad_request =
     "HTTP/1.0 400 Bad Request\r\n"
     "\r\n"
@@ -240,9 +253,55 @@ static errno_t send_response(tcp_conn_t *conn, const char *msg)
 	return EOK;
 }
 
-static errno_t uri_get(const char *uri, tcp_conn_t *conn)
+/** Determine whether it makes sense to compress the file */
+static bool uri_is_compressible(const char *uri)
+{
+	const char *ext = str_rchr(uri, '.');
+	if (ext == NULL)
+		return true;
+
+	for (size_t i = 0; i < sizeof(ext_compressed) /
+	    sizeof(ext_compressed[0]); i++) {
+		if (str_casecmp(ext, ext_compressed[i]) == 0)
+			return false;
+	}
+
+	return true;
+}
+
+/** Compress data and send the compressed data produced so far */
+static errno_t send_gzip(tcp_conn_t *conn, gzip_cstream_t *gs,
+    const char *buf, size_t len, bool finish, char *cbuf)
+{
+	size_t used, produced;
+	errno_t rc;
+
+	do {
+		rc = gzip_cstream(gs, buf, len, &used, cbuf, BUFFER_SIZE,
+		    &produced, finish);
+		if (rc != EOK)
+			return rc;
+
+		buf += used;
+		len -= used;
+
+		if (produced > 0) {
+			rc = tcp_conn_send(conn, cbuf, produced);
+			if (rc != EOK) {
+				fprintf(stderr, "tcp_conn_send() failed\n");
+				return rc;
+			}
+		}
+	} while (len > 0 || (finish && !gzip_cstream_done(gs)));
+
+	return EOK;
+}
+
+static errno_t uri_get(const char *uri, tcp_conn_t *conn, bool gzip)
 {
+	gzip_cstream_t *gs = NULL;
 	char *fbuf = NULL;
+	char *cbuf = NULL;
 	char *fname = NULL;
 	errno_t rc;
 	size_t nr;
@@ -257,6 +316,18 @@ static errno_t uri_get(const char *uri, tcp_conn_t *conn)
 	if (str_cmp(uri, "/") == 0)
 		uri = "/index.html";
 
+	if (gzip && uri_is_compressible(uri)) {
+		cbuf = calloc(BUFFER_SIZE, 1);
+		if (cbuf == NULL) {
+			rc = ENOMEM;
+			goto out;
+		}
+
+		rc = gzip_cstream_create(DEFLATE_LEVEL_DEFAULT, &gs);
+		if (rc != EOK)
+			goto out;
+	}
+
 	if (asprintf(&fname, "%s%s", WEB_ROOT, uri) < 0) {
 		rc = ENOMEM;
 		goto out;
@@ -271,7 +342,7 @@ static errno_t uri_get(const char *uri, tcp_conn_t *conn)
 	free(fname);
 	fname = NULL;
 
-	rc = send_response(conn, msg_ok);
+	rc = send_response(conn, gs != NULL ? msg_ok_gzip : msg_ok);
 	if (rc != EOK)
 		goto out;
 
@@ -281,9 +352,18 @@ static errno_t uri_get(const char *uri, tcp_conn_t *conn)
 		if (rc != EOK)
 			goto out;
 
+		if (gs != NULL) {
+			rc = send_gzip(conn, gs, fbuf, nr, nr == 0, cbuf);
+			if (rc != EOK)
+				goto out;
+		}
+
 		if (nr == 0)
 			break;
 
+		if (gs != NULL)
+			continue;
+
 		rc = tcp_conn_send(conn, fbuf, nr);
 		if (rc != EOK) {
 			fprintf(stderr, "tcp_conn_send() failed\n");
@@ -293,16 +373,128 @@ static errno_t uri_get(const char *uri, tcp_conn_t *conn)
 
 	rc = EOK;
 out:
+	if (gs != NULL)
+		gzip_cstream_destroy(gs);
 	if (fd >= 0)
 		vfs_put(fd);
 	free(fname);
+	free(cbuf);
 	free(fbuf);
 	return rc;
 }
 
+/** Determine whether a quality value is non-zero
+ *
+ * @param q Quality value (qvalue in RFC 7231)
+ * @return @c true if the value is valid and non-zero
+ */
+static bool qvalue_nonzero(const char *q)
+{
+	if (*q == '1')
+		return true;
+
+	if (*q != '0' || q[1] != '.')
+		return false;
+
+	for (q += 2; isdigit(*q); q++) {
+		if (*q != '0')
+			return true;
+	}
+
+	return false;
+}
+
+/** Determine whether gzip is an acceptable content coding
+ *
+ * The Accept-Encoding field value is a comma-separated list of content
+ * codings, each possibly followed by parameters. A coding with quality
+ * value 0 (e.g. "gzip;q=0") is not acceptable. An explicit gzip entry
+ * takes precedence over the "*" wildcard.
+ *
+ * @param value Accept-Encoding field value
+ * @return @c true if gzip encoding is acceptable
+ */
+static bool accepts_gzip(const char *value)
+{
+	const char *p = value;
+	const char *coding;
+	size_t len;
+	bool accept;
+	int gzip = -1;
+	int any = -1;
+
+	while (*p != '\0') {
+		while (isspace(*p) || *p == ',')
+			p++;
+
+		coding = p;
+		while (*p != '\0' && *p != ',' && *p != ';' && !isspace(*p))
+			p++;
+		len = p - coding;
+
+		/* Parameters, only the quality value is of interest */
+		accept = true;
+		while (*p != '\0' && *p != ',') {
+			if (*p == ';') {
+				p++;
+				while (isspace(*p))
+					p++;
+
+				if ((*p == 'q' || *p == 'Q') && p[1] == '=')
+					accept = qvalue_nonzero(p + 2);
+			} else {
+				p++;
+			}
+		}
+
+		if ((len == 4 && str_lcasecmp(coding, "gzip", 4) == 0) ||
+		    (len == 6 && str_lcasecmp(coding, "x-gzip", 6) == 0))
+			gzip = accept;
+		else if (len == 1 && *coding == '*')
+			any = accept;
+	}
+
+	if (gzip >= 0)
+		return gzip != 0;
+
+	return any > 0;
+}
+
+/** Receive request header fields
+ *
+ * @param recv Receive buffer
+ * @param gzip Place to store @c true if client accepts gzip encoding
+ */
+static errno_t req_headers(recv_t *recv, bool *gzip)
+{
+	char *line;
+	errno_t rc;
+
+	*gzip = false;
+
+	while (true) {
+		rc = recv_line(recv, &line);
+		if (rc != EOK) {
+			fprintf(stderr, "recv_line() failed\n");
+			return rc;
+		}
+
+		/* Empty line terminates the header */
+		if (str_cmp(line, "\r\n") == 0)
+			break;
+
+		if (str_lcasecmp(line, "Accept-Encoding:", 16) == 0)
+			*gzip = accepts_gzip(line + 16);
+	}
+
+	return EOK;
+}
+
 static errno_t req_process(tcp_conn_t *conn, recv_t *recv)
 {
 	char *reqline = NULL;
+	char *uri_dup;
+	bool gzip = false;
 
 	errno_t rc = recv_line(recv, &reqline);
 	if (rc != EOK) {
@@ -320,9 +512,12 @@ static errno_t req_process(tcp_conn_t *conn, recv_t *recv)
 
 	char *uri = reqline + 4;
 	char *end_uri = str_chr(uri, ' ');
+	bool simple = false;
 	if (end_uri == NULL) {
+		/* Simple request without version and header */
 		end_uri = reqline + str_size(reqline) - 2;
 		assert(*end_uri == '\r');
+		simple = true;
 	}
 
 	*end_uri = '\0';
@@ -334,7 +529,22 @@ static errno_t req_process(tcp_conn_t *conn, recv_t *recv)
 		return rc;
 	}
 
-	return uri_get(uri, conn);
+	/* The line buffer is reused for the header fields */
+	uri_dup = str_dup(uri);
+	if (uri_dup == NULL)
+		return ENOMEM;
+
+	if (!simple) {
+		rc = req_headers(recv, &gzip);
+		if (rc != EOK) {
+			free(uri_dup);
+			return rc;
+		}
+	}
+
+	rc = uri_get(uri_dup, conn, gzip);
+	free(uri_dup);
+	return rc;
 }
 
 static void usage(void)
@@ -49,7 +49,6 @@
 #include <gfx/bitmap.h>
 #include <gfx/color.h>
 #include <gfx/coord.h>
-#include <io/pixelmap.h>
 #include <ipcgfx/server.h>
 #include <mem.h>
 #include <pixconv.h>
@@ -73,9 +72,7 @@ typedef struct {
 	size_t scanline;
 	visual_t visual;
 
-	pixel2visual_t pixel2visual;
-	visual2pixel_t visual2pixel;
-	visual_mask_t visual_mask;
+	pixel2visual_row_t pixel2visual_row;
 	size_t pixel_bytes;
 
 	size_t size;
@@ -188,16 +185,15 @@ static errno_t kfb_gc_fill_rect(void *arg, gfx_rect_t *rect)
 {
 	kfb_t *kfb = (kfb_t *) arg;
 	gfx_rect_t crect;
-	gfx_coord_t x, y;
+	gfx_coord_t y;
 
 	/* Make sure we have a sorted, clipped rectangle */
 	gfx_rect_clip(rect, &kfb->rect, &crect);
 
 	for (y = crect.p0.y; y < crect.p1.y; y++) {
-		for (x = crect.p0.x; x < crect.p1.x; x++) {
-			kfb->pixel2visual(kfb->addr + FB_POS(kfb, x, y),
-			    kfb->color);
-		}
+		pixconv_fill_row(kfb->visual,
+		    kfb->addr + FB_POS(kfb, crect.p0.x, y), kfb->color,
+		    crect.p1.x - crect.p0.x);
 	}
 
 	return EOK;
@@ -282,17 +278,17 @@ static errno_t kfb_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 	kfb_bitmap_t *kfbbm = (kfb_bitmap_t *)bm;
 	kfb_t *kfb = kfbbm->kfb;
 	gfx_rect_t srect;
-	gfx_rect_t drect;
 	gfx_rect_t skfbrect;
 	gfx_rect_t crect;
 	gfx_coord2_t offs;
-	gfx_coord2_t bmdim;
-	gfx_coord2_t dim;
 	gfx_coord2_t sp;
 	gfx_coord2_t dp;
-	gfx_coord2_t pos;
-	pixelmap_t pbm;
-	pixel_t color;
+	gfx_coord_t width;
+	gfx_coord_t run;
+	gfx_coord_t x;
+	gfx_coord_t y;
+	pixel_t *src;
+	uint8_t *dst;
 
 	/* Clip source rectangle to bitmap bounds */
 
@@ -308,15 +304,6 @@ static errno_t kfb_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 		offs.y = 0;
 	}
 
-	/* Destination rectangle */
-	gfx_rect_translate(&offs, &srect, &drect);
-	gfx_coord2_subtract(&drect.p1, &drect.p0, &dim);
-	gfx_coord2_subtract(&kfbbm->rect.p1, &kfbbm->rect.p0, &bmdim);
-
-	pbm.width = bmdim.x;
-	pbm.height = bmdim.y;
-	pbm.data = kfbbm->alloc.pixels;
-
 	/* Transform KFB bounding rectangle back to bitmap coordinate system */
 	gfx_rect_rtranslate(&offs, &kfb->rect, &skfbrect);
 
@@ -326,42 +313,37 @@ static errno_t kfb_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 	 */
 	gfx_rect_clip(&srect, &skfbrect, &crect);
 
-	if ((kfbbm->flags & bmpf_color_key) != 0) {
-		/* Simple copy */
-		for (pos.y = crect.p0.y; pos.y < crect.p1.y; pos.y++) {
-			for (pos.x = crect.p0.x; pos.x < crect.p1.x; pos.x++) {
-				gfx_coord2_subtract(&pos, &kfbbm->rect.p0, &sp);
-				gfx_coord2_add(&pos, &offs, &dp);
-
-				color = pixelmap_get_pixel(&pbm, sp.x, sp.y);
-				if (color != kfbbm->key_color) {
-					kfb->pixel2visual(kfb->addr +
-					    FB_POS(kfb, dp.x, dp.y), color);
-				}
-			}
-		}
-	} else if ((kfbbm->flags & bmpf_colorize) != 0) {
-		/* Color key */
-		for (pos.y = crect.p0.y; pos.y < crect.p1.y; pos.y++) {
-			for (pos.x = crect.p0.x; pos.x < crect.p1.x; pos.x++) {
-				gfx_coord2_subtract(&pos, &kfbbm->rect.p0, &sp);
-				gfx_coord2_add(&pos, &offs, &dp);
-
-				color = pixelmap_get_pixel(&pbm, sp.x, sp.y);
-				kfb->pixel2visual(kfb->addr +
-				    FB_POS(kfb, dp.x, dp.y), color);
-			}
+	if (gfx_rect_is_empty(&crect))
+		return EOK;
+
+	width = crect.p1.x - crect.p0.x;
+	gfx_coord2_subtract(&crect.p0, &kfbbm->rect.p0, &sp);
+	gfx_coord2_add(&crect.p0, &offs, &dp);
+
+	for (y = 0; y < crect.p1.y - crect.p0.y; y++) {
+		src = (pixel_t *) ((uint8_t *) kfbbm->alloc.pixels +
+		    (sp.y + y) * kfbbm->alloc.pitch) + sp.x;
+		dst = kfb->addr + FB_POS(kfb, dp.x, dp.y + y);
+
+		if ((kfbbm->flags & bmpf_color_key) == 0) {
+			/* Simple copy */
+			kfb->pixel2visual_row(dst, src, width);
+			continue;
 		}
-	} else {
-		/* Color key & colorize */
-		for (pos.y = crect.p0.y; pos.y < crect.p1.y; pos.y++) {
-			for (pos.x = crect.p0.x; pos.x < crect.p1.x; pos.x++) {
-				gfx_coord2_subtract(&pos, &kfbbm->rect.p0, &sp);
-				gfx_coord2_add(&pos, &offs, &dp);
-
-				color = pixelmap_get_pixel(&pbm, sp.x, sp.y);
-				kfb->pixel2visual(kfb->addr +
-				    FB_POS(kfb, dp.x, dp.y), color);
+
+		/* Color key: convert each run of non-key pixels at once */
+		x = 0;
+		while (x < width) {
+			while (x < width && src[x] == kfbbm->key_color)
+				++x;
+
+			run = x;
+			while (x < width && src[x] != kfbbm->key_color)
+				++x;
+
+			if (x > run) {
+				kfb->pixel2visual_row(dst +
+				    run * kfb->pixel_bytes, src + run, x - run);
 			}
 		}
 	}
@@ -523,76 +505,10 @@ errno_t port_init(ddf_dev_t *dev)
 	kfb->scanline = scanline;
 	kfb->visual = visual;
 
-	switch (visual) {
-	case VISUAL_INDIRECT_8:
-		kfb->pixel2visual = pixel2bgr_323;
-		kfb->visual2pixel = bgr_323_2pixel;
-		kfb->visual_mask = visual_mask_323;
-		kfb->pixel_bytes = 1;
-		break;
-	case VISUAL_RGB_5_5_5_LE:
-		kfb->pixel2visual = pixel2rgb_555_le;
-		kfb->visual2pixel = rgb_555_le_2pixel;
-		kfb->visual_mask = visual_mask_555;
-		kfb->pixel_bytes = 2;
-		break;
-	case VISUAL_RGB_5_5_5_BE:
-		kfb->pixel2visual = pixel2rgb_555_be;
-		kfb->visual2pixel = rgb_555_be_2pixel;
-		kfb->visual_mask = visual_mask_555;
-		kfb->pixel_bytes = 2;
-		break;
-	case VISUAL_RGB_5_6_5_LE:
-		kfb->pixel2visual = pixel2rgb_565_le;
-		kfb->visual2pixel = rgb_565_le_2pixel;
-		kfb->visual_mask = visual_mask_565;
-		kfb->pixel_bytes = 2;
-		break;
-	case VISUAL_RGB_5_6_5_BE:
-		kfb->pixel2visual = pixel2rgb_565_be;
-		kfb->visual2pixel = rgb_565_be_2pixel;
-		kfb->visual_mask = visual_mask_565;
-		kfb->pixel_bytes = 2;
-		break;
-	case VISUAL_RGB_8_8_8:
-		kfb->pixel2visual = pixel2rgb_888;
-		kfb->visual2pixel = rgb_888_2pixel;
-		kfb->visual_mask = visual_mask_888;
-		kfb->pixel_bytes = 3;
-		break;
-	case VISUAL_BGR_8_8_8:
-		kfb->pixel2visual = pixel2bgr_888;
-		kfb->visual2pixel = bgr_888_2pixel;
-		kfb->visual_mask = visual_mask_888;
-		kfb->pixel_bytes = 3;
-		break;
-	case VISUAL_RGB_8_8_8_0:
-		kfb->pixel2visual = pixel2rgb_8880;
-		kfb->visual2pixel = rgb_8880_2pixel;
-		kfb->visual_mask = visual_mask_8880;
-		kfb->pixel_bytes = 4;
-		break;
-	case VISUAL_RGB_0_8_8_8:
-		kfb->pixel2visual = pixel2rgb_0888;
-		kfb->visual2pixel = rgb_0888_2pixel;
-		kfb->visual_mask = visual_mask_0888;
-		kfb->pixel_bytes = 4;
-		break;
-	case VISUAL_BGR_0_8_8_8:
-		kfb->pixel2visual = pixel2bgr_0888;
-		kfb->visual2pixel = bgr_0888_2pixel;
-		kfb->visual_mask = visual_mask_0888;
-		kfb->pixel_bytes = 4;
-		break;
-	case VISUAL_BGR_8_8_8_0:
-		kfb->pixel2visual = pixel2bgr_8880;
-		kfb->visual2pixel = bgr_8880_2pixel;
-		kfb->visual_mask = visual_mask_8880;
-		kfb->pixel_bytes = 4;
-		break;
-	default:
+	kfb->pixel_bytes = pixconv_visual_bytes(visual);
+	kfb->pixel2visual_row = pixconv_row_func(visual);
+	if (kfb->pixel_bytes == 0)
 		return EINVAL;
-	}
 
 	kfb->size = scanline * height;
 	kfb->addr = AS_AREA_ANY;
@@ -54,15 +54,41 @@
 #include <str_error.h>
 #include <offset.h>
 #include <inttypes.h>
+#include <stats.h>
+#include <stdatomic.h>
+#include <time.h>
 #include "block.h"
 
 #define MAX_WRITE_RETRIES 10
 
+/** Share of the available physical memory the caches may use (1/n). */
+#define CACHE_BUDGET_SHARE	4
+/** Minimum size of the cache budget in bytes. */
+#define CACHE_BUDGET_MIN	(256 * 1024)
+/** Interval between physical memory statistics queries in seconds. */
+#define CACHE_BUDGET_INTERVAL	1
+/** Maximum number of blocks released by one reclaim pass. */
+#define CACHE_RECLAIM_BATCH	8
+
 /** Lock protecting the device connection list */
 static FIBRIL_MUTEX_INITIALIZE(dcl_lock);
 /** Device connection list head. */
 static LIST_INITIALIZE(dcl);
 
+/** Number of bytes held by the caches of all devices. */
+static atomic_size_t cache_bytes = 0;
+/** Stamp source for the global LRU order of released blocks. */
+static atomic_uint_fast64_t cache_clock = 0;
+
+/** Lock protecting the cache budget update time */
+static FIBRIL_MUTEX_INITIALIZE(budget_lock);
+/** Number of bytes the caches of all devices may hold. */
+static atomic_size_t cache_budget = CACHE_BUDGET_MIN;
+/** Time of the last cache budget update. */
+static struct timespec cache_budget_time;
+/** Cache budget has been computed at least once. */
+static bool cache_budget_valid = false;
+
 typedef struct {
 	fibril_mutex_t lock;
 	size_t lblock_size;       /**< Logical block size. */
@@ -319,8 +345,11 @@ errno_t block_cache_fini(service_id_t service_id)
 	/*
 	 * We are expecting to find all blocks for this device handle on the
 	 * free list, i.e. the block reference count should be zero. Do not
-	 * bother with the cache and block locks because we are single-threaded.
+	 * bother with the block locks because we are single-threaded, but
+	 * hold the cache lock as reclaim on behalf of other devices may
+	 * still be scanning the free list.
 	 */
+	fibril_mutex_lock(&cache->lock);
 	while (!list_empty(&cache->free_list)) {
 		block_t *b = list_get_instance(list_first(&cache->free_list),
 		    block_t, free_link);
@@ -329,32 +358,182 @@ errno_t block_cache_fini(service_id_t service_id)
 		if (b->dirty) {
 			rc = write_blocks(devcon, b->pba, cache->blocks_cluster,
 			    b->data, b->size);
-			if (rc != EOK)
+			if (rc != EOK) {
+				list_prepend(&b->free_link, &cache->free_list);
+				fibril_mutex_unlock(&cache->lock);
 				return rc;
+			}
 		}
 
 		hash_table_remove_item(&cache->block_hash, &b->hash_link);
 
 		free(b->data);
 		free(b);
+		cache->blocks_cached--;
+		atomic_fetch_sub(&cache_bytes, cache->lblock_size);
 	}
 
-	hash_table_destroy(&cache->block_hash);
+	fibril_mutex_unlock(&cache->lock);
+
+	/* Make the cache unreachable for reclaim */
+	fibril_mutex_lock(&dcl_lock);
 	devcon->cache = NULL;
+	fibril_mutex_unlock(&dcl_lock);
+
+	hash_table_destroy(&cache->block_hash);
 	free(cache);
 
 	return EOK;
 }
 
+/** Update the number of bytes the caches of all devices may hold.
+ *
+ * The budget is a share of the physical memory which is either free or
+ * already used by the caches, so the caches shrink when other tasks
+ * put the system under memory pressure and grow into otherwise unused
+ * memory. The physical memory statistics are queried at most once per
+ * CACHE_BUDGET_INTERVAL.
+ *
+ * Querying the statistics involves IPC, so this must not be called with
+ * a cache lock held.
+ */
+static void cache_update_budget(void)
+{
+	struct timespec now;
+
+	getuptime(&now);
+
+	fibril_mutex_lock(&budget_lock);
+	if (cache_budget_valid &&
+	    NSEC2SEC(ts_sub_diff(&now, &cache_budget_time)) <
+	    CACHE_BUDGET_INTERVAL) {
+		fibril_mutex_unlock(&budget_lock);
+		return;
+	}
+
+	/* Others keep using the current budget until we are done */
+	cache_budget_time = now;
+	cache_budget_valid = true;
+	fibril_mutex_unlock(&budget_lock);
+
+	stats_physmem_t *physmem = stats_get_physmem();
+	if (physmem == NULL)
+		return;
+
+	uint64_t avail = physmem->free + atomic_load(&cache_bytes);
+	uint64_t share = avail / CACHE_BUDGET_SHARE;
+	free(physmem);
+
+	atomic_store(&cache_budget, max(min(share, SIZE_MAX),
+	    CACHE_BUDGET_MIN));
+}
+
+/** Get the number of bytes the caches of all devices may hold.
+ *
+ * Only the value computed by the last cache_update_budget() is used,
+ * so this may be called with cache locks held.
+ *
+ * @return Cache budget in bytes.
+ */
+static size_t cache_get_budget(void)
+{
+	return atomic_load(&cache_budget);
+}
+
 #define CACHE_LO_WATERMARK	10
 #define CACHE_HI_WATERMARK	20
 static bool cache_can_grow(cache_t *cache)
 {
 	if (cache->blocks_cached < CACHE_LO_WATERMARK)
 		return true;
-	if (!list_empty(&cache->free_list))
+	if (list_empty(&cache->free_list))
+		return true;
+	return atomic_load(&cache_bytes) + cache->lblock_size <=
+	    cache_get_budget();
+}
+
+/** Check whether a cache should give blocks back.
+ *
+ * Every cache is allowed to keep CACHE_HI_WATERMARK blocks, beyond that
+ * the blocks are released once all caches together exceed the budget.
+ */
+static bool cache_over_budget(cache_t *cache)
+{
+	if (cache->blocks_cached <= CACHE_HI_WATERMARK)
 		return false;
-	return true;
+	return atomic_load(&cache_bytes) > cache_get_budget();
+}
+
+/** Release least recently used blocks of all devices.
+ *
+ * The free lists of the caches are ordered by the time of the last
+ * release of the block, so the heads of the lists are compared and the
+ * globally oldest clean block is freed until the caches fit into the
+ * budget. Thus a busy device can take over the memory of an idle one.
+ */
+static void cache_reclaim(void)
+{
+	for (unsigned i = 0; i < CACHE_RECLAIM_BATCH; i++) {
+		if (atomic_load(&cache_bytes) <= cache_get_budget())
+			return;
+
+		fibril_mutex_lock(&dcl_lock);
+
+		cache_t *victim = NULL;
+		uint64_t victim_stamp = UINT64_MAX;
+
+		list_foreach(dcl, link, devcon_t, devcon) {
+			cache_t *cache = devcon->cache;
+			if (cache == NULL)
+				continue;
+
+			fibril_mutex_lock(&cache->lock);
+			if ((cache->blocks_cached > CACHE_HI_WATERMARK) &&
+			    !list_empty(&cache->free_list)) {
+				block_t *b = list_get_instance(
+				    list_first(&cache->free_list), block_t,
+				    free_link);
+				if (!b->dirty && b->lru_stamp < victim_stamp) {
+					victim = cache;
+					victim_stamp = b->lru_stamp;
+				}
+			}
+			fibril_mutex_unlock(&cache->lock);
+		}
+
+		if (victim == NULL) {
+			fibril_mutex_unlock(&dcl_lock);
+			return;
+		}
+
+		/* The free list could have changed, recheck the head */
+		fibril_mutex_lock(&victim->lock);
+		block_t *b = NULL;
+		if ((victim->blocks_cached > CACHE_HI_WATERMARK) &&
+		    !list_empty(&victim->free_list)) {
+			b = list_get_instance(list_first(&victim->free_list),
+			    block_t, free_link);
+			if (b->dirty || !fibril_mutex_trylock(&b->lock))
+				b = NULL;
+		}
+
+		if (b != NULL) {
+			list_remove(&b->free_link);
+			hash_table_remove_item(&victim->block_hash,
+			    &b->hash_link);
+			fibril_mutex_unlock(&b->lock);
+			free(b->data);
+			free(b);
+			victim->blocks_cached--;
+			atomic_fetch_sub(&cache_bytes, victim->lblock_size);
+		}
+
+		fibril_mutex_unlock(&victim->lock);
+		fibril_mutex_unlock(&dcl_lock);
+
+		if (b == NULL)
+			return;
+	}
 }
 
 static void block_initialize(block_t *b)
@@ -364,6 +543,7 @@ static void block_initialize(block_t *b)
 	b->write_failures = 0;
 	b->dirty = false;
 	b->toxic = false;
+	b->lru_stamp = 0;
 	fibril_rwlock_initialize(&b->contents_lock);
 	link_initialize(&b->free_link);
 }
@@ -407,6 +587,8 @@ errno_t block_get(block_t **block, service_id_t service_id, aoff64_t ba, int fla
 		return EIO;
 	}
 
+	cache_update_budget();
+
 retry:
 	rc = EOK;
 	b = NULL;
@@ -446,6 +628,7 @@ retry:
 				goto recycle;
 			}
 			cache->blocks_cached++;
+			atomic_fetch_add(&cache_bytes, cache->lblock_size);
 		} else {
 			/*
 			 * Try to recycle a block from the free list.
@@ -581,7 +764,7 @@ errno_t block_put(block_t *block)
 {
 	devcon_t *devcon = devcon_search(block->service_id);
 	cache_t *cache;
-	unsigned blocks_cached;
+	bool over_budget;
 	enum cache_mode mode;
 	errno_t rc = EOK;
 
@@ -591,9 +774,11 @@ errno_t block_put(block_t *block)
 
 	cache = devcon->cache;
 
+	cache_update_budget();
+
 retry:
 	fibril_mutex_lock(&cache->lock);
-	blocks_cached = cache->blocks_cached;
+	over_budget = cache_over_budget(cache);
 	mode = cache->mode;
 	fibril_mutex_unlock(&cache->lock);
 
@@ -601,14 +786,14 @@ retry:
 	 * Determine whether to sync the block. Syncing the block is best done
 	 * when not holding the cache lock as it does not impede concurrency.
 	 * Since the situation may have changed when we unlocked the cache, the
-	 * blocks_cached and mode variables are mere hints. We will recheck the
+	 * over_budget and mode variables are mere hints. We will recheck the
 	 * conditions later when the cache lock is held again.
 	 */
 	fibril_mutex_lock(&block->lock);
 	if (block->toxic)
 		block->dirty = false;	/* will not write back toxic block */
 	if (block->dirty && (block->refcnt == 1) &&
-	    (blocks_cached > CACHE_HI_WATERMARK || mode != CACHE_MODE_WB)) {
+	    (over_budget || mode != CACHE_MODE_WB)) {
 		rc = write_blocks(devcon, block->pba, cache->blocks_cluster,
 		    block->data, block->size);
 		if (rc == EOK)
@@ -625,8 +810,7 @@ retry:
 		 * block or put it on the free list. In case of an I/O error,
 		 * free the block.
 		 */
-		if ((cache->blocks_cached > CACHE_HI_WATERMARK) ||
-		    (rc != EOK)) {
+		if (cache_over_budget(cache) || (rc != EOK)) {
 			/*
 			 * Currently there are too many cached blocks or there
 			 * was an I/O error when writing the block back to the
@@ -659,7 +843,9 @@ retry:
 			free(block->data);
 			free(block);
 			cache->blocks_cached--;
+			atomic_fetch_sub(&cache_bytes, cache->lblock_size);
 			fibril_mutex_unlock(&cache->lock);
+			cache_reclaim();
 			return rc;
 		}
 		/*
@@ -675,11 +861,13 @@ retry:
 			fibril_mutex_unlock(&cache->lock);
 			goto retry;
 		}
+		block->lru_stamp = atomic_fetch_add(&cache_clock, 1);
 		list_append(&block->free_link, &cache->free_list);
 	}
 	fibril_mutex_unlock(&block->lock);
 	fibril_mutex_unlock(&cache->lock);
 
+	cache_reclaim();
 	return rc;
 }
 
@@ -82,6 +82,8 @@ typedef struct block {
 	size_t size;
 	/** Number of write failures. */
 	int write_failures;
+	/** Global LRU order of the last release of the block. */
+	uint64_t lru_stamp;
 	/** Link for placing the block into the free block list. */
 	link_t free_link;
 	/** Link for placing the block into the block hash table. */
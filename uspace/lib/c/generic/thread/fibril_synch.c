@@ -168,14 +168,37 @@ void fibril_mutex_initialize(fibril_mutex_t *fm)
 	list_initialize(&fm->waiters);
 }
 
+/*
+ * The mutex counter is 1 when the mutex is free, 0 when it is locked and
+ * negative when there are fibrils waiting for it. Waiters only ever enqueue
+ * themselves with fibril_synch_futex held, so an uncontended lock (1 -> 0)
+ * or unlock (0 -> 1) can be done with a single atomic operation on the
+ * counter without touching the futex, the same way futex_down() and
+ * futex_up() avoid the kernel.
+ */
+
+static bool _fibril_mutex_trylock_fast(fibril_mutex_t *fm, fibril_t *f)
+{
+	int expected = 1;
+	if (!__atomic_compare_exchange_n(&fm->counter, &expected, 0, false,
+	    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		return false;
+
+	__atomic_store_n(&fm->oi.owned_by, f, __ATOMIC_RELAXED);
+	return true;
+}
+
 void fibril_mutex_lock(fibril_mutex_t *fm)
 {
 	fibril_t *f = (fibril_t *) fibril_get_id();
 
+	if (_fibril_mutex_trylock_fast(fm, f))
+		return;
+
 	futex_lock(&fibril_synch_futex);
 
-	if (fm->counter-- > 0) {
-		fm->oi.owned_by = f;
+	if (__atomic_fetch_sub(&fm->counter, 1, __ATOMIC_ACQUIRE) > 0) {
+		__atomic_store_n(&fm->oi.owned_by, f, __ATOMIC_RELAXED);
 		futex_unlock(&fibril_synch_futex);
 		return;
 	}
@@ -190,41 +213,114 @@ void fibril_mutex_lock(fibril_mutex_t *fm)
 	fibril_wait_for(&wdata.event);
 }
 
-bool fibril_mutex_trylock(fibril_mutex_t *fm)
+/**
+ * Lock the mutex, giving up after the timeout expires.
+ *
+ * @param fm       Mutex to lock.
+ * @param timeout  Timeout in microseconds, zero means no timeout and
+ *                 a negative value only tries to lock the mutex.
+ *
+ * @return EOK if the mutex was locked, ETIMEOUT otherwise.
+ */
+errno_t fibril_mutex_lock_timeout(fibril_mutex_t *fm, usec_t timeout)
 {
-	bool locked = false;
+	fibril_t *f = (fibril_t *) fibril_get_id();
+
+	if (_fibril_mutex_trylock_fast(fm, f))
+		return EOK;
+
+	if (timeout < 0)
+		return ETIMEOUT;
+
+	struct timespec ts;
+	struct timespec *expires = NULL;
+	if (timeout) {
+		getuptime(&ts);
+		ts_add_diff(&ts, USEC2NSEC(timeout));
+		expires = &ts;
+	}
 
 	futex_lock(&fibril_synch_futex);
-	if (fm->counter > 0) {
-		fm->counter--;
-		fm->oi.owned_by = (fibril_t *) fibril_get_id();
-		locked = true;
+
+	if (__atomic_fetch_sub(&fm->counter, 1, __ATOMIC_ACQUIRE) > 0) {
+		__atomic_store_n(&fm->oi.owned_by, f, __ATOMIC_RELAXED);
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
 	}
+
+	awaiter_t wdata = AWAITER_INIT;
+	list_append(&wdata.link, &fm->waiters);
+	check_for_deadlock(&fm->oi);
+	f->waits_for = &fm->oi;
+
 	futex_unlock(&fibril_synch_futex);
 
-	return locked;
+	errno_t rc = fibril_wait_timeout(&wdata.event, expires);
+	if (rc == EOK)
+		return EOK;
+
+	futex_lock(&fibril_synch_futex);
+	if (!link_in_use(&wdata.link)) {
+		/* The mutex was handed over to us after all. */
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	/*
+	 * We are still on the list, so the mutex is held by someone else
+	 * and the counter stays at or below zero after we leave.
+	 */
+	list_remove(&wdata.link);
+	f->waits_for = NULL;
+	__atomic_fetch_add(&fm->counter, 1, __ATOMIC_RELAXED);
+	futex_unlock(&fibril_synch_futex);
+
+	return ETIMEOUT;
+}
+
+bool fibril_mutex_trylock(fibril_mutex_t *fm)
+{
+	return _fibril_mutex_trylock_fast(fm, (fibril_t *) fibril_get_id());
 }
 
 static void _fibril_mutex_unlock_unsafe(fibril_mutex_t *fm)
 {
 	assert(fm->oi.owned_by == (fibril_t *) fibril_get_id());
 
-	if (fm->counter++ < 0) {
+	/*
+	 * Clear the owner before releasing the counter, once it is
+	 * released the mutex can be taken by the fast path at any time.
+	 */
+	__atomic_store_n(&fm->oi.owned_by, NULL, __ATOMIC_RELAXED);
+
+	if (__atomic_fetch_add(&fm->counter, 1, __ATOMIC_RELEASE) < 0) {
 		awaiter_t *wdp = list_pop(&fm->waiters, awaiter_t, link);
 		assert(wdp);
 
 		fibril_t *f = (fibril_t *) wdp->fid;
-		fm->oi.owned_by = f;
+		__atomic_store_n(&fm->oi.owned_by, f, __ATOMIC_RELAXED);
 		f->waits_for = NULL;
 
 		fibril_notify(&wdp->event);
-	} else {
-		fm->oi.owned_by = NULL;
 	}
 }
 
 void fibril_mutex_unlock(fibril_mutex_t *fm)
 {
+	fibril_t *f = (fibril_t *) fibril_get_id();
+
+	assert(fm->oi.owned_by == f);
+
+	/* Nobody is waiting, hand the mutex back without the futex. */
+	__atomic_store_n(&fm->oi.owned_by, NULL, __ATOMIC_RELAXED);
+
+	int expected = 0;
+	if (__atomic_compare_exchange_n(&fm->counter, &expected, 1, false,
+	    __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		return;
+
+	__atomic_store_n(&fm->oi.owned_by, f, __ATOMIC_RELAXED);
+
 	futex_lock(&fibril_synch_futex);
 	_fibril_mutex_unlock_unsafe(fm);
 	futex_unlock(&fibril_synch_futex);
@@ -422,9 +518,13 @@ fibril_condvar_wait_timeout(fibril_condvar_t *fcv, fibril_mutex_t *fm,
 		expires = &ts;
 	}
 
+	/*
+	 * Enqueue before releasing the mutex, so that anyone who locks the
+	 * mutex afterwards also sees the waiter in fibril_condvar_signal().
+	 */
 	futex_lock(&fibril_synch_futex);
-	_fibril_mutex_unlock_unsafe(fm);
 	list_append(&wdata.link, &fcv->waiters);
+	_fibril_mutex_unlock_unsafe(fm);
 	futex_unlock(&fibril_synch_futex);
 
 	(void) fibril_wait_timeout(&wdata.event, expires);
@@ -444,8 +544,23 @@ void fibril_condvar_wait(fibril_condvar_t *fcv, fibril_mutex_t *fm)
 	(void) fibril_condvar_wait_timeout(fcv, fm, 0);
 }
 
+/*
+ * Waiters are only added with the futex held, before they release their
+ * mutex. A signal that is ordered after a waiter went to sleep (typically
+ * by locking the same mutex) therefore always sees a non-empty list and
+ * signals without waiters can skip the futex altogether.
+ */
+static bool _fibril_condvar_has_waiters(fibril_condvar_t *fcv)
+{
+	return __atomic_load_n(&fcv->waiters.head.next, __ATOMIC_ACQUIRE) !=
+	    &fcv->waiters.head;
+}
+
 void fibril_condvar_signal(fibril_condvar_t *fcv)
 {
+	if (!_fibril_condvar_has_waiters(fcv))
+		return;
+
 	futex_lock(&fibril_synch_futex);
 
 	awaiter_t *w = list_pop(&fcv->waiters, awaiter_t, link);
@@ -457,6 +572,9 @@ void fibril_condvar_signal(fibril_condvar_t *fcv)
 
 void fibril_condvar_broadcast(fibril_condvar_t *fcv)
 {
+	if (!_fibril_condvar_has_waiters(fcv))
+		return;
+
 	futex_lock(&fibril_synch_futex);
 
 	awaiter_t *w;
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file File access for C++
+ */
+
+#include <errno.h>
+#include <vfs/file.h>
+#include <vfs/vfs.h>
+
+/** Open file.
+ *
+ * @param path Path of the file
+ * @param flags Combination of VFS_FILE_* flags
+ * @param rfd Place to store the file descriptor
+ * @return EOK on success or an error code
+ */
+errno_t vfs_file_open(const char *path, int flags, int *rfd)
+{
+	int walk = WALK_REGULAR;
+	int mode = 0;
+	int fd;
+	errno_t rc;
+
+	if ((flags & VFS_FILE_READ) != 0)
+		mode |= MODE_READ;
+	if ((flags & VFS_FILE_WRITE) != 0)
+		mode |= MODE_WRITE;
+	if ((flags & VFS_FILE_APPEND) != 0)
+		mode |= MODE_APPEND;
+	if ((flags & VFS_FILE_CREATE) != 0)
+		walk |= WALK_MAY_CREATE;
+
+	rc = vfs_lookup_open(path, walk, mode, &fd);
+	if (rc != EOK)
+		return rc;
+
+	if ((flags & VFS_FILE_TRUNCATE) != 0) {
+		rc = vfs_resize(fd, 0);
+		if (rc != EOK) {
+			vfs_put(fd);
+			return rc;
+		}
+	}
+
+	*rfd = fd;
+	return EOK;
+}
+
+/** Close file.
+ *
+ * @param fd File descriptor
+ * @return EOK on success or an error code
+ */
+errno_t vfs_file_close(int fd)
+{
+	return vfs_put(fd);
+}
+
+/** Read from file.
+ *
+ * @param fd File descriptor
+ * @param pos Position to read from, updated by the number of bytes read
+ * @param buf Buffer
+ * @param size Number of bytes to read
+ * @param nread Place to store the number of bytes read, also on error
+ * @return EOK on success or an error code
+ */
+errno_t vfs_file_read(int fd, aoff64_t *pos, void *buf, size_t size,
+    size_t *nread)
+{
+	return vfs_read(fd, pos, buf, size, nread);
+}
+
+/** Write to file.
+ *
+ * @param fd File descriptor
+ * @param pos Position to write to, updated by the number of bytes written
+ * @param buf Data
+ * @param size Number of bytes to write
+ * @param nwritten Place to store the number of bytes written, also on error
+ * @return EOK on success or an error code
+ */
+errno_t vfs_file_write(int fd, aoff64_t *pos, const void *buf, size_t size,
+    size_t *nwritten)
+{
+	return vfs_write(fd, pos, buf, size, nwritten);
+}
+
+/** Get file size.
+ *
+ * @param fd File descriptor
+ * @param size Place to store the size of the file
+ * @return EOK on success or an error code
+ */
+errno_t vfs_file_size(int fd, aoff64_t *size)
+{
+	vfs_stat_t stat;
+	errno_t rc;
+
+	rc = vfs_stat(fd, &stat);
+	if (rc != EOK)
+		return rc;
+
+	*size = stat.size;
+	return EOK;
+}
+
+/** @}
+ */
@@ -154,6 +154,7 @@ extern void __fibril_synch_fini(void);
 
 extern void fibril_mutex_initialize(fibril_mutex_t *);
 extern void fibril_mutex_lock(fibril_mutex_t *);
+extern errno_t fibril_mutex_lock_timeout(fibril_mutex_t *, usec_t);
 extern bool fibril_mutex_trylock(fibril_mutex_t *);
 extern void fibril_mutex_unlock(fibril_mutex_t *);
 extern bool fibril_mutex_is_locked(fibril_mutex_t *);
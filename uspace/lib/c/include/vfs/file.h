@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file File access for C++
+ *
+ * Subset of <vfs/vfs.h> that does not depend on IPC headers,
+ * so that it can also be included from C++.
+ */
+
+#ifndef _LIBC_VFS_FILE_H_
+#define _LIBC_VFS_FILE_H_
+
+#include <_bits/decls.h>
+#include <errno.h>
+#include <offset.h>
+#include <stddef.h>
+
+__HELENOS_DECLS_BEGIN;
+
+/** Flags for vfs_file_open() */
+enum {
+	/** Open for reading */
+	VFS_FILE_READ = 1,
+	/** Open for writing */
+	VFS_FILE_WRITE = 2,
+	/** All writes go to the end of the file */
+	VFS_FILE_APPEND = 4,
+	/** Create the file if it does not exist */
+	VFS_FILE_CREATE = 8,
+	/** Truncate the file to zero length */
+	VFS_FILE_TRUNCATE = 16
+};
+
+extern errno_t vfs_file_open(const char *, int, int *);
+extern errno_t vfs_file_close(int);
+extern errno_t vfs_file_read(int, aoff64_t *, void *, size_t, size_t *);
+extern errno_t vfs_file_write(int, aoff64_t *, const void *, size_t,
+    size_t *);
+extern errno_t vfs_file_size(int, aoff64_t *);
+
+__HELENOS_DECLS_END;
+
+#endif
+
+/** @}
+ */
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <pcut/pcut.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(fibril_mutex);
+
+typedef struct {
+	fibril_mutex_t *lock;
+	usec_t timeout;
+	errno_t rc;
+	bool done;
+} lock_timeout_arg_t;
+
+static errno_t lock_timeout_fibril(void *arg)
+{
+	lock_timeout_arg_t *a = (lock_timeout_arg_t *) arg;
+
+	a->rc = fibril_mutex_lock_timeout(a->lock, a->timeout);
+	if (a->rc == EOK)
+		fibril_mutex_unlock(a->lock);
+
+	a->done = true;
+	return EOK;
+}
+
+static void run_lock_timeout(lock_timeout_arg_t *arg)
+{
+	fid_t fid = fibril_create(lock_timeout_fibril, arg);
+	PCUT_ASSERT_NOT_NULL((void *) fid);
+	fibril_add_ready(fid);
+}
+
+PCUT_TEST(lock_unlock)
+{
+	fibril_mutex_t lock;
+
+	fibril_mutex_initialize(&lock);
+	PCUT_ASSERT_FALSE(fibril_mutex_is_locked(&lock));
+
+	fibril_mutex_lock(&lock);
+	PCUT_ASSERT_TRUE(fibril_mutex_is_locked(&lock));
+	fibril_mutex_unlock(&lock);
+
+	PCUT_ASSERT_FALSE(fibril_mutex_is_locked(&lock));
+}
+
+PCUT_TEST(trylock)
+{
+	fibril_mutex_t lock;
+
+	fibril_mutex_initialize(&lock);
+
+	PCUT_ASSERT_TRUE(fibril_mutex_trylock(&lock));
+	PCUT_ASSERT_TRUE(fibril_mutex_is_locked(&lock));
+	fibril_mutex_unlock(&lock);
+
+	PCUT_ASSERT_TRUE(fibril_mutex_trylock(&lock));
+	fibril_mutex_unlock(&lock);
+}
+
+PCUT_TEST(lock_timeout_free)
+{
+	fibril_mutex_t lock;
+
+	fibril_mutex_initialize(&lock);
+
+	PCUT_ASSERT_ERRNO_VAL(EOK, fibril_mutex_lock_timeout(&lock, 1000));
+	fibril_mutex_unlock(&lock);
+
+	PCUT_ASSERT_ERRNO_VAL(EOK, fibril_mutex_lock_timeout(&lock, -1));
+	fibril_mutex_unlock(&lock);
+}
+
+PCUT_TEST(lock_timeout_expires)
+{
+	fibril_mutex_t lock;
+	lock_timeout_arg_t arg;
+
+	fibril_mutex_initialize(&lock);
+	fibril_mutex_lock(&lock);
+
+	arg.lock = &lock;
+	arg.timeout = 1000;
+	arg.rc = EOK;
+	arg.done = false;
+	run_lock_timeout(&arg);
+
+	while (!arg.done)
+		fibril_usleep(1000);
+
+	PCUT_ASSERT_ERRNO_VAL(ETIMEOUT, arg.rc);
+
+	/* The timed out waiter must not leave the mutex in a bad state. */
+	fibril_mutex_unlock(&lock);
+	PCUT_ASSERT_TRUE(fibril_mutex_trylock(&lock));
+	fibril_mutex_unlock(&lock);
+}
+
+PCUT_TEST(lock_timeout_handover)
+{
+	fibril_mutex_t lock;
+	lock_timeout_arg_t arg;
+
+	fibril_mutex_initialize(&lock);
+	fibril_mutex_lock(&lock);
+
+	arg.lock = &lock;
+	arg.timeout = 10 * 1000 * 1000;
+	arg.rc = ETIMEOUT;
+	arg.done = false;
+	run_lock_timeout(&arg);
+
+	fibril_usleep(1000);
+	fibril_mutex_unlock(&lock);
+
+	while (!arg.done)
+		fibril_usleep(1000);
+
+	PCUT_ASSERT_ERRNO_VAL(EOK, arg.rc);
+	PCUT_ASSERT_TRUE(fibril_mutex_trylock(&lock));
+	fibril_mutex_unlock(&lock);
+}
+
+PCUT_EXPORT(fibril_mutex);
@@ -0,0 +1,1209 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * @brief Implementation of deflate compression
+ *
+ * A deflate compressor (producing a `deflate' stream as described by
+ * RFC 1951) following the classic design of zlib by Jean-loup Gailly
+ * and Mark Adler.
+ *
+ * Matches are searched for in a 32 KiB sliding window using hash chains
+ * of three-byte strings. The compression level selects how long the
+ * chains are followed and whether matching is greedy or lazy (a match is
+ * only taken if the match at the next position is not longer). Symbols
+ * are collected into blocks, each of which is emitted either as stored,
+ * with the fixed Huffman code or with a dynamic Huffman code, whichever
+ * is smallest.
+ *
+ * The compressor works on input and output chunks of arbitrary size.
+ * All state, about 250 KiB, is kept in a heap-allocated deflate_stream_t.
+ *
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <mem.h>
+#include <stdlib.h>
+#include "deflate.h"
+
+/** Size of the sliding window */
+#define WINDOW_SIZE  32768
+#define WINDOW_MASK  (WINDOW_SIZE - 1)
+
+/** Shortest and longest match */
+#define MIN_MATCH  3
+#define MAX_MATCH  258
+
+/** Minimum lookahead needed to find the longest match at a position */
+#define MIN_LOOKAHEAD  (MAX_MATCH + MIN_MATCH + 1)
+
+/** Maximum distance of a match (keeps matches inside the window) */
+#define MAX_DISTANCE  (WINDOW_SIZE - MIN_LOOKAHEAD)
+
+/** Matches of minimum length are only worth it if not too far */
+#define TOO_FAR  4096
+
+/** Hash table for three-byte strings */
+#define HASH_BITS   14
+#define HASH_SIZE   (1 << HASH_BITS)
+#define HASH_MASK   (HASH_SIZE - 1)
+#define HASH_SHIFT  ((HASH_BITS + MIN_MATCH - 1) / MIN_MATCH)
+
+/** End of hash chain */
+#define NIL  0
+
+/** Maximum number of symbols in a block */
+#define SYM_BUF_SIZE  8192
+
+/** Maximum length of a stored block */
+#define MAX_STORED  65535
+
+/** Size of the buffer for one encoded block
+ *
+ * A block never covers more than the whole window and is only encoded
+ * using Huffman codes if that is not larger than storing it.
+ */
+#define PENDING_SIZE  (2 * WINDOW_SIZE + 64)
+
+/** Maximum bit length of a Huffman code */
+#define MAX_HUFFMAN_BIT  15
+
+/** Maximum bit length of the code length code */
+#define MAX_CLEN_BIT  7
+
+/** Number of literal/length codes */
+#define NUM_LITLEN  286
+
+/**
+ * Number of literal/length codes of the fixed Huffman code. Codes 286
+ * and 287 never occur in the data, but take part in the construction
+ * of the code.
+ */
+#define NUM_FIXED_LITLEN  288
+
+/** Number of distance codes */
+#define NUM_DIST  30
+
+/** Number of code length codes */
+#define NUM_CLEN  19
+
+/** Number of length codes */
+#define NUM_LEN  29
+
+/** Maximum number of symbols of any code */
+#define MAX_SYMBOLS  NUM_LITLEN
+
+/** End-of-block symbol */
+#define END_BLOCK  256
+
+/** Block types */
+#define BTYPE_STORED   0
+#define BTYPE_FIXED    1
+#define BTYPE_DYNAMIC  2
+
+/** Length codes
+ *
+ */
+static const uint16_t lens[NUM_LEN] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+/** Extended length codes
+ *
+ */
+static const uint16_t lens_ext[NUM_LEN] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/** Distance codes
+ *
+ */
+static const uint16_t dists[NUM_DIST] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+	8193, 12289, 16385, 24577
+};
+
+/** Extended distance codes
+ *
+ */
+static const uint16_t dists_ext[NUM_DIST] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+	12, 12, 13, 13
+};
+
+/** Order codes
+ *
+ */
+static const uint8_t order[NUM_CLEN] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/** Matching parameters of a compression level
+ *
+ */
+typedef struct {
+	/** Follow only a quarter of the chain if a match this long exists */
+	uint16_t good;
+	/** Lazy: do not look for a better match after one this long;
+	 *  greedy: do not insert strings of matches longer than this */
+	uint16_t lazy;
+	/** Stop searching when a match this long is found */
+	uint16_t nice;
+	/** Maximum number of hash chain entries to follow */
+	uint16_t chain;
+	/** Use lazy matching */
+	bool lazy_match;
+} deflate_config_t;
+
+/** Parameters of compression levels
+ *
+ */
+static const deflate_config_t config[DEFLATE_LEVEL_MAX + 1] = {
+	{ 0, 0, 0, 0, false },
+	{ 4, 4, 8, 4, false },
+	{ 4, 5, 16, 8, false },
+	{ 4, 6, 32, 32, false },
+	{ 4, 4, 16, 16, true },
+	{ 8, 16, 32, 32, true },
+	{ 8, 16, 128, 128, true },
+	{ 8, 32, 128, 256, true },
+	{ 32, 128, 258, 1024, true },
+	{ 32, 258, 258, 4096, true }
+};
+
+/** Streaming deflate
+ *
+ * The window holds up to twice WINDOW_SIZE bytes. Input is appended
+ * after the lookahead. When the current position reaches the upper
+ * half, the window slides down by WINDOW_SIZE bytes. The current block
+ * is always flushed before sliding so that the data it covers remain
+ * available for emitting it as a stored block.
+ *
+ */
+struct deflate_stream {
+	int level;                       /**< Compression level */
+	const deflate_config_t *config;  /**< Matching parameters */
+
+	/** Sliding window (with slack for comparing past its end) */
+	uint8_t window[2 * WINDOW_SIZE + MAX_MATCH];
+	size_t strstart;        /**< Current position in the window */
+	size_t lookahead;       /**< Number of valid bytes after strstart */
+
+	uint16_t head[HASH_SIZE];    /**< Latest position for each hash */
+	uint16_t prev[WINDOW_SIZE];  /**< Previous position with same hash */
+
+	size_t match_length;    /**< Length of the best match */
+	size_t match_start;     /**< Start of the best match */
+	size_t prev_length;     /**< Length of the match at previous position */
+	size_t prev_match;      /**< Start of the match at previous position */
+	bool match_available;   /**< Literal at previous position is pending */
+
+	size_t block_start;     /**< Start of the current block in the window */
+	size_t block_len;       /**< Number of bytes covered by the block */
+
+	uint16_t sym_dist[SYM_BUF_SIZE];  /**< Match distances (0 = literal) */
+	uint8_t sym_lc[SYM_BUF_SIZE];     /**< Literal or length - MIN_MATCH */
+	size_t sym_cnt;                   /**< Number of symbols in block */
+
+	uint16_t lit_freq[NUM_LITLEN];  /**< Literal/length code frequencies */
+	uint16_t dist_freq[NUM_DIST];   /**< Distance code frequencies */
+
+	/** Length code for each length - MIN_MATCH */
+	uint8_t length_code[MAX_MATCH - MIN_MATCH + 1];
+	/** Distance code for distance - 1 below 256, then per 128 */
+	uint8_t dist_code[512];
+
+	uint8_t pending[PENDING_SIZE];  /**< Encoded data not yet output */
+	size_t pending_len;             /**< Number of bytes in pending */
+	size_t pending_out;             /**< Number of bytes already output */
+
+	uint64_t bitbuf;  /**< Bit buffer */
+	size_t bitlen;    /**< Number of bits in the bit buffer */
+
+	bool done;        /**< Last block has been encoded */
+};
+
+/** Write bits to the pending buffer
+ *
+ * @param ds  Deflate stream.
+ * @param val Bits to write.
+ * @param cnt Number of bits (at most 32).
+ *
+ */
+static inline void put_bits(deflate_stream_t *ds, uint32_t val, size_t cnt)
+{
+	ds->bitbuf |= ((uint64_t) val) << ds->bitlen;
+	ds->bitlen += cnt;
+
+	while (ds->bitlen >= 8) {
+		assert(ds->pending_len < PENDING_SIZE);
+		ds->pending[ds->pending_len++] = (uint8_t) ds->bitbuf;
+		ds->bitbuf >>= 8;
+		ds->bitlen -= 8;
+	}
+}
+
+/** Pad the pending buffer to a byte boundary with zero bits
+ *
+ * @param ds Deflate stream.
+ *
+ */
+static void put_align(deflate_stream_t *ds)
+{
+	if (ds->bitlen > 0)
+		put_bits(ds, 0, 8 - ds->bitlen);
+}
+
+/** Get distance code
+ *
+ * @param ds   Deflate stream.
+ * @param dist Match distance.
+ *
+ * @return Distance code.
+ *
+ */
+static inline uint8_t dcode(deflate_stream_t *ds, size_t dist)
+{
+	dist--;
+	return (dist < 256) ? ds->dist_code[dist] :
+	    ds->dist_code[256 + (dist >> 7)];
+}
+
+/** Record a literal in the current block
+ *
+ * @param ds  Deflate stream.
+ * @param lit Literal byte.
+ *
+ */
+static inline void tally_lit(deflate_stream_t *ds, uint8_t lit)
+{
+	ds->sym_dist[ds->sym_cnt] = 0;
+	ds->sym_lc[ds->sym_cnt] = lit;
+	ds->sym_cnt++;
+
+	ds->lit_freq[lit]++;
+	ds->block_len++;
+}
+
+/** Record a match in the current block
+ *
+ * @param ds   Deflate stream.
+ * @param dist Match distance.
+ * @param len  Match length.
+ *
+ */
+static inline void tally_match(deflate_stream_t *ds, size_t dist, size_t len)
+{
+	ds->sym_dist[ds->sym_cnt] = dist;
+	ds->sym_lc[ds->sym_cnt] = len - MIN_MATCH;
+	ds->sym_cnt++;
+
+	ds->lit_freq[END_BLOCK + 1 + ds->length_code[len - MIN_MATCH]]++;
+	ds->dist_freq[dcode(ds, dist)]++;
+	ds->block_len += len;
+}
+
+/** Leaf of a Huffman tree
+ *
+ */
+typedef struct {
+	uint32_t freq;    /**< Symbol frequency */
+	uint16_t symbol;  /**< Symbol */
+} huffman_leaf_t;
+
+/** Compare Huffman tree leaves by frequency
+ *
+ * @param a First leaf.
+ * @param b Second leaf.
+ *
+ * @return Comparison result for qsort().
+ *
+ */
+static int huffman_leaf_cmp(const void *a, const void *b)
+{
+	const huffman_leaf_t *la = (const huffman_leaf_t *) a;
+	const huffman_leaf_t *lb = (const huffman_leaf_t *) b;
+
+	if (la->freq != lb->freq)
+		return (la->freq < lb->freq) ? -1 : 1;
+
+	return (int) la->symbol - (int) lb->symbol;
+}
+
+/** Compute length-limited Huffman code lengths
+ *
+ * Build a Huffman tree using the two-queue method. If the tree is too
+ * deep, frequencies are scaled down and the tree is rebuilt. If only one
+ * symbol is used, another symbol gets a code too, so that the code is
+ * complete.
+ *
+ * @param freq   Symbol frequencies.
+ * @param n      Number of symbols (at most MAX_SYMBOLS).
+ * @param limit  Maximum code length.
+ * @param length Computed code lengths (zero for unused symbols).
+ *
+ */
+static void huffman_lengths(const uint16_t *freq, size_t n, size_t limit,
+    uint8_t *length)
+{
+	huffman_leaf_t leaf[MAX_SYMBOLS];
+	uint32_t weight[2 * MAX_SYMBOLS];
+	uint16_t parent[2 * MAX_SYMBOLS];
+	uint8_t depth[2 * MAX_SYMBOLS];
+	size_t m = 0;
+	size_t shift = 0;
+
+	memset(length, 0, n);
+
+	for (size_t sym = 0; sym < n; sym++) {
+		if (freq[sym] != 0) {
+			leaf[m].freq = freq[sym];
+			leaf[m].symbol = sym;
+			m++;
+		}
+	}
+
+	if (m == 0)
+		return;
+
+	if (m == 1) {
+		length[leaf[0].symbol] = 1;
+		length[(leaf[0].symbol == 0) ? 1 : 0] = 1;
+		return;
+	}
+
+	qsort(leaf, m, sizeof(huffman_leaf_t), huffman_leaf_cmp);
+
+	while (true) {
+		/* Scaling keeps the weights sorted */
+		for (size_t i = 0; i < m; i++)
+			weight[i] = (leaf[i].freq >> shift) | 1;
+
+		/* Leaves are 0 .. m - 1, inner nodes m .. 2m - 2 */
+		size_t leaf_next = 0;
+		size_t inner_next = m;
+
+		for (size_t node = m; node < 2 * m - 1; node++) {
+			size_t child[2];
+
+			for (size_t c = 0; c < 2; c++) {
+				if (leaf_next < m && (inner_next == node ||
+				    weight[leaf_next] <= weight[inner_next]))
+					child[c] = leaf_next++;
+				else
+					child[c] = inner_next++;
+			}
+
+			weight[node] = weight[child[0]] + weight[child[1]];
+			parent[child[0]] = node;
+			parent[child[1]] = node;
+		}
+
+		size_t max_depth = 0;
+		depth[2 * m - 2] = 0;
+		for (size_t node = 2 * m - 2; node > 0; node--) {
+			depth[node - 1] = depth[parent[node - 1]] + 1;
+			if (depth[node - 1] > max_depth)
+				max_depth = depth[node - 1];
+		}
+
+		if (max_depth <= limit)
+			break;
+
+		shift++;
+	}
+
+	for (size_t i = 0; i < m; i++)
+		length[leaf[i].symbol] = depth[i];
+}
+
+/** Compute canonical Huffman codes
+ *
+ * The codes are returned bit-reversed, ready to be written starting
+ * with the least significant bit.
+ *
+ * @param length Code lengths.
+ * @param n      Number of symbols.
+ * @param code   Computed codes.
+ *
+ */
+static void huffman_codes(const uint8_t *length, size_t n, uint16_t *code)
+{
+	uint16_t count[MAX_HUFFMAN_BIT + 1];
+	uint16_t next[MAX_HUFFMAN_BIT + 1];
+	uint16_t c = 0;
+
+	memset(count, 0, sizeof(count));
+	for (size_t sym = 0; sym < n; sym++)
+		count[length[sym]]++;
+
+	count[0] = 0;
+	for (size_t len = 1; len <= MAX_HUFFMAN_BIT; len++) {
+		c = (c + count[len - 1]) << 1;
+		next[len] = c;
+	}
+
+	for (size_t sym = 0; sym < n; sym++) {
+		size_t len = length[sym];
+		if (len == 0)
+			continue;
+
+		uint16_t val = next[len]++;
+		uint16_t rev = 0;
+		for (size_t bit = 0; bit < len; bit++)
+			rev |= ((val >> bit) & 1) << (len - 1 - bit);
+
+		code[sym] = rev;
+	}
+}
+
+/** Compute size of the block data with the given codes
+ *
+ * @param ds       Deflate stream.
+ * @param lit_len  Literal/length code lengths.
+ * @param dist_len Distance code lengths.
+ *
+ * @return Size in bits, including the end-of-block code.
+ *
+ */
+static size_t block_data_bits(deflate_stream_t *ds, const uint8_t *lit_len,
+    const uint8_t *dist_len)
+{
+	size_t bits = 0;
+
+	for (size_t sym = 0; sym < NUM_LITLEN; sym++)
+		bits += (size_t) ds->lit_freq[sym] * lit_len[sym];
+
+	for (size_t code = 0; code < NUM_LEN; code++)
+		bits += (size_t) ds->lit_freq[END_BLOCK + 1 + code] *
+		    lens_ext[code];
+
+	for (size_t code = 0; code < NUM_DIST; code++)
+		bits += (size_t) ds->dist_freq[code] *
+		    (dist_len[code] + dists_ext[code]);
+
+	return bits;
+}
+
+/** Write the symbols of the block using the given codes
+ *
+ * @param ds       Deflate stream.
+ * @param lit_len  Literal/length code lengths.
+ * @param nlit     Number of literal/length code lengths.
+ * @param dist_len Distance code lengths.
+ *
+ */
+static void block_write_data(deflate_stream_t *ds, const uint8_t *lit_len,
+    size_t nlit, const uint8_t *dist_len)
+{
+	uint16_t lit_code[NUM_FIXED_LITLEN];
+	uint16_t dist_code[NUM_DIST];
+
+	assert(nlit <= NUM_FIXED_LITLEN);
+	huffman_codes(lit_len, nlit, lit_code);
+	huffman_codes(dist_len, NUM_DIST, dist_code);
+
+	for (size_t i = 0; i < ds->sym_cnt; i++) {
+		size_t dist = ds->sym_dist[i];
+		size_t lc = ds->sym_lc[i];
+
+		if (dist == 0) {
+			put_bits(ds, lit_code[lc], lit_len[lc]);
+			continue;
+		}
+
+		size_t code = ds->length_code[lc];
+		put_bits(ds, lit_code[END_BLOCK + 1 + code],
+		    lit_len[END_BLOCK + 1 + code]);
+		put_bits(ds, lc + MIN_MATCH - lens[code], lens_ext[code]);
+
+		code = dcode(ds, dist);
+		put_bits(ds, dist_code[code], dist_len[code]);
+		put_bits(ds, dist - dists[code], dists_ext[code]);
+	}
+
+	put_bits(ds, lit_code[END_BLOCK], lit_len[END_BLOCK]);
+}
+
+/** Write the current block as stored block(s)
+ *
+ * @param ds   Deflate stream.
+ * @param last Last block of the stream.
+ *
+ */
+static void block_write_stored(deflate_stream_t *ds, bool last)
+{
+	const uint8_t *data = ds->window + ds->block_start;
+	size_t left = ds->block_len;
+
+	do {
+		size_t len = (left > MAX_STORED) ? MAX_STORED : left;
+		left -= len;
+
+		put_bits(ds, (last && left == 0) ? 1 : 0, 1);
+		put_bits(ds, BTYPE_STORED, 2);
+		put_align(ds);
+		put_bits(ds, len, 16);
+		put_bits(ds, ~len & 0xffff, 16);
+
+		assert(ds->pending_len + len <= PENDING_SIZE);
+		memcpy(ds->pending + ds->pending_len, data, len);
+		ds->pending_len += len;
+		data += len;
+	} while (left > 0);
+}
+
+/** Encode the current block into the pending buffer
+ *
+ * @param ds   Deflate stream.
+ * @param last Last block of the stream.
+ *
+ */
+static void deflate_flush_block(deflate_stream_t *ds, bool last)
+{
+	uint8_t fixed_lit_len[NUM_FIXED_LITLEN];
+	uint8_t fixed_dist_len[NUM_DIST];
+	uint8_t lit_len[NUM_LITLEN];
+	uint8_t dist_len[NUM_DIST];
+	uint8_t clen_len[NUM_CLEN];
+	uint16_t clen_code[NUM_CLEN];
+	uint16_t clen_freq[NUM_CLEN];
+	uint8_t lengths[NUM_LITLEN + NUM_DIST];
+	uint8_t clen_sym[NUM_LITLEN + NUM_DIST];
+	uint8_t clen_extra[NUM_LITLEN + NUM_DIST];
+	size_t nclen = 0;
+
+	/* Stored size including header and padding of each chunk */
+	size_t chunks = (ds->block_len + MAX_STORED - 1) / MAX_STORED;
+	if (chunks == 0)
+		chunks = 1;
+
+	size_t stored_bits = chunks * (3 + 7 + 32) + 8 * ds->block_len;
+	size_t fixed_bits = SIZE_MAX;
+	size_t dyn_bits = SIZE_MAX;
+	size_t nlen = 0;
+	size_t ndist = 0;
+	size_t ncode = 0;
+
+	if (ds->level > 0) {
+		ds->lit_freq[END_BLOCK] = 1;
+
+		/* Fixed Huffman code */
+		for (size_t sym = 0; sym < NUM_FIXED_LITLEN; sym++) {
+			fixed_lit_len[sym] = (sym < 144) ? 8 : (sym < 256) ?
+			    9 : (sym < 280) ? 7 : 8;
+		}
+
+		memset(fixed_dist_len, 5, NUM_DIST);
+		fixed_bits = 3 + block_data_bits(ds, fixed_lit_len,
+		    fixed_dist_len);
+
+		/* Dynamic Huffman code */
+		huffman_lengths(ds->lit_freq, NUM_LITLEN, MAX_HUFFMAN_BIT,
+		    lit_len);
+		huffman_lengths(ds->dist_freq, NUM_DIST, MAX_HUFFMAN_BIT,
+		    dist_len);
+
+		if (dist_len[0] == 0 && dist_len[1] == 0) {
+			/* No distances used, but some code is needed */
+			bool used = false;
+			for (size_t code = 0; code < NUM_DIST; code++)
+				used = used || (dist_len[code] != 0);
+
+			if (!used) {
+				dist_len[0] = 1;
+				dist_len[1] = 1;
+			}
+		}
+
+		nlen = NUM_LITLEN;
+		while (nlen > END_BLOCK + 1 && lit_len[nlen - 1] == 0)
+			nlen--;
+
+		ndist = NUM_DIST;
+		while (ndist > 1 && dist_len[ndist - 1] == 0)
+			ndist--;
+
+		memcpy(lengths, lit_len, nlen);
+		memcpy(lengths + nlen, dist_len, ndist);
+
+		/* Run-length encode the code lengths */
+		memset(clen_freq, 0, sizeof(clen_freq));
+
+		size_t i = 0;
+		while (i < nlen + ndist) {
+			uint8_t cur = lengths[i];
+			size_t run = 1;
+			while (i + run < nlen + ndist &&
+			    lengths[i + run] == cur)
+				run++;
+
+			i += run;
+
+			if (cur != 0) {
+				clen_sym[nclen] = cur;
+				clen_extra[nclen++] = 0;
+				clen_freq[cur]++;
+				run--;
+
+				while (run >= 3) {
+					size_t r = (run > 6) ? 6 : run;
+					clen_sym[nclen] = 16;
+					clen_extra[nclen++] = r - 3;
+					clen_freq[16]++;
+					run -= r;
+				}
+			} else {
+				while (run >= 3) {
+					size_t r;
+					if (run >= 11) {
+						r = (run > 138) ? 138 : run;
+						clen_sym[nclen] = 18;
+						clen_extra[nclen++] = r - 11;
+						clen_freq[18]++;
+					} else {
+						r = run;
+						clen_sym[nclen] = 17;
+						clen_extra[nclen++] = r - 3;
+						clen_freq[17]++;
+					}
+
+					run -= r;
+				}
+			}
+
+			while (run > 0) {
+				clen_sym[nclen] = cur;
+				clen_extra[nclen++] = 0;
+				clen_freq[cur]++;
+				run--;
+			}
+		}
+
+		huffman_lengths(clen_freq, NUM_CLEN, MAX_CLEN_BIT, clen_len);
+
+		ncode = NUM_CLEN;
+		while (ncode > 4 && clen_len[order[ncode - 1]] == 0)
+			ncode--;
+
+		dyn_bits = 3 + 5 + 5 + 4 + 3 * ncode +
+		    block_data_bits(ds, lit_len, dist_len);
+		for (size_t sym = 0; sym < NUM_CLEN; sym++)
+			dyn_bits += (size_t) clen_freq[sym] * clen_len[sym];
+		dyn_bits += 2 * clen_freq[16] + 3 * clen_freq[17] +
+		    7 * clen_freq[18];
+	}
+
+	if (stored_bits <= fixed_bits && stored_bits <= dyn_bits) {
+		block_write_stored(ds, last);
+	} else if (fixed_bits <= dyn_bits) {
+		put_bits(ds, last ? 1 : 0, 1);
+		put_bits(ds, BTYPE_FIXED, 2);
+		block_write_data(ds, fixed_lit_len, NUM_FIXED_LITLEN,
+		    fixed_dist_len);
+	} else {
+		put_bits(ds, last ? 1 : 0, 1);
+		put_bits(ds, BTYPE_DYNAMIC, 2);
+		put_bits(ds, nlen - 257, 5);
+		put_bits(ds, ndist - 1, 5);
+		put_bits(ds, ncode - 4, 4);
+
+		for (size_t i = 0; i < ncode; i++)
+			put_bits(ds, clen_len[order[i]], 3);
+
+		huffman_codes(clen_len, NUM_CLEN, clen_code);
+		for (size_t i = 0; i < nclen; i++) {
+			uint8_t sym = clen_sym[i];
+			put_bits(ds, clen_code[sym], clen_len[sym]);
+
+			if (sym == 16)
+				put_bits(ds, clen_extra[i], 2);
+			else if (sym == 17)
+				put_bits(ds, clen_extra[i], 3);
+			else if (sym == 18)
+				put_bits(ds, clen_extra[i], 7);
+		}
+
+		block_write_data(ds, lit_len, NUM_LITLEN, dist_len);
+	}
+
+	if (last)
+		put_align(ds);
+
+	/* Start a new block */
+	ds->block_start += ds->block_len;
+	ds->block_len = 0;
+	ds->sym_cnt = 0;
+	memset(ds->lit_freq, 0, sizeof(ds->lit_freq));
+	memset(ds->dist_freq, 0, sizeof(ds->dist_freq));
+}
+
+/** Insert string at the given position into the hash table
+ *
+ * @param ds  Deflate stream.
+ * @param pos Position in the window (at least MIN_MATCH bytes must follow).
+ *
+ * @return Previous position with the same hash or NIL.
+ *
+ */
+static inline size_t insert_string(deflate_stream_t *ds, size_t pos)
+{
+	const uint8_t *p = ds->window + pos;
+	size_t hash = ((p[0] << (2 * HASH_SHIFT)) ^ (p[1] << HASH_SHIFT) ^
+	    p[2]) & HASH_MASK;
+	size_t head = ds->head[hash];
+
+	ds->prev[pos & WINDOW_MASK] = head;
+	ds->head[hash] = pos;
+	return head;
+}
+
+/** Find the longest match at the current position
+ *
+ * @param ds        Deflate stream.
+ * @param cur_match Latest position with the same hash.
+ *
+ * @return Length of the longest match (set in match_start) or
+ *         prev_length if no longer match was found.
+ *
+ */
+static size_t longest_match(deflate_stream_t *ds, size_t cur_match)
+{
+	const uint8_t *scan = ds->window + ds->strstart;
+	size_t chain = ds->config->chain;
+	size_t best_len = ds->prev_length;
+	size_t nice = ds->config->nice;
+	size_t max_len = (ds->lookahead < MAX_MATCH) ? ds->lookahead :
+	    MAX_MATCH;
+	size_t limit = (ds->strstart > MAX_DISTANCE) ?
+	    ds->strstart - MAX_DISTANCE : NIL;
+
+	/* Do not waste too much time if we already have a good match */
+	if (ds->prev_length >= ds->config->good)
+		chain >>= 2;
+
+	if (nice > max_len)
+		nice = max_len;
+
+	if (best_len >= max_len)
+		return max_len;
+
+	do {
+		const uint8_t *match = ds->window + cur_match;
+
+		/* Skip quickly if the match cannot be longer */
+		if (match[best_len] != scan[best_len] ||
+		    match[best_len - 1] != scan[best_len - 1] ||
+		    match[0] != scan[0] || match[1] != scan[1])
+			continue;
+
+		size_t len = 2;
+		while (len < max_len && match[len] == scan[len])
+			len++;
+
+		if (len > best_len) {
+			ds->match_start = cur_match;
+			best_len = len;
+			if (len >= nice)
+				break;
+		}
+	} while ((cur_match = ds->prev[cur_match & WINDOW_MASK]) > limit &&
+	    --chain != 0);
+
+	return best_len;
+}
+
+/** Compress without matching
+ *
+ * @param ds    Deflate stream.
+ * @param flush Compress all of the lookahead.
+ *
+ * @return True if the block is full and must be flushed.
+ *
+ */
+static bool deflate_none(deflate_stream_t *ds, bool flush)
+{
+	(void) flush;
+
+	/* The block is flushed before sliding the window */
+	ds->block_len += ds->lookahead;
+	ds->strstart += ds->lookahead;
+	ds->lookahead = 0;
+	return false;
+}
+
+/** Compress with greedy matching
+ *
+ * @param ds    Deflate stream.
+ * @param flush Compress all of the lookahead.
+ *
+ * @return True if the block is full and must be flushed.
+ *
+ */
+static bool deflate_greedy(deflate_stream_t *ds, bool flush)
+{
+	size_t hash_head;
+
+	while (true) {
+		if (ds->sym_cnt == SYM_BUF_SIZE)
+			return true;
+
+		if (ds->lookahead < MIN_LOOKAHEAD && !flush)
+			return false;
+
+		if (ds->lookahead == 0)
+			return false;
+
+		size_t end = ds->strstart + ds->lookahead;
+
+		hash_head = NIL;
+		if (ds->lookahead >= MIN_MATCH)
+			hash_head = insert_string(ds, ds->strstart);
+
+		ds->match_length = 0;
+		if (hash_head != NIL &&
+		    ds->strstart - hash_head <= MAX_DISTANCE) {
+			ds->prev_length = MIN_MATCH - 1;
+			ds->match_length = longest_match(ds, hash_head);
+		}
+
+		if (ds->match_length >= MIN_MATCH) {
+			tally_match(ds, ds->strstart - ds->match_start,
+			    ds->match_length);
+			ds->lookahead -= ds->match_length;
+
+			if (ds->match_length <= ds->config->lazy) {
+				/* Insert strings of the match */
+				while (--ds->match_length > 0) {
+					ds->strstart++;
+					if (ds->strstart + MIN_MATCH <= end)
+						insert_string(ds, ds->strstart);
+				}
+
+				ds->strstart++;
+			} else {
+				ds->strstart += ds->match_length;
+			}
+		} else {
+			tally_lit(ds, ds->window[ds->strstart]);
+			ds->strstart++;
+			ds->lookahead--;
+		}
+	}
+}
+
+/** Compress with lazy matching
+ *
+ * @param ds    Deflate stream.
+ * @param flush Compress all of the lookahead.
+ *
+ * @return True if the block is full and must be flushed.
+ *
+ */
+static bool deflate_lazy(deflate_stream_t *ds, bool flush)
+{
+	size_t hash_head;
+
+	while (true) {
+		if (ds->sym_cnt == SYM_BUF_SIZE)
+			return true;
+
+		if (ds->lookahead < MIN_LOOKAHEAD && !flush)
+			return false;
+
+		if (ds->lookahead == 0)
+			break;
+
+		size_t end = ds->strstart + ds->lookahead;
+
+		hash_head = NIL;
+		if (ds->lookahead >= MIN_MATCH)
+			hash_head = insert_string(ds, ds->strstart);
+
+		ds->prev_length = ds->match_length;
+		ds->prev_match = ds->match_start;
+		ds->match_length = MIN_MATCH - 1;
+
+		if (hash_head != NIL && ds->prev_length < ds->config->lazy &&
+		    ds->strstart - hash_head <= MAX_DISTANCE) {
+			ds->match_length = longest_match(ds, hash_head);
+
+			if (ds->match_length == MIN_MATCH &&
+			    ds->strstart - ds->match_start > TOO_FAR)
+				ds->match_length = MIN_MATCH - 1;
+		}
+
+		if (ds->prev_length >= MIN_MATCH &&
+		    ds->match_length <= ds->prev_length) {
+			/* Match at previous position is better */
+			tally_match(ds, ds->strstart - 1 - ds->prev_match,
+			    ds->prev_length);
+
+			/* Insert strings of the rest of the match */
+			ds->lookahead -= ds->prev_length - 1;
+			ds->prev_length -= 2;
+			do {
+				ds->strstart++;
+				if (ds->strstart + MIN_MATCH <= end)
+					insert_string(ds, ds->strstart);
+			} while (--ds->prev_length != 0);
+
+			ds->match_available = false;
+			ds->match_length = MIN_MATCH - 1;
+			ds->strstart++;
+		} else if (ds->match_available) {
+			/* Previous position becomes a literal */
+			tally_lit(ds, ds->window[ds->strstart - 1]);
+			ds->strstart++;
+			ds->lookahead--;
+		} else {
+			/* Wait for the next position to decide */
+			ds->match_available = true;
+			ds->strstart++;
+			ds->lookahead--;
+		}
+	}
+
+	if (ds->match_available) {
+		if (ds->sym_cnt == SYM_BUF_SIZE)
+			return true;
+
+		tally_lit(ds, ds->window[ds->strstart - 1]);
+		ds->match_available = false;
+	}
+
+	ds->match_length = MIN_MATCH - 1;
+	return false;
+}
+
+/** Slide the window down by WINDOW_SIZE bytes
+ *
+ * @param ds Deflate stream.
+ *
+ */
+static void deflate_slide(deflate_stream_t *ds)
+{
+	memcpy(ds->window, ds->window + WINDOW_SIZE, WINDOW_SIZE);
+	ds->strstart -= WINDOW_SIZE;
+	ds->block_start -= WINDOW_SIZE;
+	ds->match_start = (ds->match_start >= WINDOW_SIZE) ?
+	    ds->match_start - WINDOW_SIZE : NIL;
+	ds->prev_match = (ds->prev_match >= WINDOW_SIZE) ?
+	    ds->prev_match - WINDOW_SIZE : NIL;
+
+	for (size_t i = 0; i < HASH_SIZE; i++) {
+		ds->head[i] = (ds->head[i] >= WINDOW_SIZE) ?
+		    ds->head[i] - WINDOW_SIZE : NIL;
+	}
+
+	for (size_t i = 0; i < WINDOW_SIZE; i++) {
+		ds->prev[i] = (ds->prev[i] >= WINDOW_SIZE) ?
+		    ds->prev[i] - WINDOW_SIZE : NIL;
+	}
+}
+
+/** Create deflate stream
+ *
+ * @param level Compression level (DEFLATE_LEVEL_MIN to DEFLATE_LEVEL_MAX).
+ * @param rds   Place to store pointer to the new deflate stream.
+ *
+ * @return EOK on success.
+ * @return EINVAL on invalid compression level.
+ * @return ENOMEM if out of memory.
+ *
+ */
+errno_t deflate_stream_create(int level, deflate_stream_t **rds)
+{
+	deflate_stream_t *ds;
+
+	if (level < DEFLATE_LEVEL_MIN || level > DEFLATE_LEVEL_MAX)
+		return EINVAL;
+
+	ds = calloc(1, sizeof(deflate_stream_t));
+	if (ds == NULL)
+		return ENOMEM;
+
+	ds->level = level;
+	ds->config = &config[level];
+	ds->match_length = MIN_MATCH - 1;
+	ds->prev_length = MIN_MATCH - 1;
+
+	/* Position NIL marks end of hash chains, start after it */
+	ds->strstart = 1;
+	ds->block_start = 1;
+
+	for (size_t code = 0; code < NUM_LEN; code++) {
+		for (size_t i = 0; i < ((size_t) 1 << lens_ext[code]); i++) {
+			size_t len = lens[code] + i;
+			if (len <= MAX_MATCH)
+				ds->length_code[len - MIN_MATCH] = code;
+		}
+	}
+
+	for (size_t code = 0; code < NUM_DIST; code++) {
+		for (size_t i = 0; i < ((size_t) 1 << dists_ext[code]); i++) {
+			size_t dist = dists[code] - 1 + i;
+			if (dist < 256)
+				ds->dist_code[dist] = code;
+			else
+				ds->dist_code[256 + (dist >> 7)] = code;
+		}
+	}
+
+	*rds = ds;
+	return EOK;
+}
+
+/** Destroy deflate stream
+ *
+ * @param ds Deflate stream.
+ *
+ */
+void deflate_stream_destroy(deflate_stream_t *ds)
+{
+	free(ds);
+}
+
+/** Compress a chunk of data
+ *
+ * Consume as much of @a src as possible and write as much compressed data
+ * as available into @a dest. Input that is not consumed must be passed
+ * again in the next call, possibly followed by more data. Compressed data
+ * is only produced once enough input has been collected for a block.
+ *
+ * Once all input has been passed, call repeatedly with @a finish set
+ * until deflate_stream_done() returns true.
+ *
+ * @param ds       Deflate stream.
+ * @param src      Source data buffer.
+ * @param srclen   Source buffer size (bytes).
+ * @param srcused  Place to store the number of bytes consumed.
+ * @param dest     Destination data buffer.
+ * @param destlen  Destination buffer size (bytes).
+ * @param destused Place to store the number of bytes produced.
+ * @param finish   @a src contains the end of the data.
+ *
+ * @return EOK on success.
+ *
+ */
+errno_t deflate_stream(deflate_stream_t *ds, const void *src, size_t srclen,
+    size_t *srcused, void *dest, size_t destlen, size_t *destused,
+    bool finish)
+{
+	const uint8_t *sp = (const uint8_t *) src;
+	uint8_t *dp = (uint8_t *) dest;
+	size_t srccnt = 0;
+	size_t destcnt = 0;
+	size_t now;
+	bool full;
+
+	while (true) {
+		/* Output pending data */
+		now = ds->pending_len - ds->pending_out;
+		if (now > destlen - destcnt)
+			now = destlen - destcnt;
+
+		memcpy(dp + destcnt, ds->pending + ds->pending_out, now);
+		ds->pending_out += now;
+		destcnt += now;
+
+		if (ds->pending_out < ds->pending_len || ds->done)
+			break;
+
+		ds->pending_len = 0;
+		ds->pending_out = 0;
+
+		if (ds->strstart >= WINDOW_SIZE + MAX_DISTANCE) {
+			if (ds->block_len > 0 || ds->sym_cnt > 0) {
+				deflate_flush_block(ds, false);
+				continue;
+			}
+
+			deflate_slide(ds);
+		}
+
+		/* Append input to the window */
+		now = 2 * WINDOW_SIZE - ds->strstart - ds->lookahead;
+		if (now > srclen - srccnt)
+			now = srclen - srccnt;
+
+		memcpy(ds->window + ds->strstart + ds->lookahead, sp + srccnt,
+		    now);
+		ds->lookahead += now;
+		srccnt += now;
+
+		bool flush = finish && srccnt == srclen;
+
+		if (ds->level == 0)
+			full = deflate_none(ds, flush);
+		else if (ds->config->lazy_match)
+			full = deflate_lazy(ds, flush);
+		else
+			full = deflate_greedy(ds, flush);
+
+		if (full) {
+			deflate_flush_block(ds, false);
+			continue;
+		}
+
+		if (!flush) {
+			/* Need more input */
+			if (srccnt == srclen)
+				break;
+			continue;
+		}
+
+		/* All input has been compressed */
+		deflate_flush_block(ds, true);
+		ds->done = true;
+	}
+
+	*srcused = srccnt;
+	*destused = destcnt;
+	return EOK;
+}
+
+/** Determine whether all compressed data has been produced
+ *
+ * @param ds Deflate stream.
+ *
+ * @return True if the last block has been encoded and output completely.
+ *
+ */
+bool deflate_stream_done(deflate_stream_t *ds)
+{
+	return ds->done && ds->pending_out == ds->pending_len;
+}
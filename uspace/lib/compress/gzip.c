@@ -32,6 +32,8 @@
 #include <mem.h>
 #include <byteorder.h>
 #include <stdlib.h>
+#include <adt/checksum.h>
+#include "deflate.h"
 #include "gzip.h"
 #include "inflate.h"
 
@@ -46,6 +48,11 @@
 #define GZIP_FLAG_FNAME     UINT8_C(1 << 3)
 #define GZIP_FLAG_FCOMMENT  UINT8_C(1 << 4)
 
+#define GZIP_XFL_MAX   UINT8_C(2)
+#define GZIP_XFL_FAST  UINT8_C(4)
+
+#define GZIP_OS_UNKNOWN  UINT8_C(255)
+
 typedef struct {
 	uint8_t id1;
 	uint8_t id2;
@@ -61,6 +68,76 @@ typedef struct {
 	uint32_t size;
 } __attribute__((packed)) gzip_footer_t;
 
+/** Streaming GZIP decompression state */
+typedef enum {
+	/** Reading fixed header */
+	gs_header,
+	/** Reading length of extra field */
+	gs_extra_len,
+	/** Skipping extra field */
+	gs_extra,
+	/** Skipping file name */
+	gs_name,
+	/** Skipping comment */
+	gs_comment,
+	/** Skipping header CRC */
+	gs_hcrc,
+	/** Inflating compressed data */
+	gs_data,
+	/** Reading footer */
+	gs_footer,
+	/** End of stream reached */
+	gs_done
+} gzip_stream_state_t;
+
+/** Streaming GZIP decompression */
+struct gzip_stream {
+	/** Decompression state */
+	gzip_stream_state_t state;
+	/** Header flags */
+	uint8_t flags;
+	/** Header, extra field length or footer bytes collected so far */
+	uint8_t buf[sizeof(gzip_header_t)];
+	/** Number of bytes in @c buf */
+	size_t bufcnt;
+	/** Number of bytes left to skip */
+	size_t skip;
+	/** Size of the decompressed data (modulo 2^32) */
+	uint32_t size;
+	/** Inflate stream for the compressed data */
+	inflate_stream_t *inflate;
+};
+
+/** Streaming GZIP compression state */
+typedef enum {
+	/** Writing header */
+	gc_header,
+	/** Compressing data */
+	gc_data,
+	/** Writing footer */
+	gc_footer,
+	/** End of stream written */
+	gc_done
+} gzip_cstream_state_t;
+
+/** Streaming GZIP compression */
+struct gzip_cstream {
+	/** Compression state */
+	gzip_cstream_state_t state;
+	/** Header or footer to write */
+	uint8_t buf[sizeof(gzip_header_t)];
+	/** Number of bytes in @c buf */
+	size_t buflen;
+	/** Number of bytes of @c buf already written */
+	size_t bufout;
+	/** CRC-32 of the uncompressed data */
+	uint32_t crc;
+	/** Size of the uncompressed data (modulo 2^32) */
+	uint32_t size;
+	/** Deflate stream for the compressed data */
+	deflate_stream_t *deflate;
+};
+
 /** Expand GZIP compressed data
  *
  * The routine allocates the output buffer based
@@ -175,9 +252,474 @@ errno_t gzip_expand(void *src, size_t srclen, void **dest, size_t *destlen)
 
 	errno_t ret = inflate(stream, stream_length, *dest, *destlen);
 	if (ret != EOK) {
-		free(dest);
+		free(*dest);
 		return ret;
 	}
 
 	return EOK;
 }
+
+/** Create GZIP decompression stream
+ *
+ * @param rgs Place to store pointer to the new stream.
+ *
+ * @return EOK on success.
+ * @return ENOMEM if out of memory.
+ *
+ */
+errno_t gzip_stream_create(gzip_stream_t **rgs)
+{
+	gzip_stream_t *gs;
+	errno_t rc;
+
+	gs = calloc(1, sizeof(gzip_stream_t));
+	if (gs == NULL)
+		return ENOMEM;
+
+	rc = inflate_stream_create(&gs->inflate);
+	if (rc != EOK) {
+		free(gs);
+		return rc;
+	}
+
+	gs->state = gs_header;
+	*rgs = gs;
+	return EOK;
+}
+
+/** Destroy GZIP decompression stream
+ *
+ * @param gs GZIP stream.
+ *
+ */
+void gzip_stream_destroy(gzip_stream_t *gs)
+{
+	inflate_stream_destroy(gs->inflate);
+	free(gs);
+}
+
+/** Collect a fixed number of bytes into the stream buffer
+ *
+ * @param gs     GZIP stream.
+ * @param src    Source data buffer.
+ * @param srclen Source buffer size (bytes).
+ * @param srccnt Position in the source buffer (updated).
+ * @param n      Number of bytes to collect.
+ *
+ * @return True if all @a n bytes have been collected.
+ *
+ */
+static bool gzip_stream_collect(gzip_stream_t *gs, const uint8_t *src,
+    size_t srclen, size_t *srccnt, size_t n)
+{
+	size_t now = n - gs->bufcnt;
+	if (now > srclen - *srccnt)
+		now = srclen - *srccnt;
+
+	memcpy(gs->buf + gs->bufcnt, src + *srccnt, now);
+	gs->bufcnt += now;
+	*srccnt += now;
+
+	return gs->bufcnt == n;
+}
+
+/** Skip a zero-terminated string
+ *
+ * @param src    Source data buffer.
+ * @param srclen Source buffer size (bytes).
+ * @param srccnt Position in the source buffer (updated).
+ *
+ * @return True if the terminating zero has been skipped.
+ *
+ */
+static bool gzip_stream_skip_string(const uint8_t *src, size_t srclen,
+    size_t *srccnt)
+{
+	while (*srccnt < srclen) {
+		if (src[*srccnt] == 0) {
+			(*srccnt)++;
+			return true;
+		}
+
+		(*srccnt)++;
+	}
+
+	return false;
+}
+
+/** Decompress a chunk of GZIP data
+ *
+ * Decompress as much of @a src as possible into @a dest. Input that
+ * is not consumed must be passed again in the next call, possibly
+ * followed by more data. Call repeatedly until gzip_stream_done()
+ * returns true. Unlike gzip_expand(), neither the whole input nor
+ * the whole output need to be in memory at once.
+ *
+ * So far, no CRC is performed. The size stored in the footer is checked.
+ *
+ * @param gs       GZIP stream.
+ * @param src      Source data buffer.
+ * @param srclen   Source buffer size (bytes).
+ * @param srcused  Place to store the number of bytes consumed.
+ * @param dest     Destination data buffer.
+ * @param destlen  Destination buffer size (bytes).
+ * @param destused Place to store the number of bytes produced.
+ *
+ * @return EOK on success.
+ * @return ENOENT on distance too large.
+ * @return EINVAL on invalid Huffman code, invalid deflate data,
+ *                   invalid compression method or invalid stream.
+ *
+ */
+errno_t gzip_stream(gzip_stream_t *gs, const void *src, size_t srclen,
+    size_t *srcused, void *dest, size_t destlen, size_t *destused)
+{
+	const uint8_t *sp = (const uint8_t *) src;
+	uint8_t *dp = (uint8_t *) dest;
+	gzip_header_t header;
+	gzip_footer_t footer;
+	size_t srccnt = 0;
+	size_t destcnt = 0;
+	size_t used;
+	size_t produced;
+	size_t now;
+	errno_t rc = EOK;
+
+	while (rc == EOK && gs->state != gs_done) {
+		switch (gs->state) {
+		case gs_header:
+			if (!gzip_stream_collect(gs, sp, srclen, &srccnt,
+			    sizeof(header)))
+				goto out;
+
+			memcpy(&header, gs->buf, sizeof(header));
+			gs->bufcnt = 0;
+
+			if ((header.id1 != GZIP_ID1) ||
+			    (header.id2 != GZIP_ID2) ||
+			    (header.method != GZIP_METHOD_DEFLATE) ||
+			    ((header.flags & (~GZIP_FLAGS_MASK)) != 0)) {
+				rc = EINVAL;
+				break;
+			}
+
+			gs->flags = header.flags;
+			gs->state = gs_extra_len;
+			break;
+		case gs_extra_len:
+			if ((gs->flags & GZIP_FLAG_FEXTRA) != 0) {
+				if (!gzip_stream_collect(gs, sp, srclen,
+				    &srccnt, sizeof(uint16_t)))
+					goto out;
+
+				gs->skip = gs->buf[0] | (gs->buf[1] << 8);
+				gs->bufcnt = 0;
+			}
+
+			gs->state = gs_extra;
+			break;
+		case gs_extra:
+		case gs_hcrc:
+			now = gs->skip;
+			if (now > srclen - srccnt)
+				now = srclen - srccnt;
+
+			srccnt += now;
+			gs->skip -= now;
+			if (gs->skip > 0)
+				goto out;
+
+			gs->state = (gs->state == gs_extra) ? gs_name : gs_data;
+			break;
+		case gs_name:
+			if ((gs->flags & GZIP_FLAG_FNAME) != 0 &&
+			    !gzip_stream_skip_string(sp, srclen, &srccnt))
+				goto out;
+
+			gs->state = gs_comment;
+			break;
+		case gs_comment:
+			if ((gs->flags & GZIP_FLAG_FCOMMENT) != 0 &&
+			    !gzip_stream_skip_string(sp, srclen, &srccnt))
+				goto out;
+
+			if ((gs->flags & GZIP_FLAG_FHCRC) != 0)
+				gs->skip = 2;
+
+			gs->state = gs_hcrc;
+			break;
+		case gs_data:
+			rc = inflate_stream(gs->inflate, sp + srccnt,
+			    srclen - srccnt, &used, dp + destcnt,
+			    destlen - destcnt, &produced);
+			srccnt += used;
+			destcnt += produced;
+			gs->size += produced;
+
+			if (rc != EOK)
+				break;
+
+			if (!inflate_stream_done(gs->inflate))
+				goto out;
+
+			gs->state = gs_footer;
+			break;
+		case gs_footer:
+			if (!gzip_stream_collect(gs, sp, srclen, &srccnt,
+			    sizeof(footer)))
+				goto out;
+
+			memcpy(&footer, gs->buf, sizeof(footer));
+			gs->bufcnt = 0;
+
+			if (uint32_t_le2host(footer.size) != gs->size) {
+				rc = EINVAL;
+				break;
+			}
+
+			gs->state = gs_done;
+			break;
+		case gs_done:
+			break;
+		}
+	}
+
+out:
+	*srcused = srccnt;
+	*destused = destcnt;
+	return rc;
+}
+
+/** Determine whether the end of the GZIP stream was reached
+ *
+ * @param gs GZIP stream.
+ *
+ * @return True if all data has been decompressed and the footer read.
+ *
+ */
+bool gzip_stream_done(gzip_stream_t *gs)
+{
+	return gs->state == gs_done;
+}
+
+/** Create GZIP compression stream
+ *
+ * @param level Compression level (DEFLATE_LEVEL_MIN to DEFLATE_LEVEL_MAX).
+ * @param rgs   Place to store pointer to the new stream.
+ *
+ * @return EOK on success.
+ * @return EINVAL on invalid compression level.
+ * @return ENOMEM if out of memory.
+ *
+ */
+errno_t gzip_cstream_create(int level, gzip_cstream_t **rgs)
+{
+	gzip_cstream_t *gs;
+	gzip_header_t header;
+	errno_t rc;
+
+	gs = calloc(1, sizeof(gzip_cstream_t));
+	if (gs == NULL)
+		return ENOMEM;
+
+	rc = deflate_stream_create(level, &gs->deflate);
+	if (rc != EOK) {
+		free(gs);
+		return rc;
+	}
+
+	header.id1 = GZIP_ID1;
+	header.id2 = GZIP_ID2;
+	header.method = GZIP_METHOD_DEFLATE;
+	header.flags = 0;
+	header.mtime = 0;
+	header.extra_flags = (level == DEFLATE_LEVEL_MAX) ? GZIP_XFL_MAX :
+	    (level == 1) ? GZIP_XFL_FAST : 0;
+	header.os = GZIP_OS_UNKNOWN;
+
+	memcpy(gs->buf, &header, sizeof(header));
+	gs->buflen = sizeof(header);
+	gs->state = gc_header;
+
+	*rgs = gs;
+	return EOK;
+}
+
+/** Destroy GZIP compression stream
+ *
+ * @param gs GZIP compression stream.
+ *
+ */
+void gzip_cstream_destroy(gzip_cstream_t *gs)
+{
+	deflate_stream_destroy(gs->deflate);
+	free(gs);
+}
+
+/** Compress a chunk of data into GZIP format
+ *
+ * Consume as much of @a src as possible and write as much compressed
+ * data as available into @a dest. Input that is not consumed must be
+ * passed again in the next call, possibly followed by more data. Once
+ * all input has been passed, call repeatedly with @a finish set until
+ * gzip_cstream_done() returns true.
+ *
+ * @param gs       GZIP compression stream.
+ * @param src      Source data buffer.
+ * @param srclen   Source buffer size (bytes).
+ * @param srcused  Place to store the number of bytes consumed.
+ * @param dest     Destination data buffer.
+ * @param destlen  Destination buffer size (bytes).
+ * @param destused Place to store the number of bytes produced.
+ * @param finish   @a src contains the end of the data.
+ *
+ * @return EOK on success.
+ *
+ */
+errno_t gzip_cstream(gzip_cstream_t *gs, const void *src, size_t srclen,
+    size_t *srcused, void *dest, size_t destlen, size_t *destused,
+    bool finish)
+{
+	uint8_t *dp = (uint8_t *) dest;
+	gzip_footer_t footer;
+	size_t destcnt = 0;
+	size_t srccnt = 0;
+	size_t used;
+	size_t produced;
+	size_t now;
+	errno_t rc = EOK;
+
+	while (rc == EOK && gs->state != gc_done) {
+		switch (gs->state) {
+		case gc_header:
+		case gc_footer:
+			now = gs->buflen - gs->bufout;
+			if (now > destlen - destcnt)
+				now = destlen - destcnt;
+
+			memcpy(dp + destcnt, gs->buf + gs->bufout, now);
+			gs->bufout += now;
+			destcnt += now;
+
+			if (gs->bufout < gs->buflen)
+				goto out;
+
+			gs->state = (gs->state == gc_header) ? gc_data :
+			    gc_done;
+			break;
+		case gc_data:
+			rc = deflate_stream(gs->deflate, src, srclen, &used,
+			    dp + destcnt, destlen - destcnt, &produced, finish);
+			if (rc != EOK)
+				break;
+
+			/* CRC is computed over the consumed input */
+			gs->crc = compute_crc32_seed((uint8_t *) src, used,
+			    gs->crc);
+			gs->size += used;
+			srccnt += used;
+			destcnt += produced;
+
+			if (!deflate_stream_done(gs->deflate))
+				goto out;
+
+			footer.crc32 = host2uint32_t_le(gs->crc);
+			footer.size = host2uint32_t_le(gs->size);
+			memcpy(gs->buf, &footer, sizeof(footer));
+			gs->buflen = sizeof(footer);
+			gs->bufout = 0;
+			gs->state = gc_footer;
+			break;
+		case gc_done:
+			break;
+		}
+	}
+
+out:
+	*srcused = srccnt;
+	*destused = destcnt;
+	return rc;
+}
+
+/** Determine whether the whole GZIP stream has been written
+ *
+ * @param gs GZIP compression stream.
+ *
+ * @return True if all compressed data and the footer have been written.
+ *
+ */
+bool gzip_cstream_done(gzip_cstream_t *gs)
+{
+	return gs->state == gc_done;
+}
+
+/** Compress data into GZIP format
+ *
+ * The routine allocates the output buffer.
+ *
+ * @param[in]  src     Source data buffer.
+ * @param[in]  srclen  Source buffer size (bytes).
+ * @param[in]  level   Compression level (DEFLATE_LEVEL_MIN to
+ *                     DEFLATE_LEVEL_MAX).
+ * @param[out] dest    Destination data buffer.
+ * @param[out] destlen Destination buffer size (bytes).
+ *
+ * @return EOK on success.
+ * @return EINVAL on invalid compression level.
+ * @return ENOMEM if out of memory.
+ *
+ */
+errno_t gzip_compress(void *src, size_t srclen, int level, void **dest,
+    size_t *destlen)
+{
+	gzip_cstream_t *gs;
+	uint8_t *buf = NULL;
+	uint8_t *nbuf;
+	size_t size;
+	size_t srccnt = 0;
+	size_t destcnt = 0;
+	size_t used;
+	size_t produced;
+	errno_t rc;
+
+	rc = gzip_cstream_create(level, &gs);
+	if (rc != EOK)
+		return rc;
+
+	/* Most data compress to less than half, grow the buffer if not */
+	size = srclen / 2 + 64;
+
+	while (!gzip_cstream_done(gs)) {
+		if (destcnt == size || buf == NULL) {
+			if (buf != NULL)
+				size *= 2;
+
+			nbuf = realloc(buf, size);
+			if (nbuf == NULL) {
+				free(buf);
+				gzip_cstream_destroy(gs);
+				return ENOMEM;
+			}
+
+			buf = nbuf;
+		}
+
+		rc = gzip_cstream(gs, (uint8_t *) src + srccnt,
+		    srclen - srccnt, &used, buf + destcnt, size - destcnt,
+		    &produced, true);
+		if (rc != EOK) {
+			free(buf);
+			gzip_cstream_destroy(gs);
+			return rc;
+		}
+
+		srccnt += used;
+		destcnt += produced;
+	}
+
+	gzip_cstream_destroy(gs);
+
+	*dest = buf;
+	*destlen = destcnt;
+	return EOK;
+}
@@ -29,8 +29,30 @@
 #ifndef LIBCOMPRESS_GZIP_H_
 #define LIBCOMPRESS_GZIP_H_
 
+#include <errno.h>
+#include <stdbool.h>
 #include <stddef.h>
 
+/** Streaming GZIP decompression */
+typedef struct gzip_stream gzip_stream_t;
+
+/** Streaming GZIP compression */
+typedef struct gzip_cstream gzip_cstream_t;
+
 extern errno_t gzip_expand(void *, size_t, void **, size_t *);
 
+extern errno_t gzip_stream_create(gzip_stream_t **);
+extern void gzip_stream_destroy(gzip_stream_t *);
+extern errno_t gzip_stream(gzip_stream_t *, const void *, size_t, size_t *,
+    void *, size_t, size_t *);
+extern bool gzip_stream_done(gzip_stream_t *);
+
+extern errno_t gzip_compress(void *, size_t, int, void **, size_t *);
+
+extern errno_t gzip_cstream_create(int, gzip_cstream_t **);
+extern void gzip_cstream_destroy(gzip_cstream_t *);
+extern errno_t gzip_cstream(gzip_cstream_t *, const void *, size_t, size_t *,
+    void *, size_t, size_t *, bool);
+extern bool gzip_cstream_done(gzip_cstream_t *);
+
 #endif
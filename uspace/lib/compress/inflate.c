@@ -31,11 +31,19 @@
  * @brief Implementation of inflate decompression
  *
  * A simple inflate implementation (decompression of `deflate' stream as
- * described by RFC 1951) based on puff.c by Mark Adler. This code is
- * currently not optimized for speed but for readability.
+ * described by RFC 1951) based on puff.c by Mark Adler.
+ *
+ * Huffman codes are decoded using a lookup table indexed by the next
+ * FAST_BITS bits of input, which resolves most symbols in one step;
+ * only longer codes fall back to walking the canonical code bit by bit.
+ * Input is loaded into a 64-bit bit buffer a word at a time.
  *
  * All dynamically allocated memory memory is taken from the stack. The
- * stack usage should be typically bounded by 2 KB.
+ * stack usage should be typically bounded by 4 KB.
+ *
+ * The streaming variant (inflate_stream()) keeps its state, including
+ * the 32 KiB sliding window, in a heap-allocated inflate_stream_t so that
+ * the input and output can be processed in chunks of arbitrary size.
  *
  * Original copyright notice:
  *
@@ -63,11 +71,14 @@
  *
  */
 
+#include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <errno.h>
 #include <mem.h>
+#include <byteorder.h>
+#include <stdlib.h>
 #include "inflate.h"
 
 /** Maximum bits in the Huffman code */
@@ -87,6 +98,18 @@
 /** Number of all codes */
 #define MAX_CODE  (MAX_LITLEN + MAX_DIST)
 
+/** Size of the sliding window (maximum distance) */
+#define WINDOW_SIZE  32768
+
+/** Number of bits resolved by the Huffman lookup table */
+#define FAST_BITS  9
+
+/** Number of entries in the Huffman lookup table */
+#define FAST_SIZE  (1 << FAST_BITS)
+
+/** Maximum length of a match */
+#define MAX_MATCH  258
+
 /** Check for input buffer overrun condition */
 #define CHECK_OVERRUN(state) \
 	do { \
@@ -106,7 +129,7 @@ typedef struct {
 	size_t srclen;    /**< Input buffer size */
 	size_t srccnt;    /**< Position in the input buffer */
 
-	uint16_t bitbuf;  /**< Bit buffer */
+	uint64_t bitbuf;  /**< Bit buffer */
 	size_t bitlen;    /**< Number of bits in the bit buffer */
 
 	bool overrun;     /**< Overrun condition */
@@ -118,6 +141,14 @@ typedef struct {
 typedef struct {
 	uint16_t *count;   /**< Array of symbol counts */
 	uint16_t *symbol;  /**< Array of symbols */
+
+	/** Lookup table indexed by the next FAST_BITS bits of input
+	 *
+	 * Each entry holds the symbol shifted left by 4 bits and the
+	 * length of its code in the low 4 bits. Zero means that the code
+	 * is longer than FAST_BITS (or invalid).
+	 */
+	uint16_t *fast;
 } huffman_t;
 
 /** Length codes
@@ -210,21 +241,41 @@ static uint16_t dist_symbol[MAX_DIST] = {
 	16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29
 };
 
-/** Huffman code for lengths
+/** Fill up the bit buffer
  *
- */
-static huffman_t len_code = {
-	.count = len_count,
-	.symbol = len_symbol
-};
-
-/** Huffman code for distances
+ * Load as many whole bytes as fit into the bit buffer. If at least
+ * 8 bytes of input are left, they are loaded as a single word.
+ *
+ * @param src    Input buffer.
+ * @param srclen Input buffer size.
+ * @param srccnt Position in the input buffer (updated).
+ * @param bitbuf Bit buffer (updated).
+ * @param bitlen Number of bits in the bit buffer (updated).
  *
  */
-static huffman_t dist_code = {
-	.count = dist_count,
-	.symbol = dist_symbol
-};
+static inline void bits_refill(const uint8_t *src, size_t srclen,
+    size_t *srccnt, uint64_t *bitbuf, size_t *bitlen)
+{
+	if (srclen - *srccnt >= sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, src + *srccnt, sizeof(uint64_t));
+
+		size_t cnt = (63 - *bitlen) / 8;
+		*bitbuf |= uint64_t_le2host(word) << *bitlen;
+		*srccnt += cnt;
+		*bitlen += cnt * 8;
+
+		/* Drop the bits of the bytes that did not fit completely */
+		*bitbuf &= (UINT64_C(1) << *bitlen) - 1;
+		return;
+	}
+
+	while (*bitlen <= 56 && *srccnt < srclen) {
+		*bitbuf |= ((uint64_t) src[*srccnt]) << *bitlen;
+		(*srccnt)++;
+		*bitlen += 8;
+	}
+}
 
 /** Get bits from the bit buffer
  *
@@ -236,26 +287,22 @@ static huffman_t dist_code = {
  */
 static inline uint16_t get_bits(inflate_state_t *state, size_t cnt)
 {
-	/* Bit accumulator for at least 20 bits */
-	uint32_t val = state->bitbuf;
-
-	while (state->bitlen < cnt) {
-		if (state->srccnt == state->srclen) {
+	if (state->bitlen < cnt) {
+		bits_refill(state->src, state->srclen, &state->srccnt,
+		    &state->bitbuf, &state->bitlen);
+		if (state->bitlen < cnt) {
 			state->overrun = true;
 			return 0;
 		}
-
-		/* Load 8 more bits */
-		val |= ((uint32_t) state->src[state->srccnt]) << state->bitlen;
-		state->srccnt++;
-		state->bitlen += 8;
 	}
 
+	uint16_t val = state->bitbuf & ((UINT64_C(1) << cnt) - 1);
+
 	/* Update bits in the buffer */
-	state->bitbuf = (uint16_t) (val >> cnt);
+	state->bitbuf >>= cnt;
 	state->bitlen -= cnt;
 
-	return ((uint16_t) (val & ((1 << cnt) - 1)));
+	return val;
 }
 
 /** Decode `stored' block
@@ -270,7 +317,11 @@ static inline uint16_t get_bits(inflate_state_t *state, size_t cnt)
  */
 static errno_t inflate_stored(inflate_state_t *state)
 {
-	/* Discard bits in the bit buffer */
+	/*
+	 * Discard bits up to the byte boundary and return whole bytes
+	 * in the bit buffer to the input.
+	 */
+	state->srccnt -= state->bitlen / 8;
 	state->bitbuf = 0;
 	state->bitlen = 0;
 
@@ -304,19 +355,36 @@ static errno_t inflate_stored(inflate_state_t *state)
 	return EOK;
 }
 
-/** Decode a symbol using the Huffman code
+/** Look up a symbol in the Huffman code
+ *
+ * Bits of @a bitbuf above @a bitlen must be zero.
  *
- * @param state   Inflate state.
  * @param huffman Huffman code.
+ * @param bitbuf  Bit buffer with the next code in the least significant bits.
+ * @param bitlen  Number of valid bits in the bit buffer.
  * @param symbol  Decoded symbol.
+ * @param nbits   Length of the code of the symbol.
  *
- * @param EOK on success.
- * @param EINVAL on invalid Huffman code.
+ * @return EOK on success.
+ * @return ELIMIT if the code is longer than @a bitlen.
+ * @return EINVAL on invalid Huffman code.
  *
  */
-static errno_t huffman_decode(inflate_state_t *state, huffman_t *huffman,
-    uint16_t *symbol)
+static inline errno_t huffman_lookup(huffman_t *huffman, uint64_t bitbuf,
+    size_t bitlen, uint16_t *symbol, size_t *nbits)
 {
+	uint16_t entry = huffman->fast[bitbuf & (FAST_SIZE - 1)];
+	size_t len = entry & 0x0f;
+
+	if (len != 0) {
+		if (len > bitlen)
+			return ELIMIT;
+
+		*symbol = entry >> 4;
+		*nbits = len;
+		return EOK;
+	}
+
 	/* Decode bits */
 	uint16_t code = 0;
 
@@ -329,18 +397,18 @@ static errno_t huffman_decode(inflate_state_t *state, huffman_t *huffman,
 	 */
 	size_t index = 0;
 
-	/* Current number of bits in the code */
-	size_t len;
-
 	for (len = 1; len <= MAX_HUFFMAN_BIT; len++) {
+		if (len > bitlen)
+			return ELIMIT;
+
 		/* Get next bit */
-		code |= get_bits(state, 1);
-		CHECK_OVERRUN(*state);
+		code |= (bitbuf >> (len - 1)) & 1;
 
 		uint16_t count = huffman->count[len];
 		if (code < first + count) {
 			/* Return decoded symbol */
 			*symbol = huffman->symbol[index + code - first];
+			*nbits = len;
 			return EOK;
 		}
 
@@ -354,6 +422,73 @@ static errno_t huffman_decode(inflate_state_t *state, huffman_t *huffman,
 	return EINVAL;
 }
 
+/** Decode a symbol using the Huffman code
+ *
+ * @param state   Inflate state.
+ * @param huffman Huffman code.
+ * @param symbol  Decoded symbol.
+ *
+ * @param EOK on success.
+ * @param EINVAL on invalid Huffman code.
+ * @param ELIMIT on input buffer overrun.
+ *
+ */
+static inline errno_t huffman_decode(inflate_state_t *state,
+    huffman_t *huffman, uint16_t *symbol)
+{
+	size_t nbits;
+
+	if (state->bitlen < MAX_HUFFMAN_BIT) {
+		bits_refill(state->src, state->srclen, &state->srccnt,
+		    &state->bitbuf, &state->bitlen);
+	}
+
+	errno_t rc = huffman_lookup(huffman, state->bitbuf, state->bitlen,
+	    symbol, &nbits);
+	if (rc == ELIMIT)
+		state->overrun = true;
+	if (rc != EOK)
+		return rc;
+
+	state->bitbuf >>= nbits;
+	state->bitlen -= nbits;
+	return EOK;
+}
+
+/** Fill the lookup table of a Huffman code
+ *
+ * @param huffman Huffman code with symbol counts and symbols filled in.
+ *
+ */
+static void huffman_fast(huffman_t *huffman)
+{
+	/* Next code of the current length */
+	uint16_t code = 0;
+
+	/* Index of the current symbol in the symbol table */
+	size_t index = 0;
+
+	memset(huffman->fast, 0, FAST_SIZE * sizeof(uint16_t));
+
+	for (size_t len = 1; len <= FAST_BITS; len++) {
+		for (uint16_t i = 0; i < huffman->count[len]; i++) {
+			/* Codes are packed starting with the MSB */
+			size_t rev = 0;
+			for (size_t bit = 0; bit < len; bit++)
+				rev |= ((code >> bit) & 1) << (len - 1 - bit);
+
+			uint16_t entry = (huffman->symbol[index] << 4) | len;
+			for (; rev < FAST_SIZE; rev += (size_t) 1 << len)
+				huffman->fast[rev] = entry;
+
+			index++;
+			code++;
+		}
+
+		code <<= 1;
+	}
+}
+
 /** Construct Huffman tables from canonical Huffman code
  *
  * @param huffman Constructed Huffman tables.
@@ -379,6 +514,7 @@ static int16_t huffman_construct(huffman_t *huffman, uint16_t *length, size_t n)
 
 	if (huffman->count[0] == n) {
 		/* The code is complete, but decoding will fail */
+		huffman_fast(huffman);
 		return 0;
 	}
 
@@ -407,6 +543,7 @@ static int16_t huffman_construct(huffman_t *huffman, uint16_t *length, size_t n)
 		}
 	}
 
+	huffman_fast(huffman);
 	return left;
 }
 
@@ -458,19 +595,31 @@ static errno_t inflate_codes(inflate_state_t *state, huffman_t *len_code,
 			if (err != EOK)
 				return err;
 
+			if (symbol >= MAX_DIST)
+				return EINVAL;
+
 			size_t dist = dists[symbol] + get_bits(state, dists_ext[symbol]);
+			CHECK_OVERRUN(*state);
+
 			if (dist > state->destcnt)
 				return ENOENT;
 
 			if (state->destcnt + len > state->destlen)
 				return ENOMEM;
 
-			while (len > 0) {
-				/* Copy len bytes from distance bytes back */
-				state->dest[state->destcnt] =
-				    state->dest[state->destcnt - dist];
-				state->destcnt++;
-				len--;
+			/* Copy len bytes from distance bytes back */
+			uint8_t *dp = state->dest + state->destcnt;
+			state->destcnt += len;
+
+			if (dist >= len) {
+				memcpy(dp, dp - dist, len);
+			} else {
+				/* Overlapping match repeats last bytes */
+				while (len > 0) {
+					*dp = *(dp - dist);
+					dp++;
+					len--;
+				}
 			}
 		}
 	} while (symbol != 256);
@@ -481,8 +630,6 @@ static errno_t inflate_codes(inflate_state_t *state, huffman_t *len_code,
 /** Decode `fixed codes' block
  *
  * @param state     Inflate state.
- * @param len_code  Huffman code for literal/length.
- * @param dist_code Huffman code for distance.
  *
  * @return EOK on success.
  * @return ENOENT on distance too large.
@@ -491,10 +638,24 @@ static errno_t inflate_codes(inflate_state_t *state, huffman_t *len_code,
  * @return ENOMEM on output buffer overrun.
  *
  */
-static errno_t inflate_fixed(inflate_state_t *state, huffman_t *len_code,
-    huffman_t *dist_code)
+static errno_t inflate_fixed(inflate_state_t *state)
 {
-	return inflate_codes(state, len_code, dist_code);
+	uint16_t fixed_len_fast[FAST_SIZE];
+	uint16_t fixed_dist_fast[FAST_SIZE];
+	huffman_t fixed_len_code;
+	huffman_t fixed_dist_code;
+
+	fixed_len_code.count = len_count;
+	fixed_len_code.symbol = len_symbol;
+	fixed_len_code.fast = fixed_len_fast;
+	huffman_fast(&fixed_len_code);
+
+	fixed_dist_code.count = dist_count;
+	fixed_dist_code.symbol = dist_symbol;
+	fixed_dist_code.fast = fixed_dist_fast;
+	huffman_fast(&fixed_dist_code);
+
+	return inflate_codes(state, &fixed_len_code, &fixed_dist_code);
 }
 
 /** Decode `dynamic codes' block
@@ -515,14 +676,18 @@ static errno_t inflate_dynamic(inflate_state_t *state)
 	uint16_t dyn_len_symbol[MAX_LITLEN];
 	uint16_t dyn_dist_count[MAX_HUFFMAN_BIT + 1];
 	uint16_t dyn_dist_symbol[MAX_DIST];
+	uint16_t dyn_len_fast[FAST_SIZE];
+	uint16_t dyn_dist_fast[FAST_SIZE];
 	huffman_t dyn_len_code;
 	huffman_t dyn_dist_code;
 
 	dyn_len_code.count = dyn_len_count;
 	dyn_len_code.symbol = dyn_len_symbol;
+	dyn_len_code.fast = dyn_len_fast;
 
 	dyn_dist_code.count = dyn_dist_count;
 	dyn_dist_code.symbol = dyn_dist_symbol;
+	dyn_dist_code.fast = dyn_dist_fast;
 
 	/* Get number of bits in each table */
 	uint16_t nlen = get_bits(state, 5) + 257;
@@ -560,7 +725,7 @@ static errno_t inflate_dynamic(inflate_state_t *state)
 		uint16_t symbol;
 		errno_t err = huffman_decode(state, &dyn_len_code, &symbol);
 		if (err != EOK)
-			return EOK;
+			return err;
 
 		if (symbol < 16) {
 			length[index] = symbol;
@@ -660,7 +825,7 @@ errno_t inflate(void *src, size_t srclen, void *dest, size_t destlen)
 			ret = inflate_stored(&state);
 			break;
 		case 1:
-			ret = inflate_fixed(&state, &len_code, &dist_code);
+			ret = inflate_fixed(&state);
 			break;
 		case 2:
 			ret = inflate_dynamic(&state);
@@ -672,3 +837,798 @@ errno_t inflate(void *src, size_t srclen, void *dest, size_t destlen)
 
 	return ret;
 }
+
+/** Streaming inflate state
+ *
+ */
+typedef enum {
+	/** Expecting block header */
+	is_header,
+	/** Expecting length of a stored block */
+	is_stored_len,
+	/** Copying data of a stored block */
+	is_stored,
+	/** Expecting header of a dynamic block */
+	is_dyn_header,
+	/** Reading code length code lengths */
+	is_dyn_clen,
+	/** Reading literal/length and distance code lengths */
+	is_dyn_lens,
+	/** Expecting literal/length code */
+	is_codes,
+	/** Expecting distance code */
+	is_dist,
+	/** Copying match */
+	is_copy,
+	/** End of stream reached */
+	is_done,
+	/** Invalid data encountered */
+	is_error
+} inflate_stream_state_t;
+
+/** Streaming inflate
+ *
+ * Bytes are only loaded into the bit buffer when the bits are actually
+ * needed. Thus, once an operation has completed, the bit buffer holds
+ * less than 8 bits and no input beyond the end of the deflate stream
+ * is ever consumed.
+ *
+ */
+struct inflate_stream {
+	inflate_stream_state_t state;  /**< Decoder state */
+	errno_t error;                 /**< Error for is_error state */
+	bool last;                     /**< Decoding the last block */
+
+	const uint8_t *src;  /**< Input buffer of the current call */
+	size_t srclen;       /**< Input buffer size */
+	size_t srccnt;       /**< Position in the input buffer */
+
+	uint8_t *dest;       /**< Output buffer of the current call */
+	size_t destlen;      /**< Output buffer size */
+	size_t destcnt;      /**< Position in the output buffer */
+
+	uint64_t bitbuf;     /**< Bit buffer */
+	size_t bitlen;       /**< Number of bits in the bit buffer */
+
+	uint8_t window[WINDOW_SIZE];  /**< Sliding window */
+	size_t wpos;                  /**< Write position in the window */
+	size_t wfill;                 /**< Number of valid bytes in window */
+
+	size_t stored_left;  /**< Bytes left in the stored block */
+	size_t copy_len;     /**< Bytes left to copy in the match */
+	size_t copy_dist;    /**< Distance of the match */
+
+	uint16_t nlen;       /**< Number of literal/length codes */
+	uint16_t ndist;      /**< Number of distance codes */
+	uint16_t ncode;      /**< Number of code length codes */
+	uint16_t index;      /**< Number of code lengths read so far */
+	uint16_t length[MAX_CODE];  /**< Code lengths */
+
+	huffman_t *len_code;   /**< Literal/length code of the block */
+	huffman_t *dist_code;  /**< Distance code of the block */
+
+	uint16_t dyn_len_count[MAX_HUFFMAN_BIT + 1];
+	uint16_t dyn_len_symbol[MAX_LITLEN];
+	uint16_t dyn_dist_count[MAX_HUFFMAN_BIT + 1];
+	uint16_t dyn_dist_symbol[MAX_DIST];
+	uint16_t dyn_len_fast[FAST_SIZE];
+	uint16_t dyn_dist_fast[FAST_SIZE];
+	huffman_t dyn_len_code;
+	huffman_t dyn_dist_code;
+
+	uint16_t fixed_len_fast[FAST_SIZE];
+	uint16_t fixed_dist_fast[FAST_SIZE];
+	huffman_t fixed_len_code;
+	huffman_t fixed_dist_code;
+};
+
+/** Make sure the bit buffer holds at least the given number of bits
+ *
+ * @param is  Inflate stream.
+ * @param cnt Number of bits (at most 32).
+ *
+ * @return True if the bits are available, false if more input is needed.
+ *
+ */
+static inline bool stream_need(inflate_stream_t *is, size_t cnt)
+{
+	while (is->bitlen < cnt) {
+		if (is->srccnt == is->srclen)
+			return false;
+
+		is->bitbuf |= ((uint64_t) is->src[is->srccnt]) << is->bitlen;
+		is->srccnt++;
+		is->bitlen += 8;
+	}
+
+	return true;
+}
+
+/** Get bits from the bit buffer
+ *
+ * The bits must be made available by stream_need() first.
+ *
+ * @param is  Inflate stream.
+ * @param cnt Number of bits to return (at most 16).
+ *
+ * @return Returned bits.
+ *
+ */
+static inline uint16_t stream_get(inflate_stream_t *is, size_t cnt)
+{
+	uint16_t val = is->bitbuf & ((UINT64_C(1) << cnt) - 1);
+
+	is->bitbuf >>= cnt;
+	is->bitlen -= cnt;
+	return val;
+}
+
+/** Write a byte to the output buffer and to the sliding window
+ *
+ * @param is   Inflate stream.
+ * @param byte Byte to write.
+ *
+ */
+static inline void stream_put(inflate_stream_t *is, uint8_t byte)
+{
+	is->dest[is->destcnt] = byte;
+	is->destcnt++;
+
+	is->window[is->wpos] = byte;
+	is->wpos = (is->wpos + 1) % WINDOW_SIZE;
+	if (is->wfill < WINDOW_SIZE)
+		is->wfill++;
+}
+
+/** Append bytes to the sliding window
+ *
+ * @param is  Inflate stream.
+ * @param src Bytes to append.
+ * @param len Number of bytes.
+ *
+ */
+static void stream_window_append(inflate_stream_t *is, const uint8_t *src,
+    size_t len)
+{
+	/* Only the last WINDOW_SIZE bytes can be referenced */
+	if (len > WINDOW_SIZE) {
+		src += len - WINDOW_SIZE;
+		len = WINDOW_SIZE;
+	}
+
+	while (len > 0) {
+		size_t now = WINDOW_SIZE - is->wpos;
+		if (now > len)
+			now = len;
+
+		memcpy(is->window + is->wpos, src, now);
+		is->wpos = (is->wpos + now) % WINDOW_SIZE;
+		is->wfill += now;
+		if (is->wfill > WINDOW_SIZE)
+			is->wfill = WINDOW_SIZE;
+
+		src += now;
+		len -= now;
+	}
+}
+
+/** Copy bytes from the input to the output buffer and the sliding window
+ *
+ * @param is  Inflate stream.
+ * @param len Number of bytes to copy.
+ *
+ */
+static void stream_copy_input(inflate_stream_t *is, size_t len)
+{
+	const uint8_t *src = is->src + is->srccnt;
+
+	memcpy(is->dest + is->destcnt, src, len);
+	is->srccnt += len;
+	is->destcnt += len;
+
+	stream_window_append(is, src, len);
+}
+
+/** Decode a symbol using the Huffman code without consuming it
+ *
+ * @param is      Inflate stream.
+ * @param huffman Huffman code.
+ * @param symbol  Decoded symbol.
+ * @param nbits   Length of the code of the symbol.
+ *
+ * @return EOK on success.
+ * @return ELIMIT if more input is needed.
+ * @return EINVAL on invalid Huffman code.
+ *
+ */
+static errno_t stream_decode(inflate_stream_t *is, huffman_t *huffman,
+    uint16_t *symbol, size_t *nbits)
+{
+	errno_t rc;
+
+	while (true) {
+		rc = huffman_lookup(huffman, is->bitbuf, is->bitlen, symbol,
+		    nbits);
+		if (rc != ELIMIT)
+			return rc;
+
+		/* Load one more byte only if the code is not complete */
+		if (!stream_need(is, is->bitlen + 1))
+			return ELIMIT;
+	}
+}
+
+/** Finish a block
+ *
+ * @param is Inflate stream.
+ *
+ */
+static void stream_block_end(inflate_stream_t *is)
+{
+	if (is->last) {
+		/* Discard the padding of the last byte */
+		is->bitbuf = 0;
+		is->bitlen = 0;
+		is->state = is_done;
+	} else {
+		is->state = is_header;
+	}
+}
+
+/** Read the header of a dynamic block and build its Huffman codes
+ *
+ * @param is Inflate stream.
+ *
+ * @return EOK on success or if more input is needed.
+ * @return EINVAL on invalid data.
+ *
+ */
+static errno_t stream_dynamic(inflate_stream_t *is)
+{
+	uint16_t symbol;
+	size_t nbits;
+	uint16_t index;
+	int16_t rc;
+	errno_t err;
+
+	if (is->state == is_dyn_header) {
+		if (!stream_need(is, 14))
+			return EOK;
+
+		is->nlen = stream_get(is, 5) + 257;
+		is->ndist = stream_get(is, 5) + 1;
+		is->ncode = stream_get(is, 4) + 4;
+
+		if ((is->nlen > MAX_LITLEN) || (is->ndist > MAX_DIST) ||
+		    (is->ncode > MAX_ORDER))
+			return EINVAL;
+
+		is->index = 0;
+		is->state = is_dyn_clen;
+	}
+
+	if (is->state == is_dyn_clen) {
+		/* Read code length code lengths */
+		while (is->index < is->ncode) {
+			if (!stream_need(is, 3))
+				return EOK;
+
+			is->length[order[is->index]] = stream_get(is, 3);
+			is->index++;
+		}
+
+		/* Set missing lengths to zero */
+		for (index = is->ncode; index < MAX_ORDER; index++)
+			is->length[order[index]] = 0;
+
+		rc = huffman_construct(&is->dyn_len_code, is->length,
+		    MAX_ORDER);
+		if (rc != 0)
+			return EINVAL;
+
+		is->index = 0;
+		is->state = is_dyn_lens;
+	}
+
+	/* Read length/literal and distance code length tables */
+	while (is->index < is->nlen + is->ndist) {
+		err = stream_decode(is, &is->dyn_len_code, &symbol, &nbits);
+		if (err == ELIMIT)
+			return EOK;
+		if (err != EOK)
+			return err;
+
+		if (symbol < 16) {
+			(void) stream_get(is, nbits);
+			is->length[is->index] = symbol;
+			is->index++;
+			continue;
+		}
+
+		uint16_t len = 0;
+		size_t extra = (symbol == 16) ? 2 : (symbol == 17) ? 3 : 7;
+
+		if (!stream_need(is, nbits + extra))
+			return EOK;
+
+		(void) stream_get(is, nbits);
+
+		if (symbol == 16) {
+			if (is->index == 0)
+				return EINVAL;
+
+			len = is->length[is->index - 1];
+			symbol = stream_get(is, 2) + 3;
+		} else if (symbol == 17) {
+			symbol = stream_get(is, 3) + 3;
+		} else {
+			symbol = stream_get(is, 7) + 11;
+		}
+
+		if (is->index + symbol > is->nlen + is->ndist)
+			return EINVAL;
+
+		while (symbol > 0) {
+			is->length[is->index] = len;
+			is->index++;
+			symbol--;
+		}
+	}
+
+	/* Check for end-of-block code */
+	if (is->length[256] == 0)
+		return EINVAL;
+
+	/* Build Huffman tables for literal/length codes */
+	rc = huffman_construct(&is->dyn_len_code, is->length, is->nlen);
+	if ((rc < 0) || ((rc > 0) &&
+	    (is->dyn_len_code.count[0] + 1 != is->nlen)))
+		return EINVAL;
+
+	/* Build Huffman tables for distance codes */
+	rc = huffman_construct(&is->dyn_dist_code, is->length + is->nlen,
+	    is->ndist);
+	if ((rc < 0) || ((rc > 0) &&
+	    (is->dyn_dist_code.count[0] + 1 != is->ndist)))
+		return EINVAL;
+
+	is->len_code = &is->dyn_len_code;
+	is->dist_code = &is->dyn_dist_code;
+	is->state = is_codes;
+	return EOK;
+}
+
+/** Decode literal/length and distance codes without interruption
+ *
+ * Decode as long as there is enough input for any single literal or
+ * match and enough output space for the longest match. This avoids
+ * checking for running out of input or output space after every step
+ * and writing to the sliding window byte by byte. Matches are copied
+ * directly from the output buffer where possible.
+ *
+ * Stop before the end-of-block code, an invalid code or when running
+ * low on input or output space, leaving these to stream_codes().
+ *
+ * @param is Inflate stream in the is_codes state.
+ *
+ * @return EOK on success.
+ * @return ENOENT on distance too large.
+ *
+ */
+static errno_t stream_fast(inflate_stream_t *is)
+{
+	uint8_t *dest = is->dest;
+	size_t start = is->destcnt;
+	size_t destcnt = is->destcnt;
+	size_t srcstart = is->srccnt;
+	size_t ret;
+	uint16_t symbol;
+	size_t nbits;
+	errno_t rc = EOK;
+
+	/*
+	 * One iteration needs at most 48 bits, while a refill with
+	 * at least 8 bytes of input left provides at least 56 bits.
+	 */
+	while (is->srclen - is->srccnt >= sizeof(uint64_t) &&
+	    is->destlen - destcnt >= MAX_MATCH) {
+		bits_refill(is->src, is->srclen, &is->srccnt, &is->bitbuf,
+		    &is->bitlen);
+
+		if (huffman_lookup(is->len_code, is->bitbuf, is->bitlen,
+		    &symbol, &nbits) != EOK)
+			break;
+
+		if (symbol < 256) {
+			/* Write out literal */
+			is->bitbuf >>= nbits;
+			is->bitlen -= nbits;
+			dest[destcnt++] = (uint8_t) symbol;
+			continue;
+		}
+
+		if (symbol == 256 || symbol - 257 >= 29)
+			break;
+
+		/* Compute length */
+		symbol -= 257;
+		is->bitbuf >>= nbits;
+		is->bitlen -= nbits;
+
+		size_t len = lens[symbol] +
+		    (is->bitbuf & ((UINT64_C(1) << lens_ext[symbol]) - 1));
+		is->bitbuf >>= lens_ext[symbol];
+		is->bitlen -= lens_ext[symbol];
+
+		/* Get distance */
+		if (huffman_lookup(is->dist_code, is->bitbuf, is->bitlen,
+		    &symbol, &nbits) != EOK || symbol >= MAX_DIST) {
+			/* Let stream_codes() report the error */
+			is->copy_len = len;
+			is->state = is_dist;
+			break;
+		}
+
+		is->bitbuf >>= nbits;
+		is->bitlen -= nbits;
+
+		size_t dist = dists[symbol] +
+		    (is->bitbuf & ((UINT64_C(1) << dists_ext[symbol]) - 1));
+		is->bitbuf >>= dists_ext[symbol];
+		is->bitlen -= dists_ext[symbol];
+
+		/* Bytes produced here are not in the window yet */
+		if (dist > is->wfill + (destcnt - start)) {
+			rc = ENOENT;
+			break;
+		}
+
+		/* Copy bytes preceding the output buffer from the window */
+		while (len > 0 && dist > destcnt) {
+			dest[destcnt] = is->window[(is->wpos + WINDOW_SIZE -
+			    (dist - (destcnt - start))) % WINDOW_SIZE];
+			destcnt++;
+			len--;
+		}
+
+		/* Copy len bytes from distance bytes back */
+		if (dist >= len) {
+			memcpy(dest + destcnt, dest + destcnt - dist, len);
+			destcnt += len;
+		} else {
+			/* Overlapping match repeats the last dist bytes */
+			while (len > 0) {
+				dest[destcnt] = dest[destcnt - dist];
+				destcnt++;
+				len--;
+			}
+		}
+	}
+
+	stream_window_append(is, dest + start, destcnt - start);
+	is->destcnt = destcnt;
+
+	/*
+	 * Return whole bytes in the bit buffer loaded here to the input
+	 * so that no input beyond the end of the deflate stream is
+	 * consumed.
+	 */
+	ret = is->bitlen / 8;
+	if (ret > is->srccnt - srcstart)
+		ret = is->srccnt - srcstart;
+
+	is->srccnt -= ret;
+	is->bitlen -= ret * 8;
+	is->bitbuf &= (UINT64_C(1) << is->bitlen) - 1;
+
+	return rc;
+}
+
+/** Decode literal/length and distance codes
+ *
+ * Decode until end-of-block code, until more input is needed or
+ * until the output buffer is full.
+ *
+ * @param is Inflate stream.
+ *
+ * @return EOK on success.
+ * @return ENOENT on distance too large.
+ * @return EINVAL on invalid Huffman code.
+ *
+ */
+static errno_t stream_codes(inflate_stream_t *is)
+{
+	uint16_t symbol;
+	size_t nbits;
+	errno_t err;
+
+	while (true) {
+		if (is->state == is_codes) {
+			err = stream_fast(is);
+			if (err != EOK)
+				return err;
+		}
+
+		if (is->state == is_codes) {
+			err = stream_decode(is, is->len_code, &symbol, &nbits);
+			if (err == ELIMIT)
+				return EOK;
+			if (err != EOK)
+				return err;
+
+			if (symbol < 256) {
+				/* Write out literal */
+				if (is->destcnt == is->destlen)
+					return EOK;
+
+				(void) stream_get(is, nbits);
+				stream_put(is, (uint8_t) symbol);
+				continue;
+			}
+
+			if (symbol == 256) {
+				(void) stream_get(is, nbits);
+				stream_block_end(is);
+				return EOK;
+			}
+
+			/* Compute length */
+			symbol -= 257;
+			if (symbol >= 29)
+				return EINVAL;
+
+			if (!stream_need(is, nbits + lens_ext[symbol]))
+				return EOK;
+
+			(void) stream_get(is, nbits);
+			is->copy_len = lens[symbol] +
+			    stream_get(is, lens_ext[symbol]);
+			is->state = is_dist;
+		}
+
+		if (is->state == is_dist) {
+			/* Get distance */
+			err = stream_decode(is, is->dist_code, &symbol, &nbits);
+			if (err == ELIMIT)
+				return EOK;
+			if (err != EOK)
+				return err;
+
+			if (symbol >= MAX_DIST)
+				return EINVAL;
+
+			if (!stream_need(is, nbits + dists_ext[symbol]))
+				return EOK;
+
+			(void) stream_get(is, nbits);
+			is->copy_dist = dists[symbol] +
+			    stream_get(is, dists_ext[symbol]);
+			if (is->copy_dist > is->wfill)
+				return ENOENT;
+
+			is->state = is_copy;
+		}
+
+		/* Copy len bytes from distance bytes back */
+		while (is->copy_len > 0) {
+			if (is->destcnt == is->destlen)
+				return EOK;
+
+			stream_put(is, is->window[(is->wpos + WINDOW_SIZE -
+			    is->copy_dist) % WINDOW_SIZE]);
+			is->copy_len--;
+		}
+
+		is->state = is_codes;
+	}
+}
+
+/** Decode data until more input or output space is needed
+ *
+ * @param is Inflate stream.
+ *
+ * @return EOK on success.
+ * @return ENOENT on distance too large.
+ * @return EINVAL on invalid Huffman code or invalid deflate data.
+ *
+ */
+static errno_t stream_run(inflate_stream_t *is)
+{
+	inflate_stream_state_t prev;
+	uint16_t len;
+	uint16_t len_compl;
+	size_t now;
+	errno_t rc;
+
+	while (true) {
+		prev = is->state;
+
+		switch (is->state) {
+		case is_header:
+			if (!stream_need(is, 3))
+				return EOK;
+
+			/* Last block is indicated by a non-zero bit */
+			is->last = stream_get(is, 1) != 0;
+
+			switch (stream_get(is, 2)) {
+			case 0:
+				/* Discard bits up to the byte boundary */
+				(void) stream_get(is, is->bitlen % 8);
+				is->state = is_stored_len;
+				break;
+			case 1:
+				is->len_code = &is->fixed_len_code;
+				is->dist_code = &is->fixed_dist_code;
+				is->state = is_codes;
+				break;
+			case 2:
+				is->state = is_dyn_header;
+				break;
+			default:
+				return EINVAL;
+			}
+			break;
+		case is_stored_len:
+			if (!stream_need(is, 32))
+				return EOK;
+
+			len = stream_get(is, 16);
+			len_compl = stream_get(is, 16);
+
+			/* Check block length and its complement */
+			if (((int16_t) len) != ~((int16_t) len_compl))
+				return EINVAL;
+
+			is->stored_left = len;
+			is->state = is_stored;
+			break;
+		case is_stored:
+			assert(is->bitlen == 0);
+
+			now = is->stored_left;
+			if (now > is->srclen - is->srccnt)
+				now = is->srclen - is->srccnt;
+			if (now > is->destlen - is->destcnt)
+				now = is->destlen - is->destcnt;
+
+			stream_copy_input(is, now);
+			is->stored_left -= now;
+
+			if (is->stored_left > 0)
+				return EOK;
+
+			stream_block_end(is);
+			break;
+		case is_dyn_header:
+		case is_dyn_clen:
+		case is_dyn_lens:
+			rc = stream_dynamic(is);
+			if (rc != EOK)
+				return rc;
+			break;
+		case is_codes:
+		case is_dist:
+		case is_copy:
+			rc = stream_codes(is);
+			if (rc != EOK)
+				return rc;
+			break;
+		case is_done:
+			return EOK;
+		case is_error:
+			return is->error;
+		}
+
+		/* Stop when waiting for more input or output space */
+		if (is->state == prev)
+			return EOK;
+	}
+}
+
+/** Create inflate stream
+ *
+ * @param ris Place to store pointer to the new inflate stream.
+ *
+ * @return EOK on success.
+ * @return ENOMEM if out of memory.
+ *
+ */
+errno_t inflate_stream_create(inflate_stream_t **ris)
+{
+	inflate_stream_t *is;
+
+	is = calloc(1, sizeof(inflate_stream_t));
+	if (is == NULL)
+		return ENOMEM;
+
+	is->state = is_header;
+	is->dyn_len_code.count = is->dyn_len_count;
+	is->dyn_len_code.symbol = is->dyn_len_symbol;
+	is->dyn_len_code.fast = is->dyn_len_fast;
+	is->dyn_dist_code.count = is->dyn_dist_count;
+	is->dyn_dist_code.symbol = is->dyn_dist_symbol;
+	is->dyn_dist_code.fast = is->dyn_dist_fast;
+
+	is->fixed_len_code.count = len_count;
+	is->fixed_len_code.symbol = len_symbol;
+	is->fixed_len_code.fast = is->fixed_len_fast;
+	huffman_fast(&is->fixed_len_code);
+
+	is->fixed_dist_code.count = dist_count;
+	is->fixed_dist_code.symbol = dist_symbol;
+	is->fixed_dist_code.fast = is->fixed_dist_fast;
+	huffman_fast(&is->fixed_dist_code);
+
+	*ris = is;
+	return EOK;
+}
+
+/** Destroy inflate stream
+ *
+ * @param is Inflate stream.
+ *
+ */
+void inflate_stream_destroy(inflate_stream_t *is)
+{
+	free(is);
+}
+
+/** Inflate a chunk of data
+ *
+ * Decode as much of @a src as possible into @a dest. Input that is
+ * not consumed must be passed again in the next call, possibly followed
+ * by more data. Call repeatedly until inflate_stream_done() returns
+ * true. Input past the end of the deflate stream is never consumed.
+ *
+ * @param is      Inflate stream.
+ * @param src     Source data buffer.
+ * @param srclen  Source buffer size (bytes).
+ * @param srcused Place to store the number of bytes consumed.
+ * @param dest    Destination data buffer.
+ * @param destlen Destination buffer size (bytes).
+ * @param destused Place to store the number of bytes produced.
+ *
+ * @return EOK on success.
+ * @return ENOENT on distance too large.
+ * @return EINVAL on invalid Huffman code or invalid deflate data.
+ *
+ */
+errno_t inflate_stream(inflate_stream_t *is, const void *src, size_t srclen,
+    size_t *srcused, void *dest, size_t destlen, size_t *destused)
+{
+	errno_t rc;
+
+	is->src = (const uint8_t *) src;
+	is->srclen = srclen;
+	is->srccnt = 0;
+
+	is->dest = (uint8_t *) dest;
+	is->destlen = destlen;
+	is->destcnt = 0;
+
+	rc = stream_run(is);
+	if (rc != EOK) {
+		is->error = rc;
+		is->state = is_error;
+	}
+
+	*srcused = is->srccnt;
+	*destused = is->destcnt;
+
+	is->src = NULL;
+	is->dest = NULL;
+	return rc;
+}
+
+/** Determine whether the end of the deflate stream was reached
+ *
+ * @param is Inflate stream.
+ *
+ * @return True if the last block has been decoded completely.
+ *
+ */
+bool inflate_stream_done(inflate_stream_t *is)
+{
+	return is->state == is_done;
+}
@@ -29,8 +29,18 @@
 #ifndef LIBCOMPRESS_INFLATE_H_
 #define LIBCOMPRESS_INFLATE_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 
+/** Streaming inflate */
+typedef struct inflate_stream inflate_stream_t;
+
 extern errno_t inflate(void *, size_t, void *, size_t);
 
+extern errno_t inflate_stream_create(inflate_stream_t **);
+extern void inflate_stream_destroy(inflate_stream_t *);
+extern errno_t inflate_stream(inflate_stream_t *, const void *, size_t,
+    size_t *, void *, size_t, size_t *);
+extern bool inflate_stream_done(inflate_stream_t *);
+
 #endif
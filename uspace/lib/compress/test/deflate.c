@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <deflate.h>
+#include <inflate.h>
+#include <mem.h>
+#include <pcut/pcut.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(deflate);
+
+/** Compress data at the given level and check that it inflates back */
+static void round_trip(const uint8_t *data, size_t size, int level)
+{
+	deflate_stream_t *ds;
+	inflate_stream_t *is;
+	size_t cap = size + size / 8 + 1024;
+	size_t clen = 0;
+	size_t dlen = 0;
+	size_t pos = 0;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	uint8_t *cdata = malloc(cap);
+	PCUT_ASSERT_NOT_NULL(cdata);
+
+	/* One byte more than needed to detect excess output */
+	uint8_t *ddata = malloc(size + 1);
+	PCUT_ASSERT_NOT_NULL(ddata);
+
+	rc = deflate_stream_create(level, &ds);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	while (!deflate_stream_done(ds)) {
+		PCUT_ASSERT_TRUE(clen < cap);
+
+		rc = deflate_stream(ds, data + pos, size - pos, &srcused,
+		    cdata + clen, cap - clen, &destused, true);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		pos += srcused;
+		clen += destused;
+	}
+
+	deflate_stream_destroy(ds);
+	PCUT_ASSERT_INT_EQUALS(size, pos);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	pos = 0;
+	while (!inflate_stream_done(is)) {
+		rc = inflate_stream(is, cdata + pos, clen - pos, &srcused,
+		    ddata + dlen, size + 1 - dlen, &destused);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		/* Truncated stream */
+		PCUT_ASSERT_FALSE(srcused == 0 && destused == 0);
+
+		pos += srcused;
+		dlen += destused;
+	}
+
+	inflate_stream_destroy(is);
+
+	PCUT_ASSERT_INT_EQUALS(clen, pos);
+	PCUT_ASSERT_INT_EQUALS(size, dlen);
+	PCUT_ASSERT_INT_EQUALS(0, memcmp(data, ddata, size));
+
+	free(cdata);
+	free(ddata);
+}
+
+/** Fill buffer with text that compresses well */
+static void fill_text(uint8_t *buf, size_t size)
+{
+	const char *words[] = {
+		"lorem ", "ipsum ", "dolor ", "sit ", "amet\n", "HelenOS "
+	};
+	uint32_t seed = 1;
+	size_t i = 0;
+
+	while (i < size) {
+		seed = seed * 1103515245 + 12345;
+		const char *word = words[(seed >> 16) % 6];
+
+		for (size_t j = 0; word[j] != '\0' && i < size; j++)
+			buf[i++] = word[j];
+	}
+}
+
+/** Fill buffer with data that does not compress */
+static void fill_random(uint8_t *buf, size_t size)
+{
+	uint32_t seed = 1;
+
+	for (size_t i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		buf[i] = seed >> 24;
+	}
+}
+
+/** Empty input */
+PCUT_TEST(empty)
+{
+	uint8_t data[1] = { 0 };
+
+	for (int level = DEFLATE_LEVEL_MIN; level <= DEFLATE_LEVEL_MAX; level++)
+		round_trip(data, 0, level);
+}
+
+/** Short input with literals which have 9-bit fixed Huffman codes */
+PCUT_TEST(fixed_high_literals)
+{
+	uint8_t data[256];
+
+	for (size_t i = 0; i < sizeof(data); i++)
+		data[i] = 0x90 + (i % 16);
+
+	for (int level = DEFLATE_LEVEL_MIN; level <= DEFLATE_LEVEL_MAX; level++)
+		round_trip(data, sizeof(data), level);
+}
+
+/** All byte values in a short input */
+PCUT_TEST(all_bytes)
+{
+	uint8_t data[512];
+
+	for (size_t i = 0; i < sizeof(data); i++)
+		data[i] = i;
+
+	for (int level = DEFLATE_LEVEL_MIN; level <= DEFLATE_LEVEL_MAX; level++)
+		round_trip(data, sizeof(data), level);
+}
+
+/** Compressible input spanning multiple blocks and window slides */
+PCUT_TEST(text)
+{
+	size_t size = 256 * 1024;
+	uint8_t *data = malloc(size);
+	PCUT_ASSERT_NOT_NULL(data);
+
+	fill_text(data, size);
+
+	for (int level = DEFLATE_LEVEL_MIN; level <= DEFLATE_LEVEL_MAX; level++)
+		round_trip(data, size, level);
+
+	free(data);
+}
+
+/** Incompressible input */
+PCUT_TEST(random)
+{
+	size_t size = 100 * 1024;
+	uint8_t *data = malloc(size);
+	PCUT_ASSERT_NOT_NULL(data);
+
+	fill_random(data, size);
+
+	round_trip(data, size, DEFLATE_LEVEL_MIN);
+	round_trip(data, size, DEFLATE_LEVEL_DEFAULT);
+	round_trip(data, size, DEFLATE_LEVEL_MAX);
+
+	free(data);
+}
+
+/** Input is fed and output is drained in small pieces */
+PCUT_TEST(small_buffers)
+{
+	size_t size = 64 * 1024;
+	size_t cap = size + 1024;
+	size_t clen = 0;
+	size_t pos = 0;
+	size_t srcused;
+	size_t destused;
+	deflate_stream_t *ds;
+	errno_t rc;
+
+	uint8_t *data = malloc(size);
+	PCUT_ASSERT_NOT_NULL(data);
+	uint8_t *cdata = malloc(cap);
+	PCUT_ASSERT_NOT_NULL(cdata);
+	uint8_t *ddata = malloc(size);
+	PCUT_ASSERT_NOT_NULL(ddata);
+
+	fill_text(data, size);
+
+	rc = deflate_stream_create(DEFLATE_LEVEL_DEFAULT, &ds);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	while (!deflate_stream_done(ds)) {
+		size_t srclen = size - pos;
+		if (srclen > 100)
+			srclen = 100;
+
+		size_t destlen = cap - clen;
+		if (destlen > 7)
+			destlen = 7;
+
+		PCUT_ASSERT_TRUE(destlen > 0);
+
+		rc = deflate_stream(ds, data + pos, srclen, &srcused,
+		    cdata + clen, destlen, &destused, pos + srclen == size);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		pos += srcused;
+		clen += destused;
+	}
+
+	deflate_stream_destroy(ds);
+	PCUT_ASSERT_INT_EQUALS(size, pos);
+
+	rc = inflate(cdata, clen, ddata, size);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_INT_EQUALS(0, memcmp(data, ddata, size));
+
+	free(data);
+	free(cdata);
+	free(ddata);
+}
+
+PCUT_EXPORT(deflate);
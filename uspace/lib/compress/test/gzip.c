@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <deflate.h>
+#include <gzip.h>
+#include <mem.h>
+#include <pcut/pcut.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(gzip);
+
+/** Size of the test data */
+#define TEXT_SIZE  2048
+
+/** GZIP file with name "text" */
+static const uint8_t text_gz[] = {
+	0x1f, 0x8b, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00,
+	0x02, 0xff, 0x74, 0x65, 0x78, 0x74, 0x00, 0x7d,
+	0x54, 0x49, 0x12, 0x82, 0x40, 0x0c, 0xbc, 0xfb,
+	0x0a, 0x9e, 0xe3, 0xcd, 0x83, 0x2f, 0xb0, 0x8a,
+	0x39, 0x50, 0x05, 0x62, 0x09, 0xfe, 0x5f, 0x21,
+	0x0e, 0xe9, 0xa4, 0x7b, 0x38, 0xb0, 0x4c, 0x92,
+	0xc9, 0xd2, 0x9d, 0xa4, 0x9f, 0xc7, 0xf9, 0xdd,
+	0xfd, 0x9e, 0x32, 0x75, 0xcb, 0xb0, 0x1e, 0xcf,
+	0xf0, 0x5a, 0x3e, 0x53, 0xd7, 0xef, 0xda, 0x6b,
+	0x19, 0xcb, 0xf3, 0x76, 0xff, 0x9f, 0xcc, 0xd6,
+	0xf4, 0x55, 0x63, 0xb2, 0x68, 0x1d, 0x2d, 0xf2,
+	0xd7, 0x6c, 0x1f, 0x53, 0x59, 0x2f, 0x76, 0xb9,
+	0x2a, 0x6a, 0x02, 0x9e, 0x92, 0x39, 0xda, 0x4d,
+	0xfd, 0x95, 0x85, 0x76, 0x06, 0xe9, 0x76, 0x33,
+	0xa6, 0xb7, 0x8b, 0x2d, 0xee, 0x59, 0x95, 0xe0,
+	0xc3, 0x73, 0xc8, 0x81, 0x20, 0x7d, 0xf7, 0x88,
+	0x25, 0x60, 0x3e, 0x74, 0x65, 0x33, 0x88, 0x41,
+	0xeb, 0x17, 0xc2, 0x7a, 0x48, 0x38, 0xdb, 0x2f,
+	0x52, 0xd0, 0x26, 0xca, 0x51, 0x64, 0x7a, 0x95,
+	0xbd, 0xa2, 0x34, 0xe1, 0xdf, 0x0a, 0xe0, 0x7f,
+	0xd1, 0x42, 0x05, 0xf0, 0xba, 0x3c, 0x11, 0xd3,
+	0x28, 0xb8, 0x45, 0x87, 0xb8, 0x9c, 0xa1, 0x77,
+	0x49, 0x76, 0x19, 0xdd, 0x9a, 0x5d, 0x4c, 0x32,
+	0x26, 0x06, 0x64, 0xbb, 0x3b, 0x06, 0x07, 0xa9,
+	0xc0, 0x44, 0x62, 0x37, 0xe5, 0x8e, 0xc8, 0xb7,
+	0x50, 0x97, 0x3d, 0x64, 0x1a, 0xa9, 0x3f, 0x69,
+	0x94, 0x14, 0x9d, 0xb9, 0xdb, 0xa1, 0xbc, 0x88,
+	0x1d, 0xbe, 0xb1, 0x20, 0x1a, 0xb0, 0x88, 0x45,
+	0x34, 0xcb, 0xcd, 0xc3, 0xc3, 0x98, 0xed, 0x20,
+	0x2b, 0x4c, 0xb9, 0xdd, 0x46, 0x54, 0x8c, 0xd8,
+	0x2c, 0x69, 0xe4, 0x62, 0x0b, 0x9c, 0x2e, 0x07,
+	0x3d, 0x9d, 0xae, 0x39, 0xa5, 0x82, 0xa7, 0x81,
+	0x81, 0x44, 0x46, 0x19, 0x6c, 0xd4, 0x62, 0x28,
+	0x04, 0x20, 0x37, 0xb9, 0xda, 0xc1, 0xb4, 0x09,
+	0xb9, 0xd7, 0xa1, 0x06, 0xf7, 0xcb, 0x23, 0x25,
+	0x46, 0x90, 0xaa, 0x17, 0x5a, 0x85, 0x20, 0x40,
+	0xad, 0xfa, 0x9e, 0xb6, 0x1d, 0xaf, 0xd2, 0xa3,
+	0x2c, 0xb9, 0x37, 0xd2, 0xce, 0x22, 0x7e, 0x63,
+	0x38, 0xb9, 0x89, 0x98, 0x41, 0x6e, 0x3a, 0x8c,
+	0xdd, 0x1a, 0x17, 0x86, 0x9b, 0xe7, 0x91, 0xc4,
+	0x7a, 0xb0, 0x24, 0x83, 0xcc, 0x3f, 0x67, 0x7e,
+	0x3e, 0x8b, 0x5f, 0x64, 0x7e, 0x2e, 0xf3, 0x00,
+	0x08, 0x00, 0x00
+};
+
+/** Fill buffer with the text compressed in the test data */
+static void fill_text(uint8_t *buf, size_t size)
+{
+	const char *words[] = {
+		"lorem ", "ipsum ", "dolor ", "sit ", "amet\n", "HelenOS "
+	};
+	uint32_t seed = 1;
+	size_t i = 0;
+
+	while (i < size) {
+		seed = seed * 1103515245 + 12345;
+		const char *word = words[(seed >> 16) % 6];
+
+		for (size_t j = 0; word[j] != '\0' && i < size; j++)
+			buf[i++] = word[j];
+	}
+}
+
+/** Expand GZIP data through a stream in chunks of the given size
+ *
+ * @return Error code of the first failing call
+ */
+static errno_t stream_expand(const uint8_t *src, size_t srclen,
+    uint8_t *dest, size_t destlen, size_t chunk, size_t *rdlen)
+{
+	gzip_stream_t *gs;
+	size_t pos = 0;
+	size_t dlen = 0;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	rc = gzip_stream_create(&gs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	while (!gzip_stream_done(gs)) {
+		size_t inlen = srclen - pos;
+		if (inlen > chunk)
+			inlen = chunk;
+
+		rc = gzip_stream(gs, src + pos, inlen, &srcused, dest + dlen,
+		    destlen - dlen, &destused);
+		if (rc != EOK)
+			break;
+
+		/* Truncated stream */
+		if (srcused == 0 && destused == 0) {
+			rc = ELIMIT;
+			break;
+		}
+
+		pos += srcused;
+		dlen += destused;
+	}
+
+	gzip_stream_destroy(gs);
+	*rdlen = dlen;
+	return rc;
+}
+
+/** Expand GZIP file in one step */
+PCUT_TEST(expand)
+{
+	uint8_t data[TEXT_SIZE];
+	void *ddata;
+	size_t dlen;
+	errno_t rc;
+
+	fill_text(data, sizeof(data));
+
+	rc = gzip_expand((void *) text_gz, sizeof(text_gz), &ddata, &dlen);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_INT_EQUALS(sizeof(data), dlen);
+	PCUT_ASSERT_INT_EQUALS(0, memcmp(data, ddata, sizeof(data)));
+
+	free(ddata);
+}
+
+/** Expand GZIP file through a stream */
+PCUT_TEST(stream)
+{
+	uint8_t data[TEXT_SIZE];
+	uint8_t ddata[TEXT_SIZE];
+	size_t chunks[] = { 1, 5, 100, sizeof(text_gz) };
+	size_t dlen;
+	errno_t rc;
+
+	fill_text(data, sizeof(data));
+
+	for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+		rc = stream_expand(text_gz, sizeof(text_gz), ddata,
+		    sizeof(ddata), chunks[i], &dlen);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+		PCUT_ASSERT_INT_EQUALS(sizeof(data), dlen);
+		PCUT_ASSERT_INT_EQUALS(0, memcmp(data, ddata, sizeof(data)));
+	}
+}
+
+/** Invalid GZIP header */
+PCUT_TEST(bad_header)
+{
+	uint8_t src[sizeof(text_gz)];
+	uint8_t ddata[TEXT_SIZE];
+	void *edata;
+	size_t dlen;
+	errno_t rc;
+
+	memcpy(src, text_gz, sizeof(text_gz));
+	src[0] ^= 0xff;
+
+	rc = gzip_expand(src, sizeof(src), &edata, &dlen);
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+
+	rc = stream_expand(src, sizeof(src), ddata, sizeof(ddata), 1, &dlen);
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+}
+
+/** Size in the GZIP footer does not match the data */
+PCUT_TEST(bad_size)
+{
+	uint8_t src[sizeof(text_gz)];
+	uint8_t ddata[TEXT_SIZE + 1];
+	size_t dlen;
+	errno_t rc;
+
+	memcpy(src, text_gz, sizeof(text_gz));
+	src[sizeof(src) - 4] ^= 0x01;
+
+	rc = stream_expand(src, sizeof(src), ddata, sizeof(ddata),
+	    sizeof(src), &dlen);
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+}
+
+/** Truncated GZIP file */
+PCUT_TEST(truncated)
+{
+	uint8_t ddata[TEXT_SIZE];
+	size_t dlen;
+	errno_t rc;
+
+	rc = stream_expand(text_gz, sizeof(text_gz) - 1, ddata, sizeof(ddata),
+	    sizeof(text_gz), &dlen);
+	PCUT_ASSERT_ERRNO_VAL(ELIMIT, rc);
+}
+
+/** Corrupted GZIP files are handled safely */
+PCUT_TEST(corrupted)
+{
+	uint8_t src[sizeof(text_gz)];
+	uint8_t ddata[TEXT_SIZE];
+	void *edata;
+	size_t dlen;
+	errno_t rc;
+
+	for (size_t i = 0; i < sizeof(text_gz); i++) {
+		memcpy(src, text_gz, sizeof(text_gz));
+		src[i] ^= 0x55;
+
+		rc = gzip_expand(src, sizeof(src), &edata, &dlen);
+		if (rc == EOK)
+			free(edata);
+
+		(void) stream_expand(src, sizeof(src), ddata, sizeof(ddata),
+		    sizeof(src), &dlen);
+		PCUT_ASSERT_TRUE(dlen <= sizeof(ddata));
+	}
+}
+
+/** Compress data with gzip_compress() and expand it back */
+PCUT_TEST(compress_expand)
+{
+	uint8_t data[4096];
+	void *cdata;
+	size_t clen;
+	void *ddata;
+	size_t dlen;
+	errno_t rc;
+
+	for (size_t i = 0; i < sizeof(data); i++)
+		data[i] = (i % 200) + (i / 1000);
+
+	for (int level = DEFLATE_LEVEL_MIN; level <= DEFLATE_LEVEL_MAX; level++) {
+		rc = gzip_compress(data, sizeof(data), level, &cdata, &clen);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		rc = gzip_expand(cdata, clen, &ddata, &dlen);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		PCUT_ASSERT_INT_EQUALS(sizeof(data), dlen);
+		PCUT_ASSERT_INT_EQUALS(0, memcmp(data, ddata, sizeof(data)));
+
+		free(cdata);
+		free(ddata);
+	}
+}
+
+/** Invalid compression level is rejected */
+PCUT_TEST(compress_bad_level)
+{
+	uint8_t data[16] = { 0 };
+	void *cdata;
+	size_t clen;
+	errno_t rc;
+
+	rc = gzip_compress(data, sizeof(data), DEFLATE_LEVEL_MAX + 1, &cdata,
+	    &clen);
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+}
+
+PCUT_EXPORT(gzip);
@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <inflate.h>
+#include <mem.h>
+#include <pcut/pcut.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(inflate);
+
+/** Size of the test data */
+#define TEXT_SIZE  2048
+
+/** Size of the skewed test data */
+#define SKEWED_SIZE  1024
+
+/** Size of the runs test data */
+#define RUNS_SIZE  (1000 + 900 + 800)
+
+static const uint8_t text_fixed[] = {
+	0x4b, 0xc9, 0xcf, 0xc9, 0x2f, 0x52, 0x00, 0xe2,
+	0xd4, 0x5c, 0x85, 0xe2, 0xcc, 0x12, 0x38, 0xce,
+	0x2c, 0x28, 0x2e, 0xcd, 0x55, 0x48, 0x01, 0xcb,
+	0x7a, 0xa4, 0xe6, 0xa4, 0xe6, 0xf9, 0x07, 0x43,
+	0x79, 0x10, 0xb5, 0x10, 0x79, 0x98, 0x0c, 0x44,
+	0x0c, 0x55, 0x35, 0xaa, 0x0a, 0x74, 0x1a, 0xa2,
+	0x36, 0x31, 0x37, 0xb5, 0x84, 0x0b, 0xa2, 0x19,
+	0x26, 0x01, 0x73, 0x00, 0xc2, 0x49, 0x10, 0x83,
+	0xc0, 0x4a, 0x11, 0x04, 0xba, 0x20, 0x84, 0x8f,
+	0x24, 0x0a, 0xd2, 0x89, 0xea, 0x3c, 0xb0, 0x30,
+	0xc4, 0x5e, 0x7c, 0xbe, 0x44, 0x32, 0x03, 0xe1,
+	0x06, 0x74, 0x8b, 0x90, 0x9c, 0x8f, 0x30, 0x11,
+	0xd9, 0x0b, 0xc8, 0xee, 0xc1, 0xd0, 0x02, 0x52,
+	0x80, 0x6a, 0x29, 0x8c, 0x46, 0xb2, 0x16, 0x61,
+	0x25, 0x12, 0x1f, 0xc2, 0x44, 0x8e, 0x02, 0xdc,
+	0x11, 0x85, 0x08, 0x45, 0xcc, 0xe8, 0xc5, 0xa6,
+	0x1e, 0x5b, 0x94, 0xa2, 0x85, 0x3f, 0x2e, 0x0b,
+	0x10, 0x2c, 0x54, 0x15, 0xd8, 0x2c, 0x40, 0xf8,
+	0x0b, 0xe1, 0x10, 0x88, 0x0c, 0xb6, 0xe0, 0xc6,
+	0x92, 0x42, 0x10, 0xe2, 0x98, 0x41, 0x8f, 0x10,
+	0x41, 0x37, 0x12, 0xd5, 0x58, 0x88, 0x3a, 0x54,
+	0x47, 0xa2, 0x3a, 0x0c, 0x29, 0xb2, 0x11, 0xc6,
+	0x61, 0x06, 0x0e, 0x72, 0x54, 0x20, 0x3b, 0x04,
+	0x35, 0x35, 0xa1, 0xa7, 0x08, 0x74, 0x5d, 0xc8,
+	0x72, 0xe8, 0x26, 0xa0, 0x47, 0x23, 0x46, 0xfa,
+	0xc4, 0xc8, 0x4a, 0xd8, 0xa2, 0x13, 0x3d, 0xb5,
+	0x23, 0x79, 0x0f, 0x35, 0xec, 0x90, 0x49, 0x64,
+	0x0f, 0x61, 0x64, 0x30, 0xd4, 0xb0, 0x40, 0x55,
+	0x86, 0x9e, 0x78, 0x30, 0x33, 0x23, 0xba, 0x3a,
+	0x24, 0x57, 0x21, 0x3b, 0x19, 0x77, 0x32, 0xc2,
+	0xf0, 0x0c, 0x96, 0x92, 0x05, 0x2d, 0xcb, 0xa1,
+	0x26, 0x01, 0xbc, 0x85, 0x03, 0xf6, 0xdc, 0x89,
+	0x90, 0xc1, 0x1b, 0x15, 0x98, 0xb9, 0x01, 0x33,
+	0x20, 0x91, 0x63, 0x14, 0x33, 0xb0, 0x91, 0x65,
+	0x91, 0xad, 0x42, 0x0e, 0x00, 0xf4, 0x44, 0x8e,
+	0xad, 0x0c, 0xc6, 0x28, 0x09, 0x31, 0xd3, 0x3a,
+	0x92, 0x1f, 0x10, 0xe6, 0x62, 0x66, 0x29, 0x2c,
+	0x59, 0x10, 0xc3, 0xf7, 0x58, 0x64, 0xb1, 0x85,
+	0x20, 0x52, 0x50, 0x63, 0x4b, 0xf7, 0x18, 0xa5,
+	0x1d, 0x66, 0x51, 0x0a, 0xf7, 0x16, 0xd6, 0x72,
+	0x03, 0xad, 0xcc, 0xc2, 0x88, 0x5f, 0x54, 0xeb,
+	0xb0, 0x96, 0x44, 0x98, 0x31, 0x88, 0x99, 0xe8,
+	0x90, 0xed, 0xc6, 0x95, 0x5d, 0x30, 0x83, 0x1b,
+	0x33, 0x3f, 0x62, 0x08, 0x63, 0xcf, 0x58, 0x58,
+	0x63, 0x10, 0x33, 0xfe, 0x31, 0x5d, 0x8e, 0x3f,
+	0x2f, 0x02, 0x00
+};
+
+static const uint8_t text_dynamic[] = {
+	0x7d, 0x54, 0x49, 0x12, 0x82, 0x40, 0x0c, 0xbc,
+	0xfb, 0x0a, 0x9e, 0xe3, 0xcd, 0x83, 0x2f, 0xb0,
+	0x8a, 0x39, 0x50, 0x05, 0x62, 0x09, 0xfe, 0x5f,
+	0x21, 0x0e, 0xe9, 0xa4, 0x7b, 0x38, 0xb0, 0x4c,
+	0x92, 0xc9, 0xd2, 0x9d, 0xa4, 0x9f, 0xc7, 0xf9,
+	0xdd, 0xfd, 0x9e, 0x32, 0x75, 0xcb, 0xb0, 0x1e,
+	0xcf, 0xf0, 0x5a, 0x3e, 0x53, 0xd7, 0xef, 0xda,
+	0x6b, 0x19, 0xcb, 0xf3, 0x76, 0xff, 0x9f, 0xcc,
+	0xd6, 0xf4, 0x55, 0x63, 0xb2, 0x68, 0x1d, 0x2d,
+	0xf2, 0xd7, 0x6c, 0x1f, 0x53, 0x59, 0x2f, 0x76,
+	0xb9, 0x2a, 0x6a, 0x02, 0x9e, 0x92, 0x39, 0xda,
+	0x4d, 0xfd, 0x95, 0x85, 0x76, 0x06, 0xe9, 0x76,
+	0x33, 0xa6, 0xb7, 0x8b, 0x2d, 0xee, 0x59, 0x95,
+	0xe0, 0xc3, 0x73, 0xc8, 0x81, 0x20, 0x7d, 0xf7,
+	0x88, 0x25, 0x60, 0x3e, 0x74, 0x65, 0x33, 0x88,
+	0x41, 0xeb, 0x17, 0xc2, 0x7a, 0x48, 0x38, 0xdb,
+	0x2f, 0x52, 0xd0, 0x26, 0xca, 0x51, 0x64, 0x7a,
+	0x95, 0xbd, 0xa2, 0x34, 0xe1, 0xdf, 0x0a, 0xe0,
+	0x7f, 0xd1, 0x42, 0x05, 0xf0, 0xba, 0x3c, 0x11,
+	0xd3, 0x28, 0xb8, 0x45, 0x87, 0xb8, 0x9c, 0xa1,
+	0x77, 0x49, 0x76, 0x19, 0xdd, 0x9a, 0x5d, 0x4c,
+	0x32, 0x26, 0x06, 0x64, 0xbb, 0x3b, 0x06, 0x07,
+	0xa9, 0xc0, 0x44, 0x62, 0x37, 0xe5, 0x8e, 0xc8,
+	0xb7, 0x50, 0x97, 0x3d, 0x64, 0x1a, 0xa9, 0x3f,
+	0x69, 0x94, 0x14, 0x9d, 0xb9, 0xdb, 0xa1, 0xbc,
+	0x88, 0x1d, 0xbe, 0xb1, 0x20, 0x1a, 0xb0, 0x88,
+	0x45, 0x34, 0xcb, 0xcd, 0xc3, 0xc3, 0x98, 0xed,
+	0x20, 0x2b, 0x4c, 0xb9, 0xdd, 0x46, 0x54, 0x8c,
+	0xd8, 0x2c, 0x69, 0xe4, 0x62, 0x0b, 0x9c, 0x2e,
+	0x07, 0x3d, 0x9d, 0xae, 0x39, 0xa5, 0x82, 0xa7,
+	0x81, 0x81, 0x44, 0x46, 0x19, 0x6c, 0xd4, 0x62,
+	0x28, 0x04, 0x20, 0x37, 0xb9, 0xda, 0xc1, 0xb4,
+	0x09, 0xb9, 0xd7, 0xa1, 0x06, 0xf7, 0xcb, 0x23,
+	0x25, 0x46, 0x90, 0xaa, 0x17, 0x5a, 0x85, 0x20,
+	0x40, 0xad, 0xfa, 0x9e, 0xb6, 0x1d, 0xaf, 0xd2,
+	0xa3, 0x2c, 0xb9, 0x37, 0xd2, 0xce, 0x22, 0x7e,
+	0x63, 0x38, 0xb9, 0x89, 0x98, 0x41, 0x6e, 0x3a,
+	0x8c, 0xdd, 0x1a, 0x17, 0x86, 0x9b, 0xe7, 0x91,
+	0xc4, 0x7a, 0xb0, 0x24, 0x83, 0xcc, 0x3f, 0x67,
+	0x7e, 0x3e, 0x8b, 0x5f
+};
+
+/** Stored block containing "hello" */
+static const uint8_t hello_stored[] = {
+	0x01, 0x05, 0x00, 0xfa, 0xff, 'h', 'e', 'l', 'l', 'o'
+};
+
+/** Random bytes needing codes longer than 9 bits, see fill_skewed() */
+static const uint8_t skewed_dynamic[] = {
+	0x4b, 0x4c, 0x84, 0x80, 0xfd, 0x40, 0xac, 0xbc,
+	0x3e, 0x11, 0x15, 0x3c, 0xf9, 0x0e, 0x63, 0x65,
+	0x6e, 0xb5, 0x86, 0x8b, 0x36, 0x6b, 0xa0, 0x28,
+	0xda, 0x0f, 0xa1, 0x0c, 0x12, 0x13, 0x0f, 0x41,
+	0x58, 0xb2, 0xcb, 0x80, 0xc4, 0xe5, 0xc4, 0x30,
+	0x20, 0x0b, 0xc4, 0x0d, 0x43, 0x56, 0x7c, 0x1b,
+	0x44, 0x24, 0x24, 0x7e, 0x4a, 0xdc, 0x84, 0x2c,
+	0x2a, 0x3c, 0x3f, 0xf1, 0x5c, 0x5d, 0xe2, 0x33,
+	0x08, 0x47, 0x07, 0x26, 0x7a, 0x0f, 0x59, 0x89,
+	0x87, 0x1d, 0x84, 0xe6, 0x03, 0xda, 0x93, 0xa8,
+	0x7b, 0x02, 0xc4, 0x3c, 0x0e, 0x22, 0x3e, 0x41,
+	0x84, 0x7b, 0xc1, 0xe4, 0xc4, 0xc4, 0x69, 0x10,
+	0x2e, 0xbf, 0x13, 0x90, 0x58, 0x03, 0xc4, 0xa1,
+	0x6e, 0x89, 0x1f, 0x81, 0x54, 0x09, 0x10, 0x8b,
+	0xaa, 0x40, 0xe4, 0xfc, 0x9d, 0x8e, 0x26, 0x26,
+	0xb2, 0x00, 0x19, 0x4c, 0x50, 0xa3, 0xfb, 0x20,
+	0x94, 0x29, 0xdc, 0xae, 0x33, 0x9b, 0xe1, 0x5e,
+	0x02, 0x81, 0x2a, 0x64, 0x77, 0x7c, 0x79, 0x27,
+	0x0c, 0xf2, 0x1c, 0x6f, 0x62, 0x62, 0x3f, 0x98,
+	0xcf, 0x0b, 0x26, 0x1d, 0xa7, 0x02, 0x89, 0x0f,
+	0x40, 0x7c, 0x16, 0x88, 0xff, 0x25, 0xee, 0x3f,
+	0x8d, 0xac, 0x65, 0xed, 0x4d, 0x20, 0x61, 0x06,
+	0xc4, 0x07, 0x90, 0x04, 0xe7, 0x27, 0xe6, 0x24,
+	0xde, 0x49, 0x4c, 0xdc, 0x57, 0x04, 0xe5, 0xf3,
+	0x25, 0x4a, 0x81, 0xe9, 0xfc, 0xc4, 0xc4, 0x53,
+	0x60, 0x46, 0x23, 0x88, 0x70, 0x49, 0x4c, 0x5c,
+	0x0d, 0xa2, 0x63, 0x12, 0xb1, 0x83, 0x99, 0x89,
+	0x02, 0x89, 0x67, 0x12, 0x13, 0xb3, 0x91, 0x84,
+	0x78, 0x12, 0xdd, 0x80, 0xe4, 0x63, 0x90, 0x47,
+	0x81, 0xb6, 0xd8, 0x27, 0x76, 0x42, 0x84, 0x7f,
+	0x25, 0x26, 0x5e, 0x4a, 0x4c, 0x34, 0x87, 0x3a,
+	0xcc, 0x27, 0x71, 0x4f, 0xe2, 0x84, 0xc4, 0x88,
+	0x7a, 0x84, 0xb6, 0xd5, 0x08, 0x33, 0x40, 0xde,
+	0xce, 0xbe, 0x5c, 0x8b, 0x88, 0x84, 0xee, 0x8d,
+	0x60, 0xe6, 0x35, 0x20, 0xd6, 0xc3, 0x88, 0x77,
+	0x14, 0x10, 0x0e, 0x0a, 0x1b, 0x56, 0x10, 0x8b,
+	0x2d, 0x31, 0xb1, 0xe1, 0x38, 0xc4, 0x65, 0xef,
+	0x81, 0x5e, 0xed, 0xc3, 0xea, 0x89, 0xb3, 0x50,
+	0xba, 0x13, 0x12, 0x09, 0x8a, 0x08, 0x19, 0xb9,
+	0x46, 0x38, 0xb3, 0x37, 0xf1, 0x15, 0x84, 0xd1,
+	0x0d, 0x4d, 0x60, 0x73, 0xc0, 0xa4, 0x2a, 0x88,
+	0x13, 0x0c, 0x73, 0x17, 0xd8, 0xc3, 0x7e, 0x19,
+	0xd0, 0x58, 0x5c, 0x00, 0x49, 0xa7, 0x89, 0xb5,
+	0x30, 0x33, 0x36, 0x24, 0x1e, 0x4c, 0xdc, 0x01,
+	0x49, 0x33, 0x8f, 0x80, 0xe4, 0x03, 0x59, 0x58,
+	0x98, 0x5c, 0x80, 0xc8, 0x03, 0xe3, 0x72, 0x79,
+	0x62, 0xe2, 0x96, 0x44, 0x48, 0xc4, 0x57, 0x88,
+	0x43, 0xb5, 0xd5, 0xd7, 0x4b, 0x80, 0xe9, 0x23,
+	0x40, 0x9c, 0x9e, 0x98, 0x18, 0xe1, 0x02, 0x8a,
+	0x27, 0x19, 0x20, 0xe7, 0x0d, 0x30, 0xb2, 0x5e,
+	0xbe, 0x86, 0xc4, 0x2e, 0x10, 0x1f, 0xad, 0x4d,
+	0x2c, 0x4e, 0x4c, 0xb4, 0x81, 0x68, 0xda, 0xb6,
+	0x10, 0x4c, 0x69, 0x56, 0x41, 0xbc, 0x1c, 0xfe,
+	0x5f, 0x0e, 0xcc, 0xcf, 0x49, 0x4c, 0x7c, 0xf6,
+	0x55, 0x4f, 0x15, 0xc8, 0x3a, 0x35, 0xe3, 0x3b,
+	0xd0, 0xcd, 0x36, 0x70, 0x0f, 0x46, 0x46, 0x25,
+	0xea, 0x26, 0x26, 0x2e, 0x02, 0xda, 0x7f, 0x1f,
+	0xc4, 0xed, 0x01, 0xe7, 0x21, 0xa8, 0x0f, 0x12,
+	0x6f, 0x1b, 0x25, 0x26, 0x46, 0x55, 0x81, 0x13,
+	0x05, 0x07, 0x44, 0x79, 0x1c, 0x6a, 0x18, 0x02,
+	0x2d, 0xd6, 0x46, 0x0b, 0x56, 0x68, 0x24, 0xed,
+	0x98, 0x1a, 0xdb, 0x00, 0xa2, 0x0f, 0x02, 0xf1,
+	0x09, 0x98, 0x1c, 0x1b, 0x8a, 0x4a, 0xfd, 0x44,
+	0x00
+};
+
+/** Runs of repeated bytes and short strings, see fill_runs() */
+static const uint8_t runs_dynamic[] = {
+	0x4b, 0x4c, 0x1c, 0x05, 0xa3, 0x60, 0x14, 0x0c,
+	0x77, 0x50, 0x51, 0x59, 0x35, 0x8a, 0x46, 0xd1,
+	0x28, 0x1a, 0x40, 0xe4, 0x91, 0x9a, 0x93, 0x9a,
+	0xe7, 0x1f, 0xac, 0x30, 0x4a, 0x8f, 0xd2, 0xa3,
+	0x34, 0x26, 0x0d, 0x00
+};
+
+/** Fill buffer with the text compressed in the test data */
+static void fill_text(uint8_t *buf, size_t size)
+{
+	const char *words[] = {
+		"lorem ", "ipsum ", "dolor ", "sit ", "amet\n", "HelenOS "
+	};
+	uint32_t seed = 1;
+	size_t i = 0;
+
+	while (i < size) {
+		seed = seed * 1103515245 + 12345;
+		const char *word = words[(seed >> 16) % 6];
+
+		for (size_t j = 0; word[j] != '\0' && i < size; j++)
+			buf[i++] = word[j];
+	}
+}
+
+/** Fill buffer with one frequent symbol and random bytes */
+static void fill_skewed(uint8_t *buf, size_t size)
+{
+	uint32_t seed = 1;
+
+	for (size_t i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+
+		if (((seed >> 16) & 3) != 0)
+			buf[i] = 'a';
+		else
+			buf[i] = seed >> 24;
+	}
+}
+
+/** Fill buffer with runs of repeated bytes and short strings */
+static void fill_runs(uint8_t *buf)
+{
+	memset(buf, 'a', 1000);
+
+	for (size_t i = 0; i < 300; i++)
+		memcpy(buf + 1000 + 3 * i, "xyz", 3);
+
+	for (size_t i = 0; i < 100; i++)
+		memcpy(buf + 1900 + 8 * i, "HelenOS ", 8);
+}
+
+/** Expand deflate data with inflate() and compare the result */
+static void expand_check(const uint8_t *cdata, size_t clen,
+    const uint8_t *data, size_t size)
+{
+	uint8_t *ddata = malloc(size);
+	PCUT_ASSERT_NOT_NULL(ddata);
+
+	errno_t rc = inflate((void *) cdata, clen, ddata, size);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_INT_EQUALS(0, memcmp(data, ddata, size));
+
+	free(ddata);
+}
+
+/** Expand deflate data through a stream and compare the result
+ *
+ * Input and output are passed to the stream in chunks of at most
+ * @a inchunk and @a outchunk bytes.
+ */
+static void stream_check(const uint8_t *cdata, size_t clen,
+    const uint8_t *data, size_t size, size_t inchunk, size_t outchunk)
+{
+	inflate_stream_t *is;
+	size_t pos = 0;
+	size_t dlen = 0;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	/* One byte more than needed to detect excess output */
+	uint8_t *ddata = malloc(size + 1);
+	PCUT_ASSERT_NOT_NULL(ddata);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	while (!inflate_stream_done(is)) {
+		size_t inlen = clen - pos;
+		if (inlen > inchunk)
+			inlen = inchunk;
+
+		size_t outlen = size + 1 - dlen;
+		if (outlen > outchunk)
+			outlen = outchunk;
+
+		rc = inflate_stream(is, cdata + pos, inlen, &srcused,
+		    ddata + dlen, outlen, &destused);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		/* Truncated stream */
+		PCUT_ASSERT_FALSE(srcused == 0 && destused == 0);
+
+		pos += srcused;
+		dlen += destused;
+	}
+
+	inflate_stream_destroy(is);
+
+	PCUT_ASSERT_INT_EQUALS(clen, pos);
+	PCUT_ASSERT_INT_EQUALS(size, dlen);
+	PCUT_ASSERT_INT_EQUALS(0, memcmp(data, ddata, size));
+
+	free(ddata);
+}
+
+/** Expand corrupted deflate data through a stream
+ *
+ * Flips bits in each byte of the data in turn. The stream must either
+ * fail, stop making progress or finish without writing past the output
+ * buffer.
+ */
+static void stream_corrupt(const uint8_t *cdata, size_t clen, size_t size)
+{
+	inflate_stream_t *is;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	uint8_t *bad = malloc(clen);
+	PCUT_ASSERT_NOT_NULL(bad);
+
+	uint8_t *ddata = malloc(size);
+	PCUT_ASSERT_NOT_NULL(ddata);
+
+	for (size_t i = 0; i < clen; i++) {
+		memcpy(bad, cdata, clen);
+		bad[i] ^= 0x55;
+
+		rc = inflate_stream_create(&is);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		size_t pos = 0;
+		size_t dlen = 0;
+
+		while (!inflate_stream_done(is)) {
+			rc = inflate_stream(is, bad + pos, clen - pos, &srcused,
+			    ddata + dlen, size - dlen, &destused);
+			if (rc != EOK)
+				break;
+
+			PCUT_ASSERT_TRUE(srcused <= clen - pos);
+			PCUT_ASSERT_TRUE(destused <= size - dlen);
+
+			if (srcused == 0 && destused == 0)
+				break;
+
+			pos += srcused;
+			dlen += destused;
+		}
+
+		inflate_stream_destroy(is);
+	}
+
+	free(bad);
+	free(ddata);
+}
+
+/** Stored block */
+PCUT_TEST(stored)
+{
+	expand_check(hello_stored, sizeof(hello_stored),
+	    (const uint8_t *) "hello", 5);
+	stream_check(hello_stored, sizeof(hello_stored),
+	    (const uint8_t *) "hello", 5, 1, 1);
+	stream_check(hello_stored, sizeof(hello_stored),
+	    (const uint8_t *) "hello", 5, 64, 64);
+}
+
+/** Block compressed with the fixed Huffman code */
+PCUT_TEST(fixed)
+{
+	uint8_t data[TEXT_SIZE];
+
+	fill_text(data, sizeof(data));
+	expand_check(text_fixed, sizeof(text_fixed), data, sizeof(data));
+	stream_check(text_fixed, sizeof(text_fixed), data, sizeof(data),
+	    sizeof(text_fixed), sizeof(data) + 1);
+}
+
+/** Block compressed with a dynamic Huffman code */
+PCUT_TEST(dynamic)
+{
+	uint8_t data[TEXT_SIZE];
+
+	fill_text(data, sizeof(data));
+	expand_check(text_dynamic, sizeof(text_dynamic), data, sizeof(data));
+	stream_check(text_dynamic, sizeof(text_dynamic), data, sizeof(data),
+	    sizeof(text_dynamic), sizeof(data) + 1);
+}
+
+/** Input and output passed to the stream in small chunks */
+PCUT_TEST(stream_chunks)
+{
+	uint8_t data[TEXT_SIZE];
+	size_t chunks[] = { 1, 2, 3, 7, 64, 1000 };
+	size_t nchunks = sizeof(chunks) / sizeof(chunks[0]);
+
+	fill_text(data, sizeof(data));
+
+	for (size_t i = 0; i < nchunks; i++) {
+		for (size_t j = 0; j < nchunks; j++) {
+			stream_check(text_fixed, sizeof(text_fixed), data,
+			    sizeof(data), chunks[i], chunks[j]);
+			stream_check(text_dynamic, sizeof(text_dynamic), data,
+			    sizeof(data), chunks[i], chunks[j]);
+		}
+	}
+}
+
+/** Input following the deflate stream is not consumed */
+PCUT_TEST(trailing_data)
+{
+	inflate_stream_t *is;
+	uint8_t src[sizeof(hello_stored) + 4];
+	uint8_t dest[16];
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	memcpy(src, hello_stored, sizeof(hello_stored));
+	memset(src + sizeof(hello_stored), 0xff, 4);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = inflate_stream(is, src, sizeof(src), &srcused, dest,
+	    sizeof(dest), &destused);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_TRUE(inflate_stream_done(is));
+	PCUT_ASSERT_INT_EQUALS(sizeof(hello_stored), srcused);
+	PCUT_ASSERT_INT_EQUALS(5, destused);
+
+	inflate_stream_destroy(is);
+}
+
+/** Truncated deflate stream */
+PCUT_TEST(truncated)
+{
+	inflate_stream_t *is;
+	uint8_t data[TEXT_SIZE];
+	size_t half = sizeof(text_dynamic) / 2;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	rc = inflate((void *) text_dynamic, half, data, sizeof(data));
+	PCUT_ASSERT_ERRNO_VAL(ELIMIT, rc);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	/* Stream waits for more input */
+	rc = inflate_stream(is, text_dynamic, half, &srcused, data,
+	    sizeof(data), &destused);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_FALSE(inflate_stream_done(is));
+	PCUT_ASSERT_INT_EQUALS(half, srcused);
+	PCUT_ASSERT_TRUE(destused < sizeof(data));
+
+	inflate_stream_destroy(is);
+}
+
+/** Invalid block type */
+PCUT_TEST(bad_block_type)
+{
+	/* Final block of type 3 */
+	uint8_t src[] = { 0x07, 0x00, 0x00, 0x00 };
+	uint8_t dest[16];
+	inflate_stream_t *is;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	rc = inflate(src, sizeof(src), dest, sizeof(dest));
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = inflate_stream(is, src, sizeof(src), &srcused, dest,
+	    sizeof(dest), &destused);
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+
+	inflate_stream_destroy(is);
+}
+
+/** Stored block with mismatched length and its complement */
+PCUT_TEST(stored_bad_length)
+{
+	uint8_t src[sizeof(hello_stored)];
+	uint8_t dest[16];
+	inflate_stream_t *is;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	memcpy(src, hello_stored, sizeof(hello_stored));
+	src[3] = 0;
+
+	rc = inflate(src, sizeof(src), dest, sizeof(dest));
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = inflate_stream(is, src, sizeof(src), &srcused, dest,
+	    sizeof(dest), &destused);
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+
+	inflate_stream_destroy(is);
+}
+
+/** Match referring to data before the start of the output */
+PCUT_TEST(distance_too_far)
+{
+	/* Fixed code block: literal 'a', length 3 at distance 2, end */
+	uint8_t src[] = { 0x4b, 0x04, 0x42, 0x00 };
+	uint8_t dest[16];
+	inflate_stream_t *is;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	rc = inflate(src, sizeof(src), dest, sizeof(dest));
+	PCUT_ASSERT_ERRNO_VAL(ENOENT, rc);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = inflate_stream(is, src, sizeof(src), &srcused, dest,
+	    sizeof(dest), &destused);
+	PCUT_ASSERT_ERRNO_VAL(ENOENT, rc);
+
+	inflate_stream_destroy(is);
+}
+
+/** Codes longer than the lookup table */
+PCUT_TEST(long_codes)
+{
+	uint8_t data[SKEWED_SIZE];
+	size_t chunks[] = { 1, 2, 5, 64, sizeof(skewed_dynamic) };
+
+	fill_skewed(data, sizeof(data));
+	expand_check(skewed_dynamic, sizeof(skewed_dynamic), data,
+	    sizeof(data));
+
+	for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+		stream_check(skewed_dynamic, sizeof(skewed_dynamic), data,
+		    sizeof(data), chunks[i], sizeof(data) + 1);
+	}
+}
+
+/** Matches overlapping their own output */
+PCUT_TEST(overlapping_matches)
+{
+	uint8_t data[RUNS_SIZE];
+
+	fill_runs(data);
+	expand_check(runs_dynamic, sizeof(runs_dynamic), data, sizeof(data));
+	stream_check(runs_dynamic, sizeof(runs_dynamic), data, sizeof(data),
+	    sizeof(runs_dynamic), sizeof(data) + 1);
+}
+
+/** Output space around the longest match length */
+PCUT_TEST(stream_match_boundary)
+{
+	uint8_t data[RUNS_SIZE];
+	size_t chunks[] = { 1, 257, 258, 259, 300 };
+
+	fill_runs(data);
+
+	for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+		stream_check(runs_dynamic, sizeof(runs_dynamic), data,
+		    sizeof(data), sizeof(runs_dynamic), chunks[i]);
+		stream_check(runs_dynamic, sizeof(runs_dynamic), data,
+		    sizeof(data), 3, chunks[i]);
+	}
+}
+
+/** Dynamic block without any code length codes */
+PCUT_TEST(bad_code_lengths)
+{
+	/* Final dynamic block, HLIT = HDIST = HCLEN = 0, all lengths 0 */
+	uint8_t src[] = { 0x05, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	uint8_t dest[16];
+	inflate_stream_t *is;
+	size_t srcused;
+	size_t destused;
+	errno_t rc;
+
+	rc = inflate(src, sizeof(src), dest, sizeof(dest));
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+
+	rc = inflate_stream_create(&is);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = inflate_stream(is, src, sizeof(src), &srcused, dest,
+	    sizeof(dest), &destused);
+	PCUT_ASSERT_ERRNO_VAL(EINVAL, rc);
+
+	inflate_stream_destroy(is);
+}
+
+/** Corrupted deflate streams are handled safely */
+PCUT_TEST(corrupted)
+{
+	stream_corrupt(text_fixed, sizeof(text_fixed), TEXT_SIZE);
+	stream_corrupt(text_dynamic, sizeof(text_dynamic), TEXT_SIZE);
+	stream_corrupt(skewed_dynamic, sizeof(skewed_dynamic), SKEWED_SIZE);
+	stream_corrupt(runs_dynamic, sizeof(runs_dynamic), RUNS_SIZE);
+}
+
+PCUT_EXPORT(inflate);
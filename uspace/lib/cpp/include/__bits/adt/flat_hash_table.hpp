@@ -0,0 +1,706 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+#define LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+
+#include <__bits/adt/flat_hash_table_iterators.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace std::aux
+{
+    inline constexpr flat_ctrl_t flat_ctrl_empty{-128};
+    inline constexpr flat_ctrl_t flat_ctrl_deleted{-2};
+
+    /**
+     * A group of consecutive control bytes that is probed
+     * at once. There is no SIMD instruction set we could
+     * rely on across our platforms, so a group is a 64-bit
+     * word and its bytes are compared in parallel using
+     * bit arithmetic. Results are masks with the top bit
+     * of each matching byte set.
+     */
+    struct flat_group
+    {
+        static constexpr size_t width{8};
+
+        static constexpr uint64_t lsbs{0x0101010101010101ULL};
+        static constexpr uint64_t msbs{0x8080808080808080ULL};
+
+        uint64_t ctrl;
+
+        explicit flat_group(const flat_ctrl_t* pos) noexcept
+        {
+            memcpy(&ctrl, pos, sizeof(ctrl));
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            // Byte i of the group has to be byte i of the word.
+            ctrl = __builtin_bswap64(ctrl);
+#endif
+        }
+
+        /**
+         * Note: This can report a false positive for a byte
+         *       that follows a true match, the keys are
+         *       compared afterwards anyway.
+         */
+        uint64_t match(flat_ctrl_t h2) const noexcept
+        {
+            auto x = ctrl ^ (lsbs * static_cast<unsigned char>(h2));
+
+            return (x - lsbs) & ~x & msbs;
+        }
+
+        uint64_t match_empty() const noexcept
+        {
+            // Empty has the top bit set and bit 1 clear.
+            return ctrl & (~ctrl << 6) & msbs;
+        }
+
+        uint64_t match_empty_or_deleted() const noexcept
+        {
+            return ctrl & msbs;
+        }
+
+        static size_t first(uint64_t mask) noexcept
+        {
+            return __builtin_ctzll(mask) / 8;
+        }
+
+        static size_t last_non_matching(uint64_t mask) noexcept
+        {
+            return __builtin_clzll(mask) / 8;
+        }
+
+        static uint64_t next(uint64_t mask) noexcept
+        {
+            return mask & (mask - 1);
+        }
+    };
+
+    /**
+     * Open addressing hash table in the style of Swiss tables.
+     * Values are stored directly in an array of slots and
+     * a parallel array of control bytes says whether a slot
+     * is empty, deleted or full and, for full slots, holds
+     * 7 bits of the hash of the key. Lookups probe groups of
+     * control bytes and only compare keys of slots whose
+     * hash bits match, so they rarely touch unrelated values.
+     *
+     * The first flat_group::width control bytes are cloned
+     * past the end of the array so that a group can be loaded
+     * at any slot index without wrapping around.
+     */
+    template<
+        class Value, class Key, class KeyExtractor,
+        class Hasher, class KeyEq, class Alloc
+    >
+    class flat_hash_table
+    {
+        public:
+            using value_type     = Value;
+            using key_type       = Key;
+            using size_type      = size_t;
+            using allocator_type = Alloc;
+            using key_equal      = KeyEq;
+            using hasher         = Hasher;
+            using key_extract    = KeyExtractor;
+
+            using iterator       = flat_hash_table_iterator<
+                value_type, value_type&, value_type*
+            >;
+            using const_iterator = flat_hash_table_const_iterator<
+                value_type, const value_type&, const value_type*
+            >;
+
+            flat_hash_table(size_type count = 0, const hasher& hf = hasher{},
+                            const key_equal& eql = key_equal{},
+                            const allocator_type& alloc = allocator_type{})
+                : ctrl_{}, slots_{}, capacity_{}, size_{}, growth_left_{},
+                  hasher_{hf}, key_eq_{eql}, key_extractor_{}, allocator_{alloc}
+            {
+                if (count > 0)
+                    rehash(count);
+            }
+
+            flat_hash_table(const flat_hash_table& other)
+                : flat_hash_table{
+                    0, other.hasher_, other.key_eq_,
+                    allocator_traits<allocator_type>::select_on_container_copy_construction(
+                        other.allocator_
+                    )
+                  }
+            {
+                reserve(other.size_);
+                for (const auto& val: other)
+                {
+                    auto hash = hash_(key_extractor_(val));
+                    emplace_at_(find_free_slot_(hash), hash, val);
+                }
+            }
+
+            flat_hash_table(flat_hash_table&& other)
+                : ctrl_{other.ctrl_}, slots_{other.slots_},
+                  capacity_{other.capacity_}, size_{other.size_},
+                  growth_left_{other.growth_left_}, hasher_{move(other.hasher_)},
+                  key_eq_{move(other.key_eq_)}, key_extractor_{},
+                  allocator_{move(other.allocator_)}
+            {
+                other.ctrl_ = nullptr;
+                other.slots_ = nullptr;
+                other.capacity_ = 0;
+                other.size_ = 0;
+                other.growth_left_ = 0;
+            }
+
+            flat_hash_table& operator=(const flat_hash_table& other)
+            {
+                flat_hash_table tmp{other};
+                swap(tmp);
+
+                return *this;
+            }
+
+            flat_hash_table& operator=(flat_hash_table&& other)
+            {
+                flat_hash_table tmp{move(other)};
+                swap(tmp);
+
+                return *this;
+            }
+
+            ~flat_hash_table()
+            {
+                destroy_all_();
+                deallocate_(ctrl_, slots_, capacity_);
+            }
+
+            bool empty() const noexcept
+            {
+                return size_ == 0;
+            }
+
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            size_type max_size() const noexcept
+            {
+                return allocator_traits<allocator_type>::max_size(allocator_);
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_;
+            }
+
+            iterator begin() noexcept
+            {
+                return iterator{ctrl_, slots_, ctrl_ + capacity_};
+            }
+
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+
+            iterator end() noexcept
+            {
+                return iterator{
+                    ctrl_ + capacity_, slots_ + capacity_,
+                    ctrl_ + capacity_
+                };
+            }
+
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+
+            const_iterator cbegin() const noexcept
+            {
+                return const_iterator{ctrl_, slots_, ctrl_ + capacity_};
+            }
+
+            const_iterator cend() const noexcept
+            {
+                return const_iterator{
+                    ctrl_ + capacity_, slots_ + capacity_,
+                    ctrl_ + capacity_
+                };
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                /**
+                 * We need the key before we know where
+                 * to construct the value, so we construct
+                 * it on the side and move it if it gets
+                 * inserted.
+                 */
+                value_type val{forward<Args>(args)...};
+
+                return insert(move(val));
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                auto pos = prepare_insert(key_extractor_(val));
+                if (pos.found)
+                    return make_pair(iterator_at(pos.idx), false);
+
+                return make_pair(emplace_at_(pos.idx, pos.hash, val), true);
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                auto pos = prepare_insert(key_extractor_(val));
+                if (pos.found)
+                    return make_pair(iterator_at(pos.idx), false);
+
+                return make_pair(emplace_at_(pos.idx, pos.hash, move(val)), true);
+            }
+
+            struct insert_position
+            {
+                size_type idx;
+                size_t hash;
+                bool found;
+            };
+
+            /**
+             * Finds the slot holding key or the slot where it
+             * should be inserted, found tells which one it is.
+             * In the latter case, the value has to be constructed
+             * by emplace_at.
+             */
+            insert_position prepare_insert(const key_type& key)
+            {
+                auto hash = hash_(key);
+                auto idx = find_idx_(key, hash);
+                if (idx != capacity_)
+                    return insert_position{idx, hash, true};
+
+                if (growth_left_ == 0)
+                    grow_();
+
+                return insert_position{find_free_slot_(hash), hash, false};
+            }
+
+            template<class... Args>
+            iterator emplace_at(size_type idx, size_t hash, Args&&... args)
+            {
+                return emplace_at_(idx, hash, forward<Args>(args)...);
+            }
+
+            value_type& slot(size_type idx)
+            {
+                return slots_[idx];
+            }
+
+            iterator iterator_at(size_type idx)
+            {
+                return iterator{ctrl_ + idx, slots_ + idx, ctrl_ + capacity_};
+            }
+
+            iterator make_iterator(const_iterator it)
+            {
+                return iterator_at(static_cast<size_type>(it.ctrl() - ctrl_));
+            }
+
+            size_type erase(const key_type& key)
+            {
+                auto idx = find_idx_(key, hash_(key));
+                if (idx == capacity_)
+                    return 0;
+
+                erase_at_(idx);
+
+                return 1;
+            }
+
+            iterator erase(const_iterator it)
+            {
+                auto idx = static_cast<size_type>(it.ctrl() - ctrl_);
+                erase_at_(idx);
+
+                // Erasing does not move anything.
+                return iterator_at(idx + 1);
+            }
+
+            void clear() noexcept
+            {
+                destroy_all_();
+                if (capacity_ > 0)
+                    reset_ctrl_();
+            }
+
+            void swap(flat_hash_table& other)
+                noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
+                         noexcept(std::swap(declval<Hasher&>(), declval<Hasher&>())) &&
+                         noexcept(std::swap(declval<KeyEq&>(), declval<KeyEq&>())))
+            {
+                std::swap(ctrl_, other.ctrl_);
+                std::swap(slots_, other.slots_);
+                std::swap(capacity_, other.capacity_);
+                std::swap(size_, other.size_);
+                std::swap(growth_left_, other.growth_left_);
+                std::swap(hasher_, other.hasher_);
+                std::swap(key_eq_, other.key_eq_);
+                std::swap(allocator_, other.allocator_);
+            }
+
+            hasher hash_function() const
+            {
+                return hasher_;
+            }
+
+            key_equal key_eq() const
+            {
+                return key_eq_;
+            }
+
+            iterator find(const key_type& key)
+            {
+                return iterator_at(find_idx_(key, hash_(key)));
+            }
+
+            const_iterator find(const key_type& key) const
+            {
+                auto idx = find_idx_(key, hash_(key));
+
+                return const_iterator{
+                    ctrl_ + idx, slots_ + idx, ctrl_ + capacity_
+                };
+            }
+
+            size_type count(const key_type& key) const
+            {
+                return find_idx_(key, hash_(key)) == capacity_ ? 0 : 1;
+            }
+
+            size_type bucket_count() const noexcept
+            {
+                return capacity_;
+            }
+
+            float load_factor() const noexcept
+            {
+                if (capacity_ == 0)
+                    return 0.f;
+
+                return size_ / static_cast<float>(capacity_);
+            }
+
+            float max_load_factor() const noexcept
+            {
+                return max_load_num_ / static_cast<float>(max_load_den_);
+            }
+
+            void rehash(size_type count)
+            {
+                auto min_count = min_capacity_for_(size_);
+                if (count < min_count)
+                    count = min_count;
+
+                size_type new_capacity{flat_group::width};
+                while (new_capacity < count)
+                    new_capacity *= 2;
+
+                if (count == 0 && size_ == 0)
+                    new_capacity = 0;
+
+                if (new_capacity != capacity_)
+                    resize_(new_capacity);
+            }
+
+            void reserve(size_type count)
+            {
+                if (count > capacity_ * max_load_num_ / max_load_den_)
+                    rehash(min_capacity_for_(count));
+            }
+
+            bool is_eq_to(const flat_hash_table& other) const
+            {
+                if (size_ != other.size_)
+                    return false;
+
+                for (const auto& val: *this)
+                {
+                    auto it = other.find(key_extractor_(val));
+                    if (it == other.end() || !(*it == val))
+                        return false;
+                }
+
+                return true;
+            }
+
+        private:
+            flat_ctrl_t* ctrl_;
+            value_type* slots_;
+            size_type capacity_;
+            size_type size_;
+            size_type growth_left_;
+            hasher hasher_;
+            key_equal key_eq_;
+            key_extract key_extractor_;
+            allocator_type allocator_;
+
+            /**
+             * Tables are kept at most 7/8 full (counting
+             * deleted slots), so that probing always ends
+             * at an empty slot soon enough.
+             */
+            static constexpr size_type max_load_num_{7};
+            static constexpr size_type max_load_den_{8};
+
+            size_t hash_(const key_type& key) const
+            {
+                /**
+                 * Our standard hashes of integers are the
+                 * identity, mix the bits so that both the
+                 * probe start and the 7 bits in the control
+                 * byte depend on the whole key.
+                 */
+                size_t hash = hasher_(key);
+                if constexpr (sizeof(size_t) == 8)
+                {
+                    hash ^= hash >> 32;
+                    hash *= static_cast<size_t>(0x9E3779B97F4A7C15ULL);
+                    hash ^= hash >> 29;
+                }
+                else
+                {
+                    hash ^= hash >> 16;
+                    hash *= static_cast<size_t>(0x85EBCA6BU);
+                    hash ^= hash >> 13;
+                }
+
+                return hash;
+            }
+
+            static size_t h1_(size_t hash) noexcept
+            {
+                return hash >> 7;
+            }
+
+            static flat_ctrl_t h2_(size_t hash) noexcept
+            {
+                return static_cast<flat_ctrl_t>(hash & 0x7F);
+            }
+
+            static size_type min_capacity_for_(size_type count) noexcept
+            {
+                return count + (count + max_load_num_ - 1) / max_load_num_;
+            }
+
+            /**
+             * Returns capacity_ if key is not in the table.
+             */
+            size_type find_idx_(const key_type& key, size_t hash) const
+            {
+                if (capacity_ == 0)
+                    return capacity_;
+
+                auto mask = capacity_ - 1;
+                auto h2 = h2_(hash);
+                auto pos = h1_(hash) & mask;
+                size_type step{};
+
+                /**
+                 * Note: Probing by triangular numbers of groups
+                 *       visits every group of a power of two
+                 *       sized table.
+                 */
+                while (true)
+                {
+                    flat_group group{ctrl_ + pos};
+
+                    for (auto m = group.match(h2); m; m = flat_group::next(m))
+                    {
+                        auto idx = (pos + flat_group::first(m)) & mask;
+                        if (key_eq_(key, key_extractor_(slots_[idx])))
+                            return idx;
+                    }
+
+                    if (group.match_empty())
+                        return capacity_;
+
+                    step += flat_group::width;
+                    pos = (pos + step) & mask;
+                }
+            }
+
+            size_type find_free_slot_(size_t hash) const
+            {
+                auto mask = capacity_ - 1;
+                auto pos = h1_(hash) & mask;
+                size_type step{};
+
+                while (true)
+                {
+                    flat_group group{ctrl_ + pos};
+
+                    auto m = group.match_empty_or_deleted();
+                    if (m)
+                        return (pos + flat_group::first(m)) & mask;
+
+                    step += flat_group::width;
+                    pos = (pos + step) & mask;
+                }
+            }
+
+            void set_ctrl_(size_type idx, flat_ctrl_t c) noexcept
+            {
+                ctrl_[idx] = c;
+                if (idx < flat_group::width)
+                    ctrl_[capacity_ + idx] = c;
+            }
+
+            template<class... Args>
+            iterator emplace_at_(size_type idx, size_t hash, Args&&... args)
+            {
+                allocator_traits<allocator_type>::construct(
+                    allocator_, slots_ + idx, forward<Args>(args)...
+                );
+
+                if (ctrl_[idx] == flat_ctrl_empty)
+                    --growth_left_;
+                set_ctrl_(idx, h2_(hash));
+                ++size_;
+
+                return iterator_at(idx);
+            }
+
+            void erase_at_(size_type idx)
+            {
+                allocator_traits<allocator_type>::destroy(allocator_, slots_ + idx);
+                --size_;
+
+                /**
+                 * If there is no run of width full slots around idx,
+                 * no probe could have skipped past idx and we can
+                 * make the slot empty again. Otherwise we have to
+                 * leave a tombstone so that probes continue.
+                 */
+                auto mask = capacity_ - 1;
+                auto before = (idx - flat_group::width) & mask;
+                auto empty_after = flat_group{ctrl_ + idx}.match_empty();
+                auto empty_before = flat_group{ctrl_ + before}.match_empty();
+
+                if (empty_after && empty_before &&
+                    flat_group::first(empty_after) +
+                    flat_group::last_non_matching(empty_before) < flat_group::width)
+                {
+                    set_ctrl_(idx, flat_ctrl_empty);
+                    ++growth_left_;
+                }
+                else
+                    set_ctrl_(idx, flat_ctrl_deleted);
+            }
+
+            void grow_()
+            {
+                /**
+                 * If most of the used up space are tombstones,
+                 * rehashing in place reclaims it, otherwise
+                 * we double the capacity.
+                 */
+                if (capacity_ > 0 && size_ * 2 < capacity_ * max_load_num_ / max_load_den_)
+                    resize_(capacity_);
+                else
+                    resize_(capacity_ ? capacity_ * 2 : flat_group::width);
+            }
+
+            void resize_(size_type new_capacity)
+            {
+                auto old_ctrl = ctrl_;
+                auto old_slots = slots_;
+                auto old_capacity = capacity_;
+
+                ctrl_ = nullptr;
+                slots_ = nullptr;
+                capacity_ = new_capacity;
+                size_ = 0;
+                growth_left_ = 0;
+
+                if (new_capacity > 0)
+                {
+                    ctrl_ = new flat_ctrl_t[new_capacity + flat_group::width];
+                    slots_ = allocator_traits<allocator_type>::allocate(
+                        allocator_, new_capacity
+                    );
+                    reset_ctrl_();
+                }
+
+                for (size_type i = 0; i < old_capacity; ++i)
+                {
+                    if (old_ctrl[i] < 0)
+                        continue;
+
+                    auto hash = hash_(key_extractor_(old_slots[i]));
+                    emplace_at_(find_free_slot_(hash), hash, move(old_slots[i]));
+                    allocator_traits<allocator_type>::destroy(allocator_, old_slots + i);
+                }
+
+                deallocate_(old_ctrl, old_slots, old_capacity);
+            }
+
+            void reset_ctrl_() noexcept
+            {
+                memset(ctrl_, flat_ctrl_empty, capacity_ + flat_group::width);
+                size_ = 0;
+                growth_left_ = capacity_ * max_load_num_ / max_load_den_;
+            }
+
+            void destroy_all_() noexcept
+            {
+                for (size_type i = 0; i < capacity_; ++i)
+                {
+                    if (ctrl_[i] >= 0)
+                        allocator_traits<allocator_type>::destroy(allocator_, slots_ + i);
+                }
+            }
+
+            void deallocate_(flat_ctrl_t* ctrl, value_type* slots, size_type capacity)
+            {
+                if (capacity == 0)
+                    return;
+
+                delete[] ctrl;
+                allocator_traits<allocator_type>::deallocate(allocator_, slots, capacity);
+            }
+    };
+}
+
+#endif
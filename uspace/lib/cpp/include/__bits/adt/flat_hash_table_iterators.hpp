@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_FLAT_HASH_TABLE_ITERATORS
+#define LIBCPP_BITS_ADT_FLAT_HASH_TABLE_ITERATORS
+
+#include <__bits/iterator_helpers.hpp>
+#include <iterator>
+
+namespace std::aux
+{
+    /**
+     * Control byte of a flat_hash_table slot, full slots
+     * have the top bit clear.
+     */
+    using flat_ctrl_t = signed char;
+
+    template<class Value, class Reference, class Pointer>
+    class flat_hash_table_iterator
+    {
+        public:
+            using value_type      = Value;
+            using reference       = Reference;
+            using pointer         = Pointer;
+            using difference_type = ptrdiff_t;
+
+            using iterator_category = forward_iterator_tag;
+
+            flat_hash_table_iterator(const flat_ctrl_t* ctrl = nullptr,
+                                     pointer slot = nullptr,
+                                     const flat_ctrl_t* end = nullptr)
+                : ctrl_{ctrl}, slot_{slot}, end_{end}
+            {
+                skip_empty_();
+            }
+
+            flat_hash_table_iterator(const flat_hash_table_iterator&) = default;
+            flat_hash_table_iterator& operator=(const flat_hash_table_iterator&) = default;
+
+            reference operator*() const
+            {
+                return *slot_;
+            }
+
+            pointer operator->() const
+            {
+                return slot_;
+            }
+
+            flat_hash_table_iterator& operator++()
+            {
+                ++ctrl_;
+                ++slot_;
+                skip_empty_();
+
+                return *this;
+            }
+
+            flat_hash_table_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            const flat_ctrl_t* ctrl() const
+            {
+                return ctrl_;
+            }
+
+        private:
+            const flat_ctrl_t* ctrl_;
+            pointer slot_;
+            const flat_ctrl_t* end_;
+
+            void skip_empty_()
+            {
+                while (ctrl_ != end_ && *ctrl_ < 0)
+                {
+                    ++ctrl_;
+                    ++slot_;
+                }
+            }
+
+            template<class V, class CR, class CP>
+            friend class flat_hash_table_const_iterator;
+    };
+
+    template<class Value, class Ref, class Ptr>
+    bool operator==(const flat_hash_table_iterator<Value, Ref, Ptr>& lhs,
+                    const flat_hash_table_iterator<Value, Ref, Ptr>& rhs)
+    {
+        return lhs.ctrl() == rhs.ctrl();
+    }
+
+    template<class Value, class Ref, class Ptr>
+    bool operator!=(const flat_hash_table_iterator<Value, Ref, Ptr>& lhs,
+                    const flat_hash_table_iterator<Value, Ref, Ptr>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class Value, class ConstReference, class ConstPointer>
+    class flat_hash_table_const_iterator
+    {
+        using non_const_iterator_type = flat_hash_table_iterator<
+            Value, get_non_const_ref_t<ConstReference>,
+            get_non_const_ptr_t<ConstPointer>
+        >;
+
+        public:
+            using value_type      = Value;
+            using const_reference = ConstReference;
+            using const_pointer   = ConstPointer;
+            using difference_type = ptrdiff_t;
+
+            using iterator_category = forward_iterator_tag;
+
+            flat_hash_table_const_iterator(const flat_ctrl_t* ctrl = nullptr,
+                                           const_pointer slot = nullptr,
+                                           const flat_ctrl_t* end = nullptr)
+                : ctrl_{ctrl}, slot_{slot}, end_{end}
+            {
+                skip_empty_();
+            }
+
+            flat_hash_table_const_iterator(const flat_hash_table_const_iterator&) = default;
+            flat_hash_table_const_iterator& operator=(const flat_hash_table_const_iterator&) = default;
+
+            flat_hash_table_const_iterator(const non_const_iterator_type& other)
+                : ctrl_{other.ctrl_}, slot_{other.slot_}, end_{other.end_}
+            { /* DUMMY BODY */ }
+
+            flat_hash_table_const_iterator& operator=(const non_const_iterator_type& other)
+            {
+                ctrl_ = other.ctrl_;
+                slot_ = other.slot_;
+                end_ = other.end_;
+
+                return *this;
+            }
+
+            const_reference operator*() const
+            {
+                return *slot_;
+            }
+
+            const_pointer operator->() const
+            {
+                return slot_;
+            }
+
+            flat_hash_table_const_iterator& operator++()
+            {
+                ++ctrl_;
+                ++slot_;
+                skip_empty_();
+
+                return *this;
+            }
+
+            flat_hash_table_const_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            const flat_ctrl_t* ctrl() const
+            {
+                return ctrl_;
+            }
+
+        private:
+            const flat_ctrl_t* ctrl_;
+            const_pointer slot_;
+            const flat_ctrl_t* end_;
+
+            void skip_empty_()
+            {
+                while (ctrl_ != end_ && *ctrl_ < 0)
+                {
+                    ++ctrl_;
+                    ++slot_;
+                }
+            }
+    };
+
+    template<class Value, class CRef, class CPtr>
+    bool operator==(const flat_hash_table_const_iterator<Value, CRef, CPtr>& lhs,
+                    const flat_hash_table_const_iterator<Value, CRef, CPtr>& rhs)
+    {
+        return lhs.ctrl() == rhs.ctrl();
+    }
+
+    template<class Value, class CRef, class CPtr>
+    bool operator!=(const flat_hash_table_const_iterator<Value, CRef, CPtr>& lhs,
+                    const flat_hash_table_const_iterator<Value, CRef, CPtr>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class Value, class Ref, class Ptr, class CRef, class CPtr>
+    bool operator==(const flat_hash_table_iterator<Value, Ref, Ptr>& lhs,
+                    const flat_hash_table_const_iterator<Value, CRef, CPtr>& rhs)
+    {
+        return lhs.ctrl() == rhs.ctrl();
+    }
+
+    template<class Value, class Ref, class Ptr, class CRef, class CPtr>
+    bool operator!=(const flat_hash_table_iterator<Value, Ref, Ptr>& lhs,
+                    const flat_hash_table_const_iterator<Value, CRef, CPtr>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class Value, class CRef, class CPtr, class Ref, class Ptr>
+    bool operator==(const flat_hash_table_const_iterator<Value, CRef, CPtr>& lhs,
+                    const flat_hash_table_iterator<Value, Ref, Ptr>& rhs)
+    {
+        return lhs.ctrl() == rhs.ctrl();
+    }
+
+    template<class Value, class CRef, class CPtr, class Ref, class Ptr>
+    bool operator!=(const flat_hash_table_const_iterator<Value, CRef, CPtr>& lhs,
+                    const flat_hash_table_iterator<Value, Ref, Ptr>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
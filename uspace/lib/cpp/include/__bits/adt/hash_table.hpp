@@ -33,6 +33,7 @@
 #include <__bits/adt/key_extractors.hpp>
 #include <__bits/adt/hash_table_iterators.hpp>
 #include <__bits/adt/hash_table_policies.hpp>
+#include <__bits/adt/node_pool.hpp>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
@@ -86,22 +87,37 @@ namespace std::aux
                 list_node<value_type>*, size_type
             >;
 
-            hash_table(size_type buckets, float max_load_factor = 1.f)
-                : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
-                  bucket_count_{buckets}, size_{}, hasher_{}, key_eq_{},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
-            { /* DUMMY BODY */ }
+            explicit hash_table(size_type buckets,
+                                const allocator_type& alloc = allocator_type{})
+                : table_{}, bucket_count_{buckets}, size_{}, hasher_{}, key_eq_{},
+                  key_extractor_{}, max_load_factor_{1.f}, allocator_{alloc},
+                  pool_{}
+            {
+                table_ = allocate_table_(bucket_count_);
+            }
 
             hash_table(size_type buckets, const hasher& hf, const key_equal& eql,
+                       const allocator_type& alloc = allocator_type{},
                        float max_load_factor = 1.f)
-                : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
-                  bucket_count_{buckets}, size_{}, hasher_{hf}, key_eq_{eql},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
-            { /* DUMMY BODY */ }
+                : table_{}, bucket_count_{buckets}, size_{}, hasher_{hf}, key_eq_{eql},
+                  key_extractor_{}, max_load_factor_{max_load_factor},
+                  allocator_{alloc}, pool_{}
+            {
+                table_ = allocate_table_(bucket_count_);
+            }
 
             hash_table(const hash_table& other)
+                : hash_table{
+                    other,
+                    allocator_traits<allocator_type>::select_on_container_copy_construction(
+                        other.allocator_
+                    )
+                  }
+            { /* DUMMY BODY */ }
+
+            hash_table(const hash_table& other, const allocator_type& alloc)
                 : hash_table{other.bucket_count_, other.hasher_, other.key_eq_,
-                             other.max_load_factor_}
+                             alloc, other.max_load_factor_}
             {
                 for (const auto& x: other)
                     insert(x);
@@ -111,7 +127,8 @@ namespace std::aux
                 : table_{other.table_}, bucket_count_{other.bucket_count_},
                   size_{other.size_}, hasher_{move(other.hasher_)},
                   key_eq_{move(other.key_eq_)}, key_extractor_{move(other.key_extractor_)},
-                  max_load_factor_{other.max_load_factor_}
+                  max_load_factor_{other.max_load_factor_},
+                  allocator_{move(other.allocator_)}, pool_{move(other.pool_)}
             {
                 other.table_ = nullptr;
                 other.bucket_count_ = size_type{};
@@ -119,18 +136,55 @@ namespace std::aux
                 other.max_load_factor_ = 1.f;
             }
 
+            hash_table(hash_table&& other, const allocator_type& alloc)
+                : hash_table{other.bucket_count_, other.hasher_, other.key_eq_,
+                             alloc, other.max_load_factor_}
+            {
+                if (allocator_ == other.allocator_)
+                    swap_contents_(other);
+                else
+                {
+                    // Different memory, move the elements one by one.
+                    for (auto& x: other)
+                        insert(move(x));
+                    other.clear();
+                }
+            }
+
             hash_table& operator=(const hash_table& other)
             {
-                hash_table tmp{other};
-                tmp.swap(*this);
+                if constexpr (allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+                {
+                    hash_table tmp{other, other.allocator_};
+                    swap_contents_(tmp);
+                    std::swap(allocator_, tmp.allocator_);
+                }
+                else
+                {
+                    hash_table tmp{other, allocator_};
+                    swap_contents_(tmp);
+                }
 
                 return *this;
             }
 
             hash_table& operator=(hash_table&& other)
             {
-                hash_table tmp{move(other)};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                if (aux::alloc_can_steal(allocator_, other.allocator_))
+                {
+                    hash_table tmp{move(other)};
+                    swap_contents_(tmp);
+                    if constexpr (allocator_traits<allocator_type>::propagate_on_container_move_assignment::value)
+                        std::swap(allocator_, tmp.allocator_);
+                }
+                else
+                {
+                    hash_table tmp{move(other), allocator_};
+                    swap_contents_(tmp);
+                }
 
                 return *this;
             }
@@ -145,9 +199,14 @@ namespace std::aux
                 return size_;
             }
 
-            size_type max_size(allocator_type& alloc)
+            size_type max_size() const noexcept
+            {
+                return allocator_traits<allocator_type>::max_size(allocator_);
+            }
+
+            allocator_type get_allocator() const noexcept
             {
-                return allocator_traits<allocator_type>::max_size(alloc);
+                return allocator_;
             }
 
             iterator begin() noexcept
@@ -234,7 +293,7 @@ namespace std::aux
                 --size_;
 
                 node->unlink();
-                delete node;
+                destroy_node(node);
 
                 if (empty())
                     return end();
@@ -245,21 +304,20 @@ namespace std::aux
             void clear() noexcept
             {
                 for (size_type i = 0; i < bucket_count_; ++i)
-                    table_[i].clear();
+                    table_[i].clear(pool_);
                 size_ = size_type{};
+
+                // All nodes are gone, give their memory back.
+                pool_.release(allocator_);
             }
 
             void swap(hash_table& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(swap(declval<Hasher&>(), declval<Hasher&>())) &&
-                         noexcept(swap(declval<KeyEq&>(), declval<KeyEq&>())))
+                         noexcept(std::swap(declval<Hasher&>(), declval<Hasher&>())) &&
+                         noexcept(std::swap(declval<KeyEq&>(), declval<KeyEq&>())))
             {
-                std::swap(table_, other.table_);
-                std::swap(bucket_count_, other.bucket_count_);
-                std::swap(size_, other.size_);
-                std::swap(hasher_, other.hasher_);
-                std::swap(key_eq_, other.key_eq_);
-                std::swap(max_load_factor_, other.max_load_factor_);
+                swap_contents_(other);
+                aux::alloc_propagate_swap(allocator_, other.allocator_);
             }
 
             hasher hash_function() const
@@ -408,7 +466,7 @@ namespace std::aux
                  *       be thrown and no changes to this have been
                  *       made, we're ok.
                  */
-                hash_table new_table{count, max_load_factor_};
+                hash_table new_table{count, hasher_, key_eq_, allocator_, max_load_factor_};
 
                 for (std::size_t i = 0; i < bucket_count_; ++i)
                 {
@@ -447,11 +505,13 @@ namespace std::aux
                     table_[i].head = nullptr;
                 }
 
-                new_table.size_ = size_;
-                swap(new_table);
-
-                delete[] new_table.table_;
-                new_table.table_ = nullptr;
+                /**
+                 * Note: The nodes still belong to our pool,
+                 *       so we only take the buckets, new_table
+                 *       then deletes our old (now empty) ones.
+                 */
+                std::swap(table_, new_table.table_);
+                std::swap(bucket_count_, new_table.bucket_count_);
             }
 
             void reserve(size_type count)
@@ -496,9 +556,13 @@ namespace std::aux
 
             ~hash_table()
             {
-                // Lists are deleted in ~hash_table_bucket.
                 if (table_)
-                    delete[] table_;
+                {
+                    for (size_type i = 0; i < bucket_count_; ++i)
+                        table_[i].clear(pool_);
+                    pool_.release(allocator_);
+                    deallocate_table_(table_, bucket_count_);
+                }
             }
 
             place_type find_insertion_spot(const key_type& key) const
@@ -557,6 +621,17 @@ namespace std::aux
                 --size_;
             }
 
+            template<class... Args>
+            node_type* create_node(Args&&... args)
+            {
+                return pool_.create(allocator_, forward<Args>(args)...);
+            }
+
+            void destroy_node(node_type* node)
+            {
+                pool_.destroy(node);
+            }
+
         private:
             hash_table_bucket<value_type, size_type>* table_;
             size_type bucket_count_;
@@ -565,9 +640,49 @@ namespace std::aux
             key_equal key_eq_;
             key_extract key_extractor_;
             float max_load_factor_;
+            allocator_type allocator_;
+            node_pool<node_type> pool_;
 
             static constexpr float bucket_count_growth_factor_{1.25};
 
+            using bucket_type = hash_table_bucket<value_type, size_type>;
+            using bucket_allocator_type = typename allocator_traits<
+                allocator_type
+            >::template rebind_alloc<bucket_type>;
+
+            bucket_type* allocate_table_(size_type count)
+            {
+                bucket_allocator_type alloc{allocator_};
+                auto table = allocator_traits<bucket_allocator_type>::allocate(alloc, count);
+
+                for (size_type i = 0; i < count; ++i)
+                    allocator_traits<bucket_allocator_type>::construct(alloc, table + i);
+
+                return table;
+            }
+
+            void deallocate_table_(bucket_type* table, size_type count)
+            {
+                bucket_allocator_type alloc{allocator_};
+                allocator_traits<bucket_allocator_type>::deallocate(alloc, table, count);
+            }
+
+            /**
+             * Swaps everything but the allocators, the caller
+             * makes sure that the nodes and buckets of both tables
+             * can be released with the allocator they end up with.
+             */
+            void swap_contents_(hash_table& other)
+            {
+                std::swap(table_, other.table_);
+                std::swap(bucket_count_, other.bucket_count_);
+                std::swap(size_, other.size_);
+                std::swap(hasher_, other.hasher_);
+                std::swap(key_eq_, other.key_eq_);
+                std::swap(max_load_factor_, other.max_load_factor_);
+                pool_.swap(other.pool_);
+            }
+
             size_type get_bucket_idx_(const key_type& key) const
             {
                 return hasher_(key) % bucket_count_;
@@ -79,7 +79,14 @@ namespace std::aux
                 head->prepend(node);
         }
 
-        void clear()
+        /**
+         * Note: Nodes are allocated from the pool
+         *       of the table, so the table has to
+         *       clear its buckets, we cannot do that
+         *       in the destructor.
+         */
+        template<class Pool>
+        void clear(Pool& pool)
         {
             if (!head)
                 return;
@@ -89,17 +96,12 @@ namespace std::aux
             {
                 auto tmp = current;
                 current = current->next;
-                delete tmp;
+                pool.destroy(tmp);
             }
             while (current && current != head);
 
             head = nullptr;
         }
-
-        ~hash_table_bucket()
-        {
-            clear();
-        }
     };
 }
 
@@ -98,7 +98,7 @@ namespace std::aux
                     }
 
                     current->unlink();
-                    delete current;
+                    table.destroy_node(current);
 
                     return 1;
                 }
@@ -143,7 +143,6 @@ namespace std::aux
         > emplace(Table& table, Args&&... args)
         {
             using value_type = typename Table::value_type;
-            using node_type  = typename Table::node_type;
             using iterator   = typename Table::iterator;
 
             table.increment_size();
@@ -169,7 +168,7 @@ namespace std::aux
             }
             else
             {
-                auto node = new node_type{move(val)};
+                auto node = table.create_node(move(val));
                 bucket->prepend(node);
 
                 return make_pair(iterator{
@@ -185,7 +184,6 @@ namespace std::aux
             typename Table::iterator, bool
         > insert(Table& table, const Value& val)
         {
-            using node_type  = typename Table::node_type;
             using iterator   = typename Table::iterator;
 
             table.increment_size();
@@ -210,7 +208,7 @@ namespace std::aux
             }
             else
             {
-                auto node = new node_type{val};
+                auto node = table.create_node(val);
                 bucket->prepend(node);
 
                 return make_pair(iterator{
@@ -227,7 +225,6 @@ namespace std::aux
         > insert(Table& table, Value&& val)
         {
             using value_type = typename Table::value_type;
-            using node_type  = typename Table::node_type;
             using iterator   = typename Table::iterator;
 
             table.increment_size();
@@ -252,7 +249,7 @@ namespace std::aux
             }
             else
             {
-                auto node = new node_type{forward<value_type>(val)};
+                auto node = table.create_node(forward<value_type>(val));
                 bucket->prepend(node);
 
                 return make_pair(iterator{
@@ -357,7 +354,7 @@ namespace std::aux
                     --table.size_;
                     ++res;
 
-                    delete tmp;
+                    table.destroy_node(tmp);
                 }
             }
             while (current && current != head);
@@ -406,9 +403,7 @@ namespace std::aux
         template<class Table, class... Args>
         static typename Table::iterator emplace(Table& table, Args&&... args)
         {
-            using node_type  = typename Table::node_type;
-
-            auto node = new node_type{forward<Args>(args)...};
+            auto node = table.create_node(forward<Args>(args)...);
 
             return insert(table, node);
         }
@@ -416,9 +411,7 @@ namespace std::aux
         template<class Table, class Value>
         static typename Table::iterator insert(Table& table, const Value& val)
         {
-            using node_type  = typename Table::node_type;
-
-            auto node = new node_type{val};
+            auto node = table.create_node(val);
 
             return insert(table, node);
         }
@@ -427,9 +420,8 @@ namespace std::aux
         static typename Table::iterator insert(Table& table, Value&& val)
         {
             using value_type = typename Table::value_type;
-            using node_type  = typename Table::node_type;
 
-            auto node = new node_type{forward<value_type>(val)};
+            auto node = table.create_node(forward<value_type>(val));
 
             return insert(table, node);
         }
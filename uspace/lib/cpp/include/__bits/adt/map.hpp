@@ -29,7 +29,9 @@
 #ifndef LIBCPP_BITS_ADT_MAP
 #define LIBCPP_BITS_ADT_MAP
 
+#include <__bits/adt/node_handle.hpp>
 #include <__bits/adt/rbtree.hpp>
+#include <__bits/memory/memory_resource_fwd.hpp>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -38,6 +40,9 @@
 
 namespace std
 {
+    template<class Key, class Value, class Compare, class Alloc>
+    class multimap;
+
     /**
      * 23.4.4, class template map:
      */
@@ -62,18 +67,25 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_single_node<value_type>;
+        private:
+            using tree_node_type = aux::rbtree_single_node<value_type>;
 
+        public:
             using iterator             = aux::rbtree_iterator<
-                value_type, reference, pointer, size_type, node_type
+                value_type, reference, pointer, size_type, tree_node_type
             >;
             using const_iterator       = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
 
             using reverse_iterator       = std::reverse_iterator<iterator>;
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+            using node_type = aux::map_node_handle<
+                key_type, mapped_type, tree_node_type, allocator_type
+            >;
+            using insert_return_type = aux::node_insert_return<iterator, node_type>;
+
             class value_compare
             {
                 friend class map;
@@ -106,7 +118,7 @@ namespace std
 
             explicit map(const key_compare& comp,
                          const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -119,23 +131,23 @@ namespace std
             }
 
             map(const map& other)
-                : map{other, other.allocator_}
+                : tree_{other.tree_}
             { /* DUMMY BODY */ }
 
             map(map&& other)
-                : tree_{move(other.tree_)}, allocator_{move(other.allocator_)}
+                : tree_{move(other.tree_)}
             { /* DUMMY BODY */ }
 
             explicit map(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}
             { /* DUMMY BODY */ }
 
             map(const map& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}
             { /* DUMMY BODY */ }
 
             map(map&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}
             { /* DUMMY BODY */ }
 
             map(initializer_list<value_type> init,
@@ -163,7 +175,6 @@ namespace std
             map& operator=(const map& other)
             {
                 tree_ = other.tree_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -173,7 +184,6 @@ namespace std
                          is_nothrow_move_assignable<key_compare>::value)
             {
                 tree_ = move(other.tree_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -189,7 +199,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return tree_.get_allocator();
             }
 
             iterator begin() noexcept
@@ -264,7 +274,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return tree_.max_size(allocator_);
+                return tree_.max_size();
             }
 
             /**
@@ -277,7 +287,7 @@ namespace std
                 if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
                     return parent->value.second;
 
-                auto node = new node_type{value_type{key, mapped_type{}}};
+                auto node = tree_.create_node(value_type{key, mapped_type{}});
                 tree_.insert_node(node, parent);
 
                 return node->value.second;
@@ -289,7 +299,7 @@ namespace std
                 if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
                     return parent->value.second;
 
-                auto node = new node_type{value_type{move(key), mapped_type{}}};
+                auto node = tree_.create_node(value_type{move(key), mapped_type{}});
                 tree_.insert_node(node, parent);
 
                 return node->value.second;
@@ -369,8 +379,7 @@ namespace std
             template<class InputIterator>
             void insert(InputIterator first, InputIterator last)
             {
-                while (first != last)
-                    insert(*first++);
+                tree_.insert_range(first, last);
             }
 
             void insert(initializer_list<value_type> init)
@@ -386,7 +395,7 @@ namespace std
                     return make_pair(iterator{parent, false}, false);
                 else
                 {
-                    auto node = new node_type{value_type{key, forward<Args>(args)...}};
+                    auto node = tree_.create_node(value_type{key, forward<Args>(args)...});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -401,7 +410,7 @@ namespace std
                     return make_pair(iterator{parent, false}, false);
                 else
                 {
-                    auto node = new node_type{value_type{move(key), forward<Args>(args)...}};
+                    auto node = tree_.create_node(value_type{move(key), forward<Args>(args)...});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -432,7 +441,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{value_type{key, forward<T>(val)}};
+                    auto node = tree_.create_node(value_type{key, forward<T>(val)});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -451,7 +460,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{value_type{move(key), forward<T>(val)}};
+                    auto node = tree_.create_node(value_type{move(key), forward<T>(val)});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -492,10 +501,9 @@ namespace std
 
             void swap(map& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(std::swap(declval<key_compare>(), declval<key_compare>())))
+                         noexcept(std::swap(declval<key_compare&>(), declval<key_compare&>())))
             {
                 tree_.swap(other.tree_);
-                std::swap(allocator_, other.allocator_);
             }
 
             void clear() noexcept
@@ -503,6 +511,65 @@ namespace std
                 tree_.clear();
             }
 
+            node_type extract(const_iterator position)
+            {
+                return node_type{tree_.extract(position), get_allocator()};
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+
+                return extract(it);
+            }
+
+            insert_return_type insert(node_type&& node)
+            {
+                if (!node)
+                    return insert_return_type{end(), false, node_type{}};
+
+                auto res = tree_.insert_extracted(node.node());
+                if (res.second)
+                {
+                    node.release();
+
+                    return insert_return_type{res.first, true, node_type{}};
+                }
+                else
+                    return insert_return_type{res.first, false, move(node)};
+            }
+
+            iterator insert(const_iterator, node_type&& node)
+            {
+                return insert(move(node)).position;
+            }
+
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -644,11 +711,16 @@ namespace std
                 value_type, key_type, aux::key_value_key_extractor<key_type, mapped_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_single_policy, node_type
+                aux::rbtree_single_policy, tree_node_type
             >;
 
             tree_type tree_;
-            allocator_type allocator_;
+
+            template<class, class, class, class>
+            friend class map;
+
+            template<class, class, class, class>
+            friend class multimap;
 
             template<class K, class C, class A>
             friend bool operator==(const map<K, C, A>&,
@@ -725,8 +797,10 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_multi_node<value_type>;
+        private:
+            using tree_node_type = aux::rbtree_multi_node<value_type>;
 
+        public:
             class value_compare
             {
                 friend class multimap;
@@ -750,22 +824,26 @@ namespace std
             };
 
             using iterator             = aux::rbtree_iterator<
-                value_type, reference, pointer, size_type, node_type
+                value_type, reference, pointer, size_type, tree_node_type
             >;
             using const_iterator       = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
 
             using reverse_iterator       = std::reverse_iterator<iterator>;
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+            using node_type = aux::map_node_handle<
+                key_type, mapped_type, tree_node_type, allocator_type
+            >;
+
             multimap()
                 : multimap{key_compare{}}
             { /* DUMMY BODY */ }
 
             explicit multimap(const key_compare& comp,
                               const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -778,23 +856,23 @@ namespace std
             }
 
             multimap(const multimap& other)
-                : multimap{other, other.allocator_}
+                : tree_{other.tree_}
             { /* DUMMY BODY */ }
 
             multimap(multimap&& other)
-                : tree_{move(other.tree_)}, allocator_{move(other.allocator_)}
+                : tree_{move(other.tree_)}
             { /* DUMMY BODY */ }
 
             explicit multimap(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}
             { /* DUMMY BODY */ }
 
             multimap(const multimap& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}
             { /* DUMMY BODY */ }
 
             multimap(multimap&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}
             { /* DUMMY BODY */ }
 
             multimap(initializer_list<value_type> init,
@@ -822,7 +900,6 @@ namespace std
             multimap& operator=(const multimap& other)
             {
                 tree_ = other.tree_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -832,7 +909,6 @@ namespace std
                          is_nothrow_move_assignable<key_compare>::value)
             {
                 tree_ = move(other.tree_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -848,7 +924,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return tree_.get_allocator();
             }
 
             iterator begin() noexcept
@@ -923,7 +999,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return tree_.max_size(allocator_);
+                return tree_.max_size();
             }
 
             template<class... Args>
@@ -980,8 +1056,7 @@ namespace std
             template<class InputIterator>
             void insert(InputIterator first, InputIterator last)
             {
-                while (first != last)
-                    insert(*first++);
+                tree_.insert_range(first, last);
             }
 
             void insert(initializer_list<value_type> init)
@@ -1011,10 +1086,9 @@ namespace std
 
             void swap(multimap& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(std::swap(declval<key_compare>(), declval<key_compare>())))
+                         noexcept(std::swap(declval<key_compare&>(), declval<key_compare&>())))
             {
                 tree_.swap(other.tree_);
-                std::swap(allocator_, other.allocator_);
             }
 
             void clear() noexcept
@@ -1022,6 +1096,57 @@ namespace std
                 tree_.clear();
             }
 
+            node_type extract(const_iterator position)
+            {
+                return node_type{tree_.extract(position), get_allocator()};
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+
+                return extract(it);
+            }
+
+            iterator insert(node_type&& node)
+            {
+                if (!node)
+                    return end();
+
+                return tree_.insert_extracted(node.release());
+            }
+
+            iterator insert(const_iterator, node_type&& node)
+            {
+                return insert(move(node));
+            }
+
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -1163,11 +1288,16 @@ namespace std
                 value_type, key_type, aux::key_value_key_extractor<key_type, mapped_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_multi_policy, node_type
+                aux::rbtree_multi_policy, tree_node_type
             >;
 
             tree_type tree_;
-            allocator_type allocator_;
+
+            template<class, class, class, class>
+            friend class map;
+
+            template<class, class, class, class>
+            friend class multimap;
 
             template<class K, class C, class A>
             friend bool operator==(const multimap<K, C, A>&,
@@ -1221,4 +1351,19 @@ namespace std
     }
 }
 
+namespace std::pmr
+{
+    template<class Key, class Value, class Compare = less<Key>>
+    using map = std::map<
+        Key, Value, Compare,
+        polymorphic_allocator<pair<const Key, Value>>
+    >;
+
+    template<class Key, class Value, class Compare = less<Key>>
+    using multimap = std::multimap<
+        Key, Value, Compare,
+        polymorphic_allocator<pair<const Key, Value>>
+    >;
+}
+
 #endif
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_NODE_HANDLE
+#define LIBCPP_BITS_ADT_NODE_HANDLE
+
+#include <__bits/memory/allocator_traits.hpp>
+#include <new>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * 23.2.4, node handles:
+     * A node handle owns a node extracted from an associative
+     * container, the node can be inserted into a container with
+     * an equal allocator without copying or moving its value.
+     * Note: The allocator is stored only while the handle owns
+     *       a node, polymorphic allocators cannot be assigned.
+     */
+    template<class Node, class Alloc>
+    class node_handle_base
+    {
+        public:
+            using allocator_type = Alloc;
+
+            constexpr node_handle_base() noexcept
+                : node_{}
+            { /* DUMMY BODY */ }
+
+            node_handle_base(node_handle_base&& other) noexcept
+                : node_{}
+            {
+                take_(other);
+            }
+
+            node_handle_base& operator=(node_handle_base&& other)
+            {
+                if (this != &other)
+                {
+                    reset_();
+                    take_(other);
+                }
+
+                return *this;
+            }
+
+            ~node_handle_base()
+            {
+                reset_();
+            }
+
+            allocator_type get_allocator() const
+            {
+                return alloc_;
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return node_ != nullptr;
+            }
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return node_ == nullptr;
+            }
+
+            void swap(node_handle_base& other)
+                noexcept(allocator_traits<allocator_type>::propagate_on_container_swap::value ||
+                         allocator_traits<allocator_type>::is_always_equal::value)
+            {
+                if (node_ && other.node_)
+                {
+                    std::swap(node_, other.node_);
+                    aux::alloc_propagate_swap(alloc_, other.alloc_);
+                }
+                else if (node_ || other.node_)
+                {
+                    node_handle_base tmp{move(*this)};
+                    take_(other);
+                    other.take_(tmp);
+                }
+            }
+
+            /**
+             * The following are used by the containers
+             * to create handles and to take the node back.
+             */
+
+            node_handle_base(Node* node, const allocator_type& alloc)
+                : node_{node}
+            {
+                if (node_)
+                    new(&alloc_) allocator_type{alloc};
+            }
+
+            Node* node() const noexcept
+            {
+                return node_;
+            }
+
+            Node* release() noexcept
+            {
+                auto res = node_;
+                if (node_)
+                {
+                    alloc_.~allocator_type();
+                    node_ = nullptr;
+                }
+
+                return res;
+            }
+
+        protected:
+            Node* node_;
+
+            union
+            {
+                allocator_type alloc_;
+            };
+
+            void take_(node_handle_base& other)
+            {
+                if (other.node_)
+                {
+                    new(&alloc_) allocator_type{move(other.alloc_)};
+                    node_ = other.release();
+                }
+            }
+
+            void reset_()
+            {
+                if (!node_)
+                    return;
+
+                using node_allocator_type = typename allocator_traits<
+                    allocator_type
+                >::template rebind_alloc<Node>;
+
+                node_allocator_type node_alloc{alloc_};
+                node_->~Node();
+                allocator_traits<node_allocator_type>::deallocate(node_alloc, node_, 1);
+
+                release();
+            }
+    };
+
+    template<class Key, class Value, class Node, class Alloc>
+    class map_node_handle: public node_handle_base<Node, Alloc>
+    {
+        public:
+            using key_type    = Key;
+            using mapped_type = Value;
+
+            using node_handle_base<Node, Alloc>::node_handle_base;
+
+            key_type& key() const
+            {
+                return const_cast<key_type&>(this->node_->value.first);
+            }
+
+            mapped_type& mapped() const
+            {
+                return this->node_->value.second;
+            }
+
+            friend void swap(map_node_handle& lhs, map_node_handle& rhs)
+                noexcept(noexcept(lhs.swap(rhs)))
+            {
+                lhs.swap(rhs);
+            }
+    };
+
+    template<class Value, class Node, class Alloc>
+    class set_node_handle: public node_handle_base<Node, Alloc>
+    {
+        public:
+            using value_type = Value;
+
+            using node_handle_base<Node, Alloc>::node_handle_base;
+
+            value_type& value() const
+            {
+                return this->node_->value;
+            }
+
+            friend void swap(set_node_handle& lhs, set_node_handle& rhs)
+                noexcept(noexcept(lhs.swap(rhs)))
+            {
+                lhs.swap(rhs);
+            }
+    };
+
+    template<class Iterator, class NodeType>
+    struct node_insert_return
+    {
+        Iterator position;
+        bool inserted;
+        NodeType node;
+    };
+}
+
+#endif
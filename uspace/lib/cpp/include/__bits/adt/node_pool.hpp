@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_NODE_POOL
+#define LIBCPP_BITS_ADT_NODE_POOL
+
+#include <__bits/memory/allocator_traits.hpp>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * Allocator for the nodes of node based containers.
+     * Nodes are carved out of chunks that grow geometrically
+     * and destroyed nodes go to a free list for reuse, so
+     * a container does one allocation for many nodes instead
+     * of one per node and its nodes stay close in memory.
+     * Chunks come from the allocator of the owning container,
+     * which is passed to create and release rather than stored,
+     * so that pools can be swapped and moved independently of
+     * allocator propagation. All memory is given back by release,
+     * which the owner has to call (with the allocator it created
+     * the nodes with) once all nodes are destroyed and at the
+     * latest before the pool is destroyed.
+     * Note: A pool is owned by a single container and is not
+     *       synchronized, just as the container itself.
+     */
+    template<class Node>
+    class node_pool
+    {
+        public:
+            node_pool() noexcept
+                : chunks_{}, free_{}, next_chunk_size_{min_chunk_size_}
+            { /* DUMMY BODY */ }
+
+            node_pool(const node_pool&) = delete;
+            node_pool& operator=(const node_pool&) = delete;
+
+            node_pool(node_pool&& other) noexcept
+                : chunks_{other.chunks_}, free_{other.free_},
+                  next_chunk_size_{other.next_chunk_size_}
+            {
+                other.chunks_ = nullptr;
+                other.free_ = nullptr;
+                other.next_chunk_size_ = min_chunk_size_;
+            }
+
+            node_pool& operator=(node_pool&& other) noexcept
+            {
+                swap(other);
+
+                return *this;
+            }
+
+            ~node_pool()
+            { /* DUMMY BODY */ }
+
+            template<class Alloc, class... Args>
+            Node* create(Alloc& alloc, Args&&... args)
+            {
+                if (!free_)
+                    add_chunk_(alloc);
+
+                auto slot = free_;
+                free_ = slot->next;
+
+                return new(slot->storage) Node{forward<Args>(args)...};
+            }
+
+            void destroy(Node* node)
+            {
+                if (!node)
+                    return;
+
+                node->~Node();
+
+                auto slot = reinterpret_cast<slot_t*>(node);
+                slot->next = free_;
+                free_ = slot;
+            }
+
+            template<class Alloc>
+            void release(Alloc& alloc) noexcept
+            {
+                auto slot_alloc = rebind_(alloc);
+                while (chunks_)
+                {
+                    auto next = chunks_->next;
+                    allocator_traits<decltype(slot_alloc)>::deallocate(
+                        slot_alloc, reinterpret_cast<slot_t*>(chunks_),
+                        header_slots_ + chunks_->count
+                    );
+                    chunks_ = next;
+                }
+
+                free_ = nullptr;
+                next_chunk_size_ = min_chunk_size_;
+            }
+
+            void swap(node_pool& other) noexcept
+            {
+                std::swap(chunks_, other.chunks_);
+                std::swap(free_, other.free_);
+                std::swap(next_chunk_size_, other.next_chunk_size_);
+            }
+
+        private:
+            union slot_t
+            {
+                slot_t* next;
+                alignas(Node) unsigned char storage[sizeof(Node)];
+            };
+
+            struct chunk_t
+            {
+                chunk_t* next;
+                size_t count;
+            };
+
+            chunk_t* chunks_;
+            slot_t* free_;
+            size_t next_chunk_size_;
+
+            static constexpr size_t min_chunk_size_{8};
+            static constexpr size_t max_chunk_size_{256};
+
+            /**
+             * Chunks are arrays of slots, the chunk header
+             * occupies as many leading slots as it needs.
+             */
+            static constexpr size_t header_slots_{
+                (sizeof(chunk_t) + sizeof(slot_t) - 1) / sizeof(slot_t)
+            };
+
+            template<class Alloc>
+            static auto rebind_(Alloc& alloc)
+            {
+                using slot_alloc_t = typename allocator_traits<
+                    Alloc
+                >::template rebind_alloc<slot_t>;
+
+                return slot_alloc_t{alloc};
+            }
+
+            template<class Alloc>
+            void add_chunk_(Alloc& alloc)
+            {
+                auto count = next_chunk_size_;
+                auto slot_alloc = rebind_(alloc);
+                auto mem = allocator_traits<decltype(slot_alloc)>::allocate(
+                    slot_alloc, header_slots_ + count
+                );
+
+                auto chunk = reinterpret_cast<chunk_t*>(mem);
+                chunk->next = chunks_;
+                chunk->count = count;
+                chunks_ = chunk;
+
+                auto slots = mem + header_slots_;
+                for (size_t i = count; i > 0; --i)
+                {
+                    slots[i - 1].next = free_;
+                    free_ = &slots[i - 1];
+                }
+
+                if (next_chunk_size_ < max_chunk_size_)
+                    next_chunk_size_ *= 2;
+            }
+    };
+}
+
+#endif
@@ -33,6 +33,10 @@
 #include <__bits/adt/rbtree_iterators.hpp>
 #include <__bits/adt/rbtree_node.hpp>
 #include <__bits/adt/rbtree_policies.hpp>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
 
 namespace std::aux
 {
@@ -60,43 +64,122 @@ namespace std::aux
 
             using node_type = Node;
 
-            rbtree(const key_compare& kcmp = key_compare{})
-                : root_{nullptr}, size_{}, key_compare_{},
-                  key_extractor_{}
+            rbtree(const key_compare& kcmp = key_compare{},
+                   const allocator_type& alloc = allocator_type{})
+                : root_{nullptr}, size_{}, key_compare_{kcmp},
+                  key_extractor_{}, node_allocator_{alloc},
+                  free_nodes_{}, free_count_{}
             { /* DUMMY BODY */ }
 
             rbtree(const rbtree& other)
-                : rbtree{other.key_compare_}
+                : rbtree{
+                    other,
+                    allocator_type{
+                        allocator_traits<node_allocator_type>::select_on_container_copy_construction(
+                            other.node_allocator_
+                        )
+                    }
+                  }
+            { /* DUMMY BODY */ }
+
+            rbtree(const rbtree& other, const allocator_type& alloc)
+                : rbtree{other.key_compare_, alloc}
             {
-                for (const auto& x: other)
-                    insert(x);
+                insert_range(other.begin(), other.end());
             }
 
             rbtree(rbtree&& other)
                 : root_{other.root_}, size_{other.size_},
                   key_compare_{move(other.key_compare_)},
-                  key_extractor_{move(other.key_extractor_)}
+                  key_extractor_{move(other.key_extractor_)},
+                  node_allocator_{move(other.node_allocator_)},
+                  free_nodes_{other.free_nodes_}, free_count_{other.free_count_}
             {
                 other.root_ = nullptr;
                 other.size_ = size_type{};
+                other.free_nodes_ = nullptr;
+                other.free_count_ = size_type{};
+            }
+
+            rbtree(rbtree&& other, const allocator_type& alloc)
+                : rbtree{other.key_compare_, alloc}
+            {
+                if (node_allocator_ == other.node_allocator_)
+                    swap_contents_(other);
+                else
+                {
+                    // Different memory, move the elements one by one.
+                    insert_range(
+                        make_move_iterator(other.begin()),
+                        make_move_iterator(other.end())
+                    );
+                    other.clear();
+                }
             }
 
             rbtree& operator=(const rbtree& other)
             {
-                auto tmp{other};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                if constexpr (allocator_traits<node_allocator_type>::propagate_on_container_copy_assignment::value)
+                {
+                    if (node_allocator_ != other.node_allocator_)
+                    {
+                        // Our nodes cannot be reused with the new allocator.
+                        clear_(size_type{});
+                        purge_free_nodes_();
+                    }
+                    node_allocator_ = other.node_allocator_;
+                }
+
+                /**
+                 * The nodes of this tree are kept and reused
+                 * for the copies, so assigning a tree of
+                 * similar size does not allocate.
+                 */
+                key_compare_ = other.key_compare_;
+                clear_(other.size_);
+                insert_range(other.begin(), other.end());
+                trim_free_nodes_();
 
                 return *this;
             }
 
             rbtree& operator=(rbtree&& other)
             {
-                rbtree tmp{move(other)};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                if (aux::alloc_can_steal(node_allocator_, other.node_allocator_))
+                {
+                    rbtree tmp{move(other)};
+                    swap_contents_(tmp);
+                    if constexpr (allocator_traits<node_allocator_type>::propagate_on_container_move_assignment::value)
+                        swap_allocators_(tmp);
+                }
+                else
+                {
+                    // Different memory, reuse our nodes for the elements.
+                    key_compare_ = other.key_compare_;
+                    clear_(other.size_);
+                    insert_range(
+                        make_move_iterator(other.begin()),
+                        make_move_iterator(other.end())
+                    );
+                    other.clear();
+                    trim_free_nodes_();
+                }
 
                 return *this;
             }
 
+            ~rbtree()
+            {
+                clear_(size_type{});
+                purge_free_nodes_();
+            }
+
             bool empty() const noexcept
             {
                 return size_ == 0U;
@@ -107,14 +190,19 @@ namespace std::aux
                 return size_;
             }
 
-            size_type max_size(allocator_type& alloc)
+            size_type max_size() const noexcept
+            {
+                return allocator_traits<node_allocator_type>::max_size(node_allocator_);
+            }
+
+            allocator_type get_allocator() const noexcept
             {
-                return allocator_traits<allocator_type>::max_size(alloc);
+                return allocator_type{node_allocator_};
             }
 
             iterator begin()
             {
-                return iterator{find_smallest_(), false};
+                return iterator{find_smallest_(), empty()};
             }
 
             const_iterator begin() const
@@ -163,7 +251,7 @@ namespace std::aux
 
             const_iterator cbegin() const
             {
-                return const_iterator{find_smallest_(), false};
+                return const_iterator{find_smallest_(), empty()};
             }
 
             const_iterator cend() const
@@ -201,6 +289,87 @@ namespace std::aux
                 return Policy::insert(*this, forward<value_type>(val));
             }
 
+            /**
+             * Inserts a range, if the tree is empty the longest
+             * sorted prefix of the range is turned into a balanced
+             * tree in linear time and only the rest is inserted
+             * element by element.
+             */
+            template<class InputIterator>
+            void insert_range(InputIterator first, InputIterator last)
+            {
+                if (!empty())
+                {
+                    while (first != last)
+                        insert(*first++);
+
+                    return;
+                }
+
+                /**
+                 * The nodes are chained through their right
+                 * pointers, tail is the last node in the chain
+                 * and list_end the last node with its key (multi
+                 * containers keep equivalent keys in a list).
+                 */
+                node_type* head{};
+                node_type* tail{};
+                node_type* list_end{};
+                node_type* unsorted{};
+                size_type count{};
+
+                try
+                {
+                    while (first != last)
+                    {
+                        auto node = create_node_from_(first);
+                        ++first;
+
+                        if (!tail)
+                            head = node;
+                        else if (key_compare_(get_key(node->value), get_key(tail->value)))
+                        {
+                            unsorted = node;
+                            break;
+                        }
+                        else if (!key_compare_(get_key(tail->value), get_key(node->value)))
+                        {
+                            if (Policy::link_equivalent(*this, list_end, node))
+                            {
+                                list_end = node;
+                                ++size_;
+                            }
+
+                            continue;
+                        }
+                        else
+                            tail->right(node);
+
+                        tail = list_end = node;
+                        ++size_;
+                        ++count;
+                    }
+                }
+                catch (...)
+                {
+                    build_balanced_(head, count);
+                    throw;
+                }
+
+                build_balanced_(head, count);
+
+                if (unsorted)
+                {
+                    if (Policy::can_insert(*this, get_key(unsorted->value)))
+                        Policy::insert_extracted(*this, unsorted);
+                    else
+                        destroy_node(unsorted);
+
+                    while (first != last)
+                        insert(*first++);
+                }
+            }
+
             size_type erase(const key_type& key)
             {
                 return Policy::erase(*this, key);
@@ -222,22 +391,70 @@ namespace std::aux
 
             void clear() noexcept
             {
-                if (root_)
-                {
-                    delete root_;
-                    root_ = nullptr;
-                    size_ = size_type{};
-                }
+                clear_(max_free_nodes_);
             }
 
             void swap(rbtree& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(swap(declval<KeyComp&>(), declval<KeyComp&>())))
+                         noexcept(std::swap(declval<KeyComp&>(), declval<KeyComp&>())))
             {
-                std::swap(root_, other.root_);
-                std::swap(size_, other.size_);
-                std::swap(key_compare_, other.key_compare_);
-                std::swap(key_extractor_, other.key_extractor_);
+                swap_contents_(other);
+                if constexpr (allocator_traits<node_allocator_type>::propagate_on_container_swap::value)
+                    swap_allocators_(other);
+            }
+
+            /**
+             * Unlinks the node an iterator points to from
+             * the tree without destroying it, the caller
+             * takes ownership of the node.
+             */
+            node_type* extract(const_iterator it)
+            {
+                if (it == cend())
+                    return nullptr;
+
+                return detach_node_(const_cast<node_type*>(it.node()));
+            }
+
+            /**
+             * Inserts a node previously extracted from a tree
+             * using an equal allocator. If the key is already
+             * present in a unique tree, the caller keeps
+             * the ownership of the node.
+             */
+            auto insert_extracted(node_type* node)
+            {
+                return Policy::insert_extracted(*this, node);
+            }
+
+            /**
+             * Moves the elements whose keys are not in this tree
+             * yet (all elements for multi trees) from the source.
+             * Nodes are transfered if the trees use the same node
+             * type, otherwise the values are moved to new nodes.
+             */
+            template<class Tree>
+            void merge(Tree& source)
+            {
+                using source_node_type = typename Tree::node_type;
+
+                auto it = source.begin();
+                for (auto count = source.size(); count > 0; --count)
+                {
+                    auto current = it++;
+                    auto node = const_cast<source_node_type*>(current.node());
+
+                    if (!Policy::can_insert(*this, get_key(node->value)))
+                        continue;
+
+                    if constexpr (is_same_v<source_node_type, node_type>)
+                        Policy::insert_extracted(*this, source.extract(current));
+                    else
+                    {
+                        Policy::insert_extracted(*this, create_node(move(node->value)));
+                        source.erase(current);
+                    }
+                }
             }
 
             key_compare key_comp() const
@@ -353,6 +570,81 @@ namespace std::aux
                 if (!node)
                     return nullptr;
 
+                auto succ = node->successor();
+                destroy_node(detach_node_(node));
+
+                return succ;
+            }
+
+            void insert_node(node_type* node, node_type* parent)
+            {
+                Policy::insert(*this, node, parent);
+            }
+
+            template<class... Args>
+            node_type* create_node(Args&&... args)
+            {
+                node_type* node{};
+                if (free_nodes_)
+                {
+                    node = reinterpret_cast<node_type*>(free_nodes_);
+                    free_nodes_ = free_nodes_->next;
+                    --free_count_;
+                }
+                else
+                    node = allocator_traits<node_allocator_type>::allocate(node_allocator_, 1);
+
+                try
+                {
+                    new(static_cast<void*>(node)) node_type{forward<Args>(args)...};
+                }
+                catch (...)
+                {
+                    free_node_(node, max_free_nodes_);
+                    throw;
+                }
+
+                return node;
+            }
+
+            void destroy_node(node_type* node)
+            {
+                node->~node_type();
+                free_node_(node, max_free_nodes_);
+            }
+
+        private:
+            using node_allocator_type = typename allocator_traits<
+                allocator_type
+            >::template rebind_alloc<node_type>;
+
+            /**
+             * Memory of destroyed nodes is kept in a short
+             * free list, so that trees with many inserts and
+             * erases do not hit the allocator all the time.
+             */
+            struct free_node_t
+            {
+                free_node_t* next;
+            };
+
+            static constexpr size_type max_free_nodes_{64};
+
+            node_type* root_;
+            size_type size_;
+            key_compare key_compare_;
+            key_extract key_extractor_;
+            node_allocator_type node_allocator_;
+            free_node_t* free_nodes_;
+            size_type free_count_;
+
+            /**
+             * Unlinks a node from the tree and returns the node
+             * that can be destroyed or inserted elsewhere, which
+             * in multi containers is not always the one passed.
+             */
+            node_type* detach_node_(node_type* node)
+            {
                 --size_;
 
                 auto succ = node->successor();
@@ -361,21 +653,16 @@ namespace std::aux
                     /**
                      * This will kick in multi containers,
                      * we popped one node from a list of nodes
-                     * with equivalent keys and we can delete it
-                     * and return the successor which was the next
-                     * in the list.
+                     * with equivalent keys.
                      */
-                    delete tmp;
-
                     update_root_(succ); // Incase the first in list was root.
-                    return succ;
+                    return tmp;
                 }
-                else if (node == root_)
+                else if (node == root_ && !node->left() && !node->right())
                 { // Only executed if root_ is unique.
                     root_ = nullptr;
-                    delete node;
 
-                    return nullptr;
+                    return node;
                 }
 
                 if (node->left() && node->right())
@@ -388,7 +675,6 @@ namespace std::aux
                     // Also: If succ was nullptr, the swap
                     //       didn't do anything and we can
                     //       safely delete node.
-                    return delete_node(node);
                 }
 
                 auto child = node->right() ? node->right() : node->left();
@@ -397,7 +683,6 @@ namespace std::aux
                     // Simply remove the node.
                     // TODO: repair here too?
                     node->unlink();
-                    delete node;
                 }
                 else
                 {
@@ -407,30 +692,175 @@ namespace std::aux
                         child->parent()->left(child);
                     else if (node->is_right_child())
                         child->parent()->right(child);
-                    node->parent(nullptr);
-                    node->left(nullptr);
-                    node->right(nullptr);
 
                     // Repair if needed.
                     repair_after_erase_(node, child);
                     update_root_(child);
+                }
+
+                node->parent(nullptr);
+                node->left(nullptr);
+                node->right(nullptr);
 
-                    delete node;
+                return node;
+            }
+
+            template<class InputIterator>
+            node_type* create_node_from_(const InputIterator& it)
+            {
+                using reference = decltype(*it);
+
+                if constexpr (is_same_v<remove_cv_t<remove_reference_t<reference>>, value_type>)
+                    return create_node(*it);
+                else
+                    return create_node(value_type(*it));
+            }
+
+            /**
+             * Turns a chain of count nodes linked through their
+             * right pointers into a balanced tree.
+             */
+            void build_balanced_(node_type* head, size_type count)
+            {
+                root_ = build_subtree_(head, count);
+                if (root_)
+                {
+                    root_->parent(nullptr);
+                    root_->color = rbcolor::black;
                 }
+            }
 
-                return succ;
+            node_type* build_subtree_(node_type*& current, size_type count)
+            {
+                if (count == 0)
+                    return nullptr;
+
+                auto left = build_subtree_(current, count / 2);
+
+                auto node = current;
+                current = current->right();
+
+                node->left(left);
+                if (left)
+                    left->parent(node);
+
+                auto right = build_subtree_(current, count - count / 2 - 1);
+                node->right(right);
+                if (right)
+                    right->parent(node);
+
+                return node;
             }
 
-            void insert_node(node_type* node, node_type* parent)
+            void clear_(size_type keep) noexcept
             {
-                Policy::insert(*this, node, parent);
+                /**
+                 * The nodes are destroyed bottom up without
+                 * recursion, the tree can be deep as it is
+                 * not rebalanced. Up to keep nodes are put
+                 * to the free list for reuse.
+                 */
+                auto current = root_;
+                while (current)
+                {
+                    if (current->left())
+                        current = current->left();
+                    else if (current->right())
+                        current = current->right();
+                    else
+                    {
+                        auto parent = current->parent();
+                        if (parent && parent->left() == current)
+                            parent->left(nullptr);
+                        else if (parent)
+                            parent->right(nullptr);
+
+                        // Multi containers keep equivalent keys in a list.
+                        while (current)
+                        {
+                            auto next = current->next();
+                            current->~node_type();
+                            free_node_(current, keep);
+                            current = next;
+                        }
+
+                        current = parent;
+                    }
+                }
+
+                root_ = nullptr;
+                size_ = size_type{};
             }
 
-        private:
-            node_type* root_;
-            size_type size_;
-            key_compare key_compare_;
-            key_extract key_extractor_;
+
+            /**
+             * Gives the memory of a destroyed node back,
+             * it is kept for reuse if the free list has
+             * less than keep nodes.
+             */
+            void free_node_(node_type* node, size_type keep) noexcept
+            {
+                if (free_count_ < keep)
+                {
+                    free_nodes_ = new(static_cast<void*>(node)) free_node_t{free_nodes_};
+                    ++free_count_;
+                }
+                else
+                    allocator_traits<node_allocator_type>::deallocate(node_allocator_, node, 1);
+            }
+
+            void trim_free_nodes_() noexcept
+            {
+                while (free_count_ > max_free_nodes_)
+                {
+                    auto node = free_nodes_;
+                    free_nodes_ = node->next;
+                    --free_count_;
+
+                    allocator_traits<node_allocator_type>::deallocate(
+                        node_allocator_, reinterpret_cast<node_type*>(node), 1
+                    );
+                }
+            }
+
+            void purge_free_nodes_() noexcept
+            {
+                while (free_nodes_)
+                {
+                    auto node = free_nodes_;
+                    free_nodes_ = node->next;
+
+                    allocator_traits<node_allocator_type>::deallocate(
+                        node_allocator_, reinterpret_cast<node_type*>(node), 1
+                    );
+                }
+
+                free_count_ = size_type{};
+            }
+
+            /**
+             * The free list belongs to the allocator
+             * its nodes came from, so it goes with it.
+             */
+            void swap_allocators_(rbtree& other)
+            {
+                std::swap(node_allocator_, other.node_allocator_);
+                std::swap(free_nodes_, other.free_nodes_);
+                std::swap(free_count_, other.free_count_);
+            }
+
+            /**
+             * Swaps everything but the allocators, the caller
+             * makes sure that the nodes of both trees can be
+             * destroyed with the allocator they end up with.
+             */
+            void swap_contents_(rbtree& other)
+            {
+                std::swap(root_, other.root_);
+                std::swap(size_, other.size_);
+                std::swap(key_compare_, other.key_compare_);
+                std::swap(key_extractor_, other.key_extractor_);
+            }
 
             node_type* find_(const key_type& key) const
             {
@@ -448,6 +878,48 @@ namespace std::aux
                 return nullptr;
             }
 
+            /**
+             * Returns the first node whose key is not less
+             * (lower bound) or greater (upper bound) than key.
+             * In multi trees this is the head of a list, which
+             * comes first among its equivalent keys.
+             */
+            node_type* lower_bound_(const key_type& key) const
+            {
+                node_type* res{};
+                auto current = root_;
+                while (current)
+                {
+                    if (key_compare_(key_extractor_(current->value), key))
+                        current = current->right();
+                    else
+                    {
+                        res = current;
+                        current = current->left();
+                    }
+                }
+
+                return res;
+            }
+
+            node_type* upper_bound_(const key_type& key) const
+            {
+                node_type* res{};
+                auto current = root_;
+                while (current)
+                {
+                    if (key_compare_(key, key_extractor_(current->value)))
+                    {
+                        res = current;
+                        current = current->left();
+                    }
+                    else
+                        current = current->right();
+                }
+
+                return res;
+            }
+
             node_type* find_smallest_() const
             {
                 if (root_)
@@ -212,6 +212,35 @@ namespace std::aux
             if (!node1 || !node2)
                 return;
 
+            if (node1->parent() == node2)
+                std::swap(node1, node2);
+
+            if (node2->parent() == node1)
+            {
+                /**
+                 * The general case below would make node1
+                 * its own parent when the nodes are adjacent.
+                 */
+                auto parent1 = node1->parent();
+                auto left1 = node1->left();
+                auto right1 = node1->right();
+                auto is_right1 = is_right_child(node1);
+                auto is_right2 = (right1 == node2);
+
+                auto left2 = node2->left();
+                auto right2 = node2->right();
+
+                assimilate(
+                    node2, parent1,
+                    is_right2 ? left1 : node1,
+                    is_right2 ? node1 : right1,
+                    is_right1
+                );
+                assimilate(node1, node2, left2, right2, is_right2);
+
+                return;
+            }
+
             auto parent1 = node1->parent();
             auto left1 = node1->left();
             auto right1 = node1->right();
@@ -410,13 +439,9 @@ namespace std::aux
                 return this;
             }
 
-            ~rbtree_single_node()
+            rbtree_single_node* next() const
             {
-                parent_ = nullptr;
-                if (left_)
-                    delete left_;
-                if (right_)
-                    delete right_;
+                return nullptr;
             }
 
         private:
@@ -557,10 +582,15 @@ namespace std::aux
 
             const rbtree_multi_node* successor() const
             {
+                /**
+                 * The tree links of our parent point
+                 * to the head of the list, so we have
+                 * to move in the tree from there.
+                 */
                 if (next_)
                     return next_;
                 else
-                    return utils::successor(this);
+                    return utils::successor(first_);
             }
 
             rbtree_multi_node* predecessor()
@@ -620,19 +650,39 @@ namespace std::aux
                  * update then list and return this
                  * for deletion.
                  */
-                if (next_)
+                if (first_ != this)
+                {
+                    /**
+                     * Not the head of the list, the tree
+                     * does not point to us so we just
+                     * remove ourselves from the list.
+                     */
+                    auto tmp = first_;
+                    while (tmp->next_ != this)
+                        tmp = tmp->next_;
+                    tmp->next_ = next_;
+
+                    parent_ = nullptr;
+                    left_ = nullptr;
+                    right_ = nullptr;
+                    next_ = nullptr;
+                    first_ = this;
+
+                    return this;
+                }
+                else if (next_)
                 {
                     // Make next the new this.
                     next_->first_ = next_;
                     if (is_left_child())
-                        parent_->left_ = next_;
+                        parent_->left(next_);
                     else if (is_right_child())
-                        parent_->right_ = next_;
+                        parent_->right(next_);
 
                     if (left_)
-                        left_->parent_ = next_;
+                        left_->parent(next_);
                     if (right_)
-                        right_->parent_ = next_;
+                        right_->parent(next_);
 
                     /**
                      * Update the first_ pointer
@@ -646,16 +696,17 @@ namespace std::aux
                     }
 
                     /**
-                     * Otherwise destructor could
-                     * destroy them.
+                     * The node can be extracted and
+                     * inserted again, so it has to look
+                     * like a freshly created one.
                      */
                     parent_ = nullptr;
                     left_ = nullptr;
                     right_ = nullptr;
                     next_ = nullptr;
-                    first_ = nullptr;
+                    first_ = this;
 
-                    return this; // This will get deleted.
+                    return this; // This will get deleted or extracted.
                 }
                 else
                     return nullptr;
@@ -664,9 +715,9 @@ namespace std::aux
             void unlink()
             {
                 if (is_left_child())
-                    parent_->left_ = nullptr;
+                    parent_->left(nullptr);
                 else if (is_right_child())
-                    parent_->right_ = nullptr;
+                    parent_->right(nullptr);
             }
 
             void add(rbtree_multi_node* node)
@@ -704,15 +755,9 @@ namespace std::aux
                 }
             }
 
-            ~rbtree_multi_node()
+            rbtree_multi_node* next() const
             {
-                parent_ = nullptr;
-                if (left_)
-                    delete left_;
-                if (right_)
-                    delete right_;
-
-                // TODO: delete the list
+                return next_;
             }
 
         private:
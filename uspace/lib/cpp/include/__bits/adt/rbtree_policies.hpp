@@ -69,33 +69,11 @@ namespace std::aux
         template<class Tree, class Key>
         static typename Tree::const_iterator lower_bound_const(const Tree& tree, const Key& key)
         {
-            using const_iterator = typename Tree::const_iterator;
-
-            auto node = tree.find_parent_for_insertion(key);
-            const_iterator it{node, false};
-            auto beg = tree.begin();
-            auto end = tree.end();
-
-            if (tree.key_compare_(tree.get_key(*it), key))
-            {
-                // Predecessor.
-                if (it != end)
-                    return ++it;
-                else
-                    return it;
-            }
-            else if (tree.key_compare_(key, tree.get_key(*it)))
-            {
-                // Successor.
-                if (it != beg)
-                    return --it;
-                else
-                    return it;
-            }
-            else // Perfect match.
-                return it;
-
-            return it;
+            auto node = tree.lower_bound_(key);
+            if (node)
+                return typename Tree::const_iterator{node, false};
+            else
+                return tree.cend();
         }
 
         template<class Tree, class Key>
@@ -112,18 +90,11 @@ namespace std::aux
         template<class Tree, class Key>
         static typename Tree::const_iterator upper_bound_const(const Tree& tree, const Key& key)
         {
-            /**
-             * If key isn't in the tree, we get it's
-             * predecessor or tree.end(). If key is
-             * in the tree, we get it. So unless it
-             * is equal to end(), we can increment it
-             * to get the upper bound.
-             */
-            auto it = lower_bound_const(tree, key);
-            if (it == tree.end())
-                return it;
+            auto node = tree.upper_bound_(key);
+            if (node)
+                return typename Tree::const_iterator{node, false};
             else
-                return ++it;
+                return tree.cend();
         }
 
         template<class Tree, class Key>
@@ -164,7 +135,6 @@ namespace std::aux
         {
             using value_type = typename Tree::value_type;
             using iterator   = typename Tree::iterator;
-            using node_type  = typename Tree::node_type;
 
             auto val = value_type{forward<Args>(args)...};
             auto parent = tree.find_parent_for_insertion(tree.get_key(val));
@@ -172,7 +142,7 @@ namespace std::aux
             if (parent && tree.keys_equal(tree.get_key(parent->value), tree.get_key(val)))
                 return make_pair(iterator{parent, false}, false);
 
-            auto node = new node_type{move(val)};
+            auto node = tree.create_node(move(val));
 
             return insert(tree, node, parent);
         }
@@ -183,13 +153,12 @@ namespace std::aux
         > insert(Tree& tree, const Value& val)
         {
             using iterator  = typename Tree::iterator;
-            using node_type = typename Tree::node_type;
 
             auto parent = tree.find_parent_for_insertion(tree.get_key(val));
             if (parent && tree.keys_equal(tree.get_key(parent->value), tree.get_key(val)))
                 return make_pair(iterator{parent, false}, false);
 
-            auto node = new node_type{val};
+            auto node = tree.create_node(val);
 
             return insert(tree, node, parent);
         }
@@ -200,13 +169,12 @@ namespace std::aux
         > insert(Tree& tree, Value&& val)
         {
             using iterator  = typename Tree::iterator;
-            using node_type = typename Tree::node_type;
 
             auto parent = tree.find_parent_for_insertion(tree.get_key(val));
             if (parent && tree.keys_equal(tree.get_key(parent->value), tree.get_key(val)))
                 return make_pair(iterator{parent, false}, false);
 
-            auto node = new node_type{forward<Value>(val)};
+            auto node = tree.create_node(forward<Value>(val));
 
             return insert(tree, node, parent);
         }
@@ -243,6 +211,42 @@ namespace std::aux
 
             return make_pair(iterator{node, false}, true);
         }
+
+        template<class Tree>
+        static pair<
+            typename Tree::iterator, bool
+        > insert_extracted(Tree& tree, typename Tree::node_type* node)
+        {
+            using iterator  = typename Tree::iterator;
+
+            auto parent = tree.find_parent_for_insertion(tree.get_key(node->value));
+            if (parent && tree.keys_equal(tree.get_key(parent->value), tree.get_key(node->value)))
+                return make_pair(iterator{parent, false}, false);
+
+            return insert(tree, node, parent);
+        }
+
+        template<class Tree, class Key>
+        static bool can_insert(const Tree& tree, const Key& key)
+        {
+            return tree.find_(key) == nullptr;
+        }
+
+        /**
+         * Called when building a tree from a sorted range
+         * and node has the same key as last, the first
+         * of the equivalent values is kept.
+         */
+        template<class Tree>
+        static bool link_equivalent(
+            Tree& tree, typename Tree::node_type*,
+            typename Tree::node_type* node
+        )
+        {
+            tree.destroy_node(node);
+
+            return false;
+        }
     };
 
     struct rbtree_multi_policy
@@ -298,30 +302,11 @@ namespace std::aux
         template<class Tree, class Key>
         static typename Tree::const_iterator lower_bound_const(const Tree& tree, const Key& key)
         {
-            using const_iterator = typename Tree::const_iterator;
-
-            auto node = tree.find_parent_for_insertion(key);
-            const_iterator it{node, false};
-            auto beg = tree.begin();
-            auto end = tree.end();
-
-            if (tree.keys_comp(key, *it))
-                --it; // Incase we are on a successor.
-            while (tree.keys_equal(tree.get_key(*it), key) && it != beg)
-                --it; // Skip keys that are equal.
-            if (it != beg)
-                ++it; // If we moved all the way to the start, key is the smallest.
-
-            if (tree.key_compare_(tree.get_key(*it), key))
-            {
-                // Predecessor.
-                if (it != end)
-                    return ++it;
-                else
-                    return it;
-            }
-
-            return it;
+            auto node = tree.lower_bound_(key);
+            if (node)
+                return typename Tree::const_iterator{node, false};
+            else
+                return tree.cend();
         }
 
         template<class Tree, class Key>
@@ -337,25 +322,11 @@ namespace std::aux
         template<class Tree, class Key>
         static typename Tree::const_iterator upper_bound_const(const Tree& tree, const Key& key)
         {
-            /**
-             * If key isn't in the tree, we get it's
-             * predecessor or tree.end(). If key is
-             * in the tree, we get it. So unless it
-             * is equal to end(), we keep incrementing
-             * until we get to the next key.
-             */
-            auto it = lower_bound(tree, key);
-            if (it == tree.end())
-                return it;
-            else if (tree.keys_equal(tree.get_key(*it), key))
-            {
-                while (it != tree.end() && tree.keys_equal(tree.get_key(*it), key))
-                    ++it;
-
-                return it;
-            }
-
-            return it;
+            auto node = tree.upper_bound_(key);
+            if (node)
+                return typename Tree::const_iterator{node, false};
+            else
+                return tree.cend();
         }
 
         template<class Tree, class Key>
@@ -385,9 +356,7 @@ namespace std::aux
         template<class Tree, class... Args>
         static typename Tree::iterator emplace(Tree& tree, Args&&... args)
         {
-            using node_type  = typename Tree::node_type;
-
-            auto node = new node_type{forward<Args>(args)...};
+            auto node = tree.create_node(forward<Args>(args)...);
 
             return insert(tree, node);
         }
@@ -395,9 +364,7 @@ namespace std::aux
         template<class Tree, class Value>
         static typename Tree::iterator insert(Tree& tree, const Value& val)
         {
-            using node_type = typename Tree::node_type;
-
-            auto node = new node_type{val};
+            auto node = tree.create_node(val);
 
             return insert(tree, node);
         }
@@ -405,9 +372,7 @@ namespace std::aux
         template<class Tree, class Value>
         static typename Tree::iterator insert(Tree& tree, Value&& val)
         {
-            using node_type = typename Tree::node_type;
-
-            auto node = new node_type{forward<Value>(val)};
+            auto node = tree.create_node(forward<Value>(val));
 
             return insert(tree, node);
         }
@@ -451,6 +416,36 @@ namespace std::aux
 
             return iterator{node, false};
         }
+
+        template<class Tree>
+        static typename Tree::iterator insert_extracted(
+            Tree& tree, typename Tree::node_type* node
+        )
+        {
+            return insert(tree, node);
+        }
+
+        template<class Tree, class Key>
+        static bool can_insert(const Tree&, const Key&)
+        {
+            return true;
+        }
+
+        /**
+         * Called when building a tree from a sorted range
+         * and node has the same key as last, which is the
+         * last node in the list of equivalent keys.
+         */
+        template<class Tree>
+        static bool link_equivalent(
+            Tree&, typename Tree::node_type* last,
+            typename Tree::node_type* node
+        )
+        {
+            last->add(node);
+
+            return true;
+        }
     };
 }
 
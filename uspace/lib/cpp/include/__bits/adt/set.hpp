@@ -29,7 +29,9 @@
 #ifndef LIBCPP_BITS_ADT_SET
 #define LIBCPP_BITS_ADT_SET
 
+#include <__bits/adt/node_handle.hpp>
 #include <__bits/adt/rbtree.hpp>
+#include <__bits/memory/memory_resource_fwd.hpp>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -37,6 +39,9 @@
 
 namespace std
 {
+    template<class Key, class Compare, class Alloc>
+    class multiset;
+
     /**
      * 23.4.6, class template set:
      */
@@ -61,28 +66,35 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_single_node<value_type>;
+        private:
+            using tree_node_type = aux::rbtree_single_node<value_type>;
 
+        public:
             /**
              * Note: Both the iterator and const_iterator (and their local variants)
              *       types are constant iterators, the standard does not require them
              *       to be the same type, but why not? :)
              */
             using iterator             = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
             using const_iterator       = iterator;
 
             using reverse_iterator       = std::reverse_iterator<iterator>;
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+            using node_type = aux::set_node_handle<
+                value_type, tree_node_type, allocator_type
+            >;
+            using insert_return_type = aux::node_insert_return<iterator, node_type>;
+
             set()
                 : set{key_compare{}}
             { /* DUMMY BODY */ }
 
             explicit set(const key_compare& comp,
                          const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -95,23 +107,23 @@ namespace std
             }
 
             set(const set& other)
-                : set{other, other.allocator_}
+                : tree_{other.tree_}
             { /* DUMMY BODY */ }
 
             set(set&& other)
-                : tree_{move(other.tree_)}, allocator_{move(other.allocator_)}
+                : tree_{move(other.tree_)}
             { /* DUMMY BODY */ }
 
             explicit set(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}
             { /* DUMMY BODY */ }
 
             set(const set& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}
             { /* DUMMY BODY */ }
 
             set(set&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}
             { /* DUMMY BODY */ }
 
             set(initializer_list<value_type> init,
@@ -139,7 +151,6 @@ namespace std
             set& operator=(const set& other)
             {
                 tree_ = other.tree_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -149,7 +160,6 @@ namespace std
                          is_nothrow_move_assignable<key_compare>::value)
             {
                 tree_ = move(other.tree_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -165,7 +175,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return tree_.get_allocator();
             }
 
             iterator begin() noexcept
@@ -240,7 +250,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return tree_.max_size(allocator_);
+                return tree_.max_size();
             }
 
             template<class... Args>
@@ -278,8 +288,7 @@ namespace std
             template<class InputIterator>
             void insert(InputIterator first, InputIterator last)
             {
-                while (first != last)
-                    insert(*first++);
+                tree_.insert_range(first, last);
             }
 
             void insert(initializer_list<value_type> init)
@@ -309,10 +318,9 @@ namespace std
 
             void swap(set& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(std::swap(declval<key_compare>(), declval<key_compare>())))
+                         noexcept(std::swap(declval<key_compare&>(), declval<key_compare&>())))
             {
                 tree_.swap(other.tree_);
-                std::swap(allocator_, other.allocator_);
             }
 
             void clear() noexcept
@@ -320,6 +328,65 @@ namespace std
                 tree_.clear();
             }
 
+            node_type extract(const_iterator position)
+            {
+                return node_type{tree_.extract(position), get_allocator()};
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+
+                return extract(it);
+            }
+
+            insert_return_type insert(node_type&& node)
+            {
+                if (!node)
+                    return insert_return_type{end(), false, node_type{}};
+
+                auto res = tree_.insert_extracted(node.node());
+                if (res.second)
+                {
+                    node.release();
+
+                    return insert_return_type{res.first, true, node_type{}};
+                }
+                else
+                    return insert_return_type{res.first, false, move(node)};
+            }
+
+            iterator insert(const_iterator, node_type&& node)
+            {
+                return insert(move(node)).position;
+            }
+
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -461,11 +528,16 @@ namespace std
                 key_type, key_type, aux::key_no_value_key_extractor<key_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_single_policy, node_type
+                aux::rbtree_single_policy, tree_node_type
             >;
 
             tree_type tree_;
-            allocator_type allocator_;
+
+            template<class, class, class>
+            friend class set;
+
+            template<class, class, class>
+            friend class multiset;
 
             template<class K, class C, class A>
             friend bool operator==(const set<K, C, A>&,
@@ -542,28 +614,34 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_multi_node<value_type>;
+        private:
+            using tree_node_type = aux::rbtree_multi_node<value_type>;
 
+        public:
             /**
              * Note: Both the iterator and const_iterator types are constant
              *       iterators, the standard does not require them
              *       to be the same type, but why not? :)
              */
             using iterator             = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
             using const_iterator       = iterator;
 
             using reverse_iterator       = std::reverse_iterator<iterator>;
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+            using node_type = aux::set_node_handle<
+                value_type, tree_node_type, allocator_type
+            >;
+
             multiset()
                 : multiset{key_compare{}}
             { /* DUMMY BODY */ }
 
             explicit multiset(const key_compare& comp,
                               const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -576,23 +654,23 @@ namespace std
             }
 
             multiset(const multiset& other)
-                : multiset{other, other.allocator_}
+                : tree_{other.tree_}
             { /* DUMMY BODY */ }
 
             multiset(multiset&& other)
-                : tree_{move(other.tree_)}, allocator_{move(other.allocator_)}
+                : tree_{move(other.tree_)}
             { /* DUMMY BODY */ }
 
             explicit multiset(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}
             { /* DUMMY BODY */ }
 
             multiset(const multiset& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}
             { /* DUMMY BODY */ }
 
             multiset(multiset&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}
             { /* DUMMY BODY */ }
 
             multiset(initializer_list<value_type> init,
@@ -620,7 +698,6 @@ namespace std
             multiset& operator=(const multiset& other)
             {
                 tree_ = other.tree_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -630,7 +707,6 @@ namespace std
                          is_nothrow_move_assignable<key_compare>::value)
             {
                 tree_ = move(other.tree_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -646,7 +722,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return tree_.get_allocator();
             }
 
             iterator begin() noexcept
@@ -721,7 +797,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return tree_.max_size(allocator_);
+                return tree_.max_size();
             }
 
             template<class... Args>
@@ -759,8 +835,7 @@ namespace std
             template<class InputIterator>
             void insert(InputIterator first, InputIterator last)
             {
-                while (first != last)
-                    insert(*first++);
+                tree_.insert_range(first, last);
             }
 
             void insert(initializer_list<value_type> init)
@@ -790,10 +865,9 @@ namespace std
 
             void swap(multiset& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(std::swap(declval<key_compare>(), declval<key_compare>())))
+                         noexcept(std::swap(declval<key_compare&>(), declval<key_compare&>())))
             {
                 tree_.swap(other.tree_);
-                std::swap(allocator_, other.allocator_);
             }
 
             void clear() noexcept
@@ -801,6 +875,57 @@ namespace std
                 tree_.clear();
             }
 
+            node_type extract(const_iterator position)
+            {
+                return node_type{tree_.extract(position), get_allocator()};
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+
+                return extract(it);
+            }
+
+            iterator insert(node_type&& node)
+            {
+                if (!node)
+                    return end();
+
+                return tree_.insert_extracted(node.release());
+            }
+
+            iterator insert(const_iterator, node_type&& node)
+            {
+                return insert(move(node));
+            }
+
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>& source)
+            {
+                tree_.merge(source.tree_);
+            }
+
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>&& source)
+            {
+                merge(source);
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -942,11 +1067,16 @@ namespace std
                 key_type, key_type, aux::key_no_value_key_extractor<key_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_multi_policy, node_type
+                aux::rbtree_multi_policy, tree_node_type
             >;
 
             tree_type tree_;
-            allocator_type allocator_;
+
+            template<class, class, class>
+            friend class set;
+
+            template<class, class, class>
+            friend class multiset;
 
             template<class K, class C, class A>
             friend bool operator==(const multiset<K, C, A>&,
@@ -1000,4 +1130,13 @@ namespace std
     }
 }
 
+namespace std::pmr
+{
+    template<class Key, class Compare = less<Key>>
+    using set = std::set<Key, Compare, polymorphic_allocator<Key>>;
+
+    template<class Key, class Compare = less<Key>>
+    using multiset = std::multiset<Key, Compare, polymorphic_allocator<Key>>;
+}
+
 #endif
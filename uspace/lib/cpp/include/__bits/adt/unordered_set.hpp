@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_UNORDERED_SET
 
 #include <__bits/adt/hash_table.hpp>
+#include <__bits/memory/memory_resource_fwd.hpp>
 #include <initializer_list>
 #include <functional>
 #include <memory>
@@ -90,7 +91,7 @@ namespace std
                                    const hasher& hf = hasher{},
                                    const key_equal& eql = key_equal{},
                                    const allocator_type& alloc = allocator_type{})
-                : table_{bucket_count, hf, eql}, allocator_{alloc}
+                : table_{bucket_count, hf, eql, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -105,23 +106,23 @@ namespace std
             }
 
             unordered_set(const unordered_set& other)
-                : unordered_set{other, other.allocator_}
+                : table_{other.table_}
             { /* DUMMY BODY */ }
 
             unordered_set(unordered_set&& other)
-                : table_{move(other.table_)}, allocator_{move(other.allocator_)}
+                : table_{move(other.table_)}
             { /* DUMMY BODY */ }
 
             explicit unordered_set(const allocator_type& alloc)
-                : table_{default_bucket_count_}, allocator_{alloc}
+                : table_{default_bucket_count_, alloc}
             { /* DUMMY BODY */ }
 
             unordered_set(const unordered_set& other, const allocator_type& alloc)
-                : table_{other.table_}, allocator_{alloc}
+                : table_{other.table_, alloc}
             { /* DUMMY BODY */ }
 
             unordered_set(unordered_set&& other, const allocator_type& alloc)
-                : table_{move(other.table_)}, allocator_{alloc}
+                : table_{move(other.table_), alloc}
             { /* DUMMY BODY */ }
 
             unordered_set(initializer_list<value_type> init,
@@ -170,7 +171,6 @@ namespace std
             unordered_set& operator=(const unordered_set& other)
             {
                 table_ = other.table_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -181,7 +181,6 @@ namespace std
                          is_nothrow_move_assignable<key_equal>::value)
             {
                 table_ = move(other.table_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -198,7 +197,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return table_.get_allocator();
             }
 
             bool empty() const noexcept
@@ -213,7 +212,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return table_.max_size(allocator_);
+                return table_.max_size();
             }
 
             iterator begin() noexcept
@@ -318,11 +317,10 @@ namespace std
 
             void swap(unordered_set& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(std::swap(declval<hasher>(), declval<hasher>())) &&
-                         noexcept(std::swap(declval<key_equal>(), declval<key_equal>())))
+                         noexcept(std::swap(declval<hasher&>(), declval<hasher&>())) &&
+                         noexcept(std::swap(declval<key_equal&>(), declval<key_equal&>())))
             {
                 table_.swap(other.table_);
-                std::swap(allocator_, other.allocator_);
             }
 
             hasher hash_function() const
@@ -444,7 +442,6 @@ namespace std
             >;
 
             table_type table_;
-            allocator_type allocator_;
 
             static constexpr size_type default_bucket_count_{16};
 
@@ -506,7 +503,7 @@ namespace std
                                         const hasher& hf = hasher{},
                                         const key_equal& eql = key_equal{},
                                         const allocator_type& alloc = allocator_type{})
-                : table_{bucket_count, hf, eql}, allocator_{alloc}
+                : table_{bucket_count, hf, eql, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -521,23 +518,23 @@ namespace std
             }
 
             unordered_multiset(const unordered_multiset& other)
-                : unordered_multiset{other, other.allocator_}
+                : table_{other.table_}
             { /* DUMMY BODY */ }
 
             unordered_multiset(unordered_multiset&& other)
-                : table_{move(other.table_)}, allocator_{move(other.allocator_)}
+                : table_{move(other.table_)}
             { /* DUMMY BODY */ }
 
             explicit unordered_multiset(const allocator_type& alloc)
-                : table_{default_bucket_count_}, allocator_{alloc}
+                : table_{default_bucket_count_, alloc}
             { /* DUMMY BODY */ }
 
             unordered_multiset(const unordered_multiset& other, const allocator_type& alloc)
-                : table_{other.table_}, allocator_{alloc}
+                : table_{other.table_, alloc}
             { /* DUMMY BODY */ }
 
             unordered_multiset(unordered_multiset&& other, const allocator_type& alloc)
-                : table_{move(other.table_)}, allocator_{alloc}
+                : table_{move(other.table_), alloc}
             { /* DUMMY BODY */ }
 
             unordered_multiset(initializer_list<value_type> init,
@@ -586,7 +583,6 @@ namespace std
             unordered_multiset& operator=(const unordered_multiset& other)
             {
                 table_ = other.table_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -597,7 +593,6 @@ namespace std
                          is_nothrow_move_assignable<key_equal>::value)
             {
                 table_ = move(other.table_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -614,7 +609,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return table_.get_allocator();
             }
 
             bool empty() const noexcept
@@ -629,7 +624,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return table_.max_size(allocator_);
+                return table_.max_size();
             }
 
             iterator begin() noexcept
@@ -734,11 +729,10 @@ namespace std
 
             void swap(unordered_multiset& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(std::swap(declval<hasher>(), declval<hasher>())) &&
-                         noexcept(std::swap(declval<key_equal>(), declval<key_equal>())))
+                         noexcept(std::swap(declval<hasher&>(), declval<hasher&>())) &&
+                         noexcept(std::swap(declval<key_equal&>(), declval<key_equal&>())))
             {
                 table_.swap(other.table_);
-                std::swap(allocator_, other.allocator_);
             }
 
             hasher hash_function() const
@@ -860,7 +854,6 @@ namespace std
             >;
 
             table_type table_;
-            allocator_type allocator_;
 
             static constexpr size_type default_bucket_count_{16};
 
@@ -914,4 +907,25 @@ namespace std
     }
 }
 
+namespace std::pmr
+{
+    template<
+        class Key,
+        class Hash = hash<Key>,
+        class Pred = equal_to<Key>
+    >
+    using unordered_set = std::unordered_set<
+        Key, Hash, Pred, polymorphic_allocator<Key>
+    >;
+
+    template<
+        class Key,
+        class Hash = hash<Key>,
+        class Pred = equal_to<Key>
+    >
+    using unordered_multiset = std::unordered_multiset<
+        Key, Hash, Pred, polymorphic_allocator<Key>
+    >;
+}
+
 #endif
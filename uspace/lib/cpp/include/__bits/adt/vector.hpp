@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_ADT_VECTOR
 #define LIBCPP_BITS_ADT_VECTOR
 
+#include <__bits/memory/memory_resource_fwd.hpp>
 #include <algorithm>
 #include <initializer_list>
 #include <iterator>
@@ -95,7 +96,9 @@ namespace std
 
             vector(const vector& other)
                 : data_{nullptr}, size_{other.size_}, capacity_{other.capacity_},
-                  allocator_{other.allocator_}
+                  allocator_{allocator_traits<Allocator>::select_on_container_copy_construction(
+                      other.allocator_
+                  )}
             {
                 data_ = allocator_.allocate(capacity_);
 
@@ -122,6 +125,31 @@ namespace std
                     data_[i] = other.data_[i];
             }
 
+            vector(vector&& other, const Allocator& alloc)
+                : data_{nullptr}, size_{}, capacity_{}, allocator_{alloc}
+            {
+                if (allocator_ == other.allocator_)
+                {
+                    std::swap(data_, other.data_);
+                    std::swap(size_, other.size_);
+                    std::swap(capacity_, other.capacity_);
+                }
+                else if (other.size_ > 0)
+                {
+                    // Different memory, move the elements one by one.
+                    data_ = allocator_.allocate(other.size_);
+                    capacity_ = other.size_;
+
+                    for (; size_ < other.size_; ++size_)
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, data_ + size_, move(other.data_[size_])
+                        );
+                    }
+                    other.clear();
+                }
+            }
+
             vector(initializer_list<T> init, const Allocator& alloc = Allocator{})
                 : data_{nullptr}, size_{init.size()}, capacity_{init.size()},
                   allocator_{alloc}
@@ -142,7 +170,24 @@ namespace std
 
             vector& operator=(const vector& other)
             {
-                vector tmp{other};
+                if (this == &other)
+                    return *this;
+
+                if constexpr (allocator_traits<Allocator>::propagate_on_container_copy_assignment::value)
+                {
+                    if (allocator_ != other.allocator_)
+                    {
+                        // Our memory has to go back to our allocator.
+                        clear();
+                        if (data_)
+                            allocator_.deallocate(data_, capacity_);
+                        data_ = nullptr;
+                        capacity_ = size_type{};
+                    }
+                }
+                aux::alloc_propagate_copy(allocator_, other.allocator_);
+
+                vector tmp{other, allocator_};
                 swap(tmp);
 
                 return *this;
@@ -152,6 +197,17 @@ namespace std
                 noexcept(allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
                          allocator_traits<Allocator>::is_always_equal::value)
             {
+                if (this == &other)
+                    return *this;
+
+                if (!aux::alloc_can_steal(allocator_, other.allocator_))
+                {
+                    vector tmp{move(other), allocator_};
+                    swap(tmp);
+
+                    return *this;
+                }
+
                 if (data_)
                     allocator_.deallocate(data_, capacity_);
 
@@ -159,12 +215,11 @@ namespace std
                 data_ = other.data_;
                 size_ = other.size_;
                 capacity_ = other.capacity_;
-                allocator_ = move(other.allocator_);
+                aux::alloc_propagate_move(allocator_, other.allocator_);
 
                 other.data_ = nullptr;
                 other.size_ = size_type{};
                 other.capacity_ = size_type{};
-                other.allocator_ = allocator_type{};
                 return *this;
             }
 
@@ -179,7 +234,7 @@ namespace std
             template<class InputIterator>
             void assign(InputIterator first, InputIterator last)
             {
-                vector tmp{first, last};
+                vector tmp{first, last, allocator_};
                 swap(tmp);
             }
 
@@ -187,13 +242,13 @@ namespace std
             {
                 // Parenthesies required to avoid initializer list
                 // construction.
-                vector tmp(size, val);
+                vector tmp(size, val, allocator_);
                 swap(tmp);
             }
 
             void assign(initializer_list<T> init)
             {
-                vector tmp{init};
+                vector tmp{init, allocator_};
                 swap(tmp);
             }
 
@@ -274,16 +329,25 @@ namespace std
 
             void resize(size_type sz)
             {
-                resize_with_copy_(size_, capacity_);
+                resize_with_copy_(sz, max(sz, capacity_));
             }
 
             void resize(size_type sz, const value_type& val)
             {
-                auto old_size = size_;
-                resize_with_copy_(sz, capacity_);
-
-                for (size_type i = old_size - 1; i < size_; ++i)
-                    data_[i] = val;
+                if (sz <= size_)
+                    resize_with_copy_(sz, capacity_);
+                else
+                {
+                    reserve(sz);
+
+                    while (size_ < sz)
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, data_ + size_, val
+                        );
+                        ++size_;
+                    }
+                }
             }
 
             size_type capacity() const noexcept
@@ -377,22 +441,19 @@ namespace std
 
                 allocator_traits<Allocator>::construct(allocator_,
                                                        begin() + size_, forward<Args>(args)...);
+                ++size_;
 
                 return back();
             }
 
             void push_back(const T& x)
             {
-                if (size_ >= capacity_)
-                    resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = x;
+                emplace_back(x);
             }
 
             void push_back(T&& x)
             {
-                if (size_ >= capacity_)
-                    resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = forward<T>(x);
+                emplace_back(forward<T>(x));
             }
 
             void pop_back()
@@ -492,6 +553,7 @@ namespace std
                 std::swap(data_, other.data_);
                 std::swap(size_, other.size_);
                 std::swap(capacity_, other.capacity_);
+                aux::alloc_propagate_swap(allocator_, other.allocator_);
             }
 
             void clear() noexcept
@@ -517,26 +579,44 @@ namespace std
                 capacity_ = capacity;
             }
 
+            /**
+             * Note: Elements are moved to the new storage by
+             *       construction, as assignment requires a live
+             *       target. Elements added when size grows are
+             *       value-initialized.
+             */
             void resize_with_copy_(size_type size, size_type capacity)
             {
                 if (size < size_)
+                {
                     destroy_from_end_until_(begin() + size);
+                    size_ = size;
+                }
 
-                if(capacity_ == 0 || capacity_ < capacity)
+                if (capacity != capacity_)
                 {
                     auto new_data = allocator_.allocate(capacity);
 
-                    auto to_copy = min(size, size_);
-                    for (size_type i = 0; i < to_copy; ++i)
-                        new_data[i] = move(data_[i]);
+                    for (size_type i = 0; i < size_; ++i)
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, new_data + i, move(data_[i])
+                        );
+                        allocator_traits<Allocator>::destroy(allocator_, data_ + i);
+                    }
 
                     std::swap(data_, new_data);
 
-                    allocator_.deallocate(new_data, capacity_);
+                    if (new_data)
+                        allocator_.deallocate(new_data, capacity_);
+                    capacity_ = capacity;
                 }
 
-                capacity_ = capacity;
-                size_ = size;
+                while (size_ < size)
+                {
+                    allocator_traits<Allocator>::construct(allocator_, data_ + size_);
+                    ++size_;
+                }
             }
 
             void destroy_from_end_until_(iterator target)
@@ -663,4 +743,10 @@ namespace std
     // TODO: implement
 }
 
+namespace std::pmr
+{
+    template<class T>
+    using vector = std::vector<T, polymorphic_allocator<T>>;
+}
+
 #endif
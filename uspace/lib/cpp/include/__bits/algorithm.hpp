@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ALGORITHM
 
 #include <iterator>
+#include <new>
 #include <utility>
 
 namespace std
@@ -653,7 +654,42 @@ namespace std
      * 25.3.11, rotate:
      */
 
-    // TODO: implement
+    template<class ForwardIterator>
+    ForwardIterator rotate(ForwardIterator first, ForwardIterator middle,
+                           ForwardIterator last)
+    {
+        if (first == middle)
+            return last;
+        if (middle == last)
+            return first;
+
+        /**
+         * Swap blocks of the second part to the front until
+         * the first of its elements reaches its final position,
+         * which is the result, then finish the rest the same way.
+         */
+        auto next = middle;
+        do
+        {
+            iter_swap(first++, next++);
+            if (first == middle)
+                middle = next;
+        } while (next != last);
+
+        auto res = first;
+
+        next = middle;
+        while (next != last)
+        {
+            iter_swap(first++, next++);
+            if (first == middle)
+                middle = next;
+            else if (next == last)
+                next = middle;
+        }
+
+        return res;
+    }
 
     /**
      * 25.3.12, shuffle:
@@ -687,6 +723,160 @@ namespace std
     void sort_heap(RandomAccessIterator, RandomAccessIterator,
                    Compare);
 
+    namespace aux
+    {
+        /**
+         * Ranges up to this length are sorted by insertion sort,
+         * which is faster than quicksort on them due to its low
+         * constant factor.
+         */
+        inline constexpr int sort_threshold{16};
+
+        template<class RandomAccessIterator, class Compare>
+        void insertion_sort(RandomAccessIterator first,
+                            RandomAccessIterator last, Compare comp)
+        {
+            if (first == last)
+                return;
+
+            for (auto it = first + 1; it != last; ++it)
+            {
+                auto tmp = move(*it);
+                auto hole = it;
+
+                if (comp(tmp, *first))
+                {
+                    // Smaller than all sorted elements.
+                    while (hole != first)
+                    {
+                        *hole = move(*(hole - 1));
+                        --hole;
+                    }
+                }
+                else
+                {
+                    // *first stops the scan, no bound check needed.
+                    while (comp(tmp, *(hole - 1)))
+                    {
+                        *hole = move(*(hole - 1));
+                        --hole;
+                    }
+                }
+
+                *hole = move(tmp);
+            }
+        }
+
+        template<class Size>
+        Size sort_depth_limit(Size count)
+        {
+            Size depth{};
+            while (count > 1)
+            {
+                count /= 2;
+                ++depth;
+            }
+
+            return 2 * depth;
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void move_median_to_first(RandomAccessIterator res,
+                                  RandomAccessIterator a,
+                                  RandomAccessIterator b,
+                                  RandomAccessIterator c,
+                                  Compare comp)
+        {
+            if (comp(*a, *b))
+            {
+                if (comp(*b, *c))
+                    iter_swap(res, b);
+                else if (comp(*a, *c))
+                    iter_swap(res, c);
+                else
+                    iter_swap(res, a);
+            }
+            else if (comp(*a, *c))
+                iter_swap(res, a);
+            else if (comp(*b, *c))
+                iter_swap(res, c);
+            else
+                iter_swap(res, b);
+        }
+
+        /**
+         * Hoare partition of [first, last) around *pivot which
+         * must lie outside of the range. The median of three
+         * selection guarantees there is an element not less
+         * and an element not greater than the pivot in the range,
+         * so the scans need no bound checks.
+         */
+        template<class RandomAccessIterator, class Compare>
+        RandomAccessIterator unguarded_partition(RandomAccessIterator first,
+                                                 RandomAccessIterator last,
+                                                 RandomAccessIterator pivot,
+                                                 Compare comp)
+        {
+            while (true)
+            {
+                while (comp(*first, *pivot))
+                    ++first;
+
+                --last;
+                while (comp(*pivot, *last))
+                    --last;
+
+                if (!(first < last))
+                    return first;
+
+                iter_swap(first, last);
+                ++first;
+            }
+        }
+
+        /**
+         * Partitions [first, last) so that no element of
+         * [first, cut) is greater than any element
+         * of [cut, last) and returns cut.
+         */
+        template<class RandomAccessIterator, class Compare>
+        RandomAccessIterator partition_pivot(RandomAccessIterator first,
+                                             RandomAccessIterator last,
+                                             Compare comp)
+        {
+            auto mid = first + (last - first) / 2;
+            move_median_to_first(first, first + 1, mid, last - 1, comp);
+
+            return unguarded_partition(first + 1, last, first, comp);
+        }
+
+        template<class RandomAccessIterator, class Size, class Compare>
+        void introsort_loop(RandomAccessIterator first,
+                            RandomAccessIterator last,
+                            Size depth, Compare comp)
+        {
+            while (last - first > sort_threshold)
+            {
+                if (depth == 0)
+                {
+                    /**
+                     * Too many bad pivots, fall back to heapsort
+                     * to keep the worst case at O(n log n).
+                     */
+                    make_heap(first, last, comp);
+                    sort_heap(first, last, comp);
+
+                    return;
+                }
+                --depth;
+
+                auto cut = partition_pivot(first, last, comp);
+                introsort_loop(cut, last, depth, comp);
+                last = cut;
+            }
+        }
+    }
+
     template<class RandomAccessIterator>
     void sort(RandomAccessIterator first, RandomAccessIterator last)
     {
@@ -700,63 +890,321 @@ namespace std
               Compare comp)
     {
         /**
-         * Note: This isn't the most effective approach,
-         *       but since we already have these two functions
-         *       and they satisfy asymptotic limitations
-         *       imposed by the standard, we're using them at
-         *       the moment. Might be good to change it to qsort
-         *       or merge sort later.
+         * Introsort: quicksort with median of three pivots that
+         * leaves ranges shorter than aux::sort_threshold unsorted
+         * and switches to heapsort when recursion gets too deep.
+         * The final insertion sort pass then only has to move
+         * elements within these short ranges.
          */
+        auto count = last - first;
+        if (count < 2)
+            return;
 
-        make_heap(first, last, comp);
-        sort_heap(first, last, comp);
+        aux::introsort_loop(first, last, aux::sort_depth_limit(count), comp);
+        aux::insertion_sort(first, last, comp);
     }
 
     /**
      * 25.4.1.2, stable_sort:
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    namespace aux
+    {
+        /**
+         * Merges the adjacent sorted ranges [first, middle) and
+         * [middle, last) using the uninitialized buffer buf that
+         * has room for buf_size elements. If neither range fits
+         * into the buffer, the ranges are split and the inner parts
+         * rotated so that the problem reduces to two smaller merges.
+         */
+        template<class RandomAccessIterator, class Size,
+                 class T, class Compare>
+        void merge_adaptive(RandomAccessIterator first,
+                            RandomAccessIterator middle,
+                            RandomAccessIterator last,
+                            Size len1, Size len2,
+                            T* buf, Size buf_size, Compare comp)
+        {
+            if (len1 == 0 || len2 == 0)
+                return;
+
+            if (len1 + len2 == 2)
+            {
+                if (comp(*middle, *first))
+                    iter_swap(first, middle);
+
+                return;
+            }
+
+            if (len1 <= buf_size)
+            {
+                T* buf_end = buf;
+                for (auto it = first; it != middle; ++it, ++buf_end)
+                    ::new(static_cast<void*>(buf_end)) T(move(*it));
+
+                auto res = first;
+                T* left = buf;
+                auto right = middle;
+                while (left != buf_end && right != last)
+                {
+                    if (comp(*right, *left))
+                        *res++ = move(*right++);
+                    else
+                        *res++ = move(*left++);
+                }
+
+                // Remaining elements of the right range are in place.
+                while (left != buf_end)
+                    *res++ = move(*left++);
+
+                for (T* ptr = buf; ptr != buf_end; ++ptr)
+                    ptr->~T();
+            }
+            else if (len2 <= buf_size)
+            {
+                T* buf_end = buf;
+                for (auto it = middle; it != last; ++it, ++buf_end)
+                    ::new(static_cast<void*>(buf_end)) T(move(*it));
+
+                auto res = last;
+                auto left = middle;
+                T* right = buf_end;
+                while (left != first && right != buf)
+                {
+                    if (comp(*(right - 1), *(left - 1)))
+                        *--res = move(*--left);
+                    else
+                        *--res = move(*--right);
+                }
+
+                // Remaining elements of the left range are in place.
+                while (right != buf)
+                    *--res = move(*--right);
+
+                for (T* ptr = buf; ptr != buf_end; ++ptr)
+                    ptr->~T();
+            }
+            else
+            {
+                RandomAccessIterator cut1{}, cut2{};
+                Size len11{}, len22{};
+
+                if (len1 > len2)
+                {
+                    len11 = len1 / 2;
+                    cut1 = first + len11;
+                    cut2 = lower_bound(middle, last, *cut1, comp);
+                    len22 = cut2 - middle;
+                }
+                else
+                {
+                    len22 = len2 / 2;
+                    cut2 = middle + len22;
+                    cut1 = upper_bound(first, middle, *cut2, comp);
+                    len11 = cut1 - first;
+                }
+
+                auto new_middle = rotate(cut1, middle, cut2);
+                merge_adaptive(first, cut1, new_middle, len11, len22,
+                               buf, buf_size, comp);
+                merge_adaptive(new_middle, cut2, last, len1 - len11,
+                               len2 - len22, buf, buf_size, comp);
+            }
+        }
+
+        template<class RandomAccessIterator, class Size,
+                 class T, class Compare>
+        void stable_sort_adaptive(RandomAccessIterator first,
+                                  RandomAccessIterator last,
+                                  T* buf, Size buf_size, Compare comp)
+        {
+            Size count = last - first;
+            if (count <= sort_threshold)
+            {
+                insertion_sort(first, last, comp);
+
+                return;
+            }
+
+            auto middle = first + count / 2;
+            stable_sort_adaptive(first, middle, buf, buf_size, comp);
+            stable_sort_adaptive(middle, last, buf, buf_size, comp);
+
+            // Already in order, common for presorted input.
+            if (!comp(*middle, *(middle - 1)))
+                return;
+
+            merge_adaptive(first, middle, last, Size(middle - first),
+                           Size(last - middle), buf, buf_size, comp);
+        }
+    }
+
+    template<class RandomAccessIterator>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        stable_sort(first, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last,
+                     Compare comp)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+        using difference_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+
+        difference_type count = last - first;
+        if (count < 2)
+            return;
+
+        /**
+         * Merge sort with a buffer for half of the range is
+         * O(n log n). If we cannot get that much memory, we try
+         * smaller buffers and the merges that do not fit fall
+         * back to rotations, which is O(n log^2 n) without
+         * any buffer at all.
+         */
+        difference_type buf_size = (count + 1) / 2;
+        value_type* buf{};
+        while (buf_size > 0)
+        {
+            buf = static_cast<value_type*>(::operator new(
+                buf_size * sizeof(value_type), nothrow
+            ));
+            if (buf)
+                break;
+
+            buf_size /= 2;
+        }
+
+        aux::stable_sort_adaptive(first, last, buf, buf_size, comp);
+
+        ::operator delete(buf);
+    }
 
     /**
      * 25.4.1.3, partial_sort:
      */
 
-    // TODO: implement
+    namespace aux
+    {
+        template<class RandomAccessIterator, class Size, class Compare>
+        void correct_children(RandomAccessIterator, Size, Size, Compare);
+    }
 
-    /**
-     * 25.4.1.4, partial_sort_copy:
-     */
+    template<class RandomAccessIterator>
+    void partial_sort(RandomAccessIterator first,
+                      RandomAccessIterator middle,
+                      RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
 
-    // TODO: implement
+        partial_sort(first, middle, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void partial_sort(RandomAccessIterator first,
+                      RandomAccessIterator middle,
+                      RandomAccessIterator last,
+                      Compare comp)
+    {
+        auto count = middle - first;
+        if (count == 0)
+            return;
+
+        /**
+         * Keep the smallest elements seen so far in a max heap,
+         * any element smaller than its top replaces the top.
+         */
+        make_heap(first, middle, comp);
+        for (auto it = middle; it != last; ++it)
+        {
+            if (comp(*it, *first))
+            {
+                iter_swap(it, first);
+                aux::correct_children(first, decltype(count){}, count, comp);
+            }
+        }
+
+        sort_heap(first, middle, comp);
+    }
 
     /**
-     * 25.4.1.5, is_sorted:
+     * 25.4.1.4, partial_sort_copy:
      */
 
-    template<class ForwardIterator>
-    bool is_sorted(ForwardIterator first, ForwardIterator last)
+    template<class InputIterator, class RandomAccessIterator>
+    RandomAccessIterator partial_sort_copy(InputIterator first,
+                                           InputIterator last,
+                                           RandomAccessIterator result_first,
+                                           RandomAccessIterator result_last)
     {
-        return is_sorted_until(first, last) == last;
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        return partial_sort_copy(
+            first, last, result_first, result_last,
+            less<value_type>{}
+        );
     }
 
-    template<class ForwardIterator, class Comp>
-    bool is_sorted(ForwardIterator first, ForwardIterator last,
-                   Comp comp)
+    template<class InputIterator, class RandomAccessIterator, class Compare>
+    RandomAccessIterator partial_sort_copy(InputIterator first,
+                                           InputIterator last,
+                                           RandomAccessIterator result_first,
+                                           RandomAccessIterator result_last,
+                                           Compare comp)
     {
-        return is_sorted_until(first, last, comp) == last;
+        auto result_end = result_first;
+        while (first != last && result_end != result_last)
+            *result_end++ = *first++;
+
+        auto count = result_end - result_first;
+        if (count == 0)
+            return result_end;
+
+        make_heap(result_first, result_end, comp);
+        while (first != last)
+        {
+            if (comp(*first, *result_first))
+            {
+                *result_first = *first;
+                aux::correct_children(
+                    result_first, decltype(count){}, count, comp
+                );
+            }
+            ++first;
+        }
+
+        sort_heap(result_first, result_end, comp);
+
+        return result_end;
     }
 
+    /**
+     * 25.4.1.5, is_sorted:
+     */
+
     template<class ForwardIterator>
     ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last)
     {
-        if (distance(first, last) < 2)
+        if (first == last)
             return last;
 
-        while (first != last)
+        auto next = first;
+        while (++next != last)
         {
-            if (*first > *(++first))
-                return first;
+            if (*next < *first)
+                return next;
+            first = next;
         }
 
         return last;
@@ -766,23 +1214,78 @@ namespace std
     ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last,
                                     Comp comp)
     {
-        if (distance(first, last) < 2)
+        if (first == last)
             return last;
 
-        while (first != last)
+        auto next = first;
+        while (++next != last)
         {
-            if (!comp(*first, *(++first)))
-                return first;
+            if (comp(*next, *first))
+                return next;
+            first = next;
         }
 
         return last;
     }
 
+    template<class ForwardIterator>
+    bool is_sorted(ForwardIterator first, ForwardIterator last)
+    {
+        return is_sorted_until(first, last) == last;
+    }
+
+    template<class ForwardIterator, class Comp>
+    bool is_sorted(ForwardIterator first, ForwardIterator last,
+                   Comp comp)
+    {
+        return is_sorted_until(first, last, comp) == last;
+    }
+
     /**
      * 25.4.2, nth_element:
      */
 
-    // TODO: implement
+    template<class RandomAccessIterator>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        nth_element(first, nth, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last, Compare comp)
+    {
+        if (first == last || nth == last)
+            return;
+
+        /**
+         * Introselect: quickselect that only continues into
+         * the partition containing nth, with partial_sort
+         * as a fallback when pivots keep being bad.
+         */
+        auto depth = aux::sort_depth_limit(last - first);
+        while (last - first > 3)
+        {
+            if (depth == 0)
+            {
+                partial_sort(first, nth + 1, last, comp);
+
+                return;
+            }
+            --depth;
+
+            auto cut = aux::partition_pivot(first, last, comp);
+            if (cut <= nth)
+                first = cut;
+            else
+                last = cut;
+        }
+
+        aux::insertion_sort(first, last, comp);
+    }
 
     /**
      * 25.4.3, binary search:
@@ -792,13 +1295,69 @@ namespace std
      * 25.4.3.1, lower_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        return lower_bound(first, last, value, less<void>{});
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (comp(*it, value))
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.2, upper_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        return upper_bound(first, last, value, less<void>{});
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (!comp(value, *it))
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.3, equal_range:
@@ -876,40 +1435,33 @@ namespace std
             return 2 * idx + 2;
         }
 
+        /**
+         * Sifts first[idx] down the heap of count elements until
+         * it is not smaller than any of its children.
+         */
         template<class RandomAccessIterator, class Size, class Compare>
         void correct_children(RandomAccessIterator first,
                               Size idx, Size count, Compare comp)
         {
             using aux::heap_left_child;
-            using aux::heap_right_child;
 
-            auto left = heap_left_child(idx);
-            auto right = heap_right_child(idx);
-
-            bool left_incorrect{comp(first[idx], first[left])};
-            bool right_incorrect{comp(first[idx], first[right])};
-            while ((left < count && left_incorrect) ||
-                   (right < count && right_incorrect))
+            auto value = move(first[idx]);
+            auto child = heap_left_child(idx);
+            while (child < count)
             {
-                if (right >= count || (left_incorrect && comp(first[right], first[left])))
-                {
-                    swap(first[idx], first[left]);
-
-                    idx = left;
-                }
-                else if (right < count && right_incorrect)
-                {
-                    swap(first[idx], first[right]);
+                auto right = child + 1;
+                if (right < count && comp(first[child], first[right]))
+                    child = right;
 
-                    idx = right;
-                } // Else should not happen because of the while condition.
+                if (!comp(value, first[child]))
+                    break;
 
-                left = heap_left_child(idx);
-                right = heap_right_child(idx);
-
-                left_incorrect = comp(first[idx], first[left]);
-                right_incorrect = comp(first[idx], first[right]);
+                first[idx] = move(first[child]);
+                idx = child;
+                child = heap_left_child(idx);
             }
+
+            first[idx] = move(value);
         }
     }
 
@@ -971,7 +1523,7 @@ namespace std
             return;
 
         swap(first[0], first[count - 1]);
-        aux::correct_children(first, decltype(count){}, count - 2, comp);
+        aux::correct_children(first, decltype(count){}, count - 1, comp);
     }
 
     /**
@@ -996,7 +1548,8 @@ namespace std
         if (count <= 1)
             return;
 
-        for (auto i = count; i > 0; --i)
+        // Leaves are trivially heaps.
+        for (auto i = count / 2; i > 0; --i)
         {
             auto idx = i - 1;
 
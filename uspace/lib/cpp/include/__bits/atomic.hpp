@@ -29,6 +29,749 @@
 #ifndef LIBCPP_BITS_ATOMIC
 #define LIBCPP_BITS_ATOMIC
 
-#error "<atomic> is not implemented"
+#include <__bits/thread/threading.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#define ATOMIC_BOOL_LOCK_FREE     __GCC_ATOMIC_BOOL_LOCK_FREE
+#define ATOMIC_CHAR_LOCK_FREE     __GCC_ATOMIC_CHAR_LOCK_FREE
+#define ATOMIC_CHAR16_T_LOCK_FREE __GCC_ATOMIC_CHAR16_T_LOCK_FREE
+#define ATOMIC_CHAR32_T_LOCK_FREE __GCC_ATOMIC_CHAR32_T_LOCK_FREE
+#define ATOMIC_WCHAR_T_LOCK_FREE  __GCC_ATOMIC_WCHAR_T_LOCK_FREE
+#define ATOMIC_SHORT_LOCK_FREE    __GCC_ATOMIC_SHORT_LOCK_FREE
+#define ATOMIC_INT_LOCK_FREE      __GCC_ATOMIC_INT_LOCK_FREE
+#define ATOMIC_LONG_LOCK_FREE     __GCC_ATOMIC_LONG_LOCK_FREE
+#define ATOMIC_LLONG_LOCK_FREE    __GCC_ATOMIC_LLONG_LOCK_FREE
+#define ATOMIC_POINTER_LOCK_FREE  __GCC_ATOMIC_POINTER_LOCK_FREE
+
+#define ATOMIC_VAR_INIT(value) {value}
+#define ATOMIC_FLAG_INIT {false}
+
+namespace std
+{
+    /**
+     * 29.3, order and consistency:
+     */
+
+    enum memory_order
+    {
+        memory_order_relaxed,
+        memory_order_consume,
+        memory_order_acquire,
+        memory_order_release,
+        memory_order_acq_rel,
+        memory_order_seq_cst
+    };
+
+    template<class T>
+    T kill_dependency(T y) noexcept
+    {
+        return y;
+    }
+}
+
+namespace std::aux
+{
+    constexpr int builtin_order(memory_order order) noexcept
+    {
+        switch (order)
+        {
+            case memory_order_relaxed:
+                return __ATOMIC_RELAXED;
+            case memory_order_consume:
+                return __ATOMIC_CONSUME;
+            case memory_order_acquire:
+                return __ATOMIC_ACQUIRE;
+            case memory_order_release:
+                return __ATOMIC_RELEASE;
+            case memory_order_acq_rel:
+                return __ATOMIC_ACQ_REL;
+            default:
+                return __ATOMIC_SEQ_CST;
+        }
+    }
+
+    /**
+     * The order of the load performed by a failed
+     * compare and exchange cannot contain release.
+     */
+    constexpr memory_order failure_order(memory_order order) noexcept
+    {
+        if (order == memory_order_acq_rel)
+            return memory_order_acquire;
+        else if (order == memory_order_release)
+            return memory_order_relaxed;
+        else
+            return order;
+    }
+
+    /**
+     * Types the target can update with a single instruction
+     * (or an ll/sc loop) use the __atomic builtins directly.
+     * Anything else would need calls to libatomic, which we
+     * do not have, so those are protected by a fibril mutex.
+     */
+    template<class T>
+    inline constexpr bool atomic_is_native_v =
+        __atomic_always_lock_free(sizeof(T), 0) &&
+        (sizeof(T) & (sizeof(T) - 1)) == 0;
+
+    template<class T, bool = atomic_is_native_v<T>>
+    class atomic_base
+    {
+        public:
+            atomic_base() noexcept = default;
+
+            constexpr atomic_base(T desired) noexcept
+                : val_{desired}
+            { /* DUMMY BODY */ }
+
+            atomic_base(const atomic_base&) = delete;
+            atomic_base& operator=(const atomic_base&) = delete;
+
+            bool is_lock_free() const noexcept
+            {
+                return true;
+            }
+
+            void store(T desired, memory_order order = memory_order_seq_cst) noexcept
+            {
+                __atomic_store(&val_, &desired, builtin_order(order));
+            }
+
+            T load(memory_order order = memory_order_seq_cst) const noexcept
+            {
+                T res;
+                __atomic_load(&val_, &res, builtin_order(order));
+
+                return res;
+            }
+
+            operator T() const noexcept
+            {
+                return load();
+            }
+
+            T exchange(T desired, memory_order order = memory_order_seq_cst) noexcept
+            {
+                T res;
+                __atomic_exchange(&val_, &desired, &res, builtin_order(order));
+
+                return res;
+            }
+
+            bool compare_exchange_weak(T& expected, T desired,
+                                       memory_order success,
+                                       memory_order failure) noexcept
+            {
+                return __atomic_compare_exchange(
+                    &val_, &expected, &desired, true,
+                    builtin_order(success), builtin_order(failure)
+                );
+            }
+
+            bool compare_exchange_weak(T& expected, T desired,
+                                       memory_order order = memory_order_seq_cst) noexcept
+            {
+                return compare_exchange_weak(
+                    expected, desired, order, failure_order(order)
+                );
+            }
+
+            bool compare_exchange_strong(T& expected, T desired,
+                                         memory_order success,
+                                         memory_order failure) noexcept
+            {
+                return __atomic_compare_exchange(
+                    &val_, &expected, &desired, false,
+                    builtin_order(success), builtin_order(failure)
+                );
+            }
+
+            bool compare_exchange_strong(T& expected, T desired,
+                                         memory_order order = memory_order_seq_cst) noexcept
+            {
+                return compare_exchange_strong(
+                    expected, desired, order, failure_order(order)
+                );
+            }
+
+        protected:
+            /**
+             * Note: Some 32-bit targets align 64-bit types to
+             *       4 bytes only, but atomic instructions need
+             *       natural alignment.
+             */
+            alignas(sizeof(T) > alignof(T) ? sizeof(T) : alignof(T)) T val_;
+    };
+
+    template<class T>
+    class atomic_base<T, false>
+    {
+        public:
+            atomic_base() noexcept
+                : mtx_{}
+            {
+                threading::mutex::init(mtx_);
+            }
+
+            atomic_base(T desired) noexcept
+                : mtx_{}, val_{desired}
+            {
+                threading::mutex::init(mtx_);
+            }
+
+            atomic_base(const atomic_base&) = delete;
+            atomic_base& operator=(const atomic_base&) = delete;
+
+            bool is_lock_free() const noexcept
+            {
+                return false;
+            }
+
+            void store(T desired, memory_order = memory_order_seq_cst) noexcept
+            {
+                threading::mutex::lock(mtx_);
+                val_ = desired;
+                threading::mutex::unlock(mtx_);
+            }
+
+            T load(memory_order = memory_order_seq_cst) const noexcept
+            {
+                threading::mutex::lock(mtx_);
+                T res{val_};
+                threading::mutex::unlock(mtx_);
+
+                return res;
+            }
+
+            operator T() const noexcept
+            {
+                return load();
+            }
+
+            T exchange(T desired, memory_order = memory_order_seq_cst) noexcept
+            {
+                threading::mutex::lock(mtx_);
+                T res{val_};
+                val_ = desired;
+                threading::mutex::unlock(mtx_);
+
+                return res;
+            }
+
+            bool compare_exchange_weak(T& expected, T desired,
+                                       memory_order, memory_order) noexcept
+            {
+                return compare_exchange_strong(expected, desired);
+            }
+
+            bool compare_exchange_weak(T& expected, T desired,
+                                       memory_order = memory_order_seq_cst) noexcept
+            {
+                return compare_exchange_strong(expected, desired);
+            }
+
+            bool compare_exchange_strong(T& expected, T desired,
+                                         memory_order, memory_order) noexcept
+            {
+                return compare_exchange_strong(expected, desired);
+            }
+
+            bool compare_exchange_strong(T& expected, T desired,
+                                         memory_order = memory_order_seq_cst) noexcept
+            {
+                /**
+                 * Note: The standard specifies the comparison
+                 *       in terms of object representations.
+                 */
+                threading::mutex::lock(mtx_);
+                bool res = memcmp(&val_, &expected, sizeof(T)) == 0;
+                if (res)
+                    val_ = desired;
+                else
+                    expected = val_;
+                threading::mutex::unlock(mtx_);
+
+                return res;
+            }
+
+        protected:
+            mutable mutex_t mtx_;
+            T val_;
+    };
+
+    /**
+     * Arithmetic and bitwise operations of the atomic
+     * integral types.
+     */
+    template<class T>
+    class atomic_integral: public atomic_base<T>
+    {
+        public:
+            atomic_integral() noexcept = default;
+
+            constexpr atomic_integral(T desired) noexcept
+                : atomic_base<T>{desired}
+            { /* DUMMY BODY */ }
+
+            T fetch_add(T arg, memory_order order = memory_order_seq_cst) noexcept
+            {
+                if constexpr (atomic_is_native_v<T>)
+                    return __atomic_fetch_add(&this->val_, arg, builtin_order(order));
+                else
+                    return locked_fetch_([arg](T val){ return val + arg; });
+            }
+
+            T fetch_sub(T arg, memory_order order = memory_order_seq_cst) noexcept
+            {
+                if constexpr (atomic_is_native_v<T>)
+                    return __atomic_fetch_sub(&this->val_, arg, builtin_order(order));
+                else
+                    return locked_fetch_([arg](T val){ return val - arg; });
+            }
+
+            T fetch_and(T arg, memory_order order = memory_order_seq_cst) noexcept
+            {
+                if constexpr (atomic_is_native_v<T>)
+                    return __atomic_fetch_and(&this->val_, arg, builtin_order(order));
+                else
+                    return locked_fetch_([arg](T val){ return val & arg; });
+            }
+
+            T fetch_or(T arg, memory_order order = memory_order_seq_cst) noexcept
+            {
+                if constexpr (atomic_is_native_v<T>)
+                    return __atomic_fetch_or(&this->val_, arg, builtin_order(order));
+                else
+                    return locked_fetch_([arg](T val){ return val | arg; });
+            }
+
+            T fetch_xor(T arg, memory_order order = memory_order_seq_cst) noexcept
+            {
+                if constexpr (atomic_is_native_v<T>)
+                    return __atomic_fetch_xor(&this->val_, arg, builtin_order(order));
+                else
+                    return locked_fetch_([arg](T val){ return val ^ arg; });
+            }
+
+            T operator++(int) noexcept
+            {
+                return fetch_add(1);
+            }
+
+            T operator--(int) noexcept
+            {
+                return fetch_sub(1);
+            }
+
+            T operator++() noexcept
+            {
+                return fetch_add(1) + 1;
+            }
+
+            T operator--() noexcept
+            {
+                return fetch_sub(1) - 1;
+            }
+
+            T operator+=(T arg) noexcept
+            {
+                return fetch_add(arg) + arg;
+            }
+
+            T operator-=(T arg) noexcept
+            {
+                return fetch_sub(arg) - arg;
+            }
+
+            T operator&=(T arg) noexcept
+            {
+                return fetch_and(arg) & arg;
+            }
+
+            T operator|=(T arg) noexcept
+            {
+                return fetch_or(arg) | arg;
+            }
+
+            T operator^=(T arg) noexcept
+            {
+                return fetch_xor(arg) ^ arg;
+            }
+
+        private:
+            template<class Op>
+            T locked_fetch_(Op op) noexcept
+            {
+                threading::mutex::lock(this->mtx_);
+                T res{this->val_};
+                this->val_ = op(res);
+                threading::mutex::unlock(this->mtx_);
+
+                return res;
+            }
+    };
+
+    /**
+     * Note: The builtins do not scale pointer arithmetic
+     *       by the size of the pointee.
+     */
+    template<class T>
+    class atomic_pointer: public atomic_base<T*>
+    {
+        public:
+            atomic_pointer() noexcept = default;
+
+            constexpr atomic_pointer(T* desired) noexcept
+                : atomic_base<T*>{desired}
+            { /* DUMMY BODY */ }
+
+            T* fetch_add(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+            {
+                return __atomic_fetch_add(
+                    &this->val_, arg * sizeof(T), builtin_order(order)
+                );
+            }
+
+            T* fetch_sub(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+            {
+                return __atomic_fetch_sub(
+                    &this->val_, arg * sizeof(T), builtin_order(order)
+                );
+            }
+
+            T* operator++(int) noexcept
+            {
+                return fetch_add(1);
+            }
+
+            T* operator--(int) noexcept
+            {
+                return fetch_sub(1);
+            }
+
+            T* operator++() noexcept
+            {
+                return fetch_add(1) + 1;
+            }
+
+            T* operator--() noexcept
+            {
+                return fetch_sub(1) - 1;
+            }
+
+            T* operator+=(ptrdiff_t arg) noexcept
+            {
+                return fetch_add(arg) + arg;
+            }
+
+            T* operator-=(ptrdiff_t arg) noexcept
+            {
+                return fetch_sub(arg) - arg;
+            }
+    };
+
+    template<class T>
+    using atomic_base_for_t = conditional_t<
+        is_integral<T>::value && !is_same_v<T, bool>,
+        atomic_integral<T>, atomic_base<T>
+    >;
+}
+
+namespace std
+{
+    /**
+     * 29.5, atomic types:
+     */
+
+    template<class T>
+    struct atomic: aux::atomic_base_for_t<T>
+    {
+        static_assert(is_trivially_copyable_v<T>, "atomic<T> requires a trivially copyable T");
+
+        using value_type = T;
+
+        atomic() noexcept = default;
+
+        constexpr atomic(T desired) noexcept
+            : aux::atomic_base_for_t<T>{desired}
+        { /* DUMMY BODY */ }
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        T operator=(T desired) noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+    };
+
+    template<class T>
+    struct atomic<T*>: aux::atomic_pointer<T>
+    {
+        using value_type = T*;
+
+        atomic() noexcept = default;
+
+        constexpr atomic(T* desired) noexcept
+            : aux::atomic_pointer<T>{desired}
+        { /* DUMMY BODY */ }
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        T* operator=(T* desired) noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+    };
+
+    using atomic_bool     = atomic<bool>;
+    using atomic_char     = atomic<char>;
+    using atomic_schar    = atomic<signed char>;
+    using atomic_uchar    = atomic<unsigned char>;
+    using atomic_short    = atomic<short>;
+    using atomic_ushort   = atomic<unsigned short>;
+    using atomic_int      = atomic<int>;
+    using atomic_uint     = atomic<unsigned int>;
+    using atomic_long     = atomic<long>;
+    using atomic_ulong    = atomic<unsigned long>;
+    using atomic_llong    = atomic<long long>;
+    using atomic_ullong   = atomic<unsigned long long>;
+    using atomic_char16_t = atomic<char16_t>;
+    using atomic_char32_t = atomic<char32_t>;
+    using atomic_wchar_t  = atomic<wchar_t>;
+
+    using atomic_int8_t   = atomic<int8_t>;
+    using atomic_uint8_t  = atomic<uint8_t>;
+    using atomic_int16_t  = atomic<int16_t>;
+    using atomic_uint16_t = atomic<uint16_t>;
+    using atomic_int32_t  = atomic<int32_t>;
+    using atomic_uint32_t = atomic<uint32_t>;
+    using atomic_int64_t  = atomic<int64_t>;
+    using atomic_uint64_t = atomic<uint64_t>;
+
+    using atomic_intptr_t  = atomic<intptr_t>;
+    using atomic_uintptr_t = atomic<uintptr_t>;
+    using atomic_size_t    = atomic<size_t>;
+    using atomic_ptrdiff_t = atomic<ptrdiff_t>;
+    using atomic_intmax_t  = atomic<intmax_t>;
+    using atomic_uintmax_t = atomic<uintmax_t>;
+
+    /**
+     * 29.6, operations on atomic types:
+     */
+
+    template<class T>
+    bool atomic_is_lock_free(const atomic<T>* obj) noexcept
+    {
+        return obj->is_lock_free();
+    }
+
+    template<class T>
+    void atomic_init(atomic<T>* obj, T desired) noexcept
+    {
+        obj->store(desired, memory_order_relaxed);
+    }
+
+    template<class T>
+    void atomic_store(atomic<T>* obj, T desired) noexcept
+    {
+        obj->store(desired);
+    }
+
+    template<class T>
+    void atomic_store_explicit(atomic<T>* obj, T desired, memory_order order) noexcept
+    {
+        obj->store(desired, order);
+    }
+
+    template<class T>
+    T atomic_load(const atomic<T>* obj) noexcept
+    {
+        return obj->load();
+    }
+
+    template<class T>
+    T atomic_load_explicit(const atomic<T>* obj, memory_order order) noexcept
+    {
+        return obj->load(order);
+    }
+
+    template<class T>
+    T atomic_exchange(atomic<T>* obj, T desired) noexcept
+    {
+        return obj->exchange(desired);
+    }
+
+    template<class T>
+    T atomic_exchange_explicit(atomic<T>* obj, T desired, memory_order order) noexcept
+    {
+        return obj->exchange(desired, order);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak(atomic<T>* obj, T* expected, T desired) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong(atomic<T>* obj, T* expected, T desired) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak_explicit(atomic<T>* obj, T* expected, T desired,
+                                               memory_order success,
+                                               memory_order failure) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired, success, failure);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong_explicit(atomic<T>* obj, T* expected, T desired,
+                                                 memory_order success,
+                                                 memory_order failure) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired, success, failure);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_add(atomic<T>* obj, U arg) noexcept
+    {
+        return obj->fetch_add(arg);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_add_explicit(atomic<T>* obj, U arg, memory_order order) noexcept
+    {
+        return obj->fetch_add(arg, order);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_sub(atomic<T>* obj, U arg) noexcept
+    {
+        return obj->fetch_sub(arg);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_sub_explicit(atomic<T>* obj, U arg, memory_order order) noexcept
+    {
+        return obj->fetch_sub(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_and(atomic<T>* obj, T arg) noexcept
+    {
+        return obj->fetch_and(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_and_explicit(atomic<T>* obj, T arg, memory_order order) noexcept
+    {
+        return obj->fetch_and(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_or(atomic<T>* obj, T arg) noexcept
+    {
+        return obj->fetch_or(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_or_explicit(atomic<T>* obj, T arg, memory_order order) noexcept
+    {
+        return obj->fetch_or(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_xor(atomic<T>* obj, T arg) noexcept
+    {
+        return obj->fetch_xor(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_xor_explicit(atomic<T>* obj, T arg, memory_order order) noexcept
+    {
+        return obj->fetch_xor(arg, order);
+    }
+
+    /**
+     * 29.7, flag type and operations:
+     */
+
+    struct atomic_flag
+    {
+        public:
+            atomic_flag() noexcept = default;
+
+            /**
+             * Note: Used by ATOMIC_FLAG_INIT.
+             */
+            constexpr atomic_flag(bool flag) noexcept
+                : flag_{flag}
+            { /* DUMMY BODY */ }
+
+            atomic_flag(const atomic_flag&) = delete;
+            atomic_flag& operator=(const atomic_flag&) = delete;
+
+            bool test_and_set(memory_order order = memory_order_seq_cst) noexcept
+            {
+                return __atomic_test_and_set(&flag_, aux::builtin_order(order));
+            }
+
+            void clear(memory_order order = memory_order_seq_cst) noexcept
+            {
+                __atomic_clear(&flag_, aux::builtin_order(order));
+            }
+
+        private:
+            bool flag_;
+    };
+
+    inline bool atomic_flag_test_and_set(atomic_flag* flag) noexcept
+    {
+        return flag->test_and_set();
+    }
+
+    inline bool atomic_flag_test_and_set_explicit(atomic_flag* flag,
+                                                  memory_order order) noexcept
+    {
+        return flag->test_and_set(order);
+    }
+
+    inline void atomic_flag_clear(atomic_flag* flag) noexcept
+    {
+        flag->clear();
+    }
+
+    inline void atomic_flag_clear_explicit(atomic_flag* flag, memory_order order) noexcept
+    {
+        flag->clear(order);
+    }
+
+    /**
+     * 29.8, fences:
+     */
+
+    inline void atomic_thread_fence(memory_order order) noexcept
+    {
+        __atomic_thread_fence(aux::builtin_order(order));
+    }
+
+    inline void atomic_signal_fence(memory_order order) noexcept
+    {
+        __atomic_signal_fence(aux::builtin_order(order));
+    }
+}
 
 #endif
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_EXECUTION
+#define LIBCPP_BITS_EXECUTION
+
+#include <__bits/algorithm.hpp>
+#include <__bits/numeric.hpp>
+#include <__bits/thread/executor.hpp>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace std
+{
+    /**
+     * C++17 23.19, execution policies:
+     */
+
+    namespace execution
+    {
+        class sequenced_policy
+        {
+            public:
+                constexpr sequenced_policy() = default;
+        };
+
+        class parallel_policy
+        {
+            public:
+                constexpr parallel_policy() = default;
+        };
+
+        class parallel_unsequenced_policy
+        {
+            public:
+                constexpr parallel_unsequenced_policy() = default;
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+    }
+
+    template<class T>
+    struct is_execution_policy: false_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::sequenced_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::parallel_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<class T>
+    inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+    namespace aux
+    {
+        template<class ExecutionPolicy, class R>
+        using enable_if_policy_t = enable_if_t<
+            is_execution_policy_v<decay_t<ExecutionPolicy>>, R
+        >;
+
+        /**
+         * Parallel versions are only used for random access
+         * iterators, where the range can be split in O(1),
+         * everything else runs the sequential algorithm.
+         */
+        template<class ExecutionPolicy, class... Iterators>
+        inline constexpr bool use_parallel_v =
+            !is_same_v<decay_t<ExecutionPolicy>, execution::sequenced_policy> &&
+            (is_base_of_v<
+                random_access_iterator_tag,
+                typename iterator_traits<Iterators>::iterator_category
+            > && ...);
+
+        /**
+         * Ranges shorter than this are not worth
+         * distributing among the workers.
+         */
+        inline constexpr size_t parallel_min_grain{1024};
+
+        template<class RandomAccessIterator, class Compare>
+        void parallel_sort(RandomAccessIterator first,
+                           RandomAccessIterator last, Compare comp)
+        {
+            using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+            size_t count = last - first;
+            auto workers = executor::instance().concurrency();
+
+            size_t runs{1};
+            while (runs < workers && count / (runs * 2) >= parallel_min_grain)
+                runs *= 2;
+
+            if (runs < 2)
+            {
+                sort(first, last, comp);
+
+                return;
+            }
+
+            /**
+             * Every merge gets the part of the buffer that
+             * corresponds to its subrange, so concurrent merges
+             * never share memory. Without the buffer we just
+             * sort sequentially.
+             */
+            auto buf = static_cast<value_type*>(::operator new(
+                count * sizeof(value_type), nothrow
+            ));
+            if (!buf)
+            {
+                sort(first, last, comp);
+
+                return;
+            }
+
+            auto run_size = (count + runs - 1) / runs;
+            auto run_begin = [count](size_t run, size_t size){
+                auto idx = run * size;
+
+                return idx < count ? idx : count;
+            };
+
+            parallel_for(runs, 1, [&](size_t b, size_t e){
+                for (size_t run = b; run < e; ++run)
+                {
+                    sort(first + run_begin(run, run_size),
+                         first + run_begin(run + 1, run_size), comp);
+                }
+            });
+
+            for (auto width = run_size; runs > 1; width *= 2, runs /= 2)
+            {
+                parallel_for(runs / 2, 1, [&](size_t b, size_t e){
+                    for (size_t pair = b; pair < e; ++pair)
+                    {
+                        auto lo = run_begin(pair * 2, width);
+                        auto mid = run_begin(pair * 2 + 1, width);
+                        auto hi = run_begin(pair * 2 + 2, width);
+
+                        if (lo == mid || mid == hi ||
+                            !comp(*(first + mid), *(first + (mid - 1))))
+                            continue;
+
+                        merge_adaptive(
+                            first + lo, first + mid, first + hi,
+                            mid - lo, hi - mid, buf + lo, hi - lo, comp
+                        );
+                    }
+                });
+            }
+
+            ::operator delete(buf);
+        }
+    }
+
+    /**
+     * C++17 25.6.4, for_each:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator, class Function>
+    aux::enable_if_policy_t<ExecutionPolicy, void>
+    for_each(ExecutionPolicy&&, ForwardIterator first,
+             ForwardIterator last, Function f)
+    {
+        if constexpr (aux::use_parallel_v<ExecutionPolicy, ForwardIterator>)
+        {
+            aux::parallel_for(last - first, 1, [&](size_t b, size_t e){
+                for (auto it = first + b; it != first + e; ++it)
+                    f(*it);
+            });
+        }
+        else
+            for_each(first, last, f);
+    }
+
+    /**
+     * C++17 25.6.4, transform:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator1,
+             class ForwardIterator2, class UnaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator2>
+    transform(ExecutionPolicy&&, ForwardIterator1 first,
+              ForwardIterator1 last, ForwardIterator2 result,
+              UnaryOperation op)
+    {
+        if constexpr (aux::use_parallel_v<ExecutionPolicy, ForwardIterator1,
+                                          ForwardIterator2>)
+        {
+            auto count = last - first;
+            aux::parallel_for(count, 1, [&](size_t b, size_t e){
+                auto out = result + b;
+                for (auto it = first + b; it != first + e; ++it, ++out)
+                    *out = op(*it);
+            });
+
+            return result + count;
+        }
+        else
+            return transform(first, last, result, op);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1,
+             class ForwardIterator2, class ForwardIterator3,
+             class BinaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator3>
+    transform(ExecutionPolicy&&, ForwardIterator1 first1,
+              ForwardIterator1 last1, ForwardIterator2 first2,
+              ForwardIterator3 result, BinaryOperation op)
+    {
+        if constexpr (aux::use_parallel_v<ExecutionPolicy, ForwardIterator1,
+                                          ForwardIterator2, ForwardIterator3>)
+        {
+            auto count = last1 - first1;
+            aux::parallel_for(count, 1, [&](size_t b, size_t e){
+                auto in = first2 + b;
+                auto out = result + b;
+                for (auto it = first1 + b; it != first1 + e; ++it, ++in, ++out)
+                    *out = op(*it, *in);
+            });
+
+            return result + count;
+        }
+        else
+            return transform(first1, last1, first2, result, op);
+    }
+
+    /**
+     * C++17 29.8.3, reduce:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator,
+             class T, class BinaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, T>
+    reduce(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+           T init, BinaryOperation op)
+    {
+        if constexpr (aux::use_parallel_v<ExecutionPolicy, ForwardIterator>)
+        {
+            /**
+             * Every chunk is reduced on its own and the partial
+             * results are combined in whatever order they finish,
+             * which reduce allows as op has to be associative
+             * and commutative.
+             */
+            auto acc{init};
+            aux::mutex_t mtx{};
+            aux::threading::mutex::init(mtx);
+
+            aux::parallel_for(last - first, aux::parallel_min_grain,
+                              [&](size_t b, size_t e){
+                T partial(*(first + b));
+                for (auto it = first + b + 1; it != first + e; ++it)
+                    partial = op(move(partial), *it);
+
+                aux::threading::mutex::lock(mtx);
+                acc = op(move(acc), move(partial));
+                aux::threading::mutex::unlock(mtx);
+            });
+
+            return acc;
+        }
+        else
+            return reduce(first, last, move(init), op);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator, class T>
+    aux::enable_if_policy_t<ExecutionPolicy, T>
+    reduce(ExecutionPolicy&& policy, ForwardIterator first,
+           ForwardIterator last, T init)
+    {
+        return reduce(forward<ExecutionPolicy>(policy), first, last,
+                      move(init), plus<>{});
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator>
+    aux::enable_if_policy_t<
+        ExecutionPolicy, typename iterator_traits<ForwardIterator>::value_type
+    >
+    reduce(ExecutionPolicy&& policy, ForwardIterator first,
+           ForwardIterator last)
+    {
+        using value_type = typename iterator_traits<ForwardIterator>::value_type;
+
+        return reduce(forward<ExecutionPolicy>(policy), first, last,
+                      value_type{}, plus<>{});
+    }
+
+    /**
+     * C++17 28.7.1.1, sort:
+     */
+
+    template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+    aux::enable_if_policy_t<ExecutionPolicy, void>
+    sort(ExecutionPolicy&&, RandomAccessIterator first,
+         RandomAccessIterator last, Compare comp)
+    {
+        if constexpr (aux::use_parallel_v<ExecutionPolicy, RandomAccessIterator>)
+            aux::parallel_sort(first, last, comp);
+        else
+            sort(first, last, comp);
+    }
+
+    template<class ExecutionPolicy, class RandomAccessIterator>
+    aux::enable_if_policy_t<ExecutionPolicy, void>
+    sort(ExecutionPolicy&& policy, RandomAccessIterator first,
+         RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        sort(forward<ExecutionPolicy>(policy), first, last, less<value_type>{});
+    }
+}
+
+#endif
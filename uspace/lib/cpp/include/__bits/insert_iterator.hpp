@@ -29,10 +29,7 @@
 #ifndef LIBCPP_BITS_INSERT_ITERATOR
 #define LIBCPP_BITS_INSERT_ITERATOR
 
-namespace std
-{
-    struct forward_iterator_tag;
-}
+#include <__bits/iterator.hpp>
 
 namespace std::aux
 {
@@ -30,13 +30,69 @@
 #define LIBCPP_BITS_IO_FSTREAM
 
 #include <cassert>
-#include <cstdio>
+#include <cstdint>
 #include <ios>
 #include <iosfwd>
 #include <locale>
 #include <streambuf>
 #include <string>
 
+namespace std::aux
+{
+    /**
+     * Unbuffered file accessed directly through the vfs
+     * interface of libc. Buffering is done by basic_filebuf,
+     * so going through stdio would only add a second copy.
+     */
+    class vfs_file
+    {
+        public:
+            vfs_file() noexcept
+                : fd_{-1}, pos_{}
+            { /* DUMMY BODY */ }
+
+            vfs_file(const vfs_file&) = delete;
+            vfs_file& operator=(const vfs_file&) = delete;
+
+            ~vfs_file()
+            {
+                close();
+            }
+
+            bool open(const char* name, ios_base::openmode mode);
+
+            bool close();
+
+            bool is_open() const noexcept
+            {
+                return fd_ >= 0;
+            }
+
+            /**
+             * Returns the number of bytes read, zero
+             * at the end of the file or on error.
+             */
+            size_t read(void* buf, size_t size);
+
+            /**
+             * Returns true if all size bytes were written.
+             */
+            bool write(const void* buf, size_t size);
+
+            bool seek(streamoff off, ios_base::seekdir dir, streamoff& pos);
+
+            void swap(vfs_file& other) noexcept
+            {
+                std::swap(fd_, other.fd_);
+                std::swap(pos_, other.pos_);
+            }
+
+        private:
+            int fd_;
+            uint64_t pos_;
+    };
+}
+
 namespace std
 {
     /**
@@ -58,26 +114,25 @@ namespace std
 
             basic_filebuf()
                 : basic_streambuf<char_type, traits_type>{},
-                  obuf_{nullptr}, ibuf_{nullptr}, mode_{}, file_{nullptr}
+                  obuf_{nullptr}, ibuf_{nullptr}, mode_{}, file_{}
             { /* DUMMY BODY */ }
 
             basic_filebuf(const basic_filebuf&) = delete;
 
             basic_filebuf(basic_filebuf&& other)
-                : mode_{other.mode_}
+                : basic_streambuf<char_type, traits_type>{},
+                  obuf_{nullptr}, ibuf_{nullptr}, mode_{}, file_{}
             {
-                close();
-                std::swap(obuf_, other.obuf_);
-                std::swap(ibuf_, other.ibuf_);
-                std::swap(file_, other.file_);
-
-                basic_streambuf<char_type, traits_type>::swap(other);
+                swap(other);
             }
 
             virtual ~basic_filebuf()
             {
                 // TODO: exception here caught and not rethrown
                 close();
+
+                delete[] obuf_;
+                delete[] ibuf_;
             }
 
             /**
@@ -99,6 +154,7 @@ namespace std
                 std::swap(mode_, rhs.mode_);
                 std::swap(obuf_, rhs.obuf_);
                 std::swap(ibuf_, rhs.ibuf_);
+                file_.swap(rhs.file_);
 
                 basic_streambuf<char_type, traits_type>::swap(rhs);
             }
@@ -109,28 +165,22 @@ namespace std
 
             bool is_open() const
             {
-                return file_ != nullptr;
+                return file_.is_open();
             }
 
             basic_filebuf<char_type, traits_type>* open(const char* name, ios_base::openmode mode)
             {
-                if (file_)
-                    return nullptr;
-
-                mode_ = mode;
-                mode = (mode & (~ios_base::ate));
-                const char* mode_str = get_mode_str_(mode);
-
-                if (!mode_str)
+                if (file_.is_open())
                     return nullptr;
 
-                file_ = fopen(name, mode_str);
-                if (!file_)
+                if (!file_.open(name, mode))
                     return nullptr;
+                mode_ = mode;
 
                 if ((mode_ & ios_base::ate) != 0)
                 {
-                    if (fseek(file_, 0, SEEK_END) != 0)
+                    streamoff pos{};
+                    if (!file_.seek(0, ios_base::end, pos))
                     {
                         close();
                         return nullptr;
@@ -154,18 +204,18 @@ namespace std
             basic_filebuf<char_type, traits_type>* close()
             {
                 // TODO: caught exceptions are to be rethrown after closing the file
-                if (!file_)
+                if (!file_.is_open())
                     return nullptr;
-                // TODO: deallocate buffers?
 
-                if (this->output_next_ != this->output_begin_)
-                    overflow(traits_type::eof());
+                bool flushed = flush_();
                 // TODO: unshift? (p. 1084 at the top)
 
-                fclose(file_);
-                file_ = nullptr;
+                bool closed = file_.close();
 
-                return this;
+                this->setg(nullptr, nullptr, nullptr);
+                this->setp(nullptr, nullptr);
+
+                return (flushed && closed) ? this : nullptr;
             }
 
         protected:
@@ -173,50 +223,82 @@ namespace std
              * 27.9.1.5, overriden virtual functions:
              */
 
+            streamsize showmanyc() override
+            {
+                return this->egptr() - this->gptr();
+            }
+
             int_type underflow() override
             {
                 // TODO: use codecvt
-                if (!mode_is_in_(mode_))
+                if (!mode_is_in_(mode_) || !file_.is_open())
                     return traits_type::eof();
 
-                if (!ibuf_)
-                {
-                    ibuf_ = new char_type[buf_size_];
-                    this->input_begin_ = this->input_next_ = this->input_end_ = ibuf_;
-                }
+                if (this->read_avail_())
+                    return traits_type::to_int_type(*this->gptr());
 
-                off_type i{};
-                if (this->input_next_ < this->input_end_)
-                {
-                    auto idx = static_cast<off_type>(this->input_next_ - this->input_begin_);
-                    auto count = static_cast<off_type>(buf_size_) - idx;
+                /**
+                 * Pending output has to reach the file before we read
+                 * from it and the put area stays closed while we are
+                 * reading, so that sputc has to go through overflow.
+                 */
+                if (!flush_())
+                    return traits_type::eof();
+                if (obuf_)
+                    this->setp(obuf_, obuf_);
 
-                    for (; i < count; ++i, ++idx)
-                        ibuf_[i] = ibuf_[idx];
-                }
+                auto count = read_(ibuf_, buf_size_);
+                this->setg(ibuf_, ibuf_, ibuf_ + count);
 
-                for (; i < static_cast<off_type>(buf_size_); ++i)
-                {
-                    auto c = fgetc(file_);
-                    if (c == traits_type::eof())
-                        break;
+                if (count == 0)
+                    return traits_type::eof();
 
-                    ibuf_[i] = static_cast<char_type>(c);
+                return traits_type::to_int_type(*this->gptr());
+            }
 
-                    if (ibuf_[i] == '\n')
+            streamsize xsgetn(char_type* s, streamsize n) override
+            {
+                if (!s || n <= 0)
+                    return 0;
+
+                streamsize res{};
+                while (res < n)
+                {
+                    auto avail = static_cast<streamsize>(this->egptr() - this->gptr());
+                    if (avail > 0)
                     {
-                        ++i;
-                        break;
+                        auto count = (n - res) < avail ? (n - res) : avail;
+                        traits_type::copy(s + res, this->gptr(), count);
+                        this->input_next_ += count;
+                        res += count;
+
+                        continue;
                     }
-                }
 
-                this->input_next_ = this->input_begin_;
-                this->input_end_ = this->input_begin_ + i;
+                    if (!mode_is_in_(mode_) || !file_.is_open())
+                        break;
 
-                if (i == 0)
-                    return traits_type::eof();
+                    /**
+                     * Large requests bypass the buffer and
+                     * go straight to the destination.
+                     */
+                    if (static_cast<size_t>(n - res) >= buf_size_)
+                    {
+                        if (!flush_())
+                            break;
+                        if (obuf_)
+                            this->setp(obuf_, obuf_);
+
+                        auto count = read_(s + res, static_cast<size_t>(n - res));
+                        if (count == 0)
+                            break;
+                        res += count;
+                    }
+                    else if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+                        break;
+                }
 
-                return traits_type::to_int_type(*this->input_next_);
+                return res;
             }
 
             int_type pbackfail(int_type c = traits_type::eof()) override
@@ -251,18 +333,53 @@ namespace std
             int_type overflow(int_type c = traits_type::eof()) override
             {
                 // TODO: use codecvt
-                if (!mode_is_out_(mode_))
+                if (!mode_is_out_(mode_) || !file_.is_open())
                     return traits_type::eof();
 
-                auto count = static_cast<size_t>(this->output_next_ - this->output_begin_);
-                fwrite(obuf_, sizeof(char_type), count, file_);
-                fflush(file_);
+                if (!drop_input_() || !flush_())
+                    return traits_type::eof();
+                this->setp(obuf_, obuf_ + buf_size_);
 
-                this->output_next_ = this->output_begin_;
+                if (!traits_type::eq_int_type(c, traits_type::eof()))
+                    traits_type::assign(*this->output_next_++, traits_type::to_char_type(c));
 
                 return traits_type::not_eof(c);
             }
 
+            streamsize xsputn(const char_type* s, streamsize n) override
+            {
+                if (!s || n <= 0)
+                    return 0;
+
+                auto avail = static_cast<streamsize>(this->epptr() - this->pptr());
+                if (n <= avail)
+                {
+                    traits_type::copy(this->pptr(), s, n);
+                    this->output_next_ += n;
+
+                    return n;
+                }
+
+                if (traits_type::eq_int_type(overflow(), traits_type::eof()))
+                    return 0;
+
+                /**
+                 * Large writes bypass the (now empty) buffer.
+                 */
+                if (static_cast<size_t>(n) >= buf_size_)
+                {
+                    if (!file_.write(s, static_cast<size_t>(n) * sizeof(char_type)))
+                        return 0;
+
+                    return n;
+                }
+
+                traits_type::copy(this->pptr(), s, n);
+                this->output_next_ += n;
+
+                return n;
+            }
+
             basic_streambuf<char_type, traits_type>*
             setbuf(char_type* s, streamsize n) override
             {
@@ -274,25 +391,31 @@ namespace std
             pos_type seekoff(off_type off, ios_base::seekdir dir,
                              ios_base::openmode mode = ios_base::in | ios_base::out) override
             {
-                // TODO: implement
-                __unimplemented();
-                return pos_type{};
+                if (!file_.is_open() || sync() != 0)
+                    return pos_type(off_type(-1));
+
+                streamoff pos{};
+                if (!file_.seek(off * static_cast<off_type>(sizeof(char_type)), dir, pos))
+                    return pos_type(off_type(-1));
+
+                return pos_type(off_type(pos / static_cast<streamoff>(sizeof(char_type))));
             }
 
             pos_type seekpos(pos_type pos,
                              ios_base::openmode mode = ios_base::in | ios_base::out) override
             {
-                // TODO: implement
-                __unimplemented();
-                return pos_type{};
+                return seekoff(off_type(pos), ios_base::beg, mode);
             }
 
             int sync() override
             {
-                if (mode_is_out_(mode_))
-                    overflow();
+                if (!file_.is_open())
+                    return 0;
+
+                if (!flush_() || !drop_input_())
+                    return -1;
 
-                return 0; // TODO: what is the correct return value?
+                return 0;
             }
 
             void imbue(const locale& loc) override
@@ -307,51 +430,9 @@ namespace std
 
             ios_base::openmode mode_;
 
-            FILE* file_;
+            aux::vfs_file file_;
 
-            static constexpr size_t buf_size_{128};
-
-            const char* get_mode_str_(ios_base::openmode mode)
-            {
-                /**
-                 * See table 132.
-                 */
-                switch (mode)
-                {
-                    case ios_base::out:
-                    case ios_base::out | ios_base::trunc:
-                        return "w";
-                    case ios_base::out | ios_base::app:
-                    case ios_base::app:
-                        return "a";
-                    case ios_base::in:
-                        return "r";
-                    case ios_base::in | ios_base::out:
-                        return "r+";
-                    case ios_base::in | ios_base::out | ios_base::trunc:
-                        return "w+";
-                    case ios_base::in | ios_base::out | ios_base::app:
-                    case ios_base::in | ios_base::app:
-                        return "a+";
-                    case ios_base::binary | ios_base::out:
-                    case ios_base::binary | ios_base::out | ios_base::trunc:
-                        return "wb";
-                    case ios_base::binary | ios_base::out | ios_base::app:
-                    case ios_base::binary | ios_base::app:
-                        return "ab";
-                    case ios_base::binary | ios_base::in:
-                        return "rb";
-                    case ios_base::binary | ios_base::in | ios_base::out:
-                        return "r+b";
-                    case ios_base::binary | ios_base::in | ios_base::out | ios_base::trunc:
-                        return "w+b";
-                    case ios_base::binary | ios_base::in | ios_base::out | ios_base::app:
-                    case ios_base::binary | ios_base::in | ios_base::app:
-                        return "a+b";
-                    default:
-                        return nullptr;
-                }
-            }
+            static constexpr size_t buf_size_{8192};
 
             bool mode_is_in_(ios_base::openmode mode)
             {
@@ -365,14 +446,63 @@ namespace std
 
             void init_()
             {
-                if (ibuf_)
-                    this->input_begin_ = this->input_next_ = this->input_end_ = ibuf_;
+                this->setg(ibuf_, ibuf_, ibuf_);
 
                 if (obuf_)
+                    this->setp(obuf_, obuf_ + buf_size_);
+            }
+
+            /**
+             * Writes out the put area.
+             */
+            bool flush_()
+            {
+                auto count = static_cast<size_t>(this->pptr() - this->pbase());
+                if (count == 0)
+                    return true;
+
+                bool res = file_.write(this->pbase(), count * sizeof(char_type));
+                this->setp(obuf_, obuf_ + buf_size_);
+
+                return res;
+            }
+
+            /**
+             * Discards the get area and moves the file position
+             * back to the first character that was not consumed,
+             * which is where the next write has to go.
+             */
+            bool drop_input_()
+            {
+                auto count = static_cast<streamoff>(this->egptr() - this->gptr());
+                this->setg(ibuf_, ibuf_, ibuf_);
+
+                if (count == 0)
+                    return true;
+
+                streamoff pos{};
+                return file_.seek(
+                    -count * static_cast<streamoff>(sizeof(char_type)),
+                    ios_base::cur, pos
+                );
+            }
+
+            size_t read_(char_type* buf, size_t count)
+            {
+                auto bytes = file_.read(buf, count * sizeof(char_type));
+
+                /**
+                 * Note: Do not consume a partially read character,
+                 *       it will be read again in one piece.
+                 */
+                auto rest = static_cast<streamoff>(bytes % sizeof(char_type));
+                if (rest != 0)
                 {
-                    this->output_begin_ = this->output_next_ = obuf_;
-                    this->output_end_ = obuf_ + buf_size_;
+                    streamoff pos{};
+                    file_.seek(-rest, ios_base::cur, pos);
                 }
+
+                return bytes / sizeof(char_type);
             }
     };
 
@@ -36,6 +36,60 @@
 
 namespace std
 {
+    namespace aux
+    {
+        /**
+         * Fast path for decimal integers without padding or
+         * a forced sign. Our only locale does no digit grouping,
+         * so the digits are written straight to the stream buffer
+         * instead of going through num_put, which formats them
+         * with snprintf and then widens them one by one.
+         */
+        template<class Char, class Traits, class T>
+        bool insert_decimal(basic_ostream<Char, Traits>& os, T x)
+        {
+            auto flags = os.flags();
+            auto basefield = (flags & ios_base::basefield);
+
+            if ((basefield != ios_base::dec && basefield != 0) ||
+                (flags & ios_base::showpos) != 0 || os.width() > 0)
+                return false;
+
+            using unsigned_t = make_unsigned_t<T>;
+            unsigned_t val = static_cast<unsigned_t>(x);
+
+            bool negative{false};
+            if constexpr (is_signed_v<T>)
+            {
+                if (x < 0)
+                {
+                    negative = true;
+                    val = unsigned_t{} - val;
+                }
+            }
+
+            // Less than 3 digits per byte plus the sign.
+            Char buf[sizeof(T) * 3 + 1];
+            Char* end = buf + sizeof(T) * 3 + 1;
+            Char* it = end;
+
+            do
+            {
+                *--it = static_cast<Char>('0' + val % 10);
+                val /= 10;
+            } while (val != 0);
+
+            if (negative)
+                *--it = static_cast<Char>('-');
+
+            auto len = static_cast<streamsize>(end - it);
+            if (os.rdbuf()->sputn(it, len) != len)
+                os.setstate(ios_base::badbit);
+
+            return true;
+        }
+    }
+
     /**
      * 27.7.3.1, class template basic_ostream:
      */
@@ -156,6 +210,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     auto basefield = (this->flags() & ios_base::basefield);
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
@@ -177,6 +234,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
                     >(this->getloc()).put(*this, *this, this->fill(),
@@ -195,6 +255,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     auto basefield = (this->flags() & ios_base::basefield);
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
@@ -216,6 +279,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
                     >(this->getloc()).put(*this, *this, this->fill(),
@@ -234,6 +300,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
                     >(this->getloc()).put(*this, *this, this->fill(), x).failed();
@@ -251,6 +320,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
                     >(this->getloc()).put(*this, *this, this->fill(), x).failed();
@@ -268,6 +340,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
                     >(this->getloc()).put(*this, *this, this->fill(), x).failed();
@@ -285,6 +360,9 @@ namespace std
 
                 if (sen)
                 {
+                    if (aux::insert_decimal(*this, x))
+                        return *this;
+
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
                     >(this->getloc()).put(*this, *this, this->fill(), x).failed();
@@ -672,8 +750,52 @@ namespace std
     namespace aux
     {
         template<class Char, class Traits>
+        void insert_fill(basic_ostream<Char, Traits>& os, size_t count)
+        {
+            auto buf = os.rdbuf();
+            auto fill = os.fill();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (Traits::eq_int_type(buf->sputc(fill), Traits::eof()))
+                {
+                    os.setstate(ios_base::badbit);
+                    break;
+                }
+            }
+        }
+
+        /**
+         * Characters that need no widening are handed to the
+         * stream buffer in one sputn call.
+         */
+        template<class Char, class Traits>
         basic_ostream<Char, Traits>& insert(basic_ostream<Char, Traits>& os,
                                             const Char* str, size_t len)
+        {
+            size_t to_pad{};
+            if (os.width() > 0 && static_cast<size_t>(os.width()) > len)
+                to_pad = (static_cast<size_t>(os.width()) - len);
+
+            bool left = (os.flags() & ios_base::adjustfield) == ios_base::left;
+
+            if (!left)
+                insert_fill(os, to_pad);
+
+            auto count = static_cast<streamsize>(len);
+            if (os.rdbuf()->sputn(str, count) != count)
+                os.setstate(ios_base::badbit);
+
+            if (left)
+                insert_fill(os, to_pad);
+
+            os.width(0);
+            return os;
+        }
+
+        template<class Char, class Traits, class C>
+        basic_ostream<Char, Traits>& insert(basic_ostream<Char, Traits>& os,
+                                            const C* str, size_t len)
         {
             if (os.width() > 0 && static_cast<size_t>(os.width()) > len)
             {
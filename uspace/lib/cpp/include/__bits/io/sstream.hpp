@@ -75,6 +75,11 @@ namespace std
                 : mode_{move(other.mode_)}, str_{move(other.str_)}
             {
                 basic_streambuf<char_type, traits_type>::swap(other);
+
+                if ((mode_ & ios_base::in) != 0)
+                    rebase_(this->input_begin_);
+                else if ((mode_ & ios_base::out) != 0)
+                    rebase_(this->output_begin_);
             }
 
             /**
@@ -90,10 +95,16 @@ namespace std
 
             void swap(basic_stringbuf& rhs)
             {
+                const char_type* old_data = str_.data();
+                const char_type* rhs_old_data = rhs.str_.data();
+
                 std::swap(mode_, rhs.mode_);
                 std::swap(str_, rhs.str_);
 
                 basic_streambuf<char_type, traits_type>::swap(rhs);
+
+                rebase_(rhs_old_data);
+                rhs.rebase_(old_data);
             }
 
             /**
@@ -250,6 +261,30 @@ namespace std
                 }
             }
 
+            /**
+             * Short strings keep their characters inside of
+             * the string object, so moving the string moves
+             * the buffer our pointers point to.
+             */
+            void rebase_(const char_type* old_data)
+            {
+                char_type* new_data = str_.begin();
+                if (!old_data || old_data == new_data)
+                    return;
+
+                auto rebase = [old_data, new_data](char_type*& ptr){
+                    if (ptr)
+                        ptr = new_data + (ptr - old_data);
+                };
+
+                rebase(this->input_begin_);
+                rebase(this->input_next_);
+                rebase(this->input_end_);
+                rebase(this->output_begin_);
+                rebase(this->output_next_);
+                rebase(this->output_end_);
+            }
+
             bool ensure_free_space_(size_t n = 1)
             {
                 str_.ensure_free_space_(n);
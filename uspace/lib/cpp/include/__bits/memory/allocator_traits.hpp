@@ -53,15 +53,23 @@ namespace std
         struct has_allocator_type<T, void_t<typename T::allocator_type>>
             : true_type
         { /* DUMMY BODY */ };
+
+        /**
+         * Note: T::allocator_type must not be named
+         *       unless it exists.
+         */
+        template<class T, class Alloc, bool = has_allocator_type<T>::value>
+        struct uses_allocator_impl: false_type
+        { /* DUMMY BODY */ };
+
+        template<class T, class Alloc>
+        struct uses_allocator_impl<T, Alloc, true>
+            : value_is<bool, is_convertible_v<Alloc, typename T::allocator_type>>
+        { /* DUMMY BODY */ };
     }
 
     template<class T, class Alloc>
-    struct uses_allocator
-        : aux::value_is<
-        bool, aux::has_allocator_type<T>::value && is_convertible_v<
-            Alloc, typename T::allocator_type
-        >
-    >
+    struct uses_allocator: aux::uses_allocator_impl<T, Alloc>
     { /* DUMMY BODY */ };
 
     /**
@@ -87,7 +95,7 @@ namespace std
         using is_always_equal                        = typename aux::alloc_get_always_equal<Alloc>::type;
 
         template<class T>
-        using rebind_alloc = typename aux::alloc_get_rebind_alloc<Alloc, T>;
+        using rebind_alloc = typename aux::alloc_get_rebind_alloc<Alloc, T>::type;
 
         template<class T>
         using rebind_traits = allocator_traits<rebind_alloc<T>>;
@@ -145,6 +153,58 @@ namespace std
         }
     };
 
+    namespace aux
+    {
+        /**
+         * Helpers for allocator aware containers, these
+         * replace the allocator of a container on copy
+         * assignment, move assignment and swap only if
+         * the allocator asks for it. Polymorphic allocators
+         * never do, so a container keeps using the memory
+         * resource it was constructed with.
+         */
+
+        template<class Alloc>
+        void alloc_propagate_copy(Alloc& lhs, const Alloc& rhs)
+        {
+            if constexpr (allocator_traits<Alloc>::propagate_on_container_copy_assignment::value)
+                lhs = rhs;
+        }
+
+        template<class Alloc>
+        void alloc_propagate_move(Alloc& lhs, Alloc& rhs)
+        {
+            if constexpr (allocator_traits<Alloc>::propagate_on_container_move_assignment::value)
+                lhs = move(rhs);
+        }
+
+        template<class Alloc>
+        void alloc_propagate_swap(Alloc& lhs, Alloc& rhs)
+        {
+            if constexpr (allocator_traits<Alloc>::propagate_on_container_swap::value)
+            {
+                Alloc tmp{move(lhs)};
+                lhs = move(rhs);
+                rhs = move(tmp);
+            }
+        }
+
+        /**
+         * Returns true if a container using lhs can take over
+         * the memory of a container using rhs on move assignment,
+         * otherwise the elements have to be moved one by one.
+         */
+        template<class Alloc>
+        bool alloc_can_steal(const Alloc& lhs, const Alloc& rhs)
+        {
+            if constexpr (allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+                          allocator_traits<Alloc>::is_always_equal::value)
+                return true;
+            else
+                return lhs == rhs;
+        }
+    }
+
     /**
      * 20.7.9, the default allocator
      */
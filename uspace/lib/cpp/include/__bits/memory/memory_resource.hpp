@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_MEMORY_MEMORY_RESOURCE
+#define LIBCPP_BITS_MEMORY_MEMORY_RESOURCE
+
+#include <__bits/memory/allocator_arg.hpp>
+#include <__bits/memory/allocator_traits.hpp>
+#include <__bits/thread/threading.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace std::pmr
+{
+    /**
+     * C++17 23.12.2, class memory_resource:
+     */
+
+    class memory_resource
+    {
+        public:
+            virtual ~memory_resource();
+
+            void* allocate(size_t bytes, size_t alignment = alignof(max_align_t))
+            {
+                return do_allocate(bytes, alignment);
+            }
+
+            void deallocate(void* ptr, size_t bytes,
+                            size_t alignment = alignof(max_align_t))
+            {
+                do_deallocate(ptr, bytes, alignment);
+            }
+
+            bool is_equal(const memory_resource& other) const noexcept
+            {
+                return do_is_equal(other);
+            }
+
+        private:
+            virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+
+            virtual void do_deallocate(void* ptr, size_t bytes, size_t alignment) = 0;
+
+            virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+    };
+
+    inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept
+    {
+        return &lhs == &rhs || lhs.is_equal(rhs);
+    }
+
+    inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * C++17 23.12.4, global memory resources:
+     */
+
+    memory_resource* new_delete_resource() noexcept;
+
+    memory_resource* null_memory_resource() noexcept;
+
+    memory_resource* set_default_resource(memory_resource* res) noexcept;
+
+    memory_resource* get_default_resource() noexcept;
+
+    /**
+     * C++17 23.12.3, class template polymorphic_allocator:
+     */
+
+    template<class T>
+    class polymorphic_allocator
+    {
+        public:
+            using value_type = T;
+
+            polymorphic_allocator() noexcept
+                : resource_{get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator(memory_resource* res)
+                : resource_{res}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator(const polymorphic_allocator&) = default;
+
+            template<class U>
+            polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+                : resource_{other.resource()}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+            T* allocate(size_t n)
+            {
+                return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T* ptr, size_t n)
+            {
+                resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+            }
+
+            /**
+             * Elements that use polymorphic allocators get
+             * this allocator so that nested containers allocate
+             * from the same resource (uses-allocator construction).
+             */
+            template<class U, class... Args>
+            void construct(U* ptr, Args&&... args)
+            {
+                if constexpr (!uses_allocator<U, polymorphic_allocator>::value)
+                    ::new(static_cast<void*>(ptr)) U(forward<Args>(args)...);
+                else if constexpr (is_constructible_v<U, allocator_arg_t,
+                                                      const polymorphic_allocator&, Args...>)
+                    ::new(static_cast<void*>(ptr)) U(allocator_arg, *this, forward<Args>(args)...);
+                else
+                    ::new(static_cast<void*>(ptr)) U(forward<Args>(args)..., *this);
+            }
+
+            template<class U>
+            void destroy(U* ptr)
+            {
+                ptr->~U();
+            }
+
+            polymorphic_allocator select_on_container_copy_construction() const
+            {
+                return polymorphic_allocator{};
+            }
+
+            memory_resource* resource() const
+            {
+                return resource_;
+            }
+
+        private:
+            memory_resource* resource_;
+    };
+
+    template<class T1, class T2>
+    bool operator==(const polymorphic_allocator<T1>& lhs,
+                    const polymorphic_allocator<T2>& rhs) noexcept
+    {
+        return *lhs.resource() == *rhs.resource();
+    }
+
+    template<class T1, class T2>
+    bool operator!=(const polymorphic_allocator<T1>& lhs,
+                    const polymorphic_allocator<T2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * C++17 23.12.5, pool resource classes:
+     */
+
+    struct pool_options
+    {
+        size_t max_blocks_per_chunk = 0;
+        size_t largest_required_pool_block = 0;
+    };
+}
+
+namespace std::aux
+{
+    /**
+     * Common implementation of the pool resources. Requests
+     * are served from pools of blocks whose sizes are powers
+     * of two, each pool takes chunks of blocks from the upstream
+     * resource (doubling the number of blocks per chunk up to
+     * max_blocks_per_chunk) and keeps freed blocks in a free list.
+     * Requests larger than largest_required_pool_block go
+     * directly to the upstream resource.
+     * Note: Not synchronized.
+     */
+    class pool_set
+    {
+        public:
+            pool_set(const pmr::pool_options& opts, pmr::memory_resource* upstream);
+
+            pool_set(const pool_set&) = delete;
+            pool_set& operator=(const pool_set&) = delete;
+
+            ~pool_set();
+
+            void* allocate(size_t bytes, size_t alignment);
+
+            void deallocate(void* ptr, size_t bytes, size_t alignment);
+
+            void release();
+
+            pmr::memory_resource* upstream() const
+            {
+                return upstream_;
+            }
+
+            pmr::pool_options options() const
+            {
+                return options_;
+            }
+
+        private:
+            struct pool;
+            struct chunk;
+            struct large_block;
+
+            pmr::memory_resource* upstream_;
+            pmr::pool_options options_;
+            pool* pools_;
+            size_t pool_count_;
+            large_block* large_;
+
+            pool* find_pool_(size_t bytes, size_t alignment);
+    };
+}
+
+namespace std::pmr
+{
+    class unsynchronized_pool_resource: public memory_resource
+    {
+        public:
+            unsynchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+                : pools_{opts, upstream}
+            { /* DUMMY BODY */ }
+
+            unsynchronized_pool_resource()
+                : unsynchronized_pool_resource{pool_options{}, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            explicit unsynchronized_pool_resource(memory_resource* upstream)
+                : unsynchronized_pool_resource{pool_options{}, upstream}
+            { /* DUMMY BODY */ }
+
+            explicit unsynchronized_pool_resource(const pool_options& opts)
+                : unsynchronized_pool_resource{opts, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+
+            unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+            virtual ~unsynchronized_pool_resource();
+
+            void release()
+            {
+                pools_.release();
+            }
+
+            memory_resource* upstream_resource() const
+            {
+                return pools_.upstream();
+            }
+
+            pool_options options() const
+            {
+                return pools_.options();
+            }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+
+            void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+            bool do_is_equal(const memory_resource& other) const noexcept override;
+
+        private:
+            aux::pool_set pools_;
+    };
+
+    class synchronized_pool_resource: public memory_resource
+    {
+        public:
+            synchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+                : pools_{opts, upstream}, mtx_{}
+            {
+                aux::threading::mutex::init(mtx_);
+            }
+
+            synchronized_pool_resource()
+                : synchronized_pool_resource{pool_options{}, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            explicit synchronized_pool_resource(memory_resource* upstream)
+                : synchronized_pool_resource{pool_options{}, upstream}
+            { /* DUMMY BODY */ }
+
+            explicit synchronized_pool_resource(const pool_options& opts)
+                : synchronized_pool_resource{opts, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+
+            synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+            virtual ~synchronized_pool_resource();
+
+            void release();
+
+            memory_resource* upstream_resource() const
+            {
+                return pools_.upstream();
+            }
+
+            pool_options options() const
+            {
+                return pools_.options();
+            }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+
+            void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+            bool do_is_equal(const memory_resource& other) const noexcept override;
+
+        private:
+            aux::pool_set pools_;
+            aux::mutex_t mtx_;
+    };
+
+    /**
+     * C++17 23.12.6, class monotonic_buffer_resource:
+     * Hands out memory by bumping a pointer through
+     * a buffer and asks the upstream resource for
+     * geometrically growing buffers when it runs out.
+     * Deallocation does nothing, all memory is given
+     * back at once by release or the destructor.
+     */
+
+    class monotonic_buffer_resource: public memory_resource
+    {
+        public:
+            explicit monotonic_buffer_resource(memory_resource* upstream);
+
+            monotonic_buffer_resource(size_t initial_size, memory_resource* upstream);
+
+            monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                                      memory_resource* upstream);
+
+            monotonic_buffer_resource()
+                : monotonic_buffer_resource{get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            explicit monotonic_buffer_resource(size_t initial_size)
+                : monotonic_buffer_resource{initial_size, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(void* buffer, size_t buffer_size)
+                : monotonic_buffer_resource{buffer, buffer_size, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+
+            monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+            virtual ~monotonic_buffer_resource();
+
+            void release();
+
+            memory_resource* upstream_resource() const
+            {
+                return upstream_;
+            }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+
+            void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+            bool do_is_equal(const memory_resource& other) const noexcept override;
+
+        private:
+            struct chunk;
+
+            memory_resource* upstream_;
+            void* initial_buffer_;
+            size_t initial_size_;
+
+            char* current_;
+            size_t space_;
+            size_t next_size_;
+            chunk* chunks_;
+    };
+}
+
+#endif
@@ -29,8 +29,10 @@
 #ifndef LIBCPP_BITS_MEMORY_SHARED_PAYLOAD
 #define LIBCPP_BITS_MEMORY_SHARED_PAYLOAD
 
+#include <__bits/memory/allocator_traits.hpp>
 #include <__bits/refcount_obj.hpp>
 #include <cinttypes>
+#include <new>
 #include <utility>
 
 namespace std
@@ -67,9 +69,44 @@ namespace std::aux
 
             virtual uint8_t* deleter() const noexcept = 0;
 
-            virtual shared_payload_base* lock() noexcept = 0;
+            shared_payload_base* lock() noexcept
+            {
+                refcount_t rfs = this->refs();
+                while (rfs != 0L)
+                {
+                    if (this->refcount_.compare_exchange_weak(rfs, rfs + 1,
+                                                              memory_order_relaxed))
+                    {
+                        return this;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            /**
+             * Frees the payload once there are no references
+             * of either kind left, the shared object itself
+             * is gone by then.
+             */
+            virtual void release() noexcept
+            {
+                delete this;
+            }
 
             virtual ~shared_payload_base() = default;
+
+        protected:
+            /**
+             * Called by destroy() after the shared object
+             * has been destroyed, removes the weak reference
+             * held on behalf of all shared_ptrs.
+             */
+            void release_weak_() noexcept
+            {
+                if (this->decrement_weak())
+                    release();
+            }
     };
 
     template<class T, class D = default_delete<T>>
@@ -80,72 +117,103 @@ namespace std::aux
                 : data_{ptr}, deleter_{deleter}
             { /* DUMMY BODY */ }
 
-            template<class... Args>
-            shared_payload(Args&&... args)
-                : data_{new T{forward<Args>(args)...}},
-                  deleter_{}
-            { /* DUMMY BODY */ }
+            void destroy() override
+            {
+                if (data_)
+                {
+                    deleter_(data_);
+                    data_ = nullptr;
+                }
 
-            template<class Alloc, class... Args>
-            shared_payload(allocator_arg_t, Alloc alloc, Args&&... args)
-                : data_{alloc.allocate(1)},
-                  deleter_{}
+                this->release_weak_();
+            }
+
+            T* get() const noexcept override
             {
-                alloc.construct(data_, forward<Args>(args)...);
+                return data_;
             }
 
-            template<class Alloc, class... Args>
-            shared_payload(D deleter, Alloc alloc, Args&&... args)
-                : data_{alloc.allocate(1)},
-                  deleter_{deleter}
+            uint8_t* deleter() const noexcept override
             {
-                alloc.construct(data_, forward<Args>(args)...);
+                return (uint8_t*)&deleter_;
             }
 
-            void destroy() override
+        private:
+            T* data_;
+            D deleter_;
+    };
+
+    /**
+     * Payload used by make_shared and allocate_shared,
+     * it holds the shared object itself so that both
+     * are obtained by a single allocation.
+     */
+    template<class T, class Alloc>
+    class shared_inline_payload: public shared_payload_base<T>
+    {
+        using alloc_type = typename allocator_traits<Alloc>::template rebind_alloc<
+            shared_inline_payload
+        >;
+        using alloc_traits = allocator_traits<alloc_type>;
+
+        public:
+            template<class... Args>
+            static shared_inline_payload* create(const Alloc& alloc, Args&&... args)
             {
-                if (this->refs() == 0)
+                alloc_type payload_alloc{alloc};
+                auto payload = alloc_traits::allocate(payload_alloc, 1);
+
+                try
                 {
-                    if (data_)
-                    {
-                        deleter_(data_);
-                        data_ = nullptr;
-                    }
+                    ::new(static_cast<void*>(payload)) shared_inline_payload{
+                        payload_alloc, forward<Args>(args)...
+                    };
+                }
+                catch (...)
+                {
+                    alloc_traits::deallocate(payload_alloc, payload, 1);
 
-                    if (this->weak_refs() == 0)
-                        delete this;
+                    throw;
                 }
+
+                return payload;
+            }
+
+            void destroy() override
+            {
+                get()->~T();
+
+                this->release_weak_();
             }
 
             T* get() const noexcept override
             {
-                return data_;
+                return reinterpret_cast<T*>(const_cast<unsigned char*>(storage_));
             }
 
             uint8_t* deleter() const noexcept override
             {
-                return (uint8_t*)&deleter_;
+                return nullptr;
             }
 
-            shared_payload_base<T>* lock() noexcept override
+            void release() noexcept override
             {
-                refcount_t rfs = this->refs();
-                while (rfs != 0L)
-                {
-                    if (__atomic_compare_exchange_n(&this->refcount_, &rfs, rfs + 1,
-                                                    true, __ATOMIC_RELAXED,
-                                                    __ATOMIC_RELAXED))
-                    {
-                        return this;
-                    }
-                }
+                alloc_type payload_alloc{move(alloc_)};
 
-                return nullptr;
+                this->~shared_inline_payload();
+                alloc_traits::deallocate(payload_alloc, this, 1);
             }
 
         private:
-            T* data_;
-            D deleter_;
+            alloc_type alloc_;
+            alignas(T) unsigned char storage_[sizeof(T)];
+
+            template<class... Args>
+            shared_inline_payload(const alloc_type& alloc, Args&&... args)
+                : alloc_{alloc}
+            {
+                ::new(static_cast<void*>(storage_)) T{forward<Args>(args)...};
+            }
     };
 }
 
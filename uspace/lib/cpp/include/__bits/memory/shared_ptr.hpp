@@ -202,7 +202,14 @@ namespace std
 
                 if (other.payload_)
                 {
+                    /**
+                     * Note: The last shared_ptr might have
+                     *       been destroyed since the check.
+                     */
                     payload_ = other.payload_->lock();
+                    if (!payload_)
+                        throw bad_weak_ptr{};
+
                     data_ = payload_->get();
                 }
             }
@@ -375,7 +382,7 @@ namespace std
             element_type* data_;
 
             shared_ptr(aux::payload_tag_t, aux::shared_payload_base<element_type>* payload)
-                : payload_{payload}, data_{payload->get()}
+                : payload_{payload}, data_{payload ? payload->get() : nullptr}
             { /* DUMMY BODY */ }
 
             void remove_payload_()
@@ -408,11 +415,8 @@ namespace std
 
     /**
      * 20.8.2.2.6, shared_ptr creation:
-     * Note: According to the standard, these two functions
-     *       should perform at most one memory allocation
-     *       (should, don't have to :P). It might be better
-     *       to create payloads that embed the type T to
-     *       perform this optimization.
+     * Note: The object is placed in the same allocation
+     *       as its reference counts.
      */
 
     template<class T, class... Args>
@@ -420,7 +424,9 @@ namespace std
     {
         return shared_ptr<T>{
             aux::payload_tag,
-            new aux::shared_payload<T>{forward<Args>(args)...}
+            aux::shared_inline_payload<T, allocator<T>>::create(
+                allocator<T>{}, forward<Args>(args)...
+            )
         };
     }
 
@@ -429,7 +435,7 @@ namespace std
     {
         return shared_ptr<T>{
             aux::payload_tag,
-            new aux::shared_payload<T>{allocator_arg, A{alloc}, forward<Args>(args)...}
+            aux::shared_inline_payload<T, A>::create(alloc, forward<Args>(args)...)
         };
     }
 
@@ -191,7 +191,9 @@ namespace std
 
             shared_ptr<T> lock() const noexcept
             {
-                return shared_ptr{aux::payload_tag, payload_->lock()};
+                return shared_ptr{
+                    aux::payload_tag, payload_ ? payload_->lock() : nullptr
+                };
             }
 
             template<class U>
@@ -212,7 +214,7 @@ namespace std
             void remove_payload_()
             {
                 if (payload_ && payload_->decrement_weak())
-                    payload_->destroy();
+                    payload_->release();
                 payload_ = nullptr;
             }
 
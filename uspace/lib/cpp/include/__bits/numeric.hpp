@@ -29,6 +29,8 @@
 #ifndef LIBCPP_BITS_NUMERIC
 #define LIBCPP_BITS_NUMERIC
 
+#include <__bits/functional/arithmetic_operations.hpp>
+#include <iterator>
 #include <utility>
 
 namespace std
@@ -59,6 +61,36 @@ namespace std
         return acc;
     }
 
+    /**
+     * C++17 29.8.3, reduce:
+     */
+
+    template<class InputIterator, class T, class BinaryOperation>
+    T reduce(InputIterator first, InputIterator last, T init,
+             BinaryOperation op)
+    {
+        auto acc{init};
+        while (first != last)
+            acc = op(move(acc), *first++);
+
+        return acc;
+    }
+
+    template<class InputIterator, class T>
+    T reduce(InputIterator first, InputIterator last, T init)
+    {
+        return reduce(first, last, move(init), plus<>{});
+    }
+
+    template<class InputIterator>
+    typename iterator_traits<InputIterator>::value_type
+    reduce(InputIterator first, InputIterator last)
+    {
+        using value_type = typename iterator_traits<InputIterator>::value_type;
+
+        return reduce(first, last, value_type{}, plus<>{});
+    }
+
     /**
      * 26.7.3, inner product:
      */
@@ -29,6 +29,14 @@
 #ifndef LIBCPP_BITS_REGEX
 #define LIBCPP_BITS_REGEX
 
-#error "<regex> is not implemented"
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <__bits/regex/regex_algorithms.hpp>
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/regex/regex_engine.hpp>
+#include <__bits/regex/regex_iterator.hpp>
+#include <__bits/regex/regex_replace.hpp>
+#include <__bits/regex/regex_traits.hpp>
+#include <__bits/regex/sub_match.hpp>
 
 #endif
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_BASIC_REGEX
+#define LIBCPP_BITS_REGEX_BASIC_REGEX
+
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/regex/regex_engine.hpp>
+#include <__bits/regex/regex_traits.hpp>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace std
+{
+    namespace aux
+    {
+        struct regex_executor;
+    }
+
+    /**
+     * 28.8, class template basic_regex:
+     * Note: The engine works on bytes, so only
+     *       narrow character regular expressions
+     *       are supported.
+     */
+
+    template<class Char, class Traits = regex_traits<Char>>
+    class basic_regex
+    {
+        static_assert(is_same_v<Char, char>, "basic_regex: only char is supported");
+
+        public:
+            using value_type  = Char;
+            using traits_type = Traits;
+            using string_type = typename Traits::string_type;
+            using flag_type   = regex_constants::syntax_option_type;
+            using locale_type = typename Traits::locale_type;
+
+            /**
+             * 28.8.1, constants:
+             */
+
+            static constexpr flag_type icase      = regex_constants::icase;
+            static constexpr flag_type nosubs     = regex_constants::nosubs;
+            static constexpr flag_type optimize   = regex_constants::optimize;
+            static constexpr flag_type collate    = regex_constants::collate;
+            static constexpr flag_type ECMAScript = regex_constants::ECMAScript;
+            static constexpr flag_type basic      = regex_constants::basic;
+            static constexpr flag_type extended   = regex_constants::extended;
+            static constexpr flag_type awk        = regex_constants::awk;
+            static constexpr flag_type grep       = regex_constants::grep;
+            static constexpr flag_type egrep      = regex_constants::egrep;
+            static constexpr flag_type multiline  = regex_constants::multiline;
+
+            /**
+             * 28.8.2, construct/copy/destroy:
+             */
+
+            basic_regex()
+                : flags_{ECMAScript}, traits_{}, engine_{}
+            { /* DUMMY BODY */ }
+
+            explicit basic_regex(const value_type* str, flag_type flags = ECMAScript)
+                : basic_regex{}
+            {
+                assign(str, flags);
+            }
+
+            basic_regex(const value_type* str, size_t len, flag_type flags = ECMAScript)
+                : basic_regex{}
+            {
+                assign(str, len, flags);
+            }
+
+            basic_regex(const basic_regex& other)
+                : flags_{other.flags_}, traits_{other.traits_}, engine_{other.engine_}
+            { /* DUMMY BODY */ }
+
+            basic_regex(basic_regex&& other) noexcept
+                : flags_{other.flags_}, traits_{move(other.traits_)},
+                  engine_{move(other.engine_)}
+            { /* DUMMY BODY */ }
+
+            template<class ST, class SA>
+            explicit basic_regex(const basic_string<value_type, ST, SA>& str,
+                                 flag_type flags = ECMAScript)
+                : basic_regex{}
+            {
+                assign(str, flags);
+            }
+
+            template<class ForwardIterator>
+            basic_regex(ForwardIterator first, ForwardIterator last,
+                        flag_type flags = ECMAScript)
+                : basic_regex{}
+            {
+                assign(first, last, flags);
+            }
+
+            basic_regex(initializer_list<value_type> init, flag_type flags = ECMAScript)
+                : basic_regex{}
+            {
+                assign(init, flags);
+            }
+
+            ~basic_regex() = default;
+
+            basic_regex& operator=(const basic_regex& other)
+            {
+                return assign(other);
+            }
+
+            basic_regex& operator=(basic_regex&& other) noexcept
+            {
+                return assign(move(other));
+            }
+
+            basic_regex& operator=(const value_type* str)
+            {
+                return assign(str);
+            }
+
+            basic_regex& operator=(initializer_list<value_type> init)
+            {
+                return assign(init);
+            }
+
+            template<class ST, class SA>
+            basic_regex& operator=(const basic_string<value_type, ST, SA>& str)
+            {
+                return assign(str);
+            }
+
+            /**
+             * 28.8.3, assign:
+             */
+
+            basic_regex& assign(const basic_regex& other)
+            {
+                flags_ = other.flags_;
+                traits_ = other.traits_;
+                engine_ = other.engine_;
+
+                return *this;
+            }
+
+            basic_regex& assign(basic_regex&& other) noexcept
+            {
+                flags_ = other.flags_;
+                traits_ = move(other.traits_);
+                engine_ = move(other.engine_);
+
+                return *this;
+            }
+
+            basic_regex& assign(const value_type* str, flag_type flags = ECMAScript)
+            {
+                return assign_(str, traits_type::length(str), flags);
+            }
+
+            basic_regex& assign(const value_type* str, size_t len, flag_type flags = ECMAScript)
+            {
+                return assign_(str, len, flags);
+            }
+
+            template<class ST, class SA>
+            basic_regex& assign(const basic_string<value_type, ST, SA>& str,
+                                flag_type flags = ECMAScript)
+            {
+                return assign_(str.data(), str.size(), flags);
+            }
+
+            template<class InputIterator>
+            basic_regex& assign(InputIterator first, InputIterator last,
+                                flag_type flags = ECMAScript)
+            {
+                string_type str(first, last);
+
+                return assign_(str.data(), str.size(), flags);
+            }
+
+            basic_regex& assign(initializer_list<value_type> init,
+                                flag_type flags = ECMAScript)
+            {
+                return assign_(init.begin(), init.size(), flags);
+            }
+
+            /**
+             * 28.8.4, const operations:
+             */
+
+            unsigned int mark_count() const
+            {
+                if (engine_)
+                    return static_cast<unsigned int>(engine_->mark_count());
+                else
+                    return 0U;
+            }
+
+            flag_type flags() const
+            {
+                return flags_;
+            }
+
+            /**
+             * 28.8.5, locale:
+             */
+
+            locale_type imbue(locale_type loc)
+            {
+                /**
+                 * The expression has to be assigned again
+                 * after a change of the locale.
+                 */
+                engine_.reset();
+
+                return traits_.imbue(loc);
+            }
+
+            locale_type getloc() const
+            {
+                return traits_.getloc();
+            }
+
+            /**
+             * 28.8.6, swap:
+             */
+
+            void swap(basic_regex& other)
+            {
+                std::swap(flags_, other.flags_);
+                std::swap(traits_, other.traits_);
+                engine_.swap(other.engine_);
+            }
+
+        private:
+            flag_type flags_;
+            traits_type traits_;
+
+            /**
+             * Compiled expression shared by copies, a regex
+             * without an engine does not match anything.
+             */
+            shared_ptr<aux::regex_engine> engine_;
+
+            basic_regex& assign_(const value_type* str, size_t len, flag_type flags)
+            {
+                regex_constants::error_type err{};
+                auto engine = aux::regex_engine::compile(str, len, flags, err);
+
+                /**
+                 * Note: If the pattern is invalid, the regex
+                 *       is left unchanged.
+                 */
+                if (engine)
+                {
+                    engine_ = shared_ptr<aux::regex_engine>{engine};
+                    flags_ = flags;
+                }
+                else
+                {
+                    throw regex_error{err};
+                }
+
+                return *this;
+            }
+
+            friend struct aux::regex_executor;
+    };
+
+    template<class Char, class Traits>
+    void swap(basic_regex<Char, Traits>& lhs, basic_regex<Char, Traits>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    using regex  = basic_regex<char>;
+    using wregex = basic_regex<wchar_t>;
+}
+
+#endif
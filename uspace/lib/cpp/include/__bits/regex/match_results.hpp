@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_MATCH_RESULTS
+#define LIBCPP_BITS_REGEX_MATCH_RESULTS
+
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/regex/sub_match.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace std
+{
+    namespace aux
+    {
+        struct regex_executor;
+    }
+
+    template<class, class, class>
+    class regex_iterator;
+
+    /**
+     * 28.10, class template match_results:
+     */
+
+    template<
+        class BidirectionalIterator,
+        class Alloc = allocator<sub_match<BidirectionalIterator>>
+    >
+    class match_results
+    {
+        public:
+            using value_type      = sub_match<BidirectionalIterator>;
+            using const_reference = const value_type&;
+            using reference       = value_type&;
+            using const_iterator  = typename vector<value_type, Alloc>::const_iterator;
+            using iterator        = const_iterator;
+            using difference_type = typename iterator_traits<BidirectionalIterator>::difference_type;
+            using size_type       = typename allocator_traits<Alloc>::size_type;
+            using allocator_type  = Alloc;
+            using char_type       = typename iterator_traits<BidirectionalIterator>::value_type;
+            using string_type     = basic_string<char_type>;
+
+            /**
+             * 28.10.1, construct/copy/destroy:
+             */
+
+            explicit match_results(const Alloc& alloc = Alloc{})
+                : subs_{alloc}, prefix_{}, suffix_{}, unmatched_{},
+                  begin_{}, ready_{false}
+            { /* DUMMY BODY */ }
+
+            match_results(const match_results& other) = default;
+
+            match_results(match_results&& other) = default;
+
+            match_results& operator=(const match_results& other) = default;
+
+            match_results& operator=(match_results&& other) = default;
+
+            ~match_results() = default;
+
+            /**
+             * 28.10.2, state:
+             */
+
+            bool ready() const
+            {
+                return ready_;
+            }
+
+            /**
+             * 28.10.3, size:
+             */
+
+            size_type size() const
+            {
+                return subs_.size();
+            }
+
+            size_type max_size() const
+            {
+                return subs_.max_size();
+            }
+
+            bool empty() const
+            {
+                return size() == 0;
+            }
+
+            /**
+             * 28.10.4, element access:
+             */
+
+            difference_type length(size_type sub = 0) const
+            {
+                return (*this)[sub].length();
+            }
+
+            difference_type position(size_type sub = 0) const
+            {
+                return distance(begin_, (*this)[sub].first);
+            }
+
+            string_type str(size_type sub = 0) const
+            {
+                return string_type((*this)[sub]);
+            }
+
+            const_reference operator[](size_type n) const
+            {
+                if (n < size())
+                    return subs_[n];
+                else
+                    return unmatched_;
+            }
+
+            const_reference prefix() const
+            {
+                return prefix_;
+            }
+
+            const_reference suffix() const
+            {
+                return suffix_;
+            }
+
+            const_iterator begin() const
+            {
+                return subs_.begin();
+            }
+
+            const_iterator end() const
+            {
+                return subs_.end();
+            }
+
+            const_iterator cbegin() const
+            {
+                return subs_.cbegin();
+            }
+
+            const_iterator cend() const
+            {
+                return subs_.cend();
+            }
+
+            /**
+             * 28.10.5, format:
+             */
+
+            template<class OutputIterator>
+            OutputIterator format(
+                OutputIterator out, const char_type* fmt_first, const char_type* fmt_last,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                if (flags & regex_constants::format_sed)
+                    return format_sed_(out, fmt_first, fmt_last);
+
+                /**
+                 * ECMAScript rules: $$, $&, $`, $' and $n or $nn
+                 * for the n-th sub match, a two digit reference
+                 * is only used if such a sub match exists.
+                 */
+                while (fmt_first != fmt_last)
+                {
+                    auto c = *fmt_first++;
+                    if (c != '$' || fmt_first == fmt_last)
+                    {
+                        *out++ = c;
+                        continue;
+                    }
+
+                    auto next = *fmt_first;
+                    if (next == '$')
+                    {
+                        *out++ = '$';
+                        ++fmt_first;
+                    }
+                    else if (next == '&')
+                    {
+                        out = copy_(out, (*this)[0]);
+                        ++fmt_first;
+                    }
+                    else if (next == '`')
+                    {
+                        out = copy_(out, prefix());
+                        ++fmt_first;
+                    }
+                    else if (next == '\'')
+                    {
+                        out = copy_(out, suffix());
+                        ++fmt_first;
+                    }
+                    else if (next >= '0' && next <= '9')
+                    {
+                        size_type idx = static_cast<size_type>(next - '0');
+                        ++fmt_first;
+
+                        if (fmt_first != fmt_last && *fmt_first >= '0' && *fmt_first <= '9')
+                        {
+                            auto idx2 = idx * 10 + static_cast<size_type>(*fmt_first - '0');
+                            if (idx2 < size())
+                            {
+                                idx = idx2;
+                                ++fmt_first;
+                            }
+                        }
+
+                        out = copy_(out, (*this)[idx]);
+                    }
+                    else
+                        *out++ = c;
+                }
+
+                return out;
+            }
+
+            template<class OutputIterator, class ST, class SA>
+            OutputIterator format(
+                OutputIterator out, const basic_string<char_type, ST, SA>& fmt,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                return format(out, fmt.data(), fmt.data() + fmt.size(), flags);
+            }
+
+            template<class ST, class SA>
+            basic_string<char_type, ST, SA> format(
+                const basic_string<char_type, ST, SA>& fmt,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                basic_string<char_type, ST, SA> res{};
+                format(back_inserter(res), fmt, flags);
+
+                return res;
+            }
+
+            string_type format(
+                const char_type* fmt,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                string_type res{};
+                format(back_inserter(res), fmt, fmt + char_traits<char_type>::length(fmt), flags);
+
+                return res;
+            }
+
+            /**
+             * 28.10.6, allocator:
+             */
+
+            allocator_type get_allocator() const
+            {
+                return subs_.get_allocator();
+            }
+
+            /**
+             * 28.10.7, swap:
+             */
+
+            void swap(match_results& other)
+            {
+                std::swap(subs_, other.subs_);
+                std::swap(prefix_, other.prefix_);
+                std::swap(suffix_, other.suffix_);
+                std::swap(unmatched_, other.unmatched_);
+                std::swap(begin_, other.begin_);
+                std::swap(ready_, other.ready_);
+            }
+
+        private:
+            vector<value_type, Alloc> subs_;
+            value_type prefix_;
+            value_type suffix_;
+            value_type unmatched_;
+
+            /**
+             * Start of the whole target sequence, positions
+             * are relative to it (it differs from the start
+             * of the searched range in regex_iterator).
+             */
+            BidirectionalIterator begin_;
+
+            bool ready_;
+
+            template<class OutputIterator>
+            static OutputIterator copy_(OutputIterator out, const value_type& sub)
+            {
+                if (!sub.matched)
+                    return out;
+
+                for (auto it = sub.first; it != sub.second; ++it)
+                    *out++ = *it;
+
+                return out;
+            }
+
+            template<class OutputIterator>
+            OutputIterator format_sed_(OutputIterator out, const char_type* fmt_first,
+                                       const char_type* fmt_last) const
+            {
+                while (fmt_first != fmt_last)
+                {
+                    auto c = *fmt_first++;
+                    if (c == '&')
+                        out = copy_(out, (*this)[0]);
+                    else if (c == '\\' && fmt_first != fmt_last)
+                    {
+                        auto next = *fmt_first++;
+                        if (next >= '0' && next <= '9')
+                            out = copy_(out, (*this)[static_cast<size_type>(next - '0')]);
+                        else
+                            *out++ = next;
+                    }
+                    else
+                        *out++ = c;
+                }
+
+                return out;
+            }
+
+            /**
+             * Results of a failed search of [first, last).
+             */
+            void set_failed_(BidirectionalIterator first, BidirectionalIterator last)
+            {
+                subs_.clear();
+                prefix_ = value_type{};
+                suffix_ = value_type{};
+                unmatched_.first = last;
+                unmatched_.second = last;
+                unmatched_.matched = false;
+                begin_ = first;
+                ready_ = true;
+            }
+
+            friend struct aux::regex_executor;
+
+            template<class, class, class>
+            friend class regex_iterator;
+    };
+
+    using cmatch  = match_results<const char*>;
+    using wcmatch = match_results<const wchar_t*>;
+    using smatch  = match_results<string::const_iterator>;
+    using wsmatch = match_results<wstring::const_iterator>;
+
+    template<class BidiIt, class Alloc>
+    bool operator==(const match_results<BidiIt, Alloc>& lhs,
+                    const match_results<BidiIt, Alloc>& rhs)
+    {
+        if (!lhs.ready() && !rhs.ready())
+            return true;
+        if (lhs.empty() || rhs.empty())
+            return lhs.empty() && rhs.empty();
+
+        if (lhs.prefix() != rhs.prefix() || lhs.suffix() != rhs.suffix() ||
+            lhs.size() != rhs.size())
+            return false;
+
+        for (typename match_results<BidiIt, Alloc>::size_type i = 0; i < lhs.size(); ++i)
+        {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    template<class BidiIt, class Alloc>
+    bool operator!=(const match_results<BidiIt, Alloc>& lhs,
+                    const match_results<BidiIt, Alloc>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidiIt, class Alloc>
+    void swap(match_results<BidiIt, Alloc>& lhs, match_results<BidiIt, Alloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_ALGORITHMS
+#define LIBCPP_BITS_REGEX_REGEX_ALGORITHMS
+
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace std
+{
+    namespace aux
+    {
+        /**
+         * Runs the engine of a regex over a range, the engine
+         * needs contiguous bytes, so ranges given by anything
+         * else than pointers are copied first.
+         */
+        struct regex_executor
+        {
+            template<class BidiIt, class Alloc, class Char, class Traits>
+            static bool execute(BidiIt first, BidiIt last, match_results<BidiIt, Alloc>* m,
+                                const basic_regex<Char, Traits>& re,
+                                regex_constants::match_flag_type flags,
+                                regex_engine::mode md)
+            {
+                if (!re.engine_)
+                {
+                    if (m)
+                        m->set_failed_(first, last);
+
+                    return false;
+                }
+
+                char prev{};
+                if (flags & regex_constants::match_prev_avail)
+                    prev = *std::prev(first);
+
+                const char* data_first{};
+                const char* data_last{};
+                basic_string<Char> copy{};
+                if constexpr (is_pointer_v<BidiIt>)
+                {
+                    data_first = first;
+                    data_last = last;
+                }
+                else
+                {
+                    copy.assign(first, last);
+                    data_first = copy.data();
+                    data_last = data_first + copy.size();
+                }
+
+                if (!m)
+                    return re.engine_->execute(data_first, data_last, prev, flags, md, nullptr);
+
+                auto marks = re.engine_->mark_count();
+                vector<ptrdiff_t> groups(2 * (marks + 1));
+                if (!re.engine_->execute(data_first, data_last, prev, flags, md, groups.data()))
+                {
+                    m->set_failed_(first, last);
+
+                    return false;
+                }
+
+                m->subs_.resize(marks + 1);
+                for (size_t i = 0; i <= marks; ++i)
+                {
+                    auto& sub = m->subs_[i];
+                    if (groups[2 * i] == regex_engine::no_pos)
+                    {
+                        sub.first = last;
+                        sub.second = last;
+                        sub.matched = false;
+                    }
+                    else
+                    {
+                        sub.first = next(first, groups[2 * i]);
+                        sub.second = next(first, groups[2 * i + 1]);
+                        sub.matched = true;
+                    }
+                }
+
+                m->prefix_.first = first;
+                m->prefix_.second = m->subs_[0].first;
+                m->prefix_.matched = m->prefix_.first != m->prefix_.second;
+                m->suffix_.first = m->subs_[0].second;
+                m->suffix_.second = last;
+                m->suffix_.matched = m->suffix_.first != m->suffix_.second;
+                m->unmatched_.first = last;
+                m->unmatched_.second = last;
+                m->unmatched_.matched = false;
+                m->begin_ = first;
+                m->ready_ = true;
+
+                return true;
+            }
+        };
+    }
+
+    /**
+     * 28.11.2, function template regex_match:
+     */
+
+    template<class BidiIt, class Alloc, class Char, class Traits>
+    bool regex_match(BidiIt first, BidiIt last, match_results<BidiIt, Alloc>& m,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_executor::execute(
+            first, last, &m, re, flags, aux::regex_engine::mode::match
+        );
+    }
+
+    template<class BidiIt, class Char, class Traits>
+    bool regex_match(BidiIt first, BidiIt last, const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_executor::execute(
+            first, last, static_cast<match_results<BidiIt>*>(nullptr),
+            re, flags, aux::regex_engine::mode::match
+        );
+    }
+
+    template<class Char, class Alloc, class Traits>
+    bool regex_match(const Char* str, match_results<const Char*, Alloc>& m,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + char_traits<Char>::length(str), m, re, flags);
+    }
+
+    template<class ST, class SA, class Alloc, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>& str,
+                     match_results<typename basic_string<Char, ST, SA>::const_iterator, Alloc>& m,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str.begin(), str.end(), m, re, flags);
+    }
+
+    template<class ST, class SA, class Alloc, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>&&,
+                     match_results<typename basic_string<Char, ST, SA>::const_iterator, Alloc>&,
+                     const basic_regex<Char, Traits>&,
+                     regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+    template<class Char, class Traits>
+    bool regex_match(const Char* str, const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + char_traits<Char>::length(str), re, flags);
+    }
+
+    template<class ST, class SA, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>& str,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str.begin(), str.end(), re, flags);
+    }
+
+    /**
+     * 28.11.3, function template regex_search:
+     */
+
+    template<class BidiIt, class Alloc, class Char, class Traits>
+    bool regex_search(BidiIt first, BidiIt last, match_results<BidiIt, Alloc>& m,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_executor::execute(
+            first, last, &m, re, flags, aux::regex_engine::mode::search
+        );
+    }
+
+    template<class BidiIt, class Char, class Traits>
+    bool regex_search(BidiIt first, BidiIt last, const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_executor::execute(
+            first, last, static_cast<match_results<BidiIt>*>(nullptr),
+            re, flags, aux::regex_engine::mode::search
+        );
+    }
+
+    template<class Char, class Alloc, class Traits>
+    bool regex_search(const Char* str, match_results<const Char*, Alloc>& m,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + char_traits<Char>::length(str), m, re, flags);
+    }
+
+    template<class Char, class Traits>
+    bool regex_search(const Char* str, const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + char_traits<Char>::length(str), re, flags);
+    }
+
+    template<class ST, class SA, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>& str,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str.begin(), str.end(), re, flags);
+    }
+
+    template<class ST, class SA, class Alloc, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>& str,
+                      match_results<typename basic_string<Char, ST, SA>::const_iterator, Alloc>& m,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str.begin(), str.end(), m, re, flags);
+    }
+
+    template<class ST, class SA, class Alloc, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>&&,
+                      match_results<typename basic_string<Char, ST, SA>::const_iterator, Alloc>&,
+                      const basic_regex<Char, Traits>&,
+                      regex_constants::match_flag_type = regex_constants::match_default) = delete;
+}
+
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_CONSTANTS
+#define LIBCPP_BITS_REGEX_REGEX_CONSTANTS
+
+#include <__bits/stdexcept.hpp>
+
+namespace std
+{
+    /**
+     * 28.5, namespace std::regex_constants:
+     */
+
+    namespace regex_constants
+    {
+        /**
+         * 28.5.1, bitmask type syntax_option_type:
+         */
+
+        enum syntax_option_type: unsigned int
+        {
+            icase      = 1U << 0,
+            nosubs     = 1U << 1,
+            optimize   = 1U << 2,
+            collate    = 1U << 3,
+            ECMAScript = 1U << 4,
+            basic      = 1U << 5,
+            extended   = 1U << 6,
+            awk        = 1U << 7,
+            grep       = 1U << 8,
+            egrep      = 1U << 9,
+            multiline  = 1U << 10
+        };
+
+        constexpr syntax_option_type operator&(syntax_option_type lhs, syntax_option_type rhs)
+        {
+            return static_cast<syntax_option_type>(
+                static_cast<unsigned int>(lhs) & static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr syntax_option_type operator|(syntax_option_type lhs, syntax_option_type rhs)
+        {
+            return static_cast<syntax_option_type>(
+                static_cast<unsigned int>(lhs) | static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr syntax_option_type operator^(syntax_option_type lhs, syntax_option_type rhs)
+        {
+            return static_cast<syntax_option_type>(
+                static_cast<unsigned int>(lhs) ^ static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr syntax_option_type operator~(syntax_option_type opt)
+        {
+            return static_cast<syntax_option_type>(~static_cast<unsigned int>(opt));
+        }
+
+        inline syntax_option_type& operator&=(syntax_option_type& lhs, syntax_option_type rhs)
+        {
+            return lhs = lhs & rhs;
+        }
+
+        inline syntax_option_type& operator|=(syntax_option_type& lhs, syntax_option_type rhs)
+        {
+            return lhs = lhs | rhs;
+        }
+
+        inline syntax_option_type& operator^=(syntax_option_type& lhs, syntax_option_type rhs)
+        {
+            return lhs = lhs ^ rhs;
+        }
+
+        /**
+         * 28.5.2, bitmask type match_flag_type:
+         */
+
+        enum match_flag_type: unsigned int
+        {
+            match_default     = 0,
+            match_not_bol     = 1U << 0,
+            match_not_eol     = 1U << 1,
+            match_not_bow     = 1U << 2,
+            match_not_eow     = 1U << 3,
+            match_any         = 1U << 4,
+            match_not_null    = 1U << 5,
+            match_continuous  = 1U << 6,
+            match_prev_avail  = 1U << 7,
+            format_default    = 0,
+            format_sed        = 1U << 8,
+            format_no_copy    = 1U << 9,
+            format_first_only = 1U << 10
+        };
+
+        constexpr match_flag_type operator&(match_flag_type lhs, match_flag_type rhs)
+        {
+            return static_cast<match_flag_type>(
+                static_cast<unsigned int>(lhs) & static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr match_flag_type operator|(match_flag_type lhs, match_flag_type rhs)
+        {
+            return static_cast<match_flag_type>(
+                static_cast<unsigned int>(lhs) | static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr match_flag_type operator^(match_flag_type lhs, match_flag_type rhs)
+        {
+            return static_cast<match_flag_type>(
+                static_cast<unsigned int>(lhs) ^ static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr match_flag_type operator~(match_flag_type flags)
+        {
+            return static_cast<match_flag_type>(~static_cast<unsigned int>(flags));
+        }
+
+        inline match_flag_type& operator&=(match_flag_type& lhs, match_flag_type rhs)
+        {
+            return lhs = lhs & rhs;
+        }
+
+        inline match_flag_type& operator|=(match_flag_type& lhs, match_flag_type rhs)
+        {
+            return lhs = lhs | rhs;
+        }
+
+        inline match_flag_type& operator^=(match_flag_type& lhs, match_flag_type rhs)
+        {
+            return lhs = lhs ^ rhs;
+        }
+
+        /**
+         * 28.5.3, implementation defined error_type:
+         */
+
+        enum error_type
+        {
+            error_collate = 1,
+            error_ctype,
+            error_escape,
+            error_backref,
+            error_brack,
+            error_paren,
+            error_brace,
+            error_badbrace,
+            error_range,
+            error_space,
+            error_badrepeat,
+            error_complexity,
+            error_stack
+        };
+    }
+
+    /**
+     * 28.6, class regex_error:
+     */
+
+    class regex_error: public runtime_error
+    {
+        public:
+            explicit regex_error(regex_constants::error_type ecode);
+
+            regex_constants::error_type code() const;
+
+        private:
+            regex_constants::error_type code_;
+    };
+}
+
+#endif
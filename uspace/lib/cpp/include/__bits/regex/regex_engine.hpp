@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_ENGINE
+#define LIBCPP_BITS_REGEX_REGEX_ENGINE
+
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/thread/threading.hpp>
+#include <cstddef>
+
+namespace std::aux
+{
+    struct regex_program;
+    class regex_dfa;
+
+    /**
+     * Compiled form of a regular expression shared by all
+     * copies of a basic_regex. The pattern is compiled into
+     * a Thompson NFA that is executed by a lazily built DFA
+     * whose states are cached between searches, which keeps
+     * matching linear in the length of the input without
+     * the exponential blowup of backtracking engines.
+     * The NFA is only simulated directly (a Pike VM) when
+     * the positions of capture groups are needed, and then
+     * only over the part of the input the DFA determined
+     * to contain the match.
+     *
+     * Note: Because of this, back references and lookahead
+     *       assertions (which are not regular) are rejected
+     *       with error_backref and error_complexity respectively.
+     *       Also, when a repeated subexpression can match the
+     *       empty string, the automaton may select a different
+     *       (still valid) match than a backtracking ECMAScript
+     *       engine would, e.g. (?:a??)+ matches "" in "aa".
+     */
+    class regex_engine
+    {
+        public:
+            enum class mode
+            {
+                search, match
+            };
+
+            /**
+             * Value of group offsets of groups that
+             * did not participate in the match.
+             */
+            static constexpr ptrdiff_t no_pos{-1};
+
+            /**
+             * Returns nullptr and sets err if the pattern
+             * is not valid in the grammar given by flags.
+             */
+            static regex_engine* compile(const char* pattern, size_t len,
+                                         regex_constants::syntax_option_type flags,
+                                         regex_constants::error_type& err);
+
+            ~regex_engine();
+
+            size_t mark_count() const noexcept;
+
+            /**
+             * Looks for a match in [first, last), prev is the character
+             * before first used when match_prev_avail is set. If groups
+             * is not nullptr, it has to have room for 2 * (mark_count() + 1)
+             * offsets (relative to first) of the starts and ends of
+             * the whole match and all capture groups.
+             */
+            bool execute(const char* first, const char* last, char prev,
+                         regex_constants::match_flag_type flags, mode md,
+                         ptrdiff_t* groups) const;
+
+            regex_engine(const regex_engine&) = delete;
+            regex_engine& operator=(const regex_engine&) = delete;
+
+        private:
+            regex_engine(regex_program* prog);
+
+            regex_program* prog_;
+
+            /**
+             * One lazy DFA for searching and one for
+             * matching the whole input, the latter
+             * cannot stop at the first match it sees.
+             */
+            regex_dfa* search_dfa_;
+            regex_dfa* match_dfa_;
+
+            /**
+             * Guards the DFA caches, a search that finds
+             * them in use by another thread falls back
+             * to the NFA simulation instead of waiting.
+             */
+            mutable mutex_t mutex_;
+    };
+}
+
+#endif
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_ITERATOR
+#define LIBCPP_BITS_REGEX_REGEX_ITERATOR
+
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <__bits/regex/regex_algorithms.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace std
+{
+    /**
+     * 28.12.1, class template regex_iterator:
+     */
+
+    template<
+        class BidirectionalIterator,
+        class Char = typename iterator_traits<BidirectionalIterator>::value_type,
+        class Traits = regex_traits<Char>
+    >
+    class regex_iterator
+    {
+        public:
+            using regex_type        = basic_regex<Char, Traits>;
+            using value_type        = match_results<BidirectionalIterator>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+            using iterator_category = forward_iterator_tag;
+
+            regex_iterator()
+                : begin_{}, end_{}, regex_{nullptr},
+                  flags_{regex_constants::match_default}, match_{}
+            { /* DUMMY BODY */ }
+
+            regex_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                           const regex_type& re,
+                           regex_constants::match_flag_type flags = regex_constants::match_default)
+                : begin_{first}, end_{last}, regex_{&re}, flags_{flags}, match_{}
+            {
+                if (!regex_search(begin_, end_, match_, *regex_, flags_))
+                    regex_ = nullptr;
+            }
+
+            regex_iterator(BidirectionalIterator, BidirectionalIterator, const regex_type&&,
+                           regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_iterator(const regex_iterator&) = default;
+            regex_iterator& operator=(const regex_iterator&) = default;
+
+            bool operator==(const regex_iterator& other) const
+            {
+                if (!regex_ || !other.regex_)
+                    return !regex_ && !other.regex_;
+
+                return begin_ == other.begin_ && end_ == other.end_ &&
+                       regex_ == other.regex_ && flags_ == other.flags_ &&
+                       match_[0] == other.match_[0];
+            }
+
+            bool operator!=(const regex_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            const value_type& operator*() const
+            {
+                return match_;
+            }
+
+            const value_type* operator->() const
+            {
+                return &match_;
+            }
+
+            regex_iterator& operator++()
+            {
+                auto start = match_[0].second;
+                auto prev_end = start;
+
+                /**
+                 * After an empty match, a non empty match at the
+                 * same position is tried first, then the search
+                 * continues one character further.
+                 */
+                if (match_[0].first == match_[0].second)
+                {
+                    if (start == end_)
+                    {
+                        regex_ = nullptr;
+
+                        return *this;
+                    }
+
+                    auto flags = flags_ | regex_constants::match_not_null |
+                                 regex_constants::match_continuous;
+                    if (start != begin_)
+                        flags |= regex_constants::match_prev_avail;
+
+                    if (regex_search(start, end_, match_, *regex_, flags))
+                    {
+                        fix_match_(prev_end);
+
+                        return *this;
+                    }
+
+                    ++start;
+                }
+
+                flags_ |= regex_constants::match_prev_avail;
+                if (regex_search(start, end_, match_, *regex_, flags_))
+                    fix_match_(prev_end);
+                else
+                    regex_ = nullptr;
+
+                return *this;
+            }
+
+            regex_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+        private:
+            BidirectionalIterator begin_;
+            BidirectionalIterator end_;
+            const regex_type* regex_;
+            regex_constants::match_flag_type flags_;
+            value_type match_;
+
+            void fix_match_(BidirectionalIterator prev_end)
+            {
+                match_.prefix_.first = prev_end;
+                match_.prefix_.matched = match_.prefix_.first != match_.prefix_.second;
+                match_.begin_ = begin_;
+            }
+    };
+
+    using cregex_iterator  = regex_iterator<const char*>;
+    using wcregex_iterator = regex_iterator<const wchar_t*>;
+    using sregex_iterator  = regex_iterator<string::const_iterator>;
+    using wsregex_iterator = regex_iterator<wstring::const_iterator>;
+
+    /**
+     * 28.12.2, class template regex_token_iterator:
+     */
+
+    template<
+        class BidirectionalIterator,
+        class Char = typename iterator_traits<BidirectionalIterator>::value_type,
+        class Traits = regex_traits<Char>
+    >
+    class regex_token_iterator
+    {
+        public:
+            using regex_type        = basic_regex<Char, Traits>;
+            using value_type        = sub_match<BidirectionalIterator>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+            using iterator_category = forward_iterator_tag;
+
+            regex_token_iterator()
+                : position_{}, result_{nullptr}, suffix_{}, idx_{}, subs_{}
+            { /* DUMMY BODY */ }
+
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, int submatch = 0,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{}, result_{nullptr}, suffix_{}, idx_{}, subs_{}
+            {
+                subs_.push_back(submatch);
+                init_(first, last, re, flags);
+            }
+
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, const vector<int>& submatches,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{}, result_{nullptr}, suffix_{}, idx_{}, subs_{submatches}
+            {
+                init_(first, last, re, flags);
+            }
+
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, initializer_list<int> submatches,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{}, result_{nullptr}, suffix_{}, idx_{}, subs_{submatches}
+            {
+                init_(first, last, re, flags);
+            }
+
+            template<size_t N>
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, const int (&submatches)[N],
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{}, result_{nullptr}, suffix_{}, idx_{},
+                  subs_(submatches, submatches + N)
+            {
+                init_(first, last, re, flags);
+            }
+
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, int = 0,
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, const vector<int>&,
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, initializer_list<int>,
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            template<size_t N>
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, const int (&)[N],
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_token_iterator(const regex_token_iterator& other)
+                : position_{other.position_}, result_{nullptr}, suffix_{other.suffix_},
+                  idx_{other.idx_}, subs_{other.subs_}
+            {
+                fix_result_(other);
+            }
+
+            regex_token_iterator& operator=(const regex_token_iterator& other)
+            {
+                position_ = other.position_;
+                suffix_ = other.suffix_;
+                idx_ = other.idx_;
+                subs_ = other.subs_;
+                fix_result_(other);
+
+                return *this;
+            }
+
+            bool operator==(const regex_token_iterator& other) const
+            {
+                if (!result_ || !other.result_)
+                    return !result_ && !other.result_;
+
+                bool suffix = result_ == &suffix_;
+                bool other_suffix = other.result_ == &other.suffix_;
+                if (suffix || other_suffix)
+                    return suffix && other_suffix && suffix_ == other.suffix_;
+
+                return position_ == other.position_ && idx_ == other.idx_ &&
+                       subs_ == other.subs_;
+            }
+
+            bool operator!=(const regex_token_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            const value_type& operator*() const
+            {
+                return *result_;
+            }
+
+            const value_type* operator->() const
+            {
+                return result_;
+            }
+
+            regex_token_iterator& operator++()
+            {
+                if (result_ == &suffix_)
+                {
+                    result_ = nullptr;
+
+                    return *this;
+                }
+
+                if (idx_ + 1 < subs_.size())
+                {
+                    ++idx_;
+                    result_ = &current_();
+
+                    return *this;
+                }
+
+                auto prev = position_;
+                ++position_;
+                idx_ = 0;
+
+                if (position_ != position_iterator{})
+                    result_ = &current_();
+                else if (has_prefix_() && prev->suffix().length() != 0)
+                {
+                    suffix_ = prev->suffix();
+                    result_ = &suffix_;
+                }
+                else
+                    result_ = nullptr;
+
+                return *this;
+            }
+
+            regex_token_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+        private:
+            using position_iterator = regex_iterator<BidirectionalIterator, Char, Traits>;
+
+            position_iterator position_;
+            const value_type* result_;
+            value_type suffix_;
+            size_t idx_;
+            vector<int> subs_;
+
+            void init_(BidirectionalIterator first, BidirectionalIterator last,
+                       const regex_type& re, regex_constants::match_flag_type flags)
+            {
+                position_ = position_iterator{first, last, re, flags};
+                idx_ = 0;
+
+                if (position_ != position_iterator{})
+                    result_ = &current_();
+                else if (has_prefix_())
+                {
+                    /**
+                     * Without any match, the whole
+                     * sequence is the only token.
+                     */
+                    suffix_.first = first;
+                    suffix_.second = last;
+                    suffix_.matched = first != last;
+                    result_ = &suffix_;
+                }
+                else
+                    result_ = nullptr;
+            }
+
+            bool has_prefix_() const
+            {
+                for (auto sub: subs_)
+                {
+                    if (sub == -1)
+                        return true;
+                }
+
+                return false;
+            }
+
+            const value_type& current_() const
+            {
+                if (subs_[idx_] == -1)
+                    return position_->prefix();
+                else
+                    return (*position_)[static_cast<size_t>(subs_[idx_])];
+            }
+
+            void fix_result_(const regex_token_iterator& other)
+            {
+                if (!other.result_)
+                    result_ = nullptr;
+                else if (other.result_ == &other.suffix_)
+                    result_ = &suffix_;
+                else
+                    result_ = &current_();
+            }
+    };
+
+    using cregex_token_iterator  = regex_token_iterator<const char*>;
+    using wcregex_token_iterator = regex_token_iterator<const wchar_t*>;
+    using sregex_token_iterator  = regex_token_iterator<string::const_iterator>;
+    using wsregex_token_iterator = regex_token_iterator<wstring::const_iterator>;
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_REPLACE
+#define LIBCPP_BITS_REGEX_REGEX_REPLACE
+
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/regex_iterator.hpp>
+#include <iterator>
+#include <string>
+
+namespace std
+{
+    /**
+     * 28.11.4, function template regex_replace:
+     */
+
+    template<class OutputIterator, class BidiIt, class Traits, class Char>
+    OutputIterator regex_replace(OutputIterator out, BidiIt first, BidiIt last,
+                                 const basic_regex<Char, Traits>& re,
+                                 const Char* fmt_first, const Char* fmt_last,
+                                 regex_constants::match_flag_type flags)
+    {
+        regex_iterator<BidiIt, Char, Traits> it{first, last, re, flags};
+        regex_iterator<BidiIt, Char, Traits> end{};
+
+        bool copy = !(flags & regex_constants::format_no_copy);
+        if (it == end)
+        {
+            if (copy)
+            {
+                for (; first != last; ++first)
+                    *out++ = *first;
+            }
+
+            return out;
+        }
+
+        sub_match<BidiIt> suffix{};
+        for (; it != end; ++it)
+        {
+            if (copy)
+            {
+                for (auto c = it->prefix().first; c != it->prefix().second; ++c)
+                    *out++ = *c;
+            }
+
+            out = it->format(out, fmt_first, fmt_last, flags);
+            suffix = it->suffix();
+
+            if (flags & regex_constants::format_first_only)
+                break;
+        }
+
+        if (copy)
+        {
+            for (auto c = suffix.first; c != suffix.second; ++c)
+                *out++ = *c;
+        }
+
+        return out;
+    }
+
+    template<class OutputIterator, class BidiIt, class Traits, class Char, class ST, class SA>
+    OutputIterator regex_replace(OutputIterator out, BidiIt first, BidiIt last,
+                                 const basic_regex<Char, Traits>& re,
+                                 const basic_string<Char, ST, SA>& fmt,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_replace(out, first, last, re, fmt.data(), fmt.data() + fmt.size(), flags);
+    }
+
+    template<class OutputIterator, class BidiIt, class Traits, class Char>
+    OutputIterator regex_replace(OutputIterator out, BidiIt first, BidiIt last,
+                                 const basic_regex<Char, Traits>& re, const Char* fmt,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_replace(out, first, last, re, fmt, fmt + char_traits<Char>::length(fmt), flags);
+    }
+
+    template<class Traits, class Char, class ST, class SA, class FST, class FSA>
+    basic_string<Char, ST, SA> regex_replace(const basic_string<Char, ST, SA>& str,
+                                             const basic_regex<Char, Traits>& re,
+                                             const basic_string<Char, FST, FSA>& fmt,
+                                             regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char, ST, SA> res{};
+        regex_replace(back_inserter(res), str.begin(), str.end(), re, fmt, flags);
+
+        return res;
+    }
+
+    template<class Traits, class Char, class ST, class SA>
+    basic_string<Char, ST, SA> regex_replace(const basic_string<Char, ST, SA>& str,
+                                             const basic_regex<Char, Traits>& re, const Char* fmt,
+                                             regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char, ST, SA> res{};
+        regex_replace(back_inserter(res), str.begin(), str.end(), re, fmt, flags);
+
+        return res;
+    }
+
+    template<class Traits, class Char, class ST, class SA>
+    basic_string<Char> regex_replace(const Char* str, const basic_regex<Char, Traits>& re,
+                                     const basic_string<Char, ST, SA>& fmt,
+                                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char> res{};
+        regex_replace(back_inserter(res), str, str + char_traits<Char>::length(str), re, fmt, flags);
+
+        return res;
+    }
+
+    template<class Traits, class Char>
+    basic_string<Char> regex_replace(const Char* str, const basic_regex<Char, Traits>& re,
+                                     const Char* fmt,
+                                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char> res{};
+        regex_replace(back_inserter(res), str, str + char_traits<Char>::length(str), re, fmt, flags);
+
+        return res;
+    }
+}
+
+#endif
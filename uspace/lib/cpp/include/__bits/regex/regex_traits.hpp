@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_TRAITS
+#define LIBCPP_BITS_REGEX_REGEX_TRAITS
+
+#include <__bits/locale/locale.hpp>
+#include <__bits/string/string.hpp>
+#include <cctype>
+#include <cstddef>
+
+namespace std
+{
+    /**
+     * 28.7, class template regex_traits:
+     * Note: Only the "C" locale is supported, the
+     *       classification is that of <cctype>.
+     */
+
+    template<class Char>
+    struct regex_traits
+    {
+        using char_type       = Char;
+        using string_type     = basic_string<char_type>;
+        using locale_type     = locale;
+        using char_class_type = unsigned int;
+
+        regex_traits()
+            : loc_{}
+        { /* DUMMY BODY */ }
+
+        static size_t length(const char_type* str)
+        {
+            return char_traits<char_type>::length(str);
+        }
+
+        char_type translate(char_type c) const
+        {
+            return c;
+        }
+
+        char_type translate_nocase(char_type c) const
+        {
+            if (c >= 'A' && c <= 'Z')
+                return static_cast<char_type>(c - 'A' + 'a');
+            else
+                return c;
+        }
+
+        template<class ForwardIterator>
+        string_type transform(ForwardIterator first, ForwardIterator last) const
+        {
+            return string_type(first, last);
+        }
+
+        template<class ForwardIterator>
+        string_type transform_primary(ForwardIterator first, ForwardIterator last) const
+        {
+            string_type res{};
+            for (; first != last; ++first)
+                res.push_back(translate_nocase(*first));
+
+            return res;
+        }
+
+        template<class ForwardIterator>
+        string_type lookup_collatename(ForwardIterator first, ForwardIterator last) const
+        {
+            string_type res(first, last);
+            if (res.size() != 1)
+                return string_type{};
+
+            return res;
+        }
+
+        template<class ForwardIterator>
+        char_class_type lookup_classname(ForwardIterator first, ForwardIterator last,
+                                         bool icase = false) const
+        {
+            static constexpr struct
+            {
+                const char* name;
+                char_class_type mask;
+            } classes[] = {
+                {"alnum", alnum_}, {"alpha", alpha_}, {"blank", blank_},
+                {"cntrl", cntrl_}, {"digit", digit_}, {"graph", graph_},
+                {"lower", lower_}, {"print", print_}, {"punct", punct_},
+                {"space", space_}, {"upper", upper_}, {"xdigit", xdigit_},
+                {"d", digit_}, {"s", space_}, {"w", alnum_ | underscore_}
+            };
+
+            for (const auto& cls: classes)
+            {
+                auto it = first;
+                const char* name = cls.name;
+                while (it != last && *name != '\0' && translate_nocase(*it) == *name)
+                {
+                    ++it;
+                    ++name;
+                }
+
+                if (it != last || *name != '\0')
+                    continue;
+
+                if (icase && (cls.mask & (lower_ | upper_)))
+                    return lower_ | upper_;
+
+                return cls.mask;
+            }
+
+            return char_class_type{};
+        }
+
+        bool isctype(char_type c, char_class_type cls) const
+        {
+            if (static_cast<unsigned long>(c) > 127)
+                return false;
+
+            int ch = static_cast<int>(c);
+
+            return ((cls & alnum_) && isalnum(ch)) || ((cls & alpha_) && isalpha(ch)) ||
+                   ((cls & blank_) && isblank(ch)) || ((cls & cntrl_) && iscntrl(ch)) ||
+                   ((cls & digit_) && isdigit(ch)) || ((cls & graph_) && isgraph(ch)) ||
+                   ((cls & lower_) && islower(ch)) || ((cls & print_) && isprint(ch)) ||
+                   ((cls & punct_) && ispunct(ch)) || ((cls & space_) && isspace(ch)) ||
+                   ((cls & upper_) && isupper(ch)) || ((cls & xdigit_) && isxdigit(ch)) ||
+                   ((cls & underscore_) && ch == '_');
+        }
+
+        int value(char_type c, int radix) const
+        {
+            int res{-1};
+            if (c >= '0' && c <= '9')
+                res = c - '0';
+            else if (c >= 'a' && c <= 'z')
+                res = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'Z')
+                res = c - 'A' + 10;
+
+            return res < radix ? res : -1;
+        }
+
+        locale_type imbue(locale_type loc)
+        {
+            auto res = loc_;
+            loc_ = loc;
+
+            return res;
+        }
+
+        locale_type getloc() const
+        {
+            return loc_;
+        }
+
+        private:
+            static constexpr char_class_type alnum_      = 1U << 0;
+            static constexpr char_class_type alpha_      = 1U << 1;
+            static constexpr char_class_type blank_      = 1U << 2;
+            static constexpr char_class_type cntrl_      = 1U << 3;
+            static constexpr char_class_type digit_      = 1U << 4;
+            static constexpr char_class_type graph_      = 1U << 5;
+            static constexpr char_class_type lower_      = 1U << 6;
+            static constexpr char_class_type print_      = 1U << 7;
+            static constexpr char_class_type punct_      = 1U << 8;
+            static constexpr char_class_type space_      = 1U << 9;
+            static constexpr char_class_type upper_      = 1U << 10;
+            static constexpr char_class_type xdigit_     = 1U << 11;
+            static constexpr char_class_type underscore_ = 1U << 12;
+
+            locale_type loc_;
+    };
+}
+
+#endif
@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_STRING
 #define LIBCPP_BITS_STRING
 
+#include <__bits/memory/memory_resource_fwd.hpp>
 #include <__bits/string/stringfwd.hpp>
 #include <algorithm>
 #include <cassert>
@@ -478,24 +479,23 @@ namespace std
                  *  size() = 0
                  *  capacity() = unspecified
                  */
-                data_ = allocator_.allocate(default_capacity_);
-                capacity_ = default_capacity_;
+                allocate_(1);
+                ensure_null_terminator_();
             }
 
             basic_string(const basic_string& other)
                 : data_{}, size_{other.size_}, capacity_{other.capacity_},
-                  allocator_{other.allocator_}
+                  allocator_{allocator_traits<allocator_type>::select_on_container_copy_construction(
+                      other.allocator_
+                  )}
             {
                 init_(other.data(), size_);
             }
 
             basic_string(basic_string&& other)
-                : data_{other.data_}, size_{other.size_},
-                  capacity_{other.capacity_}, allocator_{move(other.allocator_)}
+                : data_{}, size_{}, capacity_{}, allocator_{move(other.allocator_)}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                move_from_(other);
             }
 
             basic_string(const basic_string& other, size_type pos, size_type n = npos,
@@ -520,9 +520,9 @@ namespace std
             }
 
             basic_string(size_type n, value_type c, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n}, allocator_{alloc}
+                : data_{}, size_{n}, capacity_{}, allocator_{alloc}
             {
-                data_ = allocator_.allocate(capacity_);
+                allocate_(size_ + 1);
                 for (size_type i = 0; i < size_; ++i)
                     traits_type::assign(data_[i], c);
                 ensure_null_terminator_();
@@ -536,8 +536,7 @@ namespace std
                 if constexpr (is_integral<InputIterator>::value)
                 { // Required by the standard.
                     size_ = static_cast<size_type>(first);
-                    capacity_ = size_;
-                    data_ = allocator_.allocate(capacity_);
+                    allocate_(size_ + 1);
 
                     for (size_type i = 0; i < size_; ++i)
                         traits_type::assign(data_[i], static_cast<value_type>(last));
@@ -561,23 +560,38 @@ namespace std
             }
 
             basic_string(basic_string&& other, const allocator_type& alloc)
-                : data_{other.data_}, size_{other.size_}, capacity_{other.capacity_}, allocator_{alloc}
+                : data_{}, size_{}, capacity_{}, allocator_{alloc}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                if (allocator_ == other.allocator_)
+                    move_from_(other);
+                else
+                    init_(other.data(), other.size());
             }
 
             ~basic_string()
             {
-                allocator_.deallocate(data_, capacity_);
+                deallocate_();
             }
 
             basic_string& operator=(const basic_string& other)
             {
                 if (this != &other)
                 {
-                    basic_string tmp{other};
+                    if constexpr (allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+                    {
+                        if (allocator_ != other.allocator_)
+                        {
+                            // Our memory has to go back to our allocator.
+                            deallocate_();
+                            data_ = sso_;
+                            size_ = 0;
+                            capacity_ = sso_capacity_;
+                            ensure_null_terminator_();
+                        }
+                    }
+                    aux::alloc_propagate_copy(allocator_, other.allocator_);
+
+                    basic_string tmp{other, allocator_};
                     swap(tmp);
                 }
 
@@ -588,8 +602,17 @@ namespace std
                 noexcept(allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
                          allocator_traits<allocator_type>::is_always_equal::value)
             {
-                if (this != &other)
-                    swap(other);
+                if (this == &other)
+                    return *this;
+
+                if (aux::alloc_can_steal(allocator_, other.allocator_))
+                {
+                    deallocate_();
+                    aux::alloc_propagate_move(allocator_, other.allocator_);
+                    move_from_(other);
+                }
+                else
+                    init_(other.data(), other.size());
 
                 return *this;
             }
@@ -706,7 +729,7 @@ namespace std
                 {
                     ensure_free_space_(new_size - size_ + 1);
                     for (size_type i = size_; i < new_size; ++i)
-                        traits_type::assign(data_[i], i);
+                        traits_type::assign(data_[i], c);
                 }
 
                 size_ = new_size;
@@ -736,13 +759,21 @@ namespace std
 
             void shrink_to_fit()
             {
-                if (size_ != capacity_)
-                    resize_with_copy_(size_, capacity_);
+                if (is_short_() || size_ + 1 == capacity_)
+                    return;
+
+                auto old_data = data_;
+                auto old_capacity = capacity_;
+
+                allocate_(size_ + 1);
+                traits_type::copy(data_, old_data, size_ + 1);
+                allocator_.deallocate(old_data, old_capacity);
             }
 
             void clear() noexcept
             {
                 size_ = 0;
+                ensure_null_terminator_();
             }
 
             bool empty() const noexcept
@@ -907,7 +938,7 @@ namespace std
             basic_string& assign(const value_type* str, size_type n)
             {
                 // TODO: if (n > max_size()) throw length_error.
-                resize_without_copy_(n);
+                resize_without_copy_(n + 1);
                 traits_type::copy(begin(), str, n);
                 size_ = n;
                 ensure_null_terminator_();
@@ -1083,7 +1114,7 @@ namespace std
                 auto len = min(n1, size_ - pos);
 
                 basic_string tmp{};
-                tmp.resize_without_copy_(size_ - len + n2);
+                tmp.resize_without_copy_(size_ - len + n2 + 1);
 
                 // Prefix.
                 copy_(begin(), begin() + pos, tmp.begin());
@@ -1095,6 +1126,7 @@ namespace std
                 copy_(begin() + pos + len, end(), tmp.begin() + pos + n2);
 
                 tmp.size_ = size_ - len + n2;
+                tmp.ensure_null_terminator_();
                 swap(tmp);
                 return *this;
             }
@@ -1160,9 +1192,31 @@ namespace std
                 noexcept(allocator_traits<allocator_type>::propagate_on_container_swap::value ||
                          allocator_traits<allocator_type>::is_always_equal::value)
             {
-                std::swap(data_, other.data_);
+                if (is_short_() && other.is_short_())
+                {
+                    value_type tmp[sso_capacity_];
+                    traits_type::copy(tmp, sso_, size_ + 1);
+                    traits_type::copy(sso_, other.sso_, other.size_ + 1);
+                    traits_type::copy(other.sso_, tmp, size_ + 1);
+                }
+                else if (is_short_())
+                {
+                    traits_type::copy(other.sso_, sso_, size_ + 1);
+                    data_ = other.data_;
+                    other.data_ = other.sso_;
+                }
+                else if (other.is_short_())
+                {
+                    traits_type::copy(sso_, other.sso_, other.size_ + 1);
+                    other.data_ = data_;
+                    data_ = sso_;
+                }
+                else
+                    std::swap(data_, other.data_);
+
                 std::swap(size_, other.size_);
                 std::swap(capacity_, other.capacity_);
+                aux::alloc_propagate_swap(allocator_, other.allocator_);
             }
 
             /**
@@ -1476,31 +1530,80 @@ namespace std
             }
 
         private:
+            /**
+             * Strings that fit into this many characters
+             * (including the null terminator) are stored in
+             * sso_ inside of the object, so that short strings
+             * do not need any heap allocation.
+             */
+            static constexpr size_type sso_capacity_{
+                sizeof(value_type) < 8 ? 16 / sizeof(value_type) : 2
+            };
+
             value_type* data_;
             size_type size_;
             size_type capacity_;
             allocator_type allocator_;
+            value_type sso_[sso_capacity_];
 
             template<class C, class T, class A>
             friend class basic_stringbuf;
 
+            bool is_short_() const noexcept
+            {
+                return data_ == sso_;
+            }
+
             /**
-             * Arbitrary value, standard just requires
-             * data() to have some capacity.
-             * (Well, we could've done data_ = &data_ and
-             * set capacity to 0, but that would be too cryptic.)
+             * Sets data_ to a buffer for at least capacity
+             * characters, the old buffer must be released
+             * (or saved) by the caller.
              */
-            static constexpr size_type default_capacity_{4};
+            void allocate_(size_type capacity)
+            {
+                if (capacity <= sso_capacity_)
+                {
+                    data_ = sso_;
+                    capacity_ = sso_capacity_;
+                }
+                else
+                {
+                    data_ = allocator_.allocate(capacity);
+                    capacity_ = capacity;
+                }
+            }
 
-            void init_(const value_type* str, size_type size)
+            void deallocate_()
             {
-                if (data_)
+                if (data_ && !is_short_())
                     allocator_.deallocate(data_, capacity_);
+            }
 
-                size_ = size;
-                capacity_ = size + 1;
+            void move_from_(basic_string& other)
+            {
+                if (other.is_short_())
+                {
+                    data_ = sso_;
+                    traits_type::copy(sso_, other.sso_, other.size_ + 1);
+                }
+                else
+                    data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+
+                // Leave other as a valid empty string.
+                other.data_ = other.sso_;
+                other.size_ = 0;
+                other.capacity_ = sso_capacity_;
+                other.ensure_null_terminator_();
+            }
+
+            void init_(const value_type* str, size_type size)
+            {
+                deallocate_();
+                allocate_(size + 1);
 
-                data_ = allocator_.allocate(capacity_);
+                size_ = size;
                 traits_type::copy(data_, str, size);
                 ensure_null_terminator_();
             }
@@ -1526,30 +1629,30 @@ namespace std
 
             void resize_without_copy_(size_type capacity)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                if (capacity > capacity_)
+                {
+                    deallocate_();
+                    allocate_(capacity);
+                }
 
-                data_ = allocator_.allocate(capacity);
                 size_ = 0;
-                capacity_ = capacity;
                 ensure_null_terminator_();
             }
 
             void resize_with_copy_(size_type size, size_type capacity)
             {
-                if(capacity_ == 0 || capacity_ < capacity)
+                if (capacity_ < capacity)
                 {
                     auto new_data = allocator_.allocate(capacity);
 
                     auto to_copy = min(size, size_);
-                    traits_type::move(new_data, data_, to_copy);
+                    traits_type::copy(new_data, data_, to_copy);
 
-                    std::swap(data_, new_data);
-
-                    allocator_.deallocate(new_data, capacity_);
+                    deallocate_();
+                    data_ = new_data;
+                    capacity_ = capacity;
                 }
 
-                capacity_ = capacity;
                 size_ = size;
                 ensure_null_terminator_();
             }
@@ -1991,4 +2094,15 @@ inline namespace string_literals
 #pragma GCC diagnostic pop
 }
 
+namespace std::pmr
+{
+    template<class Char, class Traits = char_traits<Char>>
+    using basic_string = std::basic_string<Char, Traits, polymorphic_allocator<Char>>;
+
+    using string    = basic_string<char>;
+    using u16string = basic_string<char16_t>;
+    using u32string = basic_string<char32_t>;
+    using wstring   = basic_string<wchar_t>;
+}
+
 #endif
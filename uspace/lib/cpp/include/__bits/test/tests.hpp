@@ -82,6 +82,20 @@ namespace std::test
             std::vector<test_suite*> tests_{};
     };
 
+    class atomic_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_integral();
+            void test_pointer();
+            void test_compare_exchange();
+            void test_lock_based();
+            void test_flag();
+    };
+
     class array_test: public test_suite
     {
         public:
@@ -105,6 +119,7 @@ namespace std::test
             void test_construction_and_assignment();
             void test_insert();
             void test_erase();
+            void test_growth();
     };
 
     class string_test: public test_suite
@@ -177,6 +192,7 @@ namespace std::test
             void test_multi();
             void test_reverse_iterators();
             void test_multi_bounds_and_ranges();
+            void test_node_handles();
     };
 
     class set_test: public test_suite
@@ -192,6 +208,7 @@ namespace std::test
             void test_multi();
             void test_reverse_iterators();
             void test_multi_bounds_and_ranges();
+            void test_node_handles();
     };
 
     class unordered_map_test: public test_suite
@@ -207,6 +224,19 @@ namespace std::test
             void test_multi();
     };
 
+    class flat_hash_map_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_constructors_and_assignment();
+            void test_histogram();
+            void test_emplace_insert();
+            void test_erase_and_growth();
+    };
+
     class unordered_set_test: public test_suite
     {
         public:
@@ -256,6 +286,19 @@ namespace std::test
             void test_pointers();
     };
 
+    class memory_resource_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_resources();
+            void test_pool_resource();
+            void test_monotonic_resource();
+            void test_containers();
+    };
+
     class list_test: public test_suite
     {
         public:
@@ -293,6 +336,9 @@ namespace std::test
         private:
             void test_non_modifying();
             void test_mutating();
+            void test_sorting();
+            void test_sort_timing();
+            void test_parallel();
     };
 
     class future_test: public test_suite
@@ -308,6 +354,35 @@ namespace std::test
             void test_packaged_task();
             void test_shared_future();
     };
+
+    class mpsc_channel_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_try_ops();
+            void test_close();
+            void test_timeouts();
+            void test_producers();
+    };
+
+    class regex_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_match();
+            void test_search();
+            void test_groups();
+            void test_posix();
+            void test_flags();
+            void test_iterators();
+            void test_replace();
+            void test_errors();
+            void test_complexity();
+    };
 }
 
 #endif
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_THREAD_EXECUTOR
+#define LIBCPP_BITS_THREAD_EXECUTOR
+
+#include <__bits/atomic.hpp>
+#include <__bits/exception.hpp>
+#include <__bits/thread/threading.hpp>
+#include <cstdlib>
+
+namespace std::aux
+{
+    /**
+     * Unit of work run by the executor, the task is
+     * responsible for its own lifetime.
+     */
+    class executor_task
+    {
+        public:
+            virtual void run() = 0;
+
+            virtual ~executor_task() = default;
+    };
+
+    /**
+     * Process wide pool of worker fibrils used by std::async
+     * and the parallel algorithms.
+     *
+     * Every worker owns a deque of tasks, it pops new work
+     * from the back of its own deque (which keeps recently
+     * spawned and cache hot tasks local) and when that runs
+     * dry it steals from the front of the deques of the other
+     * workers. Tasks submitted from outside of the pool are
+     * distributed in a round robin fashion, tasks submitted
+     * by a worker go to its own deque.
+     *
+     * The pool enables multithreaded fibril runners when
+     * created, so the workers can execute in parallel.
+     */
+    class executor
+    {
+        public:
+            static executor& instance();
+
+            void submit(executor_task* task);
+
+            size_t concurrency() const noexcept
+            {
+                return count_;
+            }
+
+            /**
+             * Returns true if the calling fibril is one
+             * of the workers of the pool.
+             */
+            static bool on_worker() noexcept;
+
+            executor(const executor&) = delete;
+            executor& operator=(const executor&) = delete;
+
+        private:
+            struct worker;
+
+            worker* workers_;
+            size_t count_;
+
+            atomic<size_t> pending_;
+            atomic<size_t> next_;
+
+            mutex_t idle_mutex_;
+            condvar_t idle_cv_;
+
+            executor();
+
+            executor_task* take_(size_t idx);
+            void work_(size_t idx);
+
+            static int worker_main_(void* arg);
+    };
+
+    /**
+     * Shared state of a parallel loop, splits the index range
+     * [0, count) into chunks that are claimed by whoever
+     * gets to them first. Helper tasks that start after all
+     * chunks have been claimed just drop their reference,
+     * so the loop body is only accessed while the caller
+     * is waiting for the loop to finish.
+     */
+    template<class Body>
+    class parallel_job: public executor_task
+    {
+        public:
+            parallel_job(Body& body, size_t count, size_t grain, size_t refs)
+                : body_{&body}, count_{count}, grain_{grain},
+                  chunks_{(count + grain - 1) / grain},
+                  next_{0}, done_{0}, refs_{refs},
+                  finished_{false}, mutex_{}, condvar_{}
+            {
+                threading::mutex::init(mutex_);
+                threading::condvar::init(condvar_);
+            }
+
+            void run() override
+            {
+                work();
+                release();
+            }
+
+            void work()
+            {
+                while (true)
+                {
+                    auto chunk = next_.fetch_add(1, memory_order_relaxed);
+                    if (chunk >= chunks_)
+                        break;
+
+                    auto first = chunk * grain_;
+                    auto last = first + grain_;
+                    if (last > count_)
+                        last = count_;
+
+                    /**
+                     * Note: Exceptions escaping an element access
+                     *       function of a parallel algorithm call
+                     *       terminate, see 25.2.4.
+                     */
+                    try
+                    {
+                        (*body_)(first, last);
+                    }
+                    catch (...)
+                    {
+                        std::terminate();
+                    }
+
+                    if (done_.fetch_add(1, memory_order_acq_rel) + 1 == chunks_)
+                    {
+                        threading::mutex::lock(mutex_);
+                        finished_ = true;
+                        threading::condvar::broadcast(condvar_);
+                        threading::mutex::unlock(mutex_);
+                    }
+                }
+            }
+
+            void wait()
+            {
+                threading::mutex::lock(mutex_);
+                while (!finished_)
+                    threading::condvar::wait(condvar_, mutex_);
+                threading::mutex::unlock(mutex_);
+            }
+
+            void release()
+            {
+                if (refs_.fetch_sub(1, memory_order_acq_rel) == 1)
+                    delete this;
+            }
+
+        private:
+            Body* body_;
+            size_t count_;
+            size_t grain_;
+            size_t chunks_;
+
+            atomic<size_t> next_;
+            atomic<size_t> done_;
+            atomic<size_t> refs_;
+
+            bool finished_;
+            mutex_t mutex_;
+            condvar_t condvar_;
+    };
+
+    /**
+     * Calls body(first, last) for disjoint subranges covering
+     * [0, count) using the executor. The calling fibril takes
+     * part in the work, so nested parallel loops started from
+     * a worker cannot starve the pool. Small ranges are run
+     * sequentially and body is never called for an empty range.
+     */
+    template<class Body>
+    void parallel_for(size_t count, size_t min_grain, Body body)
+    {
+        if (count == 0)
+            return;
+
+        auto& exec = executor::instance();
+        auto workers = exec.concurrency();
+
+        if (min_grain == 0)
+            min_grain = 1;
+
+        if (workers < 2 || count <= min_grain)
+        {
+            body(size_t{}, count);
+            return;
+        }
+
+        /**
+         * Few chunks per worker give the stealing something
+         * to balance without paying for a task per element.
+         */
+        auto target = workers * 4;
+        auto grain = (count + target - 1) / target;
+        if (grain < min_grain)
+            grain = min_grain;
+
+        auto chunks = (count + grain - 1) / grain;
+        auto helpers = (chunks < workers ? chunks : workers) - 1;
+
+        auto job = new parallel_job<Body>{body, count, grain, helpers + 1};
+        for (size_t i = 0; i < helpers; ++i)
+            exec.submit(job);
+
+        job->work();
+        job->wait();
+        job->release();
+    }
+}
+
+#endif
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_THREAD_MPSC_CHANNEL
+#define LIBCPP_BITS_THREAD_MPSC_CHANNEL
+
+#include <__bits/atomic.hpp>
+#include <__bits/thread/threading.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace std::__helenos
+{
+    enum class channel_status
+    {
+        success,
+        full,
+        empty,
+        timeout,
+        closed
+    };
+
+    /**
+     * HelenOS extension, a bounded multi-producer single-consumer
+     * FIFO channel. It follows the mpsc_t channel from libc: once
+     * the channel is closed, sending fails and the receiver still
+     * gets all messages that were sent before it is told
+     * that the channel is closed.
+     *
+     * Unlike mpsc_t, the channel has a fixed capacity and is
+     * lock-free. Messages are stored in a ring of slots and every
+     * slot carries a sequence number that tells whether the slot is
+     * free for the producer at a given position or holds a message
+     * for the consumer at that position. Producers thus only race
+     * on a compare-exchange of the tail position and the consumer
+     * needs no read-modify-write operation at all. The mutex and
+     * the condition variables are only used to put a fibril to
+     * sleep when the channel is full or empty.
+     *
+     * Note: Only one fibril may receive from the channel at a time
+     *       and the move constructor of T should not throw.
+     */
+    template<class T>
+    class mpsc_channel
+    {
+        public:
+            using value_type = T;
+            using size_type  = size_t;
+
+            explicit mpsc_channel(size_type capacity)
+                : slots_{}, mask_{}, tail_{}, senders_waiting_{},
+                  mtx_{}, not_full_{}, not_empty_{},
+                  receiver_waiting_{}, head_{}
+            {
+                size_type size{1};
+                while (size < capacity)
+                    size <<= 1;
+
+                slots_ = new slot[size];
+                mask_ = size - 1;
+
+                for (size_type i = 0; i < size; ++i)
+                    slots_[i].seq.store(i << 1, memory_order_relaxed);
+
+                aux::threading::mutex::init(mtx_);
+                aux::threading::condvar::init(not_full_);
+                aux::threading::condvar::init(not_empty_);
+            }
+
+            mpsc_channel(const mpsc_channel&) = delete;
+            mpsc_channel& operator=(const mpsc_channel&) = delete;
+
+            ~mpsc_channel()
+            {
+                while (true)
+                {
+                    auto& s = slots_[index_(head_)];
+                    if (s.seq.load(memory_order_acquire) != head_ + 1)
+                        break;
+
+                    s.value()->~T();
+                    head_ += 2;
+                }
+
+                delete[] slots_;
+            }
+
+            /**
+             * Sends the value if there is room for it, returns
+             * channel_status::full otherwise.
+             */
+            channel_status try_send(const T& value)
+            {
+                T tmp{value};
+
+                return try_send(move(tmp));
+            }
+
+            channel_status try_send(T&& value)
+            {
+                auto res = push_(value);
+                if (res == channel_status::success)
+                    wake_(receiver_waiting_, not_empty_);
+
+                return res;
+            }
+
+            /**
+             * Sends the value, waits for a free slot
+             * if the channel is full.
+             */
+            channel_status send(const T& value)
+            {
+                T tmp{value};
+
+                return send(move(tmp));
+            }
+
+            channel_status send(T&& value)
+            {
+                return send_(value, nullptr);
+            }
+
+            template<class Rep, class Period>
+            channel_status send_for(T&& value,
+                                    const chrono::duration<Rep, Period>& rel_time)
+            {
+                auto deadline = chrono::steady_clock::now() + rel_time;
+
+                return send_(value, &deadline);
+            }
+
+            /**
+             * Receives the oldest message, returns channel_status::empty
+             * if there is none or channel_status::closed if there
+             * is none and the channel has been closed.
+             */
+            channel_status try_receive(T& value)
+            {
+                auto res = pop_(value);
+                if (res == channel_status::success)
+                    wake_(senders_waiting_, not_full_);
+
+                return res;
+            }
+
+            /**
+             * Receives the oldest message, waits for one
+             * if the channel is empty.
+             */
+            channel_status receive(T& value)
+            {
+                return receive_(value, nullptr);
+            }
+
+            template<class Rep, class Period>
+            channel_status receive_for(T& value,
+                                       const chrono::duration<Rep, Period>& rel_time)
+            {
+                auto deadline = chrono::steady_clock::now() + rel_time;
+
+                return receive_(value, &deadline);
+            }
+
+            /**
+             * Closes the channel, all blocked fibrils are woken up.
+             */
+            void close()
+            {
+                tail_.fetch_or(closed_bit_, memory_order_acq_rel);
+
+                aux::threading::mutex::lock(mtx_);
+                aux::threading::condvar::broadcast(not_full_);
+                aux::threading::condvar::broadcast(not_empty_);
+                aux::threading::mutex::unlock(mtx_);
+            }
+
+            bool closed() const noexcept
+            {
+                return (tail_.load(memory_order_acquire) & closed_bit_) != 0;
+            }
+
+            size_type capacity() const noexcept
+            {
+                return mask_ + 1;
+            }
+
+        private:
+            using time_point = chrono::steady_clock::time_point;
+
+            struct slot
+            {
+                atomic<size_type> seq;
+                alignas(T) unsigned char storage[sizeof(T)];
+
+                T* value()
+                {
+                    return reinterpret_cast<T*>(storage);
+                }
+            };
+
+            /**
+             * Positions are kept shifted one bit to the left, the
+             * lowest bit of the tail position marks the channel as
+             * closed so that closing and sending cannot race.
+             * The sequence number of a slot is the (shifted)
+             * position it is free for, or that position plus one
+             * once it holds a message.
+             */
+            static constexpr size_type closed_bit_{1};
+
+            slot* slots_;
+            size_type mask_;
+
+            /**
+             * Producer side, the mutex and condition variables
+             * sit in between to keep the producer and consumer
+             * positions away from each other in memory.
+             */
+            atomic<size_type> tail_;
+            atomic<size_type> senders_waiting_;
+
+            aux::mutex_t mtx_;
+            aux::condvar_t not_full_;
+            aux::condvar_t not_empty_;
+
+            // Consumer side.
+            atomic<size_type> receiver_waiting_;
+            size_type head_;
+
+            size_type index_(size_type pos) const noexcept
+            {
+                return (pos >> 1) & mask_;
+            }
+
+            channel_status push_(T& value)
+            {
+                auto pos = tail_.load(memory_order_relaxed);
+                while (true)
+                {
+                    if (pos & closed_bit_)
+                        return channel_status::closed;
+
+                    auto& s = slots_[index_(pos)];
+                    auto seq = s.seq.load(memory_order_acquire);
+                    auto diff = static_cast<ptrdiff_t>(seq - pos);
+
+                    if (diff == 0)
+                    {
+                        if (tail_.compare_exchange_weak(pos, pos + 2, memory_order_relaxed))
+                        {
+                            ::new(static_cast<void*>(s.value())) T(move(value));
+                            s.seq.store(pos + 1, memory_order_release);
+
+                            return channel_status::success;
+                        }
+                    }
+                    else if (diff < 0)
+                        return channel_status::full;
+                    else
+                        pos = tail_.load(memory_order_relaxed);
+                }
+            }
+
+            channel_status pop_(T& value)
+            {
+                auto& s = slots_[index_(head_)];
+                if (s.seq.load(memory_order_acquire) != head_ + 1)
+                {
+                    /**
+                     * A producer may have claimed the slot without
+                     * filling it yet, in which case the channel
+                     * is not drained even if it is closed.
+                     */
+                    auto tail = tail_.load(memory_order_acquire);
+                    if ((tail & closed_bit_) && (tail & ~closed_bit_) == head_)
+                        return channel_status::closed;
+                    else
+                        return channel_status::empty;
+                }
+
+                auto ptr = s.value();
+                value = move(*ptr);
+                ptr->~T();
+
+                s.seq.store(head_ + ((mask_ + 1) << 1), memory_order_release);
+                head_ += 2;
+
+                return channel_status::success;
+            }
+
+            /**
+             * Wakes up the other side if it announced that it is
+             * waiting. The fence pairs with the one in wait_() so
+             * that either the waiter sees our change or we see the
+             * waiter, the mutex then makes sure the wakeup is not
+             * lost between the check and the wait.
+             */
+            void wake_(atomic<size_type>& waiting, aux::condvar_t& cv)
+            {
+                atomic_thread_fence(memory_order_seq_cst);
+                if (waiting.load(memory_order_relaxed) == 0)
+                    return;
+
+                aux::threading::mutex::lock(mtx_);
+                aux::threading::condvar::signal(cv);
+                aux::threading::mutex::unlock(mtx_);
+            }
+
+            template<class Op>
+            channel_status wait_(Op op, channel_status busy, atomic<size_type>& waiting,
+                                 aux::condvar_t& cv, const time_point* deadline)
+            {
+                aux::threading::mutex::lock(mtx_);
+                waiting.fetch_add(1, memory_order_relaxed);
+                atomic_thread_fence(memory_order_seq_cst);
+
+                auto res = op();
+                while (res == busy)
+                {
+                    if (!deadline)
+                        aux::threading::condvar::wait(cv, mtx_);
+                    else
+                    {
+                        auto timeout = aux::threading::time::convert(
+                            *deadline - chrono::steady_clock::now()
+                        );
+
+                        if (aux::threading::condvar::wait_for(cv, mtx_, timeout) != EOK)
+                        {
+                            res = op();
+                            if (res == busy)
+                                res = channel_status::timeout;
+                            break;
+                        }
+                    }
+
+                    res = op();
+                }
+
+                waiting.fetch_sub(1, memory_order_relaxed);
+                aux::threading::mutex::unlock(mtx_);
+
+                return res;
+            }
+
+            channel_status send_(T& value, const time_point* deadline)
+            {
+                auto res = push_(value);
+                if (res == channel_status::full)
+                {
+                    res = wait_(
+                        [this, &value]{ return push_(value); },
+                        channel_status::full, senders_waiting_,
+                        not_full_, deadline
+                    );
+                }
+
+                if (res == channel_status::success)
+                    wake_(receiver_waiting_, not_empty_);
+
+                return res;
+            }
+
+            channel_status receive_(T& value, const time_point* deadline)
+            {
+                auto res = pop_(value);
+                if (res == channel_status::empty)
+                {
+                    res = wait_(
+                        [this, &value]{ return pop_(value); },
+                        channel_status::empty, receiver_waiting_,
+                        not_empty_, deadline
+                    );
+                }
+
+                if (res == channel_status::success)
+                    wake_(senders_waiting_, not_full_);
+
+                return res;
+            }
+    };
+}
+
+#endif
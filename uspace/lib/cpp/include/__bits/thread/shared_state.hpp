@@ -37,6 +37,7 @@
 #include <__bits/functional/function.hpp>
 #include <__bits/functional/invoke.hpp>
 #include <__bits/refcount_obj.hpp>
+#include <__bits/thread/executor.hpp>
 #include <__bits/thread/future_common.hpp>
 #include <__bits/thread/threading.hpp>
 #include <cerrno>
@@ -242,7 +243,10 @@ namespace std::aux
 
             void set_value()
             {
+                aux::threading::mutex::lock(mutex_);
                 value_set_ = true;
+                aux::threading::mutex::unlock(mutex_);
+
                 aux::threading::condvar::broadcast(condvar_);
             }
 
@@ -269,43 +273,36 @@ namespace std::aux
      * R template parameter and void.
      */
 
+    /**
+     * The async state is a task of the executor, the function
+     * runs on one of the worker fibrils instead of a freshly
+     * created fibril. Waiting is done on the condvar of the state.
+     */
     template<class R, class F, class... Args>
-    class async_shared_state: public shared_state<R>
+    class async_shared_state: public shared_state<R>, public executor_task
     {
         public:
-            async_shared_state(F&& f, Args&&... args)
-                : shared_state<R>{}, thread_{}
+            template<class G>
+            async_shared_state(G&& f, Args&&... args)
+                : shared_state<R>{}, func_{forward<G>(f)},
+                  args_{forward<Args>(args)...}
             {
-                thread_ = thread{
-                    [=](){
-                        try
-                        {
-                            if constexpr (!is_same_v<R, void>)
-                                this->set_value(invoke(f, args...));
-                            else
-                            {
-                                invoke(f, args...);
-                                this->mark_set(true);
-                            }
-                        }
-                        catch(const exception& __exception)
-                        {
-                            this->set_exception(make_exception_ptr(__exception));
-                        }
-                    }
-                };
+                executor::instance().submit(this);
+            }
+
+            void run() override
+            {
+                invoke_(make_index_sequence<sizeof...(Args)>{});
             }
 
             void destroy() override
             {
-                if (!this->is_set())
-                    thread_.join();
+                wait();
             }
 
             void wait() const override
             {
-                if (!this->is_set())
-                    const_cast<thread&>(thread_).join();
+                shared_state_base::wait();
             }
 
             ~async_shared_state() override
@@ -314,21 +311,47 @@ namespace std::aux
             }
 
         protected:
-            future_status timed_wait_(aux::time_unit_t time) const override
+            function<R(decay_t<Args>...)> func_;
+            tuple<decay_t<Args>...> args_;
+
+            template<size_t... Is>
+            void invoke_(index_sequence<Is...>)
             {
-                /**
-                 * Note: Currently we have no timed join, but this
-                 *       behaviour should be compliant.
-                 */
-                aux::threading::time::sleep(time);
-                if (this->value_set_)
-                    return future_status::ready;
-                else
-                    return future_status::timeout;
+                try
+                {
+                    if constexpr (!is_same_v<R, void>)
+                    {
+                        auto res = invoke(move(func_), get<Is>(move(args_))...);
+                        finish_([&](){ this->value_ = move(res); });
+                    }
+                    else
+                    {
+                        invoke(move(func_), get<Is>(move(args_))...);
+                        finish_([](){});
+                    }
+                }
+                catch(const exception& __exception)
+                {
+                    auto ptr = make_exception_ptr(__exception);
+                    finish_([&](){ this->set_exception(ptr); });
+                }
             }
 
-        private:
-            thread thread_;
+            /**
+             * Note: The owner of the future may destroy the state
+             *       as soon as it sees the value set, so we broadcast
+             *       while holding the mutex and do not touch the state
+             *       after unlocking it.
+             */
+            template<class Setter>
+            void finish_(Setter setter)
+            {
+                aux::threading::mutex::lock(this->mutex_);
+                setter();
+                this->value_set_ = true;
+                aux::threading::condvar::broadcast(this->condvar_);
+                aux::threading::mutex::unlock(this->mutex_);
+            }
     };
 
     template<class R, class F, class... Args>
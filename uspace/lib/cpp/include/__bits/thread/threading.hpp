@@ -31,6 +31,7 @@
 
 #include <chrono>
 
+#include <errno.h>
 #include <fibril.h>
 #include <fibril_synch.h>
 
@@ -77,6 +78,15 @@ namespace std::aux
                 ::helenos::fibril_yield();
             }
 
+            /**
+             * Lets ready fibrils run on more than one
+             * kernel thread, safe to call repeatedly.
+             */
+            static void enable_multithreaded()
+            {
+                ::helenos::fibril_enable_multithreaded();
+            }
+
             /**
              * Note: join & detach are performed at the C++
              *       level at the moment, but eventually should
@@ -108,8 +118,14 @@ namespace std::aux
 
             static bool try_lock_for(mutex_type& mtx, time_unit timeout)
             {
-                // TODO: we need fibril_mutex_trylock_for() :/
-                return try_lock(mtx);
+                /**
+                 * Note: A zero timeout means no timeout
+                 *       at all to fibril_mutex_lock_timeout.
+                 */
+                if (timeout <= 0)
+                    return try_lock(mtx);
+
+                return ::helenos::fibril_mutex_lock_timeout(&mtx, timeout) == EOK;
             }
         };
 
@@ -127,6 +143,10 @@ namespace std::aux
 
             static int wait_for(condvar_type& cv, mutex_type& mtx, time_unit timeout)
             {
+                // Same as above, an expired deadline must not block forever.
+                if (timeout <= 0)
+                    return ETIMEOUT;
+
                 return ::helenos::fibril_condvar_wait_timeout(&cv, &mtx, timeout);
             }
 
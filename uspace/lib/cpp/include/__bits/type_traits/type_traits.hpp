@@ -999,7 +999,7 @@ namespace std
     using make_signed_t = typename make_signed<T>::type;
 
     template<class T>
-    using make_unsigned_t = typename make_signed<T>::type;
+    using make_unsigned_t = typename make_unsigned<T>::type;
 
     /**
      * 20.10.7.4, array modifications:
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/thread/executor.hpp>
+#include <deque>
+#include <thread>
+
+namespace std::aux
+{
+    namespace
+    {
+        constexpr size_t no_worker{static_cast<size_t>(-1)};
+
+        /**
+         * Note: Thread local variables are fibril local
+         *       in HelenOS, so this identifies the worker
+         *       even when it migrates between runners.
+         */
+        thread_local size_t current_worker{no_worker};
+    }
+
+    struct executor::worker
+    {
+        executor* exec;
+        size_t idx;
+
+        mutex_t mutex;
+        deque<executor_task*> tasks;
+    };
+
+    executor& executor::instance()
+    {
+        static executor* exec = new executor{};
+
+        return *exec;
+    }
+
+    executor::executor()
+        : workers_{}, count_{}, pending_{0}, next_{0},
+          idle_mutex_{}, idle_cv_{}
+    {
+        threading::mutex::init(idle_mutex_);
+        threading::condvar::init(idle_cv_);
+
+        count_ = thread::hardware_concurrency();
+        if (count_ == 0)
+            count_ = 1;
+
+        threading::thread::enable_multithreaded();
+
+        workers_ = new worker[count_];
+        for (size_t i = 0; i < count_; ++i)
+        {
+            workers_[i].exec = this;
+            workers_[i].idx = i;
+            threading::mutex::init(workers_[i].mutex);
+        }
+
+        for (size_t i = 0; i < count_; ++i)
+        {
+            auto fid = threading::thread::create(worker_main_, workers_[i]);
+            threading::thread::start(fid);
+        }
+    }
+
+    void executor::submit(executor_task* task)
+    {
+        auto idx = current_worker;
+        if (idx == no_worker)
+            idx = next_.fetch_add(1, memory_order_relaxed) % count_;
+
+        auto& w = workers_[idx];
+        threading::mutex::lock(w.mutex);
+        w.tasks.push_back(task);
+        threading::mutex::unlock(w.mutex);
+
+        pending_.fetch_add(1, memory_order_release);
+
+        /**
+         * Note: Taking the idle mutex orders the wake up
+         *       after the check done by a worker that is
+         *       about to go to sleep.
+         */
+        threading::mutex::lock(idle_mutex_);
+        threading::condvar::signal(idle_cv_);
+        threading::mutex::unlock(idle_mutex_);
+    }
+
+    bool executor::on_worker() noexcept
+    {
+        return current_worker != no_worker;
+    }
+
+    executor_task* executor::take_(size_t idx)
+    {
+        executor_task* task{};
+
+        auto& own = workers_[idx];
+        threading::mutex::lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+        }
+        threading::mutex::unlock(own.mutex);
+
+        for (size_t i = 1; !task && i < count_; ++i)
+        {
+            auto& victim = workers_[(idx + i) % count_];
+
+            threading::mutex::lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+            }
+            threading::mutex::unlock(victim.mutex);
+        }
+
+        if (task)
+            pending_.fetch_sub(1, memory_order_relaxed);
+
+        return task;
+    }
+
+    void executor::work_(size_t idx)
+    {
+        current_worker = idx;
+
+        while (true)
+        {
+            auto task = take_(idx);
+            if (task)
+            {
+                task->run();
+                continue;
+            }
+
+            threading::mutex::lock(idle_mutex_);
+            while (pending_.load(memory_order_acquire) == 0)
+                threading::condvar::wait(idle_cv_, idle_mutex_);
+            threading::mutex::unlock(idle_mutex_);
+        }
+    }
+
+    int executor::worker_main_(void* arg)
+    {
+        auto w = static_cast<worker*>(arg);
+        w->exec->work_(w->idx);
+
+        return 0;
+    }
+}
@@ -136,7 +136,18 @@ namespace __cxxabiv1
     {
         static_guard_mtx.lock();
 
-        return !*((std::uint8_t*)guard);
+        /**
+         * Another fibril might have finished the initialization
+         * while we were waiting, release will not be called then.
+         */
+        if (*((std::uint8_t*)guard))
+        {
+            static_guard_mtx.unlock();
+
+            return 0;
+        }
+
+        return 1;
     }
 
     extern "C" void __cxa_guard_release(guard_t* guard)
@@ -29,8 +29,14 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdio>
+#include <execution>
+#include <list>
+#include <numeric>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace std::test
 {
@@ -41,6 +47,9 @@ namespace std::test
 
         test_non_modifying();
         test_mutating();
+        test_sorting();
+        test_sort_timing();
+        test_parallel();
 
         return end();
     }
@@ -293,4 +302,285 @@ namespace std::test
         );
         test_eq("transform pt2", res6, data10.end());
     }
+
+    void algorithm_test::test_sorting()
+    {
+        auto check1 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        std::array<int, 9> data1{5, 9, 1, 8, 2, 7, 3, 6, 4};
+
+        std::sort(data1.begin(), data1.end());
+        test_eq(
+            "sort pt1", check1.begin(), check1.end(),
+            data1.begin(), data1.end()
+        );
+
+        auto check2 = {9, 8, 7, 6, 5, 4, 3, 2, 1};
+        std::sort(
+            data1.begin(), data1.end(),
+            [](auto lhs, auto rhs){ return lhs > rhs; }
+        );
+        test_eq(
+            "sort pt2", check2.begin(), check2.end(),
+            data1.begin(), data1.end()
+        );
+
+        std::vector<int> data2(1000);
+        for (std::size_t i = 0; i < data2.size(); ++i)
+            data2[i] = (i * 7919) % 1000;
+        std::sort(data2.begin(), data2.end());
+        test("sort pt3", std::is_sorted(data2.begin(), data2.end()));
+
+        std::array<int, 5> data3{1, 2, 4, 3, 5};
+        test("is_sorted pt1", !std::is_sorted(data3.begin(), data3.end()));
+        test_eq(
+            "is_sorted_until",
+            std::is_sorted_until(data3.begin(), data3.end()), &data3[3]
+        );
+
+        /**
+         * Sort by the key only, the second members show
+         * whether elements with equal keys kept their order.
+         */
+        auto check3 = {
+            std::pair<int, int>{1, 1}, std::pair<int, int>{1, 3},
+            std::pair<int, int>{1, 5}, std::pair<int, int>{2, 0},
+            std::pair<int, int>{2, 4}, std::pair<int, int>{3, 2}
+        };
+        std::array<std::pair<int, int>, 6> data4{
+            std::pair<int, int>{2, 0}, std::pair<int, int>{1, 1},
+            std::pair<int, int>{3, 2}, std::pair<int, int>{1, 3},
+            std::pair<int, int>{2, 4}, std::pair<int, int>{1, 5}
+        };
+        std::stable_sort(
+            data4.begin(), data4.end(),
+            [](auto lhs, auto rhs){ return lhs.first < rhs.first; }
+        );
+        test_eq(
+            "stable_sort pt1", check3.begin(), check3.end(),
+            data4.begin(), data4.end()
+        );
+
+        std::vector<std::pair<int, int>> data5(1000);
+        for (int i = 0; i < 1000; ++i)
+            data5[i] = std::pair<int, int>{(i * 7919) % 10, i};
+        std::stable_sort(
+            data5.begin(), data5.end(),
+            [](auto lhs, auto rhs){ return lhs.first < rhs.first; }
+        );
+        test("stable_sort pt2", std::is_sorted(data5.begin(), data5.end()));
+
+        auto check4 = {1, 2, 3, 4};
+        std::array<int, 9> data6{5, 9, 1, 8, 2, 7, 3, 6, 4};
+        std::partial_sort(data6.begin(), data6.begin() + 4, data6.end());
+        test_eq(
+            "partial_sort", check4.begin(), check4.end(),
+            data6.begin(), data6.begin() + 4
+        );
+
+        std::array<int, 9> data7{5, 9, 1, 8, 2, 7, 3, 6, 4};
+        std::array<int, 4> data8{};
+        auto res1 = std::partial_sort_copy(
+            data7.begin(), data7.end(),
+            data8.begin(), data8.end()
+        );
+        test_eq(
+            "partial_sort_copy pt1", check4.begin(), check4.end(),
+            data8.begin(), data8.end()
+        );
+        test_eq("partial_sort_copy pt2", res1, data8.end());
+
+        std::nth_element(data7.begin(), data7.begin() + 4, data7.end());
+        test_eq("nth_element pt1", data7[4], 5);
+        test(
+            "nth_element pt2",
+            std::all_of(
+                data7.begin(), data7.begin() + 4,
+                [](auto x){ return x < 5; }
+            )
+        );
+
+        std::array<int, 7> data9{1, 2, 2, 2, 3, 5, 8};
+        test_eq(
+            "lower_bound",
+            std::lower_bound(data9.begin(), data9.end(), 2), &data9[1]
+        );
+        test_eq(
+            "upper_bound",
+            std::upper_bound(data9.begin(), data9.end(), 2), &data9[4]
+        );
+
+        auto check5 = {4, 5, 6, 7, 1, 2, 3};
+        std::array<int, 7> data10{1, 2, 3, 4, 5, 6, 7};
+        auto res2 = std::rotate(
+            data10.begin(), data10.begin() + 3, data10.end()
+        );
+        test_eq(
+            "rotate pt1", check5.begin(), check5.end(),
+            data10.begin(), data10.end()
+        );
+        test_eq("rotate pt2", res2, &data10[4]);
+    }
+
+    void algorithm_test::test_sort_timing()
+    {
+        /**
+         * Note: The timing is only reported, there is nothing
+         *       to compare it against, but the results are
+         *       still checked for correctness.
+         */
+        constexpr std::size_t count{100'000};
+        const char* inputs[] = {"random", "sorted", "reversed"};
+
+        for (int input = 0; input < 3; ++input)
+        {
+            std::vector<unsigned int> data(count);
+            unsigned int seed{1};
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (input == 0)
+                {
+                    seed = seed * 1103515245 + 12345;
+                    data[i] = seed >> 8;
+                }
+                else if (input == 1)
+                    data[i] = i;
+                else
+                    data[i] = count - i;
+            }
+
+            auto time = [&](const char* alg, auto func){
+                auto tmp = data;
+
+                auto start = std::chrono::steady_clock::now();
+                func(tmp);
+                auto end = std::chrono::steady_clock::now();
+
+                if (report_)
+                {
+                    auto usecs = std::chrono::duration_cast<
+                        std::chrono::microseconds
+                    >(end - start).count();
+                    std::printf("[%s][%s %s] %lld us\n", name(), alg,
+                                inputs[input], (long long)usecs);
+                }
+
+                return tmp;
+            };
+
+            auto res1 = time("sort_heap", [](auto& v){
+                std::make_heap(v.begin(), v.end());
+                std::sort_heap(v.begin(), v.end());
+            });
+            test("timing sort_heap", std::is_sorted(res1.begin(), res1.end()));
+
+            auto res2 = time("sort", [](auto& v){
+                std::sort(v.begin(), v.end());
+            });
+            test("timing sort", std::is_sorted(res2.begin(), res2.end()));
+
+            auto res2p = time("sort par", [](auto& v){
+                std::sort(std::execution::par, v.begin(), v.end());
+            });
+            test("timing sort par", res2p == res2);
+
+            auto res3 = time("stable_sort", [](auto& v){
+                std::stable_sort(v.begin(), v.end());
+            });
+            test(
+                "timing stable_sort",
+                std::is_sorted(res3.begin(), res3.end())
+            );
+
+            auto res4 = time("partial_sort", [](auto& v){
+                std::partial_sort(v.begin(), v.begin() + 100, v.end());
+            });
+            test(
+                "timing partial_sort",
+                std::equal(res4.begin(), res4.begin() + 100, res2.begin())
+            );
+
+            auto res5 = time("nth_element", [](auto& v){
+                std::nth_element(v.begin(), v.begin() + count / 2, v.end());
+            });
+            test_eq("timing nth_element", res5[count / 2], res2[count / 2]);
+        }
+    }
+
+    void algorithm_test::test_parallel()
+    {
+        std::vector<int> data1(10'000);
+        for (std::size_t i = 0; i < data1.size(); ++i)
+            data1[i] = (i * 7919) % 1000;
+
+        std::vector<int> res1(data1.size());
+        auto end1 = std::transform(
+            std::execution::par, data1.begin(), data1.end(),
+            res1.begin(), [](auto x){ return x * 2; }
+        );
+        test("transform par pt1", end1 == res1.end());
+        test(
+            "transform par pt2",
+            std::equal(
+                data1.begin(), data1.end(), res1.begin(),
+                [](auto x, auto y){ return x * 2 == y; }
+            )
+        );
+
+        std::transform(
+            std::execution::par, data1.begin(), data1.end(),
+            res1.begin(), res1.begin(), std::plus<>{}
+        );
+        test(
+            "transform par binary",
+            std::equal(
+                data1.begin(), data1.end(), res1.begin(),
+                [](auto x, auto y){ return x * 3 == y; }
+            )
+        );
+
+        auto sum1 = std::accumulate(data1.begin(), data1.end(), 0LL);
+        test_eq(
+            "reduce par pt1",
+            std::reduce(std::execution::par, data1.begin(), data1.end(), 0LL),
+            sum1
+        );
+        test_eq(
+            "reduce par pt2",
+            std::reduce(std::execution::par, data1.begin(), data1.begin()),
+            0
+        );
+        test_eq(
+            "reduce seq",
+            std::reduce(std::execution::seq, data1.begin(), data1.end(), 0LL),
+            sum1
+        );
+
+        std::for_each(
+            std::execution::par_unseq, res1.begin(), res1.end(),
+            [](auto& x){ x = 1; }
+        );
+        test_eq(
+            "for_each par",
+            std::count(res1.begin(), res1.end(), 1),
+            static_cast<std::ptrdiff_t>(res1.size())
+        );
+
+        std::sort(std::execution::par, data1.begin(), data1.end(),
+                  [](auto lhs, auto rhs){ return lhs > rhs; });
+        test(
+            "sort par",
+            std::is_sorted(data1.rbegin(), data1.rend())
+        );
+
+        std::list<int> data2{3, 1, 2};
+        std::for_each(
+            std::execution::par, data2.begin(), data2.end(),
+            [](auto& x){ ++x; }
+        );
+        test_eq(
+            "reduce par list",
+            std::reduce(std::execution::par, data2.begin(), data2.end()),
+            9
+        );
+    }
 }
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <atomic>
+#include <cstdint>
+
+namespace std::test
+{
+    namespace
+    {
+        struct triple
+        {
+            long a;
+            long b;
+            long c;
+        };
+    }
+
+    bool atomic_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_integral();
+        test_pointer();
+        test_compare_exchange();
+        test_lock_based();
+        test_flag();
+
+        return end();
+    }
+
+    const char* atomic_test::name()
+    {
+        return "atomic";
+    }
+
+    void atomic_test::test_integral()
+    {
+        std::atomic<int> a{5};
+        test_eq("initial value", a.load(), 5);
+        test_eq("lock free", a.is_lock_free(), true);
+
+        test_eq("fetch_add result", a.fetch_add(3), 5);
+        test_eq("fetch_add value", a.load(), 8);
+        test_eq("fetch_sub result", a.fetch_sub(2, std::memory_order_relaxed), 8);
+        test_eq("pre-increment", ++a, 7);
+        test_eq("post-decrement", a--, 7);
+        test_eq("compound add", (a += 10), 16);
+        test_eq("compound or", (a |= 1), 17);
+        test_eq("compound and", (a &= 3), 1);
+        test_eq("compound xor", (a ^= 3), 2);
+
+        a = 42;
+        test_eq("assignment", a.load(), 42);
+        test_eq("exchange result", a.exchange(1), 42);
+        test_eq("exchange value", static_cast<int>(a), 1);
+
+        std::atomic<std::uint8_t> b{255};
+        ++b;
+        test_eq("unsigned wraparound", b.load(), static_cast<std::uint8_t>(0));
+
+        std::atomic_long c{};
+        std::atomic_init(&c, 3L);
+        std::atomic_fetch_add(&c, 4L);
+        test_eq("free functions", std::atomic_load(&c), 7L);
+    }
+
+    void atomic_test::test_pointer()
+    {
+        int arr[5]{};
+        std::atomic<int*> p{arr};
+
+        test_eq("pointer fetch_add result", p.fetch_add(2), &arr[0]);
+        test_eq("pointer fetch_add scales", p.load(), &arr[2]);
+        test_eq("pointer pre-decrement", --p, &arr[1]);
+        test_eq("pointer compound add", (p += 3), &arr[4]);
+        test_eq("pointer fetch_sub", p.fetch_sub(4), &arr[4]);
+        test_eq("pointer fetch_sub value", p.load(), &arr[0]);
+    }
+
+    void atomic_test::test_compare_exchange()
+    {
+        std::atomic<long> a{10};
+
+        long expected{3};
+        auto res1 = a.compare_exchange_strong(expected, 20);
+        test_eq("failed compare_exchange", res1, false);
+        test_eq("failed compare_exchange loads value", expected, 10L);
+
+        auto res2 = a.compare_exchange_strong(expected, 20);
+        test_eq("successful compare_exchange", res2, true);
+        test_eq("successful compare_exchange stores value", a.load(), 20L);
+
+        expected = a.load();
+        while (!a.compare_exchange_weak(expected, expected * 2,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed))
+        { /* DUMMY BODY */ }
+        test_eq("compare_exchange_weak loop", a.load(), 40L);
+    }
+
+    void atomic_test::test_lock_based()
+    {
+        std::atomic<triple> t{triple{1, 2, 3}};
+
+        auto val = t.load();
+        test_eq("struct load", val.c, 3L);
+
+        t.store(triple{4, 5, 6});
+        test_eq("struct store", t.load().a, 4L);
+
+        triple expected{4, 5, 6};
+        auto res1 = t.compare_exchange_strong(expected, triple{7, 8, 9});
+        test_eq("struct compare_exchange", res1, true);
+        test_eq("struct compare_exchange value", t.load().b, 8L);
+
+        auto res2 = t.compare_exchange_strong(expected, triple{0, 0, 0});
+        test_eq("struct failed compare_exchange", res2, false);
+        test_eq("struct failed compare_exchange loads value", expected.c, 9L);
+
+        auto old = t.exchange(triple{1, 1, 1});
+        test_eq("struct exchange", old.a, 7L);
+    }
+
+    void atomic_test::test_flag()
+    {
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+
+        test_eq("flag initially clear", flag.test_and_set(), false);
+        test_eq("flag set", flag.test_and_set(), true);
+
+        flag.clear(std::memory_order_release);
+        test_eq("flag cleared", std::atomic_flag_test_and_set(&flag), false);
+    }
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <initializer_list>
+#include <unordered_map>
+#include <string>
+#include <sstream>
+#include <utility>
+
+namespace std::test
+{
+    bool flat_hash_map_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_constructors_and_assignment();
+        test_histogram();
+        test_emplace_insert();
+        test_erase_and_growth();
+
+        return end();
+    }
+
+    const char* flat_hash_map_test::name()
+    {
+        return "flat_hash_map";
+    }
+
+    void flat_hash_map_test::test_constructors_and_assignment()
+    {
+        auto check1 = {1, 2, 3, 4, 5, 6, 7};
+        auto src1 = {
+            std::pair<const int, int>{3, 3},
+            std::pair<const int, int>{1, 1},
+            std::pair<const int, int>{5, 5},
+            std::pair<const int, int>{2, 2},
+            std::pair<const int, int>{7, 7},
+            std::pair<const int, int>{6, 6},
+            std::pair<const int, int>{4, 4}
+        };
+
+        std::__helenos::flat_hash_map<int, int> m1{src1};
+        test_contains(
+            "initializer list initialization",
+            check1.begin(), check1.end(), m1
+        );
+        test_eq("size", m1.size(), 7U);
+
+        std::__helenos::flat_hash_map<int, int> m2{src1.begin(), src1.end()};
+        test_contains(
+            "iterator range initialization",
+            check1.begin(), check1.end(), m2
+        );
+
+        std::__helenos::flat_hash_map<int, int> m3{m1};
+        test_contains(
+            "copy initialization",
+            check1.begin(), check1.end(), m3
+        );
+        test_eq("copy equality", (m1 == m3), true);
+
+        std::__helenos::flat_hash_map<int, int> m4{std::move(m1)};
+        test_contains(
+            "move initialization",
+            check1.begin(), check1.end(), m4
+        );
+        test_eq("move initialization - origin empty", m1.size(), 0U);
+        test_eq("empty", m1.empty(), true);
+
+        m1 = m4;
+        test_contains(
+            "copy assignment",
+            check1.begin(), check1.end(), m1
+        );
+
+        m4 = std::move(m1);
+        test_contains(
+            "move assignment",
+            check1.begin(), check1.end(), m4
+        );
+        test_eq("move assignment - origin empty", m1.size(), 0U);
+
+        m1 = src1;
+        test_contains(
+            "initializer list assignment",
+            check1.begin(), check1.end(), m1
+        );
+
+        m1[8] = 8;
+        test_eq("inequality", (m1 != m4), true);
+    }
+
+    void flat_hash_map_test::test_histogram()
+    {
+        std::string str{"a b a a c d b e a b b e d c a e"};
+        std::__helenos::flat_hash_map<std::string, std::size_t> map{};
+        std::istringstream iss{str};
+        std::string word{};
+
+        while (iss >> word)
+            ++map[word];
+
+        test_eq("histogram pt1", map["a"], 5U);
+        test_eq("histogram pt2", map["b"], 4U);
+        test_eq("histogram pt3", map["c"], 2U);
+        test_eq("histogram pt4", map["d"], 2U);
+        test_eq("histogram pt5", map["e"], 3U);
+        test_eq("histogram pt6", map["f"], 0U);
+        test_eq("at", map.at("a"), 5U);
+    }
+
+    void flat_hash_map_test::test_emplace_insert()
+    {
+        std::__helenos::flat_hash_map<int, int> map1{};
+
+        auto res1 = map1.emplace(1, 2);
+        test_eq("first emplace succession", res1.second, true);
+        test_eq("first emplace equivalence pt1", res1.first->first, 1);
+        test_eq("first emplace equivalence pt2", res1.first->second, 2);
+
+        auto res2 = map1.emplace(1, 3);
+        test_eq("second emplace failure", res2.second, false);
+        test_eq("second emplace equivalence pt1", res2.first->first, 1);
+        test_eq("second emplace equivalence pt2", res2.first->second, 2);
+
+        std::__helenos::flat_hash_map<int, std::string> map2{};
+        auto res3 = map2.insert(std::pair<const int, const char*>{5, "A"});
+        test_eq("conversion insert succession", res3.second, true);
+        test_eq("conversion insert equivalence pt1", res3.first->first, 5);
+        test_eq("conversion insert equivalence pt2", res3.first->second, std::string{"A"});
+
+        auto res4 = map2.insert(std::pair<const int, std::string>{6, "B"});
+        test_eq("first insert succession", res4.second, true);
+        test_eq("first insert equivalence pt1", res4.first->first, 6);
+        test_eq("first insert equivalence pt2", res4.first->second, std::string{"B"});
+
+        auto res5 = map2.insert(std::pair<const int, std::string>{6, "C"});
+        test_eq("second insert failure", res5.second, false);
+        test_eq("second insert equivalence", res5.first->second, std::string{"B"});
+
+        auto res6 = map2.try_emplace(6, "D");
+        test_eq("try_emplace failure", res6.second, false);
+        test_eq("try_emplace equivalence", res6.first->second, std::string{"B"});
+
+        auto res7 = map2.try_emplace(7, 3U, 'x');
+        test_eq("try_emplace succession", res7.second, true);
+        test_eq("try_emplace construction", res7.first->second, std::string{"xxx"});
+
+        auto res8 = map2.insert_or_assign(6, std::string{"D"});
+        test_eq("insert_or_*assign* result", res8.second, false);
+        test_eq("insert_or_*assign* equivalence", res8.first->second, std::string{"D"});
+
+        auto res9 = map2.insert_or_assign(8, std::string{"E"});
+        test_eq("*insert*_or_assign result", res9.second, true);
+        test_eq("*insert*_or_assign equivalence", res9.first->second, std::string{"E"});
+
+        map2.erase(map2.find(7));
+        test_eq("erase", map2.find(7), map2.end());
+
+        auto res10 = map2.erase(6);
+        test_eq("erase by key pt1", res10, 1U);
+        auto res11 = map2.erase(6);
+        test_eq("erase by key pt2", res11, 0U);
+        test_eq("count", map2.count(8), 1U);
+
+        map2.clear();
+        test_eq("clear", map2.empty(), true);
+        test_eq("find after clear", map2.find(8), map2.end());
+    }
+
+    void flat_hash_map_test::test_erase_and_growth()
+    {
+        std::__helenos::flat_hash_map<int, int> map{};
+
+        for (int i = 0; i < 1000; ++i)
+            map[i] = i * 2;
+        test_eq("growth size", map.size(), 1000U);
+        test_eq("growth load factor", (map.load_factor() <= map.max_load_factor()), true);
+
+        bool ok{true};
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto it = map.find(i);
+            if (it == map.end() || it->second != i * 2)
+                ok = false;
+        }
+        test_eq("growth lookup", ok, true);
+
+        for (auto it = map.begin(); it != map.end();)
+        {
+            if (it->first % 2 == 1)
+                it = map.erase(it);
+            else
+                ++it;
+        }
+        test_eq("erase while iterating size", map.size(), 500U);
+
+        ok = true;
+        for (int i = 0; i < 1000; ++i)
+        {
+            if (map.count(i) != (i % 2 == 0 ? 1U : 0U))
+                ok = false;
+        }
+        test_eq("erase while iterating lookup", ok, true);
+
+        /**
+         * Keeps a sliding window of keys, the table should
+         * reuse the erased slots instead of growing.
+         */
+        std::__helenos::flat_hash_map<int, int> window{};
+        for (int i = 0; i < 10000; ++i)
+        {
+            window[i] = i;
+            if (i >= 10)
+                window.erase(i - 10);
+        }
+        test_eq("sliding window size", window.size(), 10U);
+        test_eq("sliding window capacity", (window.bucket_count() <= 64U), true);
+
+        map.erase(map.begin(), map.end());
+        test_eq("range erase", map.empty(), true);
+
+        map.reserve(100);
+        auto buckets = map.bucket_count();
+        for (int i = 0; i < 100; ++i)
+            map[i] = i;
+        test_eq("reserve", map.bucket_count(), buckets);
+    }
+}
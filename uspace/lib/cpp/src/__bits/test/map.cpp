@@ -47,6 +47,7 @@ namespace std::test
         test_multi();
         test_reverse_iterators();
         test_multi_bounds_and_ranges();
+        test_node_handles();
 
         return end();
     }
@@ -240,7 +241,7 @@ namespace std::test
         test_eq("lower_bound of present key", res1->first, 5);
 
         auto res2 = map.lower_bound(13);
-        test_eq("lower_bound of absent key", res2->first, 9);
+        test_eq("lower_bound of absent key", res2->first, 15);
 
         auto res3 = map.upper_bound(7);
         test_eq("upper_bound of present key", res3->first, 8);
@@ -253,7 +254,7 @@ namespace std::test
         test_eq("equal_range of present key pt2", res5.second->first, 5);
 
         auto res6 = map.equal_range(14);
-        test_eq("equal_range of absent key pt1", res6.first->first, 9);
+        test_eq("equal_range of absent key pt1", res6.first->first, 15);
         test_eq("equal_range of absent key pt2", res6.second->first, 15);
     }
 
@@ -431,4 +432,64 @@ namespace std::test
             res3.first, res3.second
         );
     }
+
+    void map_test::test_node_handles()
+    {
+        std::map<int, int> map{
+            {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}
+        };
+
+        auto node1 = map.extract(3);
+        test("extract pt1", !node1.empty());
+        test_eq("extract pt2", node1.key(), 3);
+        test_eq("extract pt3", map.size(), 4U);
+        test_eq("extract pt4", map.count(3), 0U);
+
+        node1.key() = 6;
+        node1.mapped() = 42;
+        auto res1 = map.insert(std::move(node1));
+        test("insert node pt1", res1.inserted);
+        test("insert node pt2", node1.empty());
+        test_eq("insert node pt3", res1.position->first, 6);
+        test_eq("insert node pt4", map[6], 42);
+
+        auto node2 = map.extract(map.find(1));
+        node2.key() = 2;
+        auto res2 = map.insert(std::move(node2));
+        test("insert duplicit node pt1", !res2.inserted);
+        test("insert duplicit node pt2", !res2.node.empty());
+        test_eq("insert duplicit node pt3", res2.position->first, 2);
+
+        auto node3 = map.extract(42);
+        test("extract missing key", node3.empty());
+
+        auto check1 = {
+            std::pair<const int, int>{1, 1},
+            std::pair<const int, int>{2, 2},
+            std::pair<const int, int>{4, 4},
+            std::pair<const int, int>{5, 5},
+            std::pair<const int, int>{6, 42},
+            std::pair<const int, int>{7, 7}
+        };
+        std::map<int, int> src{{1, 1}, {2, 3}, {7, 7}};
+        map.merge(src);
+        test_eq(
+            "merge",
+            check1.begin(), check1.end(),
+            map.begin(), map.end()
+        );
+        test_eq("merge leftovers pt1", src.size(), 1U);
+        test_eq("merge leftovers pt2", src[2], 3);
+
+        std::multimap<int, int> mmap{{2, 4}, {2, 5}, {8, 8}};
+        mmap.merge(map);
+        test_eq("multi merge pt1", map.size(), 0U);
+        test_eq("multi merge pt2", mmap.size(), 9U);
+        test_eq("multi merge pt3", mmap.count(2), 3U);
+
+        auto node4 = mmap.extract(mmap.find(2));
+        auto res3 = mmap.insert(std::move(node4));
+        test_eq("multi insert node", mmap.count(2), 3U);
+        test_eq("multi insert node position", res3->first, 2);
+    }
 }
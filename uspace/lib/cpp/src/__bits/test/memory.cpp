@@ -198,6 +198,7 @@ namespace std::test
             }
             test_eq("weak_ptr expired after all shared_ptrs die", wptr1.expired(), true);
             test_eq("shared object destroyed while weak_ptr exists", mock::destructor_calls, 1U);
+            test_eq("lock of expired weak_ptr", (bool)wptr1.lock(), false);
         }
     }
 
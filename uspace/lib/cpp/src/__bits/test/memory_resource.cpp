@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        /**
+         * Forwards to the new/delete resource and keeps
+         * track of the number of bytes that are in use.
+         */
+        class counting_resource: public pmr::memory_resource
+        {
+            public:
+                size_t used{};
+                size_t allocations{};
+
+            private:
+                void* do_allocate(size_t bytes, size_t alignment) override
+                {
+                    ++allocations;
+                    used += bytes;
+
+                    return pmr::new_delete_resource()->allocate(bytes, alignment);
+                }
+
+                void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+                {
+                    used -= bytes;
+                    pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+                }
+
+                bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+        };
+
+        bool aligned(void* ptr, size_t alignment)
+        {
+            return (reinterpret_cast<uintptr_t>(ptr) & (alignment - 1)) == 0;
+        }
+    }
+
+    bool memory_resource_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_resources();
+        test_pool_resource();
+        test_monotonic_resource();
+        test_containers();
+
+        return end();
+    }
+
+    const char* memory_resource_test::name()
+    {
+        return "memory_resource";
+    }
+
+    void memory_resource_test::test_resources()
+    {
+        auto nd = pmr::new_delete_resource();
+        test_eq("new_delete_resource singleton", nd, pmr::new_delete_resource());
+        test("new_delete_resource equality", *nd == *nd);
+
+        auto ptr = nd->allocate(100, 64);
+        test("new_delete_resource over-aligned", aligned(ptr, 64));
+        nd->deallocate(ptr, 100, 64);
+
+        auto null = pmr::null_memory_resource();
+        test("null_memory_resource inequality", *null != *nd);
+
+        bool thrown{false};
+        try
+        {
+            null->allocate(1);
+        }
+        catch (const bad_alloc&)
+        {
+            thrown = true;
+        }
+        test("null_memory_resource throws", thrown);
+
+        test_eq("default resource", pmr::get_default_resource(), nd);
+        auto old = pmr::set_default_resource(null);
+        test_eq("set_default_resource returns previous", old, nd);
+        test_eq("default resource changed", pmr::get_default_resource(), null);
+        pmr::set_default_resource(nullptr);
+        test_eq("default resource reset", pmr::get_default_resource(), nd);
+    }
+
+    void memory_resource_test::test_pool_resource()
+    {
+        counting_resource upstream{};
+
+        {
+            pmr::unsynchronized_pool_resource pool{&upstream};
+            test_eq("pool upstream", pool.upstream_resource(), &upstream);
+
+            // The pool bookkeeping lives until destruction.
+            auto baseline = upstream.used;
+
+            void* small[64];
+            for (auto& ptr: small)
+                ptr = pool.allocate(24);
+            for (auto ptr: small)
+                test("pool alignment", aligned(ptr, alignof(max_align_t)));
+
+            auto allocations = upstream.allocations;
+            pool.deallocate(small[7], 24);
+            test_eq(
+                "pool reuses blocks",
+                pool.allocate(24), small[7]
+            );
+            test_eq("pool reuse without upstream", upstream.allocations, allocations);
+
+            auto big = pool.allocate(1 << 16, 128);
+            test("pool large block alignment", aligned(big, 128));
+            pool.deallocate(big, 1 << 16, 128);
+
+            for (auto ptr: small)
+                pool.deallocate(ptr, 24);
+
+            pool.release();
+            test_eq("pool release", upstream.used, baseline);
+
+            pool.allocate(8);
+        }
+        test_eq("pool destructor releases", upstream.used, 0U);
+
+        pmr::pool_options opts{};
+        opts.largest_required_pool_block = 100;
+        pmr::synchronized_pool_resource spool{opts, &upstream};
+        test(
+            "pool options largest block",
+            spool.options().largest_required_pool_block >= 100U
+        );
+
+        auto ptr = spool.allocate(200);
+        test("synchronized pool allocation", ptr != nullptr);
+        spool.deallocate(ptr, 200);
+    }
+
+    void memory_resource_test::test_monotonic_resource()
+    {
+        counting_resource upstream{};
+        char buffer[256];
+
+        {
+            pmr::monotonic_buffer_resource mono{buffer, sizeof(buffer), &upstream};
+
+            auto ptr1 = static_cast<char*>(mono.allocate(100, 1));
+            test("monotonic initial buffer", ptr1 >= buffer && ptr1 < buffer + sizeof(buffer));
+            test_eq("monotonic no upstream", upstream.allocations, 0U);
+
+            auto ptr2 = mono.allocate(16, 16);
+            test("monotonic alignment", aligned(ptr2, 16));
+
+            mono.allocate(1000);
+            test_eq("monotonic upstream", upstream.allocations, 1U);
+
+            mono.release();
+            test_eq("monotonic release", upstream.used, 0U);
+
+            auto ptr3 = static_cast<char*>(mono.allocate(100, 1));
+            test_eq("monotonic buffer reused", ptr3, ptr1);
+
+            for (int i = 0; i < 100; ++i)
+                mono.allocate(64);
+        }
+        test_eq("monotonic destructor releases", upstream.used, 0U);
+    }
+
+    void memory_resource_test::test_containers()
+    {
+        counting_resource res1{};
+        counting_resource res2{};
+
+        {
+            pmr::vector<int> v1{&res1};
+            for (int i = 0; i < 100; ++i)
+                v1.push_back(i);
+            test("vector uses resource", res1.used > 0U);
+
+            pmr::vector<int> v2{&res2};
+            v2 = v1;
+            test_eq("vector copy assignment keeps resource", v2.get_allocator().resource(), &res2);
+            test_eq("vector copy assignment size", v2.size(), 100U);
+
+            pmr::vector<int> v3{v1};
+            test_eq(
+                "vector copy uses default resource",
+                v3.get_allocator().resource(), pmr::get_default_resource()
+            );
+
+            v2 = std::move(v1);
+            test_eq("vector move assignment keeps resource", v2.get_allocator().resource(), &res2);
+            test_eq("vector move assignment value", v2[99], 99);
+        }
+        test_eq("vector frees memory", res1.used + res2.used, 0U);
+
+        {
+            pmr::map<int, pmr::string> m{&res1};
+            for (int i = 0; i < 50; ++i)
+                m.emplace(i, "a fairly long string that does not fit inline");
+            test("map uses resource", res1.used > 0U);
+
+            pmr::map<int, pmr::string> m2{&res2};
+            m2 = m;
+            test_eq("map copy assignment size", m2.size(), 50U);
+            test("map copy assignment resource", res2.used > 0U);
+
+            for (int i = 0; i < 50; i += 2)
+                m.erase(i);
+            test_eq("map erase", m.size(), 25U);
+            test_eq("map find", m.find(1)->second, m2[1]);
+        }
+        test_eq("map frees memory", res1.used + res2.used, 0U);
+
+        {
+            pmr::unsynchronized_pool_resource pool{&res1};
+            pmr::unordered_map<int, int> um{&pool};
+            for (int i = 0; i < 1000; ++i)
+                um[i] = i * 2;
+            test_eq("unordered_map size", um.size(), 1000U);
+            test_eq("unordered_map value", um[500], 1000);
+
+            pmr::set<int> s{&pool};
+            for (int i = 0; i < 100; ++i)
+                s.insert(100 - i);
+            test_eq("set ordering", *s.begin(), 1);
+        }
+        test_eq("pool containers free memory", res1.used, 0U);
+    }
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace std::chrono_literals;
+using std::__helenos::channel_status;
+
+namespace std::test
+{
+    bool mpsc_channel_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_try_ops();
+        test_close();
+        test_timeouts();
+        test_producers();
+
+        return end();
+    }
+
+    const char* mpsc_channel_test::name()
+    {
+        return "mpsc_channel";
+    }
+
+    void mpsc_channel_test::test_try_ops()
+    {
+        std::__helenos::mpsc_channel<int> chan{3};
+        test_eq("capacity rounded up", chan.capacity(), 4U);
+
+        int value{};
+        test_eq("try_receive empty", chan.try_receive(value), channel_status::empty);
+
+        bool sent{true};
+        for (int i = 0; i < 4; ++i)
+            sent = sent && chan.try_send(i) == channel_status::success;
+        test("try_send until full", sent);
+        test_eq("try_send full", chan.try_send(4), channel_status::full);
+
+        test_eq("try_receive pt1", chan.try_receive(value), channel_status::success);
+        test_eq("try_receive pt2", value, 0);
+        test_eq("try_send after receive", chan.try_send(4), channel_status::success);
+
+        bool in_order{true};
+        for (int i = 1; i < 5; ++i)
+        {
+            in_order = in_order && chan.try_receive(value) == channel_status::success;
+            in_order = in_order && value == i;
+        }
+        test("fifo order", in_order);
+
+        std::__helenos::mpsc_channel<std::string> strings{2};
+        strings.send(std::string(64, 'a'));
+        strings.send("b");
+
+        std::string str{};
+        strings.receive(str);
+        test_eq("move only payload", str.size(), 64U);
+    }
+
+    void mpsc_channel_test::test_close()
+    {
+        std::__helenos::mpsc_channel<int> chan{4};
+        chan.send(1);
+        chan.send(2);
+        chan.close();
+
+        test("closed", chan.closed());
+        test_eq("send after close", chan.send(3), channel_status::closed);
+
+        int value{};
+        test_eq("drain after close pt1", chan.receive(value), channel_status::success);
+        test_eq("drain after close pt2", value, 1);
+        test_eq("drain after close pt3", chan.receive(value), channel_status::success);
+        test_eq("drain after close pt4", value, 2);
+        test_eq("drained", chan.receive(value), channel_status::closed);
+
+        std::__helenos::mpsc_channel<int> chan2{4};
+        std::thread closer{[&chan2]{
+            std::this_thread::sleep_for(10ms);
+            chan2.close();
+        }};
+        test_eq("close wakes receiver", chan2.receive(value), channel_status::closed);
+        closer.join();
+    }
+
+    void mpsc_channel_test::test_timeouts()
+    {
+        std::__helenos::mpsc_channel<int> chan{1};
+
+        int value{};
+        test_eq("receive_for empty", chan.receive_for(value, 1ms), channel_status::timeout);
+
+        chan.send(1);
+        test_eq("send_for full", chan.send_for(2, 1ms), channel_status::timeout);
+
+        std::timed_mutex mtx{};
+        mtx.lock();
+
+        bool locked{true};
+        std::thread locker{[&mtx, &locked]{
+            locked = mtx.try_lock_for(1ms);
+        }};
+        locker.join();
+        test("try_lock_for timeout", !locked);
+
+        mtx.unlock();
+        test("try_lock_for unlocked", mtx.try_lock_for(1ms));
+        mtx.unlock();
+    }
+
+    void mpsc_channel_test::test_producers()
+    {
+        constexpr int producers{4};
+        constexpr int messages{1000};
+
+        std::__helenos::mpsc_channel<std::pair<int, int>> chan{8};
+        std::thread threads[producers]{};
+        for (int p = 0; p < producers; ++p)
+        {
+            threads[p] = std::thread{[&chan, p]{
+                for (int i = 0; i < messages; ++i)
+                    chan.send(std::make_pair(p, i));
+            }};
+        }
+
+        int next[producers]{};
+        bool in_order{true};
+        std::pair<int, int> msg{};
+        for (int i = 0; i < producers * messages; ++i)
+        {
+            if (chan.receive(msg) != channel_status::success)
+            {
+                in_order = false;
+                break;
+            }
+
+            in_order = in_order && msg.second == next[msg.first]++;
+        }
+
+        for (auto& thr: threads)
+            thr.join();
+
+        test("per producer fifo order", in_order);
+        test_eq("all received", chan.try_receive(msg), channel_status::empty);
+    }
+}
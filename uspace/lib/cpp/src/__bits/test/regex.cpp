@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace std::test
+{
+    bool regex_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_match();
+        test_search();
+        test_groups();
+        test_posix();
+        test_flags();
+        test_iterators();
+        test_replace();
+        test_errors();
+        test_complexity();
+
+        return end();
+    }
+
+    const char* regex_test::name()
+    {
+        return "regex";
+    }
+
+    void regex_test::test_match()
+    {
+        std::regex re{"[a-z]+[0-9]{2,3}"};
+        test("match pt1", std::regex_match("abc12", re));
+        test("match pt2", std::regex_match("abc1234", re) == false);
+        test("match pt3", std::regex_match("12", re) == false);
+        test("match pt4", std::regex_match(std::string{"x999"}, re));
+
+        std::regex alt{"a|ab"};
+        test("match alternation", std::regex_match("ab", alt));
+
+        std::regex icase{"hello", std::regex::icase};
+        test("match icase", std::regex_match("HeLLo", icase));
+
+        std::regex classes{"[[:alpha:]_]\\w*\\s*=\\s*\\d+"};
+        test("match classes", std::regex_match("foo_1 = 42", classes));
+
+        std::regex empty{};
+        test_eq("default constructed", empty.mark_count(), 0U);
+        test("default constructed never matches", std::regex_search("abc", empty) == false);
+    }
+
+    void regex_test::test_search()
+    {
+        std::regex re{"\\bfoo\\b"};
+        std::cmatch m{};
+
+        test("search pt1", std::regex_search("a foobar foo", m, re));
+        test_eq("search pt2", m.position(), 9);
+        test_eq("search pt3", m.length(), 3);
+        test_eq("search pt4", m.prefix().str(), std::string{"a foobar "});
+        test_eq("search pt5", m.suffix().length(), 0);
+
+        std::regex lazy{"<.*?>"};
+        test("search lazy pt1", std::regex_search("<a><b>", m, lazy));
+        test_eq("search lazy pt2", m.str(), std::string{"<a>"});
+
+        std::regex greedy{"<.*>"};
+        test("search greedy pt1", std::regex_search("<a><b>", m, greedy));
+        test_eq("search greedy pt2", m.str(), std::string{"<a><b>"});
+
+        std::regex lines{"^b$", std::regex::multiline};
+        test("search multiline", std::regex_search("a\nb\nc", m, lines));
+        test_eq("search multiline position", m.position(), 2);
+
+        std::regex anchored{"^b$"};
+        test("search not multiline", std::regex_search("a\nb\nc", anchored) == false);
+
+        std::vector<char> vec{'x', 'y', 'a', 'b'};
+        std::match_results<std::vector<char>::iterator> vm{};
+        test("search vector pt1", std::regex_search(vec.begin(), vec.end(), vm, std::regex{"ab"}));
+        test_eq("search vector pt2", vm.position(), 2);
+    }
+
+    void regex_test::test_groups()
+    {
+        std::regex re{"(\\w+)@(\\w+)\\.(com|org)"};
+        std::smatch m{};
+        std::string str{"mail joe@example.org now"};
+
+        test_eq("mark_count", re.mark_count(), 3U);
+        test("groups pt1", std::regex_search(str, m, re));
+        test_eq("groups pt2", m.size(), 4U);
+        test_eq("groups pt3", m[1].str(), std::string{"joe"});
+        test_eq("groups pt4", m[2].str(), std::string{"example"});
+        test_eq("groups pt5", m[3].str(), std::string{"org"});
+        test_eq("groups pt6", m.position(2), 9);
+
+        std::string b{"b"};
+        std::regex opt{"(a)|(b)"};
+        test("unmatched group pt1", std::regex_match(b, m, opt));
+        test("unmatched group pt2", m[1].matched == false);
+        test("unmatched group pt3", m[2].matched);
+        test_eq("unmatched group pt4", m[5].matched, false);
+
+        std::string ab{"ab"};
+        std::regex rep{"(?:(a)|b)+"};
+        test("iteration reset pt1", std::regex_match(ab, m, rep));
+        test("iteration reset pt2", m[1].matched == false);
+
+        std::regex last{"(?:(a)|(b))+"};
+        test("last iteration pt1", std::regex_match(ab, m, last));
+        test_eq("last iteration pt2", m[2].str(), std::string{"b"});
+
+        std::regex prio{"(a|ab)(c|bcd)(d*)"};
+        std::string abcd{"abcd"};
+        test("ecma priority pt1", std::regex_match(abcd, m, prio));
+        test_eq("ecma priority pt2", m[1].str(), std::string{"a"});
+        test_eq("ecma priority pt3", m[2].str(), std::string{"bcd"});
+
+        std::regex nosubs{"(a)(b)", std::regex::nosubs};
+        test_eq("nosubs pt1", nosubs.mark_count(), 0U);
+        test("nosubs pt2", std::regex_match(ab, m, nosubs));
+        test_eq("nosubs pt3", m.size(), 1U);
+    }
+
+    void regex_test::test_posix()
+    {
+        std::cmatch m{};
+
+        std::regex ext{"a|ab|abc", std::regex::extended};
+        test("extended longest pt1", std::regex_search("xabcd", m, ext));
+        test_eq("extended longest pt2", m.str(), std::string{"abc"});
+
+        std::regex ext2{"(foo|foobar)baz", std::regex::extended};
+        test("extended longest pt3", std::regex_search("foobarbaz", m, ext2));
+        test_eq("extended longest pt4", m[1].str(), std::string{"foobar"});
+
+        std::regex bre{"\\(ab\\)*c\\{2\\}", std::regex::basic};
+        test("basic pt1", std::regex_match("ababcc", m, bre));
+        test_eq("basic pt2", m[1].str(), std::string{"ab"});
+        test("basic pt3", std::regex_match("a+b", std::regex{"a+b", std::regex::basic}));
+
+        std::regex grep{"ERROR\nWARN", std::regex::grep};
+        test("grep newline alternation", std::regex_search("x WARN y", grep));
+
+        std::regex egrep{"ERROR|WARN", std::regex::egrep};
+        test("egrep", std::regex_search("x ERROR y", egrep));
+
+        std::regex brack{"[]a]+", std::regex::extended};
+        test("bracket leading ] pt1", std::regex_search("x]a]", m, brack));
+        test_eq("bracket leading ] pt2", m.length(), 3);
+    }
+
+    void regex_test::test_flags()
+    {
+        std::regex bol{"^a"};
+        test("not_bol", std::regex_search("ab", bol, std::regex_constants::match_not_bol) == false);
+
+        std::regex eol{"a$"};
+        test("not_eol", std::regex_search("ba", eol, std::regex_constants::match_not_eol) == false);
+
+        std::regex star{"a*"};
+        std::cmatch m{};
+        test("not_null pt1", std::regex_search("baa", m, star, std::regex_constants::match_not_null));
+        test_eq("not_null pt2", m.position(), 1);
+        test_eq("not_null pt3", m.length(), 2);
+
+        std::regex a{"a"};
+        test("continuous", std::regex_search("ba", a, std::regex_constants::match_continuous) == false);
+
+        std::string str{"ab"};
+        std::regex wb{"\\bb"};
+        test("prev_avail pt1", std::regex_search(str.begin() + 1, str.end(), wb));
+        test("prev_avail pt2", std::regex_search(str.begin() + 1, str.end(), wb,
+                                                 std::regex_constants::match_prev_avail) == false);
+    }
+
+    void regex_test::test_iterators()
+    {
+        std::string str{"one two  three"};
+        std::regex word{"\\w+"};
+
+        std::vector<std::string> words{};
+        for (std::sregex_iterator it{str.begin(), str.end(), word}, end{}; it != end; ++it)
+            words.push_back(it->str());
+
+        std::vector<std::string> check1{"one", "two", "three"};
+        test_eq("regex_iterator", words.begin(), words.end(), check1.begin(), check1.end());
+
+        std::regex empty{"x*"};
+        size_t count{};
+        std::string abc{"abc"};
+        for (std::sregex_iterator it{abc.begin(), abc.end(), empty}, end{}; it != end; ++it)
+            ++count;
+        test_eq("regex_iterator empty matches", count, 4U);
+
+        std::string csv{"a,b,,c"};
+        std::regex comma{","};
+        std::vector<std::string> fields{};
+        for (std::sregex_token_iterator it{csv.begin(), csv.end(), comma, -1}, end{}; it != end; ++it)
+            fields.push_back(it->str());
+
+        std::vector<std::string> check2{"a", "b", "", "c"};
+        test_eq("token_iterator split", fields.begin(), fields.end(), check2.begin(), check2.end());
+
+        std::string pairs{"1-2 33-44"};
+        std::regex pair{"(\\d+)-(\\d+)"};
+        std::vector<std::string> parts{};
+        for (std::sregex_token_iterator it{pairs.begin(), pairs.end(), pair, {2, 1}}, end{}; it != end; ++it)
+            parts.push_back(it->str());
+
+        std::vector<std::string> check3{"2", "1", "44", "33"};
+        test_eq("token_iterator submatches", parts.begin(), parts.end(), check3.begin(), check3.end());
+    }
+
+    void regex_test::test_replace()
+    {
+        std::regex date{"(\\d{4})-(\\d{2})-(\\d{2})"};
+        std::string str{"on 2026-10-18 and 2026-01-02"};
+
+        test_eq("replace pt1", std::regex_replace(str, date, "$3.$2.$1"),
+                std::string{"on 18.10.2026 and 02.01.2026"});
+        test_eq("replace pt2", std::regex_replace(str, date, "[$&]", std::regex_constants::format_first_only),
+                std::string{"on [2026-10-18] and 2026-01-02"});
+        test_eq("replace pt3", std::regex_replace(str, date, "$1;", std::regex_constants::format_no_copy),
+                std::string{"2026;2026;"});
+        test_eq("replace pt4", std::regex_replace(std::string{"a.b"}, std::regex{"\\."}, "$$"),
+                std::string{"a$b"});
+        test_eq("replace sed", std::regex_replace(str, date, "<&:\\1>", std::regex_constants::format_sed),
+                std::string{"on <2026-10-18:2026> and <2026-01-02:2026>"});
+        test_eq("replace empty matches", std::regex_replace(std::string{"abc"}, std::regex{"x*"}, "-"),
+                std::string{"-a-b-c-"});
+
+        std::smatch m{};
+        std::string abc{"xabcx"};
+        std::regex_search(abc, m, std::regex{"b"});
+        test_eq("format", m.format("$`|$&|$'"), std::string{"xa|b|cx"});
+    }
+
+    void regex_test::test_errors()
+    {
+        /**
+         * Compile through the engine to check the error codes
+         * without going through throw.
+         */
+        auto error = [](const char* pattern, std::regex_constants::syntax_option_type flags) {
+            std::regex_constants::error_type err{};
+            auto engine = std::aux::regex_engine::compile(
+                pattern, std::char_traits<char>::length(pattern), flags, err
+            );
+
+            if (engine)
+            {
+                delete engine;
+
+                return std::regex_constants::error_type{};
+            }
+            else
+                return err;
+        };
+
+        auto ecma = std::regex_constants::ECMAScript;
+        test_eq("error_paren pt1", error("(a", ecma), std::regex_constants::error_paren);
+        test_eq("error_paren pt2", error("a)", ecma), std::regex_constants::error_paren);
+        test_eq("error_brack", error("[a", ecma), std::regex_constants::error_brack);
+        test_eq("error_brace", error("a{2", ecma), std::regex_constants::error_brace);
+        test_eq("error_badbrace", error("a{3,2}", ecma), std::regex_constants::error_badbrace);
+        test_eq("error_badrepeat", error("*a", ecma), std::regex_constants::error_badrepeat);
+        test_eq("error_range", error("[b-a]", ecma), std::regex_constants::error_range);
+        test_eq("error_escape", error("\\", ecma), std::regex_constants::error_escape);
+        test_eq("error_ctype", error("[[:foo:]]", std::regex_constants::extended),
+                std::regex_constants::error_ctype);
+        test_eq("error_backref", error("(a)\\1", ecma), std::regex_constants::error_backref);
+        test_eq("error_complexity", error("a(?=b)", ecma), std::regex_constants::error_complexity);
+        test_eq("valid pattern", error("(a|b)*c", ecma), std::regex_constants::error_type{});
+    }
+
+    void regex_test::test_complexity()
+    {
+        /**
+         * These take exponential time with a backtracking
+         * engine, the automaton handles them in linear time.
+         */
+        std::string as(10000, 'a');
+        test("no blowup pt1", std::regex_search(as, std::regex{"(a|aa)*b"}) == false);
+
+        std::string xs(10000, 'x');
+        std::smatch m{};
+        test("no blowup pt2", std::regex_match(xs, m, std::regex{"(x+x+)+y"}) == false);
+        test("no blowup pt3", std::regex_search(xs, m, std::regex{"(x+x+)+y"}) == false);
+        test("no blowup pt4", std::regex_match(xs, m, std::regex{"(x+x+)+"}));
+        test_eq("no blowup pt5", m.length(), 10000);
+
+        std::string nested = as + "b";
+        test("nested repeats", std::regex_search(nested, std::regex{"((a*)*|b)*b$"}));
+    }
+}
@@ -45,6 +45,7 @@ namespace std::test
         test_multi();
         test_reverse_iterators();
         test_multi_bounds_and_ranges();
+        test_node_handles();
 
         return end();
     }
@@ -189,7 +190,7 @@ namespace std::test
         test_eq("lower_bound of present key", *res1, 5);
 
         auto res2 = set.lower_bound(13);
-        test_eq("lower_bound of absent key", *res2, 9);
+        test_eq("lower_bound of absent key", *res2, 15);
 
         auto res3 = set.upper_bound(7);
         test_eq("upper_bound of present key", *res3, 8);
@@ -202,7 +203,7 @@ namespace std::test
         test_eq("equal_range of present key pt2", *res5.second, 5);
 
         auto res6 = set.equal_range(14);
-        test_eq("equal_range of absent key pt1", *res6.first, 9);
+        test_eq("equal_range of absent key pt1", *res6.first, 15);
         test_eq("equal_range of absent key pt2", *res6.second, 15);
     }
 
@@ -298,4 +299,46 @@ namespace std::test
             res3.first, res3.second
         );
     }
+
+    void set_test::test_node_handles()
+    {
+        std::set<int> set{1, 2, 3, 4, 5};
+
+        auto node1 = set.extract(3);
+        test("extract pt1", !node1.empty());
+        test_eq("extract pt2", node1.value(), 3);
+        test_eq("extract pt3", set.size(), 4U);
+
+        node1.value() = 6;
+        auto res1 = set.insert(std::move(node1));
+        test("insert node pt1", res1.inserted);
+        test("insert node pt2", node1.empty());
+        test_eq("insert node pt3", *res1.position, 6);
+
+        auto node2 = set.extract(set.begin());
+        node2.value() = 2;
+        auto res2 = set.insert(std::move(node2));
+        test("insert duplicit node pt1", !res2.inserted);
+        test("insert duplicit node pt2", !res2.node.empty());
+
+        auto check1 = {1, 2, 4, 5, 6, 7};
+        std::set<int> src{1, 2, 7};
+        set.merge(src);
+        test_eq(
+            "merge",
+            check1.begin(), check1.end(),
+            set.begin(), set.end()
+        );
+        test_eq("merge leftovers", src.size(), 1U);
+
+        auto check2 = {1, 2, 2, 2, 4, 5, 6, 7, 8};
+        std::multiset<int> mset{2, 2, 8};
+        mset.merge(set);
+        test_eq(
+            "multi merge",
+            check2.begin(), check2.end(),
+            mset.begin(), mset.end()
+        );
+        test_eq("multi merge leftovers", set.size(), 0U);
+    }
 }
@@ -30,6 +30,7 @@
 #include <__bits/test/tests.hpp>
 #include <string>
 #include <cstdio>
+#include <cstring>
 
 namespace std::test
 {
@@ -108,6 +109,60 @@ namespace std::test
             str5.begin(), str5.end(),
             str3.begin() + 2, str3.begin() + 4
         );
+
+        /**
+         * Short strings live inside of the object,
+         * make sure their data moves with them.
+         */
+        const char* check2 = "a string that does not fit inline";
+
+        std::string str6{"hello"};
+        std::string str7{check2};
+        str6.swap(str7);
+        test_eq(
+            "swap short and long pt1",
+            str6.begin(), str6.end(),
+            check2, check2 + 33
+        );
+        test_eq(
+            "swap short and long pt2",
+            str7.begin(), str7.end(),
+            check1, check1 + 5
+        );
+
+        std::string str8{std::move(str7)};
+        test_eq(
+            "move constructor short string",
+            str8.begin(), str8.end(),
+            check1, check1 + 5
+        );
+        test_eq(
+            "move constructor short source empty",
+            str7.size(), 0ul
+        );
+
+        str8 = std::move(str6);
+        test_eq(
+            "move assignment long string",
+            str8.begin(), str8.end(),
+            check2, check2 + 33
+        );
+
+        std::string str9{};
+        for (size_t i = 0; i < 33; ++i)
+            str9.push_back(check2[i]);
+        test_eq(
+            "growing out of inline buffer",
+            str9.begin(), str9.end(),
+            check2, check2 + 33
+        );
+        test_eq(
+            "c_str after growing",
+            std::strcmp(str9.c_str(), check2), 0
+        );
+
+        str9.clear();
+        test_eq("c_str after clear", str9.c_str()[0], '\0');
     }
 
     void string_test::test_append()
@@ -29,6 +29,7 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <initializer_list>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -42,6 +43,7 @@ namespace std::test
         test_construction_and_assignment();
         test_insert();
         test_erase();
+        test_growth();
 
         return end();
     }
@@ -227,4 +229,36 @@ namespace std::test
             check3.begin(), check3.end()
         );
     }
+
+    void vector_test::test_growth()
+    {
+        // Long enough not to fit into the string itself.
+        std::string long1{"first string that needs a heap buffer"};
+        std::string long2{"second string that needs a heap buffer"};
+
+        std::vector<std::string> vec1{};
+        for (int i = 0; i < 20; ++i)
+        {
+            vec1.push_back(long1);
+            vec1.push_back(std::string{long2});
+            vec1.emplace_back(long1.c_str());
+        }
+        test_eq("push_back and emplace_back growth size", vec1.size(), 60ul);
+        test_eq("push_back copies", vec1[57], long1);
+        test_eq("push_back moves", vec1[58], long2);
+        test_eq("emplace_back constructs", vec1[59], long1);
+
+        vec1.reserve(200);
+        test_eq("reserve keeps elements", vec1[1], long2);
+
+        vec1.resize(70, long2);
+        test_eq("resize with value", vec1[69], long2);
+
+        vec1.resize(80);
+        test_eq("resize default constructs", vec1[79].empty(), true);
+
+        vec1.resize(3);
+        test_eq("resize shrinks", vec1.size(), 3ul);
+        test_eq("resize keeps elements", vec1[2], long1);
+    }
 }
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cerrno>
+#include <fstream>
+#include <vfs/file.h>
+
+namespace std::aux
+{
+    bool vfs_file::open(const char* name, ios_base::openmode mode)
+    {
+        if (is_open())
+            return false;
+
+        /**
+         * See table 132, binary makes no difference
+         * for us and ate is handled by the filebuf.
+         */
+        int flags{};
+
+        switch (mode & ~(ios_base::binary | ios_base::ate))
+        {
+            case ios_base::out:
+            case ios_base::out | ios_base::trunc:
+                flags = ::helenos::VFS_FILE_WRITE | ::helenos::VFS_FILE_CREATE |
+                        ::helenos::VFS_FILE_TRUNCATE;
+                break;
+            case ios_base::out | ios_base::app:
+            case ios_base::app:
+                flags = ::helenos::VFS_FILE_WRITE | ::helenos::VFS_FILE_APPEND |
+                        ::helenos::VFS_FILE_CREATE;
+                break;
+            case ios_base::in:
+                flags = ::helenos::VFS_FILE_READ;
+                break;
+            case ios_base::in | ios_base::out:
+                flags = ::helenos::VFS_FILE_READ | ::helenos::VFS_FILE_WRITE;
+                break;
+            case ios_base::in | ios_base::out | ios_base::trunc:
+                flags = ::helenos::VFS_FILE_READ | ::helenos::VFS_FILE_WRITE |
+                        ::helenos::VFS_FILE_CREATE | ::helenos::VFS_FILE_TRUNCATE;
+                break;
+            case ios_base::in | ios_base::out | ios_base::app:
+            case ios_base::in | ios_base::app:
+                flags = ::helenos::VFS_FILE_READ | ::helenos::VFS_FILE_WRITE |
+                        ::helenos::VFS_FILE_APPEND | ::helenos::VFS_FILE_CREATE;
+                break;
+            default:
+                return false;
+        }
+
+        int fd{};
+        if (::helenos::vfs_file_open(name, flags, &fd) != EOK)
+            return false;
+
+        fd_ = fd;
+        pos_ = 0;
+
+        return true;
+    }
+
+    bool vfs_file::close()
+    {
+        if (!is_open())
+            return false;
+
+        auto rc = ::helenos::vfs_file_close(fd_);
+        fd_ = -1;
+
+        return rc == EOK;
+    }
+
+    size_t vfs_file::read(void* buf, size_t size)
+    {
+        if (!is_open())
+            return 0;
+
+        ::helenos::aoff64_t pos = pos_;
+        size_t nread{};
+
+        /**
+         * Note: On error nread holds the number of bytes
+         *       read before it happened, we keep those.
+         */
+        ::helenos::vfs_file_read(fd_, &pos, buf, size, &nread);
+        pos_ += nread;
+
+        return nread;
+    }
+
+    bool vfs_file::write(const void* buf, size_t size)
+    {
+        if (!is_open())
+            return false;
+
+        ::helenos::aoff64_t pos = pos_;
+        size_t nwritten{};
+
+        auto rc = ::helenos::vfs_file_write(fd_, &pos, buf, size, &nwritten);
+        pos_ = pos;
+
+        return rc == EOK && nwritten == size;
+    }
+
+    bool vfs_file::seek(streamoff off, ios_base::seekdir dir, streamoff& pos)
+    {
+        if (!is_open())
+            return false;
+
+        streamoff base{};
+        if (dir == ios_base::cur)
+            base = static_cast<streamoff>(pos_);
+        else if (dir == ios_base::end)
+        {
+            ::helenos::aoff64_t size{};
+            if (::helenos::vfs_file_size(fd_, &size) != EOK)
+                return false;
+
+            base = static_cast<streamoff>(size);
+        }
+
+        if (base + off < 0)
+            return false;
+
+        pos_ = static_cast<uint64_t>(base + off);
+        pos = static_cast<streamoff>(pos_);
+
+        return true;
+    }
+}
@@ -0,0 +1,531 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/atomic.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <malloc.h>
+#include <memory_resource>
+
+namespace std::aux
+{
+    namespace
+    {
+        size_t align_up(size_t size, size_t alignment)
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        class new_delete_memory_resource: public pmr::memory_resource
+        {
+            private:
+                void* do_allocate(size_t bytes, size_t alignment) override
+                {
+                    if (alignment <= alignof(max_align_t))
+                        return ::operator new(bytes);
+
+                    auto ptr = ::helenos::memalign(alignment, bytes);
+                    if (!ptr)
+                        throw bad_alloc{};
+
+                    return ptr;
+                }
+
+                void do_deallocate(void* ptr, size_t, size_t alignment) override
+                {
+                    if (alignment <= alignof(max_align_t))
+                        ::operator delete(ptr);
+                    else
+                        std::free(ptr);
+                }
+
+                bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+        };
+
+        class null_memory_resource: public pmr::memory_resource
+        {
+            private:
+                void* do_allocate(size_t, size_t) override
+                {
+                    throw bad_alloc{};
+
+                    return nullptr;
+                }
+
+                void do_deallocate(void*, size_t, size_t) override
+                { /* DUMMY BODY */ }
+
+                bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+        };
+
+        /**
+         * Note: These are constant initialized, so they can
+         *       be used during initialization of other globals.
+         */
+        new_delete_memory_resource new_delete_res{};
+        null_memory_resource null_res{};
+        atomic<pmr::memory_resource*> default_res{&new_delete_res};
+
+        constexpr size_t min_block_size{8};
+        constexpr size_t default_largest_block{4096};
+        constexpr size_t max_largest_block{size_t{1} << 20};
+        constexpr size_t default_max_blocks{1024};
+        constexpr size_t max_max_blocks{size_t{1} << 16};
+
+        /**
+         * The first chunk of a pool is about this big,
+         * later chunks grow geometrically.
+         */
+        constexpr size_t first_chunk_size{1024};
+    }
+
+    struct pool_set::chunk
+    {
+        chunk* next;
+        size_t size;
+        size_t alignment;
+    };
+
+    struct pool_set::pool
+    {
+        size_t block_size;
+        size_t next_blocks;
+        void* free;
+        chunk* chunks;
+    };
+
+    struct pool_set::large_block
+    {
+        large_block* prev;
+        large_block* next;
+        void* base;
+        size_t size;
+        size_t alignment;
+    };
+
+    pool_set::pool_set(const pmr::pool_options& opts, pmr::memory_resource* upstream)
+        : upstream_{upstream}, options_{opts}, pools_{}, pool_count_{}, large_{}
+    {
+        auto& largest = options_.largest_required_pool_block;
+        if (largest == 0)
+            largest = default_largest_block;
+        else if (largest > max_largest_block)
+            largest = max_largest_block;
+
+        auto& max_blocks = options_.max_blocks_per_chunk;
+        if (max_blocks == 0)
+            max_blocks = default_max_blocks;
+        else if (max_blocks > max_max_blocks)
+            max_blocks = max_max_blocks;
+
+        size_t block_size{min_block_size};
+        pool_count_ = 1;
+        while (block_size < largest)
+        {
+            block_size *= 2;
+            ++pool_count_;
+        }
+        largest = block_size;
+
+        pools_ = static_cast<pool*>(
+            upstream_->allocate(pool_count_ * sizeof(pool), alignof(pool))
+        );
+
+        block_size = min_block_size;
+        for (size_t i = 0; i < pool_count_; ++i, block_size *= 2)
+        {
+            auto blocks = first_chunk_size / block_size;
+            if (blocks == 0)
+                blocks = 1;
+            else if (blocks > max_blocks)
+                blocks = max_blocks;
+
+            new(&pools_[i]) pool{block_size, blocks, nullptr, nullptr};
+        }
+    }
+
+    pool_set::~pool_set()
+    {
+        release();
+        upstream_->deallocate(pools_, pool_count_ * sizeof(pool), alignof(pool));
+    }
+
+    void* pool_set::allocate(size_t bytes, size_t alignment)
+    {
+        if (auto p = find_pool_(bytes, alignment); p)
+        {
+            if (!p->free)
+            {
+                /**
+                 * Blocks come first so that the chunk is aligned
+                 * to the block size, the header is at the end.
+                 */
+                auto blocks = p->next_blocks;
+                auto size = blocks * p->block_size + sizeof(chunk);
+                auto base = static_cast<char*>(upstream_->allocate(size, p->block_size));
+
+                auto header = reinterpret_cast<chunk*>(base + blocks * p->block_size);
+                header->next = p->chunks;
+                header->size = size;
+                header->alignment = p->block_size;
+                p->chunks = header;
+
+                for (size_t i = blocks; i > 0; --i)
+                {
+                    auto block = base + (i - 1) * p->block_size;
+                    *reinterpret_cast<void**>(block) = p->free;
+                    p->free = block;
+                }
+
+                if (p->next_blocks < options_.max_blocks_per_chunk / 2)
+                    p->next_blocks *= 2;
+                else
+                    p->next_blocks = options_.max_blocks_per_chunk;
+            }
+
+            auto res = p->free;
+            p->free = *static_cast<void**>(res);
+
+            return res;
+        }
+
+        /**
+         * Large blocks are kept in a list so that release
+         * can give them back, the list node is placed right
+         * in front of the returned memory.
+         */
+        if (alignment < alignof(large_block))
+            alignment = alignof(large_block);
+        auto header_size = align_up(sizeof(large_block), alignment);
+        auto size = header_size + bytes;
+
+        auto base = static_cast<char*>(upstream_->allocate(size, alignment));
+        auto res = base + header_size;
+
+        auto block = reinterpret_cast<large_block*>(res) - 1;
+        block->prev = nullptr;
+        block->next = large_;
+        block->base = base;
+        block->size = size;
+        block->alignment = alignment;
+        if (large_)
+            large_->prev = block;
+        large_ = block;
+
+        return res;
+    }
+
+    void pool_set::deallocate(void* ptr, size_t bytes, size_t alignment)
+    {
+        if (!ptr)
+            return;
+
+        if (auto p = find_pool_(bytes, alignment); p)
+        {
+            *static_cast<void**>(ptr) = p->free;
+            p->free = ptr;
+
+            return;
+        }
+
+        auto block = static_cast<large_block*>(ptr) - 1;
+        if (block->prev)
+            block->prev->next = block->next;
+        else
+            large_ = block->next;
+        if (block->next)
+            block->next->prev = block->prev;
+
+        upstream_->deallocate(block->base, block->size, block->alignment);
+    }
+
+    void pool_set::release()
+    {
+        for (size_t i = 0; i < pool_count_; ++i)
+        {
+            auto& p = pools_[i];
+            while (p.chunks)
+            {
+                auto next = p.chunks->next;
+                auto base = reinterpret_cast<char*>(p.chunks + 1) - p.chunks->size;
+                upstream_->deallocate(base, p.chunks->size, p.chunks->alignment);
+                p.chunks = next;
+            }
+
+            p.free = nullptr;
+        }
+
+        while (large_)
+        {
+            auto next = large_->next;
+            upstream_->deallocate(large_->base, large_->size, large_->alignment);
+            large_ = next;
+        }
+    }
+
+    pool_set::pool* pool_set::find_pool_(size_t bytes, size_t alignment)
+    {
+        auto size = bytes > alignment ? bytes : alignment;
+        if (size > options_.largest_required_pool_block)
+            return nullptr;
+
+        size_t idx{};
+        size_t block_size{min_block_size};
+        while (block_size < size)
+        {
+            block_size *= 2;
+            ++idx;
+        }
+
+        return &pools_[idx];
+    }
+}
+
+namespace std::pmr
+{
+    memory_resource::~memory_resource()
+    { /* DUMMY BODY */ }
+
+    memory_resource* new_delete_resource() noexcept
+    {
+        return &aux::new_delete_res;
+    }
+
+    memory_resource* null_memory_resource() noexcept
+    {
+        return &aux::null_res;
+    }
+
+    memory_resource* set_default_resource(memory_resource* res) noexcept
+    {
+        if (!res)
+            res = new_delete_resource();
+
+        return aux::default_res.exchange(res);
+    }
+
+    memory_resource* get_default_resource() noexcept
+    {
+        return aux::default_res.load();
+    }
+
+    unsynchronized_pool_resource::~unsynchronized_pool_resource()
+    { /* DUMMY BODY */ }
+
+    void* unsynchronized_pool_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        return pools_.allocate(bytes, alignment);
+    }
+
+    void unsynchronized_pool_resource::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+    {
+        pools_.deallocate(ptr, bytes, alignment);
+    }
+
+    bool unsynchronized_pool_resource::do_is_equal(const memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    synchronized_pool_resource::~synchronized_pool_resource()
+    { /* DUMMY BODY */ }
+
+    void synchronized_pool_resource::release()
+    {
+        aux::threading::mutex::lock(mtx_);
+        pools_.release();
+        aux::threading::mutex::unlock(mtx_);
+    }
+
+    void* synchronized_pool_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        aux::threading::mutex::lock(mtx_);
+
+        void* res{};
+        try
+        {
+            res = pools_.allocate(bytes, alignment);
+        }
+        catch (...)
+        {
+            aux::threading::mutex::unlock(mtx_);
+            throw;
+        }
+
+        aux::threading::mutex::unlock(mtx_);
+
+        return res;
+    }
+
+    void synchronized_pool_resource::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+    {
+        aux::threading::mutex::lock(mtx_);
+        pools_.deallocate(ptr, bytes, alignment);
+        aux::threading::mutex::unlock(mtx_);
+    }
+
+    bool synchronized_pool_resource::do_is_equal(const memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    /**
+     * Each buffer obtained from upstream ends with
+     * this header, which links the buffers for release.
+     */
+    struct monotonic_buffer_resource::chunk
+    {
+        chunk* next;
+        size_t size;
+        size_t alignment;
+    };
+
+    namespace
+    {
+        constexpr size_t default_monotonic_size{1024};
+
+        size_t grow_monotonic_size(size_t size)
+        {
+            if (size > numeric_limits<size_t>::max() / 2)
+                return size;
+            else
+                return size * 2;
+        }
+    }
+
+    monotonic_buffer_resource::monotonic_buffer_resource(memory_resource* upstream)
+        : monotonic_buffer_resource{default_monotonic_size, upstream}
+    { /* DUMMY BODY */ }
+
+    monotonic_buffer_resource::monotonic_buffer_resource(size_t initial_size,
+                                                         memory_resource* upstream)
+        : upstream_{upstream}, initial_buffer_{}, initial_size_{initial_size},
+          current_{}, space_{}, next_size_{}, chunks_{}
+    {
+        if (initial_size_ == 0)
+            initial_size_ = default_monotonic_size;
+        next_size_ = initial_size_;
+    }
+
+    monotonic_buffer_resource::monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                                                         memory_resource* upstream)
+        : upstream_{upstream}, initial_buffer_{buffer}, initial_size_{buffer_size},
+          current_{static_cast<char*>(buffer)}, space_{buffer_size},
+          next_size_{grow_monotonic_size(buffer_size > 0 ? buffer_size : default_monotonic_size)},
+          chunks_{}
+    { /* DUMMY BODY */ }
+
+    monotonic_buffer_resource::~monotonic_buffer_resource()
+    {
+        release();
+    }
+
+    void monotonic_buffer_resource::release()
+    {
+        while (chunks_)
+        {
+            auto next = chunks_->next;
+            auto base = reinterpret_cast<char*>(chunks_ + 1) - chunks_->size;
+            upstream_->deallocate(base, chunks_->size, chunks_->alignment);
+            chunks_ = next;
+        }
+
+        if (initial_buffer_)
+        {
+            current_ = static_cast<char*>(initial_buffer_);
+            space_ = initial_size_;
+            next_size_ = grow_monotonic_size(initial_size_ > 0 ? initial_size_ : default_monotonic_size);
+        }
+        else
+        {
+            current_ = nullptr;
+            space_ = 0;
+            next_size_ = initial_size_;
+        }
+    }
+
+    void* monotonic_buffer_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        if (bytes == 0)
+            bytes = 1;
+
+        if (current_)
+        {
+            auto addr = reinterpret_cast<uintptr_t>(current_);
+            auto pad = aux::align_up(addr, alignment) - addr;
+
+            if (pad <= space_ && bytes <= space_ - pad)
+            {
+                auto res = current_ + pad;
+                current_ = res + bytes;
+                space_ -= pad + bytes;
+
+                return res;
+            }
+        }
+
+        /**
+         * The new buffer is aligned for this request,
+         * so it is served from the start of the buffer.
+         */
+        if (alignment < alignof(chunk))
+            alignment = alignof(chunk);
+        auto size = aux::align_up(bytes, alignof(chunk)) + sizeof(chunk);
+        if (size < next_size_)
+            size = aux::align_up(next_size_, alignof(chunk));
+
+        auto base = static_cast<char*>(upstream_->allocate(size, alignment));
+
+        auto header = reinterpret_cast<chunk*>(base + size) - 1;
+        header->next = chunks_;
+        header->size = size;
+        header->alignment = alignment;
+        chunks_ = header;
+
+        current_ = base + bytes;
+        space_ = size - sizeof(chunk) - bytes;
+        next_size_ = grow_monotonic_size(size);
+
+        return base;
+    }
+
+    void monotonic_buffer_resource::do_deallocate(void*, size_t, size_t)
+    { /* DUMMY BODY */ }
+
+    bool monotonic_buffer_resource::do_is_equal(const memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+}
@@ -89,7 +89,10 @@ namespace std
         if (owner_ != this_thread::get_id())
             return;
         else if (--lock_level_ == 0)
+        {
+            owner_ = thread::id{};
             aux::threading::mutex::unlock(mtx_);
+        }
     }
 
     recursive_mutex::native_handle_type recursive_mutex::native_handle()
@@ -165,7 +168,10 @@ namespace std
         if (owner_ != this_thread::get_id())
             return;
         else if (--lock_level_ == 0)
+        {
+            owner_ = thread::id{};
             aux::threading::mutex::unlock(mtx_);
+        }
     }
 
     recursive_timed_mutex::native_handle_type recursive_timed_mutex::native_handle()
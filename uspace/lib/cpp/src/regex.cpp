@@ -0,0 +1,2364 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cctype>
+#include <cstdint>
+#include <regex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace std
+{
+    namespace
+    {
+        const char* regex_error_message(regex_constants::error_type code)
+        {
+            switch (code)
+            {
+                case regex_constants::error_collate:
+                    return "regex_error: invalid collating element name";
+                case regex_constants::error_ctype:
+                    return "regex_error: invalid character class name";
+                case regex_constants::error_escape:
+                    return "regex_error: invalid escaped character or trailing escape";
+                case regex_constants::error_backref:
+                    return "regex_error: back references are not supported";
+                case regex_constants::error_brack:
+                    return "regex_error: mismatched [ and ]";
+                case regex_constants::error_paren:
+                    return "regex_error: mismatched ( and )";
+                case regex_constants::error_brace:
+                    return "regex_error: mismatched { and }";
+                case regex_constants::error_badbrace:
+                    return "regex_error: invalid range in a {} expression";
+                case regex_constants::error_range:
+                    return "regex_error: invalid character range";
+                case regex_constants::error_space:
+                    return "regex_error: regular expression too large";
+                case regex_constants::error_badrepeat:
+                    return "regex_error: repeat not preceded by a valid expression";
+                case regex_constants::error_complexity:
+                    return "regex_error: unsupported regular expression feature";
+                case regex_constants::error_stack:
+                    return "regex_error: regular expression nested too deeply";
+                default:
+                    return "regex_error: unknown error";
+            }
+        }
+    }
+
+    regex_error::regex_error(regex_constants::error_type ecode)
+        : runtime_error{regex_error_message(ecode)}, code_{ecode}
+    { /* DUMMY BODY */ }
+
+    regex_constants::error_type regex_error::code() const
+    {
+        return code_;
+    }
+}
+
+namespace std::aux
+{
+    struct regex_byte_set
+    {
+        uint64_t bits[4]{};
+
+        void add(unsigned char c)
+        {
+            bits[c >> 6] |= uint64_t{1} << (c & 63);
+        }
+
+        void add_range(unsigned char lo, unsigned char hi)
+        {
+            for (unsigned int c = lo; c <= hi; ++c)
+                add(static_cast<unsigned char>(c));
+        }
+
+        bool has(unsigned char c) const
+        {
+            return (bits[c >> 6] >> (c & 63)) & 1;
+        }
+
+        void merge(const regex_byte_set& other)
+        {
+            for (size_t i = 0; i < 4; ++i)
+                bits[i] |= other.bits[i];
+        }
+
+        void invert()
+        {
+            for (size_t i = 0; i < 4; ++i)
+                bits[i] = ~bits[i];
+        }
+
+        void fold_case()
+        {
+            for (unsigned char c = 'a'; c <= 'z'; ++c)
+            {
+                unsigned char u = c - 'a' + 'A';
+                if (has(c) || has(u))
+                {
+                    add(c);
+                    add(u);
+                }
+            }
+        }
+    };
+
+    namespace
+    {
+        namespace rc = regex_constants;
+
+        using byte_set = regex_byte_set;
+
+        /**
+         * Limits that keep compilation and the
+         * DFA construction bounded.
+         */
+        constexpr size_t max_instructions{1U << 16};
+        constexpr size_t max_repeat{1000};
+        constexpr size_t max_depth{512};
+
+        byte_set make_ctype_set(int (*pred)(int))
+        {
+            byte_set res{};
+            for (int c = 0; c < 128; ++c)
+            {
+                if (pred(c))
+                    res.add(static_cast<unsigned char>(c));
+            }
+
+            return res;
+        }
+
+        int is_word(int c)
+        {
+            return isalnum(c) || c == '_';
+        }
+
+        /**
+         * Note: Only the classes of the "C" locale are
+         *       supported, in which the ctype functions
+         *       do not classify bytes above 127.
+         */
+        bool lookup_class(const char* first, const char* last, byte_set& res)
+        {
+            static constexpr struct
+            {
+                const char* name;
+                int (*pred)(int);
+            } classes[] = {
+                {"alnum", isalnum}, {"alpha", isalpha}, {"blank", isblank},
+                {"cntrl", iscntrl}, {"digit", isdigit}, {"graph", isgraph},
+                {"lower", islower}, {"print", isprint}, {"punct", ispunct},
+                {"space", isspace}, {"upper", isupper}, {"xdigit", isxdigit},
+                {"d", isdigit}, {"s", isspace}, {"w", is_word}
+            };
+
+            auto len = static_cast<size_t>(last - first);
+            for (const auto& cls: classes)
+            {
+                size_t i{};
+                while (i < len && cls.name[i] == first[i])
+                    ++i;
+
+                if (i == len && cls.name[i] == '\0')
+                {
+                    res = make_ctype_set(cls.pred);
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        enum class grammar
+        {
+            ecma, basic, extended, awk
+        };
+
+        enum assertion_kind: uint32_t
+        {
+            assert_bol, assert_eol, assert_word_boundary, assert_not_word_boundary
+        };
+
+        enum class node_kind: uint8_t
+        {
+            empty, set, concat, alternation, repeat, group, assertion
+        };
+
+        constexpr uint32_t no_node{static_cast<uint32_t>(-1)};
+        constexpr uint32_t infinity{static_cast<uint32_t>(-1)};
+
+        /**
+         * Node of the syntax tree, the children of concatenations
+         * and alternations are kept in vectors so that the depth
+         * of the tree (and thus the recursion of the compiler)
+         * only depends on the nesting of groups and repeats.
+         */
+        struct node
+        {
+            node_kind kind;
+
+            /**
+             * Set index, group index or assertion kind.
+             */
+            uint32_t arg;
+
+            uint32_t min;
+            uint32_t max;
+            bool greedy;
+
+            vector<uint32_t> children;
+        };
+    }
+
+    enum class regex_op: uint8_t
+    {
+        set, split, jump, save, reset, assertion, match
+    };
+
+    /**
+     * Instructions of the NFA, set consumes a byte
+     * from sets[x], split continues at both x and y
+     * (x having priority), jump continues at x, save
+     * records the current position in the group slot x,
+     * reset clears the group slots [x, y) and assertion
+     * checks the zero width assertion x.
+     */
+    struct regex_instruction
+    {
+        regex_op op;
+        uint32_t x;
+        uint32_t y;
+    };
+
+    struct regex_program
+    {
+        vector<regex_instruction> code{};
+        vector<byte_set> sets{};
+        size_t marks{};
+
+        /**
+         * POSIX grammars select the leftmost longest
+         * match, ECMAScript the leftmost match preferred
+         * by the order of alternatives and repeats.
+         */
+        bool longest{};
+        bool multiline{};
+
+        byte_set word{};
+        byte_set line_end{};
+
+        /**
+         * Bytes that no set in the program distinguishes
+         * share a class, the DFA has one transition per class.
+         */
+        uint8_t classes[256]{};
+        size_t class_count{};
+
+        /**
+         * Bytes a match can start with, valid only if
+         * every match consumes at least one byte and no
+         * assertion is tested before the first one.
+         */
+        byte_set first{};
+        bool has_first{};
+    };
+
+    namespace
+    {
+        class regex_parser
+        {
+            public:
+                regex_parser(const char* first, const char* last,
+                             rc::syntax_option_type flags)
+                    : cur_{first}, last_{last}, grammar_{grammar::ecma},
+                      icase_{(flags & rc::icase) != 0},
+                      nosubs_{(flags & rc::nosubs) != 0},
+                      newline_alt_{false}, failed_{false},
+                      err_{}, groups_{}, depth_{}, nodes_{}, sets_{}
+                {
+                    if (flags & rc::ECMAScript)
+                        grammar_ = grammar::ecma;
+                    else if (flags & rc::basic)
+                        grammar_ = grammar::basic;
+                    else if (flags & rc::extended)
+                        grammar_ = grammar::extended;
+                    else if (flags & rc::awk)
+                        grammar_ = grammar::awk;
+                    else if (flags & rc::grep)
+                    {
+                        grammar_ = grammar::basic;
+                        newline_alt_ = true;
+                    }
+                    else if (flags & rc::egrep)
+                    {
+                        grammar_ = grammar::extended;
+                        newline_alt_ = true;
+                    }
+                }
+
+                uint32_t parse()
+                {
+                    auto root = parse_disjunction_();
+                    if (!failed_ && cur_ != last_)
+                        fail_(rc::error_paren);
+
+                    return failed_ ? no_node : root;
+                }
+
+                rc::error_type error() const
+                {
+                    return err_;
+                }
+
+                size_t groups() const
+                {
+                    return groups_;
+                }
+
+                bool posix() const
+                {
+                    return grammar_ != grammar::ecma;
+                }
+
+                vector<node>& nodes()
+                {
+                    return nodes_;
+                }
+
+                vector<byte_set>& sets()
+                {
+                    return sets_;
+                }
+
+            private:
+                const char* cur_;
+                const char* last_;
+                grammar grammar_;
+                bool icase_;
+                bool nosubs_;
+
+                /**
+                 * Newlines separate alternatives in grep and egrep.
+                 */
+                bool newline_alt_;
+
+                bool failed_;
+                rc::error_type err_;
+                size_t groups_;
+                size_t depth_;
+
+                vector<node> nodes_;
+                vector<byte_set> sets_;
+
+                uint32_t fail_(rc::error_type err)
+                {
+                    if (!failed_)
+                    {
+                        failed_ = true;
+                        err_ = err;
+                    }
+
+                    return no_node;
+                }
+
+                bool error_(rc::error_type err)
+                {
+                    fail_(err);
+
+                    return false;
+                }
+
+                uint32_t add_node_(node_kind kind, uint32_t arg = 0)
+                {
+                    nodes_.push_back(node{kind, arg, 0, 0, true, {}});
+
+                    return static_cast<uint32_t>(nodes_.size() - 1);
+                }
+
+                uint32_t add_set_(byte_set set, bool negate = false)
+                {
+                    if (icase_)
+                        set.fold_case();
+                    if (negate)
+                        set.invert();
+
+                    sets_.push_back(set);
+
+                    return add_node_(node_kind::set, static_cast<uint32_t>(sets_.size() - 1));
+                }
+
+                uint32_t add_char_(unsigned char c)
+                {
+                    byte_set set{};
+                    set.add(c);
+
+                    return add_set_(set);
+                }
+
+                uint32_t add_any_()
+                {
+                    byte_set set{};
+                    set.invert();
+
+                    /**
+                     * Note: In ECMAScript the dot does
+                     *       not match line terminators.
+                     */
+                    if (grammar_ == grammar::ecma)
+                    {
+                        set.bits[0] &= ~(uint64_t{1} << '\n');
+                        set.bits[0] &= ~(uint64_t{1} << '\r');
+                    }
+
+                    return add_set_(set);
+                }
+
+                bool at_(char c, size_t offset = 0) const
+                {
+                    return static_cast<size_t>(last_ - cur_) > offset && cur_[offset] == c;
+                }
+
+                bool at_alternative_end_() const
+                {
+                    if (cur_ == last_)
+                        return true;
+
+                    auto c = *cur_;
+                    if (newline_alt_ && c == '\n')
+                        return true;
+
+                    if (grammar_ == grammar::basic)
+                        return depth_ > 0 && c == '\\' && at_(')', 1);
+                    else
+                        return c == '|' || (c == ')' && depth_ > 0);
+                }
+
+                uint32_t parse_disjunction_()
+                {
+                    auto first = parse_alternative_();
+                    if (failed_)
+                        return no_node;
+
+                    uint32_t alt{no_node};
+                    while (cur_ != last_ && (*cur_ == '|' || (newline_alt_ && *cur_ == '\n')))
+                    {
+                        if (*cur_ == '|' && grammar_ == grammar::basic)
+                            break;
+                        ++cur_;
+
+                        if (alt == no_node)
+                        {
+                            alt = add_node_(node_kind::alternation);
+                            nodes_[alt].children.push_back(first);
+                        }
+
+                        auto next = parse_alternative_();
+                        if (failed_)
+                            return no_node;
+                        nodes_[alt].children.push_back(next);
+                    }
+
+                    return alt == no_node ? first : alt;
+                }
+
+                uint32_t parse_alternative_()
+                {
+                    vector<uint32_t> items{};
+                    while (!at_alternative_end_())
+                    {
+                        if (*cur_ == ')' && grammar_ != grammar::basic)
+                            return fail_(rc::error_paren);
+
+                        /**
+                         * In basic regular expressions a star at the start
+                         * (possibly after the ^ anchor) is an ordinary character.
+                         */
+                        bool at_start = items.empty() || (
+                            items.size() == 1 &&
+                            nodes_[items[0]].kind == node_kind::assertion &&
+                            nodes_[items[0]].arg == assert_bol
+                        );
+
+                        auto term = parse_term_(at_start);
+                        if (failed_)
+                            return no_node;
+                        items.push_back(term);
+                    }
+
+                    if (items.empty())
+                        return add_node_(node_kind::empty);
+                    else if (items.size() == 1)
+                        return items[0];
+
+                    auto res = add_node_(node_kind::concat);
+                    nodes_[res].children = move(items);
+
+                    return res;
+                }
+
+                uint32_t parse_term_(bool at_start)
+                {
+                    auto atom = (grammar_ == grammar::ecma) ? parse_atom_ecma_() : parse_atom_posix_(at_start);
+                    if (failed_)
+                        return no_node;
+
+                    while (cur_ != last_)
+                    {
+                        uint32_t min{}, max{};
+                        auto c = *cur_;
+
+                        if (c == '*')
+                        {
+                            ++cur_;
+                            min = 0;
+                            max = infinity;
+                        }
+                        else if (c == '+' && grammar_ != grammar::basic)
+                        {
+                            ++cur_;
+                            min = 1;
+                            max = infinity;
+                        }
+                        else if (c == '?' && grammar_ != grammar::basic)
+                        {
+                            ++cur_;
+                            min = 0;
+                            max = 1;
+                        }
+                        else if (c == '{' && grammar_ != grammar::basic)
+                        {
+                            ++cur_;
+                            if (!parse_interval_(min, max))
+                                return no_node;
+                        }
+                        else if (c == '\\' && at_('{', 1) && grammar_ == grammar::basic)
+                        {
+                            cur_ += 2;
+                            if (!parse_interval_(min, max))
+                                return no_node;
+                        }
+                        else
+                            break;
+
+                        if (nodes_[atom].kind == node_kind::assertion)
+                            return fail_(rc::error_badrepeat);
+
+                        bool greedy{true};
+                        if (grammar_ == grammar::ecma && at_('?'))
+                        {
+                            ++cur_;
+                            greedy = false;
+                        }
+
+                        auto rep = add_node_(node_kind::repeat);
+                        nodes_[rep].min = min;
+                        nodes_[rep].max = max;
+                        nodes_[rep].greedy = greedy;
+                        nodes_[rep].children.push_back(atom);
+                        atom = rep;
+
+                        /**
+                         * ECMAScript allows only one quantifier per atom,
+                         * the following one is reported as a bad repeat.
+                         */
+                        if (grammar_ == grammar::ecma)
+                            break;
+                    }
+
+                    return atom;
+                }
+
+                bool parse_number_(uint32_t& res)
+                {
+                    if (cur_ == last_ || !isdigit(static_cast<unsigned char>(*cur_)))
+                        return false;
+
+                    res = 0;
+                    while (cur_ != last_ && isdigit(static_cast<unsigned char>(*cur_)))
+                    {
+                        if (res <= max_repeat)
+                            res = res * 10 + static_cast<uint32_t>(*cur_ - '0');
+                        ++cur_;
+                    }
+
+                    return true;
+                }
+
+                bool parse_interval_(uint32_t& min, uint32_t& max)
+                {
+                    if (cur_ == last_)
+                        return error_(rc::error_brace);
+                    if (!parse_number_(min))
+                        return error_(rc::error_badbrace);
+
+                    max = min;
+                    if (at_(','))
+                    {
+                        ++cur_;
+                        if (!parse_number_(max))
+                            max = infinity;
+                    }
+
+                    if (cur_ == last_)
+                        return error_(rc::error_brace);
+
+                    if (grammar_ == grammar::basic)
+                    {
+                        if (!at_('\\') || !at_('}', 1))
+                            return error_(at_('\\') ? rc::error_brace : rc::error_badbrace);
+                        cur_ += 2;
+                    }
+                    else
+                    {
+                        if (!at_('}'))
+                            return error_(rc::error_badbrace);
+                        ++cur_;
+                    }
+
+                    if (min > max_repeat || (max != infinity && (max > max_repeat || min > max)))
+                        return error_(rc::error_badbrace);
+
+                    return true;
+                }
+
+                uint32_t parse_group_()
+                {
+                    if (depth_ >= max_depth)
+                        return fail_(rc::error_stack);
+
+                    bool capture{!nosubs_};
+                    if (grammar_ == grammar::ecma && at_('?'))
+                    {
+                        if (at_(':', 1))
+                        {
+                            cur_ += 2;
+                            capture = false;
+                        }
+                        else if (at_('=', 1) || at_('!', 1))
+                            return fail_(rc::error_complexity);
+                    }
+
+                    uint32_t idx{};
+                    if (capture)
+                        idx = static_cast<uint32_t>(++groups_);
+
+                    ++depth_;
+                    auto body = parse_disjunction_();
+                    --depth_;
+                    if (failed_)
+                        return no_node;
+
+                    if (grammar_ == grammar::basic)
+                    {
+                        if (!at_('\\') || !at_(')', 1))
+                            return fail_(rc::error_paren);
+                        cur_ += 2;
+                    }
+                    else
+                    {
+                        if (!at_(')'))
+                            return fail_(rc::error_paren);
+                        ++cur_;
+                    }
+
+                    /**
+                     * A group around an assertion can be repeated.
+                     */
+                    if (!capture && nodes_[body].kind == node_kind::assertion)
+                    {
+                        auto res = add_node_(node_kind::concat);
+                        nodes_[res].children.push_back(body);
+
+                        return res;
+                    }
+                    else if (!capture)
+                        return body;
+
+                    auto res = add_node_(node_kind::group, idx);
+                    nodes_[res].children.push_back(body);
+
+                    return res;
+                }
+
+                static int hex_value(char c)
+                {
+                    if (c >= '0' && c <= '9')
+                        return c - '0';
+                    else if (c >= 'a' && c <= 'f')
+                        return c - 'a' + 10;
+                    else if (c >= 'A' && c <= 'F')
+                        return c - 'A' + 10;
+                    else
+                        return -1;
+                }
+
+                bool parse_hex_(size_t digits, unsigned char& res)
+                {
+                    unsigned int val{};
+                    for (size_t i = 0; i < digits; ++i)
+                    {
+                        if (cur_ == last_ || hex_value(*cur_) < 0)
+                            return error_(rc::error_escape);
+                        val = val * 16 + static_cast<unsigned int>(hex_value(*cur_++));
+                    }
+
+                    /**
+                     * Note: Only narrow characters are supported.
+                     */
+                    if (val > 0xFF)
+                        return error_(rc::error_escape);
+                    res = static_cast<unsigned char>(val);
+
+                    return true;
+                }
+
+                /**
+                 * Character escapes of ECMAScript valid both
+                 * inside and outside of brackets, c is the
+                 * character after the backslash.
+                 */
+                bool parse_char_escape_ecma_(char c, unsigned char& res)
+                {
+                    switch (c)
+                    {
+                        case 'f':
+                            res = '\f';
+                            return true;
+                        case 'n':
+                            res = '\n';
+                            return true;
+                        case 'r':
+                            res = '\r';
+                            return true;
+                        case 't':
+                            res = '\t';
+                            return true;
+                        case 'v':
+                            res = '\v';
+                            return true;
+                        case 'c':
+                            if (cur_ == last_ || !isalpha(static_cast<unsigned char>(*cur_)))
+                                return error_(rc::error_escape);
+                            res = static_cast<unsigned char>(*cur_++ % 32);
+                            return true;
+                        case 'x':
+                            return parse_hex_(2, res);
+                        case 'u':
+                            return parse_hex_(4, res);
+                        case '0':
+                            if (cur_ != last_ && isdigit(static_cast<unsigned char>(*cur_)))
+                                return error_(rc::error_escape);
+                            res = '\0';
+                            return true;
+                        default:
+                            if (isdigit(static_cast<unsigned char>(c)))
+                                return error_(rc::error_backref);
+                            if (isalpha(static_cast<unsigned char>(c)))
+                                return error_(rc::error_escape);
+                            res = static_cast<unsigned char>(c);
+                            return true;
+                    }
+                }
+
+                /**
+                 * Escapes of awk, c is the character after the backslash.
+                 */
+                bool parse_char_escape_awk_(char c, unsigned char& res)
+                {
+                    switch (c)
+                    {
+                        case 'a':
+                            res = '\a';
+                            return true;
+                        case 'b':
+                            res = '\b';
+                            return true;
+                        case 'f':
+                            res = '\f';
+                            return true;
+                        case 'n':
+                            res = '\n';
+                            return true;
+                        case 'r':
+                            res = '\r';
+                            return true;
+                        case 't':
+                            res = '\t';
+                            return true;
+                        case 'v':
+                            res = '\v';
+                            return true;
+                        default:
+                            if (c >= '0' && c <= '7')
+                            {
+                                unsigned int val = static_cast<unsigned int>(c - '0');
+                                for (size_t i = 0; i < 2 && cur_ != last_ && *cur_ >= '0' && *cur_ <= '7'; ++i)
+                                    val = val * 8 + static_cast<unsigned int>(*cur_++ - '0');
+
+                                if (val > 0xFF)
+                                    return error_(rc::error_escape);
+                                res = static_cast<unsigned char>(val);
+
+                                return true;
+                            }
+
+                            res = static_cast<unsigned char>(c);
+                            return true;
+                    }
+                }
+
+                /**
+                 * Returns true and sets res for \d, \s, \w and their
+                 * negations.
+                 */
+                static bool class_escape(char c, byte_set& res)
+                {
+                    switch (c)
+                    {
+                        case 'd':
+                        case 'D':
+                            res = make_ctype_set(isdigit);
+                            break;
+                        case 's':
+                        case 'S':
+                            res = make_ctype_set(isspace);
+                            break;
+                        case 'w':
+                        case 'W':
+                            res = make_ctype_set(is_word);
+                            break;
+                        default:
+                            return false;
+                    }
+
+                    if (isupper(static_cast<unsigned char>(c)))
+                        res.invert();
+
+                    return true;
+                }
+
+                uint32_t parse_atom_ecma_()
+                {
+                    auto c = *cur_++;
+                    switch (c)
+                    {
+                        case '^':
+                            return add_node_(node_kind::assertion, assert_bol);
+                        case '$':
+                            return add_node_(node_kind::assertion, assert_eol);
+                        case '.':
+                            return add_any_();
+                        case '[':
+                            return parse_bracket_();
+                        case '(':
+                            return parse_group_();
+                        case '*':
+                        case '+':
+                        case '?':
+                        case '{':
+                            return fail_(rc::error_badrepeat);
+                        case '\\':
+                            break;
+                        default:
+                            return add_char_(static_cast<unsigned char>(c));
+                    }
+
+                    if (cur_ == last_)
+                        return fail_(rc::error_escape);
+
+                    c = *cur_++;
+                    if (c == 'b')
+                        return add_node_(node_kind::assertion, assert_word_boundary);
+                    else if (c == 'B')
+                        return add_node_(node_kind::assertion, assert_not_word_boundary);
+
+                    byte_set set{};
+                    if (class_escape(c, set))
+                    {
+                        /**
+                         * Note: The negated classes have to be negated
+                         *       after case folding, which does not change
+                         *       them anyway, so we can skip that.
+                         */
+                        sets_.push_back(set);
+
+                        return add_node_(node_kind::set, static_cast<uint32_t>(sets_.size() - 1));
+                    }
+
+                    unsigned char res{};
+                    if (!parse_char_escape_ecma_(c, res))
+                        return no_node;
+
+                    return add_char_(res);
+                }
+
+                bool at_bre_end_() const
+                {
+                    /**
+                     * The $ anchor is only special at the end
+                     * of a basic regular expression or subexpression.
+                     */
+                    return cur_ + 1 == last_ ||
+                           (cur_[1] == '\\' && at_(')', 2)) ||
+                           (newline_alt_ && cur_[1] == '\n');
+                }
+
+                uint32_t parse_atom_posix_(bool at_start)
+                {
+                    auto c = *cur_;
+                    if (grammar_ == grammar::basic)
+                    {
+                        if (c == '^' && at_start)
+                        {
+                            ++cur_;
+
+                            return add_node_(node_kind::assertion, assert_bol);
+                        }
+                        else if (c == '$' && at_bre_end_())
+                        {
+                            ++cur_;
+
+                            return add_node_(node_kind::assertion, assert_eol);
+                        }
+                        else if (c == '*' && at_start)
+                        {
+                            ++cur_;
+
+                            return add_char_('*');
+                        }
+                        else if (c == '^' || c == '$')
+                        {
+                            ++cur_;
+
+                            return add_char_(static_cast<unsigned char>(c));
+                        }
+                    }
+
+                    ++cur_;
+                    switch (c)
+                    {
+                        case '^':
+                            return add_node_(node_kind::assertion, assert_bol);
+                        case '$':
+                            return add_node_(node_kind::assertion, assert_eol);
+                        case '.':
+                            return add_any_();
+                        case '[':
+                            return parse_bracket_();
+                        case '\\':
+                            break;
+                        case '(':
+                            if (grammar_ != grammar::basic)
+                                return parse_group_();
+                            return add_char_('(');
+                        case '*':
+                        case '+':
+                        case '?':
+                        case '{':
+                            if (grammar_ != grammar::basic)
+                                return fail_(rc::error_badrepeat);
+                            return add_char_(static_cast<unsigned char>(c));
+                        default:
+                            return add_char_(static_cast<unsigned char>(c));
+                    }
+
+                    if (cur_ == last_)
+                        return fail_(rc::error_escape);
+
+                    c = *cur_++;
+                    if (grammar_ == grammar::basic)
+                    {
+                        if (c == '(')
+                            return parse_group_();
+                        else if (c == ')')
+                            return fail_(rc::error_paren);
+                        else if (c == '{')
+                            return fail_(rc::error_badrepeat);
+                    }
+
+                    if (grammar_ == grammar::awk)
+                    {
+                        unsigned char res{};
+                        if (!parse_char_escape_awk_(c, res))
+                            return no_node;
+
+                        return add_char_(res);
+                    }
+
+                    if (c >= '1' && c <= '9')
+                        return fail_(rc::error_backref);
+
+                    return add_char_(static_cast<unsigned char>(c));
+                }
+
+                /**
+                 * Parses a single character or a class inside
+                 * of brackets, is_set tells which one it was.
+                 */
+                bool parse_class_atom_(unsigned char& chr, byte_set& set, bool& is_set)
+                {
+                    auto c = *cur_;
+                    if (c == '[' && (at_(':', 1) || at_('.', 1) || at_('=', 1)))
+                    {
+                        auto delim = cur_[1];
+                        auto first = cur_ + 2;
+                        auto end = first;
+                        while (end != last_ && !(*end == delim && end + 1 != last_ && end[1] == ']'))
+                            ++end;
+
+                        if (end == last_)
+                            return error_(rc::error_brack);
+                        cur_ = end + 2;
+
+                        is_set = delim == ':';
+                        if (is_set)
+                        {
+                            if (!lookup_class(first, end, set))
+                                return error_(rc::error_ctype);
+
+                            return true;
+                        }
+
+                        /**
+                         * Note: Only single character collating
+                         *       elements and equivalence classes
+                         *       of the "C" locale are supported.
+                         */
+                        if (end - first != 1)
+                            return error_(rc::error_collate);
+                        chr = static_cast<unsigned char>(*first);
+
+                        return true;
+                    }
+
+                    ++cur_;
+                    is_set = false;
+                    if (c != '\\' || grammar_ == grammar::basic || grammar_ == grammar::extended)
+                    {
+                        chr = static_cast<unsigned char>(c);
+
+                        return true;
+                    }
+
+                    if (cur_ == last_)
+                        return error_(rc::error_escape);
+
+                    c = *cur_++;
+                    if (grammar_ == grammar::awk)
+                    {
+                        if (!parse_char_escape_awk_(c, chr))
+                            return false;
+
+                        return true;
+                    }
+
+                    if (class_escape(c, set))
+                    {
+                        is_set = true;
+
+                        return true;
+                    }
+
+                    if (c == 'b')
+                    {
+                        chr = '\b';
+
+                        return true;
+                    }
+                    else if (c == '-')
+                    {
+                        chr = '-';
+
+                        return true;
+                    }
+
+                    if (!parse_char_escape_ecma_(c, chr))
+                        return false;
+
+                    return true;
+                }
+
+                uint32_t parse_bracket_()
+                {
+                    byte_set res{};
+                    bool negate{false};
+                    if (at_('^'))
+                    {
+                        ++cur_;
+                        negate = true;
+                    }
+
+                    /**
+                     * In POSIX brackets the first ] is an ordinary character,
+                     * in ECMAScript [] is an empty class that matches nothing.
+                     */
+                    bool first{true};
+                    while (true)
+                    {
+                        if (cur_ == last_)
+                            return fail_(rc::error_brack);
+
+                        if (*cur_ == ']' && (grammar_ == grammar::ecma || !first))
+                        {
+                            ++cur_;
+                            break;
+                        }
+                        first = false;
+
+                        unsigned char lo{};
+                        byte_set set{};
+                        bool is_set{};
+                        if (!parse_class_atom_(lo, set, is_set))
+                            return no_node;
+
+                        if (!is_set && at_('-') && cur_ + 1 != last_ && cur_[1] != ']')
+                        {
+                            ++cur_;
+
+                            unsigned char hi{};
+                            if (!parse_class_atom_(hi, set, is_set))
+                                return no_node;
+                            if (is_set || hi < lo)
+                                return fail_(rc::error_range);
+
+                            res.add_range(lo, hi);
+                        }
+                        else if (!is_set)
+                            res.add(lo);
+                        else
+                            res.merge(set);
+                    }
+
+                    return add_set_(res, negate);
+                }
+        };
+
+        /**
+         * Translates the syntax tree into NFA instructions.
+         */
+        class regex_compiler
+        {
+            public:
+                regex_compiler(const vector<node>& nodes, vector<regex_instruction>& code)
+                    : nodes_{nodes}, code_{code}
+                { /* DUMMY BODY */ }
+
+                bool compile(uint32_t root)
+                {
+                    emit_(regex_op::save, 0);
+                    if (!compile_(root))
+                        return false;
+                    emit_(regex_op::save, 1);
+                    emit_(regex_op::match);
+
+                    return code_.size() <= max_instructions;
+                }
+
+            private:
+                const vector<node>& nodes_;
+                vector<regex_instruction>& code_;
+
+                uint32_t emit_(regex_op op, uint32_t x = 0, uint32_t y = 0)
+                {
+                    code_.push_back(regex_instruction{op, x, y});
+
+                    return static_cast<uint32_t>(code_.size() - 1);
+                }
+
+                uint32_t here_() const
+                {
+                    return static_cast<uint32_t>(code_.size());
+                }
+
+                /**
+                 * Points a split at its preferred and other
+                 * target depending on the greediness.
+                 */
+                void patch_split_(uint32_t split, uint32_t body, uint32_t out, bool greedy)
+                {
+                    code_[split].x = greedy ? body : out;
+                    code_[split].y = greedy ? out : body;
+                }
+
+                bool compile_(uint32_t idx)
+                {
+                    if (code_.size() > max_instructions)
+                        return false;
+
+                    const auto& n = nodes_[idx];
+                    switch (n.kind)
+                    {
+                        case node_kind::empty:
+                            return true;
+                        case node_kind::set:
+                            emit_(regex_op::set, n.arg);
+                            return true;
+                        case node_kind::assertion:
+                            emit_(regex_op::assertion, n.arg);
+                            return true;
+                        case node_kind::group:
+                            emit_(regex_op::save, 2 * n.arg);
+                            if (!compile_(n.children[0]))
+                                return false;
+                            emit_(regex_op::save, 2 * n.arg + 1);
+                            return true;
+                        case node_kind::concat:
+                            for (auto child: n.children)
+                            {
+                                if (!compile_(child))
+                                    return false;
+                            }
+                            return true;
+                        case node_kind::alternation:
+                            return compile_alternation_(n);
+                        case node_kind::repeat:
+                            return compile_repeat_(n);
+                    }
+
+                    return false;
+                }
+
+                bool compile_alternation_(const node& n)
+                {
+                    vector<uint32_t> jumps{};
+                    for (size_t i = 0; i < n.children.size(); ++i)
+                    {
+                        if (i + 1 == n.children.size())
+                        {
+                            if (!compile_(n.children[i]))
+                                return false;
+                            break;
+                        }
+
+                        auto split = emit_(regex_op::split);
+                        if (!compile_(n.children[i]))
+                            return false;
+                        jumps.push_back(emit_(regex_op::jump));
+                        patch_split_(split, split + 1, here_(), true);
+                    }
+
+                    for (auto jump: jumps)
+                        code_[jump].x = here_();
+
+                    return true;
+                }
+
+                /**
+                 * Finds the slots of the groups nested in a node,
+                 * these are numbered consecutively.
+                 */
+                void group_slots_(uint32_t idx, uint32_t& first, uint32_t& last) const
+                {
+                    const auto& n = nodes_[idx];
+                    if (n.kind == node_kind::group)
+                    {
+                        if (first == last)
+                            first = 2 * n.arg;
+                        last = 2 * n.arg + 2;
+                    }
+
+                    for (auto child: n.children)
+                        group_slots_(child, first, last);
+                }
+
+                /**
+                 * Every iteration of a repeat starts with the
+                 * groups nested in it unmatched (ECMAScript).
+                 */
+                bool compile_iteration_(uint32_t child, uint32_t first, uint32_t last, bool reset)
+                {
+                    if (reset && first != last)
+                        emit_(regex_op::reset, first, last);
+
+                    return compile_(child);
+                }
+
+                bool compile_repeat_(const node& n)
+                {
+                    auto child = n.children[0];
+                    if (n.max == 0)
+                        return true;
+
+                    uint32_t first{}, last{};
+                    group_slots_(child, first, last);
+
+                    /**
+                     * The last of the mandatory copies
+                     * doubles as the body of an unbounded loop.
+                     */
+                    uint32_t copies = n.min;
+                    if (n.max == infinity && n.min > 0)
+                        --copies;
+
+                    for (uint32_t i = 0; i < copies; ++i)
+                    {
+                        if (!compile_iteration_(child, first, last, i > 0))
+                            return false;
+                    }
+
+                    if (n.max == infinity)
+                    {
+                        if (n.min > 0)
+                        {
+                            auto body = here_();
+                            if (!compile_iteration_(child, first, last, true))
+                                return false;
+                            auto split = emit_(regex_op::split);
+                            patch_split_(split, body, split + 1, n.greedy);
+                        }
+                        else
+                        {
+                            auto split = emit_(regex_op::split);
+                            if (!compile_iteration_(child, first, last, true))
+                                return false;
+                            emit_(regex_op::jump, split);
+                            patch_split_(split, split + 1, here_(), n.greedy);
+                        }
+
+                        return true;
+                    }
+
+                    vector<uint32_t> splits{};
+                    for (uint32_t i = n.min; i < n.max; ++i)
+                    {
+                        splits.push_back(emit_(regex_op::split));
+                        if (!compile_iteration_(child, first, last, i > 0))
+                            return false;
+                    }
+
+                    for (auto split: splits)
+                        patch_split_(split, split + 1, here_(), n.greedy);
+
+                    return true;
+                }
+        };
+
+        void compute_classes(regex_program& prog)
+        {
+            for (auto& c: prog.classes)
+                c = 0;
+            prog.class_count = 1;
+
+            auto refine = [&prog](const byte_set& set) {
+                bool in[256]{}, out[256]{};
+                int16_t split_to[256];
+                for (auto& s: split_to)
+                    s = -1;
+
+                for (unsigned int b = 0; b < 256; ++b)
+                {
+                    if (set.has(static_cast<unsigned char>(b)))
+                        in[prog.classes[b]] = true;
+                    else
+                        out[prog.classes[b]] = true;
+                }
+
+                for (unsigned int b = 0; b < 256; ++b)
+                {
+                    auto cls = prog.classes[b];
+                    if (!set.has(static_cast<unsigned char>(b)) || !in[cls] || !out[cls])
+                        continue;
+
+                    if (split_to[cls] < 0)
+                        split_to[cls] = static_cast<int16_t>(prog.class_count++);
+                    prog.classes[b] = static_cast<uint8_t>(split_to[cls]);
+                }
+            };
+
+            for (const auto& set: prog.sets)
+                refine(set);
+            refine(prog.word);
+            refine(prog.line_end);
+        }
+
+        void compute_first(regex_program& prog)
+        {
+            vector<bool> seen(prog.code.size(), false);
+            vector<size_t> stack{};
+            stack.push_back(0);
+            prog.has_first = true;
+
+            while (!stack.empty())
+            {
+                auto pc = stack.back();
+                stack.pop_back();
+                if (seen[pc])
+                    continue;
+                seen[pc] = true;
+
+                const auto& inst = prog.code[pc];
+                switch (inst.op)
+                {
+                    case regex_op::set:
+                        prog.first.merge(prog.sets[inst.x]);
+                        break;
+                    case regex_op::split:
+                        stack.push_back(inst.x);
+                        stack.push_back(inst.y);
+                        break;
+                    case regex_op::jump:
+                        stack.push_back(inst.x);
+                        break;
+                    case regex_op::save:
+                    case regex_op::reset:
+                        stack.push_back(pc + 1);
+                        break;
+                    default:
+                        prog.has_first = false;
+
+                        return;
+                }
+            }
+        }
+
+        bool build_program(const char* pattern, size_t len,
+                           rc::syntax_option_type flags,
+                           regex_program& prog, rc::error_type& err)
+        {
+            regex_parser parser{pattern, pattern + len, flags};
+            auto root = parser.parse();
+            if (root == no_node)
+            {
+                err = parser.error();
+
+                return false;
+            }
+
+            regex_compiler compiler{parser.nodes(), prog.code};
+            if (!compiler.compile(root))
+            {
+                err = rc::error_space;
+
+                return false;
+            }
+
+            prog.sets = move(parser.sets());
+            prog.marks = parser.groups();
+            prog.longest = parser.posix();
+            prog.multiline = (flags & rc::multiline) != 0;
+
+            prog.word = make_ctype_set(is_word);
+            prog.line_end.add('\n');
+            if (!parser.posix())
+                prog.line_end.add('\r');
+
+            compute_classes(prog);
+            compute_first(prog);
+
+            return true;
+        }
+
+        /**
+         * Flags describing the text before the current
+         * position, part of the identity of a DFA state.
+         */
+        enum context_flag: uint32_t
+        {
+            ctx_bol     = 1U << 0,
+            ctx_word    = 1U << 1,
+            ctx_no_wb   = 1U << 2,
+            ctx_restart = 1U << 3
+        };
+
+        struct context
+        {
+            bool bol;
+            bool eol;
+            bool prev_word;
+            bool next_word;
+            bool no_wb;
+        };
+
+        /**
+         * Context at a position given the flags describing what
+         * precedes it and the next byte (or -1 at the end of input).
+         */
+        context make_context(const regex_program& prog, uint32_t flags, int next,
+                             bool not_eol, bool not_eow)
+        {
+            context ctx{};
+            ctx.bol = (flags & ctx_bol) != 0;
+            ctx.prev_word = (flags & ctx_word) != 0;
+            ctx.no_wb = (flags & ctx_no_wb) != 0;
+
+            if (next < 0)
+            {
+                ctx.eol = !not_eol;
+                ctx.next_word = false;
+                ctx.no_wb = ctx.no_wb || not_eow;
+            }
+            else
+            {
+                auto c = static_cast<unsigned char>(next);
+                ctx.eol = prog.multiline && prog.line_end.has(c);
+                ctx.next_word = prog.word.has(c);
+            }
+
+            return ctx;
+        }
+
+        /**
+         * Flags of the position after the byte c.
+         */
+        uint32_t flags_after(const regex_program& prog, unsigned char c)
+        {
+            uint32_t res{};
+            if (prog.multiline && prog.line_end.has(c))
+                res |= ctx_bol;
+            if (prog.word.has(c))
+                res |= ctx_word;
+
+            return res;
+        }
+
+        bool assertion_holds(uint32_t kind, const context& ctx)
+        {
+            bool boundary = !ctx.no_wb && ctx.prev_word != ctx.next_word;
+            switch (kind)
+            {
+                case assert_bol:
+                    return ctx.bol;
+                case assert_eol:
+                    return ctx.eol;
+                case assert_word_boundary:
+                    return boundary;
+                case assert_not_word_boundary:
+                    return !boundary;
+                default:
+                    return false;
+            }
+        }
+
+        /**
+         * Size of the cache of a single DFA, once it is
+         * reached the cache is flushed and rebuilt.
+         */
+        constexpr size_t dfa_budget{1U << 20};
+
+        /**
+         * If the cache has to be flushed more than this many
+         * times while making little progress, the search is
+         * handed over to the NFA simulation.
+         */
+        constexpr size_t dfa_max_flushes{4};
+        constexpr size_t dfa_min_progress{10};
+    }
+
+    class regex_sparse_set
+    {
+        public:
+            regex_sparse_set()
+                : dense_{}, sparse_{}, size_{}
+            { /* DUMMY BODY */ }
+
+            void resize(size_t n)
+            {
+                dense_.resize(n);
+                sparse_.resize(n);
+                size_ = 0;
+            }
+
+            bool contains(uint32_t val) const
+            {
+                auto idx = sparse_[val];
+
+                return idx < size_ && dense_[idx] == val;
+            }
+
+            void insert(uint32_t val)
+            {
+                sparse_[val] = static_cast<uint32_t>(size_);
+                dense_[size_++] = val;
+            }
+
+            void clear()
+            {
+                size_ = 0;
+            }
+
+        private:
+            vector<uint32_t> dense_;
+            vector<uint32_t> sparse_;
+            size_t size_;
+    };
+
+    enum class regex_run_kind
+    {
+        /**
+         * Leftmost match preferred by priorities (ECMAScript).
+         */
+        first,
+
+        /**
+         * Leftmost longest match (POSIX).
+         */
+        longest,
+
+        /**
+         * Match of the whole input, regex_match.
+         */
+        full
+    };
+
+    /**
+     * A state of the DFA is the list of NFA instructions
+     * that consume a byte reached by the threads alive at
+     * a position, ordered by their priority, together with
+     * the context flags of the position. In the longest
+     * mode, threads that started at different positions
+     * are separated by marks so that threads that started
+     * later can be dropped once a match is found.
+     */
+    class regex_dfa
+    {
+        public:
+            enum class result
+            {
+                no_match, match, give_up
+            };
+
+            regex_dfa(const regex_program& prog, regex_run_kind kind)
+                : prog_{prog}, kind_{kind}, states_{}, transitions_{},
+                  index_{}, memory_{}, closure_{}, stack_{},
+                  visited_{}, next_{}, starts_{}
+            {
+                visited_.resize(prog_.code.size());
+                flush_();
+            }
+
+            /**
+             * Runs the DFA over [first, last) and sets match_end
+             * to the end of the match if one is found, or to the
+             * first position where a match ended if early_exit is set.
+             */
+            result run(const char* first, const char* last, uint32_t start_flags,
+                       bool anchored, bool early_exit, bool not_eol, bool not_eow,
+                       const char*& match_end)
+            {
+                auto state = start_state_(start_flags, anchored);
+
+                const auto* classes = prog_.classes;
+                const auto class_count = prog_.class_count;
+                const char* found{nullptr};
+                const char* flushed_at{first};
+                size_t flushes{};
+
+                auto p = first;
+                for (; p != last; ++p)
+                {
+                    auto c = static_cast<unsigned char>(*p);
+                    auto idx = state * class_count + classes[c];
+                    auto trans = transitions_[idx];
+
+                    if (trans < 0)
+                    {
+                        trans = compute_(state, c);
+                        if (trans < 0)
+                        {
+                            if (++flushes > dfa_max_flushes &&
+                                static_cast<size_t>(p - flushed_at) < dfa_min_progress * states_.size())
+                                return result::give_up;
+                            flushed_at = p;
+
+                            auto key = states_[state];
+                            flush_();
+                            state = add_state_(key);
+                            trans = compute_(state, c);
+                            if (trans < 0)
+                                return result::give_up;
+                            idx = state * class_count + classes[c];
+                        }
+
+                        transitions_[idx] = trans;
+                    }
+
+                    if ((trans & 1) && kind_ != regex_run_kind::full)
+                    {
+                        found = p;
+                        if (early_exit)
+                        {
+                            match_end = p;
+
+                            return result::match;
+                        }
+                    }
+
+                    state = static_cast<uint32_t>(trans) >> 1;
+                    if (state == dead)
+                        break;
+                }
+
+                if (p == last)
+                {
+                    auto ctx = make_context(prog_, states_[state].flags, -1, not_eol, not_eow);
+                    if (closure_of_(states_[state], ctx))
+                        found = last;
+                }
+
+                if (!found)
+                    return result::no_match;
+
+                match_end = found;
+
+                return result::match;
+            }
+
+        private:
+            struct state_key
+            {
+                vector<uint32_t> kernel;
+                uint32_t flags;
+
+                bool operator==(const state_key& other) const
+                {
+                    return flags == other.flags && kernel == other.kernel;
+                }
+            };
+
+            struct state_key_hash
+            {
+                size_t operator()(const state_key& key) const noexcept
+                {
+                    uint64_t res{0xcbf29ce484222325ULL ^ key.flags};
+                    for (auto pc: key.kernel)
+                    {
+                        res ^= pc;
+                        res *= 0x100000001b3ULL;
+                    }
+
+                    return static_cast<size_t>(res ^ (res >> 32));
+                }
+            };
+
+            static constexpr uint32_t mark{static_cast<uint32_t>(-1)};
+            static constexpr uint32_t full{static_cast<uint32_t>(-1)};
+            static constexpr uint32_t dead{0};
+
+            const regex_program& prog_;
+            regex_run_kind kind_;
+
+            vector<state_key> states_;
+
+            /**
+             * Transitions of all states indexed by state
+             * and byte class, -1 for transitions that were
+             * not computed yet, otherwise the next state
+             * shifted left by one with the lowest bit set
+             * if a match ended before the byte.
+             */
+            vector<int32_t> transitions_;
+
+            __helenos::flat_hash_map<state_key, uint32_t, state_key_hash> index_;
+            size_t memory_;
+
+            vector<uint32_t> closure_;
+            vector<uint32_t> stack_;
+            regex_sparse_set visited_;
+            state_key next_;
+
+            /**
+             * Start states indexed by the start flags and
+             * by whether the search is anchored, so that
+             * short inputs do not pay for a lookup.
+             */
+            static constexpr size_t start_count{32};
+            uint32_t starts_[start_count];
+
+            void flush_()
+            {
+                states_.clear();
+                transitions_.clear();
+                index_.clear();
+                memory_ = 0;
+
+                for (auto& start: starts_)
+                    start = full;
+
+                /**
+                 * The dead state always has index 0.
+                 */
+                add_state_(state_key{{}, 0});
+            }
+
+            uint32_t start_state_(uint32_t start_flags, bool anchored)
+            {
+                auto idx = (start_flags & (ctx_bol | ctx_word | ctx_no_wb)) | (anchored ? 16U : 0U);
+                if (starts_[idx] != full)
+                    return starts_[idx];
+
+                state_key start{};
+                start.flags = start_flags;
+                if (anchored)
+                    start.kernel.push_back(0);
+                else
+                    start.flags |= ctx_restart;
+
+                auto state = add_state_(start);
+                if (state == full)
+                {
+                    flush_();
+                    state = add_state_(start);
+                }
+                starts_[idx] = state;
+
+                return state;
+            }
+
+            uint32_t add_state_(const state_key& key)
+            {
+                auto it = index_.find(key);
+                if (it != index_.end())
+                    return it->second;
+
+                auto cost = sizeof(state_key) * 2 + 2 * sizeof(uint32_t) * key.kernel.size() +
+                            sizeof(int32_t) * prog_.class_count;
+                if (memory_ + cost > dfa_budget && states_.size() > 1)
+                    return full;
+                memory_ += cost;
+
+                auto idx = static_cast<uint32_t>(states_.size());
+                states_.push_back(key);
+                transitions_.resize(transitions_.size() + prog_.class_count, -1);
+                index_.emplace(key, idx);
+
+                return idx;
+            }
+
+            /**
+             * Follows all empty transitions from the kernel of a state
+             * in priority order, the reached instructions that consume
+             * a byte are stored in closure_. Returns true if the match
+             * instruction was reached.
+             */
+            bool closure_of_(const state_key& key, const context& ctx)
+            {
+                closure_.clear();
+                visited_.clear();
+
+                const auto& kernel = key.kernel;
+                bool restart = (key.flags & ctx_restart) != 0;
+                bool matched{false};
+
+                for (size_t i = 0; i <= kernel.size(); ++i)
+                {
+                    uint32_t start{};
+                    if (i < kernel.size())
+                        start = kernel[i];
+                    else if (restart && !matched)
+                    {
+                        if (kind_ == regex_run_kind::longest && !closure_.empty() && closure_.back() != mark)
+                            closure_.push_back(mark);
+                    }
+                    else
+                        break;
+
+                    if (start == mark)
+                    {
+                        /**
+                         * Threads that started later cannot
+                         * produce the leftmost longest match.
+                         */
+                        if (matched)
+                            break;
+                        if (!closure_.empty() && closure_.back() != mark)
+                            closure_.push_back(mark);
+
+                        continue;
+                    }
+
+                    stack_.clear();
+                    stack_.push_back(start);
+                    while (!stack_.empty())
+                    {
+                        auto pc = stack_.back();
+                        stack_.pop_back();
+
+                        if (visited_.contains(pc))
+                            continue;
+                        visited_.insert(pc);
+
+                        const auto& inst = prog_.code[pc];
+                        switch (inst.op)
+                        {
+                            case regex_op::set:
+                                closure_.push_back(pc);
+                                break;
+                            case regex_op::match:
+                                /**
+                                 * Threads of lower priority than the match
+                                 * cannot change the leftmost first match.
+                                 */
+                                if (kind_ == regex_run_kind::first)
+                                    return true;
+                                matched = true;
+                                break;
+                            case regex_op::jump:
+                                stack_.push_back(inst.x);
+                                break;
+                            case regex_op::split:
+                                stack_.push_back(inst.y);
+                                stack_.push_back(inst.x);
+                                break;
+                            case regex_op::save:
+                            case regex_op::reset:
+                                stack_.push_back(pc + 1);
+                                break;
+                            case regex_op::assertion:
+                                if (assertion_holds(inst.x, ctx))
+                                    stack_.push_back(pc + 1);
+                                break;
+                        }
+                    }
+                }
+
+                while (!closure_.empty() && closure_.back() == mark)
+                    closure_.pop_back();
+
+                return matched;
+            }
+
+            /**
+             * Computes the transition of a state on byte c,
+             * returns -1 if the cache is full.
+             */
+            int32_t compute_(uint32_t state, unsigned char c)
+            {
+                const auto& key = states_[state];
+                auto ctx = make_context(prog_, key.flags, c, false, false);
+                bool matched = closure_of_(key, ctx);
+
+                next_.kernel.clear();
+                for (auto pc: closure_)
+                {
+                    if (pc == mark)
+                    {
+                        if (!next_.kernel.empty() && next_.kernel.back() != mark)
+                            next_.kernel.push_back(mark);
+                    }
+                    else if (prog_.sets[prog_.code[pc].x].has(c))
+                        next_.kernel.push_back(pc + 1);
+                }
+
+                while (!next_.kernel.empty() && next_.kernel.back() == mark)
+                    next_.kernel.pop_back();
+
+                next_.flags = flags_after(prog_, c);
+                if ((key.flags & ctx_restart) && !matched)
+                    next_.flags |= ctx_restart;
+                if (next_.kernel.empty() && !(next_.flags & ctx_restart))
+                    next_.flags = 0;
+
+                auto next = add_state_(next_);
+                if (next == full)
+                    return -1;
+
+                return static_cast<int32_t>((next << 1) | (matched ? 1 : 0));
+            }
+    };
+
+    namespace
+    {
+        /**
+         * Simulation of the NFA that keeps track of the
+         * capture groups of each thread, used to find the
+         * groups of a match after the DFA found its end.
+         */
+        class pike_vm
+        {
+            public:
+                pike_vm(const regex_program& prog, size_t slots)
+                    : prog_{prog}, slots_{slots}, clist_{}, nlist_{},
+                      stack_{}, work_(slots), best_(slots, regex_engine::no_pos)
+                {
+                    clist_.init(prog_.code.size(), slots_);
+                    nlist_.init(prog_.code.size(), slots_);
+                }
+
+                /**
+                 * Steps over [first, end), last is the end of the
+                 * input that determines the context of end.
+                 */
+                bool run(const char* first, const char* end, const char* last,
+                         uint32_t start_flags, bool not_eol, bool not_eow,
+                         bool not_null, bool anchored, regex_run_kind kind)
+                {
+                    vector<ptrdiff_t> fresh(slots_, regex_engine::no_pos);
+                    bool matched{false};
+
+                    auto* clist = &clist_;
+                    auto* nlist = &nlist_;
+                    clist->clear();
+                    nlist->clear();
+
+                    auto ctx = make_context(prog_, start_flags, first == last ? -1 : static_cast<unsigned char>(*first),
+                                            not_eol, not_eow);
+                    for (auto p = first; ; ++p)
+                    {
+                        /**
+                         * Without live threads the input can be skipped
+                         * up to the next byte that can start a match.
+                         */
+                        if (clist->count == 0 && !matched && !anchored && prog_.has_first)
+                        {
+                            auto q = p;
+                            while (q != end && !prog_.first.has(static_cast<unsigned char>(*q)))
+                                ++q;
+
+                            if (q == end)
+                                break;
+                            else if (q != p)
+                            {
+                                p = q;
+                                ctx = make_context(prog_, flags_after(prog_, static_cast<unsigned char>(p[-1])),
+                                                   static_cast<unsigned char>(*p), not_eol, not_eow);
+                            }
+                        }
+
+                        auto offset = p - first;
+                        if (!matched && (p == first || !anchored))
+                            add_(*clist, 0, fresh.data(), offset, ctx);
+
+                        if (clist->count == 0 && (matched || anchored))
+                            break;
+
+                        context next_ctx{};
+                        if (p != end)
+                        {
+                            auto c = static_cast<unsigned char>(*p);
+                            next_ctx = make_context(prog_, flags_after(prog_, c),
+                                                    p + 1 == last ? -1 : static_cast<unsigned char>(p[1]),
+                                                    not_eol, not_eow);
+                        }
+
+                        for (size_t i = 0; i < clist->count; ++i)
+                        {
+                            auto pc = clist->pcs[i];
+                            auto caps = clist->caps(i);
+                            const auto& inst = prog_.code[pc];
+
+                            if (inst.op == regex_op::match)
+                            {
+                                if (not_null && caps[0] == offset)
+                                    continue;
+
+                                if (kind == regex_run_kind::longest)
+                                {
+                                    if (!matched || caps[0] < best_[0] ||
+                                        (caps[0] == best_[0] && caps[1] > best_[1]))
+                                        save_(caps);
+                                    matched = true;
+
+                                    continue;
+                                }
+                                else if (kind == regex_run_kind::full && p != last)
+                                    continue;
+
+                                save_(caps);
+                                matched = true;
+
+                                /**
+                                 * Threads of lower priority are cut off.
+                                 */
+                                break;
+                            }
+
+                            if (p != end && prog_.sets[inst.x].has(static_cast<unsigned char>(*p)))
+                                add_(*nlist, pc + 1, caps, offset + 1, next_ctx);
+                        }
+
+                        if (p == end)
+                            break;
+
+                        swap(clist, nlist);
+                        nlist->clear();
+                        ctx = next_ctx;
+                    }
+
+                    return matched;
+                }
+
+                const ptrdiff_t* groups() const
+                {
+                    return best_.data();
+                }
+
+            private:
+                struct thread_list
+                {
+                    regex_sparse_set visited;
+                    vector<uint32_t> pcs;
+                    vector<ptrdiff_t> slots;
+                    size_t count;
+                    size_t width;
+
+                    void init(size_t size, size_t w)
+                    {
+                        visited.resize(size);
+                        pcs.resize(size);
+                        slots.resize(size * w);
+                        count = 0;
+                        width = w;
+                    }
+
+                    void clear()
+                    {
+                        visited.clear();
+                        count = 0;
+                    }
+
+                    ptrdiff_t* caps(size_t i)
+                    {
+                        return slots.data() + i * width;
+                    }
+                };
+
+                struct stack_entry
+                {
+                    uint32_t pc;
+                    uint32_t slot;
+                    ptrdiff_t value;
+                };
+
+                static constexpr uint32_t no_slot{static_cast<uint32_t>(-1)};
+
+                const regex_program& prog_;
+                size_t slots_;
+                thread_list clist_;
+                thread_list nlist_;
+                vector<stack_entry> stack_;
+                vector<ptrdiff_t> work_;
+                vector<ptrdiff_t> best_;
+
+                void save_(const ptrdiff_t* caps)
+                {
+                    for (size_t i = 0; i < slots_; ++i)
+                        best_[i] = caps[i];
+                }
+
+                /**
+                 * Adds the threads reachable from pc by empty
+                 * transitions in priority order, the saved
+                 * group slots are restored when backing out
+                 * of the branch that saved them.
+                 */
+                void add_(thread_list& list, uint32_t pc0, const ptrdiff_t* caps,
+                          ptrdiff_t offset, const context& ctx)
+                {
+                    for (size_t i = 0; i < slots_; ++i)
+                        work_[i] = caps[i];
+
+                    stack_.clear();
+                    stack_.push_back(stack_entry{pc0, no_slot, 0});
+                    while (!stack_.empty())
+                    {
+                        auto entry = stack_.back();
+                        stack_.pop_back();
+
+                        if (entry.slot != no_slot)
+                        {
+                            work_[entry.slot] = entry.value;
+                            continue;
+                        }
+
+                        auto pc = entry.pc;
+                        while (!list.visited.contains(pc))
+                        {
+                            list.visited.insert(pc);
+
+                            const auto& inst = prog_.code[pc];
+                            if (inst.op == regex_op::jump)
+                                pc = inst.x;
+                            else if (inst.op == regex_op::split)
+                            {
+                                stack_.push_back(stack_entry{inst.y, no_slot, 0});
+                                pc = inst.x;
+                            }
+                            else if (inst.op == regex_op::save)
+                            {
+                                if (inst.x < slots_)
+                                {
+                                    stack_.push_back(stack_entry{0, inst.x, work_[inst.x]});
+                                    work_[inst.x] = offset;
+                                }
+                                ++pc;
+                            }
+                            else if (inst.op == regex_op::reset)
+                            {
+                                for (auto slot = inst.x; slot < inst.y && slot < slots_; ++slot)
+                                {
+                                    if (work_[slot] == regex_engine::no_pos)
+                                        continue;
+
+                                    stack_.push_back(stack_entry{0, slot, work_[slot]});
+                                    work_[slot] = regex_engine::no_pos;
+                                }
+                                ++pc;
+                            }
+                            else if (inst.op == regex_op::assertion)
+                            {
+                                if (!assertion_holds(inst.x, ctx))
+                                    break;
+                                ++pc;
+                            }
+                            else
+                            {
+                                auto idx = list.count++;
+                                list.pcs[idx] = pc;
+
+                                auto dest = list.caps(idx);
+                                for (size_t i = 0; i < slots_; ++i)
+                                    dest[i] = work_[i];
+
+                                break;
+                            }
+                        }
+                    }
+                }
+        };
+    }
+
+    regex_engine* regex_engine::compile(const char* pattern, size_t len,
+                                        regex_constants::syntax_option_type flags,
+                                        regex_constants::error_type& err)
+    {
+        auto prog = new regex_program{};
+        if (!build_program(pattern, len, flags, *prog, err))
+        {
+            delete prog;
+
+            return nullptr;
+        }
+
+        return new regex_engine{prog};
+    }
+
+    regex_engine::regex_engine(regex_program* prog)
+        : prog_{prog},
+          search_dfa_{new regex_dfa{*prog, prog->longest ? regex_run_kind::longest : regex_run_kind::first}},
+          match_dfa_{new regex_dfa{*prog, regex_run_kind::full}},
+          mutex_{}
+    {
+        threading::mutex::init(mutex_);
+    }
+
+    regex_engine::~regex_engine()
+    {
+        delete search_dfa_;
+        delete match_dfa_;
+        delete prog_;
+    }
+
+    size_t regex_engine::mark_count() const noexcept
+    {
+        return prog_->marks;
+    }
+
+    bool regex_engine::execute(const char* first, const char* last, char prev,
+                               regex_constants::match_flag_type flags, mode md,
+                               ptrdiff_t* groups) const
+    {
+        const auto& prog = *prog_;
+
+        /**
+         * Note: When the character before first is available,
+         *       match_not_bol and match_not_bow are ignored.
+         */
+        uint32_t start_flags{};
+        if (flags & rc::match_prev_avail)
+        {
+            auto c = static_cast<unsigned char>(prev);
+            if (prog.multiline && prog.line_end.has(c))
+                start_flags |= ctx_bol;
+            if (prog.word.has(c))
+                start_flags |= ctx_word;
+        }
+        else
+        {
+            if (!(flags & rc::match_not_bol))
+                start_flags |= ctx_bol;
+            if (flags & rc::match_not_bow)
+                start_flags |= ctx_no_wb;
+        }
+
+        bool not_eol = (flags & rc::match_not_eol) != 0;
+        bool not_eow = (flags & rc::match_not_eow) != 0;
+        bool not_null = (flags & rc::match_not_null) != 0;
+        bool anchored = md == mode::match || (flags & rc::match_continuous);
+
+        regex_run_kind kind{regex_run_kind::full};
+        if (md == mode::search)
+            kind = prog.longest ? regex_run_kind::longest : regex_run_kind::first;
+
+        /**
+         * The DFA cannot tell if a match is empty, so with
+         * match_not_null it only rules out inputs that do
+         * not match at all.
+         */
+        const char* end{last};
+        if (threading::mutex::try_lock(mutex_))
+        {
+            auto& dfa = (md == mode::match) ? *match_dfa_ : *search_dfa_;
+
+            const char* match_end{};
+            auto res = dfa.run(
+                first, last, start_flags, anchored,
+                !groups || (flags & rc::match_any),
+                not_eol, not_eow, match_end
+            );
+            threading::mutex::unlock(mutex_);
+
+            if (res == regex_dfa::result::no_match)
+                return false;
+            else if (res == regex_dfa::result::match)
+            {
+                if (!groups && !not_null)
+                    return true;
+                if (!not_null)
+                    end = match_end;
+            }
+        }
+
+        pike_vm vm{prog, groups ? 2 * (prog.marks + 1) : 2};
+        if (!vm.run(first, end, last, start_flags, not_eol, not_eow, not_null, anchored, kind))
+            return false;
+
+        if (groups)
+        {
+            auto res = vm.groups();
+            for (size_t i = 0; i < 2 * (prog.marks + 1); ++i)
+                groups[i] = res[i];
+        }
+
+        return true;
+    }
+}
@@ -32,6 +32,13 @@
 #include <thread>
 #include <utility>
 
+/**
+ * Note: Declared here because <stats.h> does not wrap
+ *       its declarations for C++, the returned array
+ *       (of stats_cpu_t) is only counted and freed.
+ */
+extern "C" void* stats_get_cpus(std::size_t*);
+
 namespace std
 {
     thread::thread() noexcept
@@ -119,9 +126,14 @@ namespace std
 
     unsigned thread::hardware_concurrency() noexcept
     {
-        // TODO:
-        __unimplemented();
-        return 0;
+        size_t count{};
+        auto cpus = stats_get_cpus(&count);
+        if (!cpus)
+            return 0;
+
+        std::free(cpus);
+
+        return static_cast<unsigned>(count);
     }
 
     void swap(thread& x, thread& y) noexcept
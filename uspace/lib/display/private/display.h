@@ -43,6 +43,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <types/ipcgfx/client.h>
 
 /** Display server session structure */
 struct display {
@@ -70,6 +71,10 @@ struct display_window {
 	display_wnd_cb_t *cb;
 	/** Argument to callback functions */
 	void *cb_arg;
+	/** Batching IPC GC or @c NULL */
+	ipc_gc_t *batch_gc;
+	/** Session of the batching IPC GC */
+	async_sess_t *batch_sess;
 };
 
 #endif
@@ -234,6 +234,11 @@ errno_t display_window_destroy(display_window_t *window)
 	if (window == NULL)
 		return EOK;
 
+	if (window->batch_gc != NULL) {
+		(void) ipc_gc_delete(window->batch_gc);
+		async_hangup(window->batch_sess);
+	}
+
 	exch = async_exchange_begin(window->display->sess);
 	rc = async_req_1_0(exch, DISPLAY_WINDOW_DESTROY, window->id);
 
@@ -276,6 +281,53 @@ errno_t display_window_get_gc(display_window_t *window, gfx_context_t **rgc)
 	return EOK;
 }
 
+/** Create batching graphics context for drawing into a window.
+ *
+ * Drawing operations are collected and sent to the display server
+ * together by gfx_update(), which the caller must call to make its
+ * drawing visible (see ipc_gc_batch_enable()). If the display server
+ * does not support batching, the graphics context works without it.
+ * The graphics context is destroyed together with the window.
+ *
+ * @param window Window
+ * @param rgc Place to store pointer to new graphics context
+ * @return EOK on success or an error code
+ */
+errno_t display_window_get_batch_gc(display_window_t *window,
+    gfx_context_t **rgc)
+{
+	async_sess_t *sess;
+	async_exch_t *exch;
+	ipc_gc_t *gc;
+	errno_t rc;
+
+	if (window->batch_gc != NULL)
+		return EBUSY;
+
+	exch = async_exchange_begin(window->display->sess);
+	sess = async_connect_me_to(exch, INTERFACE_GC, 0, window->id, &rc);
+	if (sess == NULL) {
+		async_exchange_end(exch);
+		return rc;
+	}
+
+	async_exchange_end(exch);
+
+	rc = ipc_gc_create(sess, &gc);
+	if (rc != EOK) {
+		async_hangup(sess);
+		return rc;
+	}
+
+	/* Fall back to unbatched operation if not supported */
+	(void) ipc_gc_batch_enable(gc);
+
+	window->batch_gc = gc;
+	window->batch_sess = sess;
+	*rgc = ipc_gc_get_ctx(gc);
+	return EOK;
+}
+
 /** Request a window move.
  *
  * Request the display service to initiate a user window move operation
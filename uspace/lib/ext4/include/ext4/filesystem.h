@@ -50,6 +50,8 @@ extern uint32_t ext4_filesystem_blockaddr2_index_in_group(ext4_superblock_t *,
 extern uint32_t ext4_filesystem_index_in_group2blockaddr(ext4_superblock_t *,
     uint32_t, uint32_t);
 extern uint32_t ext4_filesystem_blockaddr2group(ext4_superblock_t *, uint64_t);
+extern errno_t ext4_filesystem_read_block_group_ref(ext4_filesystem_t *,
+    uint32_t, ext4_block_group_ref_t **);
 extern errno_t ext4_filesystem_get_block_group_ref(ext4_filesystem_t *, uint32_t,
     ext4_block_group_ref_t **);
 extern errno_t ext4_filesystem_put_block_group_ref(ext4_block_group_ref_t *);
@@ -62,6 +64,8 @@ extern errno_t ext4_filesystem_free_inode(ext4_inode_ref_t *);
 extern errno_t ext4_filesystem_truncate_inode(ext4_inode_ref_t *, aoff64_t);
 extern errno_t ext4_filesystem_get_inode_data_block_index(ext4_inode_ref_t *,
     aoff64_t iblock, uint32_t *);
+extern errno_t ext4_filesystem_get_inode_data_block_range(ext4_inode_ref_t *,
+    aoff64_t, uint32_t *, uint32_t *);
 extern errno_t ext4_filesystem_set_inode_data_block_index(ext4_inode_ref_t *,
     aoff64_t, uint32_t);
 extern errno_t ext4_filesystem_release_inode_block(ext4_inode_ref_t *, uint32_t);
@@ -35,7 +35,10 @@
 #ifndef LIBEXT4_TYPES_H_
 #define LIBEXT4_TYPES_H_
 
+#include <adt/hash_table.h>
+#include <adt/list.h>
 #include <block.h>
+#include <fibril_synch.h>
 
 /*
  * Structure of the super block
@@ -232,8 +235,77 @@ typedef struct ext4_filesystem {
 	ext4_superblock_t *superblock;
 	aoff64_t inode_block_limits[4];
 	aoff64_t inode_blocks_per_level[4];
+
+	/** Upper bound of the longest free extent in each block group */
+	uint32_t *bg_max_free;
+	/** Incremented whenever blocks are freed */
+	uint64_t bg_free_gen;
+	/** Protects summary fibril state */
+	fibril_mutex_t summary_lock;
+	/** Signalled when summary fibril terminates */
+	fibril_condvar_t summary_cv;
+	/** Summary fibril is running */
+	bool summary_running;
+	/** Summary fibril should terminate */
+	bool summary_stop;
+	/** Per-inode preallocation windows (ext4_balloc_pa_t) */
+	list_t prealloc;
+	/** Protects @c prealloc */
+	fibril_mutex_t prealloc_lock;
+
+	/** Extent status of recently used i-nodes */
+	hash_table_t es_inodes;
+	/** I-nodes in @c es_inodes, most recently used first */
+	list_t es_lru;
+	/** Number of i-nodes in @c es_inodes */
+	size_t es_count;
+	/** Protects extent status cache */
+	fibril_mutex_t es_lock;
 } ext4_filesystem_t;
 
+/** Maximum number of i-nodes with cached extent status */
+#define EXT4_ES_MAX_INODES  128
+/** Maximum number of cached ranges per i-node */
+#define EXT4_ES_INODE_RANGES  16
+
+/** Range of logical blocks mapped to consecutive physical blocks */
+typedef struct {
+	/** First logical block */
+	uint32_t iblock;
+	/** First physical block */
+	uint32_t fblock;
+	/** Number of blocks */
+	uint32_t count;
+} ext4_es_range_t;
+
+/** Longest free extent of block group is not known */
+#define EXT4_BALLOC_MAX_FREE_UNKNOWN  UINT32_MAX
+
+/** Minimum number of blocks preallocated for an i-node at once */
+#define EXT4_BALLOC_PREALLOC_MIN  8
+/** Maximum number of blocks preallocated for an i-node at once */
+#define EXT4_BALLOC_PREALLOC_MAX  256
+
+/** Preallocation window of an i-node.
+ *
+ * Blocks in the window are marked as used in the block bitmap, but they
+ * are not yet accounted to the i-node. They are handed out to the i-node
+ * as it grows sequentially and returned to the free pool once the file
+ * is closed or truncated.
+ */
+typedef struct {
+	/** Link to ext4_filesystem_t.prealloc */
+	link_t link;
+	/** I-node number */
+	uint32_t inode;
+	/** Logical block that will be served from the window next */
+	uint32_t iblock;
+	/** First remaining physical block of the window */
+	uint32_t fblock;
+	/** Number of remaining blocks in the window */
+	uint32_t count;
+} ext4_balloc_pa_t;
+
 /** Size of buffer for volume name. To hold 16 latin-1 chars encoded as UTF-8
  * and a null terminator we need 2 * 16 + 1 bytes
  */
@@ -36,8 +36,11 @@
  */
 
 #include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include "ext4/balloc.h"
 #include "ext4/bitmap.h"
 #include "ext4/block_group.h"
@@ -92,6 +95,9 @@ errno_t ext4_balloc_free_block(ext4_inode_ref_t *inode_ref, uint32_t block_addr)
 		return rc;
 	}
 
+	fs->bg_max_free[block_group] = EXT4_BALLOC_MAX_FREE_UNKNOWN;
+	fs->bg_free_gen++;
+
 	uint32_t block_size = ext4_superblock_get_block_size(sb);
 
 	/* Update superblock free blocks count */
@@ -119,10 +125,21 @@ errno_t ext4_balloc_free_block(ext4_inode_ref_t *inode_ref, uint32_t block_addr)
 	return ext4_filesystem_put_block_group_ref(bg_ref);
 }
 
-static errno_t ext4_balloc_free_blocks_internal(ext4_inode_ref_t *inode_ref,
+/** Return continuous set of blocks to the free pool.
+ *
+ * Blocks must lie in a single block group. Only the bitmap, block group
+ * and superblock are updated, the owning i-node is left untouched.
+ *
+ * @param fs    Filesystem
+ * @param first First block to release
+ * @param count Number of blocks to release
+ *
+ * @return Error code
+ *
+ */
+static errno_t ext4_balloc_release_blocks_internal(ext4_filesystem_t *fs,
     uint32_t first, uint32_t count)
 {
-	ext4_filesystem_t *fs = inode_ref->fs;
 	ext4_superblock_t *sb = fs->superblock;
 
 	/* Compute indexes */
@@ -165,7 +182,9 @@ static errno_t ext4_balloc_free_blocks_internal(ext4_inode_ref_t *inode_ref,
 		return rc;
 	}
 
-	uint32_t block_size = ext4_superblock_get_block_size(sb);
+	/* Freed blocks may have merged with a neighbouring free extent */
+	fs->bg_max_free[block_group_first] = EXT4_BALLOC_MAX_FREE_UNKNOWN;
+	fs->bg_free_gen++;
 
 	/* Update superblock free blocks count */
 	uint32_t sb_free_blocks =
@@ -173,13 +192,6 @@ static errno_t ext4_balloc_free_blocks_internal(ext4_inode_ref_t *inode_ref,
 	sb_free_blocks += count;
 	ext4_superblock_set_free_blocks_count(sb, sb_free_blocks);
 
-	/* Update inode blocks count */
-	uint64_t ino_blocks =
-	    ext4_inode_get_blocks_count(sb, inode_ref->inode);
-	ino_blocks -= count * (block_size / EXT4_INODE_BLOCK_SIZE);
-	ext4_inode_set_blocks_count(sb, inode_ref->inode, ino_blocks);
-	inode_ref->dirty = true;
-
 	/* Update block group free blocks count */
 	uint32_t free_blocks =
 	    ext4_block_group_get_free_blocks_count(bg_ref->block_group, sb);
@@ -192,6 +204,28 @@ static errno_t ext4_balloc_free_blocks_internal(ext4_inode_ref_t *inode_ref,
 	return ext4_filesystem_put_block_group_ref(bg_ref);
 }
 
+static errno_t ext4_balloc_free_blocks_internal(ext4_inode_ref_t *inode_ref,
+    uint32_t first, uint32_t count)
+{
+	ext4_superblock_t *sb = inode_ref->fs->superblock;
+
+	errno_t rc = ext4_balloc_release_blocks_internal(inode_ref->fs, first,
+	    count);
+	if (rc != EOK)
+		return rc;
+
+	uint32_t block_size = ext4_superblock_get_block_size(sb);
+
+	/* Update inode blocks count */
+	uint64_t ino_blocks =
+	    ext4_inode_get_blocks_count(sb, inode_ref->inode);
+	ino_blocks -= count * (block_size / EXT4_INODE_BLOCK_SIZE);
+	ext4_inode_set_blocks_count(sb, inode_ref->inode, ino_blocks);
+	inode_ref->dirty = true;
+
+	return EOK;
+}
+
 /** Free continuous set of blocks.
  *
  * @param inode_ref Inode, where the blocks are allocated
@@ -614,6 +648,631 @@ success:
 	return rc;
 }
 
+/** Allocate a run of blocks in a block group.
+ *
+ * The run is placed at @a start_idx if there is at least one free block
+ * there, so that it continues the extent that ends at the goal. Otherwise
+ * the first run of @a want free blocks in the group is used. When the whole
+ * group is scanned without success, the longest free extent found is
+ * remembered in the group summary so that the group is not scanned again
+ * for requests it cannot satisfy.
+ *
+ * @param fs        Filesystem
+ * @param bgid      Block group index
+ * @param start_idx Preferred index in group (goal)
+ * @param want      Requested number of blocks
+ * @param fblock    Output value - first allocated block
+ * @param allocated Output value - number of allocated blocks
+ *
+ * @return EOK on success, ENOSPC if the group has no suitable run,
+ *         other error code on failure
+ *
+ */
+static errno_t ext4_balloc_alloc_in_group(ext4_filesystem_t *fs, uint32_t bgid,
+    uint32_t start_idx, uint32_t want, uint32_t *fblock, uint32_t *allocated)
+{
+	ext4_superblock_t *sb = fs->superblock;
+
+	/* Skip groups known not to contain a long enough free extent */
+	if (fs->bg_max_free[bgid] < want)
+		return ENOSPC;
+
+	/* Load block group reference */
+	ext4_block_group_ref_t *bg_ref;
+	errno_t rc = ext4_filesystem_get_block_group_ref(fs, bgid, &bg_ref);
+	if (rc != EOK)
+		return rc;
+
+	uint32_t free_blocks =
+	    ext4_block_group_get_free_blocks_count(bg_ref->block_group, sb);
+	if (free_blocks < want) {
+		/* This group has not enough free blocks */
+		rc = ext4_filesystem_put_block_group_ref(bg_ref);
+		return rc == EOK ? ENOSPC : rc;
+	}
+
+	/* Compute indexes */
+	uint32_t first_in_group =
+	    ext4_balloc_get_first_data_block_in_group(sb, bg_ref);
+	uint32_t first_in_group_index =
+	    ext4_filesystem_blockaddr2_index_in_group(sb, first_in_group);
+	uint32_t blocks_in_group = ext4_superblock_get_blocks_in_group(sb, bgid);
+
+	if (start_idx < first_in_group_index)
+		start_idx = first_in_group_index;
+
+	/* Load block with bitmap */
+	uint32_t bitmap_block_addr =
+	    ext4_block_group_get_block_bitmap(bg_ref->block_group, sb);
+
+	block_t *bitmap_block;
+	rc = block_get(&bitmap_block, fs->device, bitmap_block_addr,
+	    BLOCK_FLAGS_NONE);
+	if (rc != EOK) {
+		ext4_filesystem_put_block_group_ref(bg_ref);
+		return rc;
+	}
+
+	uint32_t run_idx = start_idx;
+	uint32_t run_len = 0;
+
+	/* Extend the extent ending at goal as far as possible */
+	while ((run_len < want) && (start_idx + run_len < blocks_in_group) &&
+	    ext4_bitmap_is_free_bit(bitmap_block->data, start_idx + run_len))
+		run_len++;
+
+	if (run_len == 0) {
+		uint32_t longest = 0;
+
+		/* Find first long enough run after goal */
+		rc = ext4_bitmap_find_free_run(bitmap_block->data, start_idx,
+		    blocks_in_group, want, &run_idx, NULL);
+		if (rc != EOK) {
+			/* Scan the whole group */
+			rc = ext4_bitmap_find_free_run(bitmap_block->data,
+			    first_in_group_index, blocks_in_group, want,
+			    &run_idx, &longest);
+		}
+
+		if (rc != EOK) {
+			/* Remember what the group can offer */
+			fs->bg_max_free[bgid] = longest;
+
+			rc = block_put(bitmap_block);
+			errno_t rc2 = ext4_filesystem_put_block_group_ref(bg_ref);
+			if (rc != EOK)
+				return rc;
+			if (rc2 != EOK)
+				return rc2;
+
+			return ENOSPC;
+		}
+
+		run_len = want;
+	}
+
+	/* Modify bitmap */
+	ext4_bitmap_set_bits(bitmap_block->data, run_idx, run_len);
+	bitmap_block->dirty = true;
+
+	rc = block_put(bitmap_block);
+	if (rc != EOK) {
+		ext4_filesystem_put_block_group_ref(bg_ref);
+		return rc;
+	}
+
+	/* Update superblock free blocks count */
+	uint32_t sb_free_blocks = ext4_superblock_get_free_blocks_count(sb);
+	sb_free_blocks -= run_len;
+	ext4_superblock_set_free_blocks_count(sb, sb_free_blocks);
+
+	/* Update block group free blocks count */
+	free_blocks -= run_len;
+	ext4_block_group_set_free_blocks_count(bg_ref->block_group, sb,
+	    free_blocks);
+	bg_ref->dirty = true;
+
+	*fblock = ext4_filesystem_index_in_group2blockaddr(sb, run_idx, bgid);
+	*allocated = run_len;
+
+	return ext4_filesystem_put_block_group_ref(bg_ref);
+}
+
+/** Allocate a continuous run of blocks.
+ *
+ * Tries to allocate @a count blocks starting at @a goal. If that is not
+ * possible, block groups are searched for a free extent of the requested
+ * length, starting with the goal group. If no group can satisfy the
+ * request, the requested length is halved and the search repeated.
+ * The group summaries make the repeated passes cheap, since groups
+ * without long enough free extents are skipped without touching
+ * their bitmaps.
+ *
+ * Blocks are not accounted to any i-node.
+ *
+ * @param fs        Filesystem
+ * @param goal      Preferred first block
+ * @param count     Requested number of blocks (at least 1)
+ * @param fblock    Output value - first allocated block
+ * @param allocated Output value - number of allocated blocks (1 to count)
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_alloc_blocks(ext4_filesystem_t *fs, uint32_t goal,
+    uint32_t count, uint32_t *fblock, uint32_t *allocated)
+{
+	ext4_superblock_t *sb = fs->superblock;
+	uint32_t block_group_count = ext4_superblock_get_block_group_count(sb);
+	uint32_t goal_group = ext4_filesystem_blockaddr2group(sb, goal);
+	uint32_t goal_index = ext4_filesystem_blockaddr2_index_in_group(sb, goal);
+	uint32_t want = count;
+
+	assert(count > 0);
+
+	if (goal_group >= block_group_count) {
+		goal_group = 0;
+		goal_index = 0;
+	}
+
+	while (true) {
+		uint32_t bgid = goal_group;
+
+		for (uint32_t i = 0; i < block_group_count; i++) {
+			uint32_t start_idx = (bgid == goal_group) ? goal_index : 0;
+
+			errno_t rc = ext4_balloc_alloc_in_group(fs, bgid, start_idx,
+			    want, fblock, allocated);
+			if (rc != ENOSPC)
+				return rc;
+
+			bgid = (bgid + 1) % block_group_count;
+		}
+
+		if (want == 1)
+			return ENOSPC;
+
+		want /= 2;
+	}
+}
+
+/** Find preallocation window of an i-node.
+ *
+ * Preallocation lock must be held.
+ *
+ * @param fs    Filesystem
+ * @param inode I-node number
+ *
+ * @return Preallocation window or NULL if the i-node has none
+ *
+ */
+static ext4_balloc_pa_t *ext4_balloc_find_pa(ext4_filesystem_t *fs,
+    uint32_t inode)
+{
+	assert(fibril_mutex_is_locked(&fs->prealloc_lock));
+
+	list_foreach(fs->prealloc, link, ext4_balloc_pa_t, pa) {
+		if (pa->inode == inode)
+			return pa;
+	}
+
+	return NULL;
+}
+
+/** Return preallocation window to the free pool and destroy it.
+ *
+ * @param fs Filesystem
+ * @param pa Preallocation window (already removed from the list)
+ *
+ * @return Error code
+ *
+ */
+static errno_t ext4_balloc_release_pa(ext4_filesystem_t *fs,
+    ext4_balloc_pa_t *pa)
+{
+	errno_t rc = EOK;
+
+	if (pa->count > 0)
+		rc = ext4_balloc_release_blocks_internal(fs, pa->fblock,
+		    pa->count);
+
+	free(pa);
+	return rc;
+}
+
+/** Allocate data block for sequentially growing i-node.
+ *
+ * The block is taken from the preallocation window of the i-node if
+ * the window continues at @a iblock. Otherwise a new window sized
+ * according to the current length of the file is allocated with
+ * ext4_balloc_alloc_blocks() and its first block is returned.
+ * Sequential writes thus get large extents while touching block
+ * bitmaps only once per window.
+ *
+ * @param inode_ref I-node to allocate block for
+ * @param iblock    Logical block the allocated block will be mapped to
+ * @param fblock    Output value - allocated block address
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_alloc_block_prealloc(ext4_inode_ref_t *inode_ref,
+    uint32_t iblock, uint32_t *fblock)
+{
+	ext4_filesystem_t *fs = inode_ref->fs;
+	ext4_superblock_t *sb = fs->superblock;
+	uint32_t block_size = ext4_superblock_get_block_size(sb);
+	ext4_balloc_pa_t *old_pa = NULL;
+	uint64_t ino_blocks;
+	errno_t rc;
+
+	fibril_mutex_lock(&fs->prealloc_lock);
+
+	ext4_balloc_pa_t *pa = ext4_balloc_find_pa(fs, inode_ref->index);
+	if (pa != NULL && pa->iblock == iblock && pa->count > 0) {
+		/* Serve block from the window */
+		*fblock = pa->fblock;
+		pa->fblock++;
+		pa->iblock++;
+		pa->count--;
+
+		if (pa->count == 0) {
+			list_remove(&pa->link);
+			free(pa);
+		}
+
+		fibril_mutex_unlock(&fs->prealloc_lock);
+		goto success;
+	}
+
+	if (pa != NULL) {
+		/* Access is not sequential, drop the window */
+		list_remove(&pa->link);
+		old_pa = pa;
+	}
+
+	fibril_mutex_unlock(&fs->prealloc_lock);
+
+	if (old_pa != NULL) {
+		rc = ext4_balloc_release_pa(fs, old_pa);
+		if (rc != EOK)
+			return rc;
+	}
+
+	/*
+	 * Size the window according to the size of the file. Directories
+	 * grow rarely and are not closed explicitly, so they do not
+	 * get any window at all.
+	 */
+	uint32_t want = 1;
+	if (ext4_inode_is_type(sb, inode_ref->inode, EXT4_INODE_MODE_FILE)) {
+		want = iblock + 1;
+		if (want < EXT4_BALLOC_PREALLOC_MIN)
+			want = EXT4_BALLOC_PREALLOC_MIN;
+		if (want > EXT4_BALLOC_PREALLOC_MAX)
+			want = EXT4_BALLOC_PREALLOC_MAX;
+	}
+
+	uint32_t goal;
+	rc = ext4_balloc_find_goal(inode_ref, &goal);
+	if (rc != EOK)
+		return rc;
+
+	uint32_t start;
+	uint32_t allocated;
+	rc = ext4_balloc_alloc_blocks(fs, goal, want, &start, &allocated);
+	if (rc != EOK)
+		return rc;
+
+	*fblock = start;
+
+	if (allocated > 1) {
+		pa = malloc(sizeof(ext4_balloc_pa_t));
+		if (pa == NULL) {
+			/* Window is only an optimization, give it back */
+			rc = ext4_balloc_release_blocks_internal(fs, start + 1,
+			    allocated - 1);
+			if (rc != EOK) {
+				ext4_balloc_release_blocks_internal(fs, start, 1);
+				return rc;
+			}
+		} else {
+			link_initialize(&pa->link);
+			pa->inode = inode_ref->index;
+			pa->iblock = iblock + 1;
+			pa->fblock = start + 1;
+			pa->count = allocated - 1;
+
+			fibril_mutex_lock(&fs->prealloc_lock);
+			list_append(&pa->link, &fs->prealloc);
+			fibril_mutex_unlock(&fs->prealloc_lock);
+		}
+	}
+
+success:
+	/* Account the block to the i-node */
+	ino_blocks = ext4_inode_get_blocks_count(sb, inode_ref->inode);
+	ino_blocks += block_size / EXT4_INODE_BLOCK_SIZE;
+	ext4_inode_set_blocks_count(sb, inode_ref->inode, ino_blocks);
+	inode_ref->dirty = true;
+
+	return EOK;
+}
+
+/** Discard preallocation window of an i-node.
+ *
+ * Unused preallocated blocks are returned to the free pool.
+ *
+ * @param fs    Filesystem
+ * @param inode I-node number
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_discard_prealloc(ext4_filesystem_t *fs, uint32_t inode)
+{
+	fibril_mutex_lock(&fs->prealloc_lock);
+
+	ext4_balloc_pa_t *pa = ext4_balloc_find_pa(fs, inode);
+	if (pa != NULL)
+		list_remove(&pa->link);
+
+	fibril_mutex_unlock(&fs->prealloc_lock);
+
+	if (pa == NULL)
+		return EOK;
+
+	return ext4_balloc_release_pa(fs, pa);
+}
+
+/** Discard all preallocation windows.
+ *
+ * @param fs Filesystem
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_discard_all(ext4_filesystem_t *fs)
+{
+	errno_t rc = EOK;
+
+	fibril_mutex_lock(&fs->prealloc_lock);
+
+	while (!list_empty(&fs->prealloc)) {
+		ext4_balloc_pa_t *pa = list_get_instance(
+		    list_first(&fs->prealloc), ext4_balloc_pa_t, link);
+		list_remove(&pa->link);
+
+		errno_t rc2 = ext4_balloc_release_pa(fs, pa);
+		if (rc == EOK)
+			rc = rc2;
+	}
+
+	fibril_mutex_unlock(&fs->prealloc_lock);
+	return rc;
+}
+
+/** Initialize block allocator state of a filesystem.
+ *
+ * @param fs Filesystem
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_init(ext4_filesystem_t *fs)
+{
+	uint32_t block_group_count =
+	    ext4_superblock_get_block_group_count(fs->superblock);
+
+	fs->bg_max_free = calloc(block_group_count, sizeof(uint32_t));
+	if (fs->bg_max_free == NULL)
+		return ENOMEM;
+
+	for (uint32_t i = 0; i < block_group_count; i++)
+		fs->bg_max_free[i] = EXT4_BALLOC_MAX_FREE_UNKNOWN;
+
+	list_initialize(&fs->prealloc);
+	fibril_mutex_initialize(&fs->prealloc_lock);
+
+	fs->bg_free_gen = 0;
+	fibril_mutex_initialize(&fs->summary_lock);
+	fibril_condvar_initialize(&fs->summary_cv);
+	fs->summary_running = false;
+	fs->summary_stop = false;
+	return EOK;
+}
+
+/** Finalize block allocator state of a filesystem.
+ *
+ * Preallocation windows that were not discarded are destroyed
+ * without returning their blocks to the free pool.
+ *
+ * @param fs Filesystem
+ *
+ */
+void ext4_balloc_fini(ext4_filesystem_t *fs)
+{
+	while (!list_empty(&fs->prealloc)) {
+		ext4_balloc_pa_t *pa = list_get_instance(
+		    list_first(&fs->prealloc), ext4_balloc_pa_t, link);
+		list_remove(&pa->link);
+		free(pa);
+	}
+
+	free(fs->bg_max_free);
+	fs->bg_max_free = NULL;
+}
+
+/** Compute free space summary of a block group.
+ *
+ * @param fs   Filesystem
+ * @param bgid Block group index
+ *
+ * @return Error code
+ *
+ */
+static errno_t ext4_balloc_summarize_group(ext4_filesystem_t *fs, uint32_t bgid)
+{
+	ext4_superblock_t *sb = fs->superblock;
+	uint64_t gen = fs->bg_free_gen;
+
+	/*
+	 * Do not initialize uninitialized groups, the summary fibril
+	 * must not write to the device behind the allocator's back.
+	 */
+	ext4_block_group_ref_t *bg_ref;
+	errno_t rc = ext4_filesystem_read_block_group_ref(fs, bgid, &bg_ref);
+	if (rc != EOK)
+		return rc;
+
+	uint32_t longest = 0;
+	uint32_t free_blocks =
+	    ext4_block_group_get_free_blocks_count(bg_ref->block_group, sb);
+
+	if (ext4_block_group_has_flag(bg_ref->block_group,
+	    EXT4_BLOCK_GROUP_BLOCK_UNINIT)) {
+		/*
+		 * The bitmap is not valid yet, all blocks but the metadata
+		 * are free. The free count is an upper bound of the longest
+		 * free extent, which is all the allocator needs.
+		 */
+		longest = free_blocks;
+	} else if (free_blocks > 0) {
+		uint32_t first_in_group =
+		    ext4_balloc_get_first_data_block_in_group(sb, bg_ref);
+		uint32_t first_in_group_index =
+		    ext4_filesystem_blockaddr2_index_in_group(sb, first_in_group);
+		uint32_t blocks_in_group =
+		    ext4_superblock_get_blocks_in_group(sb, bgid);
+
+		uint32_t bitmap_block_addr =
+		    ext4_block_group_get_block_bitmap(bg_ref->block_group, sb);
+
+		block_t *bitmap_block;
+		rc = block_get(&bitmap_block, fs->device, bitmap_block_addr,
+		    BLOCK_FLAGS_NONE);
+		if (rc != EOK) {
+			ext4_filesystem_put_block_group_ref(bg_ref);
+			return rc;
+		}
+
+		/* Look for a run that cannot exist to scan the whole group */
+		uint32_t idx;
+		(void) ext4_bitmap_find_free_run(bitmap_block->data,
+		    first_in_group_index, blocks_in_group, UINT32_MAX, &idx,
+		    &longest);
+
+		rc = block_put(bitmap_block);
+		if (rc != EOK) {
+			ext4_filesystem_put_block_group_ref(bg_ref);
+			return rc;
+		}
+	}
+
+	rc = ext4_filesystem_put_block_group_ref(bg_ref);
+	if (rc != EOK)
+		return rc;
+
+	/*
+	 * Blocks freed while we were waiting for I/O may have made a longer
+	 * extent. Allocations can only make the result a looser bound.
+	 */
+	if (gen == fs->bg_free_gen)
+		fs->bg_max_free[bgid] = longest;
+
+	return EOK;
+}
+
+/** Free space summary fibril.
+ *
+ * Walks all block groups in the background and computes the longest free
+ * extent of each, so that the allocator knows which groups to skip
+ * without reading their bitmaps first. Mounting does not need to wait
+ * for this.
+ *
+ * @param arg Filesystem
+ *
+ * @return Error code
+ *
+ */
+static errno_t ext4_balloc_summary_fibril(void *arg)
+{
+	ext4_filesystem_t *fs = (ext4_filesystem_t *) arg;
+	uint32_t block_group_count =
+	    ext4_superblock_get_block_group_count(fs->superblock);
+	errno_t rc = EOK;
+
+	for (uint32_t bgid = 0; bgid < block_group_count; bgid++) {
+		fibril_mutex_lock(&fs->summary_lock);
+		bool stop = fs->summary_stop;
+		fibril_mutex_unlock(&fs->summary_lock);
+
+		if (stop)
+			break;
+
+		/* Groups already scanned by the allocator are up to date */
+		if (fs->bg_max_free[bgid] == EXT4_BALLOC_MAX_FREE_UNKNOWN) {
+			/*
+			 * On failure, leave the remaining groups to be
+			 * summarized by the allocator as it scans them.
+			 */
+			rc = ext4_balloc_summarize_group(fs, bgid);
+			if (rc != EOK)
+				break;
+		}
+
+		/* Let requests from clients proceed */
+		fibril_yield();
+	}
+
+	fibril_mutex_lock(&fs->summary_lock);
+	fs->summary_running = false;
+	fibril_condvar_broadcast(&fs->summary_cv);
+	fibril_mutex_unlock(&fs->summary_lock);
+
+	return rc;
+}
+
+/** Start computing free space summaries in the background.
+ *
+ * Failure to start is not an error, summaries are then computed
+ * by the allocator as it scans the groups.
+ *
+ * @param fs Filesystem
+ *
+ */
+void ext4_balloc_summary_start(ext4_filesystem_t *fs)
+{
+	fid_t fid = fibril_create(ext4_balloc_summary_fibril, fs);
+	if (fid == 0)
+		return;
+
+	fibril_mutex_lock(&fs->summary_lock);
+	fs->summary_stop = false;
+	fs->summary_running = true;
+	fibril_mutex_unlock(&fs->summary_lock);
+
+	fibril_add_ready(fid);
+}
+
+/** Stop computing free space summaries.
+ *
+ * Waits for the summary fibril to terminate.
+ *
+ * @param fs Filesystem
+ *
+ */
+void ext4_balloc_summary_stop(ext4_filesystem_t *fs)
+{
+	fibril_mutex_lock(&fs->summary_lock);
+
+	fs->summary_stop = true;
+	while (fs->summary_running)
+		fibril_condvar_wait(&fs->summary_cv, &fs->summary_lock);
+
+	fibril_mutex_unlock(&fs->summary_lock);
+}
+
 /** Try to allocate concrete block.
  *
  * @param inode_ref Inode to allocate block for
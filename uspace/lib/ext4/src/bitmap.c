@@ -134,6 +134,45 @@ void ext4_bitmap_set_bit(uint8_t *bitmap, uint32_t index)
 	*target |= 1 << bit_index;
 }
 
+/** Set continuous set of bits (set to 1).
+ *
+ * Index and count must be checked by caller, if they aren't out of bounds.
+ *
+ * @param bitmap Pointer to bitmap
+ * @param index  Index of first bit to set
+ * @param count  Number of bits to be set
+ *
+ */
+void ext4_bitmap_set_bits(uint8_t *bitmap, uint32_t index, uint32_t count)
+{
+	uint32_t idx = index;
+	uint32_t remaining = count;
+
+	/* Align index to multiple of 8 */
+	while (((idx % 8) != 0) && (remaining > 0)) {
+		ext4_bitmap_set_bit(bitmap, idx);
+		idx++;
+		remaining--;
+	}
+
+	/* Set the whole bytes */
+	uint8_t *target = bitmap + (idx / 8);
+	while (remaining >= 8) {
+		*target = 255;
+
+		idx += 8;
+		remaining -= 8;
+		target++;
+	}
+
+	/* Set remaining bits */
+	while (remaining != 0) {
+		ext4_bitmap_set_bit(bitmap, idx);
+		idx++;
+		remaining--;
+	}
+}
+
 /** Check if requested bit is free.
  *
  * @param bitmap Pointer to bitmap
@@ -264,6 +303,76 @@ errno_t ext4_bitmap_find_free_bit_and_set(uint8_t *bitmap, uint32_t start_idx,
 	return ENOSPC;
 }
 
+/** Try to find a run of free bits.
+ *
+ * Walk through bitmap and find the first run of at least @a want
+ * free bits. Whole free or used bytes are skipped at once. Bits
+ * are not modified.
+ *
+ * @param bitmap  Pointer to bitmap
+ * @param start   Index of bit, where the algorithm will begin
+ * @param max     Maximum index of bit in bitmap
+ * @param want    Required length of the run
+ * @param index   Output value - index of the first bit of the run
+ * @param longest Output value - length of the longest run seen (can be NULL)
+ *
+ * @return EOK if the run was found, ENOSPC otherwise
+ *
+ */
+errno_t ext4_bitmap_find_free_run(uint8_t *bitmap, uint32_t start,
+    uint32_t max, uint32_t want, uint32_t *index, uint32_t *longest)
+{
+	uint32_t idx = start;
+	uint32_t run_start = start;
+	uint32_t run_len = 0;
+	uint32_t best = 0;
+
+	while (idx < max) {
+		uint8_t byte = bitmap[idx / 8];
+
+		if (((idx % 8) == 0) && (idx + 8 <= max) &&
+		    ((byte == 0) || (byte == 255))) {
+			if (byte == 255) {
+				/* Whole byte is used */
+				run_len = 0;
+			} else {
+				/* Whole byte is free */
+				if (run_len == 0)
+					run_start = idx;
+				run_len += 8;
+			}
+
+			idx += 8;
+		} else {
+			if ((byte & (1 << (idx % 8))) == 0) {
+				if (run_len == 0)
+					run_start = idx;
+				run_len++;
+			} else {
+				run_len = 0;
+			}
+
+			idx++;
+		}
+
+		if (run_len > best)
+			best = run_len;
+
+		if (run_len >= want) {
+			*index = run_start;
+			if (longest != NULL)
+				*longest = best;
+			return EOK;
+		}
+	}
+
+	if (longest != NULL)
+		*longest = best;
+
+	/* Run not found */
+	return ENOSPC;
+}
+
 /**
  * @}
  */
@@ -445,6 +445,26 @@ errno_t ext4_directory_add_entry(ext4_inode_ref_t *parent, const char *name,
 			return EOK;
 	}
 
+	/* Convert directory to indexed once it outgrows the first block */
+	if ((ext4_superblock_has_feature_compatible(fs->superblock,
+	    EXT4_FEATURE_COMPAT_DIR_INDEX)) && (total_blocks == 1) &&
+	    (!ext4_inode_has_flag(parent->inode, EXT4_INODE_FLAG_INDEX))) {
+		errno_t rc = ext4_directory_dx_init(parent);
+		if (rc == EOK) {
+			ext4_inode_set_flag(parent->inode, EXT4_INODE_FLAG_INDEX);
+			parent->dirty = true;
+
+			return ext4_directory_dx_add_entry(parent, child, name);
+		}
+
+		/*
+		 * Directory with unexpected layout or a corrupted first
+		 * block stays linear
+		 */
+		if ((rc != ENOTSUP) && (rc != EXT4_ERR_BAD_DX_DIR))
+			return rc;
+	}
+
 	/* No free block found - needed to allocate next data block */
 
 	iblock = 0;
@@ -228,15 +228,29 @@ void ext4_directory_dx_entry_set_block(ext4_directory_dx_entry_t *entry,
 	entry->block = host2uint32_t_le(block);
 }
 
-/** Initialize index structure of new directory.
+/** Convert linear directory to indexed directory.
+ *
+ * The directory must consist of a single block starting with '.' and '..'
+ * entries. All other entries are moved to a newly appended leaf block
+ * and the first block is turned into index root pointing to the leaf.
+ * The '..' entry is extended over the index root, so the first block
+ * remains a valid linear directory block.
  *
  * @param dir Pointer to directory i-node
  *
- * @return Error code
+ * @return EOK on success, ENOTSUP if the directory does not have the
+ *         expected layout, EXT4_ERR_BAD_DX_DIR if its entries are
+ *         corrupted, other error code on failure
  *
  */
 errno_t ext4_directory_dx_init(ext4_inode_ref_t *dir)
 {
+	ext4_superblock_t *sb = dir->fs->superblock;
+	uint32_t block_size = ext4_superblock_get_block_size(sb);
+
+	if (ext4_inode_get_size(sb, dir->inode) != block_size)
+		return ENOTSUP;
+
 	/* Load block 0, where will be index root located */
 	uint32_t fblock;
 	errno_t rc = ext4_filesystem_get_inode_data_block_index(dir, 0,
@@ -249,50 +263,87 @@ errno_t ext4_directory_dx_init(ext4_inode_ref_t *dir)
 	if (rc != EOK)
 		return rc;
 
-	/* Initialize pointers to data structures */
-	ext4_directory_dx_root_t *root = block->data;
-	ext4_directory_dx_root_info_t *info = &(root->info);
+	/* Check '.' and '..' entries */
+	ext4_directory_entry_ll_t *dot = block->data;
+	ext4_directory_entry_ll_t *dotdot = block->data +
+	    sizeof(ext4_directory_dx_dot_entry_t);
+	uint16_t dotdot_len = ext4_directory_entry_ll_get_entry_length(dotdot);
+
+	if ((ext4_directory_entry_ll_get_entry_length(dot) !=
+	    sizeof(ext4_directory_dx_dot_entry_t)) ||
+	    (ext4_directory_entry_ll_get_name_length(sb, dot) != 1) ||
+	    (dot->name[0] != '.') ||
+	    (ext4_directory_entry_ll_get_name_length(sb, dotdot) != 2) ||
+	    (dotdot->name[0] != '.') || (dotdot->name[1] != '.') ||
+	    (dotdot_len < sizeof(ext4_directory_dx_dot_entry_t)) ||
+	    (sizeof(ext4_directory_dx_dot_entry_t) + dotdot_len > block_size)) {
+		block_put(block);
+		return ENOTSUP;
+	}
 
-	/* Initialize root info structure */
-	uint8_t hash_version =
-	    ext4_superblock_get_default_hash_version(dir->fs->superblock);
+	/* Entries following '..' will be moved to the leaf */
+	uint32_t entries_offset = sizeof(ext4_directory_dx_dot_entry_t) +
+	    dotdot_len;
+	uint32_t entries_size = block_size - entries_offset;
 
-	ext4_directory_dx_root_info_set_hash_version(info, hash_version);
-	ext4_directory_dx_root_info_set_indirect_levels(info, 0);
-	ext4_directory_dx_root_info_set_info_length(info, 8);
+	/*
+	 * Find the last entry, which will be extended to the end of the leaf.
+	 * Do this before allocating the leaf so that a corrupted block does
+	 * not leave it allocated.
+	 */
+	uint32_t last_offset = 0;
+	if (entries_size > 0) {
+		while (true) {
+			ext4_directory_entry_ll_t *entry = block->data +
+			    entries_offset + last_offset;
+			uint16_t len = ext4_directory_entry_ll_get_entry_length(entry);
+			if (len == 0 || last_offset + len > entries_size) {
+				/* Corrupted directory block */
+				block_put(block);
+				return EXT4_ERR_BAD_DX_DIR;
+			}
 
-	/* Set limit and current number of entries */
-	ext4_directory_dx_countlimit_t *countlimit =
-	    (ext4_directory_dx_countlimit_t *) &root->entries;
-	ext4_directory_dx_countlimit_set_count(countlimit, 1);
+			if (last_offset + len == entries_size)
+				break;
 
-	uint32_t block_size =
-	    ext4_superblock_get_block_size(dir->fs->superblock);
-	uint32_t entry_space =
-	    block_size - 2 * sizeof(ext4_directory_dx_dot_entry_t) -
-	    sizeof(ext4_directory_dx_root_info_t);
-	uint16_t root_limit = entry_space / sizeof(ext4_directory_dx_entry_t);
-	ext4_directory_dx_countlimit_set_limit(countlimit, root_limit);
+			last_offset += len;
+		}
+	}
 
-	/* Append new block, where will be new entries inserted in the future */
+	/* Append new block, where will be the entries stored */
 	uint32_t iblock;
-	rc = ext4_filesystem_append_inode_block(dir, &fblock, &iblock);
+	uint32_t leaf_fblock;
+	rc = ext4_filesystem_append_inode_block(dir, &leaf_fblock, &iblock);
 	if (rc != EOK) {
 		block_put(block);
 		return rc;
 	}
 
 	block_t *new_block;
-	rc = block_get(&new_block, dir->fs->device, fblock, BLOCK_FLAGS_NOREAD);
+	rc = block_get(&new_block, dir->fs->device, leaf_fblock,
+	    BLOCK_FLAGS_NOREAD);
 	if (rc != EOK) {
 		block_put(block);
 		return rc;
 	}
 
-	/* Fill the whole block with empty entry */
-	ext4_directory_entry_ll_t *block_entry = new_block->data;
-	ext4_directory_entry_ll_set_entry_length(block_entry, block_size);
-	ext4_directory_entry_ll_set_inode(block_entry, 0);
+	memset(new_block->data, 0, block_size);
+
+	if (entries_size > 0) {
+		memcpy(new_block->data, block->data + entries_offset,
+		    entries_size);
+
+		/* Extend the last entry to the end of the block */
+		ext4_directory_entry_ll_t *entry = new_block->data + last_offset;
+		uint16_t len = ext4_directory_entry_ll_get_entry_length(entry);
+		ext4_directory_entry_ll_set_entry_length(entry,
+		    len + block_size - entries_size);
+	} else {
+		/* Fill the whole block with empty entry */
+		ext4_directory_entry_ll_t *block_entry = new_block->data;
+		ext4_directory_entry_ll_set_entry_length(block_entry, block_size);
+		ext4_directory_entry_ll_set_inode(block_entry, 0);
+	}
 
 	new_block->dirty = true;
 	rc = block_put(new_block);
@@ -301,7 +352,34 @@ errno_t ext4_directory_dx_init(ext4_inode_ref_t *dir)
 		return rc;
 	}
 
-	/* Connect new block to the only entry in index */
+	/* Let '..' cover the rest of the root block */
+	ext4_directory_entry_ll_set_entry_length(dotdot,
+	    block_size - sizeof(ext4_directory_dx_dot_entry_t));
+
+	/* Initialize pointers to data structures */
+	ext4_directory_dx_root_t *root = block->data;
+	ext4_directory_dx_root_info_t *info = &(root->info);
+
+	/* Initialize root info structure */
+	uint8_t hash_version = ext4_superblock_get_default_hash_version(sb);
+
+	memset(info, 0, sizeof(ext4_directory_dx_root_info_t));
+	ext4_directory_dx_root_info_set_hash_version(info, hash_version);
+	ext4_directory_dx_root_info_set_indirect_levels(info, 0);
+	ext4_directory_dx_root_info_set_info_length(info, 8);
+
+	/* Set limit and current number of entries */
+	ext4_directory_dx_countlimit_t *countlimit =
+	    (ext4_directory_dx_countlimit_t *) &root->entries;
+	ext4_directory_dx_countlimit_set_count(countlimit, 1);
+
+	uint32_t entry_space =
+	    block_size - 2 * sizeof(ext4_directory_dx_dot_entry_t) -
+	    sizeof(ext4_directory_dx_root_info_t);
+	uint16_t root_limit = entry_space / sizeof(ext4_directory_dx_entry_t);
+	ext4_directory_dx_countlimit_set_limit(countlimit, root_limit);
+
+	/* Connect the leaf to the only entry in index */
 	ext4_directory_dx_entry_t *entry = root->entries;
 	ext4_directory_dx_entry_set_block(entry, iblock);
 
@@ -831,6 +909,12 @@ static errno_t ext4_directory_dx_split_data(ext4_inode_ref_t *inode_ref,
 		current_size += sort_array[i].rec_len;
 	}
 
+	/* Keep at least one entry in the old block */
+	if (mid == 0 && idx > 1) {
+		mid = 1;
+		new_hash = sort_array[1].hash;
+	}
+
 	/* Check hash collision */
 	uint32_t continued = 0;
 	if (new_hash == sort_array[mid - 1].hash)
@@ -40,6 +40,7 @@
 #include <stdlib.h>
 #include "ext4/balloc.h"
 #include "ext4/extent.h"
+#include "ext4/extent_status.h"
 #include "ext4/inode.h"
 #include "ext4/superblock.h"
 
@@ -373,20 +374,57 @@ static void ext4_extent_binsearch(ext4_extent_header_t *header,
  */
 errno_t ext4_extent_find_block(ext4_inode_ref_t *inode_ref, uint32_t iblock,
     uint32_t *fblock)
+{
+	uint32_t count;
+
+	return ext4_extent_find_block_range(inode_ref, iblock, fblock, &count);
+}
+
+/** Find range of physical blocks in the extent tree.
+ *
+ * Ranges found in the tree are remembered in the extent status cache,
+ * so that the tree does not need to be walked again for the following
+ * blocks of the same extent.
+ *
+ * @param inode_ref I-node to load block from
+ * @param iblock    Logical block number to find
+ * @param fblock    Output value for physical block number (0 for hole)
+ * @param count     Output value for number of following logical blocks
+ *                  (including @a iblock) mapped to following physical
+ *                  blocks, limited by size of the i-node
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_extent_find_block_range(ext4_inode_ref_t *inode_ref,
+    uint32_t iblock, uint32_t *fblock, uint32_t *count)
 {
 	errno_t rc = EOK;
+	ext4_filesystem_t *fs = inode_ref->fs;
+
 	/* Compute bound defined by i-node size */
 	uint64_t inode_size =
-	    ext4_inode_get_size(inode_ref->fs->superblock, inode_ref->inode);
+	    ext4_inode_get_size(fs->superblock, inode_ref->inode);
 
 	uint32_t block_size =
-	    ext4_superblock_get_block_size(inode_ref->fs->superblock);
+	    ext4_superblock_get_block_size(fs->superblock);
 
 	uint32_t last_idx = (inode_size - 1) / block_size;
 
 	/* Check if requested iblock is not over size of i-node */
 	if (iblock > last_idx) {
 		*fblock = 0;
+		*count = 1;
+		return EOK;
+	}
+
+	/* Try extent status cache first */
+	uint32_t cached_fblock;
+	uint32_t cached_count;
+	if (ext4_es_lookup(fs, inode_ref->index, iblock, &cached_fblock,
+	    &cached_count)) {
+		*fblock = cached_fblock;
+		*count = min(cached_count, last_idx - iblock + 1);
 		return EOK;
 	}
 
@@ -410,8 +448,7 @@ errno_t ext4_extent_find_block(ext4_inode_ref_t *inode_ref, uint32_t iblock,
 				return rc;
 		}
 
-		rc = block_get(&block, inode_ref->fs->device, child,
-		    BLOCK_FLAGS_NONE);
+		rc = block_get(&block, fs->device, child, BLOCK_FLAGS_NONE);
 		if (rc != EOK)
 			return rc;
 
@@ -422,16 +459,23 @@ errno_t ext4_extent_find_block(ext4_inode_ref_t *inode_ref, uint32_t iblock,
 	ext4_extent_t *extent = NULL;
 	ext4_extent_binsearch(header, &extent, iblock);
 
+	*fblock = 0;
+	*count = 1;
+
 	/* Prevent empty leaf */
-	if (extent == NULL) {
-		*fblock = 0;
-	} else {
-		/* Compute requested physical block address */
-		uint32_t phys_block;
+	if (extent != NULL) {
 		uint32_t first = ext4_extent_get_first_block(extent);
-		phys_block = ext4_extent_get_start(extent) + iblock - first;
+		uint32_t length = ext4_extent_get_block_count(extent);
+		uint32_t start = ext4_extent_get_start(extent);
+
+		/* Binary search returns nearest extent, check it covers iblock */
+		if (iblock - first < length) {
+			ext4_es_insert(fs, inode_ref->index, first, start, length);
 
-		*fblock = phys_block;
+			/* Compute requested physical block address */
+			*fblock = start + iblock - first;
+			*count = min(first + length - iblock, last_idx - iblock + 1);
+		}
 	}
 
 	/* Cleanup */
@@ -619,6 +663,9 @@ static errno_t ext4_extent_release_branch(ext4_inode_ref_t *inode_ref,
 errno_t ext4_extent_release_blocks_from(ext4_inode_ref_t *inode_ref,
     uint32_t iblock_from)
 {
+	/* Cached mappings of the released blocks become invalid */
+	ext4_es_invalidate(inode_ref->fs, inode_ref->index);
+
 	/* Find the first extent to modify */
 	ext4_extent_path_t *path;
 	errno_t rc2;
@@ -954,6 +1001,10 @@ static errno_t ext4_extent_append_extent(ext4_inode_ref_t *inode_ref,
  * to some existing extent or creates new extents.
  * It includes possible extent tree modifications (splitting).
  *
+ * Blocks are taken from the preallocation window of the i-node,
+ * so that a sequentially growing file keeps extending its last
+ * extent instead of creating new ones.
+ *
  * @param inode_ref I-node to append block to
  * @param iblock    Output logical number of newly allocated block
  * @param fblock    Output physical block address of newly allocated block
@@ -989,6 +1040,14 @@ errno_t ext4_extent_append_block(ext4_inode_ref_t *inode_ref, uint32_t *iblock,
 	while (path_ptr->depth != 0)
 		path_ptr++;
 
+	uint32_t phys_block = 0;
+
+	/* Allocate new data block */
+	rc = ext4_balloc_alloc_block_prealloc(inode_ref, new_block_idx,
+	    &phys_block);
+	if (rc != EOK)
+		goto finish;
+
 	/* Add new extent to the node if not present */
 	if (path_ptr->extent == NULL)
 		goto append_extent;
@@ -996,14 +1055,10 @@ errno_t ext4_extent_append_block(ext4_inode_ref_t *inode_ref, uint32_t *iblock,
 	uint16_t block_count = ext4_extent_get_block_count(path_ptr->extent);
 	uint16_t block_limit = (1 << 15);
 
-	uint32_t phys_block = 0;
 	if (block_count < block_limit) {
 		/* There is space for new block in the extent */
 		if (block_count == 0) {
 			/* Existing extent is empty */
-			rc = ext4_balloc_alloc_block(inode_ref, &phys_block);
-			if (rc != EOK)
-				goto finish;
 
 			/* Initialize extent */
 			ext4_extent_set_first_block(path_ptr->extent, new_block_idx);
@@ -1021,17 +1076,13 @@ errno_t ext4_extent_append_block(ext4_inode_ref_t *inode_ref, uint32_t *iblock,
 			goto finish;
 		} else {
 			/* Existing extent contains some blocks */
-			phys_block = ext4_extent_get_start(path_ptr->extent);
-			phys_block += ext4_extent_get_block_count(path_ptr->extent);
-
-			/* Check if the following block is free for allocation */
-			bool free;
-			rc = ext4_balloc_try_alloc_block(inode_ref, phys_block, &free);
-			if (rc != EOK)
-				goto finish;
+			uint64_t next_block = ext4_extent_get_start(path_ptr->extent) +
+			    block_count;
+			uint32_t next_iblock =
+			    ext4_extent_get_first_block(path_ptr->extent) + block_count;
 
-			if (!free) {
-				/* Target is not free, new block must be appended to new extent */
+			if (phys_block != next_block || new_block_idx != next_iblock) {
+				/* New block must be appended to new extent */
 				goto append_extent;
 			}
 
@@ -1051,14 +1102,6 @@ errno_t ext4_extent_append_block(ext4_inode_ref_t *inode_ref, uint32_t *iblock,
 	}
 
 append_extent:
-	/* Append new extent to the tree */
-	phys_block = 0;
-
-	/* Allocate new data block */
-	rc = ext4_balloc_alloc_block(inode_ref, &phys_block);
-	if (rc != EOK)
-		goto finish;
-
 	/* Append extent for new block (includes tree splitting if needed) */
 	rc = ext4_extent_append_extent(inode_ref, path, new_block_idx);
 	if (rc != EOK) {
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libext4
+ * @{
+ */
+/**
+ * @file  extent_status.c
+ * @brief Cache of mapped extents.
+ *
+ * For every recently used i-node, the cache remembers a few ranges of
+ * logical blocks together with the physical blocks they are mapped to.
+ * Ranges of an i-node are kept sorted by logical block, so that they can
+ * be binary searched. Looking up a block of a cached range does not need
+ * to walk the extent tree, which would otherwise load index blocks
+ * through libblock for every single block of the file.
+ *
+ * Mapping of a logical block never changes while the block stays
+ * allocated, so the cache only needs to be invalidated when blocks
+ * are released from the i-node.
+ */
+
+#include <adt/hash.h>
+#include <adt/hash_table.h>
+#include <adt/list.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <mem.h>
+#include <stdlib.h>
+#include "ext4/extent_status.h"
+
+/** Extent status of one i-node */
+typedef struct {
+	/** Link to ext4_filesystem_t.es_inodes */
+	ht_link_t link;
+	/** Link to ext4_filesystem_t.es_lru */
+	link_t lru_link;
+	/** I-node number */
+	uint32_t inode;
+	/** Number of valid entries */
+	size_t count;
+	/** Cached ranges sorted by logical block */
+	ext4_es_range_t ranges[EXT4_ES_INODE_RANGES];
+} ext4_es_inode_t;
+
+static size_t ext4_es_key_hash(const void *key_arg)
+{
+	const uint32_t *inode = key_arg;
+	return hash_mix32(*inode);
+}
+
+static size_t ext4_es_hash(const ht_link_t *item)
+{
+	ext4_es_inode_t *es = hash_table_get_inst(item, ext4_es_inode_t, link);
+	return hash_mix32(es->inode);
+}
+
+static bool ext4_es_key_equal(const void *key_arg, const ht_link_t *item)
+{
+	const uint32_t *inode = key_arg;
+	ext4_es_inode_t *es = hash_table_get_inst(item, ext4_es_inode_t, link);
+
+	return *inode == es->inode;
+}
+
+static void ext4_es_remove_callback(ht_link_t *item)
+{
+	ext4_es_inode_t *es = hash_table_get_inst(item, ext4_es_inode_t, link);
+
+	list_remove(&es->lru_link);
+	free(es);
+}
+
+static const hash_table_ops_t ext4_es_ops = {
+	.hash = ext4_es_hash,
+	.key_hash = ext4_es_key_hash,
+	.key_equal = ext4_es_key_equal,
+	.equal = NULL,
+	.remove_callback = ext4_es_remove_callback
+};
+
+/** Initialize extent status cache of a filesystem.
+ *
+ * @param fs Filesystem
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_es_init(ext4_filesystem_t *fs)
+{
+	if (!hash_table_create(&fs->es_inodes, 0, 0, &ext4_es_ops))
+		return ENOMEM;
+
+	list_initialize(&fs->es_lru);
+	fs->es_count = 0;
+	fibril_mutex_initialize(&fs->es_lock);
+	return EOK;
+}
+
+/** Finalize extent status cache of a filesystem.
+ *
+ * @param fs Filesystem
+ *
+ */
+void ext4_es_fini(ext4_filesystem_t *fs)
+{
+	hash_table_destroy(&fs->es_inodes);
+	fs->es_count = 0;
+}
+
+/** Find extent status of an i-node.
+ *
+ * Cache lock must be held.
+ *
+ * @param fs    Filesystem
+ * @param inode I-node number
+ *
+ * @return Extent status or NULL if not cached
+ *
+ */
+static ext4_es_inode_t *ext4_es_find(ext4_filesystem_t *fs, uint32_t inode)
+{
+	assert(fibril_mutex_is_locked(&fs->es_lock));
+
+	ht_link_t *link = hash_table_find(&fs->es_inodes, &inode);
+	if (link == NULL)
+		return NULL;
+
+	return hash_table_get_inst(link, ext4_es_inode_t, link);
+}
+
+/** Find index of the last range starting at or before logical block.
+ *
+ * @param es     Extent status of the i-node
+ * @param iblock Logical block
+ *
+ * @return Index of the range or es->count if there is no such range
+ *
+ */
+static size_t ext4_es_search(ext4_es_inode_t *es, uint32_t iblock)
+{
+	size_t l = 0;
+	size_t r = es->count;
+
+	/* Find first range starting after iblock */
+	while (l < r) {
+		size_t m = l + (r - l) / 2;
+		if (es->ranges[m].iblock <= iblock)
+			l = m + 1;
+		else
+			r = m;
+	}
+
+	return l > 0 ? l - 1 : es->count;
+}
+
+/** Look up logical block in the cache.
+ *
+ * @param fs     Filesystem
+ * @param inode  I-node number
+ * @param iblock Logical block to look up
+ * @param fblock Output value - physical block
+ * @param count  Output value - number of consecutive logical blocks
+ *               starting with @a iblock mapped to consecutive
+ *               physical blocks
+ *
+ * @return True if the block was found in the cache
+ *
+ */
+bool ext4_es_lookup(ext4_filesystem_t *fs, uint32_t inode, uint32_t iblock,
+    uint32_t *fblock, uint32_t *count)
+{
+	bool found = false;
+
+	fibril_mutex_lock(&fs->es_lock);
+
+	ext4_es_inode_t *es = ext4_es_find(fs, inode);
+	if (es != NULL) {
+		size_t i = ext4_es_search(es, iblock);
+		if (i < es->count &&
+		    iblock - es->ranges[i].iblock < es->ranges[i].count) {
+			uint32_t offset = iblock - es->ranges[i].iblock;
+
+			*fblock = es->ranges[i].fblock + offset;
+			*count = es->ranges[i].count - offset;
+			found = true;
+		}
+
+		/* Move to the front of LRU */
+		list_remove(&es->lru_link);
+		list_prepend(&es->lru_link, &fs->es_lru);
+	}
+
+	fibril_mutex_unlock(&fs->es_lock);
+	return found;
+}
+
+/** Insert mapped range into the cache.
+ *
+ * The range replaces any cached ranges it overlaps. If the i-node
+ * has too many ranges cached, the one farthest from the new range
+ * is dropped. If too many i-nodes are cached, the least recently
+ * used one is dropped. Failure to allocate memory is not an error,
+ * the range is simply not cached.
+ *
+ * @param fs     Filesystem
+ * @param inode  I-node number
+ * @param iblock First logical block of the range
+ * @param fblock First physical block of the range
+ * @param count  Number of blocks in the range
+ *
+ */
+void ext4_es_insert(ext4_filesystem_t *fs, uint32_t inode, uint32_t iblock,
+    uint32_t fblock, uint32_t count)
+{
+	if (count == 0)
+		return;
+
+	fibril_mutex_lock(&fs->es_lock);
+
+	ext4_es_inode_t *es = ext4_es_find(fs, inode);
+	if (es == NULL) {
+		if (fs->es_count >= EXT4_ES_MAX_INODES) {
+			/* Evict least recently used i-node */
+			ext4_es_inode_t *old = list_get_instance(
+			    list_last(&fs->es_lru), ext4_es_inode_t, lru_link);
+			hash_table_remove_item(&fs->es_inodes, &old->link);
+			fs->es_count--;
+		}
+
+		es = calloc(1, sizeof(ext4_es_inode_t));
+		if (es == NULL) {
+			fibril_mutex_unlock(&fs->es_lock);
+			return;
+		}
+
+		es->inode = inode;
+		link_initialize(&es->lru_link);
+		hash_table_insert(&fs->es_inodes, &es->link);
+		list_prepend(&es->lru_link, &fs->es_lru);
+		fs->es_count++;
+	}
+
+	/* Drop ranges overlapping the new one */
+	size_t i = 0;
+	while (i < es->count) {
+		ext4_es_range_t *r = &es->ranges[i];
+		if (r->iblock < iblock + count && iblock < r->iblock + r->count) {
+			memmove(r, r + 1,
+			    (es->count - i - 1) * sizeof(ext4_es_range_t));
+			es->count--;
+		} else {
+			i++;
+		}
+	}
+
+	if (es->count == EXT4_ES_INODE_RANGES) {
+		/* Drop the range at the farther end */
+		if (iblock < es->ranges[0].iblock) {
+			es->count--;
+		} else {
+			memmove(&es->ranges[0], &es->ranges[1],
+			    (es->count - 1) * sizeof(ext4_es_range_t));
+			es->count--;
+		}
+	}
+
+	/* Insert keeping the ranges sorted */
+	i = 0;
+	while (i < es->count && es->ranges[i].iblock < iblock)
+		i++;
+
+	memmove(&es->ranges[i + 1], &es->ranges[i],
+	    (es->count - i) * sizeof(ext4_es_range_t));
+	es->ranges[i].iblock = iblock;
+	es->ranges[i].fblock = fblock;
+	es->ranges[i].count = count;
+	es->count++;
+
+	fibril_mutex_unlock(&fs->es_lock);
+}
+
+/** Forget all cached ranges of an i-node.
+ *
+ * Must be called whenever blocks are released from the i-node.
+ *
+ * @param fs    Filesystem
+ * @param inode I-node number
+ *
+ */
+void ext4_es_invalidate(ext4_filesystem_t *fs, uint32_t inode)
+{
+	fibril_mutex_lock(&fs->es_lock);
+
+	ext4_es_inode_t *es = ext4_es_find(fs, inode);
+	if (es != NULL) {
+		hash_table_remove_item(&fs->es_inodes, &es->link);
+		fs->es_count--;
+	}
+
+	fibril_mutex_unlock(&fs->es_lock);
+}
+
+/**
+ * @}
+ */
@@ -50,6 +50,7 @@
 #include "ext4/cfg.h"
 #include "ext4/directory.h"
 #include "ext4/extent.h"
+#include "ext4/extent_status.h"
 #include "ext4/filesystem.h"
 #include "ext4/ialloc.h"
 #include "ext4/inode.h"
@@ -137,7 +138,19 @@ static errno_t ext4_filesystem_init(ext4_filesystem_t *fs, service_id_t service_
 	if (rc != EOK)
 		goto err_2;
 
+	/* Initialize block allocator */
+	rc = ext4_balloc_init(fs);
+	if (rc != EOK)
+		goto err_2;
+
+	/* Initialize extent status cache */
+	rc = ext4_es_init(fs);
+	if (rc != EOK)
+		goto err_3;
+
 	return EOK;
+err_3:
+	ext4_balloc_fini(fs);
 err_2:
 	block_cache_fini(fs->device);
 err_1:
@@ -155,6 +168,10 @@ err:
  */
 static void ext4_filesystem_fini(ext4_filesystem_t *fs)
 {
+	/* Finalize extent status cache and block allocator */
+	ext4_es_fini(fs);
+	ext4_balloc_fini(fs);
+
 	/* Release memory space for superblock */
 	free(fs->superblock);
 
@@ -348,6 +365,11 @@ errno_t ext4_filesystem_create(ext4_cfg_t *cfg, service_id_t service_id)
 	if (rc != EOK)
 		goto err;
 
+	/* Return preallocated blocks to the free pool */
+	rc = ext4_balloc_discard_all(fs);
+	if (rc != EOK)
+		goto err;
+
 	/* Write superblock to device */
 	rc = ext4_superblock_write_direct(service_id, fs->superblock);
 	if (rc != EOK)
@@ -459,6 +481,10 @@ errno_t ext4_filesystem_open(ext4_instance_t *inst, service_id_t service_id,
 	*size = ext4_inode_get_size(fs->superblock, enode->inode_ref->inode);
 
 	ext4_node_put(root_node);
+
+	/* Compute free space summaries without delaying the mount */
+	ext4_balloc_summary_start(fs);
+
 	*rfs = fs;
 	return EOK;
 error:
@@ -481,9 +507,16 @@ error:
  */
 errno_t ext4_filesystem_close(ext4_filesystem_t *fs)
 {
+	ext4_balloc_summary_stop(fs);
+
+	/* Return preallocated blocks to the free pool */
+	errno_t rc = ext4_balloc_discard_all(fs);
+	if (rc != EOK)
+		return rc;
+
 	/* Write the superblock to the device */
 	ext4_superblock_set_state(fs->superblock, EXT4_SUPERBLOCK_STATE_VALID_FS);
-	errno_t rc = ext4_superblock_write_direct(fs->device, fs->superblock);
+	rc = ext4_superblock_write_direct(fs->device, fs->superblock);
 	if (rc != EOK)
 		return rc;
 
@@ -896,7 +929,12 @@ static errno_t ext4_filesystem_init_inode_table(ext4_block_group_ref_t *bg_ref)
 	return EOK;
 }
 
-/** Get reference to block group specified by index.
+/** Get reference to block group specified by index without initializing it.
+ *
+ * Unlike ext4_filesystem_get_block_group_ref() this does not initialize
+ * the bitmaps and inode table of uninitialized block groups, so it never
+ * writes to the device. The descriptor must not be modified through
+ * the reference.
  *
  * @param fs   Filesystem to find block group on
  * @param bgid Index of block group to load
@@ -905,8 +943,8 @@ static errno_t ext4_filesystem_init_inode_table(ext4_block_group_ref_t *bg_ref)
  * @return Error code
  *
  */
-errno_t ext4_filesystem_get_block_group_ref(ext4_filesystem_t *fs, uint32_t bgid,
-    ext4_block_group_ref_t **ref)
+errno_t ext4_filesystem_read_block_group_ref(ext4_filesystem_t *fs,
+    uint32_t bgid, ext4_block_group_ref_t **ref)
 {
 	/* Allocate memory for new structure */
 	ext4_block_group_ref_t *newref =
@@ -941,6 +979,27 @@ errno_t ext4_filesystem_get_block_group_ref(ext4_filesystem_t *fs, uint32_t bgid
 	newref->index = bgid;
 	newref->dirty = false;
 
+	*ref = newref;
+	return EOK;
+}
+
+/** Get reference to block group specified by index.
+ *
+ * @param fs   Filesystem to find block group on
+ * @param bgid Index of block group to load
+ * @param ref  Output pointer for reference
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_filesystem_get_block_group_ref(ext4_filesystem_t *fs, uint32_t bgid,
+    ext4_block_group_ref_t **ref)
+{
+	ext4_block_group_ref_t *newref;
+	errno_t rc = ext4_filesystem_read_block_group_ref(fs, bgid, &newref);
+	if (rc != EOK)
+		return rc;
+
 	*ref = newref;
 
 	if (ext4_block_group_has_flag(newref->block_group,
@@ -1529,6 +1588,12 @@ errno_t ext4_filesystem_truncate_inode(ext4_inode_ref_t *inode_ref,
 	if (!ext4_inode_can_truncate(sb, inode_ref->inode))
 		return EINVAL;
 
+	/* Blocks past the new end of file must not be served from window */
+	errno_t rc = ext4_balloc_discard_prealloc(inode_ref->fs,
+	    inode_ref->index);
+	if (rc != EOK)
+		return rc;
+
 	/* If sizes are equal, nothing has to be done. */
 	aoff64_t old_size = ext4_inode_get_size(sb, inode_ref->inode);
 	if (old_size == new_size)
@@ -1553,7 +1618,7 @@ errno_t ext4_filesystem_truncate_inode(ext4_inode_ref_t *inode_ref,
 	    EXT4_FEATURE_INCOMPAT_EXTENTS)) &&
 	    (ext4_inode_has_flag(inode_ref->inode, EXT4_INODE_FLAG_EXTENTS))) {
 		/* Extents require special operation */
-		errno_t rc = ext4_extent_release_blocks_from(inode_ref,
+		rc = ext4_extent_release_blocks_from(inode_ref,
 		    old_blocks_count - diff_blocks_count);
 		if (rc != EOK)
 			return rc;
@@ -1562,7 +1627,7 @@ errno_t ext4_filesystem_truncate_inode(ext4_inode_ref_t *inode_ref,
 
 		/* Starting from 1 because of logical blocks are numbered from 0 */
 		for (uint32_t i = 1; i <= diff_blocks_count; ++i) {
-			errno_t rc = ext4_filesystem_release_inode_block(inode_ref,
+			rc = ext4_filesystem_release_inode_block(inode_ref,
 			    old_blocks_count - i);
 			if (rc != EOK)
 				return rc;
@@ -1689,6 +1754,39 @@ errno_t ext4_filesystem_get_inode_data_block_index(ext4_inode_ref_t *inode_ref,
 	return EOK;
 }
 
+/** Get range of physical blocks by logical index of the first block.
+ *
+ * For i-nodes using extents, the whole remaining part of the extent
+ * containing @a iblock is returned. Otherwise only one block is.
+ *
+ * @param inode_ref I-node to read block address from
+ * @param iblock    Logical index of block
+ * @param fblock    Output pointer for return physical block address
+ * @param count     Output pointer for number of consecutive blocks
+ *                  (including @a iblock) mapped to consecutive
+ *                  physical blocks
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_filesystem_get_inode_data_block_range(ext4_inode_ref_t *inode_ref,
+    aoff64_t iblock, uint32_t *fblock, uint32_t *count)
+{
+	ext4_filesystem_t *fs = inode_ref->fs;
+
+	if ((ext4_superblock_has_feature_incompatible(fs->superblock,
+	    EXT4_FEATURE_INCOMPAT_EXTENTS)) &&
+	    (ext4_inode_has_flag(inode_ref->inode, EXT4_INODE_FLAG_EXTENTS)) &&
+	    (ext4_inode_get_size(fs->superblock, inode_ref->inode) != 0)) {
+		return ext4_extent_find_block_range(inode_ref, iblock, fblock,
+		    count);
+	}
+
+	*count = 1;
+	return ext4_filesystem_get_inode_data_block_index(inode_ref, iblock,
+	    fblock);
+}
+
 /** Set physical block address for the block logical address into the i-node.
  *
  * @param inode_ref I-node to set block address to
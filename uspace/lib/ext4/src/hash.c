@@ -1,4 +1,5 @@
 /*
+ * Copyright (c) 2026 SimonJRiddix
  * Copyright (c) 2012 Frantisek Princ
  * All rights reserved.
  *
@@ -34,14 +35,269 @@
  * @brief Hashing algorithms for ext4 HTree.
  */
 
+#include <byteorder.h>
 #include <errno.h>
 #include "ext4/hash.h"
 
+/** Largest hash value that can be stored in the index */
+#define EXT4_HTREE_EOF_32BIT  0x7fffffffU
+
+/** TEA key schedule constant */
+#define TEA_DELTA  0x9E3779B9
+
+/*
+ * F, G and H are basic MD4 functions: selection, majority, parity
+ */
+#define MD4_F(x, y, z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define MD4_G(x, y, z)  (((x) & (y)) + (((x) ^ (y)) & (z)))
+#define MD4_H(x, y, z)  ((x) ^ (y) ^ (z))
+
+#define MD4_K1  0
+#define MD4_K2  013240474631UL
+#define MD4_K3  015666365641UL
+
+#define MD4_ROUND(f, a, b, c, d, x, s) \
+	((a) += f((b), (c), (d)) + (x), (a) = ext4_hash_rol32((a), (s)))
+
+static inline uint32_t ext4_hash_rol32(uint32_t word, unsigned int shift)
+{
+	return (word << shift) | (word >> (32 - shift));
+}
+
+/** One round of TEA cipher used by TEA hash.
+ *
+ * @param buf State of the hash
+ * @param in  Next 16 bytes of input
+ *
+ */
+static void ext4_hash_tea_transform(uint32_t buf[4], const uint32_t in[4])
+{
+	uint32_t sum = 0;
+	uint32_t b0 = buf[0];
+	uint32_t b1 = buf[1];
+	uint32_t a = in[0];
+	uint32_t b = in[1];
+	uint32_t c = in[2];
+	uint32_t d = in[3];
+
+	for (unsigned int n = 0; n < 16; n++) {
+		sum += TEA_DELTA;
+		b0 += ((b1 << 4) + a) ^ (b1 + sum) ^ ((b1 >> 5) + b);
+		b1 += ((b0 << 4) + c) ^ (b0 + sum) ^ ((b0 >> 5) + d);
+	}
+
+	buf[0] += b0;
+	buf[1] += b1;
+}
+
+/** Reduced MD4 transformation used by half-MD4 hash.
+ *
+ * @param buf State of the hash
+ * @param in  Next 32 bytes of input
+ *
+ */
+static void ext4_hash_half_md4_transform(uint32_t buf[4], const uint32_t in[8])
+{
+	uint32_t a = buf[0];
+	uint32_t b = buf[1];
+	uint32_t c = buf[2];
+	uint32_t d = buf[3];
+
+	/* Round 1 */
+	MD4_ROUND(MD4_F, a, b, c, d, in[0] + MD4_K1, 3);
+	MD4_ROUND(MD4_F, d, a, b, c, in[1] + MD4_K1, 7);
+	MD4_ROUND(MD4_F, c, d, a, b, in[2] + MD4_K1, 11);
+	MD4_ROUND(MD4_F, b, c, d, a, in[3] + MD4_K1, 19);
+	MD4_ROUND(MD4_F, a, b, c, d, in[4] + MD4_K1, 3);
+	MD4_ROUND(MD4_F, d, a, b, c, in[5] + MD4_K1, 7);
+	MD4_ROUND(MD4_F, c, d, a, b, in[6] + MD4_K1, 11);
+	MD4_ROUND(MD4_F, b, c, d, a, in[7] + MD4_K1, 19);
+
+	/* Round 2 */
+	MD4_ROUND(MD4_G, a, b, c, d, in[1] + MD4_K2, 3);
+	MD4_ROUND(MD4_G, d, a, b, c, in[3] + MD4_K2, 5);
+	MD4_ROUND(MD4_G, c, d, a, b, in[5] + MD4_K2, 9);
+	MD4_ROUND(MD4_G, b, c, d, a, in[7] + MD4_K2, 13);
+	MD4_ROUND(MD4_G, a, b, c, d, in[0] + MD4_K2, 3);
+	MD4_ROUND(MD4_G, d, a, b, c, in[2] + MD4_K2, 5);
+	MD4_ROUND(MD4_G, c, d, a, b, in[4] + MD4_K2, 9);
+	MD4_ROUND(MD4_G, b, c, d, a, in[6] + MD4_K2, 13);
+
+	/* Round 3 */
+	MD4_ROUND(MD4_H, a, b, c, d, in[3] + MD4_K3, 3);
+	MD4_ROUND(MD4_H, d, a, b, c, in[7] + MD4_K3, 9);
+	MD4_ROUND(MD4_H, c, d, a, b, in[2] + MD4_K3, 11);
+	MD4_ROUND(MD4_H, b, c, d, a, in[6] + MD4_K3, 15);
+	MD4_ROUND(MD4_H, a, b, c, d, in[1] + MD4_K3, 3);
+	MD4_ROUND(MD4_H, d, a, b, c, in[5] + MD4_K3, 9);
+	MD4_ROUND(MD4_H, c, d, a, b, in[0] + MD4_K3, 11);
+	MD4_ROUND(MD4_H, b, c, d, a, in[4] + MD4_K3, 15);
+
+	buf[0] += a;
+	buf[1] += b;
+	buf[2] += c;
+	buf[3] += d;
+}
+
+/** Legacy hash used by the first htree implementation.
+ *
+ * @param name     Name to be hashed
+ * @param len      Length of name
+ * @param unsig    Treat characters as unsigned
+ *
+ * @return Hash value
+ *
+ */
+static uint32_t ext4_hash_legacy(const char *name, int len, bool unsig)
+{
+	uint32_t hash;
+	uint32_t hash0 = 0x12a3fe2d;
+	uint32_t hash1 = 0x37abe8f9;
+
+	for (int i = 0; i < len; i++) {
+		int c = unsig ? (int) (unsigned char) name[i] :
+		    (int) (signed char) name[i];
+
+		hash = hash1 + (hash0 ^ (uint32_t) (c * 7152373));
+		if (hash & 0x80000000)
+			hash -= 0x7fffffff;
+
+		hash1 = hash0;
+		hash0 = hash;
+	}
+
+	return hash0 << 1;
+}
+
+/** Convert part of the name to input words of a hash transformation.
+ *
+ * The buffer is padded with a value derived from the length of the
+ * remaining part of the name.
+ *
+ * @param msg   Remaining part of the name
+ * @param len   Length of the remaining part
+ * @param buf   Output buffer
+ * @param num   Number of words in the output buffer
+ * @param unsig Treat characters as unsigned
+ *
+ */
+static void ext4_hash_str2hashbuf(const char *msg, int len, uint32_t *buf,
+    int num, bool unsig)
+{
+	uint32_t pad = (uint32_t) len | ((uint32_t) len << 8);
+	pad |= pad << 16;
+
+	uint32_t val = pad;
+	if (len > num * 4)
+		len = num * 4;
+
+	for (int i = 0; i < len; i++) {
+		int c = unsig ? (int) (unsigned char) msg[i] :
+		    (int) (signed char) msg[i];
+
+		val = (uint32_t) c + (val << 8);
+		if ((i % 4) == 3) {
+			*buf++ = val;
+			val = pad;
+			num--;
+		}
+	}
+
+	if (--num >= 0)
+		*buf++ = val;
+
+	while (--num >= 0)
+		*buf++ = pad;
+}
+
+/** Compute hash value of a directory entry name.
+ *
+ * The algorithm is selected by @c hinfo->hash_version and seeded
+ * with @c hinfo->seed (unless it is all zeros). Results are compatible
+ * with the Linux implementation.
+ *
+ * @param hinfo Hash info with hash version and seed, output hash values
+ * @param len   Length of name
+ * @param name  Name to be hashed
+ *
+ * @return EOK on success, ENOTSUP if hash version is not known
+ *
+ */
 errno_t ext4_hash_string(ext4_hash_info_t *hinfo, int len, const char *name)
 {
-	// TODO
-	hinfo->hash = 0;
-	return ENOTSUP;
+	uint32_t hash;
+	uint32_t minor_hash = 0;
+	uint32_t in[8];
+	const char *p;
+	bool unsig = false;
+
+	/* Default seed */
+	uint32_t buf[4] = {
+		0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476
+	};
+
+	/* Use the seed from superblock unless it is all zeros */
+	if (hinfo->seed != NULL) {
+		for (unsigned int i = 0; i < 4; i++) {
+			if (hinfo->seed[i] != 0) {
+				for (unsigned int j = 0; j < 4; j++)
+					buf[j] = uint32_t_le2host(hinfo->seed[j]);
+				break;
+			}
+		}
+	}
+
+	switch (hinfo->hash_version) {
+	case EXT4_HASH_VERSION_LEGACY_UNSIGNED:
+		unsig = true;
+		/* Fallthrough */
+	case EXT4_HASH_VERSION_LEGACY:
+		hash = ext4_hash_legacy(name, len, unsig);
+		break;
+	case EXT4_HASH_VERSION_HALF_MD4_UNSIGNED:
+		unsig = true;
+		/* Fallthrough */
+	case EXT4_HASH_VERSION_HALF_MD4:
+		p = name;
+		while (len > 0) {
+			ext4_hash_str2hashbuf(p, len, in, 8, unsig);
+			ext4_hash_half_md4_transform(buf, in);
+			len -= 32;
+			p += 32;
+		}
+
+		hash = buf[1];
+		minor_hash = buf[2];
+		break;
+	case EXT4_HASH_VERSION_TEA_UNSIGNED:
+		unsig = true;
+		/* Fallthrough */
+	case EXT4_HASH_VERSION_TEA:
+		p = name;
+		while (len > 0) {
+			ext4_hash_str2hashbuf(p, len, in, 4, unsig);
+			ext4_hash_tea_transform(buf, in);
+			len -= 16;
+			p += 16;
+		}
+
+		hash = buf[0];
+		minor_hash = buf[1];
+		break;
+	default:
+		hinfo->hash = 0;
+		return ENOTSUP;
+	}
+
+	/* The lowest bit is used to mark hash collisions in the index */
+	hash = hash & ~1;
+	if (hash == (EXT4_HTREE_EOF_32BIT << 1))
+		hash = (EXT4_HTREE_EOF_32BIT - 1) << 1;
+
+	hinfo->hash = hash;
+	hinfo->minor_hash = minor_hash;
+
+	return EOK;
 }
 
 /**
@@ -55,6 +55,9 @@
 #include "ext4/fstypes.h"
 #include "ext4/superblock.h"
 
+/** Maximum number of consecutive blocks returned by one read request */
+#define EXT4_READ_MAX_BLOCKS  32
+
 /* Forward declarations of auxiliary functions */
 
 static errno_t ext4_read_directory(ipc_call_t *, aoff64_t, size_t,
@@ -569,17 +572,10 @@ errno_t ext4_link(fs_node_t *pfn, fs_node_t *cfn, const char *name)
 			return rc;
 		}
 
-		/* Initialize directory index if supported */
-		if (ext4_superblock_has_feature_compatible(fs->superblock,
-		    EXT4_FEATURE_COMPAT_DIR_INDEX)) {
-			rc = ext4_directory_dx_init(child->inode_ref);
-			if (rc != EOK)
-				return rc;
-
-			ext4_inode_set_flag(child->inode_ref->inode,
-			    EXT4_INODE_FLAG_INDEX);
-			child->inode_ref->dirty = true;
-		}
+		/*
+		 * New directory starts linear, it is converted to indexed
+		 * by ext4_directory_add_entry() once it outgrows one block.
+		 */
 
 		uint16_t parent_links =
 		    ext4_inode_get_links_count(parent->inode_ref->inode);
@@ -1204,28 +1200,35 @@ errno_t ext4_read_file(ipc_call_t *call, aoff64_t pos, size_t size,
 		return EOK;
 	}
 
-	/* For now, we only read data from one block at a time */
 	uint32_t block_size = ext4_superblock_get_block_size(sb);
 	aoff64_t file_block = pos / block_size;
 	uint32_t offset_in_block = pos % block_size;
-	uint32_t bytes = min(block_size - offset_in_block, size);
 
 	/* Handle end of file */
-	if (pos + bytes > file_size)
-		bytes = file_size - pos;
+	if (pos + size > file_size)
+		size = file_size - pos;
 
-	/* Get the real block number */
+	/* Get the real block number and length of the mapped range */
 	uint32_t fs_block;
-	errno_t rc = ext4_filesystem_get_inode_data_block_index(inode_ref,
-	    file_block, &fs_block);
+	uint32_t count;
+	errno_t rc = ext4_filesystem_get_inode_data_block_range(inode_ref,
+	    file_block, &fs_block, &count);
 	if (rc != EOK) {
 		async_answer_0(call, rc);
 		return rc;
 	}
 
+	/* Read at most one block from a hole and limit the size of buffer */
+	if (fs_block == 0)
+		count = 1;
+	if (count > EXT4_READ_MAX_BLOCKS)
+		count = EXT4_READ_MAX_BLOCKS;
+
+	size_t bytes = min((size_t) count * block_size - offset_in_block, size);
+
 	/*
 	 * Check for sparse file.
-	 * If ext4_filesystem_get_inode_data_block_index returned
+	 * If ext4_filesystem_get_inode_data_block_range returned
 	 * fs_block == 0, it means that the given block is not allocated for the
 	 * file and we need to return a buffer of zeros
 	 */
@@ -1246,8 +1249,52 @@ errno_t ext4_read_file(ipc_call_t *call, aoff64_t pos, size_t size,
 		return rc;
 	}
 
-	/* Usual case - we need to read a block from device */
 	block_t *block;
+
+	/* Data spanning several consecutive blocks are gathered in a buffer */
+	if (offset_in_block + bytes > block_size) {
+		buffer = malloc(bytes);
+		if (buffer == NULL) {
+			async_answer_0(call, ENOMEM);
+			return ENOMEM;
+		}
+
+		size_t done = 0;
+		uint32_t offset = offset_in_block;
+		while (done < bytes) {
+			rc = block_get(&block, inst->service_id, fs_block,
+			    BLOCK_FLAGS_NONE);
+			if (rc != EOK) {
+				free(buffer);
+				async_answer_0(call, rc);
+				return rc;
+			}
+
+			size_t chunk = min(block_size - offset, bytes - done);
+			memcpy(buffer + done, block->data + offset, chunk);
+
+			rc = block_put(block);
+			if (rc != EOK) {
+				free(buffer);
+				async_answer_0(call, rc);
+				return rc;
+			}
+
+			done += chunk;
+			offset = 0;
+			fs_block++;
+		}
+
+		rc = async_data_read_finalize(call, buffer, bytes);
+		free(buffer);
+		if (rc != EOK)
+			return rc;
+
+		*rbytes = bytes;
+		return EOK;
+	}
+
+	/* Usual case - we need to read a block from device */
 	rc = block_get(&block, inst->service_id, fs_block, BLOCK_FLAGS_NONE);
 	if (rc != EOK) {
 		async_answer_0(call, rc);
@@ -1434,6 +1481,9 @@ static errno_t ext4_truncate(service_id_t service_id, fs_index_t index,
 }
 
 /** Close file.
+ *
+ * Blocks preallocated for the file and not used are returned
+ * to the free pool.
  *
  * @param service_id Device identifier
  * @param index      I-node number
@@ -1443,7 +1493,12 @@ static errno_t ext4_truncate(service_id_t service_id, fs_index_t index,
  */
 static errno_t ext4_close(service_id_t service_id, fs_index_t index)
 {
-	return EOK;
+	ext4_instance_t *inst;
+	errno_t rc = ext4_instance_get(service_id, &inst);
+	if (rc != EOK)
+		return rc;
+
+	return ext4_balloc_discard_prealloc(inst->filesystem, index);
 }
 
 /** Destroy node specified by index.
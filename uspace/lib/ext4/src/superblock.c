@@ -1508,6 +1508,9 @@ errno_t ext4_superblock_create(size_t dev_bsize, uint64_t dev_bcnt,
 {
 	ext4_superblock_t *sb;
 	uuid_t uuid;
+	uuid_t seed_uuid;
+	uint8_t seed_buf[16];
+	uint32_t hash_seed[4];
 	uint32_t cur_ts;
 	uint64_t first_block = 0;
 	uint64_t fs_blocks;
@@ -1534,6 +1537,14 @@ errno_t ext4_superblock_create(size_t dev_bsize, uint64_t dev_bcnt,
 	if (rc != EOK)
 		goto error;
 
+	/* Random seed for the directory index hash */
+	rc = uuid_generate(&seed_uuid);
+	if (rc != EOK)
+		goto error;
+
+	uuid_encode(&seed_uuid, seed_buf);
+	memcpy(hash_seed, seed_buf, sizeof(hash_seed));
+
 	/* Current UNIX time */
 	getrealtime(&ts); // XXX ISO C does not say what the epoch is
 	cur_ts = ts.tv_sec;
@@ -1628,7 +1639,8 @@ errno_t ext4_superblock_create(size_t dev_bsize, uint64_t dev_bcnt,
 		ext4_superblock_set_first_inode(sb, EXT4_REV0_FIRST_INO);
 		ext4_superblock_set_inode_size(sb, EXT4_REV0_INODE_SIZE);
 		ext4_superblock_set_block_group_index(sb, 0); // XXX
-		ext4_superblock_set_features_compatible(sb, 0);
+		ext4_superblock_set_features_compatible(sb,
+		    EXT4_FEATURE_COMPAT_DIR_INDEX);
 		ext4_superblock_set_features_incompatible(sb, 0);
 		ext4_superblock_set_features_read_only(sb, 0);
 
@@ -1643,6 +1655,13 @@ errno_t ext4_superblock_create(size_t dev_bsize, uint64_t dev_bcnt,
 		    "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0"
 		    "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0");
 		sb->algorithm_usage_bitmap = 0;
+
+		/* Directory index */
+		ext4_superblock_set_hash_seed(sb, hash_seed);
+		ext4_superblock_set_default_hash_version(sb,
+		    EXT4_HASH_VERSION_HALF_MD4);
+		ext4_superblock_set_flags(sb,
+		    EXT4_SUPERBLOCK_FLAGS_UNSIGNED_HASH);
 	}
 #if 0
 	/* Journalling */
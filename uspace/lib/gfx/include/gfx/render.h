@@ -44,6 +44,7 @@
 extern errno_t gfx_set_clip_rect(gfx_context_t *, gfx_rect_t *);
 extern errno_t gfx_set_color(gfx_context_t *, gfx_color_t *);
 extern errno_t gfx_fill_rect(gfx_context_t *, gfx_rect_t *);
+extern errno_t gfx_copy_area(gfx_context_t *, gfx_rect_t *, gfx_coord2_t *);
 extern errno_t gfx_update(gfx_context_t *);
 
 #endif
@@ -70,6 +70,8 @@ typedef struct {
 	errno_t (*cursor_set_pos)(void *, gfx_coord2_t *);
 	/** Set hardware cursor visibility */
 	errno_t (*cursor_set_visible)(void *, bool);
+	/** Copy area */
+	errno_t (*copy_area)(void *, gfx_rect_t *, gfx_coord2_t *);
 } gfx_context_ops_t;
 
 #endif
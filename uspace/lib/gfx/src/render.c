@@ -75,6 +75,29 @@ errno_t gfx_fill_rect(gfx_context_t *gc, gfx_rect_t *rect)
 	return gc->ops->fill_rect(gc->arg, rect);
 }
 
+/** Copy area.
+ *
+ * Copy pixels in @a rect to the same rectangle translated by @a offs.
+ * The source and destination may overlap. Source pixels outside of
+ * the GC are not copied, destination is clipped to the clipping
+ * rectangle.
+ *
+ * @param gc Graphic context
+ * @param rect Source rectangle
+ * @param offs Offset of the destination rectangle
+ *
+ * @return EOK on success, ENOTSUP if not supported, ENOMEM if
+ *         insufficient resources, EIO if grahic device connection was lost
+ */
+errno_t gfx_copy_area(gfx_context_t *gc, gfx_rect_t *rect,
+    gfx_coord2_t *offs)
+{
+	if (gc->ops->copy_area != NULL)
+		return gc->ops->copy_area(gc->arg, rect, offs);
+	else
+		return ENOTSUP;
+}
+
 /** Update display.
  *
  * Finish any deferred rendering.
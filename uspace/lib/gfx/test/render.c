@@ -41,8 +41,17 @@ static errno_t testgc_set_clip_rect(void *, gfx_rect_t *);
 static errno_t testgc_set_color(void *, gfx_color_t *);
 static errno_t testgc_fill_rect(void *, gfx_rect_t *);
 static errno_t testgc_update(void *);
+static errno_t testgc_copy_area(void *, gfx_rect_t *, gfx_coord2_t *);
 
 static gfx_context_ops_t ops = {
+	.set_clip_rect = testgc_set_clip_rect,
+	.set_color = testgc_set_color,
+	.fill_rect = testgc_fill_rect,
+	.update = testgc_update,
+	.copy_area = testgc_copy_area
+};
+
+static gfx_context_ops_t ops_nocopy = {
 	.set_clip_rect = testgc_set_clip_rect,
 	.set_color = testgc_set_color,
 	.fill_rect = testgc_fill_rect,
@@ -64,6 +73,10 @@ typedef struct {
 	gfx_rect_t frect;
 
 	bool update;
+
+	bool copy_area;
+	gfx_rect_t carect;
+	gfx_coord2_t caoffs;
 } test_gc_t;
 
 /** Set clipping rectangle */
@@ -275,6 +288,104 @@ PCUT_TEST(fill_rect_failure)
 	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
 }
 
+/** Copy area */
+PCUT_TEST(copy_area)
+{
+	errno_t rc;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	gfx_context_t *gc = NULL;
+	test_gc_t tgc;
+
+	memset(&tgc, 0, sizeof(tgc));
+
+	rc = gfx_context_new(&ops, &tgc, &gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	offs.x = 5;
+	offs.y = -6;
+
+	PCUT_ASSERT_FALSE(tgc.copy_area);
+
+	tgc.rc = EOK;
+
+	rc = gfx_copy_area(gc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	PCUT_ASSERT_TRUE(tgc.copy_area);
+	PCUT_ASSERT_INT_EQUALS(rect.p0.x, tgc.carect.p0.x);
+	PCUT_ASSERT_INT_EQUALS(rect.p0.y, tgc.carect.p0.y);
+	PCUT_ASSERT_INT_EQUALS(rect.p1.x, tgc.carect.p1.x);
+	PCUT_ASSERT_INT_EQUALS(rect.p1.y, tgc.carect.p1.y);
+	PCUT_ASSERT_INT_EQUALS(offs.x, tgc.caoffs.x);
+	PCUT_ASSERT_INT_EQUALS(offs.y, tgc.caoffs.y);
+
+	rc = gfx_context_delete(gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
+/** Copy area with error return */
+PCUT_TEST(copy_area_failure)
+{
+	errno_t rc;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	gfx_context_t *gc = NULL;
+	test_gc_t tgc;
+
+	memset(&tgc, 0, sizeof(tgc));
+
+	rc = gfx_context_new(&ops, &tgc, &gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	offs.x = 5;
+	offs.y = 6;
+
+	tgc.rc = EIO;
+
+	rc = gfx_copy_area(gc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EIO, rc);
+
+	rc = gfx_context_delete(gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
+/** Copy area on GC that does not support it */
+PCUT_TEST(copy_area_unsupported)
+{
+	errno_t rc;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	gfx_context_t *gc = NULL;
+	test_gc_t tgc;
+
+	memset(&tgc, 0, sizeof(tgc));
+
+	rc = gfx_context_new(&ops_nocopy, &tgc, &gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	offs.x = 5;
+	offs.y = 6;
+
+	rc = gfx_copy_area(gc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(ENOTSUP, rc);
+
+	rc = gfx_context_delete(gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
 /** Update GC */
 PCUT_TEST(update)
 {
@@ -362,4 +473,15 @@ static errno_t testgc_update(void *arg)
 	return tgc->rc;
 }
 
+static errno_t testgc_copy_area(void *arg, gfx_rect_t *rect,
+    gfx_coord2_t *offs)
+{
+	test_gc_t *tgc = (test_gc_t *) arg;
+
+	tgc->copy_area = true;
+	tgc->carect = *rect;
+	tgc->caoffs = *offs;
+	return tgc->rc;
+}
+
 PCUT_EXPORT(render);
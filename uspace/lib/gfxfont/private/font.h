@@ -45,6 +45,7 @@
 #include <types/gfx/font.h>
 #include <types/gfx/typeface.h>
 #include <riff/chunk.h>
+#include "runcache.h"
 
 /** Font
  *
@@ -69,6 +70,8 @@ struct gfx_font {
 	gfx_bitmap_t *bitmap;
 	/** Bitmap rectangle */
 	gfx_rect_t rect;
+	/** Cache of pre-rendered text runs */
+	gfx_run_cache_t runs;
 };
 
 /** Font info
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libgfxfont
+ * @{
+ */
+/**
+ * @file Text run cache
+ */
+
+#ifndef _GFX_PRIVATE_RUNCACHE_H
+#define _GFX_PRIVATE_RUNCACHE_H
+
+#include <adt/list.h>
+#include <errno.h>
+#include <io/pixel.h>
+#include <stddef.h>
+#include <types/gfx/bitmap.h>
+#include <types/gfx/color.h>
+#include <types/gfx/coord.h>
+#include <types/gfx/font.h>
+
+/** Maximum number of cached runs per font */
+#define GFX_RUN_CACHE_RUNS 64
+
+/** Maximum number of pixels in cached run bitmaps per font */
+#define GFX_RUN_CACHE_PIXELS (512 * 1024)
+
+/** Maximum length of a cached run in bytes */
+#define GFX_RUN_CACHE_LEN 256
+
+/** Cached text run.
+ *
+ * A run of glyphs pre-rendered in a single color into a color-keyed
+ * bitmap, so that it can be drawn with one bitmap render.
+ */
+typedef struct {
+	/** Link to @c gfx_run_cache_t.runs */
+	link_t lruns;
+	/** Text of the run (not NUL-terminated) */
+	char *text;
+	/** Length of text in bytes */
+	size_t len;
+	/** Color of the run */
+	pixel_t color;
+	/** Run bitmap */
+	gfx_bitmap_t *bitmap;
+	/** Bitmap rectangle relative to the pen start point */
+	gfx_rect_t rect;
+	/** Number of pixels in the bitmap */
+	size_t npixels;
+} gfx_run_t;
+
+/** Text run cache.
+ *
+ * The runs are kept in least recently used order, the most recently
+ * used one first.
+ */
+typedef struct {
+	/** Cached runs (of gfx_run_t) */
+	list_t runs;
+	/** Number of cached runs */
+	size_t nruns;
+	/** Total number of pixels in run bitmaps */
+	size_t npixels;
+} gfx_run_cache_t;
+
+extern void gfx_run_cache_init(gfx_run_cache_t *);
+extern void gfx_run_cache_clear(gfx_run_cache_t *);
+extern errno_t gfx_run_cache_render(gfx_font_t *, const char *, size_t,
+    gfx_color_t *, gfx_coord2_t *);
+
+#endif
+
+/** @}
+ */
@@ -44,6 +44,7 @@
 #include <stdlib.h>
 #include "../private/font.h"
 #include "../private/glyph.h"
+#include "../private/runcache.h"
 #include "../private/tpf_file.h"
 #include "../private/typeface.h"
 
@@ -130,6 +131,7 @@ static errno_t gfx_font_create_with_info(gfx_typeface_t *tface,
 
 	font->metrics = *metrics;
 	list_initialize(&font->glyphs);
+	gfx_run_cache_init(&font->runs);
 	*rfont = font;
 	return EOK;
 error:
@@ -237,6 +239,8 @@ void gfx_font_close(gfx_font_t *font)
 {
 	gfx_glyph_t *glyph;
 
+	gfx_run_cache_clear(&font->runs);
+
 	glyph = gfx_font_first_glyph(font);
 	while (glyph != NULL) {
 		gfx_glyph_destroy(glyph);
@@ -381,6 +385,9 @@ errno_t gfx_font_splice_at_glyph(gfx_font_t *font, gfx_glyph_t *glyph,
 	gfx_coord_t x0;
 	errno_t rc;
 
+	/* Cached runs refer to the old glyph layout */
+	gfx_run_cache_clear(&font->runs);
+
 	/* Change of width of glyph */
 	dwidth = (nrect->p1.x - nrect->p0.x) -
 	    (glyph->rect.p1.x - glyph->rect.p0.x);
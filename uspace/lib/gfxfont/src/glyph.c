@@ -45,6 +45,7 @@
 #include <str.h>
 #include "../private/font.h"
 #include "../private/glyph.h"
+#include "../private/runcache.h"
 #include "../private/tpf_file.h"
 
 /** Initialize glyph metrics structure.
@@ -117,6 +118,7 @@ errno_t gfx_glyph_create(gfx_font_t *font, gfx_glyph_metrics_t *metrics,
  */
 void gfx_glyph_destroy(gfx_glyph_t *glyph)
 {
+	gfx_run_cache_clear(&glyph->font->runs);
 	list_remove(&glyph->lglyphs);
 	free(glyph);
 }
@@ -139,6 +141,7 @@ void gfx_glyph_get_metrics(gfx_glyph_t *glyph, gfx_glyph_metrics_t *metrics)
  */
 errno_t gfx_glyph_set_metrics(gfx_glyph_t *glyph, gfx_glyph_metrics_t *metrics)
 {
+	gfx_run_cache_clear(&glyph->font->runs);
 	glyph->metrics = *metrics;
 	return EOK;
 }
@@ -179,6 +182,7 @@ errno_t gfx_glyph_set_pattern(gfx_glyph_t *glyph, const char *pattern)
 	}
 
 	list_append(&pat->lpatterns, &glyph->patterns);
+	gfx_run_cache_clear(&glyph->font->runs);
 	return EOK;
 }
 
@@ -199,6 +203,7 @@ void gfx_glyph_clear_pattern(gfx_glyph_t *glyph, const char *pattern)
 			list_remove(&pat->lpatterns);
 			free(pat->text);
 			free(pat);
+			gfx_run_cache_clear(&glyph->font->runs);
 			return;
 		}
 
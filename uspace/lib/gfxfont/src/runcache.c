@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libgfxfont
+ * @{
+ */
+/**
+ * @file Text run cache
+ *
+ * Rendering text glyph by glyph costs one bitmap render per glyph, which
+ * adds up when the same labels and list entries are redrawn over and
+ * over. Each font therefore keeps a small cache of recently rendered
+ * runs of text, each pre-rendered in its color into a color-keyed bitmap
+ * that can be drawn with a single bitmap render. The least recently used
+ * runs are evicted when the cache exceeds its limits.
+ */
+
+#include <adt/list.h>
+#include <errno.h>
+#include <gfx/bitmap.h>
+#include <gfx/color.h>
+#include <gfx/coord.h>
+#include <gfx/font.h>
+#include <io/pixelmap.h>
+#include <mem.h>
+#include <stdlib.h>
+#include "../private/font.h"
+#include "../private/glyph.h"
+#include "../private/runcache.h"
+#include "../private/typeface.h"
+
+/** Initialize text run cache.
+ *
+ * @param cache Text run cache
+ */
+void gfx_run_cache_init(gfx_run_cache_t *cache)
+{
+	list_initialize(&cache->runs);
+	cache->nruns = 0;
+	cache->npixels = 0;
+}
+
+/** Destroy cached run.
+ *
+ * @param cache Text run cache
+ * @param run Run
+ */
+static void gfx_run_destroy(gfx_run_cache_t *cache, gfx_run_t *run)
+{
+	list_remove(&run->lruns);
+	--cache->nruns;
+	cache->npixels -= run->npixels;
+
+	if (run->bitmap != NULL)
+		gfx_bitmap_destroy(run->bitmap);
+	free(run->text);
+	free(run);
+}
+
+/** Remove all runs from text run cache.
+ *
+ * This must be called whenever glyphs of the font change.
+ *
+ * @param cache Text run cache
+ */
+void gfx_run_cache_clear(gfx_run_cache_t *cache)
+{
+	link_t *link;
+
+	while ((link = list_first(&cache->runs)) != NULL) {
+		gfx_run_destroy(cache,
+		    list_get_instance(link, gfx_run_t, lruns));
+	}
+}
+
+/** Convert color to the pixel value a GC would draw it with.
+ *
+ * @param color Color
+ * @return Pixel value
+ */
+static pixel_t gfx_run_color_pixel(gfx_color_t *color)
+{
+	uint16_t r, g, b;
+	uint8_t attr;
+
+	gfx_color_get_rgb_i16(color, &r, &g, &b);
+	gfx_color_get_ega(color, &attr);
+	return PIXEL(attr, r >> 8, g >> 8, b >> 8);
+}
+
+/** Find run in text run cache.
+ *
+ * @param cache Text run cache
+ * @param str String
+ * @param len Length of the run in bytes
+ * @param color Run color
+ * @return Run or @c NULL if not found
+ */
+static gfx_run_t *gfx_run_cache_find(gfx_run_cache_t *cache,
+    const char *str, size_t len, pixel_t color)
+{
+	list_foreach(cache->runs, lruns, gfx_run_t, run) {
+		if (run->len == len && run->color == color &&
+		    memcmp(run->text, str, len) == 0)
+			return run;
+	}
+
+	return NULL;
+}
+
+/** Determine bounding rectangle of a run.
+ *
+ * @param font Font
+ * @param text Run text (NUL-terminated)
+ * @param rect Place to store rectangle relative to the pen start point
+ */
+static void gfx_run_get_rect(gfx_font_t *font, const char *text,
+    gfx_rect_t *rect)
+{
+	gfx_glyph_t *glyph;
+	gfx_coord2_t cpos;
+	gfx_coord2_t offs;
+	gfx_rect_t grect;
+	gfx_rect_t env;
+	const char *cp;
+	size_t stradv;
+	errno_t rc;
+
+	rect->p0.x = 0;
+	rect->p0.y = 0;
+	rect->p1.x = 0;
+	rect->p1.y = 0;
+
+	cpos.x = 0;
+	cpos.y = 0;
+	cp = text;
+	while (*cp != '\0') {
+		rc = gfx_font_search_glyph(font, cp, &glyph, &stradv);
+		if (rc != EOK) {
+			++cp;
+			continue;
+		}
+
+		gfx_coord2_subtract(&cpos, &glyph->origin, &offs);
+		gfx_rect_translate(&offs, &glyph->rect, &grect);
+		gfx_rect_envelope(rect, &grect, &env);
+		*rect = env;
+
+		cp += stradv;
+		cpos.x += glyph->metrics.advance;
+	}
+}
+
+/** Render glyphs of a run into its bitmap.
+ *
+ * @param font Font
+ * @param run Run with bitmap covering @c run->rect
+ * @param key Key color
+ * @return EOK on success or an error code
+ */
+static errno_t gfx_run_paint(gfx_font_t *font, gfx_run_t *run, pixel_t key)
+{
+	gfx_bitmap_alloc_t falloc;
+	gfx_bitmap_alloc_t ralloc;
+	pixelmap_t fmap;
+	gfx_glyph_t *glyph;
+	gfx_coord2_t cpos;
+	gfx_coord2_t offs;
+	gfx_coord_t x, y;
+	pixel_t *row;
+	const char *cp;
+	size_t stradv;
+	errno_t rc;
+
+	rc = gfx_bitmap_get_alloc(font->bitmap, &falloc);
+	if (rc != EOK)
+		return rc;
+
+	rc = gfx_bitmap_get_alloc(run->bitmap, &ralloc);
+	if (rc != EOK)
+		return rc;
+
+	fmap.width = font->rect.p1.x;
+	fmap.height = font->rect.p1.y;
+	fmap.data = falloc.pixels;
+
+	for (y = run->rect.p0.y; y < run->rect.p1.y; y++) {
+		row = (pixel_t *)((uint8_t *) ralloc.pixels +
+		    (y - run->rect.p0.y) * ralloc.pitch);
+		for (x = run->rect.p0.x; x < run->rect.p1.x; x++)
+			row[x - run->rect.p0.x] = key;
+	}
+
+	cpos.x = 0;
+	cpos.y = 0;
+	cp = run->text;
+	while (*cp != '\0') {
+		rc = gfx_font_search_glyph(font, cp, &glyph, &stradv);
+		if (rc != EOK) {
+			++cp;
+			continue;
+		}
+
+		/* Glyph pixel (x, y) lands at (x + offs.x, y + offs.y) */
+		gfx_coord2_subtract(&cpos, &glyph->origin, &offs);
+
+		for (y = glyph->rect.p0.y; y < glyph->rect.p1.y; y++) {
+			row = (pixel_t *)((uint8_t *) ralloc.pixels +
+			    (y + offs.y - run->rect.p0.y) * ralloc.pitch);
+			for (x = glyph->rect.p0.x; x < glyph->rect.p1.x; x++) {
+				if (pixelmap_get_pixel(&fmap, x, y) !=
+				    PIXEL(0, 0, 0, 0))
+					row[x + offs.x - run->rect.p0.x] =
+					    run->color;
+			}
+		}
+
+		cp += stradv;
+		cpos.x += glyph->metrics.advance;
+	}
+
+	return EOK;
+}
+
+/** Create run and render it into a new bitmap.
+ *
+ * @param font Font
+ * @param str String
+ * @param len Length of the run in bytes
+ * @param color Run color
+ * @param rrun Place to store pointer to new run
+ * @return EOK on success, ENOTSUP if the run is too large to cache,
+ *         ENOMEM if out of memory or another error code
+ */
+static errno_t gfx_run_create(gfx_font_t *font, const char *str, size_t len,
+    pixel_t color, gfx_run_t **rrun)
+{
+	gfx_run_t *run;
+	gfx_bitmap_params_t params;
+	gfx_coord2_t dim;
+	errno_t rc;
+
+	run = calloc(1, sizeof(gfx_run_t));
+	if (run == NULL)
+		return ENOMEM;
+
+	run->text = malloc(len + 1);
+	if (run->text == NULL) {
+		free(run);
+		return ENOMEM;
+	}
+
+	memcpy(run->text, str, len);
+	run->text[len] = '\0';
+	run->len = len;
+	run->color = color;
+
+	gfx_run_get_rect(font, run->text, &run->rect);
+	gfx_rect_dims(&run->rect, &dim);
+	run->npixels = (size_t) dim.x * (size_t) dim.y;
+
+	if (run->npixels > GFX_RUN_CACHE_PIXELS) {
+		rc = ENOTSUP;
+		goto error;
+	}
+
+	if (run->npixels != 0) {
+		/* Inverting the color always yields a different key */
+		gfx_bitmap_params_init(&params);
+		params.rect = run->rect;
+		params.flags = bmpf_color_key;
+		params.key_color = INVERT(color);
+
+		rc = gfx_bitmap_create(font->typeface->gc, &params, NULL,
+		    &run->bitmap);
+		if (rc != EOK)
+			goto error;
+
+		rc = gfx_run_paint(font, run, params.key_color);
+		if (rc != EOK)
+			goto error;
+	}
+
+	*rrun = run;
+	return EOK;
+error:
+	if (run->bitmap != NULL)
+		gfx_bitmap_destroy(run->bitmap);
+	free(run->text);
+	free(run);
+	return rc;
+}
+
+/** Render run of text using the text run cache.
+ *
+ * If the run is not cached yet, it is rendered into a new bitmap and
+ * added to the cache, evicting least recently used runs as needed.
+ *
+ * @param font Font
+ * @param str String
+ * @param len Length of the run in bytes
+ * @param color Text color
+ * @param pos Pen start position
+ * @return EOK on success, ENOTSUP if the run cannot be cached (and must
+ *         be rendered glyph by glyph) or another error code
+ */
+errno_t gfx_run_cache_render(gfx_font_t *font, const char *str, size_t len,
+    gfx_color_t *color, gfx_coord2_t *pos)
+{
+	gfx_run_cache_t *cache = &font->runs;
+	gfx_run_t *run;
+	pixel_t pcolor;
+	errno_t rc;
+
+	if (len == 0)
+		return EOK;
+
+	if (len > GFX_RUN_CACHE_LEN)
+		return ENOTSUP;
+
+	pcolor = gfx_run_color_pixel(color);
+
+	run = gfx_run_cache_find(cache, str, len, pcolor);
+	if (run != NULL) {
+		/* Move to the front of the LRU list */
+		list_remove(&run->lruns);
+		list_prepend(&run->lruns, &cache->runs);
+	} else {
+		rc = gfx_run_create(font, str, len, pcolor, &run);
+		if (rc != EOK)
+			return rc;
+
+		/* Evict least recently used runs to make room */
+		while (!list_empty(&cache->runs) &&
+		    (cache->nruns >= GFX_RUN_CACHE_RUNS ||
+		    cache->npixels + run->npixels > GFX_RUN_CACHE_PIXELS)) {
+			gfx_run_destroy(cache, list_get_instance(
+			    list_last(&cache->runs), gfx_run_t, lruns));
+		}
+
+		list_prepend(&run->lruns, &cache->runs);
+		++cache->nruns;
+		cache->npixels += run->npixels;
+	}
+
+	if (run->bitmap == NULL)
+		return EOK;
+
+	return gfx_bitmap_render(run->bitmap, &run->rect, pos);
+}
+
+/** @}
+ */
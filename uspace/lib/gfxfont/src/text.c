@@ -44,6 +44,7 @@
 #include <mem.h>
 #include <str.h>
 #include "../private/font.h"
+#include "../private/runcache.h"
 #include "../private/typeface.h"
 
 /** Initialize text formatting structure.
@@ -191,6 +192,46 @@ static errno_t gfx_puttext_textmode(gfx_coord2_t *pos, gfx_text_fmt_t *fmt,
 	return rc;
 }
 
+/** Render run of text glyph by glyph.
+ *
+ * @param font Font
+ * @param pos Pen start position
+ * @param str String
+ * @param len Length of the run in bytes
+ * @return EOK on success or an error code
+ */
+static errno_t gfx_puttext_glyphs(gfx_font_t *font, gfx_coord2_t *pos,
+    const char *str, size_t len)
+{
+	gfx_glyph_metrics_t gmetrics;
+	const char *cp;
+	gfx_glyph_t *glyph;
+	gfx_coord2_t cpos;
+	size_t stradv;
+	errno_t rc;
+
+	cpos = *pos;
+	cp = str;
+	while (cp < str + len) {
+		rc = gfx_font_search_glyph(font, cp, &glyph, &stradv);
+		if (rc != EOK) {
+			++cp;
+			continue;
+		}
+
+		gfx_glyph_get_metrics(glyph, &gmetrics);
+
+		rc = gfx_glyph_render(glyph, &cpos);
+		if (rc != EOK)
+			return rc;
+
+		cp += stradv;
+		cpos.x += gmetrics.advance;
+	}
+
+	return EOK;
+}
+
 /** Get text starting position.
  *
  * @param pos Anchor position
@@ -288,6 +329,7 @@ errno_t gfx_puttext(gfx_coord2_t *pos, gfx_text_fmt_t *fmt, const char *str)
 		rmargin = spos.x + width;
 	}
 
+	/* Determine how much of the string fits */
 	cpos = spos;
 	cp = str;
 	while (*cp != '\0') {
@@ -303,14 +345,18 @@ errno_t gfx_puttext(gfx_coord2_t *pos, gfx_text_fmt_t *fmt, const char *str)
 		if (fmt->abbreviate && cpos.x + gmetrics.advance > rmargin)
 			break;
 
-		rc = gfx_glyph_render(glyph, &cpos);
-		if (rc != EOK)
-			return rc;
-
 		cp += stradv;
 		cpos.x += gmetrics.advance;
 	}
 
+	/* Render as a single cached run or, failing that, glyph by glyph */
+	rc = gfx_run_cache_render(fmt->font, str, cp - str, fmt->color, &spos);
+	if (rc != EOK) {
+		rc = gfx_puttext_glyphs(fmt->font, &spos, str, cp - str);
+		if (rc != EOK)
+			return rc;
+	}
+
 	/* Text underlining */
 	if (fmt->underline) {
 		gfx_font_get_metrics(fmt->font, &fmetrics);
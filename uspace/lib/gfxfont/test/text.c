@@ -30,8 +30,11 @@
 #include <gfx/context.h>
 #include <gfx/font.h>
 #include <gfx/glyph.h>
+#include <gfx/glyph_bmp.h>
 #include <gfx/text.h>
 #include <gfx/typeface.h>
+#include <io/pixel.h>
+#include <mem.h>
 #include <pcut/pcut.h>
 #include "../private/font.h"
 #include "../private/typeface.h"
@@ -64,6 +67,7 @@ typedef struct {
 	void *bm_pixels;
 	gfx_rect_t bm_srect;
 	gfx_coord2_t bm_offs;
+	int bm_created;
 } test_gc_t;
 
 typedef struct {
@@ -150,6 +154,110 @@ PCUT_TEST(dummy_puttext)
 	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
 }
 
+/** Text is rendered as a single cached run */
+PCUT_TEST(puttext_run_cache)
+{
+	gfx_font_props_t props;
+	gfx_font_metrics_t metrics;
+	gfx_glyph_metrics_t gmetrics;
+	gfx_typeface_t *tface;
+	gfx_font_t *font;
+	gfx_glyph_t *glyph;
+	gfx_glyph_bmp_t *bmp;
+	gfx_context_t *gc;
+	gfx_color_t *color;
+	gfx_text_fmt_t fmt;
+	gfx_coord2_t pos;
+	pixel_t *pixels;
+	test_gc_t tgc;
+	int created;
+	errno_t rc;
+
+	memset(&tgc, 0, sizeof(tgc));
+
+	rc = gfx_context_new(&test_ops, (void *)&tgc, &gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_color_new_rgb_i16(0xffff, 0, 0, &color);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_typeface_create(gc, &tface);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gfx_font_props_init(&props);
+	gfx_font_metrics_init(&metrics);
+	rc = gfx_font_create(tface, &props, &metrics, &font);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gfx_glyph_metrics_init(&gmetrics);
+	gmetrics.advance = 2;
+
+	rc = gfx_glyph_create(font, &gmetrics, &glyph);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_glyph_set_pattern(glyph, "A");
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_glyph_bmp_open(glyph, &bmp);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_glyph_bmp_setpix(bmp, 0, 0, 1);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_glyph_bmp_save(bmp);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	gfx_glyph_bmp_close(bmp);
+
+	gfx_text_fmt_init(&fmt);
+	fmt.font = font;
+	fmt.color = color;
+	pos.x = 10;
+	pos.y = 20;
+
+	/* First rendering creates the run bitmap */
+	created = tgc.bm_created;
+	rc = gfx_puttext(&pos, &fmt, "AA");
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_INT_EQUALS(created + 1, tgc.bm_created);
+
+	PCUT_ASSERT_INT_EQUALS(bmpf_color_key, tgc.bm_params.flags);
+	PCUT_ASSERT_INT_EQUALS(0, tgc.bm_params.rect.p0.x);
+	PCUT_ASSERT_INT_EQUALS(0, tgc.bm_params.rect.p0.y);
+	PCUT_ASSERT_INT_EQUALS(3, tgc.bm_params.rect.p1.x);
+	PCUT_ASSERT_INT_EQUALS(1, tgc.bm_params.rect.p1.y);
+
+	pixels = (pixel_t *) tgc.bm_pixels;
+	PCUT_ASSERT_INT_EQUALS(0xff, RED(pixels[0]));
+	PCUT_ASSERT_INT_EQUALS(tgc.bm_params.key_color, pixels[1]);
+	PCUT_ASSERT_INT_EQUALS(pixels[0], pixels[2]);
+	PCUT_ASSERT_TRUE(pixels[0] != tgc.bm_params.key_color);
+
+	PCUT_ASSERT_INT_EQUALS(10, tgc.bm_offs.x);
+	PCUT_ASSERT_INT_EQUALS(20, tgc.bm_offs.y);
+
+	/* Second rendering reuses it */
+	pos.x = 30;
+	rc = gfx_puttext(&pos, &fmt, "AA");
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_INT_EQUALS(created + 1, tgc.bm_created);
+	PCUT_ASSERT_INT_EQUALS(30, tgc.bm_offs.x);
+
+	/* Changing the glyph invalidates the cache */
+	rc = gfx_glyph_set_metrics(glyph, &gmetrics);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_puttext(&pos, &fmt, "AA");
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_INT_EQUALS(created + 2, tgc.bm_created);
+
+	gfx_font_close(font);
+	gfx_typeface_destroy(tface);
+	gfx_color_delete(color);
+
+	rc = gfx_context_delete(gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
 /** gfx_text_start_pos() correctly computes text start position */
 PCUT_TEST(text_start_pos)
 {
@@ -494,6 +602,7 @@ static errno_t testgc_bitmap_create(void *arg, gfx_bitmap_params_t *params,
 	}
 
 	tbm->tgc = tgc;
+	++tgc->bm_created;
 	tgc->bm_params = *params;
 	tgc->bm_pixels = tbm->alloc.pixels;
 	*rbm = (void *)tbm;
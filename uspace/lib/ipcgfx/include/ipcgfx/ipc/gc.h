@@ -36,6 +36,11 @@
 #define _IPCGFX_IPC_GC_H_
 
 #include <ipc/common.h>
+#include <stdint.h>
+#include <types/gfx/coord.h>
+
+/** Size of the command buffer shared by client and server */
+#define IPC_GC_BATCH_SIZE 4096
 
 typedef enum {
 	GC_SET_CLIP_RECT = IPC_FIRST_USER_METHOD,
@@ -48,8 +53,53 @@ typedef enum {
 	GC_BITMAP_DESTROY,
 	GC_BITMAP_RENDER,
 	GC_BITMAP_GET_ALLOC,
+	GC_BATCH_SETUP,
+	GC_BATCH_SUBMIT,
+	GC_COPY_AREA
 } gc_request_t;
 
+/** Command recorded in the command buffer */
+typedef enum {
+	GC_CMD_SET_CLIP_RECT,
+	GC_CMD_SET_CLIP_RECT_NULL,
+	GC_CMD_SET_RGB_COLOR,
+	GC_CMD_FILL_RECT,
+	GC_CMD_BITMAP_RENDER,
+	GC_CMD_UPDATE,
+	GC_CMD_COPY_AREA
+} gc_cmd_type_t;
+
+/** Entry of the command buffer */
+typedef struct {
+	/** Command type (gc_cmd_type_t) */
+	uint32_t type;
+	/** Bitmap ID for GC_CMD_BITMAP_RENDER */
+	sysarg_t bmp_id;
+	union {
+		/** Rectangle for GC_CMD_SET_CLIP_RECT, GC_CMD_FILL_RECT */
+		gfx_rect_t rect;
+		/** Color for GC_CMD_SET_RGB_COLOR */
+		struct {
+			uint16_t r;
+			uint16_t g;
+			uint16_t b;
+		} color;
+		/** Source rectangle and offset for GC_CMD_BITMAP_RENDER */
+		struct {
+			gfx_rect_t srect;
+			gfx_coord2_t offs;
+		} render;
+		/** Source rectangle and offset for GC_CMD_COPY_AREA */
+		struct {
+			gfx_rect_t rect;
+			gfx_coord2_t offs;
+		} copy;
+	} u;
+} gc_cmd_t;
+
+/** Number of commands fitting into the command buffer */
+#define IPC_GC_BATCH_CMDS (IPC_GC_BATCH_SIZE / sizeof(gc_cmd_t))
+
 #endif
 
 /** @}
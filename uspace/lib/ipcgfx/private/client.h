@@ -38,7 +38,9 @@
 #define _IPCGFX_PRIVATE_CLIENT_H
 
 #include <async.h>
+#include <fibril_synch.h>
 #include <gfx/context.h>
+#include <ipcgfx/ipc/gc.h>
 
 /** Actual structure of graphics context.
  *
@@ -49,6 +51,14 @@ struct ipc_gc {
 	gfx_context_t *gc;
 	/** Session with GFX server */
 	async_sess_t *sess;
+	/** Lock protecting the command buffer */
+	fibril_mutex_t lock;
+	/** Command buffer shared with server or @c NULL if not batching */
+	gc_cmd_t *batch;
+	/** Number of commands recorded in the command buffer */
+	size_t batch_count;
+	/** First error from a batch submitted implicitly */
+	errno_t batch_rc;
 };
 
 /** Bitmap in IPC GC */
@@ -42,6 +42,7 @@
 #include <gfx/bitmap.h>
 #include <gfx/context.h>
 #include <gfx/coord.h>
+#include <ipcgfx/ipc/gc.h>
 #include <stdbool.h>
 
 /** Server-side of IPC GC connection.
@@ -53,6 +54,8 @@ typedef struct {
 	list_t bitmaps;
 	/** Next bitmap ID to allocate */
 	sysarg_t next_bmp_id;
+	/** Command buffer shared by client or @c NULL */
+	gc_cmd_t *batch;
 } ipc_gc_srv_t;
 
 /** Bitmap in canvas GC */
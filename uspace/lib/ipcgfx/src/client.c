@@ -36,6 +36,8 @@
  */
 
 #include <as.h>
+#include <assert.h>
+#include <fibril_synch.h>
 #include <ipcgfx/client.h>
 #include <ipcgfx/ipc/gc.h>
 #include <gfx/color.h>
@@ -48,6 +50,7 @@ static errno_t ipc_gc_set_clip_rect(void *, gfx_rect_t *);
 static errno_t ipc_gc_set_color(void *, gfx_color_t *);
 static errno_t ipc_gc_fill_rect(void *, gfx_rect_t *);
 static errno_t ipc_gc_update(void *);
+static errno_t ipc_gc_copy_area(void *, gfx_rect_t *, gfx_coord2_t *);
 static errno_t ipc_gc_bitmap_create(void *, gfx_bitmap_params_t *,
     gfx_bitmap_alloc_t *, void **);
 static errno_t ipc_gc_bitmap_destroy(void *);
@@ -62,9 +65,77 @@ gfx_context_ops_t ipc_gc_ops = {
 	.bitmap_create = ipc_gc_bitmap_create,
 	.bitmap_destroy = ipc_gc_bitmap_destroy,
 	.bitmap_render = ipc_gc_bitmap_render,
-	.bitmap_get_alloc = ipc_gc_bitmap_get_alloc
+	.bitmap_get_alloc = ipc_gc_bitmap_get_alloc,
+	.copy_area = ipc_gc_copy_area
 };
 
+/** Submit commands recorded in the command buffer to the server.
+ *
+ * @param ipcgc IPC GC, its lock must be held
+ * @return EOK on success or the first error returned by the server
+ */
+static errno_t ipc_gc_batch_submit(ipc_gc_t *ipcgc)
+{
+	async_exch_t *exch;
+	errno_t rc;
+
+	assert(fibril_mutex_is_locked(&ipcgc->lock));
+
+	if (ipcgc->batch_count == 0)
+		return EOK;
+
+	exch = async_exchange_begin(ipcgc->sess);
+	rc = async_req_1_0(exch, GC_BATCH_SUBMIT, ipcgc->batch_count);
+	async_exchange_end(exch);
+
+	ipcgc->batch_count = 0;
+	return rc;
+}
+
+/** Submit command buffer, remembering the error for gfx_update().
+ *
+ * @param ipcgc IPC GC, its lock must be held
+ */
+static void ipc_gc_batch_flush(ipc_gc_t *ipcgc)
+{
+	errno_t rc;
+
+	rc = ipc_gc_batch_submit(ipcgc);
+	if (rc != EOK && ipcgc->batch_rc == EOK)
+		ipcgc->batch_rc = rc;
+}
+
+/** Record command in the command buffer.
+ *
+ * If the command buffer is full, it is submitted first.
+ *
+ * @param ipcgc IPC GC, its lock must be held
+ * @param cmd Command
+ */
+static void ipc_gc_batch_record(ipc_gc_t *ipcgc, gc_cmd_t *cmd)
+{
+	assert(fibril_mutex_is_locked(&ipcgc->lock));
+
+	if (ipcgc->batch_count >= IPC_GC_BATCH_CMDS)
+		ipc_gc_batch_flush(ipcgc);
+
+	ipcgc->batch[ipcgc->batch_count++] = *cmd;
+}
+
+/** Add command to the command buffer.
+ *
+ * @param ipcgc IPC GC
+ * @param cmd Command
+ * @return EOK
+ */
+static errno_t ipc_gc_batch_add(ipc_gc_t *ipcgc, gc_cmd_t *cmd)
+{
+	fibril_mutex_lock(&ipcgc->lock);
+	ipc_gc_batch_record(ipcgc, cmd);
+	fibril_mutex_unlock(&ipcgc->lock);
+	return EOK;
+}
+
 /** Set clipping rectangle on IPC GC.
  *
  * @param arg IPC GC
@@ -76,8 +147,20 @@ static errno_t ipc_gc_set_clip_rect(void *arg, gfx_rect_t *rect)
 {
 	ipc_gc_t *ipcgc = (ipc_gc_t *) arg;
 	async_exch_t *exch;
+	gc_cmd_t cmd;
 	errno_t rc;
 
+	if (ipcgc->batch != NULL) {
+		if (rect != NULL) {
+			cmd.type = GC_CMD_SET_CLIP_RECT;
+			cmd.u.rect = *rect;
+		} else {
+			cmd.type = GC_CMD_SET_CLIP_RECT_NULL;
+		}
+
+		return ipc_gc_batch_add(ipcgc, &cmd);
+	}
+
 	exch = async_exchange_begin(ipcgc->sess);
 	if (rect != NULL) {
 		rc = async_req_4_0(exch, GC_SET_CLIP_RECT, rect->p0.x, rect->p0.y,
@@ -105,10 +188,19 @@ static errno_t ipc_gc_set_color(void *arg, gfx_color_t *color)
 	ipc_gc_t *ipcgc = (ipc_gc_t *) arg;
 	async_exch_t *exch;
 	uint16_t r, g, b;
+	gc_cmd_t cmd;
 	errno_t rc;
 
 	gfx_color_get_rgb_i16(color, &r, &g, &b);
 
+	if (ipcgc->batch != NULL) {
+		cmd.type = GC_CMD_SET_RGB_COLOR;
+		cmd.u.color.r = r;
+		cmd.u.color.g = g;
+		cmd.u.color.b = b;
+		return ipc_gc_batch_add(ipcgc, &cmd);
+	}
+
 	exch = async_exchange_begin(ipcgc->sess);
 	rc = async_req_3_0(exch, GC_SET_RGB_COLOR, r, g, b);
 	async_exchange_end(exch);
@@ -127,8 +219,15 @@ static errno_t ipc_gc_fill_rect(void *arg, gfx_rect_t *rect)
 {
 	ipc_gc_t *ipcgc = (ipc_gc_t *) arg;
 	async_exch_t *exch;
+	gc_cmd_t cmd;
 	errno_t rc;
 
+	if (ipcgc->batch != NULL) {
+		cmd.type = GC_CMD_FILL_RECT;
+		cmd.u.rect = *rect;
+		return ipc_gc_batch_add(ipcgc, &cmd);
+	}
+
 	exch = async_exchange_begin(ipcgc->sess);
 	rc = async_req_4_0(exch, GC_FILL_RECT, rect->p0.x, rect->p0.y,
 	    rect->p1.x, rect->p1.y);
@@ -137,7 +236,49 @@ static errno_t ipc_gc_fill_rect(void *arg, gfx_rect_t *rect)
 	return rc;
 }
 
+/** Copy area on IPC GC.
+ *
+ * @param arg IPC GC
+ * @param rect Source rectangle
+ * @param offs Offset of the destination rectangle
+ *
+ * @return EOK on success or an error code
+ */
+static errno_t ipc_gc_copy_area(void *arg, gfx_rect_t *rect,
+    gfx_coord2_t *offs)
+{
+	ipc_gc_t *ipcgc = (ipc_gc_t *) arg;
+	async_exch_t *exch;
+	ipc_call_t answer;
+	gc_cmd_t cmd;
+	aid_t req;
+	errno_t rc;
+
+	if (ipcgc->batch != NULL) {
+		cmd.type = GC_CMD_COPY_AREA;
+		cmd.u.copy.rect = *rect;
+		cmd.u.copy.offs = *offs;
+		return ipc_gc_batch_add(ipcgc, &cmd);
+	}
+
+	exch = async_exchange_begin(ipcgc->sess);
+	req = async_send_2(exch, GC_COPY_AREA, offs->x, offs->y, &answer);
+
+	rc = async_data_write_start(exch, rect, sizeof (gfx_rect_t));
+	async_exchange_end(exch);
+	if (rc != EOK) {
+		async_forget(req);
+		return rc;
+	}
+
+	async_wait_for(req, &rc);
+	return rc;
+}
+
 /** Update display on IPC GC.
+ *
+ * In batch mode this submits the command buffer and reports the first
+ * error of any operation recorded since the last update.
  *
  * @param arg IPC GC
  *
@@ -147,8 +288,26 @@ static errno_t ipc_gc_update(void *arg)
 {
 	ipc_gc_t *ipcgc = (ipc_gc_t *) arg;
 	async_exch_t *exch;
+	gc_cmd_t cmd;
 	errno_t rc;
 
+	if (ipcgc->batch != NULL) {
+		fibril_mutex_lock(&ipcgc->lock);
+
+		cmd.type = GC_CMD_UPDATE;
+		ipc_gc_batch_record(ipcgc, &cmd);
+		rc = ipc_gc_batch_submit(ipcgc);
+
+		if (ipcgc->batch_rc != EOK) {
+			if (rc == EOK)
+				rc = ipcgc->batch_rc;
+			ipcgc->batch_rc = EOK;
+		}
+
+		fibril_mutex_unlock(&ipcgc->lock);
+		return rc;
+	}
+
 	exch = async_exchange_begin(ipcgc->sess);
 	rc = async_req_0_0(exch, GC_UPDATE);
 	async_exchange_end(exch);
@@ -360,10 +519,18 @@ errno_t ipc_gc_bitmap_create(void *arg, gfx_bitmap_params_t *params,
 static errno_t ipc_gc_bitmap_destroy(void *bm)
 {
 	ipc_gc_bitmap_t *ipcbm = (ipc_gc_bitmap_t *)bm;
+	ipc_gc_t *ipcgc = ipcbm->ipcgc;
 	async_exch_t *exch;
 	errno_t rc;
 
-	exch = async_exchange_begin(ipcbm->ipcgc->sess);
+	/* Recorded commands might refer to the bitmap */
+	if (ipcgc->batch != NULL) {
+		fibril_mutex_lock(&ipcgc->lock);
+		ipc_gc_batch_flush(ipcgc);
+		fibril_mutex_unlock(&ipcgc->lock);
+	}
+
+	exch = async_exchange_begin(ipcgc->sess);
 	rc = async_req_1_0(exch, GC_BITMAP_DESTROY, ipcbm->bmp_id);
 	async_exchange_end(exch);
 
@@ -392,6 +559,7 @@ static errno_t ipc_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 	gfx_coord2_t offs;
 	async_exch_t *exch = NULL;
 	ipc_call_t answer;
+	gc_cmd_t cmd;
 	aid_t req;
 	errno_t rc;
 
@@ -410,6 +578,14 @@ static errno_t ipc_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 	/* Destination rectangle */
 	gfx_rect_translate(&offs, &srect, &drect);
 
+	if (ipcbm->ipcgc->batch != NULL) {
+		cmd.type = GC_CMD_BITMAP_RENDER;
+		cmd.bmp_id = ipcbm->bmp_id;
+		cmd.u.render.srect = srect;
+		cmd.u.render.offs = offs;
+		return ipc_gc_batch_add(ipcbm->ipcgc, &cmd);
+	}
+
 	exch = async_exchange_begin(ipcbm->ipcgc->sess);
 	req = async_send_3(exch, GC_BITMAP_RENDER, ipcbm->bmp_id, offs.x,
 	    offs.y, &answer);
@@ -474,6 +650,7 @@ errno_t ipc_gc_create(async_sess_t *sess, ipc_gc_t **rgc)
 
 	ipcgc->gc = gc;
 	ipcgc->sess = sess;
+	fibril_mutex_initialize(&ipcgc->lock);
 	*rgc = ipcgc;
 	return EOK;
 error:
@@ -495,10 +672,74 @@ errno_t ipc_gc_delete(ipc_gc_t *ipcgc)
 	if (rc != EOK)
 		return rc;
 
+	if (ipcgc->batch != NULL) {
+		fibril_mutex_lock(&ipcgc->lock);
+		(void) ipc_gc_batch_submit(ipcgc);
+		fibril_mutex_unlock(&ipcgc->lock);
+		as_area_destroy(ipcgc->batch);
+	}
+
 	free(ipcgc);
 	return EOK;
 }
 
+/** Enable batch mode on IPC GC.
+ *
+ * In batch mode, setting clipping rectangle and color, filling rectangles,
+ * copying areas and rendering bitmaps are recorded in a command buffer
+ * shared with the server instead of being sent one by one. The command
+ * buffer is submitted by gfx_update(), when it becomes full or before
+ * a bitmap is destroyed. The server executes all the commands in one go.
+ *
+ * The caller must call gfx_update() to make its drawing visible. Errors of
+ * the recorded operations are reported by gfx_update(). Bitmap pixels
+ * are read by the server when the command buffer is submitted, not when
+ * gfx_bitmap_render() is called.
+ *
+ * @param ipcgc IPC GC
+ * @return EOK on success, error code if the server does not support
+ *         batch mode (the GC then keeps working without it)
+ */
+errno_t ipc_gc_batch_enable(ipc_gc_t *ipcgc)
+{
+	async_exch_t *exch;
+	ipc_call_t answer;
+	gc_cmd_t *batch;
+	aid_t req;
+	errno_t rc;
+
+	if (ipcgc->batch != NULL)
+		return EOK;
+
+	batch = as_area_create(AS_AREA_ANY, IPC_GC_BATCH_SIZE, AS_AREA_READ |
+	    AS_AREA_WRITE | AS_AREA_CACHEABLE, AS_AREA_UNPAGED);
+	if (batch == AS_MAP_FAILED)
+		return ENOMEM;
+
+	exch = async_exchange_begin(ipcgc->sess);
+	req = async_send_0(exch, GC_BATCH_SETUP, &answer);
+	rc = async_share_out_start(exch, batch, AS_AREA_READ |
+	    AS_AREA_CACHEABLE);
+	async_exchange_end(exch);
+
+	if (rc != EOK) {
+		async_forget(req);
+		as_area_destroy(batch);
+		return rc;
+	}
+
+	async_wait_for(req, &rc);
+	if (rc != EOK) {
+		as_area_destroy(batch);
+		return rc;
+	}
+
+	ipcgc->batch_count = 0;
+	ipcgc->batch_rc = EOK;
+	ipcgc->batch = batch;
+	return EOK;
+}
+
 /** Get generic graphic context from IPC GC.
  *
  * @param ipcgc IPC GC
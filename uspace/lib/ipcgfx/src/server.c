@@ -106,6 +106,40 @@ static void gc_fill_rect_srv(ipc_gc_srv_t *srvgc, ipc_call_t *call)
 	async_answer_0(call, rc);
 }
 
+static void gc_copy_area_srv(ipc_gc_srv_t *srvgc, ipc_call_t *icall)
+{
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	ipc_call_t call;
+	size_t size;
+	errno_t rc;
+
+	if (!async_data_write_receive(&call, &size)) {
+		async_answer_0(&call, EREFUSED);
+		async_answer_0(icall, EREFUSED);
+		return;
+	}
+
+	if (size != sizeof(gfx_rect_t)) {
+		async_answer_0(&call, EINVAL);
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	rc = async_data_write_finalize(&call, &rect, size);
+	if (rc != EOK) {
+		async_answer_0(&call, rc);
+		async_answer_0(icall, rc);
+		return;
+	}
+
+	offs.x = ipc_get_arg1(icall);
+	offs.y = ipc_get_arg2(icall);
+
+	rc = gfx_copy_area(srvgc->gc, &rect, &offs);
+	async_answer_0(icall, rc);
+}
+
 static void gc_update_srv(ipc_gc_srv_t *srvgc, ipc_call_t *call)
 {
 	errno_t rc;
@@ -359,6 +393,110 @@ static void gc_bitmap_render_srv(ipc_gc_srv_t *srvgc, ipc_call_t *icall)
 	async_answer_0(icall, rc);
 }
 
+static void gc_batch_setup_srv(ipc_gc_srv_t *srvgc, ipc_call_t *icall)
+{
+	ipc_call_t call;
+	size_t size;
+	unsigned int flags;
+	void *batch;
+	errno_t rc;
+
+	if (!async_share_out_receive(&call, &size, &flags)) {
+		async_answer_0(&call, EINVAL);
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	if (size != IPC_GC_BATCH_SIZE) {
+		async_answer_0(&call, EINVAL);
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	rc = async_share_out_finalize(&call, &batch);
+	if (rc != EOK || batch == AS_MAP_FAILED) {
+		async_answer_0(icall, ENOMEM);
+		return;
+	}
+
+	if (srvgc->batch != NULL)
+		as_area_destroy(srvgc->batch);
+	srvgc->batch = batch;
+
+	async_answer_0(icall, EOK);
+}
+
+/** Execute one command from the command buffer.
+ *
+ * @param srvgc Server GC
+ * @param cmd Command (a copy not modifiable by the client)
+ * @return EOK on success or an error code
+ */
+static errno_t gc_batch_cmd_exec(ipc_gc_srv_t *srvgc, gc_cmd_t *cmd)
+{
+	ipc_gc_srv_bitmap_t *bitmap;
+	gfx_color_t *color;
+	errno_t rc;
+
+	switch (cmd->type) {
+	case GC_CMD_SET_CLIP_RECT:
+		return gfx_set_clip_rect(srvgc->gc, &cmd->u.rect);
+	case GC_CMD_SET_CLIP_RECT_NULL:
+		return gfx_set_clip_rect(srvgc->gc, NULL);
+	case GC_CMD_SET_RGB_COLOR:
+		rc = gfx_color_new_rgb_i16(cmd->u.color.r, cmd->u.color.g,
+		    cmd->u.color.b, &color);
+		if (rc != EOK)
+			return ENOMEM;
+
+		rc = gfx_set_color(srvgc->gc, color);
+		gfx_color_delete(color);
+		return rc;
+	case GC_CMD_FILL_RECT:
+		return gfx_fill_rect(srvgc->gc, &cmd->u.rect);
+	case GC_CMD_BITMAP_RENDER:
+		bitmap = gc_bitmap_lookup(srvgc, cmd->bmp_id);
+		if (bitmap == NULL)
+			return ENOENT;
+
+		return gfx_bitmap_render(bitmap->bmp, &cmd->u.render.srect,
+		    &cmd->u.render.offs);
+	case GC_CMD_UPDATE:
+		return gfx_update(srvgc->gc);
+	case GC_CMD_COPY_AREA:
+		return gfx_copy_area(srvgc->gc, &cmd->u.copy.rect,
+		    &cmd->u.copy.offs);
+	default:
+		return EINVAL;
+	}
+}
+
+static void gc_batch_submit_srv(ipc_gc_srv_t *srvgc, ipc_call_t *call)
+{
+	gc_cmd_t cmd;
+	size_t count;
+	size_t i;
+	errno_t rc;
+	errno_t first_rc = EOK;
+
+	count = ipc_get_arg1(call);
+
+	if (srvgc->batch == NULL || count > IPC_GC_BATCH_CMDS) {
+		async_answer_0(call, EINVAL);
+		return;
+	}
+
+	/* Execute all commands, report the first failure */
+	for (i = 0; i < count; i++) {
+		cmd = srvgc->batch[i];
+		rc = gc_batch_cmd_exec(srvgc, &cmd);
+		if (rc != EOK && first_rc == EOK)
+			first_rc = rc;
+	}
+
+	async_answer_0(call, first_rc);
+}
+
 errno_t gc_conn(ipc_call_t *icall, gfx_context_t *gc)
 {
 	ipc_gc_srv_t srvgc;
@@ -371,6 +509,7 @@ errno_t gc_conn(ipc_call_t *icall, gfx_context_t *gc)
 	srvgc.gc = gc;
 	list_initialize(&srvgc.bitmaps);
 	srvgc.next_bmp_id = 1;
+	srvgc.batch = NULL;
 
 	while (true) {
 		ipc_call_t call;
@@ -411,6 +550,15 @@ errno_t gc_conn(ipc_call_t *icall, gfx_context_t *gc)
 		case GC_BITMAP_RENDER:
 			gc_bitmap_render_srv(&srvgc, &call);
 			break;
+		case GC_BATCH_SETUP:
+			gc_batch_setup_srv(&srvgc, &call);
+			break;
+		case GC_BATCH_SUBMIT:
+			gc_batch_submit_srv(&srvgc, &call);
+			break;
+		case GC_COPY_AREA:
+			gc_copy_area_srv(&srvgc, &call);
+			break;
 		default:
 			async_answer_0(&call, EINVAL);
 			break;
@@ -437,6 +585,9 @@ errno_t gc_conn(ipc_call_t *icall, gfx_context_t *gc)
 		link = list_first(&srvgc.bitmaps);
 	}
 
+	if (srvgc.batch != NULL)
+		as_area_destroy(srvgc.batch);
+
 	return EOK;
 }
 
@@ -35,6 +35,7 @@
 #include <gfx/context.h>
 #include <gfx/render.h>
 #include <ipcgfx/client.h>
+#include <ipcgfx/ipc/gc.h>
 #include <ipcgfx/server.h>
 #include <loc.h>
 #include <pcut/pcut.h>
@@ -53,6 +54,7 @@ static errno_t test_gc_set_clip_rect(void *, gfx_rect_t *);
 static errno_t test_gc_set_color(void *, gfx_color_t *);
 static errno_t test_gc_fill_rect(void *, gfx_rect_t *);
 static errno_t test_gc_update(void *);
+static errno_t test_gc_copy_area(void *, gfx_rect_t *, gfx_coord2_t *);
 static errno_t test_gc_bitmap_create(void *, gfx_bitmap_params_t *,
     gfx_bitmap_alloc_t *, void **);
 static errno_t test_gc_bitmap_destroy(void *);
@@ -67,7 +69,8 @@ static gfx_context_ops_t test_gc_ops = {
 	.bitmap_create = test_gc_bitmap_create,
 	.bitmap_destroy = test_gc_bitmap_destroy,
 	.bitmap_render = test_gc_bitmap_render,
-	.bitmap_get_alloc = test_gc_bitmap_get_alloc
+	.bitmap_get_alloc = test_gc_bitmap_get_alloc,
+	.copy_area = test_gc_copy_area
 };
 
 /** Describes to the server how to respond to our request and pass tracking
@@ -90,6 +93,10 @@ typedef struct {
 
 	bool update_called;
 
+	bool copy_area_called;
+	gfx_rect_t copy_area_rect;
+	gfx_coord2_t copy_area_offs;
+
 	bool bitmap_create_called;
 	gfx_bitmap_params_t bitmap_create_params;
 	gfx_bitmap_alloc_t bitmap_create_alloc;
@@ -453,6 +460,116 @@ PCUT_TEST(fill_rect_success)
 	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
 }
 
+/** gfx_copy_area with server returning failure */
+PCUT_TEST(copy_area_failure)
+{
+	errno_t rc;
+	service_id_t sid;
+	test_response_t resp;
+	gfx_context_t *gc;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	async_sess_t *sess;
+	ipc_gc_t *ipcgc;
+
+	async_set_fallback_port_handler(test_ipcgc_conn, &resp);
+
+	// FIXME This causes this test to be non-reentrant!
+	rc = loc_server_register(test_ipcgfx_server);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = loc_service_register(test_ipcgfx_svc, &sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	sess = loc_service_connect(sid, INTERFACE_GC, 0);
+	PCUT_ASSERT_NOT_NULL(sess);
+
+	rc = ipc_gc_create(sess, &ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = ipc_gc_get_ctx(ipcgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	resp.rc = ENOMEM;
+	resp.copy_area_called = false;
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	offs.x = 5;
+	offs.y = -6;
+	rc = gfx_copy_area(gc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(ENOMEM, rc);
+	PCUT_ASSERT_TRUE(resp.copy_area_called);
+	PCUT_ASSERT_EQUALS(rect.p0.x, resp.copy_area_rect.p0.x);
+	PCUT_ASSERT_EQUALS(rect.p0.y, resp.copy_area_rect.p0.y);
+	PCUT_ASSERT_EQUALS(rect.p1.x, resp.copy_area_rect.p1.x);
+	PCUT_ASSERT_EQUALS(rect.p1.y, resp.copy_area_rect.p1.y);
+	PCUT_ASSERT_EQUALS(offs.x, resp.copy_area_offs.x);
+	PCUT_ASSERT_EQUALS(offs.y, resp.copy_area_offs.y);
+
+	ipc_gc_delete(ipcgc);
+	async_hangup(sess);
+
+	rc = loc_service_unregister(sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
+/** gfx_copy_area with server returning success */
+PCUT_TEST(copy_area_success)
+{
+	errno_t rc;
+	service_id_t sid;
+	test_response_t resp;
+	gfx_context_t *gc;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	async_sess_t *sess;
+	ipc_gc_t *ipcgc;
+
+	async_set_fallback_port_handler(test_ipcgc_conn, &resp);
+
+	// FIXME This causes this test to be non-reentrant!
+	rc = loc_server_register(test_ipcgfx_server);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = loc_service_register(test_ipcgfx_svc, &sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	sess = loc_service_connect(sid, INTERFACE_GC, 0);
+	PCUT_ASSERT_NOT_NULL(sess);
+
+	rc = ipc_gc_create(sess, &ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = ipc_gc_get_ctx(ipcgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	resp.rc = EOK;
+	resp.copy_area_called = false;
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	offs.x = 5;
+	offs.y = -6;
+	rc = gfx_copy_area(gc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_TRUE(resp.copy_area_called);
+	PCUT_ASSERT_EQUALS(rect.p0.x, resp.copy_area_rect.p0.x);
+	PCUT_ASSERT_EQUALS(rect.p0.y, resp.copy_area_rect.p0.y);
+	PCUT_ASSERT_EQUALS(rect.p1.x, resp.copy_area_rect.p1.x);
+	PCUT_ASSERT_EQUALS(rect.p1.y, resp.copy_area_rect.p1.y);
+	PCUT_ASSERT_EQUALS(offs.x, resp.copy_area_offs.x);
+	PCUT_ASSERT_EQUALS(offs.y, resp.copy_area_offs.y);
+
+	ipc_gc_delete(ipcgc);
+	async_hangup(sess);
+
+	rc = loc_service_unregister(sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
 /** gfx_update with server returning failure */
 PCUT_TEST(update_failure)
 {
@@ -535,6 +652,190 @@ PCUT_TEST(update_success)
 	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
 }
 
+/** Batch mode defers fill rect until gfx_update */
+PCUT_TEST(batch_fill_rect_update_success)
+{
+	errno_t rc;
+	service_id_t sid;
+	test_response_t resp;
+	gfx_context_t *gc;
+	gfx_rect_t rect;
+	async_sess_t *sess;
+	ipc_gc_t *ipcgc;
+
+	async_set_fallback_port_handler(test_ipcgc_conn, &resp);
+
+	// FIXME This causes this test to be non-reentrant!
+	rc = loc_server_register(test_ipcgfx_server);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = loc_service_register(test_ipcgfx_svc, &sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	sess = loc_service_connect(sid, INTERFACE_GC, 0);
+	PCUT_ASSERT_NOT_NULL(sess);
+
+	rc = ipc_gc_create(sess, &ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = ipc_gc_batch_enable(ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = ipc_gc_get_ctx(ipcgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	resp.rc = EOK;
+	resp.fill_rect_called = false;
+	resp.update_called = false;
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	rc = gfx_fill_rect(gc, &rect);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_FALSE(resp.fill_rect_called);
+
+	rc = gfx_update(gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_TRUE(resp.fill_rect_called);
+	PCUT_ASSERT_EQUALS(rect.p0.x, resp.fill_rect_rect.p0.x);
+	PCUT_ASSERT_EQUALS(rect.p0.y, resp.fill_rect_rect.p0.y);
+	PCUT_ASSERT_EQUALS(rect.p1.x, resp.fill_rect_rect.p1.x);
+	PCUT_ASSERT_EQUALS(rect.p1.y, resp.fill_rect_rect.p1.y);
+	PCUT_ASSERT_TRUE(resp.update_called);
+
+	ipc_gc_delete(ipcgc);
+	async_hangup(sess);
+
+	rc = loc_service_unregister(sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
+/** Batch mode records gfx_copy_area and executes it on gfx_update */
+PCUT_TEST(batch_copy_area_success)
+{
+	errno_t rc;
+	service_id_t sid;
+	test_response_t resp;
+	gfx_context_t *gc;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	async_sess_t *sess;
+	ipc_gc_t *ipcgc;
+
+	async_set_fallback_port_handler(test_ipcgc_conn, &resp);
+
+	// FIXME This causes this test to be non-reentrant!
+	rc = loc_server_register(test_ipcgfx_server);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = loc_service_register(test_ipcgfx_svc, &sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	sess = loc_service_connect(sid, INTERFACE_GC, 0);
+	PCUT_ASSERT_NOT_NULL(sess);
+
+	rc = ipc_gc_create(sess, &ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = ipc_gc_batch_enable(ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = ipc_gc_get_ctx(ipcgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	resp.rc = EOK;
+	resp.copy_area_called = false;
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	offs.x = 5;
+	offs.y = -6;
+	rc = gfx_copy_area(gc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_FALSE(resp.copy_area_called);
+
+	rc = gfx_update(gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	PCUT_ASSERT_TRUE(resp.copy_area_called);
+	PCUT_ASSERT_EQUALS(rect.p0.x, resp.copy_area_rect.p0.x);
+	PCUT_ASSERT_EQUALS(rect.p0.y, resp.copy_area_rect.p0.y);
+	PCUT_ASSERT_EQUALS(rect.p1.x, resp.copy_area_rect.p1.x);
+	PCUT_ASSERT_EQUALS(rect.p1.y, resp.copy_area_rect.p1.y);
+	PCUT_ASSERT_EQUALS(offs.x, resp.copy_area_offs.x);
+	PCUT_ASSERT_EQUALS(offs.y, resp.copy_area_offs.y);
+
+	ipc_gc_delete(ipcgc);
+	async_hangup(sess);
+
+	rc = loc_service_unregister(sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
+/** Batch mode reports failure of recorded operation from gfx_update */
+PCUT_TEST(batch_fill_rect_failure)
+{
+	errno_t rc;
+	service_id_t sid;
+	test_response_t resp;
+	gfx_context_t *gc;
+	gfx_rect_t rect;
+	async_sess_t *sess;
+	ipc_gc_t *ipcgc;
+	size_t i;
+
+	async_set_fallback_port_handler(test_ipcgc_conn, &resp);
+
+	// FIXME This causes this test to be non-reentrant!
+	rc = loc_server_register(test_ipcgfx_server);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = loc_service_register(test_ipcgfx_svc, &sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	sess = loc_service_connect(sid, INTERFACE_GC, 0);
+	PCUT_ASSERT_NOT_NULL(sess);
+
+	rc = ipc_gc_create(sess, &ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = ipc_gc_batch_enable(ipcgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = ipc_gc_get_ctx(ipcgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	resp.rc = ENOMEM;
+	resp.fill_rect_called = false;
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+
+	/* Overflow the command buffer so that it is submitted implicitly */
+	for (i = 0; i < 2 * IPC_GC_BATCH_SIZE / sizeof(gfx_rect_t); i++) {
+		rc = gfx_fill_rect(gc, &rect);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	}
+
+	PCUT_ASSERT_TRUE(resp.fill_rect_called);
+
+	resp.rc = EOK;
+	rc = gfx_update(gc);
+	PCUT_ASSERT_ERRNO_VAL(ENOMEM, rc);
+
+	/* Error has been reported */
+	rc = gfx_update(gc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	ipc_gc_delete(ipcgc);
+	async_hangup(sess);
+
+	rc = loc_service_unregister(sid);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+}
+
 /** gfx_bitmap_create with server returning failure */
 PCUT_TEST(bitmap_create_failure)
 {
@@ -1104,6 +1405,25 @@ static errno_t test_gc_fill_rect(void *arg, gfx_rect_t *rect)
 	return resp->rc;
 }
 
+/** Copy area in test GC.
+ *
+ * @param arg Test GC
+ * @param rect Source rectangle
+ * @param offs Offset of the destination rectangle
+ *
+ * @return EOK on success or an error code
+ */
+static errno_t test_gc_copy_area(void *arg, gfx_rect_t *rect,
+    gfx_coord2_t *offs)
+{
+	test_response_t *resp = (test_response_t *) arg;
+
+	resp->copy_area_called = true;
+	resp->copy_area_rect = *rect;
+	resp->copy_area_offs = *offs;
+	return resp->rc;
+}
+
 /** Update test GC.
  *
  * @param arg Test GC
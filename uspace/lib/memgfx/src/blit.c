@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libmemgfx
+ * @{
+ */
+/**
+ * @file Row blitting kernels
+ *
+ * Kernels operating on one row of pixels at a time. Where the target
+ * has SIMD registers (SSE2, NEON) the color-keyed kernels process four
+ * pixels at once using a compare-and-select sequence written with the
+ * compiler vector extension, otherwise they fall back to scalar code.
+ */
+
+#include <mem.h>
+#include <stdint.h>
+#include "../private/blit.h"
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define MEM_BLIT_VECTOR
+#endif
+
+#ifdef MEM_BLIT_VECTOR
+
+/** Number of pixels in one vector */
+#define MEM_BLIT_VLEN 4
+
+/** Vector of pixels */
+typedef uint32_t mem_blit_vec_t __attribute__((vector_size(16)));
+
+/** Load vector of pixels from possibly unaligned address. */
+static inline mem_blit_vec_t mem_blit_vload(const pixel_t *p)
+{
+	mem_blit_vec_t v;
+
+	__builtin_memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+/** Store vector of pixels to possibly unaligned address. */
+static inline void mem_blit_vstore(pixel_t *p, mem_blit_vec_t v)
+{
+	__builtin_memcpy(p, &v, sizeof(v));
+}
+
+/** Broadcast pixel to all vector lanes. */
+static inline mem_blit_vec_t mem_blit_vdup(pixel_t pixel)
+{
+	mem_blit_vec_t v = { pixel, pixel, pixel, pixel };
+	return v;
+}
+
+#endif
+
+/** Fill row of pixels with a color.
+ *
+ * @param dst Destination
+ * @param count Number of pixels
+ * @param color Fill color
+ */
+void mem_blit_fill(pixel_t *dst, size_t count, pixel_t color)
+{
+	size_t i = 0;
+
+#ifdef MEM_BLIT_VECTOR
+	mem_blit_vec_t vcolor = mem_blit_vdup(color);
+
+	for (; i + MEM_BLIT_VLEN <= count; i += MEM_BLIT_VLEN)
+		mem_blit_vstore(dst + i, vcolor);
+#endif
+	for (; i < count; i++)
+		dst[i] = color;
+}
+
+/** Copy row of pixels.
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param count Number of pixels
+ */
+void mem_blit_copy(pixel_t *dst, const pixel_t *src, size_t count)
+{
+	memmove(dst, src, count * sizeof(pixel_t));
+}
+
+/** Copy row of pixels, skipping pixels equal to the key color.
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param count Number of pixels
+ * @param key Key color
+ */
+void mem_blit_key(pixel_t *dst, const pixel_t *src, size_t count,
+    pixel_t key)
+{
+	size_t i = 0;
+
+#ifdef MEM_BLIT_VECTOR
+	mem_blit_vec_t vkey = mem_blit_vdup(key);
+
+	for (; i + MEM_BLIT_VLEN <= count; i += MEM_BLIT_VLEN) {
+		mem_blit_vec_t s = mem_blit_vload(src + i);
+		mem_blit_vec_t d = mem_blit_vload(dst + i);
+		mem_blit_vec_t mask = (mem_blit_vec_t) (s != vkey);
+
+		mem_blit_vstore(dst + i, (s & mask) | (d & ~mask));
+	}
+#endif
+	for (; i < count; i++) {
+		if (src[i] != key)
+			dst[i] = src[i];
+	}
+}
+
+/** Paint pixels not equal to the key color with a solid color.
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param count Number of pixels
+ * @param key Key color
+ * @param color Color to paint with
+ */
+void mem_blit_colorize(pixel_t *dst, const pixel_t *src, size_t count,
+    pixel_t key, pixel_t color)
+{
+	size_t i = 0;
+
+#ifdef MEM_BLIT_VECTOR
+	mem_blit_vec_t vkey = mem_blit_vdup(key);
+	mem_blit_vec_t vcolor = mem_blit_vdup(color);
+
+	for (; i + MEM_BLIT_VLEN <= count; i += MEM_BLIT_VLEN) {
+		mem_blit_vec_t s = mem_blit_vload(src + i);
+		mem_blit_vec_t d = mem_blit_vload(dst + i);
+		mem_blit_vec_t mask = (mem_blit_vec_t) (s != vkey);
+
+		mem_blit_vstore(dst + i, (vcolor & mask) | (d & ~mask));
+	}
+#endif
+	for (; i < count; i++) {
+		if (src[i] != key)
+			dst[i] = color;
+	}
+}
+
+/** @}
+ */
@@ -42,9 +42,10 @@
 #include <gfx/context.h>
 #include <gfx/render.h>
 #include <io/pixel.h>
-#include <io/pixelmap.h>
+#include <mem.h>
 #include <memgfx/memgc.h>
 #include <stdlib.h>
+#include "../private/blit.h"
 #include "../private/memgc.h"
 
 static errno_t mem_gc_set_clip_rect(void *, gfx_rect_t *);
@@ -59,6 +60,7 @@ static errno_t mem_gc_bitmap_get_alloc(void *, gfx_bitmap_alloc_t *);
 static errno_t mem_gc_cursor_get_pos(void *, gfx_coord2_t *);
 static errno_t mem_gc_cursor_set_pos(void *, gfx_coord2_t *);
 static errno_t mem_gc_cursor_set_visible(void *, bool);
+static errno_t mem_gc_copy_area(void *, gfx_rect_t *, gfx_coord2_t *);
 static void mem_gc_invalidate_rect(mem_gc_t *, gfx_rect_t *);
 
 gfx_context_ops_t mem_gc_ops = {
@@ -72,7 +74,8 @@ gfx_context_ops_t mem_gc_ops = {
 	.bitmap_get_alloc = mem_gc_bitmap_get_alloc,
 	.cursor_get_pos = mem_gc_cursor_get_pos,
 	.cursor_set_pos = mem_gc_cursor_set_pos,
-	.cursor_set_visible = mem_gc_cursor_set_visible
+	.cursor_set_visible = mem_gc_cursor_set_visible,
+	.copy_area = mem_gc_copy_area
 };
 
 /** Set clipping rectangle on memory GC.
@@ -126,8 +129,8 @@ static errno_t mem_gc_fill_rect(void *arg, gfx_rect_t *rect)
 {
 	mem_gc_t *mgc = (mem_gc_t *) arg;
 	gfx_rect_t crect;
-	gfx_coord_t x, y;
-	pixelmap_t pixelmap;
+	gfx_coord_t y;
+	pixel_t *row;
 
 	/* Make sure we have a sorted, clipped rectangle */
 	gfx_rect_clip(rect, &mgc->clip_rect, &crect);
@@ -135,13 +138,77 @@ static errno_t mem_gc_fill_rect(void *arg, gfx_rect_t *rect)
 	assert(mgc->rect.p0.x == 0);
 	assert(mgc->rect.p0.y == 0);
 	assert(mgc->alloc.pitch == mgc->rect.p1.x * (int)sizeof(uint32_t));
-	pixelmap.width = mgc->rect.p1.x;
-	pixelmap.height = mgc->rect.p1.y;
-	pixelmap.data = mgc->alloc.pixels;
 
-	for (y = crect.p0.y; y < crect.p1.y; y++) {
-		for (x = crect.p0.x; x < crect.p1.x; x++) {
-			pixelmap_put_pixel(&pixelmap, x, y, mgc->color);
+	if (!gfx_rect_is_empty(&crect)) {
+		row = (pixel_t *) mgc->alloc.pixels +
+		    crect.p0.y * mgc->rect.p1.x + crect.p0.x;
+		for (y = crect.p0.y; y < crect.p1.y; y++) {
+			mem_blit_fill(row, crect.p1.x - crect.p0.x, mgc->color);
+			row += mgc->rect.p1.x;
+		}
+	}
+
+	mem_gc_invalidate_rect(mgc, &crect);
+	return EOK;
+}
+
+/** Copy area on memory GC.
+ *
+ * @param arg Memory GC
+ * @param rect Source rectangle
+ * @param offs Offset of the destination rectangle
+ *
+ * @return EOK on success or an error code
+ */
+static errno_t mem_gc_copy_area(void *arg, gfx_rect_t *rect,
+    gfx_coord2_t *offs)
+{
+	mem_gc_t *mgc = (mem_gc_t *) arg;
+	gfx_rect_t srect;
+	gfx_rect_t drect;
+	gfx_rect_t crect;
+	gfx_coord_t y;
+	gfx_coord_t width;
+	size_t size;
+	pixel_t *drow;
+	pixel_t *srow;
+
+	/* Only pixels inside the GC can be copied */
+	gfx_rect_clip(rect, &mgc->rect, &srect);
+
+	/* Clip destination rectangle */
+	gfx_rect_translate(offs, &srect, &drect);
+	gfx_rect_clip(&drect, &mgc->clip_rect, &crect);
+
+	assert(mgc->rect.p0.x == 0);
+	assert(mgc->rect.p0.y == 0);
+	assert(mgc->alloc.pitch == mgc->rect.p1.x * (int)sizeof(uint32_t));
+
+	if (gfx_rect_is_empty(&crect))
+		return EOK;
+
+	width = mgc->rect.p1.x;
+	size = (crect.p1.x - crect.p0.x) * sizeof(pixel_t);
+
+	if (offs->y <= 0) {
+		/* Moving up, copy rows top to bottom */
+		drow = (pixel_t *) mgc->alloc.pixels +
+		    crect.p0.y * width + crect.p0.x;
+		srow = drow - offs->y * width - offs->x;
+		for (y = crect.p0.y; y < crect.p1.y; y++) {
+			memmove(drow, srow, size);
+			drow += width;
+			srow += width;
+		}
+	} else {
+		/* Moving down, go bottom to top */
+		drow = (pixel_t *) mgc->alloc.pixels +
+		    (crect.p1.y - 1) * width + crect.p0.x;
+		srow = drow - offs->y * width - offs->x;
+		for (y = crect.p0.y; y < crect.p1.y; y++) {
+			memmove(drow, srow, size);
+			drow -= width;
+			srow -= width;
 		}
 	}
 
@@ -379,10 +446,12 @@ static errno_t mem_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 	gfx_rect_t drect;
 	gfx_rect_t crect;
 	gfx_coord2_t offs;
-	gfx_coord_t x, y;
-	pixelmap_t smap;
-	pixelmap_t dmap;
-	pixel_t pixel;
+	gfx_coord_t y;
+	gfx_coord_t swidth;
+	gfx_coord_t dwidth;
+	size_t count;
+	pixel_t *srow;
+	pixel_t *drow;
 
 	if (srect0 != NULL)
 		gfx_rect_clip(srect0, &mbm->rect, &srect);
@@ -404,54 +473,52 @@ static errno_t mem_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 
 	assert(mbm->alloc.pitch == (mbm->rect.p1.x - mbm->rect.p0.x) *
 	    (int)sizeof(uint32_t));
-	smap.width = mbm->rect.p1.x - mbm->rect.p0.x;
-	smap.height = mbm->rect.p1.y - mbm->rect.p0.y;
-	smap.data = mbm->alloc.pixels;
+	swidth = mbm->rect.p1.x - mbm->rect.p0.x;
 
 	assert(mbm->mgc->rect.p0.x == 0);
 	assert(mbm->mgc->rect.p0.y == 0);
 	assert(mbm->mgc->alloc.pitch == mbm->mgc->rect.p1.x * (int)sizeof(uint32_t));
-	dmap.width = mbm->mgc->rect.p1.x;
-	dmap.height = mbm->mgc->rect.p1.y;
-	dmap.data = mbm->mgc->alloc.pixels;
+	dwidth = mbm->mgc->rect.p1.x;
 
-	if ((mbm->flags & bmpf_direct_output) != 0) {
+	if ((mbm->flags & bmpf_direct_output) != 0 ||
+	    gfx_rect_is_empty(&crect)) {
 		/* Nothing to do */
-	} else if ((mbm->flags & bmpf_color_key) == 0) {
+		goto done;
+	}
+
+	/* Blit row by row */
+	count = crect.p1.x - crect.p0.x;
+	srow = (pixel_t *) mbm->alloc.pixels +
+	    (crect.p0.y - mbm->rect.p0.y - offs.y) * swidth +
+	    (crect.p0.x - mbm->rect.p0.x - offs.x);
+	drow = (pixel_t *) mbm->mgc->alloc.pixels +
+	    crect.p0.y * dwidth + crect.p0.x;
+
+	if ((mbm->flags & bmpf_color_key) == 0) {
 		/* Simple copy */
 		for (y = crect.p0.y; y < crect.p1.y; y++) {
-			for (x = crect.p0.x; x < crect.p1.x; x++) {
-				pixel = pixelmap_get_pixel(&smap,
-				    x - mbm->rect.p0.x - offs.x,
-				    y - mbm->rect.p0.y - offs.y);
-				pixelmap_put_pixel(&dmap, x, y, pixel);
-			}
+			mem_blit_copy(drow, srow, count);
+			srow += swidth;
+			drow += dwidth;
 		}
 	} else if ((mbm->flags & bmpf_colorize) == 0) {
 		/* Color key */
 		for (y = crect.p0.y; y < crect.p1.y; y++) {
-			for (x = crect.p0.x; x < crect.p1.x; x++) {
-				pixel = pixelmap_get_pixel(&smap,
-				    x - mbm->rect.p0.x - offs.x,
-				    y - mbm->rect.p0.y - offs.y);
-				if (pixel != mbm->key_color)
-					pixelmap_put_pixel(&dmap, x, y, pixel);
-			}
+			mem_blit_key(drow, srow, count, mbm->key_color);
+			srow += swidth;
+			drow += dwidth;
 		}
 	} else {
 		/* Color key & colorization */
 		for (y = crect.p0.y; y < crect.p1.y; y++) {
-			for (x = crect.p0.x; x < crect.p1.x; x++) {
-				pixel = pixelmap_get_pixel(&smap,
-				    x - mbm->rect.p0.x - offs.x,
-				    y - mbm->rect.p0.y - offs.y);
-				if (pixel != mbm->key_color)
-					pixelmap_put_pixel(&dmap, x, y,
-					    mbm->mgc->color);
-			}
+			mem_blit_colorize(drow, srow, count, mbm->key_color,
+			    mbm->mgc->color);
+			srow += swidth;
+			drow += dwidth;
 		}
 	}
 
+done:
 	mem_gc_invalidate_rect(mbm->mgc, &crect);
 	return EOK;
 }
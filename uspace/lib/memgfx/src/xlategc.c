@@ -57,6 +57,7 @@ static errno_t xlate_gc_bitmap_get_alloc(void *, gfx_bitmap_alloc_t *);
 static errno_t xlate_gc_cursor_get_pos(void *, gfx_coord2_t *);
 static errno_t xlate_gc_cursor_set_pos(void *, gfx_coord2_t *);
 static errno_t xlate_gc_cursor_set_visible(void *, bool);
+static errno_t xlate_gc_copy_area(void *, gfx_rect_t *, gfx_coord2_t *);
 
 gfx_context_ops_t xlate_gc_ops = {
 	.set_clip_rect = xlate_gc_set_clip_rect,
@@ -69,7 +70,8 @@ gfx_context_ops_t xlate_gc_ops = {
 	.bitmap_get_alloc = xlate_gc_bitmap_get_alloc,
 	.cursor_get_pos = xlate_gc_cursor_get_pos,
 	.cursor_set_pos = xlate_gc_cursor_set_pos,
-	.cursor_set_visible = xlate_gc_cursor_set_visible
+	.cursor_set_visible = xlate_gc_cursor_set_visible,
+	.copy_area = xlate_gc_copy_area
 };
 
 /** Set clipping rectangle on translating GC.
@@ -335,6 +337,24 @@ static errno_t xlate_gc_cursor_set_visible(void *arg, bool visible)
 	return gfx_cursor_set_visible(xgc->bgc, visible);
 }
 
+/** Copy area on translating GC.
+ *
+ * @param arg Translating GC
+ * @param rect Source rectangle
+ * @param offs Offset of the destination rectangle
+ *
+ * @return EOK on success or an error code
+ */
+static errno_t xlate_gc_copy_area(void *arg, gfx_rect_t *rect,
+    gfx_coord2_t *offs)
+{
+	xlate_gc_t *xgc = (xlate_gc_t *) arg;
+	gfx_rect_t crect;
+
+	gfx_rect_translate(&xgc->off, rect, &crect);
+	return gfx_copy_area(xgc->bgc, &crect, offs);
+}
+
 /** Set translation offset on translating GC.
  *
  * @param xgc Translating GC
@@ -279,6 +279,284 @@ PCUT_TEST(bitmap_render)
 	free(alloc.pixels);
 }
 
+/** Test rendering color-keyed sub-rectangle of bitmap with offset */
+PCUT_TEST(bitmap_render_key_offset)
+{
+	mem_gc_t *mgc;
+	gfx_rect_t rect;
+	gfx_rect_t srect;
+	gfx_rect_t drect;
+	gfx_bitmap_alloc_t alloc;
+	gfx_context_t *gc;
+	gfx_coord2_t pos;
+	gfx_coord2_t offs;
+	gfx_coord2_t spos;
+	gfx_bitmap_params_t params;
+	gfx_bitmap_alloc_t balloc;
+	gfx_bitmap_t *bitmap;
+	pixelmap_t bpmap;
+	pixelmap_t dpmap;
+	pixel_t pixel;
+	pixel_t expected;
+	test_resp_t resp;
+	errno_t rc;
+
+	/* Bounding rectangle for memory GC */
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 20;
+	rect.p1.y = 4;
+
+	alloc.pitch = (rect.p1.x - rect.p0.x) * sizeof(uint32_t);
+	alloc.off0 = 0;
+	alloc.pixels = calloc(1, alloc.pitch * (rect.p1.y - rect.p0.y));
+	PCUT_ASSERT_NOT_NULL(alloc.pixels);
+
+	rc = mem_gc_create(&rect, &alloc, &test_mem_gc_cb, &resp, &mgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = mem_gc_get_ctx(mgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	/* Create color-keyed bitmap with width not divisible by four */
+
+	gfx_bitmap_params_init(&params);
+	params.rect.p0.x = 1;
+	params.rect.p0.y = 1;
+	params.rect.p1.x = 16;
+	params.rect.p1.y = 4;
+	params.flags = bmpf_color_key;
+	params.key_color = PIXEL(0, 255, 0, 255);
+
+	rc = gfx_bitmap_create(gc, &params, NULL, &bitmap);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	rc = gfx_bitmap_get_alloc(bitmap, &balloc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	bpmap.width = params.rect.p1.x - params.rect.p0.x;
+	bpmap.height = params.rect.p1.y - params.rect.p0.y;
+	bpmap.data = balloc.pixels;
+
+	/* Every third pixel is transparent, others encode the position */
+	for (pos.y = 0; pos.y < (gfx_coord_t) bpmap.height; pos.y++) {
+		for (pos.x = 0; pos.x < (gfx_coord_t) bpmap.width; pos.x++) {
+			pixelmap_put_pixel(&bpmap, pos.x, pos.y,
+			    (pos.x % 3) == 0 ? params.key_color :
+			    PIXEL(0, pos.x, pos.y, 1));
+		}
+	}
+
+	dpmap.width = rect.p1.x - rect.p0.x;
+	dpmap.height = rect.p1.y - rect.p0.y;
+	dpmap.data = alloc.pixels;
+
+	/* Background */
+	for (pos.y = rect.p0.y; pos.y < rect.p1.y; pos.y++) {
+		for (pos.x = rect.p0.x; pos.x < rect.p1.x; pos.x++)
+			pixelmap_put_pixel(&dpmap, pos.x, pos.y, PIXEL(0, 9, 9, 9));
+	}
+
+	memset(&resp, 0, sizeof(resp));
+
+	/* Render sub-rectangle, partially outside of GC */
+	srect.p0.x = 2;
+	srect.p0.y = 1;
+	srect.p1.x = 16;
+	srect.p1.y = 4;
+	offs.x = 3;
+	offs.y = 2;
+
+	rc = gfx_bitmap_render(bitmap, &srect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gfx_rect_translate(&offs, &srect, &drect);
+
+	for (pos.y = rect.p0.y; pos.y < rect.p1.y; pos.y++) {
+		for (pos.x = rect.p0.x; pos.x < rect.p1.x; pos.x++) {
+			pixel = pixelmap_get_pixel(&dpmap, pos.x, pos.y);
+			expected = PIXEL(0, 9, 9, 9);
+			if (gfx_pix_inside_rect(&pos, &drect)) {
+				spos.x = pos.x - offs.x - params.rect.p0.x;
+				spos.y = pos.y - offs.y - params.rect.p0.y;
+				if ((spos.x % 3) != 0)
+					expected = PIXEL(0, spos.x, spos.y, 1);
+			}
+			PCUT_ASSERT_INT_EQUALS(expected, pixel);
+		}
+	}
+
+	/* Invalidate rect is the destination clipped to the GC */
+	PCUT_ASSERT_TRUE(resp.invalidate_called);
+	PCUT_ASSERT_INT_EQUALS(5, resp.inv_rect.p0.x);
+	PCUT_ASSERT_INT_EQUALS(3, resp.inv_rect.p0.y);
+	PCUT_ASSERT_INT_EQUALS(19, resp.inv_rect.p1.x);
+	PCUT_ASSERT_INT_EQUALS(4, resp.inv_rect.p1.y);
+
+	mem_gc_delete(mgc);
+	free(alloc.pixels);
+}
+
+/** Test copying an area upwards in memory GC */
+PCUT_TEST(copy_area_up)
+{
+	mem_gc_t *mgc;
+	gfx_rect_t rect;
+	gfx_rect_t crect;
+	gfx_coord2_t offs;
+	gfx_bitmap_alloc_t alloc;
+	gfx_context_t *gc;
+	gfx_coord2_t pos;
+	pixelmap_t pixelmap;
+	pixel_t pixel;
+	pixel_t expected;
+	test_resp_t resp;
+	errno_t rc;
+
+	/* Bounding rectangle for memory GC */
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+
+	alloc.pitch = (rect.p1.x - rect.p0.x) * sizeof(uint32_t);
+	alloc.off0 = 0;
+	alloc.pixels = calloc(1, alloc.pitch * (rect.p1.y - rect.p0.y));
+	PCUT_ASSERT_NOT_NULL(alloc.pixels);
+
+	rc = mem_gc_create(&rect, &alloc, &test_mem_gc_cb, &resp, &mgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = mem_gc_get_ctx(mgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	pixelmap.width = rect.p1.x - rect.p0.x;
+	pixelmap.height = rect.p1.y - rect.p0.y;
+	pixelmap.data = alloc.pixels;
+
+	/* Give each pixel a distinct value */
+	for (pos.y = rect.p0.y; pos.y < rect.p1.y; pos.y++) {
+		for (pos.x = rect.p0.x; pos.x < rect.p1.x; pos.x++) {
+			pixelmap_put_pixel(&pixelmap, pos.x, pos.y,
+			    PIXEL(0, pos.x, pos.y, 0));
+		}
+	}
+
+	/* Scroll everything but the top three rows up by three rows */
+	crect.p0.x = 0;
+	crect.p0.y = 3;
+	crect.p1.x = 10;
+	crect.p1.y = 10;
+	offs.x = 0;
+	offs.y = -3;
+
+	memset(&resp, 0, sizeof(resp));
+
+	rc = gfx_copy_area(gc, &crect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	for (pos.y = rect.p0.y; pos.y < rect.p1.y; pos.y++) {
+		for (pos.x = rect.p0.x; pos.x < rect.p1.x; pos.x++) {
+			pixel = pixelmap_get_pixel(&pixelmap, pos.x, pos.y);
+			expected = pos.y < 7 ? PIXEL(0, pos.x, pos.y + 3, 0) :
+			    PIXEL(0, pos.x, pos.y, 0);
+			PCUT_ASSERT_INT_EQUALS(expected, pixel);
+		}
+	}
+
+	/* Check that the invalidate rect is equal to the destination rect */
+	PCUT_ASSERT_TRUE(resp.invalidate_called);
+	PCUT_ASSERT_INT_EQUALS(0, resp.inv_rect.p0.x);
+	PCUT_ASSERT_INT_EQUALS(0, resp.inv_rect.p0.y);
+	PCUT_ASSERT_INT_EQUALS(10, resp.inv_rect.p1.x);
+	PCUT_ASSERT_INT_EQUALS(7, resp.inv_rect.p1.y);
+
+	mem_gc_delete(mgc);
+	free(alloc.pixels);
+}
+
+/** Test copying an overlapping area downwards in memory GC */
+PCUT_TEST(copy_area_down)
+{
+	mem_gc_t *mgc;
+	gfx_rect_t rect;
+	gfx_rect_t crect;
+	gfx_rect_t drect;
+	gfx_coord2_t offs;
+	gfx_bitmap_alloc_t alloc;
+	gfx_context_t *gc;
+	gfx_coord2_t pos;
+	pixelmap_t pixelmap;
+	pixel_t pixel;
+	pixel_t expected;
+	test_resp_t resp;
+	errno_t rc;
+
+	/* Bounding rectangle for memory GC */
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+
+	alloc.pitch = (rect.p1.x - rect.p0.x) * sizeof(uint32_t);
+	alloc.off0 = 0;
+	alloc.pixels = calloc(1, alloc.pitch * (rect.p1.y - rect.p0.y));
+	PCUT_ASSERT_NOT_NULL(alloc.pixels);
+
+	rc = mem_gc_create(&rect, &alloc, &test_mem_gc_cb, &resp, &mgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gc = mem_gc_get_ctx(mgc);
+	PCUT_ASSERT_NOT_NULL(gc);
+
+	pixelmap.width = rect.p1.x - rect.p0.x;
+	pixelmap.height = rect.p1.y - rect.p0.y;
+	pixelmap.data = alloc.pixels;
+
+	/* Give each pixel a distinct value */
+	for (pos.y = rect.p0.y; pos.y < rect.p1.y; pos.y++) {
+		for (pos.x = rect.p0.x; pos.x < rect.p1.x; pos.x++) {
+			pixelmap_put_pixel(&pixelmap, pos.x, pos.y,
+			    PIXEL(0, pos.x, pos.y, 0));
+		}
+	}
+
+	/* Source and destination overlap */
+	crect.p0.x = 2;
+	crect.p0.y = 2;
+	crect.p1.x = 6;
+	crect.p1.y = 6;
+	offs.x = 1;
+	offs.y = 1;
+
+	memset(&resp, 0, sizeof(resp));
+
+	rc = gfx_copy_area(gc, &crect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	gfx_rect_translate(&offs, &crect, &drect);
+
+	for (pos.y = rect.p0.y; pos.y < rect.p1.y; pos.y++) {
+		for (pos.x = rect.p0.x; pos.x < rect.p1.x; pos.x++) {
+			pixel = pixelmap_get_pixel(&pixelmap, pos.x, pos.y);
+			expected = gfx_pix_inside_rect(&pos, &drect) ?
+			    PIXEL(0, pos.x - 1, pos.y - 1, 0) :
+			    PIXEL(0, pos.x, pos.y, 0);
+			PCUT_ASSERT_INT_EQUALS(expected, pixel);
+		}
+	}
+
+	/* Check that the invalidate rect is equal to the destination rect */
+	PCUT_ASSERT_TRUE(resp.invalidate_called);
+	PCUT_ASSERT_INT_EQUALS(drect.p0.x, resp.inv_rect.p0.x);
+	PCUT_ASSERT_INT_EQUALS(drect.p0.y, resp.inv_rect.p0.y);
+	PCUT_ASSERT_INT_EQUALS(drect.p1.x, resp.inv_rect.p1.x);
+	PCUT_ASSERT_INT_EQUALS(drect.p1.y, resp.inv_rect.p1.y);
+
+	mem_gc_delete(mgc);
+	free(alloc.pixels);
+}
+
 /** Test gfx_update() on a memory GC */
 PCUT_TEST(gfx_update)
 {
@@ -53,6 +53,7 @@ static errno_t testgc_bitmap_get_alloc(void *, gfx_bitmap_alloc_t *);
 static errno_t testgc_cursor_get_pos(void *, gfx_coord2_t *);
 static errno_t testgc_cursor_set_pos(void *, gfx_coord2_t *);
 static errno_t testgc_cursor_set_visible(void *, bool);
+static errno_t testgc_copy_area(void *, gfx_rect_t *, gfx_coord2_t *);
 
 static gfx_context_ops_t testgc_ops = {
 	.set_clip_rect = testgc_set_clip_rect,
@@ -65,7 +66,8 @@ static gfx_context_ops_t testgc_ops = {
 	.bitmap_get_alloc = testgc_bitmap_get_alloc,
 	.cursor_get_pos = testgc_cursor_get_pos,
 	.cursor_set_pos = testgc_cursor_set_pos,
-	.cursor_set_visible = testgc_cursor_set_visible
+	.cursor_set_visible = testgc_cursor_set_visible,
+	.copy_area = testgc_copy_area
 };
 
 typedef struct {
@@ -127,6 +129,12 @@ typedef struct {
 	bool cursor_set_visible_called;
 	/** Value passed to cursor_set_visible */
 	bool cursor_set_visible_vis;
+	/** True if copy_area was called */
+	bool copy_area_called;
+	/** Source rectangle passed to copy_area */
+	gfx_rect_t copy_area_rect;
+	/** Offset passed to copy_area */
+	gfx_coord2_t copy_area_offs;
 } test_gc_t;
 
 typedef struct {
@@ -291,6 +299,58 @@ PCUT_TEST(fill_rect)
 	gfx_context_delete(tgc);
 }
 
+/** Test copying area in a translation GC */
+PCUT_TEST(copy_area)
+{
+	test_gc_t test_gc;
+	gfx_context_t *tgc;
+	xlate_gc_t *xlategc;
+	gfx_context_t *xgc;
+	gfx_rect_t rect;
+	gfx_coord2_t offs;
+	gfx_coord2_t off;
+	errno_t rc;
+
+	rc = gfx_context_new(&testgc_ops, &test_gc, &tgc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	off.x = 10;
+	off.y = 20;
+	rc = xlate_gc_create(&off, tgc, &xlategc);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	xgc = xlate_gc_get_ctx(xlategc);
+
+	memset(&test_gc, 0, sizeof(test_gc));
+
+	rect.p0.x = 1;
+	rect.p0.y = 2;
+	rect.p1.x = 3;
+	rect.p1.y = 4;
+	offs.x = 5;
+	offs.y = -6;
+
+	test_gc.rc = EOK;
+	rc = gfx_copy_area(xgc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	/* Source rectangle is translated, offset is not */
+	PCUT_ASSERT_TRUE(test_gc.copy_area_called);
+	PCUT_ASSERT_INT_EQUALS(11, test_gc.copy_area_rect.p0.x);
+	PCUT_ASSERT_INT_EQUALS(22, test_gc.copy_area_rect.p0.y);
+	PCUT_ASSERT_INT_EQUALS(13, test_gc.copy_area_rect.p1.x);
+	PCUT_ASSERT_INT_EQUALS(24, test_gc.copy_area_rect.p1.y);
+	PCUT_ASSERT_INT_EQUALS(5, test_gc.copy_area_offs.x);
+	PCUT_ASSERT_INT_EQUALS(-6, test_gc.copy_area_offs.y);
+
+	test_gc.rc = EIO;
+	rc = gfx_copy_area(xgc, &rect, &offs);
+	PCUT_ASSERT_ERRNO_VAL(EIO, rc);
+
+	xlate_gc_delete(xlategc);
+	gfx_context_delete(tgc);
+}
+
 /** Test updating a translation GC */
 PCUT_TEST(update)
 {
@@ -913,4 +973,23 @@ static errno_t testgc_cursor_set_visible(void *arg, bool visible)
 	return test_gc->rc;
 }
 
+/** Copy area in test GC.
+ *
+ * @param arg Argument (test_gc_t *)
+ * @param rect Source rectangle
+ * @param offs Offset of the destination rectangle
+ * @return EOK on success or an error code
+ */
+static errno_t testgc_copy_area(void *arg, gfx_rect_t *rect,
+    gfx_coord2_t *offs)
+{
+	test_gc_t *test_gc = (test_gc_t *)arg;
+
+	test_gc->copy_area_called = true;
+	test_gc->copy_area_rect = *rect;
+	test_gc->copy_area_offs = *offs;
+
+	return test_gc->rc;
+}
+
 PCUT_EXPORT(xlategc);
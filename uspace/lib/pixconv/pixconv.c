@@ -38,9 +38,16 @@
  * the names of the visuals and the format created by these functions.
  * The functions use the so called network bit order (i.e. big endian)
  * with respect to their names.
+ *
+ * For converting many pixels at once, row conversion functions are
+ * provided for each visual. These avoid calling a function per pixel
+ * and, where the target has SIMD registers (SSE2, NEON), convert four
+ * pixels at a time using the compiler vector extension.
  */
 
 #include <byteorder.h>
+#include <mem.h>
+#include <stdint.h>
 #include "pixconv.h"
 
 void pixel2argb_8888(void *dst, pixel_t pix)
@@ -283,5 +290,343 @@ pixel_t gray_8_2pixel(void *src)
 	return (0xff000000 | (val << 16) | (val << 8) | (val));
 }
 
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define PIXCONV_VECTOR
+#endif
+
+#ifdef PIXCONV_VECTOR
+
+/** Vector of four pixels */
+typedef uint32_t pixconv_vec_t __attribute__((vector_size(16)));
+
+#endif
+
+/*
+ * The conversion macros below take the pixel value and compute the value
+ * that stored in big endian order yields the visual. They only use shifts
+ * and masks so that they can be applied both to scalars and vectors.
+ */
+
+#define PIXCONV_BSWAP32(v) \
+	(((v) << 24) | (((v) & 0xff00) << 8) | (((v) >> 8) & 0xff00) | \
+	((v) >> 24))
+
+#define PIXCONV_BSWAP16(v) \
+	((((v) << 8) & 0xff00) | (((v) >> 8) & 0xff))
+
+#ifdef __BE__
+#define PIXCONV_BE32(v) (v)
+#define PIXCONV_BE16(v) (v)
+#define PIXCONV_LE16(v) PIXCONV_BSWAP16(v)
+#else
+#define PIXCONV_BE32(v) PIXCONV_BSWAP32(v)
+#define PIXCONV_BE16(v) PIXCONV_BSWAP16(v)
+#define PIXCONV_LE16(v) (v)
+#endif
+
+#define PIXCONV_ARGB_8888(v) (v)
+#define PIXCONV_ABGR_8888(v) \
+	(((v) & 0xff00ff00) | (((v) >> 16) & 0xff) | (((v) & 0xff) << 16))
+#define PIXCONV_RGBA_8888(v) (((v) << 8) | ((v) >> 24))
+#define PIXCONV_BGRA_8888(v) PIXCONV_BSWAP32(v)
+#define PIXCONV_RGB_0888(v) ((v) & 0xffffff)
+#define PIXCONV_BGR_0888(v) \
+	((((v) >> 16) & 0xff) | ((v) & 0xff00) | (((v) & 0xff) << 16))
+#define PIXCONV_RGB_8880(v) ((v) << 8)
+#define PIXCONV_BGR_8880(v) \
+	((((v) & 0xff) << 24) | (((v) & 0xff00) << 8) | (((v) >> 8) & 0xff00))
+#define PIXCONV_RGB_555(v) \
+	((((v) >> 9) & 0x7c00) | (((v) >> 6) & 0x3e0) | (((v) >> 3) & 0x1f))
+#define PIXCONV_RGB_565(v) \
+	((((v) >> 8) & 0xf800) | (((v) >> 5) & 0x7e0) | (((v) >> 3) & 0x1f))
+
+#ifdef PIXCONV_VECTOR
+
+/** Convert four pixels at a time to a 32-bit visual. */
+#define PIXCONV_ROW32_VECTOR(conv) \
+	for (; i + 4 <= n; i += 4) { \
+		pixconv_vec_t v; \
+		memcpy(&v, src + i, sizeof(v)); \
+		v = conv(v); \
+		v = PIXCONV_BE32(v); \
+		memcpy(d + 4 * i, &v, sizeof(v)); \
+	}
+
+/** Convert four pixels at a time to a 16-bit visual. */
+#define PIXCONV_ROW16_VECTOR(conv, order) \
+	for (; i + 4 <= n; i += 4) { \
+		pixconv_vec_t v; \
+		uint32_t w[2]; \
+		memcpy(&v, src + i, sizeof(v)); \
+		v = conv(v); \
+		v = order(v); \
+		w[0] = PIXCONV_PAIR16(v[0], v[1]); \
+		w[1] = PIXCONV_PAIR16(v[2], v[3]); \
+		memcpy(d + 2 * i, w, sizeof(w)); \
+	}
+
+#ifdef __BE__
+#define PIXCONV_PAIR16(a, b) (((a) << 16) | (b))
+#else
+#define PIXCONV_PAIR16(a, b) ((a) | ((b) << 16))
+#endif
+
+#else
+
+#define PIXCONV_ROW32_VECTOR(conv)
+#define PIXCONV_ROW16_VECTOR(conv, order)
+
+#endif
+
+/** Define row conversion function for a 32-bit visual. */
+#define PIXCONV_ROW32(name, conv) \
+	static void name(void *dst, const pixel_t *src, size_t n) \
+	{ \
+		uint8_t *d = (uint8_t *) dst; \
+		uint32_t w; \
+		size_t i = 0; \
+\
+		PIXCONV_ROW32_VECTOR(conv) \
+		for (; i < n; i++) { \
+			w = conv(src[i]); \
+			w = PIXCONV_BE32(w); \
+			memcpy(d + 4 * i, &w, sizeof(w)); \
+		} \
+	}
+
+/** Define row conversion function for a 16-bit visual. */
+#define PIXCONV_ROW16(name, conv, order) \
+	static void name(void *dst, const pixel_t *src, size_t n) \
+	{ \
+		uint8_t *d = (uint8_t *) dst; \
+		uint32_t w; \
+		uint16_t h; \
+		size_t i = 0; \
+\
+		PIXCONV_ROW16_VECTOR(conv, order) \
+		for (; i < n; i++) { \
+			w = conv(src[i]); \
+			h = order(w); \
+			memcpy(d + 2 * i, &h, sizeof(h)); \
+		} \
+	}
+
+PIXCONV_ROW32(pixel2argb_8888_row, PIXCONV_ARGB_8888)
+PIXCONV_ROW32(pixel2abgr_8888_row, PIXCONV_ABGR_8888)
+PIXCONV_ROW32(pixel2rgba_8888_row, PIXCONV_RGBA_8888)
+PIXCONV_ROW32(pixel2bgra_8888_row, PIXCONV_BGRA_8888)
+PIXCONV_ROW32(pixel2rgb_0888_row, PIXCONV_RGB_0888)
+PIXCONV_ROW32(pixel2bgr_0888_row, PIXCONV_BGR_0888)
+PIXCONV_ROW32(pixel2rgb_8880_row, PIXCONV_RGB_8880)
+PIXCONV_ROW32(pixel2bgr_8880_row, PIXCONV_BGR_8880)
+PIXCONV_ROW16(pixel2rgb_555_be_row, PIXCONV_RGB_555, PIXCONV_BE16)
+PIXCONV_ROW16(pixel2rgb_555_le_row, PIXCONV_RGB_555, PIXCONV_LE16)
+PIXCONV_ROW16(pixel2rgb_565_be_row, PIXCONV_RGB_565, PIXCONV_BE16)
+PIXCONV_ROW16(pixel2rgb_565_le_row, PIXCONV_RGB_565, PIXCONV_LE16)
+
+/** Convert row of pixels to 24-bit visual with blue in the first byte.
+ *
+ * On little-endian hosts four pixels are packed into three 32-bit words
+ * at a time.
+ *
+ * @param dst Destination
+ * @param src Source pixels
+ * @param n Number of pixels
+ */
+static void pixel2bgr_888_row(void *dst, const pixel_t *src, size_t n)
+{
+	uint8_t *d = (uint8_t *) dst;
+	size_t i = 0;
+
+#ifdef __LE__
+	uint32_t w[3];
+
+	for (; i + 4 <= n; i += 4) {
+		w[0] = (src[i] & 0xffffff) | (src[i + 1] << 24);
+		w[1] = ((src[i + 1] >> 8) & 0xffff) | (src[i + 2] << 16);
+		w[2] = ((src[i + 2] >> 16) & 0xff) | (src[i + 3] << 8);
+		memcpy(d + 3 * i, w, sizeof(w));
+	}
+#endif
+	for (; i < n; i++)
+		pixel2bgr_888(d + 3 * i, src[i]);
+}
+
+/** Convert row of pixels to 24-bit visual with red in the first byte.
+ *
+ * @param dst Destination
+ * @param src Source pixels
+ * @param n Number of pixels
+ */
+static void pixel2rgb_888_row(void *dst, const pixel_t *src, size_t n)
+{
+	uint8_t *d = (uint8_t *) dst;
+	size_t i = 0;
+
+#ifdef __LE__
+	uint32_t p[4];
+	uint32_t w[3];
+	unsigned j;
+
+	for (; i + 4 <= n; i += 4) {
+		for (j = 0; j < 4; j++)
+			p[j] = PIXCONV_ABGR_8888(src[i + j]);
+
+		w[0] = (p[0] & 0xffffff) | (p[1] << 24);
+		w[1] = ((p[1] >> 8) & 0xffff) | (p[2] << 16);
+		w[2] = ((p[2] >> 16) & 0xff) | (p[3] << 8);
+		memcpy(d + 3 * i, w, sizeof(w));
+	}
+#endif
+	for (; i < n; i++)
+		pixel2rgb_888(d + 3 * i, src[i]);
+}
+
+/** Convert row of pixels to 8-bit inverted 3-2-3 visual.
+ *
+ * @param dst Destination
+ * @param src Source pixels
+ * @param n Number of pixels
+ */
+static void pixel2bgr_323_row(void *dst, const pixel_t *src, size_t n)
+{
+	uint8_t *d = (uint8_t *) dst;
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		pixel2bgr_323(d + i, src[i]);
+}
+
+/** Conversion functions for each visual */
+static const struct {
+	/** Bytes per pixel */
+	size_t bytes;
+	/** Pixel conversion function */
+	pixel2visual_t pixel2visual;
+	/** Row conversion function */
+	pixel2visual_row_t pixel2visual_row;
+} pixconv_visual[] = {
+	[VISUAL_INDIRECT_8] = { 1, pixel2bgr_323, pixel2bgr_323_row },
+	[VISUAL_RGB_5_5_5_LE] = { 2, pixel2rgb_555_le, pixel2rgb_555_le_row },
+	[VISUAL_RGB_5_5_5_BE] = { 2, pixel2rgb_555_be, pixel2rgb_555_be_row },
+	[VISUAL_RGB_5_6_5_LE] = { 2, pixel2rgb_565_le, pixel2rgb_565_le_row },
+	[VISUAL_RGB_5_6_5_BE] = { 2, pixel2rgb_565_be, pixel2rgb_565_be_row },
+	[VISUAL_BGR_8_8_8] = { 3, pixel2bgr_888, pixel2bgr_888_row },
+	[VISUAL_BGR_0_8_8_8] = { 4, pixel2bgr_0888, pixel2bgr_0888_row },
+	[VISUAL_BGR_8_8_8_0] = { 4, pixel2bgr_8880, pixel2bgr_8880_row },
+	[VISUAL_ABGR_8_8_8_8] = { 4, pixel2abgr_8888, pixel2abgr_8888_row },
+	[VISUAL_BGRA_8_8_8_8] = { 4, pixel2bgra_8888, pixel2bgra_8888_row },
+	[VISUAL_RGB_8_8_8] = { 3, pixel2rgb_888, pixel2rgb_888_row },
+	[VISUAL_RGB_0_8_8_8] = { 4, pixel2rgb_0888, pixel2rgb_0888_row },
+	[VISUAL_RGB_8_8_8_0] = { 4, pixel2rgb_8880, pixel2rgb_8880_row },
+	[VISUAL_ARGB_8_8_8_8] = { 4, pixel2argb_8888, pixel2argb_8888_row },
+	[VISUAL_RGBA_8_8_8_8] = { 4, pixel2rgba_8888, pixel2rgba_8888_row }
+};
+
+/** Determine if visual is supported by the row conversion functions.
+ *
+ * @param visual Visual
+ * @return @c true iff @a visual is supported
+ */
+static bool pixconv_visual_valid(visual_t visual)
+{
+	return (size_t) visual < sizeof(pixconv_visual) /
+	    sizeof(pixconv_visual[0]) && pixconv_visual[visual].bytes != 0;
+}
+
+/** Get number of bytes per pixel of a visual.
+ *
+ * @param visual Visual
+ * @return Bytes per pixel or zero if @a visual is not supported
+ */
+size_t pixconv_visual_bytes(visual_t visual)
+{
+	if (!pixconv_visual_valid(visual))
+		return 0;
+
+	return pixconv_visual[visual].bytes;
+}
+
+/** Get row conversion function for a visual.
+ *
+ * @param visual Visual
+ * @return Row conversion function or @c NULL if @a visual is not supported
+ */
+pixel2visual_row_t pixconv_row_func(visual_t visual)
+{
+	if (!pixconv_visual_valid(visual))
+		return NULL;
+
+	return pixconv_visual[visual].pixel2visual_row;
+}
+
+/** Convert row of pixels to a visual.
+ *
+ * @param visual Destination visual (must be supported)
+ * @param dst Destination
+ * @param src Source pixels
+ * @param n Number of pixels
+ */
+void pixconv_row(visual_t visual, void *dst, const pixel_t *src, size_t n)
+{
+	pixconv_visual[visual].pixel2visual_row(dst, src, n);
+}
+
+/** Fill row of a visual with a single pixel value.
+ *
+ * The pixel is converted once and then replicated by copying the already
+ * filled part of the row.
+ *
+ * @param visual Destination visual (must be supported)
+ * @param dst Destination
+ * @param pix Pixel value
+ * @param n Number of pixels
+ */
+void pixconv_fill_row(visual_t visual, void *dst, pixel_t pix, size_t n)
+{
+	uint8_t *d = (uint8_t *) dst;
+	size_t bytes = pixconv_visual[visual].bytes;
+	size_t total = n * bytes;
+	size_t done;
+	size_t chunk;
+
+	if (n == 0)
+		return;
+
+	pixconv_visual[visual].pixel2visual(d, pix);
+
+	done = bytes;
+	while (done < total) {
+		chunk = done < total - done ? done : total - done;
+		memcpy(d + done, d, chunk);
+		done += chunk;
+	}
+}
+
+/** Convert rectangle of pixels to a visual.
+ *
+ * @param visual Destination visual (must be supported)
+ * @param dst Destination (first pixel of the first row)
+ * @param dst_pitch Destination row pitch in bytes
+ * @param src Source (first pixel of the first row)
+ * @param src_pitch Source row pitch in bytes
+ * @param width Rectangle width in pixels
+ * @param height Rectangle height in pixels
+ */
+void pixconv_rect(visual_t visual, void *dst, size_t dst_pitch,
+    const pixel_t *src, size_t src_pitch, size_t width, size_t height)
+{
+	pixel2visual_row_t row = pixconv_visual[visual].pixel2visual_row;
+	uint8_t *d = (uint8_t *) dst;
+	const uint8_t *s = (const uint8_t *) src;
+	size_t y;
+
+	for (y = 0; y < height; y++) {
+		row(d, (const pixel_t *) s, width);
+		d += dst_pitch;
+		s += src_pitch;
+	}
+}
+
 /** @}
  */
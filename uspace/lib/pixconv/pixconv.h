@@ -37,7 +37,9 @@
 #ifndef SOFTREND_PIXCONV_H_
 #define SOFTREND_PIXCONV_H_
 
+#include <abi/fb/visuals.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <io/pixel.h>
 
 /** Function to render a pixel. */
@@ -49,6 +51,9 @@ typedef void (*visual_mask_t)(void *, bool);
 /** Function to retrieve a pixel. */
 typedef pixel_t (*visual2pixel_t)(void *);
 
+/** Function to render a row of pixels. */
+typedef void (*pixel2visual_row_t)(void *, const pixel_t *, size_t);
+
 extern void pixel2argb_8888(void *, pixel_t);
 extern void pixel2abgr_8888(void *, pixel_t);
 extern void pixel2rgba_8888(void *, pixel_t);
@@ -92,6 +97,13 @@ extern pixel_t rgb_565_le_2pixel(void *);
 extern pixel_t bgr_323_2pixel(void *);
 extern pixel_t gray_8_2pixel(void *);
 
+extern size_t pixconv_visual_bytes(visual_t);
+extern pixel2visual_row_t pixconv_row_func(visual_t);
+extern void pixconv_row(visual_t, void *, const pixel_t *, size_t);
+extern void pixconv_fill_row(visual_t, void *, pixel_t, size_t);
+extern void pixconv_rect(visual_t, void *, size_t, const pixel_t *, size_t,
+    size_t, size_t);
+
 #endif
 
 /** @}
@@ -76,7 +76,9 @@ typedef enum {
 	/** Special system window */
 	ui_wndf_system = 0x4,
 	/** Maximized windows should avoid this window */
-	ui_wndf_avoid = 0x8
+	ui_wndf_avoid = 0x8,
+	/** Batch drawing, application calls gfx_update() to make it visible */
+	ui_wndf_batch = 0x10
 } ui_wnd_flags_t;
 
 /** Window parameters */
@@ -284,7 +284,12 @@ errno_t ui_window_create(ui_t *ui, ui_wnd_params_t *params,
 		if (rc != EOK)
 			goto error;
 
-		rc = display_window_get_gc(window->dwindow, &gc);
+		if ((params->flags & ui_wndf_batch) != 0) {
+			rc = display_window_get_batch_gc(window->dwindow,
+			    &gc);
+		} else {
+			rc = display_window_get_gc(window->dwindow, &gc);
+		}
 		if (rc != EOK)
 			goto error;
 	} else if (ui->console != NULL) {
@@ -1359,6 +1364,9 @@ static void ui_window_update(void *arg)
 	window->dirty_rect.p0.y = 0;
 	window->dirty_rect.p1.x = 0;
 	window->dirty_rect.p1.y = 0;
+
+	/* Display GC may be batching */
+	(void) gfx_update(window->realgc);
 }
 
 /** Window cursor get position callback
@@ -45,6 +45,7 @@
 #include "cursimg.h"
 #include "cursor.h"
 #include "display.h"
+#include "region.h"
 #include "seat.h"
 #include "window.h"
 #include "wmclient.h"
@@ -103,6 +104,7 @@ errno_t ds_display_create(gfx_context_t *gc, ds_display_flags_t flags,
 	list_initialize(&disp->idevcfgs);
 	list_initialize(&disp->seats);
 	list_initialize(&disp->windows);
+	ds_region_init(&disp->dirty);
 	disp->flags = flags;
 	*rdisp = disp;
 	return EOK;
@@ -691,10 +693,7 @@ static errno_t ds_display_alloc_backbuf(ds_display_t *disp)
 	if (rc != EOK)
 		goto error;
 
-	disp->dirty_rect.p0.x = 0;
-	disp->dirty_rect.p0.y = 0;
-	disp->dirty_rect.p1.x = 0;
-	disp->dirty_rect.p1.y = 0;
+	ds_region_clear(&disp->dirty);
 
 	return EOK;
 error:
@@ -1004,13 +1003,17 @@ errno_t ds_display_paint_bg(ds_display_t *disp, gfx_rect_t *rect)
 
 /** Update front buffer from back buffer.
  *
- * If the display is not double-buffered, no action is taken.
+ * Each rectangle of the dirty region is rendered separately so that
+ * damage in distant parts of the display does not cause the area between
+ * them to be copied as well. If the display is not double-buffered,
+ * no action is taken.
  *
  * @param disp Display
  * @return EOK on success, or an error code
  */
 static errno_t ds_display_update(ds_display_t *disp)
 {
+	size_t i;
 	errno_t rc;
 
 	if (disp->backbuf == NULL) {
@@ -1018,40 +1021,79 @@ static errno_t ds_display_update(ds_display_t *disp)
 		return EOK;
 	}
 
-	rc = gfx_bitmap_render(disp->backbuf, &disp->dirty_rect, NULL);
-	if (rc != EOK)
-		return rc;
-
-	disp->dirty_rect.p0.x = 0;
-	disp->dirty_rect.p0.y = 0;
-	disp->dirty_rect.p1.x = 0;
-	disp->dirty_rect.p1.y = 0;
+	for (i = 0; i < disp->dirty.nrects; i++) {
+		rc = gfx_bitmap_render(disp->backbuf, &disp->dirty.rects[i],
+		    NULL);
+		if (rc != EOK)
+			return rc;
+	}
 
+	ds_region_clear(&disp->dirty);
 	return EOK;
 }
 
-/** Paint display.
+/** Paint part of display without updating the front buffer.
+ *
+ * Going from the top window down, determine the part of @a rect that
+ * each window leaves visible, so that fully occluded windows are skipped
+ * and partially occluded ones only paint their visible part. The
+ * background is only painted where no window covers it.
+ *
+ * The visible regions may be larger than exact if a region runs out of
+ * rectangles. Windows are therefore still painted bottom to top, so that
+ * any such overdraw is covered by the windows above.
  *
  * @param display Display
  * @param rect Bounding rectangle or @c NULL to repaint entire display
  */
-errno_t ds_display_paint(ds_display_t *disp, gfx_rect_t *rect)
+static errno_t ds_display_paint_rect(ds_display_t *disp, gfx_rect_t *rect)
 {
+	ds_region_t uncovered;
+	gfx_rect_t crect;
+	gfx_rect_t drect;
 	errno_t rc;
 	ds_window_t *wnd;
 	ds_seat_t *seat;
+	size_t i;
 
-	/* Paint background */
-	rc = ds_display_paint_bg(disp, rect);
-	if (rc != EOK)
-		return rc;
+	if (rect != NULL)
+		gfx_rect_clip(&disp->rect, rect, &crect);
+	else
+		crect = disp->rect;
 
-	/* Paint windows bottom to top */
-	wnd = ds_display_last_window(disp);
+	/* Determine visible part of each window, top to bottom */
+	ds_region_init(&uncovered);
+	ds_region_add(&uncovered, &crect);
+
+	wnd = ds_display_first_window(disp);
 	while (wnd != NULL) {
-		rc = ds_window_paint(wnd, rect);
+		if (ds_window_is_visible(wnd) &&
+		    !ds_region_is_empty(&uncovered)) {
+			gfx_rect_translate(&wnd->dpos, &wnd->rect, &drect);
+			ds_region_clip(&uncovered, &drect, &wnd->vis);
+			ds_region_subtract(&uncovered, &drect);
+		} else {
+			ds_region_init(&wnd->vis);
+		}
+
+		wnd = ds_display_next_window(wnd);
+	}
+
+	/* Paint background where it is not covered by windows */
+	for (i = 0; i < uncovered.nrects; i++) {
+		rc = ds_display_paint_bg(disp, &uncovered.rects[i]);
 		if (rc != EOK)
 			return rc;
+	}
+
+	/* Paint visible parts of windows bottom to top */
+	wnd = ds_display_last_window(disp);
+	while (wnd != NULL) {
+		for (i = 0; i < wnd->vis.nrects; i++) {
+			rc = ds_window_paint(wnd, &wnd->vis.rects[i]);
+			if (rc != EOK)
+				return rc;
+		}
 
 		wnd = ds_display_prev_window(wnd);
 	}
@@ -1076,13 +1118,51 @@ errno_t ds_display_paint(ds_display_t *disp, gfx_rect_t *rect)
 		seat = ds_display_next_seat(seat);
 	}
 
+	return EOK;
+}
+
+/** Paint display.
+ *
+ * @param display Display
+ * @param rect Bounding rectangle or @c NULL to repaint entire display
+ */
+errno_t ds_display_paint(ds_display_t *disp, gfx_rect_t *rect)
+{
+	errno_t rc;
+
+	rc = ds_display_paint_rect(disp, rect);
+	if (rc != EOK)
+		return rc;
+
+	return ds_display_update(disp);
+}
+
+/** Paint region of display.
+ *
+ * Each rectangle of @a region is painted separately and the front buffer
+ * is then updated once.
+ *
+ * @param display Display
+ * @param region Region to repaint
+ */
+errno_t ds_display_paint_region(ds_display_t *disp, ds_region_t *region)
+{
+	size_t i;
+	errno_t rc;
+
+	for (i = 0; i < region->nrects; i++) {
+		rc = ds_display_paint_rect(disp, &region->rects[i]);
+		if (rc != EOK)
+			return rc;
+	}
+
 	return ds_display_update(disp);
 }
 
 /** Display invalidate callback.
  *
  * Called by backbuffer memory GC when something is rendered into it.
- * Updates the display's dirty rectangle.
+ * Adds the rectangle to the display's dirty region.
  *
  * @param arg Argument (display cast as void *)
  * @param rect Rectangle to update
@@ -1090,10 +1170,8 @@ errno_t ds_display_paint(ds_display_t *disp, gfx_rect_t *rect)
 static void ds_display_invalidate_cb(void *arg, gfx_rect_t *rect)
 {
 	ds_display_t *disp = (ds_display_t *) arg;
-	gfx_rect_t env;
 
-	gfx_rect_envelope(&disp->dirty_rect, rect, &env);
-	disp->dirty_rect = env;
+	ds_region_add(&disp->dirty, rect);
 }
 
 /** Display update callback.
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup display
+ * @{
+ */
+/**
+ * @file Display server region
+ *
+ * A region is used to track the parts of the display that need to be
+ * repainted or flushed to the output devices. It is kept as a short list
+ * of disjoint rectangles so that damage in distant parts of the display
+ * does not degrade into a single rectangle covering all of them.
+ */
+
+#include <gfx/coord.h>
+#include <macros.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "region.h"
+
+/** Two disjoint rectangles are merged if the envelope wastes at most
+ * 1/ds_region_merge_ratio of its area on pixels not in either of them.
+ */
+enum {
+	ds_region_merge_ratio = 4
+};
+
+/** Compute area of a sorted rectangle.
+ *
+ * @param rect Rectangle
+ * @return Number of pixels in @a rect
+ */
+static uint64_t ds_region_rect_area(gfx_rect_t *rect)
+{
+	return (uint64_t)(rect->p1.x - rect->p0.x) *
+	    (uint64_t)(rect->p1.y - rect->p0.y);
+}
+
+/** Compute number of pixels wasted by merging two disjoint rectangles.
+ *
+ * @param a First rectangle
+ * @param b Second rectangle
+ * @param env Place to store envelope of @a a and @a b
+ * @return Number of pixels in @a env that are neither in @a a nor in @a b
+ */
+static uint64_t ds_region_merge_waste(gfx_rect_t *a, gfx_rect_t *b,
+    gfx_rect_t *env)
+{
+	gfx_rect_envelope(a, b, env);
+	return ds_region_rect_area(env) - ds_region_rect_area(a) -
+	    ds_region_rect_area(b);
+}
+
+/** Remove rectangle from region.
+ *
+ * @param region Region
+ * @param idx Index of rectangle to remove
+ */
+static void ds_region_remove(ds_region_t *region, size_t idx)
+{
+	region->rects[idx] = region->rects[region->nrects - 1];
+	--region->nrects;
+}
+
+/** Append rectangle to region.
+ *
+ * The caller guarantees that @a rect is disjoint from all rectangles
+ * in the region. If the region is full, @a rect is merged in by
+ * ds_region_add() instead.
+ *
+ * @param region Region
+ * @param rect Sorted, non-empty rectangle
+ */
+static void ds_region_append(ds_region_t *region, gfx_rect_t *rect)
+{
+	if (region->nrects < ds_region_max_rects)
+		region->rects[region->nrects++] = *rect;
+	else
+		ds_region_add(region, rect);
+}
+
+/** Initialize region to empty.
+ *
+ * @param region Region
+ */
+void ds_region_init(ds_region_t *region)
+{
+	region->nrects = 0;
+}
+
+/** Make region empty.
+ *
+ * @param region Region
+ */
+void ds_region_clear(ds_region_t *region)
+{
+	region->nrects = 0;
+}
+
+/** Determine if region is empty.
+ *
+ * @param region Region
+ * @return @c true iff region contains no pixels
+ */
+bool ds_region_is_empty(ds_region_t *region)
+{
+	return region->nrects == 0;
+}
+
+/** Add rectangle to region.
+ *
+ * The region is extended to cover @a rect. To keep the rectangles
+ * disjoint, a rectangle that overlaps an existing one is merged with it
+ * into their envelope. Disjoint rectangles are merged as well if the
+ * envelope is not much larger than the two rectangles together. When
+ * the region is full, the new rectangle is merged with the one where
+ * this wastes the least area.
+ *
+ * @param region Region
+ * @param rect Rectangle
+ */
+void ds_region_add(ds_region_t *region, gfx_rect_t *rect)
+{
+	gfx_rect_t r;
+	gfx_rect_t env;
+	gfx_rect_t best_env;
+	uint64_t waste;
+	uint64_t best_waste;
+	size_t best;
+	size_t i;
+
+	gfx_rect_points_sort(rect, &r);
+	if (gfx_rect_is_empty(&r))
+		return;
+
+again:
+	for (i = 0; i < region->nrects; i++) {
+		if (gfx_rect_is_inside(&r, &region->rects[i]))
+			return;
+
+		if (gfx_rect_is_incident(&r, &region->rects[i])) {
+			gfx_rect_envelope(&r, &region->rects[i], &env);
+		} else {
+			waste = ds_region_merge_waste(&r, &region->rects[i],
+			    &env);
+			if (waste * ds_region_merge_ratio >
+			    ds_region_rect_area(&env))
+				continue;
+		}
+
+		/* The envelope may now touch other rectangles. */
+		ds_region_remove(region, i);
+		r = env;
+		goto again;
+	}
+
+	if (region->nrects < ds_region_max_rects) {
+		region->rects[region->nrects++] = r;
+		return;
+	}
+
+	/* Region is full. Merge with the best candidate. */
+	best = 0;
+	best_waste = ds_region_merge_waste(&r, &region->rects[0], &best_env);
+	for (i = 1; i < region->nrects; i++) {
+		waste = ds_region_merge_waste(&r, &region->rects[i], &env);
+		if (waste < best_waste) {
+			best = i;
+			best_waste = waste;
+			best_env = env;
+		}
+	}
+
+	ds_region_remove(region, best);
+	r = best_env;
+	goto again;
+}
+
+/** Subtract rectangle from region.
+ *
+ * Each rectangle of the region intersecting @a rect is replaced with
+ * the (at most four) pieces of it lying outside @a rect. If the region
+ * runs out of rectangles, pieces are merged by ds_region_add(), so the
+ * result may be larger than the exact difference, but never smaller.
+ *
+ * @param region Region
+ * @param rect Rectangle
+ */
+void ds_region_subtract(ds_region_t *region, gfx_rect_t *rect)
+{
+	ds_region_t old;
+	gfx_rect_t s;
+	gfx_rect_t r;
+	gfx_rect_t piece;
+	size_t i;
+
+	gfx_rect_points_sort(rect, &s);
+	if (gfx_rect_is_empty(&s))
+		return;
+
+	old = *region;
+	ds_region_clear(region);
+
+	for (i = 0; i < old.nrects; i++) {
+		r = old.rects[i];
+		if (!gfx_rect_is_incident(&r, &s)) {
+			ds_region_append(region, &r);
+			continue;
+		}
+
+		/* Full-width piece above @a s */
+		if (r.p0.y < s.p0.y) {
+			piece.p0.x = r.p0.x;
+			piece.p0.y = r.p0.y;
+			piece.p1.x = r.p1.x;
+			piece.p1.y = s.p0.y;
+			ds_region_append(region, &piece);
+		}
+
+		/* Full-width piece below @a s */
+		if (s.p1.y < r.p1.y) {
+			piece.p0.x = r.p0.x;
+			piece.p0.y = s.p1.y;
+			piece.p1.x = r.p1.x;
+			piece.p1.y = r.p1.y;
+			ds_region_append(region, &piece);
+		}
+
+		/* Pieces left and right of @a s, within its rows */
+		piece.p0.y = max(r.p0.y, s.p0.y);
+		piece.p1.y = min(r.p1.y, s.p1.y);
+
+		if (r.p0.x < s.p0.x) {
+			piece.p0.x = r.p0.x;
+			piece.p1.x = s.p0.x;
+			ds_region_append(region, &piece);
+		}
+
+		if (s.p1.x < r.p1.x) {
+			piece.p0.x = s.p1.x;
+			piece.p1.x = r.p1.x;
+			ds_region_append(region, &piece);
+		}
+	}
+}
+
+/** Compute intersection of region and rectangle.
+ *
+ * @param region Region
+ * @param clip Clipping rectangle
+ * @param dest Place to store the part of @a region inside @a clip
+ */
+void ds_region_clip(ds_region_t *region, gfx_rect_t *clip, ds_region_t *dest)
+{
+	gfx_rect_t r;
+	size_t i;
+
+	ds_region_init(dest);
+
+	for (i = 0; i < region->nrects; i++) {
+		gfx_rect_clip(&region->rects[i], clip, &r);
+		if (!gfx_rect_is_empty(&r))
+			dest->rects[dest->nrects++] = r;
+	}
+}
+
+/** Get bounding rectangle of region.
+ *
+ * @param region Region
+ * @param rect Place to store bounding rectangle (empty if region is empty)
+ */
+void ds_region_get_bounds(ds_region_t *region, gfx_rect_t *rect)
+{
+	gfx_rect_t env;
+	size_t i;
+
+	rect->p0.x = 0;
+	rect->p0.y = 0;
+	rect->p1.x = 0;
+	rect->p1.y = 0;
+
+	for (i = 0; i < region->nrects; i++) {
+		gfx_rect_envelope(rect, &region->rects[i], &env);
+		*rect = env;
+	}
+}
+
+/** @}
+ */
@@ -43,6 +43,7 @@
 #include "cursor.h"
 #include "display.h"
 #include "idevcfg.h"
+#include "region.h"
 #include "seat.h"
 #include "window.h"
 
@@ -361,33 +362,19 @@ void ds_seat_get_pointer_rect(ds_seat_t *seat, gfx_rect_t *rect)
 static errno_t ds_seat_repaint_pointer(ds_seat_t *seat, gfx_rect_t *old_rect)
 {
 	gfx_rect_t new_rect;
-	gfx_rect_t envelope;
-	errno_t rc;
+	ds_region_t region;
 
 	ds_seat_get_pointer_rect(seat, &new_rect);
 
-	if (gfx_rect_is_incident(old_rect, &new_rect)) {
-		/* Rectangles do not intersect. Repaint them separately. */
-		rc = ds_display_paint(seat->display, &new_rect);
-		if (rc != EOK)
-			return rc;
-
-		rc = ds_display_paint(seat->display, old_rect);
-		if (rc != EOK)
-			return rc;
-	} else {
-		/*
-		 * Rectangles intersect. As an optimization, repaint them
-		 * in a single operation.
-		 */
-		gfx_rect_envelope(old_rect, &new_rect, &envelope);
-
-		rc = ds_display_paint(seat->display, &envelope);
-		if (rc != EOK)
-			return rc;
-	}
+	/*
+	 * If the rectangles intersect, the region merges them and they
+	 * are repainted in a single operation.
+	 */
+	ds_region_init(&region);
+	ds_region_add(&region, old_rect);
+	ds_region_add(&region, &new_rect);
 
-	return EOK;
+	return ds_display_paint_region(seat->display, &region);
 }
 
 /** Post pointing device event to the seat
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gfx/coord.h>
+#include <pcut/pcut.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../region.h"
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(region);
+
+/** Initialized region is empty */
+PCUT_TEST(init_empty)
+{
+	ds_region_t region;
+	gfx_rect_t bounds;
+
+	ds_region_init(&region);
+	PCUT_ASSERT_TRUE(ds_region_is_empty(&region));
+
+	ds_region_get_bounds(&region, &bounds);
+	PCUT_ASSERT_TRUE(gfx_rect_is_empty(&bounds));
+}
+
+/** Adding empty rectangle leaves region empty */
+PCUT_TEST(add_empty)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 10;
+	rect.p0.y = 10;
+	rect.p1.x = 10;
+	rect.p1.y = 20;
+	ds_region_add(&region, &rect);
+
+	PCUT_ASSERT_TRUE(ds_region_is_empty(&region));
+}
+
+/** Distant rectangles are kept separate */
+PCUT_TEST(add_distant)
+{
+	ds_region_t region;
+	gfx_rect_t r1;
+	gfx_rect_t r2;
+	gfx_rect_t bounds;
+
+	ds_region_init(&region);
+
+	r1.p0.x = 0;
+	r1.p0.y = 0;
+	r1.p1.x = 10;
+	r1.p1.y = 10;
+	ds_region_add(&region, &r1);
+
+	r2.p0.x = 1000;
+	r2.p0.y = 700;
+	r2.p1.x = 1010;
+	r2.p1.y = 710;
+	ds_region_add(&region, &r2);
+
+	PCUT_ASSERT_INT_EQUALS(2, region.nrects);
+
+	ds_region_get_bounds(&region, &bounds);
+	PCUT_ASSERT_INT_EQUALS(0, bounds.p0.x);
+	PCUT_ASSERT_INT_EQUALS(0, bounds.p0.y);
+	PCUT_ASSERT_INT_EQUALS(1010, bounds.p1.x);
+	PCUT_ASSERT_INT_EQUALS(710, bounds.p1.y);
+}
+
+/** Overlapping rectangles are merged into their envelope */
+PCUT_TEST(add_overlapping)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 5;
+	rect.p0.y = 5;
+	rect.p1.x = 15;
+	rect.p1.y = 15;
+	ds_region_add(&region, &rect);
+
+	PCUT_ASSERT_INT_EQUALS(1, region.nrects);
+	PCUT_ASSERT_INT_EQUALS(0, region.rects[0].p0.x);
+	PCUT_ASSERT_INT_EQUALS(0, region.rects[0].p0.y);
+	PCUT_ASSERT_INT_EQUALS(15, region.rects[0].p1.x);
+	PCUT_ASSERT_INT_EQUALS(15, region.rects[0].p1.y);
+}
+
+/** Adjacent rectangles with a cheap envelope are merged */
+PCUT_TEST(add_adjacent)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 10;
+	rect.p0.y = 0;
+	rect.p1.x = 20;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	PCUT_ASSERT_INT_EQUALS(1, region.nrects);
+	PCUT_ASSERT_INT_EQUALS(0, region.rects[0].p0.x);
+	PCUT_ASSERT_INT_EQUALS(20, region.rects[0].p1.x);
+}
+
+/** Rectangle inside region does not change it */
+PCUT_TEST(add_inside)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 100;
+	rect.p1.y = 100;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 20;
+	rect.p0.y = 20;
+	rect.p1.x = 30;
+	rect.p1.y = 30;
+	ds_region_add(&region, &rect);
+
+	PCUT_ASSERT_INT_EQUALS(1, region.nrects);
+	PCUT_ASSERT_INT_EQUALS(100, region.rects[0].p1.x);
+	PCUT_ASSERT_INT_EQUALS(100, region.rects[0].p1.y);
+}
+
+/** Merged envelope absorbs other rectangles it now overlaps */
+PCUT_TEST(add_cascade)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 200;
+	rect.p0.y = 0;
+	rect.p1.x = 210;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	PCUT_ASSERT_INT_EQUALS(2, region.nrects);
+
+	/* Bridge spanning both rectangles */
+	rect.p0.x = 5;
+	rect.p0.y = 0;
+	rect.p1.x = 205;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	PCUT_ASSERT_INT_EQUALS(1, region.nrects);
+	PCUT_ASSERT_INT_EQUALS(0, region.rects[0].p0.x);
+	PCUT_ASSERT_INT_EQUALS(210, region.rects[0].p1.x);
+}
+
+/** Number of rectangles stays bounded and region covers all of them */
+PCUT_TEST(add_full)
+{
+	ds_region_t region;
+	gfx_rect_t rects[2 * ds_region_max_rects];
+	size_t i;
+	size_t j;
+	bool covered;
+
+	ds_region_init(&region);
+
+	for (i = 0; i < 2 * ds_region_max_rects; i++) {
+		rects[i].p0.x = 100 * i;
+		rects[i].p0.y = 100 * (i % 3);
+		rects[i].p1.x = 100 * i + 10;
+		rects[i].p1.y = 100 * (i % 3) + 10;
+		ds_region_add(&region, &rects[i]);
+	}
+
+	PCUT_ASSERT_TRUE(region.nrects <= ds_region_max_rects);
+
+	for (i = 0; i < 2 * ds_region_max_rects; i++) {
+		covered = false;
+		for (j = 0; j < region.nrects; j++) {
+			if (gfx_rect_is_inside(&rects[i], &region.rects[j]))
+				covered = true;
+		}
+
+		PCUT_ASSERT_TRUE(covered);
+	}
+
+	for (i = 0; i < region.nrects; i++) {
+		for (j = i + 1; j < region.nrects; j++) {
+			PCUT_ASSERT_FALSE(gfx_rect_is_incident(&region.rects[i],
+			    &region.rects[j]));
+		}
+	}
+}
+
+/** Clearing region makes it empty */
+PCUT_TEST(clear)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+	PCUT_ASSERT_FALSE(ds_region_is_empty(&region));
+
+	ds_region_clear(&region);
+	PCUT_ASSERT_TRUE(ds_region_is_empty(&region));
+}
+
+/** Subtracting a rectangle from the middle leaves a frame around it */
+PCUT_TEST(subtract_middle)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+	gfx_rect_t hole;
+	gfx_coord2_t pos;
+	size_t i;
+	size_t hits;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 100;
+	rect.p1.y = 100;
+	ds_region_add(&region, &rect);
+
+	hole.p0.x = 40;
+	hole.p0.y = 40;
+	hole.p1.x = 60;
+	hole.p1.y = 60;
+	ds_region_subtract(&region, &hole);
+
+	PCUT_ASSERT_INT_EQUALS(4, region.nrects);
+
+	/* Every pixel is covered exactly once outside the hole */
+	for (pos.y = 0; pos.y < 100; pos.y += 5) {
+		for (pos.x = 0; pos.x < 100; pos.x += 5) {
+			hits = 0;
+			for (i = 0; i < region.nrects; i++) {
+				if (gfx_pix_inside_rect(&pos, &region.rects[i]))
+					++hits;
+			}
+
+			if (gfx_pix_inside_rect(&pos, &hole))
+				PCUT_ASSERT_INT_EQUALS(0, hits);
+			else
+				PCUT_ASSERT_INT_EQUALS(1, hits);
+		}
+	}
+}
+
+/** Subtracting a covering rectangle leaves region empty */
+PCUT_TEST(subtract_all)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 10;
+	rect.p0.y = 10;
+	rect.p1.x = 20;
+	rect.p1.y = 20;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 1000;
+	rect.p0.y = 10;
+	rect.p1.x = 1020;
+	rect.p1.y = 20;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 2000;
+	rect.p1.y = 2000;
+	ds_region_subtract(&region, &rect);
+
+	PCUT_ASSERT_TRUE(ds_region_is_empty(&region));
+}
+
+/** Subtracting a disjoint rectangle does not change region */
+PCUT_TEST(subtract_disjoint)
+{
+	ds_region_t region;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 10;
+	rect.p0.y = 0;
+	rect.p1.x = 20;
+	rect.p1.y = 10;
+	ds_region_subtract(&region, &rect);
+
+	PCUT_ASSERT_INT_EQUALS(1, region.nrects);
+	PCUT_ASSERT_INT_EQUALS(0, region.rects[0].p0.x);
+	PCUT_ASSERT_INT_EQUALS(10, region.rects[0].p1.x);
+}
+
+/** Clipping region to a rectangle */
+PCUT_TEST(clip)
+{
+	ds_region_t region;
+	ds_region_t clipped;
+	gfx_rect_t rect;
+
+	ds_region_init(&region);
+
+	rect.p0.x = 0;
+	rect.p0.y = 0;
+	rect.p1.x = 10;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 500;
+	rect.p0.y = 0;
+	rect.p1.x = 510;
+	rect.p1.y = 10;
+	ds_region_add(&region, &rect);
+
+	rect.p0.x = 5;
+	rect.p0.y = 5;
+	rect.p1.x = 100;
+	rect.p1.y = 100;
+	ds_region_clip(&region, &rect, &clipped);
+
+	PCUT_ASSERT_INT_EQUALS(1, clipped.nrects);
+	PCUT_ASSERT_INT_EQUALS(5, clipped.rects[0].p0.x);
+	PCUT_ASSERT_INT_EQUALS(5, clipped.rects[0].p0.y);
+	PCUT_ASSERT_INT_EQUALS(10, clipped.rects[0].p1.x);
+	PCUT_ASSERT_INT_EQUALS(10, clipped.rects[0].p1.y);
+}
+
+PCUT_EXPORT(region);
@@ -45,6 +45,7 @@
 #include <types/display/cursor.h>
 #include "cursor.h"
 #include "clonegc.h"
+#include "region.h"
 #include "seat.h"
 #include "window.h"
 
@@ -116,8 +117,8 @@ typedef struct ds_display {
 	/** Frontbuffer (clone) GC */
 	ds_clonegc_t *fbgc;
 
-	/** Backbuffer dirty rectangle */
-	gfx_rect_t dirty_rect;
+	/** Backbuffer dirty region */
+	ds_region_t dirty;
 
 	/** Display flags */
 	ds_display_flags_t flags;
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 SimonJRiddix
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup display
+ * @{
+ */
+/**
+ * @file Display server region type
+ */
+
+#ifndef TYPES_DISPLAY_REGION_H
+#define TYPES_DISPLAY_REGION_H
+
+#include <gfx/coord.h>
+#include <stddef.h>
+
+enum {
+	/** Maximum number of rectangles in a region */
+	ds_region_max_rects = 16
+};
+
+/** Display server region.
+ *
+ * A set of pixels described by a small number of non-overlapping
+ * rectangles. Adding a rectangle may enlarge the region beyond the
+ * exact union of the added rectangles (see ds_region_add()), but never
+ * makes it smaller.
+ */
+typedef struct ds_region {
+	/** Number of rectangles */
+	size_t nrects;
+	/** Rectangles (sorted, non-empty, pairwise disjoint) */
+	gfx_rect_t rects[ds_region_max_rects];
+} ds_region_t;
+
+#endif
+
+/** @}
+ */
@@ -45,6 +45,7 @@
 #include <io/pixel.h>
 #include <io/pixelmap.h>
 #include <memgfx/memgc.h>
+#include "region.h"
 
 typedef sysarg_t ds_wnd_id_t;
 
@@ -110,6 +111,8 @@ typedef struct ds_window {
 	char *caption;
 	/** Number of foci */
 	unsigned nfocus;
+	/** Visible part of the display area being painted */
+	ds_region_t vis;
 } ds_window_t;
 
 /** Window event queue entry */
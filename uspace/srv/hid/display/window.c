@@ -47,6 +47,7 @@
 #include <wndmgt.h>
 #include "client.h"
 #include "display.h"
+#include "region.h"
 #include "seat.h"
 #include "window.h"
 #include "wmclient.h"
@@ -394,11 +395,8 @@ errno_t ds_window_paint_preview(ds_window_t *wnd, gfx_rect_t *rect)
  */
 static errno_t ds_window_repaint_preview(ds_window_t *wnd, gfx_rect_t *old_rect)
 {
-	errno_t rc;
 	gfx_rect_t prect;
-	gfx_rect_t envelope;
-	bool oldr;
-	bool newr;
+	ds_region_t region;
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG2, "ds_window_repaint_preview");
 
@@ -408,36 +406,19 @@ static errno_t ds_window_repaint_preview(ds_window_t *wnd, gfx_rect_t *old_rect)
 	 */
 	ds_window_get_preview_rect(wnd, &prect);
 
-	oldr = (old_rect != NULL) && !gfx_rect_is_empty(old_rect);
-	newr = !gfx_rect_is_empty(&prect);
-
-	if (oldr && newr && gfx_rect_is_incident(old_rect, &prect)) {
-		/*
-		 * As an optimization, repaint both rectangles in a single
-		 * operation.
-		 */
-
-		gfx_rect_envelope(old_rect, &prect, &envelope);
-
-		rc = ds_display_paint(wnd->display, &envelope);
-		if (rc != EOK)
-			return rc;
-	} else {
-		/* Repaint each rectangle separately */
-		if (oldr) {
-			rc = ds_display_paint(wnd->display, old_rect);
-			if (rc != EOK)
-				return rc;
-		}
+	/*
+	 * Repaint both rectangles. If they intersect, the region merges
+	 * them and they are repainted in a single operation.
+	 */
+	ds_region_init(&region);
+	if (old_rect != NULL)
+		ds_region_add(&region, old_rect);
+	ds_region_add(&region, &prect);
 
-		if (newr) {
-			rc = ds_display_paint(wnd->display, &prect);
-			if (rc != EOK)
-				return rc;
-		}
-	}
+	if (ds_region_is_empty(&region))
+		return EOK;
 
-	return EOK;
+	return ds_display_paint_region(wnd->display, &region);
 }
 
 /** Start moving a window by mouse drag.
@@ -54,10 +54,18 @@
 
 typedef struct logger_log logger_log_t;
 
+/** Rotate the log file once it grows beyond this size */
+#define LOG_ROTATE_SIZE (256 * 1024)
+
+/** Number of compressed rotated log files to keep */
+#define LOG_ROTATE_COUNT 3
+
 typedef struct {
 	fibril_mutex_t guard;
 	char *filename;
 	FILE *logfile;
+	/** Size of the log file (valid while it is open) */
+	size_t size;
 } logger_dest_t;
 
 struct logger_log {
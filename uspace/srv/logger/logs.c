@@ -30,12 +30,19 @@
  * @{
  */
 #include <assert.h>
+#include <deflate.h>
 #include <errno.h>
+#include <gzip.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <str.h>
+#include <str_error.h>
+#include <vfs/vfs.h>
 #include "logger.h"
 
+/** Buffer size for compressing rotated log files */
+#define ROTATE_BUF_SIZE 4096
+
 static FIBRIL_MUTEX_INITIALIZE(log_list_guard);
 static LIST_INITIALIZE(log_list);
 
@@ -59,6 +66,7 @@ static errno_t create_dest(const char *name, logger_dest_t **dest)
 		return ENOMEM;
 	}
 	result->logfile = NULL;
+	result->size = 0;
 	fibril_mutex_initialize(&result->guard);
 	*dest = result;
 	return EOK;
@@ -282,19 +290,156 @@ void log_release(logger_log_t *log)
 	free(log);
 }
 
+/** Compress file into a new GZIP file.
+ *
+ * @param src Name of the file to compress
+ * @param dest Name of the compressed file to create
+ * @return EOK on success or an error code
+ */
+static errno_t compress_file(const char *src, const char *dest)
+{
+	gzip_cstream_t *gs = NULL;
+	uint8_t *ibuf = NULL;
+	uint8_t *obuf = NULL;
+	FILE *in = NULL;
+	FILE *out = NULL;
+	size_t ipos = 0, ilen = 0;
+	size_t used, produced;
+	bool eof = false;
+	errno_t rc;
+
+	ibuf = malloc(ROTATE_BUF_SIZE);
+	obuf = malloc(ROTATE_BUF_SIZE);
+	if (ibuf == NULL || obuf == NULL) {
+		rc = ENOMEM;
+		goto out;
+	}
+
+	rc = gzip_cstream_create(DEFLATE_LEVEL_DEFAULT, &gs);
+	if (rc != EOK)
+		goto out;
+
+	in = fopen(src, "rb");
+	out = fopen(dest, "wb");
+	if (in == NULL || out == NULL) {
+		rc = EIO;
+		goto out;
+	}
+
+	while (!gzip_cstream_done(gs)) {
+		if (ipos == ilen && !eof) {
+			ipos = 0;
+			ilen = fread(ibuf, 1, ROTATE_BUF_SIZE, in);
+			if (ilen == 0) {
+				if (ferror(in)) {
+					rc = EIO;
+					goto out;
+				}
+
+				eof = true;
+			}
+		}
+
+		rc = gzip_cstream(gs, ibuf + ipos, ilen - ipos, &used, obuf,
+		    ROTATE_BUF_SIZE, &produced, eof);
+		if (rc != EOK)
+			goto out;
+
+		ipos += used;
+
+		if (fwrite(obuf, 1, produced, out) != produced) {
+			rc = EIO;
+			goto out;
+		}
+	}
+
+	rc = EOK;
+out:
+	if (out != NULL && fclose(out) != 0 && rc == EOK)
+		rc = EIO;
+	if (in != NULL)
+		fclose(in);
+	if (rc != EOK)
+		remove(dest);
+	if (gs != NULL)
+		gzip_cstream_destroy(gs);
+	free(ibuf);
+	free(obuf);
+	return rc;
+}
+
+/** Rotate log file.
+ *
+ * The log file is compressed into @c name.1.gz, older compressed files
+ * are shifted to @c name.2.gz etc. and the oldest one is removed. The
+ * log file is then started anew. If compression fails, the old
+ * messages are dropped so that the log does not grow without bounds.
+ *
+ * @param dest Log destination with the log file open
+ */
+static void rotate_log(logger_dest_t *dest)
+{
+	char *older;
+	char *newer;
+	errno_t rc;
+
+	fclose(dest->logfile);
+	dest->logfile = NULL;
+
+	for (int i = LOG_ROTATE_COUNT; i > 1; i--) {
+		if (asprintf(&older, "%s.%d.gz", dest->filename, i) < 0)
+			return;
+
+		if (asprintf(&newer, "%s.%d.gz", dest->filename, i - 1) < 0) {
+			free(older);
+			return;
+		}
+
+		remove(older);
+		rename(newer, older);
+		free(older);
+		free(newer);
+	}
+
+	if (asprintf(&newer, "%s.1.gz", dest->filename) < 0)
+		return;
+
+	rc = compress_file(dest->filename, newer);
+	if (rc != EOK) {
+		logger_log("Failed compressing %s: %s.\n", dest->filename,
+		    str_error(rc));
+	}
+
+	free(newer);
+	remove(dest->filename);
+}
+
 void write_to_log(logger_log_t *log, log_level_t level, const char *message)
 {
+	vfs_stat_t st;
+	int n;
+
 	assert(fibril_mutex_is_locked(&log->guard));
 	assert(log->dest != NULL);
 	fibril_mutex_lock(&log->dest->guard);
-	if (log->dest->logfile == NULL)
+	if (log->dest->logfile == NULL) {
 		log->dest->logfile = fopen(log->dest->filename, "a");
+		log->dest->size = 0;
+		if (vfs_stat_path(log->dest->filename, &st) == EOK)
+			log->dest->size = st.size;
+	}
 
 	if (log->dest->logfile != NULL) {
-		fprintf(log->dest->logfile, "[%s] %s: %s\n",
+		n = fprintf(log->dest->logfile, "[%s] %s: %s\n",
 		    log->full_name, log_level_str(level),
 		    (const char *) message);
 		fflush(log->dest->logfile);
+
+		if (n > 0)
+			log->dest->size += n;
+
+		if (log->dest->size >= LOG_ROTATE_SIZE)
+			rotate_log(log->dest);
 	}
 
 	fibril_mutex_unlock(&log->dest->guard);